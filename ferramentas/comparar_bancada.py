@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+Monta a tabela antes/depois de duas execuções da bancada de desempenho.
+
+Aceita os dois formatos, desde que os dois arquivos sejam do mesmo:
+- relatório do firmware (MODO_BANCADA, ver saco/Bancada.h): a saída da
+  serial, com as linhas "BANCADA nome=..." no meio dos logs; compara
+  ciclos_medio (ou a métrica passada em --metrica, ex.: ciclos_min)
+- saída JSON da bancada do host (bancada_saco --benchmark_out=arquivo.json
+  --benchmark_out_format=json); compara cpu_time em ns
+
+Uso: python3 ferramentas/comparar_bancada.py antes depois [--metrica ciclos_min]
+"""
+import json
+import sys
+
+
+def ler_firmware(texto, metrica):
+    resultados = {}
+    for linha in texto.splitlines():
+        inicio = linha.find('BANCADA nome=')
+        if inicio < 0:
+            continue
+        campos = dict(item.split('=', 1) for item in linha[inicio:].split()[1:] if '=' in item)
+        resultados[campos['nome']] = float(campos[metrica])
+    return resultados, metrica
+
+
+def ler_host(dados):
+    resultados = {}
+    for rotina in dados.get('benchmarks', []):
+        if rotina.get('run_type', 'iteration') != 'iteration':
+            continue
+        escala = {'ns': 1, 'us': 1e3, 'ms': 1e6, 's': 1e9}[rotina.get('time_unit', 'ns')]
+        resultados[rotina['name']] = rotina['cpu_time'] * escala
+    return resultados, 'cpu_time (ns)'
+
+
+def ler(caminho, metrica):
+    with open(caminho, encoding='utf-8', errors='replace') as arquivo:
+        texto = arquivo.read()
+    try:
+        return ler_host(json.loads(texto))
+    except ValueError:
+        return ler_firmware(texto, metrica)
+
+
+def main(argumentos):
+    metrica = 'ciclos_medio'
+    if '--metrica' in argumentos:
+        posicao = argumentos.index('--metrica')
+        metrica = argumentos[posicao + 1]
+        del argumentos[posicao:posicao + 2]
+    if len(argumentos) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    antes, unidade = ler(argumentos[0], metrica)
+    depois, unidade_depois = ler(argumentos[1], metrica)
+    if unidade != unidade_depois:
+        print('os dois arquivos precisam ser do mesmo formato', file=sys.stderr)
+        return 1
+
+    print('| rotina | antes | depois | variação |')
+    print('|---|---:|---:|---:|')
+    for nome in list(antes) + [n for n in depois if n not in antes]:
+        a = antes.get(nome)
+        d = depois.get(nome)
+        variacao = f'{(d - a) / a * 100:+.1f}%' if a and d is not None else '-'
+        formatar = lambda v: '-' if v is None else (f'{v:.2f}' if v < 100 else f'{v:.0f}')
+        print(f'| {nome} | {formatar(a)} | {formatar(d)} | {variacao} |')
+    print(f'\nMétrica: {unidade}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
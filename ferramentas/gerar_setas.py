@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""
+Gera saco/setas.h com os glifos das 8 setas e do alvo central já no formato
+de páginas do SSD1306, prontos para serem copiados para a área azul.
+
+Reproduz exatamente o desenho que o SetaDisplay fazia em tempo de execução
+(desenharSetaReta, desenharSetaAngular, desenharSetaFrente e
+desenharLinhaEspessa), com as mesmas primitivas da Adafruit_GFX (drawLine,
+fillTriangle, drawCircle e fillCircle) e aritmética float de 32 bits.
+
+Uso: python3 ferramentas/gerar_setas.py [saida]
+"""
+import math
+import os
+import struct
+import sys
+
+SCREEN_WIDTH = 128
+SCREEN_HEIGHT = 64
+YELLOW_AREA_HEIGHT = 16
+BLUE_AREA_HEIGHT = 48
+SETA_COMPRIMENTO = 47
+
+CENTRO_X = SCREEN_WIDTH // 2
+CENTRO_Y = YELLOW_AREA_HEIGHT + (BLUE_AREA_HEIGHT // 2)
+
+
+def f32(valor):
+    """Arredonda para float de 32 bits, como o firmware."""
+    return struct.unpack('f', struct.pack('f', valor))[0]
+
+
+def trunc(valor):
+    """Conversão float -> int do C (trunca em direção a zero)."""
+    return int(valor)
+
+
+def cdiv(a, b):
+    """Divisão inteira do C (trunca em direção a zero)."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+class Tela:
+    def __init__(self):
+        self.pixels = [[0] * SCREEN_WIDTH for _ in range(SCREEN_HEIGHT)]
+
+    def pixel(self, x, y):
+        if 0 <= x < SCREEN_WIDTH and 0 <= y < SCREEN_HEIGHT:
+            self.pixels[y][x] = 1
+
+    def linha_v(self, x, y, h):
+        for yy in range(y, y + h):
+            self.pixel(x, yy)
+
+    def linha_h(self, x, y, w):
+        for xx in range(x, x + w):
+            self.pixel(xx, y)
+
+    def linha(self, x0, y0, x1, y1):
+        # Adafruit_GFX::drawLine / writeLine (Bresenham)
+        if x0 == x1:
+            if y0 > y1:
+                y0, y1 = y1, y0
+            self.linha_v(x0, y0, y1 - y0 + 1)
+            return
+        if y0 == y1:
+            if x0 > x1:
+                x0, x1 = x1, x0
+            self.linha_h(x0, y0, x1 - x0 + 1)
+            return
+
+        ingreme = abs(y1 - y0) > abs(x1 - x0)
+        if ingreme:
+            x0, y0 = y0, x0
+            x1, y1 = y1, x1
+        if x0 > x1:
+            x0, x1 = x1, x0
+            y0, y1 = y1, y0
+
+        dx = x1 - x0
+        dy = abs(y1 - y0)
+        erro = dx // 2
+        passo_y = 1 if y0 < y1 else -1
+
+        while x0 <= x1:
+            if ingreme:
+                self.pixel(y0, x0)
+            else:
+                self.pixel(x0, y0)
+            erro -= dy
+            if erro < 0:
+                y0 += passo_y
+                erro += dx
+            x0 += 1
+
+    def triangulo_cheio(self, x0, y0, x1, y1, x2, y2):
+        # Adafruit_GFX::fillTriangle
+        if y0 > y1:
+            y0, y1 = y1, y0
+            x0, x1 = x1, x0
+        if y1 > y2:
+            y2, y1 = y1, y2
+            x2, x1 = x1, x2
+        if y0 > y1:
+            y0, y1 = y1, y0
+            x0, x1 = x1, x0
+
+        if y0 == y2:
+            a = b = x0
+            if x1 < a:
+                a = x1
+            elif x1 > b:
+                b = x1
+            if x2 < a:
+                a = x2
+            elif x2 > b:
+                b = x2
+            self.linha_h(a, y0, b - a + 1)
+            return
+
+        dx01, dy01 = x1 - x0, y1 - y0
+        dx02, dy02 = x2 - x0, y2 - y0
+        dx12, dy12 = x2 - x1, y2 - y1
+        sa = sb = 0
+
+        ultimo = y1 if y1 == y2 else y1 - 1
+
+        y = y0
+        while y <= ultimo:
+            a = x0 + cdiv(sa, dy01)
+            b = x0 + cdiv(sb, dy02)
+            sa += dx01
+            sb += dx02
+            if a > b:
+                a, b = b, a
+            self.linha_h(a, y, b - a + 1)
+            y += 1
+
+        sa = dx12 * (y - y1)
+        sb = dx02 * (y - y0)
+        while y <= y2:
+            a = x1 + cdiv(sa, dy12)
+            b = x0 + cdiv(sb, dy02)
+            sa += dx12
+            sb += dx02
+            if a > b:
+                a, b = b, a
+            self.linha_h(a, y, b - a + 1)
+            y += 1
+
+    def circulo(self, x0, y0, r):
+        # Adafruit_GFX::drawCircle
+        f = 1 - r
+        ddf_x = 1
+        ddf_y = -2 * r
+        x, y = 0, r
+
+        self.pixel(x0, y0 + r)
+        self.pixel(x0, y0 - r)
+        self.pixel(x0 + r, y0)
+        self.pixel(x0 - r, y0)
+
+        while x < y:
+            if f >= 0:
+                y -= 1
+                ddf_y += 2
+                f += ddf_y
+            x += 1
+            ddf_x += 2
+            f += ddf_x
+
+            for px, py in ((x, y), (-x, y), (x, -y), (-x, -y),
+                           (y, x), (-y, x), (y, -x), (-y, -x)):
+                self.pixel(x0 + px, y0 + py)
+
+    def circulo_cheio(self, x0, y0, r):
+        # Adafruit_GFX::fillCircle + fillCircleHelper(cantos = 3, delta = 0)
+        self.linha_v(x0, y0 - r, 2 * r + 1)
+
+        f = 1 - r
+        ddf_x = 1
+        ddf_y = -2 * r
+        x, y = 0, r
+        px, py = x, y
+        delta = 1
+
+        while x < y:
+            if f >= 0:
+                y -= 1
+                ddf_y += 2
+                f += ddf_y
+            x += 1
+            ddf_x += 2
+            f += ddf_x
+            if x < (y + 1):
+                self.linha_v(x0 + x, y0 - y, 2 * y + delta)
+                self.linha_v(x0 - x, y0 - y, 2 * y + delta)
+            if y != py:
+                self.linha_v(x0 + py, y0 - px, 2 * px + delta)
+                self.linha_v(x0 - py, y0 - px, 2 * px + delta)
+                py = y
+            px = x
+
+    def paginas_azuis(self):
+        """Bytes das páginas da área azul no layout do framebuffer do SSD1306."""
+        dados = []
+        for pagina in range(YELLOW_AREA_HEIGHT // 8, SCREEN_HEIGHT // 8):
+            for x in range(SCREEN_WIDTH):
+                byte = 0
+                for bit in range(8):
+                    if self.pixels[pagina * 8 + bit][x]:
+                        byte |= 1 << bit
+                dados.append(byte)
+        return dados
+
+
+def linha_espessa(tela, x1, y1, x2, y2):
+    tela.linha(x1, y1, x2, y2)
+
+    if x1 == x2:
+        tela.linha(x1 + 1, y1, x2 + 1, y2)
+    elif y1 == y2:
+        tela.linha(x1, y1 + 1, x2, y2 + 1)
+    else:
+        dx = f32(x2 - x1)
+        dy = f32(y2 - y1)
+        comprimento = f32(math.sqrt(f32(f32(dx * dx) + f32(dy * dy))))
+        perp_x = f32(-dy / comprimento)
+        perp_y = f32(dx / comprimento)
+        tela.linha(trunc(f32(x1 + perp_x)), trunc(f32(y1 + perp_y)),
+                   trunc(f32(x2 + perp_x)), trunc(f32(y2 + perp_y)))
+
+
+def seta_reta(tela, modo):
+    metade = SETA_COMPRIMENTO // 2
+    ponta = 10
+    base = 8
+    cx, cy = CENTRO_X, CENTRO_Y
+
+    if modo == 0:
+        linha_espessa(tela, cx - metade, cy, cx + metade - ponta, cy)
+        tela.triangulo_cheio(cx + metade, cy,
+                             cx + metade - ponta, cy - base,
+                             cx + metade - ponta, cy + base)
+    elif modo == 1:
+        linha_espessa(tela, cx, cy + metade, cx, cy - metade + ponta)
+        tela.triangulo_cheio(cx, cy - metade,
+                             cx - base, cy - metade + ponta,
+                             cx + base, cy - metade + ponta)
+    elif modo == 2:
+        linha_espessa(tela, cx + metade, cy, cx - metade + ponta, cy)
+        tela.triangulo_cheio(cx - metade, cy,
+                             cx - metade + ponta, cy - base,
+                             cx - metade + ponta, cy + base)
+    elif modo == 3:
+        linha_espessa(tela, cx, cy - metade, cx, cy + metade - ponta)
+        tela.triangulo_cheio(cx, cy + metade,
+                             cx - base, cy + metade - ponta,
+                             cx + base, cy + metade - ponta)
+
+
+def seta_angular(tela, angulo):
+    metade = SETA_COMPRIMENTO // 2
+    ponta = 10
+    base = 8
+    cx, cy = CENTRO_X, CENTRO_Y
+
+    radianos = f32(angulo * math.pi / 180.0)
+    cos_t = f32(math.cos(radianos))
+    sin_t = f32(math.sin(radianos))
+
+    inicio_x = trunc(f32(cx - f32(metade * cos_t)))
+    inicio_y = trunc(f32(cy + f32(metade * sin_t)))
+    base_x = trunc(f32(cx + f32((metade - ponta) * cos_t)))
+    base_y = trunc(f32(cy - f32((metade - ponta) * sin_t)))
+
+    vertice_x = trunc(f32(cx + f32(metade * cos_t)))
+    vertice_y = trunc(f32(cy - f32(metade * sin_t)))
+
+    perp_x = -sin_t
+    perp_y = -cos_t
+
+    base1_x = trunc(f32(base_x + f32(base * perp_x)))
+    base1_y = trunc(f32(base_y + f32(base * perp_y)))
+    base2_x = trunc(f32(base_x - f32(base * perp_x)))
+    base2_y = trunc(f32(base_y - f32(base * perp_y)))
+
+    linha_espessa(tela, inicio_x, inicio_y, base_x, base_y)
+    tela.triangulo_cheio(vertice_x, vertice_y, base1_x, base1_y, base2_x, base2_y)
+
+
+def seta_frente(tela):
+    tela.circulo(CENTRO_X, CENTRO_Y, 12)
+    tela.circulo(CENTRO_X, CENTRO_Y, 11)
+    tela.circulo_cheio(CENTRO_X, CENTRO_Y, 3)
+
+
+# Mesmo mapeamento ângulo -> desenho do antigo SetaDisplay::seta(int)
+GLIFOS = [
+    ("0 graus (frente)", lambda t: seta_reta(t, 1)),
+    ("45 graus", lambda t: seta_angular(t, 45)),
+    ("90 graus (direita)", lambda t: seta_reta(t, 0)),
+    ("135 graus", lambda t: seta_angular(t, 135)),
+    ("180 graus (trás)", lambda t: seta_reta(t, 3)),
+    ("225 graus", lambda t: seta_angular(t, 225)),
+    ("270 graus (esquerda)", lambda t: seta_reta(t, 2)),
+    ("315 graus", lambda t: seta_angular(t, 315)),
+    ("centro", seta_frente),
+]
+
+
+def main():
+    raiz = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    saida = sys.argv[1] if len(sys.argv) > 1 else os.path.join(raiz, "saco", "setas.h")
+
+    linhas = [
+        "/**",
+        " * @file setas.h",
+        " * @brief Glifos pré-calculados das setas para a área azul do display",
+        " *",
+        " * ARQUIVO GERADO por ferramentas/gerar_setas.py - não edite à mão.",
+        " *",
+        " * Cada glifo ocupa a área azul inteira (páginas 2 a 7 do SSD1306) no",
+        " * mesmo layout do framebuffer da Adafruit_SSD1306, então desenhar uma",
+        " * seta é uma única cópia de memória, sem trigonometria nem primitivas.",
+        " * Índices 0-7: ângulos 0, 45, ..., 315 graus; índice 8: alvo central.",
+        " */",
+        "#ifndef SETAS_H",
+        "#define SETAS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define NUM_GLIFOS_SETA 9",
+        "#define GLIFO_SETA_CENTRO 8",
+        "#define TAMANHO_GLIFO_SETA ((BLUE_AREA_HEIGHT / 8) * SCREEN_WIDTH)",
+        "",
+        "static const uint8_t GLIFOS_SETA[NUM_GLIFOS_SETA][TAMANHO_GLIFO_SETA] PROGMEM = {",
+    ]
+
+    for nome, desenhar in GLIFOS:
+        tela = Tela()
+        desenhar(tela)
+        dados = tela.paginas_azuis()
+        linhas.append("  { // %s" % nome)
+        for i in range(0, len(dados), 16):
+            linhas.append("    " + ", ".join("0x%02X" % b for b in dados[i:i + 16]) + ",")
+        linhas.append("  },")
+
+    linhas += ["};", "", "#endif", ""]
+
+    with open(saida, "w", encoding="utf-8") as arquivo:
+        arquivo.write("\n".join(linhas))
+
+
+if __name__ == "__main__":
+    main()
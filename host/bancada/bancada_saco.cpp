@@ -0,0 +1,210 @@
+/**
+ * @file bancada_saco.cpp
+ * @brief Bancada do host (google-benchmark) para as rotinas de sensoriamento
+ *
+ * Mede as mesmas rotinas da Bancada do firmware (saco/Bancada.h), com os
+ * mesmos nomes, alimentadas por um traço: o sintético por padrão ou um
+ * traço gravado no saco em SACO_TRACO.
+ *
+ *   bancada_saco --benchmark_out=antes.json --benchmark_out_format=json
+ *   python3 ferramentas/comparar_bancada.py antes.json depois.json
+ *
+ * O relógio é o virtual: os delay() das rotinas não contam, só o
+ * processamento (e o custo dos shims de I2C e toque).
+ */
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "Bancada.h"
+#include "ComparacaoFFT.h"
+#include "ReproducaoTraco.h"
+#include "display.h"
+
+namespace {
+
+traco::Traco& dadosTraco() {
+  static traco::Traco dados = [] {
+    traco::Traco carregado;
+    const char* caminho = getenv("SACO_TRACO");
+    std::string erro;
+    if (caminho && carregado.carregar(caminho, erro)) {
+      return carregado;
+    }
+    if (caminho) {
+      fprintf(stderr, "%s: %s; usando o traço sintético\n", caminho, erro.c_str());
+    }
+    traco::ParametrosSinteticos parametros;
+    parametros.duracaoMs = 10000;
+    for (uint32_t t = 200; t < parametros.duracaoMs; t += 400) {
+      parametros.golpes.push_back({t, 4.0f + (t % 7), 20, (int)(t / 400) % NUM_SENSORES});
+    }
+    return traco::gerarSintetico(parametros);
+  }();
+  return dados;
+}
+
+// Reinicia o mundo simulado e reproduz o traço em laço
+class Ambiente {
+public:
+  Ambiente() {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    sensores.iniciar();
+    reproducao.reset(new traco::Reproducao(dadosTraco()));
+    reproducao->aplicarCalibracao(sensores);
+    reproducao->instalar();
+    Bancada::reiniciar(sensores);
+  }
+
+  // Avança o relógio e recomeça o traço quando ele termina
+  void avancar(uint64_t us) {
+    simulacao::avancarUs(us);
+    if (reproducao->terminou()) {
+      reproducao->instalar();
+    }
+  }
+
+private:
+  std::unique_ptr<traco::Reproducao> reproducao;
+};
+
+void integraFFT(benchmark::State& estado) {
+  Ambiente ambiente;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(Bancada::integraFFT(sensores));
+    ambiente.avancar(1000);
+  }
+}
+BENCHMARK(integraFFT);
+
+void detectarPico(benchmark::State& estado) {
+  Ambiente ambiente;
+  float sinal[BANCADA_ITERACOES];
+  for (uint32_t i = 0; i < BANCADA_ITERACOES; i++) {
+    sinal[i] = Bancada::sinalPico(i);
+  }
+  uint32_t i = 0;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(Bancada::detectarPico(sensores, sinal[i]));
+    i = (i + 1) % BANCADA_ITERACOES;
+  }
+}
+BENCHMARK(detectarPico);
+
+void detectarToque(benchmark::State& estado) {
+  Ambiente ambiente;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(sensores.detectarToque());
+    ambiente.avancar(1000);
+  }
+}
+BENCHMARK(detectarToque);
+
+void calibrarSensorIndividual(benchmark::State& estado) {
+  Ambiente ambiente;
+  int indice = 0;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(sensores.calibrarSensorIndividual(indice));
+    indice = (indice + 1) % NUM_SENSORES;
+    ambiente.avancar(0);
+  }
+}
+BENCHMARK(calibrarSensorIndividual);
+
+// Backends de FFT_FORCA (Espectro.h), só o espectro, sobre a aceleração do traço
+template <class FFT>
+void medirFFT(benchmark::State& estado) {
+  static const std::vector<float> sinal = traco::aceleracaoResultante(dadosTraco());
+  PipelineForca<FFT> pipeline;
+  size_t i = 0;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(pipeline.processar(sinal[i]));
+    i = (i + 1) % sinal.size();
+  }
+}
+
+void fft_arduinoFFT(benchmark::State& estado) { medirFFT<FFTArduino<SAMPLES>>(estado); }
+BENCHMARK(fft_arduinoFFT);
+void fft_portavel(benchmark::State& estado) { medirFFT<FFTPortavel<SAMPLES>>(estado); }
+BENCHMARK(fft_portavel);
+void fft_espdsp_f32(benchmark::State& estado) { medirFFT<FFTEspDspF32<SAMPLES>>(estado); }
+BENCHMARK(fft_espdsp_f32);
+void fft_espdsp_s16(benchmark::State& estado) { medirFFT<FFTEspDspS16<SAMPLES>>(estado); }
+BENCHMARK(fft_espdsp_s16);
+
+void classificarGolpe(benchmark::State& estado) {
+  float caracteristicas[NUM_CARACTERISTICAS];
+  Bancada::caracteristicasBancada(caracteristicas);
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(classificadorGolpes.classificar(caracteristicas));
+  }
+}
+BENCHMARK(classificarGolpe);
+
+// O anel é esvaziado fora do tempo medido a cada LOG_CAPACIDADE registros
+void registrarLog(benchmark::State& estado) {
+  static ServicoLog log;
+  class : public Print {
+  public:
+    size_t write(uint8_t) override { return 1; }
+  } nula;
+  uint32_t i = 0;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(Bancada::registrarLog(log, i));
+    if (++i % LOG_CAPACIDADE == 0) {
+      estado.PauseTiming();
+      log.descarregar(nula);
+      estado.ResumeTiming();
+    }
+  }
+}
+BENCHMARK(registrarLog);
+
+// Comando novo no nó de medições: o FirebaseJson de antes e o Medicao.h
+void decodificarMedicao_firebaseJson(benchmark::State& estado) {
+  Medicao medicao;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(Bancada::decodificarFirebaseJson(Bancada::respostaMedicoes(), medicao));
+  }
+}
+BENCHMARK(decodificarMedicao_firebaseJson);
+
+void decodificarMedicao(benchmark::State& estado) {
+  const char* resposta = Bancada::respostaMedicoes();
+  size_t tamanho = strlen(resposta);
+  Medicao medicao;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(::decodificarMedicao(resposta, tamanho, medicao));
+  }
+}
+BENCHMARK(decodificarMedicao);
+
+// O mesmo comando sozinho na caixa de entrada (esquema 2)
+void decodificarMedicao_entrada(benchmark::State& estado) {
+  const char* resposta = Bancada::respostaEntrada();
+  size_t tamanho = strlen(resposta);
+  Medicao medicao;
+  for (auto _ : estado) {
+    benchmark::DoNotOptimize(::decodificarMedicao(resposta, tamanho, medicao));
+  }
+}
+BENCHMARK(decodificarMedicao_entrada);
+
+void seta(benchmark::State& estado) {
+  Ambiente ambiente;
+  setaDisplay.begin();
+  static const int angulos[8] = {0, 45, 90, 135, 180, 225, 270, 315};
+  uint32_t i = 0;
+  for (auto _ : estado) {
+    setaDisplay.seta(angulos[i++ % 8]);
+  }
+}
+BENCHMARK(seta);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+/**
+ * @file gerar_delta.cpp
+ * @brief Gera a imagem OTA (saco/Delta.h) de uma versão nova do firmware
+ *
+ *   gerar_delta <base.bin|--completa> <nova.bin> <saida.sdl>
+ *
+ * Com a base (o .bin da versão que está nos sacos), gera o delta; com
+ * --completa, a imagem nova inteira comprimida, para quem não tem a base.
+ * Confere o resultado aplicando-o de volta e imprime o tamanho e a
+ * composição (cópias da base, da janela e literais).
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Delta.h"
+#include "GeradorDelta.h"
+
+namespace {
+
+bool lerArquivo(const char* caminho, std::vector<uint8_t>& dados) {
+  std::ifstream arquivo(caminho, std::ios::binary);
+  if (!arquivo) {
+    return false;
+  }
+  dados.assign(std::istreambuf_iterator<char>(arquivo), std::istreambuf_iterator<char>());
+  return true;
+}
+
+class ParticoesMemoria : public ParticoesDelta {
+public:
+  explicit ParticoesMemoria(const std::vector<uint8_t>& base) : base(base) {}
+  std::vector<uint8_t> saida;
+
+  bool lerBase(uint32_t posicao, uint8_t* dados, size_t tamanho) override {
+    if (posicao + tamanho > base.size()) return false;
+    memcpy(dados, base.data() + posicao, tamanho);
+    return true;
+  }
+  bool escrever(const uint8_t* dados, size_t tamanho) override {
+    saida.insert(saida.end(), dados, dados + tamanho);
+    return true;
+  }
+
+private:
+  const std::vector<uint8_t>& base;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 4) {
+    fprintf(stderr, "uso: gerar_delta <base.bin|--completa> <nova.bin> <saida.sdl>\n");
+    return 2;
+  }
+  std::vector<uint8_t> base;
+  std::vector<uint8_t> nova;
+  if (strcmp(argv[1], "--completa") != 0 && !lerArquivo(argv[1], base)) {
+    fprintf(stderr, "não foi possível ler %s\n", argv[1]);
+    return 1;
+  }
+  if (!lerArquivo(argv[2], nova)) {
+    fprintf(stderr, "não foi possível ler %s\n", argv[2]);
+    return 1;
+  }
+
+  ota::EstatisticasDelta estatisticas;
+  std::vector<uint8_t> delta = ota::gerarDelta(base, nova, &estatisticas);
+
+  ParticoesMemoria particoes(base);
+  static AplicadorDelta aplicador;
+  aplicador.reiniciar();
+  if (!aplicador.alimentar(particoes, delta.data(), delta.size()) || !aplicador.getConcluido() ||
+      particoes.saida != nova) {
+    fprintf(stderr, "o delta gerado não reproduz a imagem nova (%s)\n",
+            nomeErroDelta(aplicador.getErro()));
+    return 1;
+  }
+
+  std::ofstream saida(argv[3], std::ios::binary);
+  saida.write((const char*)delta.data(), delta.size());
+  if (!saida) {
+    fprintf(stderr, "não foi possível gravar %s\n", argv[3]);
+    return 1;
+  }
+
+  printf("%s: %zu bytes (%.1f%% de %zu)\n", argv[3], delta.size(),
+         100.0 * delta.size() / (nova.empty() ? 1 : nova.size()), nova.size());
+  printf("  base:    %zu cópias, %zu bytes\n", estatisticas.copiasBase, estatisticas.bytesBase);
+  printf("  janela:  %zu cópias, %zu bytes\n", estatisticas.copiasJanela, estatisticas.bytesJanela);
+  printf("  literal: %zu bytes\n", estatisticas.literais);
+  return 0;
+}
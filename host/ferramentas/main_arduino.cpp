@@ -0,0 +1,21 @@
+/**
+ * @file main_arduino.cpp
+ * @brief O main() do core Arduino: setup() uma vez e loop() para sempre
+ *
+ * Liga os saco_gnu11_<placa> (firmware e sketch compilados em gnu++11, como
+ * no core Arduino-ESP32). Rodando, o sketch sobe contra os shims em tempo
+ * real, com o RTDB em memória.
+ */
+#include <Arduino.h>
+#include "Simulacao.h"
+
+void setup();
+void loop();
+
+int main() {
+  simulacao::definirRelogio(simulacao::ModoRelogio::Real);
+  setup();
+  while (true) {
+    loop();
+  }
+}
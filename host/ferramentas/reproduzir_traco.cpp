@@ -0,0 +1,136 @@
+/**
+ * @file reproduzir_traco.cpp
+ * @brief Reproduz um traço gravado no saco contra o Sensores do firmware
+ *
+ *   reproduzir_traco <traco.bin|captura_serial> [toques|forca|fft|calibrar N]
+ *   reproduzir_traco --sintetico [toques|forca|fft|calibrar N]
+ *
+ * - toques:     imprime cada pad detectado por detectarToque() (padrão)
+ * - forca:      mede calcularForca() em janelas consecutivas de 1 s
+ * - fft:        força de cada janela de 1 s em todos os backends de FFT
+ *               (Espectro.h), com o erro relativo ao arduinoFFT e o tempo
+ * - calibrar N: roda calibrarSensorIndividual(N) sobre o traço
+ *
+ * Usa o relógio virtual: o traço inteiro é consumido sem esperar, e o
+ * resultado é sempre o mesmo para o mesmo arquivo.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "ComparacaoFFT.h"
+#include "ReproducaoTraco.h"
+#include "Sensores.h"
+
+static void uso() {
+  fprintf(stderr,
+          "uso: reproduzir_traco <arquivo|--sintetico> [toques|forca|fft|calibrar N]\n");
+}
+
+static void reproduzirToques(traco::Reproducao& reproducao) {
+  int anterior = -1;
+  int detectados = 0;
+  while (!reproducao.terminou()) {
+    int sensor = sensores.detectarToque();
+    if (sensor != -1 && sensor != anterior) {
+      printf("%10.3f s  pad %d\n", (simulacao::agoraUs() - reproducao.inicio()) / 1e6, sensor);
+      detectados++;
+    }
+    anterior = sensor;
+    delay(1);
+  }
+  printf("%d toques detectados\n", detectados);
+}
+
+static void reproduzirForca(traco::Reproducao& reproducao) {
+  while (!reproducao.terminou()) {
+    float inicio = (simulacao::agoraUs() - reproducao.inicio()) / 1e6;
+    float forca = sensores.calcularForca();
+    if (forca > 0) {
+      printf("%10.3f s  força %.1f\n", inicio, forca);
+    }
+  }
+}
+
+static void compararBackends(const traco::Traco& dados) {
+  std::vector<traco::ResultadoFFT> resultados = traco::compararFFT(dados);
+  printf("%8s", "janela");
+  for (const traco::ResultadoFFT& r : resultados) {
+    printf(" %12s", r.nome.c_str());
+  }
+  printf("\n");
+  for (size_t i = 0; i < resultados[0].forcas.size(); i++) {
+    printf("%6zu s", i);
+    for (const traco::ResultadoFFT& r : resultados) {
+      printf(" %12.3f", r.forcas[i]);
+    }
+    printf("\n");
+  }
+  printf("\n%-12s %12s %12s %10s %10s\n", "backend", "erro máx %", "erro médio %", "ns/amostra",
+         "aceleração");
+  for (const traco::ResultadoFFT& r : resultados) {
+    printf("%-12s %12.4f %12.4f %10.0f %9.1fx\n", r.nome.c_str(), r.erroMaximo * 100,
+           r.erroMedio * 100, r.nsPorAmostra,
+           r.nsPorAmostra > 0 ? resultados[0].nsPorAmostra / r.nsPorAmostra : 0.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    uso();
+    return 2;
+  }
+  std::string arquivo = argv[1];
+  std::string modo = argc > 2 ? argv[2] : "toques";
+
+  traco::Traco dados;
+  if (arquivo == "--sintetico") {
+    traco::ParametrosSinteticos parametros;
+    parametros.golpes = {{1000, 6.0f, 20, 0}, {2000, 12.0f, 20, 3}, {3500, 3.0f, 20, 5}};
+    dados = traco::gerarSintetico(parametros);
+  } else {
+    std::string erro;
+    if (!dados.carregar(arquivo, erro)) {
+      fprintf(stderr, "%s: %s\n", arquivo.c_str(), erro.c_str());
+      return 1;
+    }
+  }
+  printf("%s: %.2f s, %zu toques, %zu IMU, %zu marcadores\n", arquivo.c_str(),
+         dados.duracaoUs() / 1e6, dados.toques.size(), dados.imu.size(),
+         dados.marcadores.size());
+
+  if (modo == "fft") {
+    compararBackends(dados);
+    return 0;
+  }
+
+  simulacao::reiniciar();
+  simulacao::silenciarSerial(true);
+  sensores.iniciar();
+
+  traco::Reproducao reproducao(dados);
+  reproducao.aplicarCalibracao(sensores);
+  reproducao.instalar();
+
+  auto parede = std::chrono::steady_clock::now();
+  if (modo == "toques") {
+    reproduzirToques(reproducao);
+  } else if (modo == "forca") {
+    reproduzirForca(reproducao);
+  } else if (modo == "calibrar" && argc > 3) {
+    int indice = atoi(argv[3]);
+    bool ok = sensores.calibrarSensorIndividual(indice);
+    printf("calibração do pad %d: %s, limite %d\n", indice, ok ? "ok" : "falhou",
+           sensores.getThreshold(indice));
+  } else {
+    uso();
+    return 2;
+  }
+
+  double simulado = (simulacao::agoraUs() - reproducao.inicio()) / 1e6;
+  double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - parede).count();
+  printf("%.2f s de traço em %.3f s (%.0fx o tempo real)\n", simulado, real,
+         real > 0 ? simulado / real : 0.0);
+  return 0;
+}
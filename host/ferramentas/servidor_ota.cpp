@@ -0,0 +1,82 @@
+/**
+ * @file servidor_ota.cpp
+ * @brief Serve um diretório de imagens OTA por HTTP, no lugar de um CDN
+ *
+ *   servidor_ota <diretorio> [--porta 8070] [--taxa bytes_por_segundo]
+ *
+ * Publica cada arquivo do diretório (manifesto.txt e os .sdl gerados pelo
+ * gerar_delta) na raiz. Os sacos acham o servidor em /ota/url no Firebase.
+ * Como o ServidorRTDB, escuta só em 127.0.0.1: para os sacos de verdade,
+ * qualquer servidor HTTP estático com o mesmo diretório serve. --taxa
+ * limita o envio, para ver o download competindo com um WiFi fraco. Roda
+ * até Ctrl+C.
+ */
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "ServidorOta.h"
+
+namespace {
+
+volatile std::sig_atomic_t parar = 0;
+
+void aoSinal(int) {
+  parar = 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "uso: servidor_ota <diretorio> [--porta 8070] [--taxa bytes_por_segundo]\n");
+    return 2;
+  }
+  uint16_t porta = 8070;
+  uint32_t taxa = 0;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    std::string nome = argv[i];
+    if (nome == "--porta") {
+      porta = (uint16_t)atoi(argv[i + 1]);
+    } else if (nome == "--taxa") {
+      taxa = (uint32_t)atol(argv[i + 1]);
+    } else {
+      fprintf(stderr, "opção desconhecida: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  ota::ServidorOta servidor;
+  std::error_code erro;
+  for (const auto& entrada : std::filesystem::directory_iterator(argv[1], erro)) {
+    if (!entrada.is_regular_file()) continue;
+    std::ifstream arquivo(entrada.path(), std::ios::binary);
+    std::string conteudo((std::istreambuf_iterator<char>(arquivo)), std::istreambuf_iterator<char>());
+    std::string caminho = "/" + entrada.path().filename().string();
+    servidor.publicar(caminho, conteudo);
+    printf("%s (%zu bytes)\n", caminho.c_str(), conteudo.size());
+  }
+  if (erro) {
+    fprintf(stderr, "não foi possível ler %s: %s\n", argv[1], erro.message().c_str());
+    return 1;
+  }
+  servidor.limitarTaxa(taxa);
+  if (!servidor.iniciar(porta)) {
+    fprintf(stderr, "não foi possível escutar na porta %u\n", (unsigned)porta);
+    return 1;
+  }
+  printf("servindo em %s\n", servidor.url().c_str());
+
+  signal(SIGINT, aoSinal);
+  signal(SIGTERM, aoSinal);
+  while (!parar) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+  servidor.parar();
+  return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file simulador_frota.cpp
+ * @brief Teste de carga do backend: N sacos virtuais contra um RTDB por HTTP
+ *
+ *   simulador_frota [--dispositivos 1,10,50,100] [--duracao 20] [--hz 1]
+ *                   [--modo polling|stream|ambos] [--comandos 6]
+ *                   [--medicao-ms 1000] [--servidor host:porta] [--ns projeto]
+ *                   [--csv arquivo]
+ *
+ * Para cada quantidade de sacos (e cada modo), roda a frota por --duracao
+ * segundos e imprime taxa de requisições, latências e banda. Sem
+ * --servidor usa o ServidorRTDB local; com ele, qualquer servidor com a
+ * API REST do RTDB (ex.: o emulador do Firebase, com --ns <projeto>).
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Frota.h"
+#include "Simulacao.h"
+
+namespace {
+
+struct Opcoes {
+  std::vector<int> dispositivos = {1, 10, 50, 100};
+  std::vector<bool> modos = {false};
+  frota::ConfiguracaoFrota base;
+  std::string servidor;
+  std::string ns;
+  std::string csv;
+};
+
+void uso() {
+  fprintf(stderr,
+          "uso: simulador_frota [--dispositivos 1,10,50] [--duracao s] [--hz n]\n"
+          "                     [--modo polling|stream|ambos] [--comandos por_minuto]\n"
+          "                     [--medicao-ms ms] [--servidor host:porta] [--ns projeto]\n"
+          "                     [--csv arquivo]\n");
+}
+
+bool interpretar(int argc, char** argv, Opcoes& opcoes) {
+  for (int i = 1; i < argc; i++) {
+    std::string nome = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    std::string valor = argv[++i];
+    if (nome == "--dispositivos") {
+      opcoes.dispositivos.clear();
+      for (char* parte = strtok(&valor[0], ","); parte; parte = strtok(nullptr, ",")) {
+        opcoes.dispositivos.push_back(atoi(parte));
+      }
+    } else if (nome == "--duracao") {
+      opcoes.base.duracaoS = atof(valor.c_str());
+    } else if (nome == "--hz") {
+      opcoes.base.hz = atof(valor.c_str());
+    } else if (nome == "--modo") {
+      if (valor == "polling") opcoes.modos = {false};
+      else if (valor == "stream") opcoes.modos = {true};
+      else if (valor == "ambos") opcoes.modos = {false, true};
+      else return false;
+    } else if (nome == "--comandos") {
+      opcoes.base.comandosPorMinuto = atof(valor.c_str());
+    } else if (nome == "--medicao-ms") {
+      opcoes.base.duracaoMedicaoMs = atoi(valor.c_str());
+    } else if (nome == "--servidor") {
+      opcoes.servidor = valor;
+    } else if (nome == "--ns") {
+      opcoes.ns = valor;
+    } else if (nome == "--csv") {
+      opcoes.csv = valor;
+    } else {
+      return false;
+    }
+  }
+  return !opcoes.dispositivos.empty() && opcoes.base.hz > 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Opcoes opcoes;
+  if (!interpretar(argc, argv, opcoes)) {
+    uso();
+    return 2;
+  }
+
+  simulacao::reiniciar();
+  simulacao::silenciarSerial(true);
+  simulacao::definirRelogio(simulacao::ModoRelogio::Real, 1.0);
+
+  FILE* csv = nullptr;
+  if (!opcoes.csv.empty()) {
+    csv = fopen(opcoes.csv.c_str(), "w");
+    if (!csv) {
+      fprintf(stderr, "não foi possível criar %s\n", opcoes.csv.c_str());
+      return 1;
+    }
+    fprintf(csv, "modo,sacos,hz,segundos,req_s,req_s_saco,leituras,gravacoes,atualizacoes,"
+                 "remocoes,eventos,erros,lat_p50_ms,lat_p95_ms,lat_p99_ms,lat_max_ms,"
+                 "kb_s_entrada,kb_s_saida,comandos,atendidos,concluidos,cmd_p50_ms,"
+                 "cmd_p95_ms,registro_s\n");
+  }
+
+  printf("%-8s %6s %9s %9s %9s %8s %8s %8s %8s %10s %10s %6s %9s %9s\n", "modo", "sacos",
+         "req/s", "req/s/saco", "eventos/s", "p50 ms", "p95 ms", "p99 ms", "max ms",
+         "kB/s ent.", "kB/s saída", "erros", "cmd p50", "cmd p95");
+
+  for (bool stream : opcoes.modos) {
+    for (int dispositivos : opcoes.dispositivos) {
+      frota::ServidorRTDB servidorLocal;
+      std::string host = "127.0.0.1";
+      uint16_t porta;
+      if (opcoes.servidor.empty()) {
+        if (!servidorLocal.iniciar()) {
+          fprintf(stderr, "falha ao iniciar o servidor local\n");
+          return 1;
+        }
+        porta = servidorLocal.porta();
+      } else {
+        size_t doisPontos = opcoes.servidor.rfind(':');
+        host = opcoes.servidor.substr(0, doisPontos);
+        porta = doisPontos == std::string::npos ? 80 : atoi(opcoes.servidor.c_str() + doisPontos + 1);
+      }
+      std::string consulta = opcoes.ns.empty() ? "" : "ns=" + opcoes.ns;
+      frota::ClienteRTDBHTTP sacos(host, porta, consulta);
+      frota::ClienteRTDBHTTP app(host, porta, consulta);
+
+      frota::ConfiguracaoFrota configuracao = opcoes.base;
+      configuracao.dispositivos = dispositivos;
+      configuracao.stream = stream;
+      frota::ResultadoFrota r = frota::executarFrota(
+          configuracao, sacos, app, opcoes.servidor.empty() ? &servidorLocal : nullptr);
+
+      const frota::EstatisticasCliente& e = r.sacos;
+      double requisicoes = e.totalRequisicoes() / r.segundos;
+      double eventos = e.eventos / r.segundos;
+      double p50 = frota::percentil(e.latenciasUs, 50) / 1000.0;
+      double p95 = frota::percentil(e.latenciasUs, 95) / 1000.0;
+      double p99 = frota::percentil(e.latenciasUs, 99) / 1000.0;
+      double maximo = frota::percentil(e.latenciasUs, 100) / 1000.0;
+      double entrada = e.bytesRecebidos / r.segundos / 1024.0;
+      double saida = e.bytesEnviados / r.segundos / 1024.0;
+      double cmd50 = frota::percentil(r.latenciaComandoMs, 50);
+      double cmd95 = frota::percentil(r.latenciaComandoMs, 95);
+      const char* modo = stream ? "stream" : "polling";
+
+      printf("%-8s %6d %9.1f %9.2f %9.1f %8.2f %8.2f %8.2f %8.2f %10.1f %10.1f %6llu %9.0f %9.0f\n",
+             modo, dispositivos, requisicoes, requisicoes / dispositivos, eventos, p50, p95, p99,
+             maximo, entrada, saida, (unsigned long long)e.erros, cmd50, cmd95);
+      if (r.comandosAtendidos < r.comandosEnviados) {
+        printf("         %llu de %llu comandos atendidos na janela\n",
+               (unsigned long long)r.comandosAtendidos, (unsigned long long)r.comandosEnviados);
+      }
+      fflush(stdout);
+
+      if (csv) {
+        fprintf(csv, "%s,%d,%.2f,%.2f,%.2f,%.3f,%llu,%llu,%llu,%llu,%llu,%llu,%.3f,%.3f,%.3f,"
+                     "%.3f,%.2f,%.2f,%llu,%llu,%llu,%.0f,%.0f,%.2f\n",
+                modo, dispositivos, configuracao.hz, r.segundos, requisicoes,
+                requisicoes / dispositivos,
+                (unsigned long long)e.requisicoes[(int)frota::OperacaoRTDB::Leitura],
+                (unsigned long long)e.requisicoes[(int)frota::OperacaoRTDB::Gravacao],
+                (unsigned long long)e.requisicoes[(int)frota::OperacaoRTDB::Atualizacao],
+                (unsigned long long)e.requisicoes[(int)frota::OperacaoRTDB::Remocao],
+                (unsigned long long)e.eventos, (unsigned long long)e.erros, p50, p95, p99,
+                maximo, entrada, saida, (unsigned long long)r.comandosEnviados,
+                (unsigned long long)r.comandosAtendidos, (unsigned long long)r.comandosConcluidos,
+                cmd50, cmd95, r.registroS);
+        fflush(csv);
+      }
+    }
+  }
+  if (csv) {
+    fclose(csv);
+  }
+  return 0;
+}
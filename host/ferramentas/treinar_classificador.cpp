@@ -0,0 +1,147 @@
+/**
+ * @file treinar_classificador.cpp
+ * @brief Treina e avalia o classificador de golpes a partir de traços
+ *
+ *   treinar_classificador [opções] jab=a.bin,b.bin direto=c.bin gancho=... uppercut=...
+ *   treinar_classificador --sintetico 400 --saida saco/ModeloGolpesSaco.h
+ *   treinar_classificador --avaliar jab=a.bin ...
+ *
+ * Cada traço é uma sessão gravada (modo gravacao) com um só tipo de golpe.
+ * Os golpes são segmentados e resumidos como no firmware; 75% treinam a
+ * MLP e 25% medem a acurácia do modelo int8 (matriz de confusão, acordo
+ * com o float e tempo de inferência no host).
+ *
+ * - --sintetico N: N golpes sintéticos de cada tipo, além dos traços
+ * - --saida ARQ:   grava as tabelas (o saco/ModeloGolpes<Placa>.h do firmware)
+ * - --avaliar:     só avalia o modelo embarcado nos traços dados
+ * - --ocultos H, --epocas E, --semente S
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "TreinoClassificador.h"
+
+static void uso() {
+  fprintf(stderr,
+          "uso: treinar_classificador [--sintetico N] [--saida ARQ] [--avaliar] [--ocultos H]\n"
+          "                           [--epocas E] [--semente S] [tipo=traco[,traco...]]...\n"
+          "tipos: jab, direto, gancho, uppercut\n");
+}
+
+static bool tipoPorNome(const std::string& nome, TipoGolpe& tipo) {
+  for (int t = 0; t < NUM_TIPOS_GOLPE; t++) {
+    if (nome == nomeTipoGolpe((TipoGolpe)t)) {
+      tipo = (TipoGolpe)t;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void imprimir(const char* titulo, const traco::AvaliacaoClassificador& a, bool comFloat) {
+  printf("\n%s: %u golpes, acurácia int8 %.1f%%", titulo, a.total, a.acuracia * 100);
+  if (comFloat) {
+    printf(", float %.1f%%, int8 = float em %.1f%%", a.acuraciaFloat * 100, a.concordancia * 100);
+  }
+  printf(", %.0f ns por golpe no host\n", a.nsPorGolpe);
+  printf("%10s", "real\\prev");
+  for (int k = 0; k < NUM_TIPOS_GOLPE; k++) printf(" %9s", nomeTipoGolpe((TipoGolpe)k));
+  printf("\n");
+  for (int r = 0; r < NUM_TIPOS_GOLPE; r++) {
+    printf("%10s", nomeTipoGolpe((TipoGolpe)r));
+    for (int k = 0; k < NUM_TIPOS_GOLPE; k++) printf(" %9u", a.confusao[r][k]);
+    printf("\n");
+  }
+}
+
+int main(int argc, char** argv) {
+  traco::ParametrosTreino parametros;
+  uint32_t sinteticos = 0;
+  std::string saida;
+  bool soAvaliar = false;
+  std::vector<traco::ExemploGolpe> exemplos;
+  std::string origem;
+  bool gravado = false;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--sintetico" && i + 1 < argc) {
+      sinteticos = atoi(argv[++i]);
+    } else if (arg == "--saida" && i + 1 < argc) {
+      saida = argv[++i];
+    } else if (arg == "--avaliar") {
+      soAvaliar = true;
+    } else if (arg == "--ocultos" && i + 1 < argc) {
+      parametros.ocultos = atoi(argv[++i]);
+    } else if (arg == "--epocas" && i + 1 < argc) {
+      parametros.epocas = atoi(argv[++i]);
+    } else if (arg == "--semente" && i + 1 < argc) {
+      parametros.semente = atoi(argv[++i]);
+    } else if (arg.find('=') != std::string::npos) {
+      TipoGolpe tipo;
+      if (!tipoPorNome(arg.substr(0, arg.find('=')), tipo)) {
+        uso();
+        return 2;
+      }
+      std::stringstream arquivos(arg.substr(arg.find('=') + 1));
+      std::string arquivo;
+      while (std::getline(arquivos, arquivo, ',')) {
+        traco::Traco dados;
+        std::string erro;
+        if (!dados.carregar(arquivo, erro)) {
+          fprintf(stderr, "%s: %s\n", arquivo.c_str(), erro.c_str());
+          return 1;
+        }
+        std::vector<traco::ExemploGolpe> doTraco = traco::extrairExemplos(dados, tipo);
+        printf("%s: %zu golpes de %s\n", arquivo.c_str(), doTraco.size(), nomeTipoGolpe(tipo));
+        exemplos.insert(exemplos.end(), doTraco.begin(), doTraco.end());
+        gravado = gravado || !doTraco.empty();
+        origem += (origem.empty() ? "" : ", ") + arquivo;
+      }
+    } else {
+      uso();
+      return 2;
+    }
+  }
+  if (sinteticos > 0) {
+    std::vector<traco::ExemploGolpe> gerados = traco::exemplosSinteticos(sinteticos, parametros.semente);
+    printf("%zu golpes sintéticos\n", gerados.size());
+    exemplos.insert(exemplos.end(), gerados.begin(), gerados.end());
+    origem += (origem.empty() ? "" : ", ") + std::to_string(sinteticos) +
+              " golpes sintéticos por tipo (semente " + std::to_string(parametros.semente) + ")";
+  }
+  if (exemplos.empty()) {
+    uso();
+    return 2;
+  }
+
+  if (soAvaliar) {
+    imprimir("modelo embarcado", traco::avaliar(modeloGolpesPadrao(), exemplos), false);
+    return 0;
+  }
+
+  std::mt19937 gerador(parametros.semente);
+  std::shuffle(exemplos.begin(), exemplos.end(), gerador);
+  size_t corte = exemplos.size() * 3 / 4;
+  std::vector<traco::ExemploGolpe> treino(exemplos.begin(), exemplos.begin() + corte);
+  std::vector<traco::ExemploGolpe> teste(exemplos.begin() + corte, exemplos.end());
+
+  traco::ModeloTreinado modelo = traco::treinar(treino, parametros);
+  ModeloGolpes tabelas = modelo.tabelas();
+  imprimir("treino", traco::avaliar(tabelas, treino, &modelo), true);
+  imprimir("teste", traco::avaliar(tabelas, teste, &modelo), true);
+  imprimir("modelo embarcado no teste", traco::avaliar(modeloGolpesPadrao(), teste), false);
+
+  if (!saida.empty()) {
+    if (!traco::escreverModelo(modelo, saida, origem, gravado)) {
+      fprintf(stderr, "%s: falha ao gravar\n", saida.c_str());
+      return 1;
+    }
+    printf("\nmodelo gravado em %s\n", saida.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,268 @@
+#include "ClienteRTDBHTTP.h"
+
+#include <sys/socket.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#include "Http.h"
+
+using simulacao::Json;
+
+namespace frota {
+
+namespace {
+
+// Valor de uma linha "campo: valor" do SSE
+std::string valorCampo(const std::string& linha, size_t inicio) {
+  size_t primeiro = linha.find_first_not_of(' ', inicio);
+  return primeiro == std::string::npos ? "" : linha.substr(primeiro);
+}
+
+// Stream SSE numa conexão própria, lido por uma thread
+class FluxoHTTP : public simulacao::FluxoRTDB {
+public:
+  FluxoHTTP(ClienteRTDBHTTP& cliente, int socket, std::string pendente)
+      : cliente(cliente), socket(socket), pendente(std::move(pendente)) {
+    leitor = std::thread(&FluxoHTTP::ler, this);
+  }
+
+  ~FluxoHTTP() override {
+    shutdown(socket, SHUT_RDWR);
+    leitor.join();
+    fecharSocket(socket);
+  }
+
+  bool proximo(simulacao::EventoRTDB& evento, uint32_t esperaMs) override {
+    std::unique_lock<std::mutex> trava(mutex);
+    if (fila.empty() && esperaMs > 0) {
+      novoEvento.wait_for(trava, std::chrono::milliseconds(esperaMs),
+                          [this] { return !fila.empty() || !conectado; });
+    }
+    if (fila.empty()) {
+      return false;
+    }
+    evento = fila.front();
+    fila.pop_front();
+    return true;
+  }
+
+  bool ativo() override {
+    std::lock_guard<std::mutex> trava(mutex);
+    return conectado || !fila.empty();
+  }
+
+private:
+  ClienteRTDBHTTP& cliente;
+  int socket;
+  std::string pendente;
+  std::thread leitor;
+
+  std::mutex mutex;
+  std::condition_variable novoEvento;
+  std::deque<simulacao::EventoRTDB> fila;
+  bool conectado = true;
+
+  void ler() {
+    std::string linha, tipo, dados;
+    while (lerLinha(socket, pendente, linha)) {
+      cliente.contarStream(linha.size() + 1, false);
+      if (linha.rfind("event:", 0) == 0) {
+        tipo = valorCampo(linha, 6);
+      } else if (linha.rfind("data:", 0) == 0) {
+        dados = valorCampo(linha, 5);
+      } else if (linha.empty() && !tipo.empty()) {
+        if (tipo == "cancel" || tipo == "auth_revoked") {
+          break;
+        }
+        Json conteudo;
+        if ((tipo == "put" || tipo == "patch") && Json::interpretar(dados, conteudo)) {
+          const Json* caminho = conteudo.buscar("path");
+          const Json* valor = conteudo.buscar("data");
+          std::lock_guard<std::mutex> trava(mutex);
+          fila.push_back({tipo, caminho ? caminho->comoTexto() : "/", valor ? *valor : Json()});
+          cliente.contarStream(0, true);
+        }
+        tipo.clear();
+        dados.clear();
+        novoEvento.notify_all();
+      }
+    }
+    std::lock_guard<std::mutex> trava(mutex);
+    conectado = false;
+    novoEvento.notify_all();
+  }
+};
+
+}  // namespace
+
+uint64_t EstatisticasCliente::totalRequisicoes() const {
+  uint64_t total = 0;
+  for (uint64_t n : requisicoes) {
+    total += n;
+  }
+  return total;
+}
+
+ClienteRTDBHTTP::ClienteRTDBHTTP(const std::string& host, uint16_t porta,
+                                 const std::string& consulta)
+    : host(host), porta(porta), consulta(consulta) {}
+
+ClienteRTDBHTTP::~ClienteRTDBHTTP() {
+  for (int s : conexoesLivres) {
+    fecharSocket(s);
+  }
+}
+
+std::string ClienteRTDBHTTP::alvo(const std::string& caminho) const {
+  std::string normalizado = caminho.empty() || caminho[0] != '/' ? "/" + caminho : caminho;
+  while (normalizado.size() > 1 && normalizado.back() == '/') {
+    normalizado.pop_back();
+  }
+  std::string url = codificarCaminho(normalizado == "/" ? "/" : normalizado) + ".json";
+  return consulta.empty() ? url : url + "?" + consulta;
+}
+
+int ClienteRTDBHTTP::obterConexao() {
+  {
+    std::lock_guard<std::mutex> trava(mutexConexoes);
+    if (!conexoesLivres.empty()) {
+      int s = conexoesLivres.back();
+      conexoesLivres.pop_back();
+      return s;
+    }
+  }
+  return conectar(host, porta);
+}
+
+void ClienteRTDBHTTP::devolverConexao(int socket) {
+  std::lock_guard<std::mutex> trava(mutexConexoes);
+  conexoesLivres.push_back(socket);
+}
+
+bool ClienteRTDBHTTP::requisitar(OperacaoRTDB operacao, const std::string& metodo,
+                                 const std::string& caminho, const std::string& corpo,
+                                 std::string& resposta, std::string& erro) {
+  std::string requisicao = metodo + " " + alvo(caminho) + " HTTP/1.1\r\nHost: " + host +
+                           "\r\nContent-Type: application/json\r\nContent-Length: " +
+                           std::to_string(corpo.size()) + "\r\nConnection: keep-alive\r\n\r\n" +
+                           corpo;
+
+  auto inicio = std::chrono::steady_clock::now();
+  MensagemHttp mensagem;
+  bool ok = false;
+  // Uma conexão ociosa pode ter sido fechada pelo servidor: tenta outra
+  for (int tentativa = 0; tentativa < 2 && !ok; tentativa++) {
+    int s = obterConexao();
+    if (s < 0) {
+      break;
+    }
+    std::string pendente;
+    ok = enviarTudo(s, requisicao) && lerMensagem(s, pendente, mensagem, false);
+    if (ok && mensagem.cabecalho("connection") != "close") {
+      devolverConexao(s);
+    } else {
+      fecharSocket(s);
+    }
+  }
+  uint32_t latencia = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - inicio).count();
+
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  contadores.requisicoes[(int)operacao]++;
+  contadores.bytesEnviados += requisicao.size();
+  contadores.latenciasUs.push_back(latencia);
+  if (!ok) {
+    contadores.erros++;
+    erro = "connection refused";
+    return false;
+  }
+  contadores.bytesRecebidos += mensagem.bytes;
+  if (mensagem.status != 200) {
+    contadores.erros++;
+    Json corpoErro;
+    const Json* texto = Json::interpretar(mensagem.corpo, corpoErro) ? corpoErro.buscar("error")
+                                                                     : nullptr;
+    erro = texto ? texto->comoTexto() : "bad request";
+    return false;
+  }
+  resposta = mensagem.corpo;
+  return true;
+}
+
+bool ClienteRTDBHTTP::ler(const std::string& caminho, Json& valor, std::string& erro) {
+  std::string resposta;
+  if (!requisitar(OperacaoRTDB::Leitura, "GET", caminho, "", resposta, erro)) {
+    return false;
+  }
+  if (!Json::interpretar(resposta, valor)) {
+    erro = "invalid JSON response";
+    return false;
+  }
+  if (valor.nulo()) {
+    erro = "path not exist";
+    return false;
+  }
+  return true;
+}
+
+bool ClienteRTDBHTTP::gravar(const std::string& caminho, const Json& valor, std::string& erro) {
+  std::string resposta;
+  return requisitar(OperacaoRTDB::Gravacao, "PUT", caminho, valor.serializar(), resposta, erro);
+}
+
+bool ClienteRTDBHTTP::atualizar(const std::string& caminho, const Json& valor, std::string& erro) {
+  std::string resposta;
+  return requisitar(OperacaoRTDB::Atualizacao, "PATCH", caminho, valor.serializar(), resposta,
+                    erro);
+}
+
+bool ClienteRTDBHTTP::remover(const std::string& caminho, std::string& erro) {
+  std::string resposta;
+  return requisitar(OperacaoRTDB::Remocao, "DELETE", caminho, "", resposta, erro);
+}
+
+std::shared_ptr<simulacao::FluxoRTDB> ClienteRTDBHTTP::observar(const std::string& caminho,
+                                                               std::string& erro) {
+  int s = conectar(host, porta);
+  std::string requisicao = "GET " + alvo(caminho) + " HTTP/1.1\r\nHost: " + host +
+                           "\r\nAccept: text/event-stream\r\n\r\n";
+  std::string pendente;
+  MensagemHttp resposta;
+  bool ok = s >= 0 && enviarTudo(s, requisicao) &&
+            lerMensagem(s, pendente, resposta, false, true) && resposta.status == 200;
+
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  contadores.requisicoes[(int)OperacaoRTDB::Stream]++;
+  contadores.bytesEnviados += requisicao.size();
+  contadores.bytesRecebidos += resposta.bytes;
+  if (!ok) {
+    contadores.erros++;
+    fecharSocket(s);
+    erro = "stream connection failed";
+    return nullptr;
+  }
+  return std::make_shared<FluxoHTTP>(*this, s, pendente);
+}
+
+void ClienteRTDBHTTP::contarStream(uint64_t bytes, bool evento) {
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  contadores.bytesRecebidos += bytes;
+  if (evento) {
+    contadores.eventos++;
+  }
+}
+
+EstatisticasCliente ClienteRTDBHTTP::estatisticas() {
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  return contadores;
+}
+
+void ClienteRTDBHTTP::zerarEstatisticas() {
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  contadores = EstatisticasCliente();
+}
+
+}  // namespace frota
@@ -0,0 +1,76 @@
+/**
+ * @file ClienteRTDBHTTP.h
+ * @brief RTDB simulado que fala HTTP com um servidor compatível com o RTDB
+ *
+ * Instalado com simulacao::definirRTDB(), faz o shim do Firebase_ESP_Client
+ * enviar cada operação do firmware como requisição REST (keep-alive, uma
+ * conexão por requisição simultânea) e cada beginStream() como um stream
+ * SSE. Mede a latência e os bytes de cada requisição.
+ */
+#ifndef FROTA_CLIENTE_RTDB_HTTP_H
+#define FROTA_CLIENTE_RTDB_HTTP_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "RTDB.h"
+
+namespace frota {
+
+enum class OperacaoRTDB { Leitura = 0, Gravacao, Atualizacao, Remocao, Stream };
+#define NUM_OPERACOES_RTDB 5
+
+struct EstatisticasCliente {
+  uint64_t requisicoes[NUM_OPERACOES_RTDB] = {};
+  uint64_t erros = 0;           // Falhas de conexão e respostas != 200
+  uint64_t eventos = 0;         // Eventos SSE recebidos (sem keep-alive)
+  uint64_t bytesEnviados = 0;   // Requisições completas, com cabeçalhos
+  uint64_t bytesRecebidos = 0;  // Respostas e streams, com cabeçalhos
+  std::vector<uint32_t> latenciasUs;  // Uma por requisição REST
+
+  uint64_t totalRequisicoes() const;
+};
+
+class ClienteRTDBHTTP : public simulacao::RTDB {
+public:
+  // consulta: parâmetros extras da URL (ex.: "ns=projeto" no emulador)
+  ClienteRTDBHTTP(const std::string& host, uint16_t porta, const std::string& consulta = "");
+  ~ClienteRTDBHTTP();
+
+  bool ler(const std::string& caminho, simulacao::Json& valor, std::string& erro) override;
+  bool gravar(const std::string& caminho, const simulacao::Json& valor, std::string& erro) override;
+  bool atualizar(const std::string& caminho, const simulacao::Json& valor, std::string& erro) override;
+  bool remover(const std::string& caminho, std::string& erro) override;
+  std::shared_ptr<simulacao::FluxoRTDB> observar(const std::string& caminho, std::string& erro) override;
+
+  EstatisticasCliente estatisticas();
+  void zerarEstatisticas();
+
+  // Usado pelos fluxos
+  void contarStream(uint64_t bytes, bool evento);
+  const std::string& getHost() const { return host; }
+  uint16_t getPorta() const { return porta; }
+  std::string alvo(const std::string& caminho) const;
+
+private:
+  std::string host;
+  uint16_t porta;
+  std::string consulta;
+
+  std::mutex mutexConexoes;
+  std::vector<int> conexoesLivres;
+
+  std::mutex mutexEstatisticas;
+  EstatisticasCliente contadores;
+
+  bool requisitar(OperacaoRTDB operacao, const std::string& metodo, const std::string& caminho,
+                  const std::string& corpo, std::string& resposta, std::string& erro);
+  int obterConexao();
+  void devolverConexao(int socket);
+};
+
+}  // namespace frota
+
+#endif
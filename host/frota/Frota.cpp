@@ -0,0 +1,234 @@
+#include "Frota.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "Conexao.h"
+#include "Simulacao.h"
+
+using simulacao::Json;
+
+namespace frota {
+
+namespace {
+
+typedef std::chrono::steady_clock Relogio;
+
+class Execucao {
+public:
+  Execucao(const ConfiguracaoFrota& configuracao, ClienteRTDBHTTP& app)
+      : configuracao(configuracao), app(app), ids(configuracao.dispositivos),
+        inicio(Relogio::now()) {}
+
+  void saco(int indice) {
+    char mac[18];
+    snprintf(mac, sizeof(mac), "02:00:00:%02X:%02X:%02X", (indice >> 16) & 0xFF,
+             (indice >> 8) & 0xFF, indice & 0xFF);
+    simulacao::definirMacThread(mac);
+
+    ConexaoManager conexao;
+    conexao.begin();  // Registro em /devices/<id>
+    if (configuracao.stream) {
+      conexao.beginCommandStream();
+    }
+    conexao.updateDeviceStatus("disponivel");
+    {
+      std::lock_guard<std::mutex> trava(mutex);
+      ids[indice] = conexao.deviceId.c_str();
+      prontos++;
+    }
+    mudou.notify_all();
+
+    // Mesmas requisições da tarefaComunicacao e de uma medição de força
+    uint32_t periodoMs = (uint32_t)(1000 / configuracao.hz);
+    while (!encerrado()) {
+      if (conexao.hasRemoteChanges()) {
+        String estado = conexao.getDeviceState();
+        if (estado == "ocupado" && conexao.checkForCommands()) {
+          Medicao medicao = conexao.getCurrentMeasurement();
+          if (conexao.updateDeviceEx()) {
+            registrarAtendimento(agoraMs() - medicao.timestampSolicitacao);
+            esperar(configuracao.duracaoMedicaoMs);
+            conexao.setMeasurementResult(random(50, 500));
+            conexao.updateDevicemMdicoes("concluida");
+            concluidos++;
+          }
+        }
+      }
+      esperar(periodoMs);
+    }
+  }
+
+  void aplicativo() {
+    // Comandos espalhados ao longo do período de cada saco
+    double periodoMs = 60000.0 / std::max(configuracao.comandosPorMinuto, 0.001);
+    std::vector<double> proximo(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+      proximo[i] = agoraMs() + periodoMs * (i + 0.5) / ids.size();
+    }
+    while (!encerrado()) {
+      size_t i = std::min_element(proximo.begin(), proximo.end()) - proximo.begin();
+      double espera = proximo[i] - agoraMs();
+      if (espera > 0) {
+        esperar((uint32_t)espera);
+        continue;
+      }
+      proximo[i] += periodoMs;
+
+      // Como a página: só pede uma medição quando a anterior terminou (o
+      // saco repete o estado em entrada/)
+      std::string caminho = "/devices/" + ids[i] + "/entrada";
+      Json estado;
+      std::string erro;
+      if (app.ler(caminho + "/estado", estado, erro) &&
+          (estado.comoTexto() == "solicitada" || estado.comoTexto() == "executando")) {
+        continue;
+      }
+      Json comando = Json::objeto();
+      comando.membros()["versao"] = Json(ESQUEMA_DISPOSITIVO);
+      comando.membros()["estado"] = Json("solicitada");
+      comando.membros()["tipo"] = Json("forca");
+      comando.membros()["usuario"] = Json("frota");
+      comando.membros()["timestampSolicitacao"] = Json((long long)agoraMs());
+      if (app.gravar(caminho, comando, erro)) {
+        enviados++;
+      }
+    }
+  }
+
+  bool aguardarRegistro(double limiteS) {
+    std::unique_lock<std::mutex> trava(mutex);
+    return mudou.wait_for(trava, std::chrono::duration<double>(limiteS),
+                          [this] { return prontos == (int)ids.size(); });
+  }
+
+  void ocuparTodos() {
+    std::string erro;
+    for (const std::string& id : ids) {
+      app.gravar("/devices/" + id + "/estado", Json("ocupado"), erro);
+    }
+  }
+
+  void encerrar() {
+    {
+      std::lock_guard<std::mutex> trava(mutex);
+      fim = true;
+    }
+    mudou.notify_all();
+  }
+
+  uint64_t agoraMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Relogio::now() - inicio).count();
+  }
+
+  void zerarContadores() {
+    std::lock_guard<std::mutex> trava(mutex);
+    latencias.clear();
+    enviados = 0;
+    atendidos = 0;
+    concluidos = 0;
+  }
+
+  const ConfiguracaoFrota& configuracao;
+  ClienteRTDBHTTP& app;
+  std::vector<std::string> ids;
+  std::vector<uint32_t> latencias;
+  std::atomic<uint64_t> enviados{0};
+  std::atomic<uint64_t> atendidos{0};
+  std::atomic<uint64_t> concluidos{0};
+  std::mutex mutex;
+
+private:
+  Relogio::time_point inicio;
+  std::condition_variable mudou;
+  int prontos = 0;
+  bool fim = false;
+
+  bool encerrado() {
+    std::lock_guard<std::mutex> trava(mutex);
+    return fim;
+  }
+
+  void esperar(uint32_t ms) {
+    std::unique_lock<std::mutex> trava(mutex);
+    mudou.wait_for(trava, std::chrono::milliseconds(ms), [this] { return fim; });
+  }
+
+  void registrarAtendimento(uint64_t latenciaMs) {
+    std::lock_guard<std::mutex> trava(mutex);
+    latencias.push_back((uint32_t)latenciaMs);
+    atendidos++;
+  }
+};
+
+}  // namespace
+
+double percentil(std::vector<uint32_t> valores, double p) {
+  if (valores.empty()) {
+    return 0;
+  }
+  std::sort(valores.begin(), valores.end());
+  size_t indice = (size_t)(p / 100.0 * (valores.size() - 1) + 0.5);
+  return valores[std::min(indice, valores.size() - 1)];
+}
+
+ResultadoFrota executarFrota(const ConfiguracaoFrota& configuracao, ClienteRTDBHTTP& sacos,
+                             ClienteRTDBHTTP& app, ServidorRTDB* servidor) {
+  ResultadoFrota resultado;
+  resultado.configuracao = configuracao;
+
+  simulacao::definirRTDB(&sacos);
+  Execucao execucao(configuracao, app);
+
+  auto inicioRegistro = Relogio::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < configuracao.dispositivos; i++) {
+    threads.emplace_back(&Execucao::saco, &execucao, i);
+  }
+  if (!execucao.aguardarRegistro(60)) {
+    fprintf(stderr, "frota: nem todos os sacos se registraram em 60 s\n");
+  }
+  resultado.registroS = std::chrono::duration<double>(Relogio::now() - inicioRegistro).count();
+  execucao.ocuparTodos();
+
+  // Janela medida: só o regime, sem o registro
+  sacos.zerarEstatisticas();
+  app.zerarEstatisticas();
+  execucao.zerarContadores();
+  if (servidor) {
+    servidor->zerarEstatisticas();
+  }
+  auto inicioJanela = Relogio::now();
+  std::thread aplicativo(&Execucao::aplicativo, &execucao);
+
+  std::this_thread::sleep_for(std::chrono::duration<double>(configuracao.duracaoS));
+  resultado.sacos = sacos.estatisticas();
+  resultado.app = app.estatisticas();
+  if (servidor) {
+    resultado.servidorLocal = true;
+    resultado.servidor = servidor->estatisticas();
+  }
+  resultado.segundos = std::chrono::duration<double>(Relogio::now() - inicioJanela).count();
+  {
+    std::lock_guard<std::mutex> trava(execucao.mutex);
+    resultado.latenciaComandoMs = execucao.latencias;
+  }
+  resultado.comandosEnviados = execucao.enviados;
+  resultado.comandosAtendidos = execucao.atendidos;
+  resultado.comandosConcluidos = execucao.concluidos;
+
+  execucao.encerrar();
+  aplicativo.join();
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  simulacao::definirRTDB(nullptr);
+  return resultado;
+}
+
+}  // namespace frota
@@ -0,0 +1,56 @@
+/**
+ * @file Frota.h
+ * @brief Simulação de N sacos contra um RTDB por HTTP
+ *
+ * Cada saco virtual é uma thread com o próprio ConexaoManager (MAC e
+ * deviceId próprios) repetindo as requisições da tarefaComunicacao:
+ * registro, leitura do estado e dos comandos a cada ciclo (ou só quando o
+ * stream avisa de mudanças) e a gravação dos resultados. Um "app" envia
+ * comandos de força aos sacos como a página web faz.
+ */
+#ifndef FROTA_FROTA_H
+#define FROTA_FROTA_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ClienteRTDBHTTP.h"
+#include "ServidorRTDB.h"
+
+namespace frota {
+
+struct ConfiguracaoFrota {
+  int dispositivos = 10;
+  double duracaoS = 20;            // Janela medida, depois do registro
+  double hz = 1;                   // Ciclos por segundo da tarefa de comunicação
+  bool stream = false;             // ConexaoManager::beginCommandStream()
+  double comandosPorMinuto = 6;    // Por saco
+  uint32_t duracaoMedicaoMs = 1000;
+};
+
+struct ResultadoFrota {
+  ConfiguracaoFrota configuracao;
+  double segundos = 0;             // Duração real da janela medida
+  double registroS = 0;            // Tempo até todos os sacos se registrarem
+  EstatisticasCliente sacos;       // Requisições feitas pelos sacos
+  EstatisticasCliente app;
+  uint64_t comandosEnviados = 0;
+  uint64_t comandosAtendidos = 0;  // O saco leu o comando e marcou "executando"
+  uint64_t comandosConcluidos = 0;
+  std::vector<uint32_t> latenciaComandoMs;  // Do envio pelo app até "executando"
+  bool servidorLocal = false;
+  EstatisticasServidor servidor = {};
+};
+
+// `sacos` é instalado como RTDB do shim durante a execução; `app` é usado
+// diretamente. Com o servidor local, as estatísticas dele cobrem a mesma
+// janela medida.
+ResultadoFrota executarFrota(const ConfiguracaoFrota& configuracao, ClienteRTDBHTTP& sacos,
+                             ClienteRTDBHTTP& app, ServidorRTDB* servidor = nullptr);
+
+// Percentil (0-100) de uma amostra; 0 se vazia
+double percentil(std::vector<uint32_t> valores, double p);
+
+}  // namespace frota
+
+#endif
@@ -0,0 +1,213 @@
+#include "Http.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace frota {
+
+namespace {
+
+bool receber(int socket, std::string& pendente) {
+  char bloco[4096];
+  ssize_t lidos = recv(socket, bloco, sizeof(bloco), 0);
+  if (lidos <= 0) {
+    return false;
+  }
+  pendente.append(bloco, lidos);
+  return true;
+}
+
+std::string minusculas(std::string texto) {
+  std::transform(texto.begin(), texto.end(), texto.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return texto;
+}
+
+std::string aparar(const std::string& texto) {
+  size_t inicio = texto.find_first_not_of(" \t\r");
+  size_t fim = texto.find_last_not_of(" \t\r");
+  return inicio == std::string::npos ? "" : texto.substr(inicio, fim - inicio + 1);
+}
+
+}  // namespace
+
+std::string MensagemHttp::cabecalho(const std::string& nome) const {
+  auto item = cabecalhos.find(nome);
+  return item == cabecalhos.end() ? "" : item->second;
+}
+
+bool lerMensagem(int socket, std::string& pendente, MensagemHttp& mensagem,
+                 bool requisicao, bool semCorpo) {
+  mensagem = MensagemHttp();
+  size_t fimCabecalhos;
+  while ((fimCabecalhos = pendente.find("\r\n\r\n")) == std::string::npos) {
+    if (pendente.size() > 64 * 1024 || !receber(socket, pendente)) {
+      return false;
+    }
+  }
+
+  std::string cabecalhos = pendente.substr(0, fimCabecalhos);
+  size_t fimLinha = cabecalhos.find("\r\n");
+  std::string primeira = cabecalhos.substr(0, fimLinha);
+  if (requisicao) {
+    size_t espaco1 = primeira.find(' ');
+    size_t espaco2 = primeira.find(' ', espaco1 + 1);
+    if (espaco1 == std::string::npos || espaco2 == std::string::npos) {
+      return false;
+    }
+    mensagem.metodo = primeira.substr(0, espaco1);
+    mensagem.alvo = primeira.substr(espaco1 + 1, espaco2 - espaco1 - 1);
+  } else {
+    size_t espaco = primeira.find(' ');
+    if (espaco == std::string::npos) {
+      return false;
+    }
+    mensagem.status = atoi(primeira.c_str() + espaco + 1);
+  }
+
+  size_t posicao = fimLinha == std::string::npos ? cabecalhos.size() : fimLinha + 2;
+  while (posicao < cabecalhos.size()) {
+    size_t fim = cabecalhos.find("\r\n", posicao);
+    if (fim == std::string::npos) fim = cabecalhos.size();
+    std::string linha = cabecalhos.substr(posicao, fim - posicao);
+    size_t doisPontos = linha.find(':');
+    if (doisPontos != std::string::npos) {
+      mensagem.cabecalhos[minusculas(aparar(linha.substr(0, doisPontos)))] =
+          aparar(linha.substr(doisPontos + 1));
+    }
+    posicao = fim + 2;
+  }
+  pendente.erase(0, fimCabecalhos + 4);
+  mensagem.bytes = fimCabecalhos + 4;
+  if (semCorpo) {
+    return true;
+  }
+
+  size_t tamanho = strtoul(mensagem.cabecalho("content-length").c_str(), nullptr, 10);
+  while (pendente.size() < tamanho) {
+    if (!receber(socket, pendente)) {
+      return false;
+    }
+  }
+  mensagem.corpo = pendente.substr(0, tamanho);
+  pendente.erase(0, tamanho);
+  mensagem.bytes += tamanho;
+  return true;
+}
+
+bool lerLinha(int socket, std::string& pendente, std::string& linha) {
+  size_t fim;
+  while ((fim = pendente.find('\n')) == std::string::npos) {
+    if (!receber(socket, pendente)) {
+      return false;
+    }
+  }
+  linha = pendente.substr(0, fim);
+  if (!linha.empty() && linha.back() == '\r') {
+    linha.pop_back();
+  }
+  pendente.erase(0, fim + 1);
+  return true;
+}
+
+bool enviarTudo(int socket, const std::string& dados) {
+  size_t enviados = 0;
+  while (enviados < dados.size()) {
+    ssize_t n = send(socket, dados.data() + enviados, dados.size() - enviados, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return false;
+    }
+    enviados += n;
+  }
+  return true;
+}
+
+std::string codificarCaminho(const std::string& caminho) {
+  static const char* hex = "0123456789ABCDEF";
+  std::string saida;
+  for (unsigned char c : caminho) {
+    if (std::isalnum(c) || c == '/' || c == '-' || c == '_' || c == '.' || c == '~') {
+      saida += c;
+    } else {
+      saida += '%';
+      saida += hex[c >> 4];
+      saida += hex[c & 15];
+    }
+  }
+  return saida;
+}
+
+std::string decodificarCaminho(const std::string& caminho) {
+  std::string saida;
+  for (size_t i = 0; i < caminho.size(); i++) {
+    if (caminho[i] == '%' && i + 2 < caminho.size()) {
+      saida += (char)strtol(caminho.substr(i + 1, 2).c_str(), nullptr, 16);
+      i += 2;
+    } else {
+      saida += caminho[i];
+    }
+  }
+  return saida;
+}
+
+int conectar(const std::string& host, uint16_t porta) {
+  addrinfo dicas = {};
+  dicas.ai_family = AF_UNSPEC;
+  dicas.ai_socktype = SOCK_STREAM;
+  addrinfo* enderecos = nullptr;
+  if (getaddrinfo(host.c_str(), std::to_string(porta).c_str(), &dicas, &enderecos) != 0) {
+    return -1;
+  }
+  int s = -1;
+  for (addrinfo* e = enderecos; e; e = e->ai_next) {
+    s = socket(e->ai_family, e->ai_socktype, e->ai_protocol);
+    if (s < 0) continue;
+    if (connect(s, e->ai_addr, e->ai_addrlen) == 0) break;
+    close(s);
+    s = -1;
+  }
+  freeaddrinfo(enderecos);
+  if (s >= 0) {
+    int ligado = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &ligado, sizeof(ligado));
+  }
+  return s;
+}
+
+int escutar(uint16_t porta, uint16_t& portaEscolhida) {
+  int s = socket(AF_INET, SOCK_STREAM, 0);
+  if (s < 0) return -1;
+  int ligado = 1;
+  setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &ligado, sizeof(ligado));
+
+  sockaddr_in endereco = {};
+  endereco.sin_family = AF_INET;
+  endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  endereco.sin_port = htons(porta);
+  if (bind(s, (sockaddr*)&endereco, sizeof(endereco)) != 0 || listen(s, 512) != 0) {
+    close(s);
+    return -1;
+  }
+  socklen_t tamanho = sizeof(endereco);
+  getsockname(s, (sockaddr*)&endereco, &tamanho);
+  portaEscolhida = ntohs(endereco.sin_port);
+  return s;
+}
+
+void fecharSocket(int socket) {
+  if (socket >= 0) {
+    shutdown(socket, SHUT_RDWR);
+    close(socket);
+  }
+}
+
+}  // namespace frota
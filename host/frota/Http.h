@@ -0,0 +1,50 @@
+/**
+ * @file Http.h
+ * @brief HTTP/1.1 mínimo (sockets POSIX) do servidor e do cliente do RTDB local
+ *
+ * Só o necessário para a API REST do Realtime Database: mensagens com
+ * Content-Length, conexões keep-alive e respostas text/event-stream (SSE).
+ */
+#ifndef FROTA_HTTP_H
+#define FROTA_HTTP_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace frota {
+
+struct MensagemHttp {
+  // Requisição: metodo e alvo; resposta: status
+  std::string metodo;
+  std::string alvo;
+  int status = 0;
+  std::map<std::string, std::string> cabecalhos;  // Nomes em minúsculas
+  std::string corpo;
+  size_t bytes = 0;  // Tamanho total na conexão (linha, cabeçalhos e corpo)
+
+  std::string cabecalho(const std::string& nome) const;
+};
+
+// Lê uma mensagem completa de `socket`. `pendente` guarda os bytes já
+// recebidos além da mensagem (keep-alive) e deve ser reaproveitado.
+// semCorpo: só lê até o fim dos cabeçalhos (resposta de um stream).
+bool lerMensagem(int socket, std::string& pendente, MensagemHttp& mensagem,
+                 bool requisicao, bool semCorpo = false);
+
+// Lê até o próximo '\n' (linhas de eventos SSE), sem o "\r\n"
+bool lerLinha(int socket, std::string& pendente, std::string& linha);
+
+bool enviarTudo(int socket, const std::string& dados);
+
+std::string codificarCaminho(const std::string& caminho);
+std::string decodificarCaminho(const std::string& caminho);
+
+// Conexões TCP locais ou remotas; -1 em caso de erro
+int conectar(const std::string& host, uint16_t porta);
+int escutar(uint16_t porta, uint16_t& portaEscolhida);
+void fecharSocket(int socket);
+
+}  // namespace frota
+
+#endif
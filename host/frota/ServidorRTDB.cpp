@@ -0,0 +1,240 @@
+#include "ServidorRTDB.h"
+
+#include <sys/socket.h>
+
+#include <chrono>
+
+#include "Http.h"
+
+using simulacao::Json;
+
+namespace frota {
+
+namespace {
+
+const char* textoStatus(int status) {
+  switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+  }
+  return "Error";
+}
+
+// "/devices/abc.json?ns=x" -> "/devices/abc"; false se não for .json
+bool caminhoDoAlvo(const std::string& alvo, std::string& caminho) {
+  caminho = decodificarCaminho(alvo.substr(0, alvo.find('?')));
+  const std::string sufixo = ".json";
+  if (caminho.size() < sufixo.size() ||
+      caminho.compare(caminho.size() - sufixo.size(), sufixo.size(), sufixo) != 0) {
+    return false;
+  }
+  caminho.erase(caminho.size() - sufixo.size());
+  if (caminho.empty()) {
+    caminho = "/";
+  }
+  return true;
+}
+
+std::string erroJson(const std::string& mensagem) {
+  Json erro = Json::objeto();
+  erro.membros()["error"] = Json(mensagem);
+  return erro.serializar();
+}
+
+}  // namespace
+
+ServidorRTDB::ServidorRTDB() {}
+
+ServidorRTDB::~ServidorRTDB() {
+  parar();
+}
+
+bool ServidorRTDB::iniciar(uint16_t porta) {
+  if (rodando) {
+    return true;
+  }
+  socketEscuta = escutar(porta, portaAtual);
+  if (socketEscuta < 0) {
+    return false;
+  }
+  rodando = true;
+  aceitador = std::thread(&ServidorRTDB::aceitar, this);
+  return true;
+}
+
+void ServidorRTDB::parar() {
+  if (!rodando.exchange(false)) {
+    return;
+  }
+  shutdown(socketEscuta, SHUT_RDWR);
+  aceitador.join();
+  fecharSocket(socketEscuta);
+  socketEscuta = -1;
+
+  std::vector<std::thread> pendentes;
+  {
+    std::lock_guard<std::mutex> trava(mutexConexoes);
+    for (int s : sockets) {
+      shutdown(s, SHUT_RDWR);  // Acorda os atendentes bloqueados em recv()
+    }
+    pendentes.swap(atendentes);
+  }
+  for (std::thread& t : pendentes) {
+    t.join();
+  }
+}
+
+EstatisticasServidor ServidorRTDB::estatisticas() {
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  return contadores;
+}
+
+void ServidorRTDB::zerarEstatisticas() {
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  uint32_t ativas = contadores.conexoesAtivas;
+  contadores = EstatisticasServidor();
+  contadores.conexoesAtivas = ativas;
+  contadores.conexoesMaximas = ativas;
+}
+
+void ServidorRTDB::contar(uint64_t EstatisticasServidor::*campo, uint64_t quantidade) {
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  contadores.*campo += quantidade;
+}
+
+void ServidorRTDB::aceitar() {
+  while (rodando) {
+    int cliente = accept(socketEscuta, nullptr, nullptr);
+    if (cliente < 0) {
+      continue;  // parar() derruba o socket e encerra o laço
+    }
+    std::lock_guard<std::mutex> trava(mutexConexoes);
+    if (!rodando) {
+      fecharSocket(cliente);
+      break;
+    }
+    sockets.insert(cliente);
+    atendentes.emplace_back(&ServidorRTDB::atender, this, cliente);
+  }
+}
+
+bool ServidorRTDB::responder(int socket, int status, const std::string& corpo) {
+  std::string resposta = "HTTP/1.1 " + std::to_string(status) + " " + textoStatus(status) +
+                         "\r\nContent-Type: application/json; charset=utf-8"
+                         "\r\nContent-Length: " + std::to_string(corpo.size()) +
+                         "\r\nConnection: keep-alive\r\n\r\n" + corpo;
+  contar(&EstatisticasServidor::bytesSaida, resposta.size());
+  if (status >= 400) {
+    contar(&EstatisticasServidor::erros);
+  }
+  return enviarTudo(socket, resposta);
+}
+
+void ServidorRTDB::atender(int socket) {
+  {
+    std::lock_guard<std::mutex> trava(mutexEstatisticas);
+    contadores.conexoesAtivas++;
+    if (contadores.conexoesAtivas > contadores.conexoesMaximas) {
+      contadores.conexoesMaximas = contadores.conexoesAtivas;
+    }
+  }
+
+  std::string pendente;
+  MensagemHttp requisicao;
+  while (rodando && lerMensagem(socket, pendente, requisicao, true)) {
+    contar(&EstatisticasServidor::bytesEntrada, requisicao.bytes);
+
+    std::string caminho;
+    if (!caminhoDoAlvo(requisicao.alvo, caminho)) {
+      if (!responder(socket, 404, erroJson("404 Not Found"))) break;
+      continue;
+    }
+
+    std::string erro;
+    bool continuar = true;
+    if (requisicao.metodo == "GET" &&
+        requisicao.cabecalho("accept").find("text/event-stream") != std::string::npos) {
+      transmitir(socket, caminho);
+      break;  // O stream ocupa a conexão até cair
+    } else if (requisicao.metodo == "GET") {
+      contar(&EstatisticasServidor::leituras);
+      Json valor;
+      dados.ler(caminho, valor, erro);  // Nó inexistente: null, como no RTDB
+      continuar = responder(socket, 200, valor.serializar());
+    } else if (requisicao.metodo == "PUT" || requisicao.metodo == "PATCH") {
+      Json valor;
+      if (!Json::interpretar(requisicao.corpo, valor)) {
+        continuar = responder(socket, 400, erroJson("Invalid data; couldn't parse JSON object"));
+        continue;
+      }
+      bool ok;
+      if (requisicao.metodo == "PUT") {
+        contar(&EstatisticasServidor::gravacoes);
+        ok = dados.gravar(caminho, valor, erro);
+      } else {
+        contar(&EstatisticasServidor::atualizacoes);
+        ok = dados.atualizar(caminho, valor, erro);
+      }
+      continuar = ok ? responder(socket, 200, requisicao.corpo)
+                     : responder(socket, 400, erroJson(erro));
+    } else if (requisicao.metodo == "DELETE") {
+      contar(&EstatisticasServidor::remocoes);
+      dados.remover(caminho, erro);
+      continuar = responder(socket, 200, "null");
+    } else {
+      continuar = responder(socket, 405, erroJson("Method not allowed"));
+    }
+    if (!continuar || requisicao.cabecalho("connection") == "close") {
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> trava(mutexConexoes);
+    sockets.erase(socket);
+    fecharSocket(socket);
+  }
+  std::lock_guard<std::mutex> trava(mutexEstatisticas);
+  contadores.conexoesAtivas--;
+}
+
+void ServidorRTDB::transmitir(int socket, const std::string& caminho) {
+  contar(&EstatisticasServidor::streams);
+  std::string erro;
+  std::shared_ptr<simulacao::FluxoRTDB> fluxo = dados.observar(caminho, erro);
+
+  std::string cabecalhos =
+      "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+      "Cache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n";
+  contar(&EstatisticasServidor::bytesSaida, cabecalhos.size());
+  if (!enviarTudo(socket, cabecalhos)) {
+    return;
+  }
+
+  auto ultimoEnvio = std::chrono::steady_clock::now();
+  while (rodando) {
+    simulacao::EventoRTDB evento;
+    std::string mensagem;
+    if (fluxo->proximo(evento, 200)) {
+      Json conteudo = Json::objeto();
+      conteudo.membros()["path"] = Json(evento.caminho);
+      conteudo.membros()["data"] = evento.dados;
+      mensagem = "event: " + evento.tipo + "\ndata: " + conteudo.serializar() + "\n\n";
+      contar(&EstatisticasServidor::eventos);
+    } else if (std::chrono::steady_clock::now() - ultimoEnvio >
+               std::chrono::milliseconds(keepAliveMs.load())) {
+      mensagem = "event: keep-alive\ndata: null\n\n";
+    } else {
+      continue;
+    }
+    contar(&EstatisticasServidor::bytesSaida, mensagem.size());
+    if (!enviarTudo(socket, mensagem)) {
+      return;
+    }
+    ultimoEnvio = std::chrono::steady_clock::now();
+  }
+}
+
+}  // namespace frota
@@ -0,0 +1,80 @@
+/**
+ * @file ServidorRTDB.h
+ * @brief Servidor HTTP local compatível com a API REST do Realtime Database
+ *
+ * Atende GET, PUT, PATCH e DELETE em "/<caminho>.json" sobre um
+ * RTDBMemoria, e streams SSE (Accept: text/event-stream) com os eventos
+ * "put"/"patch"/"keep-alive" do RTDB. Serve de alvo para o simulador de
+ * frota sem gastar a cota do projeto real; o emulador do Firebase também
+ * pode ser usado no lugar dele (simulador_frota --servidor).
+ */
+#ifndef FROTA_SERVIDOR_RTDB_H
+#define FROTA_SERVIDOR_RTDB_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RTDB.h"
+
+namespace frota {
+
+struct EstatisticasServidor {
+  uint64_t leituras;
+  uint64_t gravacoes;
+  uint64_t atualizacoes;
+  uint64_t remocoes;
+  uint64_t streams;      // Streams abertos
+  uint64_t eventos;      // Eventos SSE enviados (sem keep-alive)
+  uint64_t erros;        // Respostas 4xx
+  uint64_t bytesEntrada;
+  uint64_t bytesSaida;
+  uint32_t conexoesAtivas;
+  uint32_t conexoesMaximas;
+};
+
+class ServidorRTDB {
+public:
+  ServidorRTDB();
+  ~ServidorRTDB();
+
+  bool iniciar(uint16_t porta = 0);  // 0: escolhe uma porta livre
+  void parar();
+  uint16_t porta() const { return portaAtual; }
+
+  simulacao::RTDBMemoria& banco() { return dados; }
+  EstatisticasServidor estatisticas();
+  void zerarEstatisticas();
+
+  // Intervalo dos eventos keep-alive dos streams (o RTDB usa 30 s)
+  void definirKeepAlive(uint32_t ms) { keepAliveMs = ms; }
+
+private:
+  simulacao::RTDBMemoria dados;
+  int socketEscuta = -1;
+  uint16_t portaAtual = 0;
+  std::atomic<bool> rodando{false};
+  std::atomic<uint32_t> keepAliveMs{30000};
+  std::thread aceitador;
+
+  std::mutex mutexConexoes;
+  std::vector<std::thread> atendentes;
+  std::set<int> sockets;
+
+  std::mutex mutexEstatisticas;
+  EstatisticasServidor contadores = {};
+
+  void aceitar();
+  void atender(int socket);
+  void transmitir(int socket, const std::string& caminho);
+  bool responder(int socket, int status, const std::string& corpo);
+  void contar(uint64_t EstatisticasServidor::*campo, uint64_t quantidade = 1);
+};
+
+}  // namespace frota
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file GeradorDelta.cpp
+ * @brief Busca gulosa de trechos na base e na janela
+ */
+#include "GeradorDelta.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Delta.h"
+
+namespace ota {
+
+namespace {
+
+const int BITS_HASH = 16;
+const int CADEIA = 32;            // Candidatos olhados por posição
+const size_t MINIMO_TRECHO = 4;
+
+uint32_t hash4(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return (v * 2654435761u) >> (32 - BITS_HASH);
+}
+
+size_t comum(const uint8_t* a, const uint8_t* b, size_t limite) {
+  size_t n = 0;
+  while (n < limite && a[n] == b[n]) {
+    n++;
+  }
+  return n;
+}
+
+size_t bytesVarint(uint32_t valor) {
+  size_t n = 1;
+  while (valor >= 0x80) {
+    valor >>= 7;
+    n++;
+  }
+  return n;
+}
+
+uint32_t zigzag(int32_t valor) {
+  return ((uint32_t)valor << 1) ^ (uint32_t)(valor >> 31);
+}
+
+class Escritor {
+public:
+  explicit Escritor(std::vector<uint8_t>& saida) : saida(saida) {}
+
+  void varint(uint32_t valor) {
+    while (valor >= 0x80) {
+      saida.push_back((uint8_t)(valor | 0x80));
+      valor >>= 7;
+    }
+    saida.push_back((uint8_t)valor);
+  }
+
+  void op(OpDelta op) { saida.push_back((uint8_t)op); }
+
+  void literal(const uint8_t* dados, size_t tamanho) {
+    if (tamanho == 0) {
+      return;
+    }
+    op(OpDelta::Literal);
+    varint((uint32_t)tamanho);
+    saida.insert(saida.end(), dados, dados + tamanho);
+  }
+
+private:
+  std::vector<uint8_t>& saida;
+};
+
+}  // namespace
+
+std::vector<uint8_t> gerarDelta(const std::vector<uint8_t>& base, const std::vector<uint8_t>& alvo,
+                                EstatisticasDelta* estatisticas) {
+  EstatisticasDelta contagem;
+  std::vector<uint8_t> saida;
+  CabecalhoDelta cabecalho;
+  cabecalho.magico = DELTA_MAGICO;
+  cabecalho.tamanhoBase = (uint32_t)base.size();
+  cabecalho.crcBase = crc32Delta(0, base.data(), base.size());
+  cabecalho.tamanhoAlvo = (uint32_t)alvo.size();
+  cabecalho.crcAlvo = crc32Delta(0, alvo.data(), alvo.size());
+  const uint8_t* bytesCabecalho = (const uint8_t*)&cabecalho;
+  saida.insert(saida.end(), bytesCabecalho, bytesCabecalho + sizeof(cabecalho));
+  Escritor escritor(saida);
+
+  // Cadeias de posições com o mesmo hash, a mais recente primeiro
+  std::vector<int32_t> cabecaBase(1 << BITS_HASH, -1);
+  std::vector<int32_t> anteriorBase(base.size(), -1);
+  for (size_t p = 0; p + MINIMO_TRECHO <= base.size(); p++) {
+    uint32_t h = hash4(&base[p]);
+    anteriorBase[p] = cabecaBase[h];
+    cabecaBase[h] = (int32_t)p;
+  }
+  std::vector<int32_t> cabecaJanela(1 << BITS_HASH, -1);
+  std::vector<int32_t> anteriorJanela(alvo.size(), -1);
+  auto indexar = [&](size_t p) {
+    if (p + MINIMO_TRECHO <= alvo.size()) {
+      uint32_t h = hash4(&alvo[p]);
+      anteriorJanela[p] = cabecaJanela[h];
+      cabecaJanela[h] = (int32_t)p;
+    }
+  };
+
+  size_t proximaBase = 0;
+  size_t inicioLiteral = 0;
+  size_t i = 0;
+  while (i < alvo.size()) {
+    size_t restante = alvo.size() - i;
+    OpDelta melhorOp = OpDelta::Literal;
+    size_t melhorTamanho = 0;
+    size_t melhorOrigem = 0;
+    long melhorGanho = 0;
+
+    // Ganho: bytes cobertos menos o custo da operação no delta
+    auto considerar = [&](OpDelta op, size_t origem, size_t tamanho) {
+      if (tamanho < MINIMO_TRECHO) {
+        return;
+      }
+      size_t custo = 1 + bytesVarint((uint32_t)tamanho);
+      if (op == OpDelta::CopiaBase) {
+        custo += bytesVarint(zigzag((int32_t)(origem - proximaBase)));
+      } else {
+        custo += bytesVarint((uint32_t)(i - origem));
+      }
+      long ganho = (long)tamanho - (long)custo;
+      if (ganho > melhorGanho) {
+        melhorGanho = ganho;
+        melhorOp = op;
+        melhorTamanho = tamanho;
+        melhorOrigem = origem;
+      }
+    };
+
+    if (proximaBase < base.size()) {
+      size_t limite = std::min(restante, base.size() - proximaBase);
+      considerar(OpDelta::CopiaBase, proximaBase, comum(&base[proximaBase], &alvo[i], limite));
+    }
+    if (restante >= MINIMO_TRECHO) {
+      uint32_t h = hash4(&alvo[i]);
+      int olhados = 0;
+      for (int32_t p = cabecaBase[h]; p >= 0 && olhados < CADEIA; p = anteriorBase[p], olhados++) {
+        size_t limite = std::min(restante, base.size() - (size_t)p);
+        considerar(OpDelta::CopiaBase, (size_t)p, comum(&base[p], &alvo[i], limite));
+      }
+      olhados = 0;
+      for (int32_t p = cabecaJanela[h]; p >= 0 && olhados < CADEIA; p = anteriorJanela[p], olhados++) {
+        if (i - (size_t)p > DELTA_JANELA) {
+          break;
+        }
+        // A cópia pode passar de i: o aplicador repete o trecho
+        considerar(OpDelta::CopiaJanela, (size_t)p, comum(&alvo[p], &alvo[i], restante));
+      }
+    }
+
+    if (melhorTamanho == 0) {
+      indexar(i);
+      i++;
+      continue;
+    }
+
+    escritor.literal(alvo.data() + inicioLiteral, i - inicioLiteral);
+    contagem.literais += i - inicioLiteral;
+    escritor.op(melhorOp);
+    if (melhorOp == OpDelta::CopiaBase) {
+      escritor.varint(zigzag((int32_t)(melhorOrigem - proximaBase)));
+      proximaBase = melhorOrigem + melhorTamanho;
+      contagem.copiasBase++;
+      contagem.bytesBase += melhorTamanho;
+    } else {
+      escritor.varint((uint32_t)(i - melhorOrigem));
+      contagem.copiasJanela++;
+      contagem.bytesJanela += melhorTamanho;
+    }
+    escritor.varint((uint32_t)melhorTamanho);
+    for (size_t k = 0; k < melhorTamanho; k++) {
+      indexar(i + k);
+    }
+    i += melhorTamanho;
+    inicioLiteral = i;
+  }
+  escritor.literal(alvo.data() + inicioLiteral, alvo.size() - inicioLiteral);
+  contagem.literais += alvo.size() - inicioLiteral;
+  escritor.op(OpDelta::Fim);
+
+  if (estatisticas) {
+    *estatisticas = contagem;
+  }
+  return saida;
+}
+
+}  // namespace ota
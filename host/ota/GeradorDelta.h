@@ -0,0 +1,34 @@
+/**
+ * @file GeradorDelta.h
+ * @brief Gera o delta (saco/Delta.h) entre duas imagens de firmware
+ *
+ * Guloso: em cada posição da imagem nova procura o trecho igual mais longo
+ * entre a continuação da última cópia da base, a base inteira (hash de 4
+ * bytes, com cadeias curtas) e a janela dos últimos
+ * DELTA_JANELA bytes gerados. Sem nenhum trecho bom o byte vai como
+ * literal. Não é o menor delta possível, mas é rápido e determinístico.
+ */
+#ifndef OTA_GERADOR_DELTA_H
+#define OTA_GERADOR_DELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ota {
+
+struct EstatisticasDelta {
+  size_t copiasBase = 0;
+  size_t bytesBase = 0;
+  size_t copiasJanela = 0;
+  size_t bytesJanela = 0;
+  size_t literais = 0;  // Bytes
+};
+
+// Base vazia: imagem completa comprimida
+std::vector<uint8_t> gerarDelta(const std::vector<uint8_t>& base, const std::vector<uint8_t>& alvo,
+                                EstatisticasDelta* estatisticas = nullptr);
+
+}  // namespace ota
+
+#endif
@@ -0,0 +1,151 @@
+#include "ServidorOta.h"
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "Http.h"
+
+using namespace frota;
+
+namespace ota {
+
+ServidorOta::~ServidorOta() {
+  parar();
+}
+
+bool ServidorOta::iniciar(uint16_t porta) {
+  if (rodando) {
+    return true;
+  }
+  socketEscuta = escutar(porta, portaAtual);
+  if (socketEscuta < 0) {
+    return false;
+  }
+  rodando = true;
+  aceitador = std::thread(&ServidorOta::aceitar, this);
+  return true;
+}
+
+void ServidorOta::parar() {
+  if (!rodando.exchange(false)) {
+    return;
+  }
+  shutdown(socketEscuta, SHUT_RDWR);
+  aceitador.join();
+  fecharSocket(socketEscuta);
+  socketEscuta = -1;
+
+  std::vector<std::thread> pendentes;
+  {
+    std::lock_guard<std::mutex> trava(mutexConexoes);
+    for (int s : sockets) {
+      shutdown(s, SHUT_RDWR);
+    }
+    pendentes.swap(atendentes);
+  }
+  for (std::thread& t : pendentes) {
+    t.join();
+  }
+}
+
+std::string ServidorOta::url() const {
+  return "http://127.0.0.1:" + std::to_string(portaAtual);
+}
+
+void ServidorOta::publicar(const std::string& caminho, const std::vector<uint8_t>& dados) {
+  publicar(caminho, std::string(dados.begin(), dados.end()));
+}
+
+void ServidorOta::publicar(const std::string& caminho, const std::string& texto) {
+  std::lock_guard<std::mutex> trava(mutexArquivos);
+  arquivos[caminho] = texto;
+}
+
+void ServidorOta::remover(const std::string& caminho) {
+  std::lock_guard<std::mutex> trava(mutexArquivos);
+  arquivos.erase(caminho);
+}
+
+uint32_t ServidorOta::requisicoes(const std::string& caminho) {
+  std::lock_guard<std::mutex> trava(mutexArquivos);
+  return contagemRequisicoes[caminho];
+}
+
+uint64_t ServidorOta::bytesEnviados(const std::string& caminho) {
+  std::lock_guard<std::mutex> trava(mutexArquivos);
+  return contagemBytes[caminho];
+}
+
+void ServidorOta::aceitar() {
+  while (rodando) {
+    int cliente = accept(socketEscuta, nullptr, nullptr);
+    if (cliente < 0) {
+      continue;  // parar() derruba o socket e encerra o laço
+    }
+    std::lock_guard<std::mutex> trava(mutexConexoes);
+    if (!rodando) {
+      fecharSocket(cliente);
+      break;
+    }
+    sockets.insert(cliente);
+    atendentes.emplace_back(&ServidorOta::atender, this, cliente);
+  }
+}
+
+void ServidorOta::atender(int socket) {
+  std::string pendente;
+  MensagemHttp requisicao;
+  while (rodando && lerMensagem(socket, pendente, requisicao, true)) {
+    std::string caminho = decodificarCaminho(requisicao.alvo.substr(0, requisicao.alvo.find('?')));
+    std::string corpo;
+    bool existe;
+    {
+      std::lock_guard<std::mutex> trava(mutexArquivos);
+      contagemRequisicoes[caminho]++;
+      auto arquivo = arquivos.find(caminho);
+      existe = arquivo != arquivos.end();
+      if (existe) {
+        corpo = arquivo->second;
+      }
+    }
+    if (requisicao.metodo != "GET" || !existe) {
+      std::string resposta = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n"
+                             "Connection: keep-alive\r\n\r\n";
+      if (!enviarTudo(socket, resposta)) break;
+      continue;
+    }
+    std::string cabecalhos = "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream"
+                             "\r\nContent-Length: " + std::to_string(corpo.size()) +
+                             "\r\nConnection: keep-alive\r\n\r\n";
+    if (!enviarTudo(socket, cabecalhos) || !enviarCorpo(socket, caminho, corpo)) break;
+  }
+
+  std::lock_guard<std::mutex> trava(mutexConexoes);
+  sockets.erase(socket);
+  fecharSocket(socket);
+}
+
+// Em blocos de 1 KB; com taxa limitada, cada bloco espera a sua vez
+bool ServidorOta::enviarCorpo(int socket, const std::string& caminho, const std::string& corpo) {
+  const size_t BLOCO = 1024;
+  auto inicio = std::chrono::steady_clock::now();
+  for (size_t enviados = 0; enviados < corpo.size() && rodando;) {
+    size_t n = std::min(BLOCO, corpo.size() - enviados);
+    uint32_t limite = taxa;
+    if (limite > 0) {
+      auto vez = inicio + std::chrono::microseconds((uint64_t)enviados * 1000000 / limite);
+      std::this_thread::sleep_until(vez);
+    }
+    if (!enviarTudo(socket, corpo.substr(enviados, n))) {
+      return false;
+    }
+    enviados += n;
+    std::lock_guard<std::mutex> trava(mutexArquivos);
+    contagemBytes[caminho] += n;
+  }
+  return rodando;
+}
+
+}  // namespace ota
@@ -0,0 +1,68 @@
+/**
+ * @file ServidorOta.h
+ * @brief Servidor HTTP local das atualizações OTA (no lugar de um CDN)
+ *
+ * Serve por GET os arquivos publicados: o manifesto e as imagens (deltas e
+ * completas, saco/Delta.h). Pode limitar a taxa de envio, para simular o
+ * WiFi fraco de uma academia, e conta o que cada arquivo mandou. Os testes
+ * de OTA e a ferramenta servidor_ota usam o mesmo.
+ */
+#ifndef OTA_SERVIDOR_OTA_H
+#define OTA_SERVIDOR_OTA_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ota {
+
+class ServidorOta {
+public:
+  ServidorOta() {}
+  ~ServidorOta();
+
+  bool iniciar(uint16_t porta = 0);  // 0: escolhe uma porta livre
+  void parar();
+  uint16_t porta() const { return portaAtual; }
+  std::string url() const;           // "http://127.0.0.1:<porta>"
+
+  // "/manifesto.txt", "/saco-1.1.0.sdl"...
+  void publicar(const std::string& caminho, const std::vector<uint8_t>& dados);
+  void publicar(const std::string& caminho, const std::string& texto);
+  void remover(const std::string& caminho);
+
+  // 0: sem limite
+  void limitarTaxa(uint32_t bytesPorSegundo) { taxa = bytesPorSegundo; }
+
+  uint32_t requisicoes(const std::string& caminho);
+  uint64_t bytesEnviados(const std::string& caminho);
+
+private:
+  int socketEscuta = -1;
+  uint16_t portaAtual = 0;
+  std::atomic<bool> rodando{false};
+  std::atomic<uint32_t> taxa{0};
+  std::thread aceitador;
+
+  std::mutex mutexConexoes;
+  std::vector<std::thread> atendentes;
+  std::set<int> sockets;
+
+  std::mutex mutexArquivos;
+  std::map<std::string, std::string> arquivos;
+  std::map<std::string, uint32_t> contagemRequisicoes;
+  std::map<std::string, uint64_t> contagemBytes;
+
+  void aceitar();
+  void atender(int socket);
+  bool enviarCorpo(int socket, const std::string& caminho, const std::string& corpo);
+};
+
+}  // namespace ota
+
+#endif
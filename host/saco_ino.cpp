@@ -0,0 +1,8 @@
+/**
+ * @file saco_ino.cpp
+ * @brief Compila o sketch saco.ino como C++ comum no build nativo
+ *
+ * O Arduino inclui Arduino.h implicitamente no sketch; aqui isso é explícito.
+ */
+#include <Arduino.h>
+#include "../saco/saco.ino"
@@ -0,0 +1,278 @@
+#include "Adafruit_GFX.h"
+
+#include <utility>
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+  : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t cor) {
+  // Bresenham, como writeLine() da Adafruit
+  bool ingreme = abs(y1 - y0) > abs(x1 - x0);
+  if (ingreme) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t erro = dx / 2;
+  int16_t passoY = y0 < y1 ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    if (ingreme) {
+      drawPixel(y0, x0, cor);
+    } else {
+      drawPixel(x0, y0, cor);
+    }
+    erro -= dy;
+    if (erro < 0) {
+      y0 += passoY;
+      erro += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t cor) {
+  drawLine(x, y, x, y + h - 1, cor);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t cor) {
+  drawLine(x, y, x + w - 1, y, cor);
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t cor) {
+  drawFastHLine(x, y, w, cor);
+  drawFastHLine(x, y + h - 1, w, cor);
+  drawFastVLine(x, y, h, cor);
+  drawFastVLine(x + w - 1, y, h, cor);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t cor) {
+  for (int16_t i = x; i < x + w; i++) {
+    drawFastVLine(i, y, h, cor);
+  }
+}
+
+void Adafruit_GFX::fillScreen(uint16_t cor) {
+  fillRect(0, 0, _width, _height, cor);
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t cor) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  drawPixel(x0, y0 + r, cor);
+  drawPixel(x0, y0 - r, cor);
+  drawPixel(x0 + r, y0, cor);
+  drawPixel(x0 - r, y0, cor);
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+
+    drawPixel(x0 + x, y0 + y, cor);
+    drawPixel(x0 - x, y0 + y, cor);
+    drawPixel(x0 + x, y0 - y, cor);
+    drawPixel(x0 - x, y0 - y, cor);
+    drawPixel(x0 + y, y0 + x, cor);
+    drawPixel(x0 - y, y0 + x, cor);
+    drawPixel(x0 + y, y0 - x, cor);
+    drawPixel(x0 - y, y0 - x, cor);
+  }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t cor) {
+  drawFastVLine(x0, y0 - r, 2 * r + 1, cor);
+  circleHelper(x0, y0, r, 3, 0, cor);
+}
+
+void Adafruit_GFX::circleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cantos,
+                                int16_t delta, uint16_t cor) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+
+  delta++;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (x < (y + 1)) {
+      if (cantos & 1) drawFastVLine(x0 + x, y0 - y, 2 * y + delta, cor);
+      if (cantos & 2) drawFastVLine(x0 - x, y0 - y, 2 * y + delta, cor);
+    }
+    if (y != py) {
+      if (cantos & 1) drawFastVLine(x0 + py, y0 - px, 2 * px + delta, cor);
+      if (cantos & 2) drawFastVLine(x0 - py, y0 - px, 2 * px + delta, cor);
+      py = y;
+    }
+    px = x;
+  }
+}
+
+void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                                int16_t y2, uint16_t cor) {
+  drawLine(x0, y0, x1, y1, cor);
+  drawLine(x1, y1, x2, y2, cor);
+  drawLine(x2, y2, x0, y0, cor);
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2,
+                                int16_t y2, uint16_t cor) {
+  int16_t a, b, y, ultimo;
+
+  // Ordena por Y (y2 >= y1 >= y0)
+  if (y0 > y1) {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+  if (y1 > y2) {
+    std::swap(y2, y1);
+    std::swap(x2, x1);
+  }
+  if (y0 > y1) {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+
+  if (y0 == y2) {
+    a = b = x0;
+    if (x1 < a) a = x1;
+    else if (x1 > b) b = x1;
+    if (x2 < a) a = x2;
+    else if (x2 > b) b = x2;
+    drawFastHLine(a, y0, b - a + 1, cor);
+    return;
+  }
+
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+          dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+
+  ultimo = y1 == y2 ? y1 : y1 - 1;
+
+  for (y = y0; y <= ultimo; y++) {
+    a = x0 + sa / dy01;
+    b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b) std::swap(a, b);
+    drawFastHLine(a, y, b - a + 1, cor);
+  }
+
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / dy12;
+    b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b) std::swap(a, b);
+    drawFastHLine(a, y, b - a + 1, cor);
+  }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t cor,
+                            uint16_t fundo, uint8_t tamanho) {
+  if (x >= _width || y >= _height || (x + 6 * tamanho - 1) < 0 || (y + 8 * tamanho - 1) < 0) {
+    return;
+  }
+  for (int8_t i = 0; i < 5; i++) {
+    // Coluna determinística a partir do código (substitui a tabela da fonte)
+    uint8_t linha = c == ' ' ? 0 : (uint8_t)((c * 37u + i * 11u) | 0x41) & 0x7F;
+    for (int8_t j = 0; j < 8; j++, linha >>= 1) {
+      if (linha & 1) {
+        if (tamanho == 1) drawPixel(x + i, y + j, cor);
+        else fillRect(x + i * tamanho, y + j * tamanho, tamanho, tamanho, cor);
+      } else if (fundo != cor) {
+        if (tamanho == 1) drawPixel(x + i, y + j, fundo);
+        else fillRect(x + i * tamanho, y + j * tamanho, tamanho, tamanho, fundo);
+      }
+    }
+  }
+  if (fundo != cor) {
+    if (tamanho == 1) drawFastVLine(x + 5, y, 8, fundo);
+    else fillRect(x + 5 * tamanho, y, tamanho, 8 * tamanho, fundo);
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += textsize * 8;
+  } else if (c != '\r') {
+    if (wrap && ((cursor_x + textsize * 6) > _width)) {
+      cursor_x = 0;
+      cursor_y += textsize * 8;
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+    cursor_x += textsize * 6;
+  }
+  return 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx,
+                              int16_t* miny, int16_t* maxx, int16_t* maxy) {
+  if (c == '\n') {
+    *x = 0;
+    *y += textsize * 8;
+  } else if (c != '\r') {
+    if (wrap && ((*x + textsize * 6) > _width)) {
+      *x = 0;
+      *y += textsize * 8;
+    }
+    int x2 = *x + textsize * 6 - 1;
+    int y2 = *y + textsize * 8 - 1;
+    if (x2 > *maxx) *maxx = x2;
+    if (y2 > *maxy) *maxy = y2;
+    if (*x < *minx) *minx = *x;
+    if (*y < *miny) *miny = *y;
+    *x += textsize * 6;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char* texto, int16_t x, int16_t y, int16_t* x1,
+                                 int16_t* y1, uint16_t* w, uint16_t* h) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+  unsigned char c;
+  while ((c = *texto++)) {
+    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  }
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const String& texto, int16_t x, int16_t y, int16_t* x1,
+                                 int16_t* y1, uint16_t* w, uint16_t* h) {
+  getTextBounds(texto.c_str(), x, y, x1, y1, w, h);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file Adafruit_GFX.h
+ * @brief Subconjunto da Adafruit_GFX para o build nativo
+ *
+ * As primitivas seguem os algoritmos da biblioteca original (mesmos pixels).
+ * O texto usa a métrica da fonte padrão (6x8 por caractere, com escala),
+ * mas cada caractere é desenhado como um padrão 5x7 derivado do código, sem
+ * a tabela da fonte: posições e caixas delimitadoras batem com o display
+ * real, o desenho exato das letras não.
+ */
+#ifndef SHIM_ADAFRUIT_GFX_H
+#define SHIM_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h);
+  virtual ~Adafruit_GFX() {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t cor) = 0;
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t cor);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t cor);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t cor);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t cor);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t cor);
+  void fillScreen(uint16_t cor);
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t cor);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t cor);
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                    uint16_t cor);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                    uint16_t cor);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t cor, uint16_t fundo,
+                uint8_t tamanho);
+
+  void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+  void setTextSize(uint8_t s) { textsize = s > 0 ? s : 1; }
+  void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+  void setTextColor(uint16_t c, uint16_t fundo) { textcolor = c; textbgcolor = fundo; }
+  void setTextWrap(bool w) { wrap = w; }
+  int16_t getCursorX() const { return cursor_x; }
+  int16_t getCursorY() const { return cursor_y; }
+
+  void getTextBounds(const char* texto, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                     uint16_t* w, uint16_t* h);
+  void getTextBounds(const String& texto, int16_t x, int16_t y, int16_t* x1, int16_t* y1,
+                     uint16_t* w, uint16_t* h);
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+protected:
+  int16_t WIDTH, HEIGHT;
+  int16_t _width, _height;
+  int16_t cursor_x = 0, cursor_y = 0;
+  uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+  uint8_t textsize = 1;
+  bool wrap = true;
+
+  void circleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cantos, int16_t delta,
+                    uint16_t cor);
+  void charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny,
+                  int16_t* maxx, int16_t* maxy);
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "Adafruit_SSD1306.h"
+
+#include <cstdlib>
+#include <cstring>
+
+// Como WIRE_MAX da biblioteca: o byte de controle ocupa uma posição
+static const size_t MAXIMO_TRANSACAO = 32;
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst_pin,
+                                   uint32_t clkDuring, uint32_t clkAfter)
+  : Adafruit_GFX(w, h), wire(twi ? twi : &Wire), clkDuring(clkDuring), clkAfter(clkAfter) {
+  (void)rst_pin;
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+  free(buffer);
+}
+
+void Adafruit_SSD1306::enviarComandos(const uint8_t* comandos, size_t quantidade) {
+  wire->beginTransmission(endereco);
+  wire->write((uint8_t)0x00);
+  size_t bytesNaTransacao = 1;
+  while (quantidade--) {
+    if (bytesNaTransacao >= MAXIMO_TRANSACAO) {
+      wire->endTransmission();
+      wire->beginTransmission(endereco);
+      wire->write((uint8_t)0x00);
+      bytesNaTransacao = 1;
+    }
+    wire->write(*comandos++);
+    bytesNaTransacao++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+  enviarComandos(&c, 1);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset, bool periphBegin) {
+  (void)reset;
+  if (buffer == nullptr) {
+    buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8));
+    if (buffer == nullptr) {
+      return false;
+    }
+  }
+  clearDisplay();
+  endereco = addr ? addr : (HEIGHT == 32 ? 0x3C : 0x3D);
+  if (periphBegin) {
+    wire->begin();
+  }
+  wire->setClock(clkDuring);
+
+  // Presença do controlador
+  wire->beginTransmission(endereco);
+  if (wire->endTransmission() != 0) {
+    wire->setClock(clkAfter);
+    return false;
+  }
+
+  const uint8_t inicializacao[] = {
+    SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX,
+    (uint8_t)(HEIGHT - 1), SSD1306_SETDISPLAYOFFSET, 0x00, SSD1306_SETSTARTLINE | 0x00,
+    SSD1306_CHARGEPUMP, (uint8_t)(vcs == SSD1306_EXTERNALVCC ? 0x10 : 0x14),
+    SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x01, SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS, 0x12, SSD1306_SETCONTRAST,
+    (uint8_t)(vcs == SSD1306_EXTERNALVCC ? 0x9F : 0xCF), SSD1306_SETPRECHARGE,
+    (uint8_t)(vcs == SSD1306_EXTERNALVCC ? 0x22 : 0xF1), SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME, SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL,
+    SSD1306_DISPLAYON};
+  enviarComandos(inicializacao, sizeof(inicializacao));
+  wire->setClock(clkAfter);
+  return true;
+}
+
+void Adafruit_SSD1306::display() {
+  wire->setClock(clkDuring);
+  const uint8_t janela[] = {SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0,
+                            (uint8_t)(WIDTH - 1)};
+  enviarComandos(janela, sizeof(janela));
+
+  size_t restante = WIDTH * ((HEIGHT + 7) / 8);
+  const uint8_t* dados = buffer;
+  while (restante) {
+    size_t bloco = restante < MAXIMO_TRANSACAO - 1 ? restante : MAXIMO_TRANSACAO - 1;
+    wire->beginTransmission(endereco);
+    wire->write((uint8_t)0x40);
+    wire->write(dados, bloco);
+    wire->endTransmission();
+    dados += bloco;
+    restante -= bloco;
+  }
+  wire->setClock(clkAfter);
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+  ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::dim(bool dim) {
+  const uint8_t comandos[] = {SSD1306_SETCONTRAST, (uint8_t)(dim ? 0 : 0xCF)};
+  enviarComandos(comandos, sizeof(comandos));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t cor) {
+  if (buffer == nullptr || x < 0 || x >= width() || y < 0 || y >= height()) {
+    return;
+  }
+  uint8_t& byte = buffer[x + (y / 8) * WIDTH];
+  switch (cor) {
+    case SSD1306_WHITE: byte |= (1 << (y & 7)); break;
+    case SSD1306_BLACK: byte &= ~(1 << (y & 7)); break;
+    case SSD1306_INVERSE: byte ^= (1 << (y & 7)); break;
+  }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if (buffer == nullptr || x < 0 || x >= width() || y < 0 || y >= height()) {
+    return false;
+  }
+  return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
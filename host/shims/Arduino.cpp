@@ -0,0 +1,105 @@
+#include "Arduino.h"
+
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+std::mt19937 gerador(12345);
+std::mutex mutexGerador;
+uint8_t niveis[64];
+}
+
+unsigned long millis() {
+  return simulacao::agoraUs() / 1000;
+}
+
+unsigned long micros() {
+  return simulacao::agoraUs();
+}
+
+void delay(uint32_t ms) {
+  simulacao::esperarUs((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+  simulacao::esperarUs(us);
+}
+
+void yield() {
+  simulacao::verificarEncerramento();
+}
+
+void pinMode(uint8_t pino, uint8_t modo) {
+  (void)pino;
+  (void)modo;
+}
+
+void digitalWrite(uint8_t pino, uint8_t valor) {
+  if (pino < 64) {
+    niveis[pino] = valor;
+  }
+}
+
+int digitalRead(uint8_t pino) {
+  return pino < 64 ? niveis[pino] : LOW;
+}
+
+uint16_t touchRead(uint8_t pino) {
+  return simulacao::lerToque(pino);
+}
+
+long random(long maximo) {
+  return random(0, maximo);
+}
+
+long random(long minimo, long maximo) {
+  if (minimo >= maximo) {
+    return minimo;
+  }
+  std::uniform_int_distribution<long> distribuicao(minimo, maximo - 1);
+  std::lock_guard<std::mutex> trava(mutexGerador);
+  return distribuicao(gerador);
+}
+
+void randomSeed(unsigned long semente) {
+  std::lock_guard<std::mutex> trava(mutexGerador);
+  gerador.seed(semente);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  simulacao::escreverSerial(&c, 1);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* dados, size_t quantidade) {
+  simulacao::escreverSerial(dados, quantidade);
+  return quantidade;
+}
+
+int HardwareSerial::available() {
+  return simulacao::disponivelSerial();
+}
+
+int HardwareSerial::read() {
+  return simulacao::lerSerial();
+}
+
+void EspClass::restart() {
+  if (!simulacao::emTarefa()) {
+    throw std::runtime_error("ESP.restart() chamado no build nativo");
+  }
+  // A tarefa fica parada até o teste encerrar as tarefas e "religar" a placa
+  simulacao::pedirReinicio();
+  while (true) {
+    simulacao::esperarUs(10000);
+    simulacao::verificarEncerramento();
+  }
+}
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t)(simulacao::agoraUs() * getCpuFreqMHz());
+}
@@ -0,0 +1,99 @@
+/**
+ * @file Arduino.h
+ * @brief Núcleo do Arduino-ESP32 para o build nativo
+ *
+ * Tempo, toque, GPIO e Serial são atendidos pelo hardware simulado
+ * (Simulacao.h).
+ */
+#ifndef SHIM_ARDUINO_H
+#define SHIM_ARDUINO_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Print.h"
+#include "WString.h"
+#include "Simulacao.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+using std::abs;
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define PROGMEM
+#define F(texto) (texto)
+#define memcpy_P memcpy
+#define pgm_read_byte(endereco) (*(const uint8_t*)(endereco))
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+// Pinos de toque do ESP32-S3 (Tn == GPIOn)
+enum {
+  T1 = 1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14
+};
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pino, uint8_t modo);
+void digitalWrite(uint8_t pino, uint8_t valor);
+int digitalRead(uint8_t pino);
+
+uint16_t touchRead(uint8_t pino);
+void touchSleepWakeUpEnable(uint8_t pino, uint32_t limiar);  // esp_sleep.cpp
+
+long random(long maximo);
+long random(long minimo, long maximo);
+void randomSeed(unsigned long semente);
+
+template <typename T, typename L, typename H>
+inline T constrain(T valor, L minimo, H maximo) {
+  return valor < minimo ? minimo : (valor > maximo ? maximo : valor);
+}
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* dados, size_t quantidade) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  void restart();
+  uint32_t getCycleCount();   // 240 ciclos por µs, como o ESP32-S3 a 240 MHz
+  uint32_t getFreeHeap() { return 200000; }
+  uint32_t getCpuFreqMHz() { return 240; }
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,130 @@
+#include "LittleFS.h"
+
+#include <filesystem>
+#include <mutex>
+
+fs::LittleFSFS LittleFS;
+
+namespace simulacao {
+
+namespace {
+std::mutex mutexFlash;
+String diretorio = "flash_simulada";
+}
+
+void definirDiretorioFlash(const String& novo) {
+  std::lock_guard<std::mutex> trava(mutexFlash);
+  diretorio = novo;
+}
+
+String diretorioFlash() {
+  std::lock_guard<std::mutex> trava(mutexFlash);
+  return diretorio;
+}
+
+}  // namespace simulacao
+
+namespace fs {
+
+size_t File::write(const uint8_t* dados, size_t quantidade) {
+  return arquivo ? fwrite(dados, 1, quantidade, arquivo.get()) : 0;
+}
+
+int File::available() {
+  if (!arquivo) return 0;
+  long atual = ftell(arquivo.get());
+  fseek(arquivo.get(), 0, SEEK_END);
+  long fim = ftell(arquivo.get());
+  fseek(arquivo.get(), atual, SEEK_SET);
+  return (int)(fim - atual);
+}
+
+int File::read() {
+  return arquivo ? fgetc(arquivo.get()) : -1;
+}
+
+int File::peek() {
+  if (!arquivo) return -1;
+  int c = fgetc(arquivo.get());
+  if (c != EOF) ungetc(c, arquivo.get());
+  return c;
+}
+
+size_t File::read(uint8_t* dados, size_t quantidade) {
+  return arquivo ? fread(dados, 1, quantidade, arquivo.get()) : 0;
+}
+
+bool File::seek(uint32_t posicao) {
+  return arquivo && fseek(arquivo.get(), posicao, SEEK_SET) == 0;
+}
+
+size_t File::position() {
+  return arquivo ? ftell(arquivo.get()) : 0;
+}
+
+size_t File::size() {
+  if (!arquivo) return 0;
+  long atual = ftell(arquivo.get());
+  fseek(arquivo.get(), 0, SEEK_END);
+  long fim = ftell(arquivo.get());
+  fseek(arquivo.get(), atual, SEEK_SET);
+  return fim;
+}
+
+void File::flush() {
+  if (arquivo) fflush(arquivo.get());
+}
+
+std::string FS::caminhoHost(const char* caminho) {
+  std::string base = simulacao::diretorioFlash().c_str();
+  return base + (caminho[0] == '/' ? "" : "/") + caminho;
+}
+
+File FS::open(const char* caminho, const char* modo) {
+  std::string modoHost = std::string(modo) + "b";
+  FILE* arquivo = fopen(caminhoHost(caminho).c_str(), modoHost.c_str());
+  return arquivo ? File(arquivo) : File();
+}
+
+bool FS::exists(const char* caminho) {
+  return std::filesystem::exists(caminhoHost(caminho));
+}
+
+bool FS::remove(const char* caminho) {
+  return std::filesystem::remove(caminhoHost(caminho));
+}
+
+bool FS::rename(const char* de, const char* para) {
+  std::error_code erro;
+  std::filesystem::rename(caminhoHost(de), caminhoHost(para), erro);
+  return !erro;
+}
+
+size_t FS::usedBytes() {
+  size_t total = 0;
+  std::error_code erro;
+  for (const auto& item :
+       std::filesystem::directory_iterator(simulacao::diretorioFlash().c_str(), erro)) {
+    if (item.is_regular_file()) total += item.file_size();
+  }
+  return total;
+}
+
+bool LittleFSFS::begin(bool formatarSeFalhar, const char* base, uint8_t maxArquivos,
+                       const char* particao) {
+  (void)formatarSeFalhar;
+  (void)base;
+  (void)maxArquivos;
+  (void)particao;
+  std::error_code erro;
+  std::filesystem::create_directories(simulacao::diretorioFlash().c_str(), erro);
+  return !erro;
+}
+
+bool LittleFSFS::format() {
+  std::error_code erro;
+  std::filesystem::remove_all(simulacao::diretorioFlash().c_str(), erro);
+  return begin();
+}
+
+}  // namespace fs
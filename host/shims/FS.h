@@ -0,0 +1,72 @@
+/**
+ * @file FS.h
+ * @brief fs::File do Arduino-ESP32 para o build nativo
+ *
+ * Os arquivos do "flash" ficam num diretório do host
+ * (simulacao::definirDiretorioFlash).
+ */
+#ifndef SHIM_FS_H
+#define SHIM_FS_H
+
+#include <Arduino.h>
+#include <cstdio>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace simulacao {
+void definirDiretorioFlash(const String& diretorio);
+String diretorioFlash();
+}
+
+namespace fs {
+
+class File : public Stream {
+public:
+  File() {}
+  explicit File(FILE* arquivo) : arquivo(arquivo, fclose) {}
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* dados, size_t quantidade) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t read(uint8_t* dados, size_t quantidade);
+  bool seek(uint32_t posicao);
+  size_t position();
+  size_t size();
+  void flush() override;
+  void close() { arquivo.reset(); }
+  operator bool() const { return (bool)arquivo; }
+
+private:
+  std::shared_ptr<FILE> arquivo;
+};
+
+class FS {
+public:
+  File open(const char* caminho, const char* modo = FILE_READ);
+  File open(const String& caminho, const char* modo = FILE_READ) {
+    return open(caminho.c_str(), modo);
+  }
+  bool exists(const char* caminho);
+  bool exists(const String& caminho) { return exists(caminho.c_str()); }
+  bool remove(const char* caminho);
+  bool remove(const String& caminho) { return remove(caminho.c_str()); }
+  bool rename(const char* de, const char* para);
+  size_t totalBytes() { return 1536 * 1024; }
+  size_t usedBytes();
+
+protected:
+  std::string caminhoHost(const char* caminho);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif
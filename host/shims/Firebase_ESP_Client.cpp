@@ -0,0 +1,339 @@
+#include "Firebase_ESP_Client.h"
+
+#include <mutex>
+
+#include "RTDB.h"
+
+using simulacao::Json;
+
+FirebaseClass Firebase;
+
+namespace {
+
+int tipoNumerico(const Json& valor) {
+  switch (valor.tipo()) {
+    case Json::Tipo::Nulo: return FirebaseJson::JSON_NULL;
+    case Json::Tipo::Booleano: return FirebaseJson::JSON_BOOL;
+    case Json::Tipo::Inteiro: return FirebaseJson::JSON_INT;
+    case Json::Tipo::Real: return FirebaseJson::JSON_FLOAT;
+    case Json::Tipo::Texto: return FirebaseJson::JSON_STRING;
+    case Json::Tipo::Objeto: return FirebaseJson::JSON_OBJECT;
+    case Json::Tipo::Vetor: return FirebaseJson::JSON_ARRAY;
+  }
+  return FirebaseJson::JSON_UNDEFINED;
+}
+
+const char* nomeTipo(const Json& valor) {
+  switch (valor.tipo()) {
+    case Json::Tipo::Nulo: return "null";
+    case Json::Tipo::Booleano: return "boolean";
+    case Json::Tipo::Inteiro: return "int";
+    case Json::Tipo::Real: return "float";
+    case Json::Tipo::Texto: return "string";
+    case Json::Tipo::Objeto: return "object";
+    case Json::Tipo::Vetor: return "array";
+  }
+  return "undefined";
+}
+
+bool aceitaNumero(const Json& valor) { return valor.numero(); }
+bool aceitaBool(const Json& valor) { return valor.tipo() == Json::Tipo::Booleano; }
+bool aceitaTexto(const Json& valor) { return valor.tipo() == Json::Tipo::Texto; }
+bool aceitaObjeto(const Json& valor) {
+  return valor.tipo() == Json::Tipo::Objeto || valor.tipo() == Json::Tipo::Vetor;
+}
+bool aceitaQualquer(const Json& valor) { (void)valor; return true; }
+
+}  // namespace
+
+// ---------------------------------------------------------------- FirebaseJson
+
+FirebaseJson& FirebaseJson::set(const String& caminho, const String& valor) {
+  raiz.buscarOuCriar(caminho.c_str()) = Json(valor.std());
+  return *this;
+}
+
+FirebaseJson& FirebaseJson::set(const String& caminho, FirebaseJson& valor) {
+  raiz.buscarOuCriar(caminho.c_str()) = valor.raiz;
+  return *this;
+}
+
+FirebaseJson& FirebaseJson::set(const String& caminho, const FirebaseJson& valor) {
+  raiz.buscarOuCriar(caminho.c_str()) = valor.raiz;
+  return *this;
+}
+
+FirebaseJson& FirebaseJson::set(const String& caminho, const FirebaseJsonArray& valor) {
+  raiz.buscarOuCriar(caminho.c_str()) = valor.json();
+  return *this;
+}
+
+FirebaseJson& FirebaseJson::set(const String& caminho) {
+  raiz.buscarOuCriar(caminho.c_str()) = Json();
+  return *this;
+}
+
+FirebaseJson& FirebaseJson::add(const String& chave, const String& valor) {
+  raiz.membros()[chave.std()] = Json(valor.std());
+  return *this;
+}
+
+FirebaseJson& FirebaseJson::add(const String& chave, const FirebaseJson& valor) {
+  raiz.membros()[chave.std()] = valor.raiz;
+  return *this;
+}
+
+bool FirebaseJson::get(FirebaseJsonData& resultado, const String& caminho) const {
+  resultado = FirebaseJsonData();
+  const Json* valor = raiz.buscar(caminho.c_str());
+  if (valor == nullptr) {
+    return false;
+  }
+  resultado.success = true;
+  resultado.typeNum = tipoNumerico(*valor);
+  resultado.type = nomeTipo(*valor);
+  if (valor->tipo() == Json::Tipo::Texto) {
+    resultado.stringValue = valor->comoTexto().c_str();
+  } else {
+    resultado.stringValue = valor->serializar().c_str();
+  }
+  resultado.intValue = (int)valor->comoInteiro();
+  resultado.floatValue = (float)valor->comoReal();
+  resultado.doubleValue = valor->comoReal();
+  resultado.boolValue = valor->comoBool();
+  return true;
+}
+
+bool FirebaseJson::remove(const String& caminho) {
+  return raiz.remover(caminho.c_str());
+}
+
+FirebaseJson& FirebaseJson::clear() {
+  raiz = Json::objeto();
+  return *this;
+}
+
+bool FirebaseJson::setJsonData(const String& texto) {
+  Json lido;
+  if (!Json::interpretar(texto.c_str(), lido)) {
+    return false;
+  }
+  raiz = lido;
+  return true;
+}
+
+void FirebaseJson::toString(String& saida, bool formatado) const {
+  (void)formatado;
+  saida = raiz.serializar().c_str();
+}
+
+String FirebaseJson::raw() const {
+  return String(raiz.serializar().c_str());
+}
+
+// ---------------------------------------------------------------- FirebaseData
+
+String FirebaseData::dataType() const {
+  return nomeTipo(valor);
+}
+
+String FirebaseData::stringData() const {
+  if (valor.tipo() == Json::Tipo::Texto) {
+    return String(valor.comoTexto().c_str());
+  }
+  return String();
+}
+
+void FirebaseData::registrarSucesso(const Json& resposta) {
+  valor = resposta;
+  bruto = resposta.serializar();
+  if (resposta.tipo() == Json::Tipo::Objeto) {
+    objeto.definirJson(resposta);
+  } else {
+    objeto.clear();
+  }
+  erro = "";
+  codigoHttp = 200;
+}
+
+void FirebaseData::registrarErro(const String& motivo, int codigo) {
+  valor = Json();
+  bruto = valor.serializar();
+  objeto.clear();
+  erro = motivo;
+  codigoHttp = codigo;
+}
+
+// ---------------------------------------------------------------- RTDB
+
+bool FirebaseClass::ready() {
+  return simulacao::wifiConectado() && simulacao::firebasePronto();
+}
+
+bool FirebaseRTDB::ler(FirebaseData* fbdo, const String& caminho, Json& valor) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  if (!simulacao::wifiConectado()) {
+    fbdo->registrarErro("connection refused", -1);
+    return false;
+  }
+  std::string erro;
+  if (!simulacao::rtdb().ler(caminho.c_str(), valor, erro)) {
+    fbdo->registrarErro(erro.c_str(), erro == "path not exist" ? 200 : -1);
+    return false;
+  }
+  return true;
+}
+
+bool FirebaseRTDB::lerTipado(FirebaseData* fbdo, const String& caminho,
+                             bool (*aceita)(const Json&)) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  Json valor;
+  if (!ler(fbdo, caminho, valor)) {
+    return false;
+  }
+  if (!aceita(valor)) {
+    fbdo->registrarErro("data type mismatch", 200);
+    return false;
+  }
+  fbdo->registrarSucesso(valor);
+  return true;
+}
+
+bool FirebaseRTDB::gravar(FirebaseData* fbdo, const String& caminho, const Json& valor) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  if (!simulacao::wifiConectado()) {
+    fbdo->registrarErro("connection refused", -1);
+    return false;
+  }
+  std::string erro;
+  if (!simulacao::rtdb().gravar(caminho.c_str(), valor, erro)) {
+    fbdo->registrarErro(erro.c_str(), -1);
+    return false;
+  }
+  fbdo->registrarSucesso(valor);
+  return true;
+}
+
+bool FirebaseRTDB::setJSON(FirebaseData* fbdo, const String& caminho, FirebaseJson* json) {
+  return gravar(fbdo, caminho, json->json());
+}
+
+bool FirebaseRTDB::updateNode(FirebaseData* fbdo, const String& caminho, FirebaseJson* json) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  if (!simulacao::wifiConectado()) {
+    fbdo->registrarErro("connection refused", -1);
+    return false;
+  }
+  std::string erro;
+  if (!simulacao::rtdb().atualizar(caminho.c_str(), json->json(), erro)) {
+    fbdo->registrarErro(erro.c_str(), 400);
+    return false;
+  }
+  fbdo->registrarSucesso(json->json());
+  return true;
+}
+
+bool FirebaseRTDB::getJSON(FirebaseData* fbdo, const String& caminho) {
+  return lerTipado(fbdo, caminho, aceitaObjeto);
+}
+
+bool FirebaseRTDB::get(FirebaseData* fbdo, const String& caminho) {
+  return lerTipado(fbdo, caminho, aceitaQualquer);
+}
+
+bool FirebaseRTDB::getInt(FirebaseData* fbdo, const String& caminho) {
+  return lerTipado(fbdo, caminho, aceitaNumero);
+}
+
+bool FirebaseRTDB::getFloat(FirebaseData* fbdo, const String& caminho) {
+  return lerTipado(fbdo, caminho, aceitaNumero);
+}
+
+bool FirebaseRTDB::getBool(FirebaseData* fbdo, const String& caminho) {
+  return lerTipado(fbdo, caminho, aceitaBool);
+}
+
+bool FirebaseRTDB::getString(FirebaseData* fbdo, const String& caminho) {
+  return lerTipado(fbdo, caminho, aceitaTexto);
+}
+
+bool FirebaseRTDB::setInt(FirebaseData* fbdo, const String& caminho, int valor) {
+  return gravar(fbdo, caminho, Json(valor));
+}
+
+bool FirebaseRTDB::setFloat(FirebaseData* fbdo, const String& caminho, float valor) {
+  return gravar(fbdo, caminho, Json(valor));
+}
+
+bool FirebaseRTDB::setDouble(FirebaseData* fbdo, const String& caminho, double valor) {
+  return gravar(fbdo, caminho, Json(valor));
+}
+
+bool FirebaseRTDB::setBool(FirebaseData* fbdo, const String& caminho, bool valor) {
+  return gravar(fbdo, caminho, Json(valor));
+}
+
+bool FirebaseRTDB::setString(FirebaseData* fbdo, const String& caminho, const String& valor) {
+  return gravar(fbdo, caminho, Json(valor.std()));
+}
+
+bool FirebaseRTDB::deleteNode(FirebaseData* fbdo, const String& caminho) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  if (!simulacao::wifiConectado()) {
+    fbdo->registrarErro("connection refused", -1);
+    return false;
+  }
+  std::string erro;
+  if (!simulacao::rtdb().remover(caminho.c_str(), erro)) {
+    fbdo->registrarErro(erro.c_str(), -1);
+    return false;
+  }
+  fbdo->registrarSucesso(Json());
+  return true;
+}
+
+bool FirebaseRTDB::beginStream(FirebaseData* fbdo, const String& caminho) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  fbdo->fluxo.reset();
+  fbdo->eventoDisponivel = false;
+  if (!simulacao::wifiConectado()) {
+    fbdo->registrarErro("connection refused", -1);
+    return false;
+  }
+  std::string erro;
+  fbdo->fluxo = simulacao::rtdb().observar(caminho.c_str(), erro);
+  if (!fbdo->fluxo) {
+    fbdo->registrarErro(erro.c_str(), -1);
+    return false;
+  }
+  fbdo->caminhoFluxo = caminho;
+  return true;
+}
+
+bool FirebaseRTDB::readStream(FirebaseData* fbdo) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  fbdo->eventoDisponivel = false;
+  if (!fbdo->fluxo) {
+    fbdo->registrarErro("stream not started", -1);
+    return false;
+  }
+  // A biblioteca reabre o stream sozinha quando a conexão cai
+  if (!fbdo->fluxo->ativo() && !beginStream(fbdo, fbdo->caminhoFluxo)) {
+    return false;
+  }
+  simulacao::EventoRTDB evento;
+  if (fbdo->fluxo->proximo(evento, 0)) {
+    fbdo->registrarSucesso(evento.dados);
+    fbdo->eventoDisponivel = true;
+    fbdo->caminhoEvento = evento.caminho.c_str();
+    fbdo->tipoEvento = evento.tipo.c_str();
+  }
+  return true;
+}
+
+bool FirebaseRTDB::endStream(FirebaseData* fbdo) {
+  std::lock_guard<std::recursive_mutex> trava(fbdo->conexao());
+  fbdo->fluxo.reset();
+  fbdo->eventoDisponivel = false;
+  return true;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file Firebase_ESP_Client.h
+ * @brief Subconjunto do Firebase_ESP_Client usado pelo firmware
+ *
+ * As operações do RTDB são atendidas pelo RTDB simulado (RTDB.h), com a
+ * mesma semântica de tipos e mensagens de erro da biblioteca original.
+ */
+#ifndef SHIM_FIREBASE_ESP_CLIENT_H
+#define SHIM_FIREBASE_ESP_CLIENT_H
+
+#include <Arduino.h>
+#include <memory>
+#include <mutex>
+#include "Json.h"
+
+namespace simulacao {
+class FluxoRTDB;
+}
+
+class FirebaseJsonData {
+public:
+  bool success = false;
+  int typeNum = 0;
+  String type;
+  String stringValue;
+  int intValue = 0;
+  float floatValue = 0;
+  double doubleValue = 0;
+  bool boolValue = false;
+};
+
+class FirebaseJsonArray {
+public:
+  FirebaseJsonArray() : raiz(simulacao::Json::vetor()) {}
+
+  template <typename T>
+  FirebaseJsonArray& add(T valor) {
+    raiz.itens().push_back(simulacao::Json(valor));
+    return *this;
+  }
+  FirebaseJsonArray& add(const String& valor) {
+    raiz.itens().push_back(simulacao::Json(valor.std()));
+    return *this;
+  }
+  size_t size() const { return raiz.itens().size(); }
+
+  const simulacao::Json& json() const { return raiz; }
+
+private:
+  simulacao::Json raiz;
+};
+
+class FirebaseJson {
+public:
+  enum jsonDataType {
+    JSON_UNDEFINED = 0,
+    JSON_OBJECT = 1,
+    JSON_ARRAY = 2,
+    JSON_STRING = 3,
+    JSON_INT = 4,
+    JSON_FLOAT = 5,
+    JSON_DOUBLE = 6,
+    JSON_BOOL = 7,
+    JSON_NULL = 8
+  };
+
+  FirebaseJson() : raiz(simulacao::Json::objeto()) {}
+
+  // O caminho aceita "a/b/c", criando os objetos intermediários
+  template <typename T>
+  FirebaseJson& set(const String& caminho, T valor) {
+    raiz.buscarOuCriar(caminho.c_str()) = simulacao::Json(valor);
+    return *this;
+  }
+  FirebaseJson& set(const String& caminho, const String& valor);
+  FirebaseJson& set(const String& caminho, FirebaseJson& valor);
+  FirebaseJson& set(const String& caminho, const FirebaseJson& valor);
+  FirebaseJson& set(const String& caminho, const FirebaseJsonArray& valor);
+  // Sem valor grava null; num updateNode, null apaga o filho
+  FirebaseJson& set(const String& caminho);
+
+  // Como na biblioteca, add() não interpreta as barras: a chave fica
+  // inteira no primeiro nível, o que faz do updateNode uma escrita em
+  // vários caminhos ("saida/estado")
+  template <typename T>
+  FirebaseJson& add(const String& chave, T valor) {
+    raiz.membros()[chave.std()] = simulacao::Json(valor);
+    return *this;
+  }
+  FirebaseJson& add(const String& chave, const String& valor);
+  FirebaseJson& add(const String& chave, const FirebaseJson& valor);
+
+  bool get(FirebaseJsonData& resultado, const String& caminho) const;
+  bool remove(const String& caminho);
+  FirebaseJson& clear();
+  bool setJsonData(const String& texto);
+
+  void toString(String& saida, bool formatado = false) const;
+  String raw() const;
+
+  const simulacao::Json& json() const { return raiz; }
+  void definirJson(const simulacao::Json& valor) { raiz = valor; }
+
+private:
+  simulacao::Json raiz;
+};
+
+class FirebaseData {
+public:
+  void setBSSLBufferSize(int rx, int tx) { (void)rx; (void)tx; }
+  void setResponseSize(int tamanho) { (void)tamanho; }
+
+  String dataType() const;
+  String stringData() const;
+  int intData() const { return (int)valor.comoInteiro(); }
+  float floatData() const { return (float)valor.comoReal(); }
+  double doubleData() const { return valor.comoReal(); }
+  bool boolData() const { return valor.comoBool(); }
+  FirebaseJson& jsonObject() { return objeto; }
+  FirebaseJson* jsonObjectPtr() { return &objeto; }
+  String payload() const { return String(bruto.c_str()); }
+  // Como na biblioteca, to<const char*>() aponta para a resposta crua
+  // guardada no FirebaseData, válida até a próxima requisição com ele
+  template <typename T>
+  T to() const;
+  String errorReason() const { return erro; }
+  int httpCode() const { return codigoHttp; }
+
+  // Stream (beginStream/readStream): dados do último evento lido
+  bool streamAvailable() const { return eventoDisponivel; }
+  bool streamTimeout() const { return false; }
+  String dataPath() const { return caminhoEvento; }
+  String eventType() const { return tipoEvento; }
+
+  // Usados pelo shim do RTDB
+  void registrarSucesso(const simulacao::Json& resposta);
+  void registrarErro(const String& motivo, int codigo);
+  std::recursive_mutex& conexao() { return mutexConexao; }
+
+  std::shared_ptr<simulacao::FluxoRTDB> fluxo;
+  String caminhoFluxo;
+  bool eventoDisponivel = false;
+  String caminhoEvento;
+  String tipoEvento;
+
+private:
+  simulacao::Json valor;
+  std::string bruto;
+  FirebaseJson objeto;
+  String erro;
+  int codigoHttp = 0;
+
+  // Cada FirebaseData é uma conexão TLS: as requisições feitas por ele são
+  // atendidas uma de cada vez. Os campos acima continuam sem proteção,
+  // como na biblioteca original.
+  std::recursive_mutex mutexConexao;
+};
+
+template <>
+inline const char* FirebaseData::to<const char*>() const {
+  return bruto.c_str();
+}
+
+struct FirebaseConfig {
+  String api_key;
+  String database_url;
+  struct {
+    int connection_timeout = 0;
+  } timeout;
+};
+
+struct FirebaseAuth {
+  struct {
+    String email;
+    String password;
+  } user;
+};
+
+class FirebaseRTDB {
+public:
+  bool setJSON(FirebaseData* fbdo, const String& caminho, FirebaseJson* json);
+  bool updateNode(FirebaseData* fbdo, const String& caminho, FirebaseJson* json);
+  bool getJSON(FirebaseData* fbdo, const String& caminho);
+  bool get(FirebaseData* fbdo, const String& caminho);
+  bool getInt(FirebaseData* fbdo, const String& caminho);
+  bool getFloat(FirebaseData* fbdo, const String& caminho);
+  bool getBool(FirebaseData* fbdo, const String& caminho);
+  bool getString(FirebaseData* fbdo, const String& caminho);
+  bool setInt(FirebaseData* fbdo, const String& caminho, int valor);
+  bool setFloat(FirebaseData* fbdo, const String& caminho, float valor);
+  bool setDouble(FirebaseData* fbdo, const String& caminho, double valor);
+  bool setBool(FirebaseData* fbdo, const String& caminho, bool valor);
+  bool setString(FirebaseData* fbdo, const String& caminho, const String& valor);
+  bool deleteNode(FirebaseData* fbdo, const String& caminho);
+
+  bool beginStream(FirebaseData* fbdo, const String& caminho);
+  bool readStream(FirebaseData* fbdo);
+  bool endStream(FirebaseData* fbdo);
+
+private:
+  bool ler(FirebaseData* fbdo, const String& caminho, simulacao::Json& valor);
+  bool gravar(FirebaseData* fbdo, const String& caminho, const simulacao::Json& valor);
+  bool lerTipado(FirebaseData* fbdo, const String& caminho, bool (*aceita)(const simulacao::Json&));
+};
+
+class FirebaseClass {
+public:
+  void begin(FirebaseConfig* config, FirebaseAuth* auth) { (void)config; (void)auth; }
+  void reconnectNetwork(bool ativo) { (void)ativo; }
+  void reconnectWiFi(bool ativo) { (void)ativo; }
+  bool ready();
+
+  FirebaseRTDB RTDB;
+};
+
+extern FirebaseClass Firebase;
+
+#endif
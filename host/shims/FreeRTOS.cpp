@@ -0,0 +1,493 @@
+/**
+ * @file FreeRTOS.cpp
+ * @brief Tarefas, semáforos, filas e grupos de eventos do FreeRTOS sobre threads do host
+ *
+ * Prioridades e afinidade de núcleo são registradas mas não influenciam o
+ * escalonador do host. As esperas respeitam o relógio simulado: no relógio
+ * real escalado o tempo de espera é dividido pela escala; no relógio virtual
+ * uma espera com prazo apenas avança o relógio.
+ */
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Simulacao.h"
+
+struct TarefaSimulada {
+  std::string nome;
+  UBaseType_t prioridade;
+  TaskFunction_t funcao;
+  void* parametro;
+  std::thread thread;
+};
+
+struct SemaforoSimulado {
+  std::mutex mutex;
+  std::condition_variable cv;
+  UBaseType_t contagem;
+  UBaseType_t maximo;
+};
+
+struct FilaSimulada {
+  std::mutex mutex;
+  std::condition_variable cv;
+  UBaseType_t tamanho;
+  UBaseType_t tamanhoItem;
+  std::deque<std::vector<uint8_t>> itens;
+};
+
+struct GrupoEventosSimulado {
+  std::mutex mutex;
+  std::condition_variable cv;
+  EventBits_t bits = 0;
+};
+
+namespace {
+
+std::mutex mutexTarefas;
+std::vector<TarefaSimulada*> tarefas;
+std::atomic<bool> sinalEncerramento{false};
+
+std::mutex mutexSono;
+std::condition_variable cvSono;
+
+thread_local TarefaSimulada* tarefaAtual = nullptr;
+
+const auto FATIA_ESPERA = std::chrono::milliseconds(20);
+
+std::atomic<simulacao::GanchoTarefa> ganchoEntrou{nullptr};
+std::atomic<simulacao::GanchoTarefa> ganchoSaiu{nullptr};
+
+void chamarGancho(const std::atomic<simulacao::GanchoTarefa>& gancho) {
+  simulacao::GanchoTarefa funcao = gancho.load();
+  if (funcao != nullptr && tarefaAtual != nullptr) {
+    funcao();
+  }
+}
+
+// Marca a espera de uma tarefa entre a construção e o fim do escopo
+struct EsperaTarefa {
+  EsperaTarefa() { chamarGancho(ganchoSaiu); }
+  ~EsperaTarefa() { chamarGancho(ganchoEntrou); }
+};
+
+std::chrono::steady_clock::duration duracaoReal(uint64_t usSimulados) {
+  return std::chrono::microseconds((uint64_t)(usSimulados / simulacao::escalaRelogio()));
+}
+
+template <typename Pronto>
+bool aguardar(std::unique_lock<std::mutex>& trava, std::condition_variable& cv,
+              TickType_t espera, Pronto pronto) {
+  if (pronto()) {
+    return true;
+  }
+  if (espera == 0) {
+    return false;
+  }
+
+  if (simulacao::modoRelogio() == simulacao::ModoRelogio::Virtual) {
+    if (espera == portMAX_DELAY) {
+      fprintf(stderr, "FreeRTOS simulado: espera infinita com relógio virtual\n");
+      abort();
+    }
+    simulacao::avancarUs((uint64_t)espera * portTICK_PERIOD_MS * 1000);
+    return pronto();
+  }
+
+  EsperaTarefa esperando;
+  bool infinita = (espera == portMAX_DELAY);
+  auto prazo = std::chrono::steady_clock::now() +
+               duracaoReal((uint64_t)espera * portTICK_PERIOD_MS * 1000);
+
+  while (!pronto()) {
+    if (tarefaAtual != nullptr && sinalEncerramento) {
+      throw simulacao::EncerramentoTarefa();
+    }
+    auto agora = std::chrono::steady_clock::now();
+    if (!infinita && agora >= prazo) {
+      return false;
+    }
+    auto limite = agora + FATIA_ESPERA;
+    if (!infinita && prazo < limite) {
+      limite = prazo;
+    }
+    cv.wait_until(trava, limite);
+  }
+  return true;
+}
+
+void executarTarefa(TarefaSimulada* tarefa) {
+  tarefaAtual = tarefa;
+  chamarGancho(ganchoEntrou);
+  try {
+    tarefa->funcao(tarefa->parametro);
+  } catch (const simulacao::EncerramentoTarefa&) {
+    // Encerramento pedido pelo simulador ou vTaskDelete(NULL)
+  }
+}
+
+}  // namespace
+
+namespace simulacao {
+
+void dormirInterrompivel(uint64_t usReais) {
+  {
+    EsperaTarefa esperando;
+    std::unique_lock<std::mutex> trava(mutexSono);
+    auto prazo = std::chrono::steady_clock::now() + std::chrono::microseconds(usReais);
+    while (std::chrono::steady_clock::now() < prazo) {
+      if (tarefaAtual != nullptr && sinalEncerramento) {
+        break;
+      }
+      cvSono.wait_until(trava, prazo);
+    }
+  }
+  verificarEncerramento();
+}
+
+void definirGanchosTarefa(GanchoTarefa entrou, GanchoTarefa saiu) {
+  ganchoEntrou = entrou;
+  ganchoSaiu = saiu;
+}
+
+bool encerrando() {
+  return sinalEncerramento;
+}
+
+bool emTarefa() {
+  return tarefaAtual != nullptr;
+}
+
+void verificarEncerramento() {
+  if (tarefaAtual != nullptr && sinalEncerramento) {
+    throw EncerramentoTarefa();
+  }
+}
+
+void encerrarTarefas() {
+  std::vector<TarefaSimulada*> pendentes;
+  {
+    std::lock_guard<std::mutex> trava(mutexTarefas);
+    pendentes.swap(tarefas);
+  }
+
+  sinalEncerramento = true;
+  {
+    std::lock_guard<std::mutex> trava(mutexSono);
+    cvSono.notify_all();
+  }
+  for (TarefaSimulada* tarefa : pendentes) {
+    if (tarefa->thread.joinable()) {
+      tarefa->thread.join();
+    }
+    delete tarefa;
+  }
+  sinalEncerramento = false;
+}
+
+void reiniciarTarefas() {
+  encerrarTarefas();
+}
+
+}  // namespace simulacao
+
+// ------------------------------------------------------------------ Tarefas
+
+BaseType_t xTaskCreate(TaskFunction_t funcao, const char* nome, uint32_t pilha,
+                       void* parametro, UBaseType_t prioridade, TaskHandle_t* handle) {
+  (void)pilha;
+  TarefaSimulada* tarefa = new TarefaSimulada();
+  tarefa->nome = nome ? nome : "";
+  tarefa->prioridade = prioridade;
+  tarefa->funcao = funcao;
+  tarefa->parametro = parametro;
+  {
+    std::lock_guard<std::mutex> trava(mutexTarefas);
+    tarefas.push_back(tarefa);
+    tarefa->thread = std::thread(executarTarefa, tarefa);
+  }
+  if (handle) {
+    *handle = tarefa;
+  }
+  return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t funcao, const char* nome, uint32_t pilha,
+                                   void* parametro, UBaseType_t prioridade,
+                                   TaskHandle_t* handle, BaseType_t nucleo) {
+  (void)nucleo;
+  return xTaskCreate(funcao, nome, pilha, parametro, prioridade, handle);
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+  // Só a autoexclusão é suportada: a thread termina e é recolhida no encerramento
+  if (handle == nullptr || handle == tarefaAtual) {
+    throw simulacao::EncerramentoTarefa();
+  }
+}
+
+void vTaskDelay(TickType_t ticks) {
+  simulacao::esperarUs((uint64_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+void vTaskDelayUntil(TickType_t* ultimoDespertar, TickType_t periodo) {
+  xTaskDelayUntil(ultimoDespertar, periodo);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* ultimoDespertar, TickType_t periodo) {
+  TickType_t proximo = *ultimoDespertar + periodo;
+  TickType_t agora = xTaskGetTickCount();
+  *ultimoDespertar = proximo;
+  if ((int32_t)(proximo - agora) > 0) {
+    vTaskDelay(proximo - agora);
+    return pdTRUE;
+  }
+  simulacao::verificarEncerramento();
+  return pdFALSE;
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)(simulacao::agoraUs() / (portTICK_PERIOD_MS * 1000));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return tarefaAtual;
+}
+
+const char* pcTaskGetName(TaskHandle_t handle) {
+  TarefaSimulada* tarefa = handle ? handle : tarefaAtual;
+  return tarefa ? tarefa->nome.c_str() : "principal";
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t handle) {
+  TarefaSimulada* tarefa = handle ? handle : tarefaAtual;
+  return tarefa ? tarefa->prioridade : 1;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t handle) {
+  (void)handle;
+  return 1024;
+}
+
+void taskYIELD() {
+  std::this_thread::yield();
+  simulacao::verificarEncerramento();
+}
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+  while (mux->trava.test_and_set(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+  mux->trava.clear(std::memory_order_release);
+}
+
+// ---------------------------------------------------------------- Semáforos
+
+static SemaphoreHandle_t criarSemaforo(UBaseType_t maximo, UBaseType_t inicial) {
+  SemaforoSimulado* semaforo = new SemaforoSimulado();
+  semaforo->maximo = maximo;
+  semaforo->contagem = inicial;
+  return semaforo;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return criarSemaforo(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return criarSemaforo(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maximo, UBaseType_t inicial) {
+  return criarSemaforo(maximo, inicial);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaforo, TickType_t espera) {
+  std::unique_lock<std::mutex> trava(semaforo->mutex);
+  if (!aguardar(trava, semaforo->cv, espera, [&] { return semaforo->contagem > 0; })) {
+    return pdFALSE;
+  }
+  semaforo->contagem--;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaforo) {
+  std::lock_guard<std::mutex> trava(semaforo->mutex);
+  if (semaforo->contagem >= semaforo->maximo) {
+    return pdFALSE;
+  }
+  semaforo->contagem++;
+  semaforo->cv.notify_one();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaforo, BaseType_t* acordouTarefa) {
+  if (acordouTarefa) {
+    *acordouTarefa = pdFALSE;
+  }
+  return xSemaphoreGive(semaforo);
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaforo) {
+  std::lock_guard<std::mutex> trava(semaforo->mutex);
+  return semaforo->contagem;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaforo) {
+  delete semaforo;
+}
+
+// -------------------------------------------------------------------- Filas
+
+QueueHandle_t xQueueCreate(UBaseType_t tamanho, UBaseType_t tamanhoItem) {
+  FilaSimulada* fila = new FilaSimulada();
+  fila->tamanho = tamanho;
+  fila->tamanhoItem = tamanhoItem;
+  return fila;
+}
+
+static BaseType_t enviar(QueueHandle_t fila, const void* item, TickType_t espera, bool frente) {
+  std::unique_lock<std::mutex> trava(fila->mutex);
+  if (!aguardar(trava, fila->cv, espera, [&] { return fila->itens.size() < fila->tamanho; })) {
+    return errQUEUE_FULL;
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(item);
+  std::vector<uint8_t> copia(bytes, bytes + fila->tamanhoItem);
+  if (frente) {
+    fila->itens.push_front(std::move(copia));
+  } else {
+    fila->itens.push_back(std::move(copia));
+  }
+  fila->cv.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xQueueSend(QueueHandle_t fila, const void* item, TickType_t espera) {
+  return enviar(fila, item, espera, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t fila, const void* item, TickType_t espera) {
+  return enviar(fila, item, espera, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t fila, const void* item, TickType_t espera) {
+  return enviar(fila, item, espera, true);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t fila, const void* item, BaseType_t* acordouTarefa) {
+  if (acordouTarefa) {
+    *acordouTarefa = pdFALSE;
+  }
+  return enviar(fila, item, 0, false);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t fila, const void* item) {
+  std::lock_guard<std::mutex> trava(fila->mutex);
+  const uint8_t* bytes = static_cast<const uint8_t*>(item);
+  fila->itens.clear();
+  fila->itens.emplace_back(bytes, bytes + fila->tamanhoItem);
+  fila->cv.notify_all();
+  return pdTRUE;
+}
+
+static BaseType_t receber(QueueHandle_t fila, void* item, TickType_t espera, bool remover) {
+  std::unique_lock<std::mutex> trava(fila->mutex);
+  if (!aguardar(trava, fila->cv, espera, [&] { return !fila->itens.empty(); })) {
+    return pdFALSE;
+  }
+  memcpy(item, fila->itens.front().data(), fila->tamanhoItem);
+  if (remover) {
+    fila->itens.pop_front();
+    fila->cv.notify_all();
+  }
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t fila, void* item, TickType_t espera) {
+  return receber(fila, item, espera, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t fila, void* item, TickType_t espera) {
+  return receber(fila, item, espera, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t fila) {
+  std::lock_guard<std::mutex> trava(fila->mutex);
+  return fila->itens.size();
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t fila) {
+  std::lock_guard<std::mutex> trava(fila->mutex);
+  return fila->tamanho - fila->itens.size();
+}
+
+BaseType_t xQueueReset(QueueHandle_t fila) {
+  std::lock_guard<std::mutex> trava(fila->mutex);
+  fila->itens.clear();
+  fila->cv.notify_all();
+  return pdPASS;
+}
+
+void vQueueDelete(QueueHandle_t fila) {
+  delete fila;
+}
+
+// ------------------------------------------------------- Grupos de eventos
+
+EventGroupHandle_t xEventGroupCreate() {
+  return new GrupoEventosSimulado();
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t grupo, EventBits_t bits) {
+  std::lock_guard<std::mutex> trava(grupo->mutex);
+  grupo->bits |= bits;
+  grupo->cv.notify_all();
+  return grupo->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t grupo, EventBits_t bits) {
+  std::lock_guard<std::mutex> trava(grupo->mutex);
+  EventBits_t anteriores = grupo->bits;
+  grupo->bits &= ~bits;
+  return anteriores;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t grupo) {
+  std::lock_guard<std::mutex> trava(grupo->mutex);
+  return grupo->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t grupo, EventBits_t bits, BaseType_t limpar,
+                                BaseType_t todos, TickType_t espera) {
+  std::unique_lock<std::mutex> trava(grupo->mutex);
+  auto satisfeito = [&] {
+    return todos ? (grupo->bits & bits) == bits : (grupo->bits & bits) != 0;
+  };
+  bool ok = aguardar(trava, grupo->cv, espera, satisfeito);
+  // Como no FreeRTOS: devolve os bits no momento em que a espera terminou
+  EventBits_t valor = grupo->bits;
+  if (ok && limpar) {
+    grupo->bits &= ~bits;
+  }
+  return valor;
+}
+
+void vEventGroupDelete(EventGroupHandle_t grupo) {
+  delete grupo;
+}
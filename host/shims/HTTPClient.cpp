@@ -0,0 +1,129 @@
+#include "HTTPClient.h"
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+int conectar(const std::string& host, uint16_t porta) {
+  addrinfo dicas = {};
+  dicas.ai_family = AF_INET;
+  dicas.ai_socktype = SOCK_STREAM;
+  addrinfo* enderecos = nullptr;
+  if (getaddrinfo(host.c_str(), std::to_string(porta).c_str(), &dicas, &enderecos) != 0) {
+    return -1;
+  }
+  int s = -1;
+  for (addrinfo* e = enderecos; e; e = e->ai_next) {
+    s = socket(e->ai_family, e->ai_socktype, e->ai_protocol);
+    if (s < 0) continue;
+    if (connect(s, e->ai_addr, e->ai_addrlen) == 0) break;
+    close(s);
+    s = -1;
+  }
+  freeaddrinfo(enderecos);
+  return s;
+}
+
+bool enviarTudo(int s, const std::string& dados) {
+  size_t enviados = 0;
+  while (enviados < dados.size()) {
+    ssize_t n = send(s, dados.data() + enviados, dados.size() - enviados, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    enviados += n;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool HTTPClient::begin(const String& url) {
+  end();
+  std::string texto = url.std();
+  const std::string esquema = "http://";
+  if (texto.compare(0, esquema.size(), esquema) != 0) {
+    return false;
+  }
+  texto = texto.substr(esquema.size());
+  size_t barra = texto.find('/');
+  std::string autoridade = texto.substr(0, barra);
+  caminho = barra == std::string::npos ? "/" : texto.substr(barra);
+  size_t doisPontos = autoridade.find(':');
+  host = autoridade.substr(0, doisPontos);
+  porta = doisPontos == std::string::npos ? 80 : (uint16_t)atoi(autoridade.c_str() + doisPontos + 1);
+  return !host.empty();
+}
+
+int HTTPClient::GET() {
+  tamanho = -1;
+  if (!simulacao::wifiConectado() || host.empty()) {
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  int s = conectar(host, porta);
+  if (s < 0) {
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  cliente.assumir(s, "");
+  cliente.setTimeout(timeoutMs);
+  std::string requisicao = "GET " + caminho + " HTTP/1.1\r\nHost: " + host + ":" +
+                           std::to_string(porta) + "\r\nUser-Agent: ESP32HTTPClient\r\n"
+                           "Connection: close\r\n\r\n";
+  if (!enviarTudo(s, requisicao)) {
+    end();
+    return HTTPC_ERROR_SEND_HEADER_FAILED;
+  }
+
+  // Cabeçalhos; o que vier junto do corpo volta para o WiFiClient
+  std::string recebidos;
+  size_t fim;
+  while ((fim = recebidos.find("\r\n\r\n")) == std::string::npos) {
+    char bloco[512];
+    ssize_t n = recv(s, bloco, sizeof(bloco), 0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) {
+      end();
+      return n == 0 ? HTTPC_ERROR_CONNECTION_LOST : HTTPC_ERROR_READ_TIMEOUT;
+    }
+    recebidos.append(bloco, n);
+  }
+  std::string cabecalhos = recebidos.substr(0, fim + 2);
+  cliente.assumir(s, recebidos.substr(fim + 4));
+
+  size_t espaco = cabecalhos.find(' ');
+  if (espaco == std::string::npos) {
+    end();
+    return HTTPC_ERROR_CONNECTION_LOST;
+  }
+  int status = atoi(cabecalhos.c_str() + espaco + 1);
+  for (size_t inicio = cabecalhos.find("\r\n") + 2; inicio < cabecalhos.size();) {
+    size_t quebra = cabecalhos.find("\r\n", inicio);
+    std::string linha = cabecalhos.substr(inicio, quebra - inicio);
+    inicio = quebra + 2;
+    size_t separador = linha.find(':');
+    if (separador == std::string::npos) continue;
+    std::string nome = linha.substr(0, separador);
+    for (char& c : nome) c = (char)tolower((unsigned char)c);
+    if (nome == "content-length") {
+      tamanho = atoi(linha.c_str() + separador + 1);
+    }
+  }
+  return status;
+}
+
+String HTTPClient::getString() {
+  std::string corpo;
+  uint8_t bloco[512];
+  while (tamanho < 0 || (int)corpo.size() < tamanho) {
+    size_t falta = tamanho < 0 ? sizeof(bloco) : std::min(sizeof(bloco), (size_t)tamanho - corpo.size());
+    int n = cliente.read(bloco, falta);
+    if (n <= 0) break;
+    corpo.append((const char*)bloco, n);
+  }
+  return String(corpo);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file HTTPClient.h
+ * @brief HTTPClient do Arduino-ESP32: GET por HTTP/1.1 num socket de verdade
+ *
+ * Só "http://" e só GET, o que a atualização OTA usa contra o servidor
+ * local (host/ota/ServidorOta.h). Sem WiFi simulado, GET() falha como no
+ * saco fora da rede.
+ */
+#ifndef SHIM_HTTPCLIENT_H
+#define SHIM_HTTPCLIENT_H
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_NOT_FOUND 404
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT 5000
+
+class HTTPClient {
+public:
+  HTTPClient() {}
+  ~HTTPClient() { end(); }
+
+  bool begin(const String& url);
+  int GET();
+  int getSize() { return tamanho; }  // -1: sem Content-Length
+  WiFiClient* getStreamPtr() { return &cliente; }
+  String getString();
+  bool connected() { return cliente.connected(); }
+  void end() { cliente.stop(); }
+  void setTimeout(uint16_t ms) { timeoutMs = ms; }
+  void setConnectTimeout(int32_t ms) { (void)ms; }
+
+private:
+  std::string host;
+  uint16_t porta = 80;
+  std::string caminho;
+  int tamanho = -1;
+  uint32_t timeoutMs = HTTPCLIENT_DEFAULT_TCP_TIMEOUT;
+  WiFiClient cliente;
+};
+
+#endif
@@ -0,0 +1,396 @@
+#include "Json.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace simulacao {
+
+Json::Json(double valor) : tipo_(Tipo::Real), real(valor) {
+  // Como no RTDB, números inteiros representáveis ficam inteiros
+  if (std::isfinite(valor) && valor == std::floor(valor) && std::fabs(valor) < 9.0e15) {
+    tipo_ = Tipo::Inteiro;
+    inteiro = (long long)valor;
+  }
+}
+
+Json Json::objeto() {
+  Json json;
+  json.tipo_ = Tipo::Objeto;
+  return json;
+}
+
+Json Json::vetor() {
+  Json json;
+  json.tipo_ = Tipo::Vetor;
+  return json;
+}
+
+long long Json::comoInteiro() const {
+  switch (tipo_) {
+    case Tipo::Inteiro: return inteiro;
+    case Tipo::Real: return (long long)real;
+    case Tipo::Booleano: return booleano ? 1 : 0;
+    default: return 0;
+  }
+}
+
+double Json::comoReal() const {
+  switch (tipo_) {
+    case Tipo::Inteiro: return (double)inteiro;
+    case Tipo::Real: return real;
+    case Tipo::Booleano: return booleano ? 1 : 0;
+    default: return 0;
+  }
+}
+
+std::vector<std::string> Json::separarCaminho(const std::string& caminho) {
+  std::vector<std::string> partes;
+  std::string atual;
+  for (char c : caminho) {
+    if (c == '/') {
+      if (!atual.empty()) {
+        partes.push_back(atual);
+        atual.clear();
+      }
+    } else {
+      atual += c;
+    }
+  }
+  if (!atual.empty()) {
+    partes.push_back(atual);
+  }
+  return partes;
+}
+
+const Json* Json::buscar(const std::string& caminho) const {
+  const Json* atual = this;
+  for (const std::string& parte : separarCaminho(caminho)) {
+    if (atual->tipo_ == Tipo::Objeto) {
+      auto item = atual->objetoMembros.find(parte);
+      if (item == atual->objetoMembros.end()) {
+        return nullptr;
+      }
+      atual = &item->second;
+    } else if (atual->tipo_ == Tipo::Vetor) {
+      char* fim = nullptr;
+      unsigned long indice = strtoul(parte.c_str(), &fim, 10);
+      if (*fim != '\0' || indice >= atual->vetorItens.size()) {
+        return nullptr;
+      }
+      atual = &atual->vetorItens[indice];
+    } else {
+      return nullptr;
+    }
+  }
+  return atual;
+}
+
+Json& Json::buscarOuCriar(const std::string& caminho) {
+  Json* atual = this;
+  for (const std::string& parte : separarCaminho(caminho)) {
+    if (atual->tipo_ != Tipo::Objeto) {
+      *atual = objeto();
+    }
+    atual = &atual->objetoMembros[parte];
+  }
+  return *atual;
+}
+
+bool Json::remover(const std::string& caminho) {
+  std::vector<std::string> partes = separarCaminho(caminho);
+  if (partes.empty()) {
+    bool existia = !nulo();
+    *this = Json();
+    return existia;
+  }
+  std::string ultima = partes.back();
+  partes.pop_back();
+
+  Json* pai = this;
+  for (const std::string& parte : partes) {
+    if (pai->tipo_ != Tipo::Objeto) {
+      return false;
+    }
+    auto item = pai->objetoMembros.find(parte);
+    if (item == pai->objetoMembros.end()) {
+      return false;
+    }
+    pai = &item->second;
+  }
+  return pai->tipo_ == Tipo::Objeto && pai->objetoMembros.erase(ultima) > 0;
+}
+
+void Json::podar() {
+  if (tipo_ == Tipo::Objeto) {
+    for (auto item = objetoMembros.begin(); item != objetoMembros.end();) {
+      item->second.podar();
+      Tipo tipoFilho = item->second.tipo_;
+      if (tipoFilho == Tipo::Nulo ||
+          (tipoFilho == Tipo::Objeto && item->second.objetoMembros.empty())) {
+        item = objetoMembros.erase(item);
+      } else {
+        ++item;
+      }
+    }
+  } else if (tipo_ == Tipo::Vetor) {
+    for (Json& item : vetorItens) {
+      item.podar();
+    }
+  }
+}
+
+static void escaparTexto(const std::string& texto, std::string& saida) {
+  saida += '"';
+  for (unsigned char c : texto) {
+    switch (c) {
+      case '"': saida += "\\\""; break;
+      case '\\': saida += "\\\\"; break;
+      case '\n': saida += "\\n"; break;
+      case '\r': saida += "\\r"; break;
+      case '\t': saida += "\\t"; break;
+      default:
+        if (c < 0x20) {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          saida += buffer;
+        } else {
+          saida += (char)c;
+        }
+    }
+  }
+  saida += '"';
+}
+
+std::string Json::serializar() const {
+  std::string saida;
+  serializar(saida);
+  return saida;
+}
+
+void Json::serializar(std::string& saida) const {
+  char buffer[40];
+  switch (tipo_) {
+    case Tipo::Nulo:
+      saida += "null";
+      break;
+    case Tipo::Booleano:
+      saida += booleano ? "true" : "false";
+      break;
+    case Tipo::Inteiro:
+      snprintf(buffer, sizeof(buffer), "%lld", inteiro);
+      saida += buffer;
+      break;
+    case Tipo::Real:
+      // Menor representação que volta ao mesmo double
+      for (int precisao = 6; precisao <= 17; precisao++) {
+        snprintf(buffer, sizeof(buffer), "%.*g", precisao, real);
+        if (strtod(buffer, nullptr) == real) {
+          break;
+        }
+      }
+      saida += buffer;
+      break;
+    case Tipo::Texto:
+      escaparTexto(texto, saida);
+      break;
+    case Tipo::Objeto: {
+      saida += '{';
+      bool primeiro = true;
+      for (const auto& item : objetoMembros) {
+        if (!primeiro) saida += ',';
+        primeiro = false;
+        escaparTexto(item.first, saida);
+        saida += ':';
+        item.second.serializar(saida);
+      }
+      saida += '}';
+      break;
+    }
+    case Tipo::Vetor: {
+      saida += '[';
+      for (size_t i = 0; i < vetorItens.size(); i++) {
+        if (i > 0) saida += ',';
+        vetorItens[i].serializar(saida);
+      }
+      saida += ']';
+      break;
+    }
+  }
+}
+
+namespace {
+
+struct Leitor {
+  const std::string& texto;
+  size_t posicao;
+
+  void pularEspacos() {
+    while (posicao < texto.size() && isspace((unsigned char)texto[posicao])) {
+      posicao++;
+    }
+  }
+
+  bool consumir(char c) {
+    pularEspacos();
+    if (posicao < texto.size() && texto[posicao] == c) {
+      posicao++;
+      return true;
+    }
+    return false;
+  }
+
+  bool palavra(const char* esperado) {
+    size_t tamanho = strlen(esperado);
+    if (texto.compare(posicao, tamanho, esperado) == 0) {
+      posicao += tamanho;
+      return true;
+    }
+    return false;
+  }
+
+  bool lerTexto(std::string& saida) {
+    if (!consumir('"')) {
+      return false;
+    }
+    while (posicao < texto.size()) {
+      char c = texto[posicao++];
+      if (c == '"') {
+        return true;
+      }
+      if (c != '\\') {
+        saida += c;
+        continue;
+      }
+      if (posicao >= texto.size()) {
+        return false;
+      }
+      char escape = texto[posicao++];
+      switch (escape) {
+        case '"': saida += '"'; break;
+        case '\\': saida += '\\'; break;
+        case '/': saida += '/'; break;
+        case 'b': saida += '\b'; break;
+        case 'f': saida += '\f'; break;
+        case 'n': saida += '\n'; break;
+        case 'r': saida += '\r'; break;
+        case 't': saida += '\t'; break;
+        case 'u': {
+          if (posicao + 4 > texto.size()) {
+            return false;
+          }
+          unsigned long codigo = strtoul(texto.substr(posicao, 4).c_str(), nullptr, 16);
+          posicao += 4;
+          // UTF-8 do plano básico (pares substitutos não são tratados)
+          if (codigo < 0x80) {
+            saida += (char)codigo;
+          } else if (codigo < 0x800) {
+            saida += (char)(0xC0 | (codigo >> 6));
+            saida += (char)(0x80 | (codigo & 0x3F));
+          } else {
+            saida += (char)(0xE0 | (codigo >> 12));
+            saida += (char)(0x80 | ((codigo >> 6) & 0x3F));
+            saida += (char)(0x80 | (codigo & 0x3F));
+          }
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  bool lerValor(Json& saida, int profundidade) {
+    if (profundidade > 64) {
+      return false;
+    }
+    pularEspacos();
+    if (posicao >= texto.size()) {
+      return false;
+    }
+    char c = texto[posicao];
+
+    if (c == '{') {
+      posicao++;
+      saida = Json::objeto();
+      if (consumir('}')) {
+        return true;
+      }
+      do {
+        std::string chave;
+        if (!lerTexto(chave) || !consumir(':')) {
+          return false;
+        }
+        if (!lerValor(saida.membros()[chave], profundidade + 1)) {
+          return false;
+        }
+      } while (consumir(','));
+      return consumir('}');
+    }
+    if (c == '[') {
+      posicao++;
+      saida = Json::vetor();
+      if (consumir(']')) {
+        return true;
+      }
+      do {
+        saida.itens().emplace_back();
+        if (!lerValor(saida.itens().back(), profundidade + 1)) {
+          return false;
+        }
+      } while (consumir(','));
+      return consumir(']');
+    }
+    if (c == '"') {
+      std::string valor;
+      if (!lerTexto(valor)) {
+        return false;
+      }
+      saida = Json(valor);
+      return true;
+    }
+    if (palavra("true")) {
+      saida = Json(true);
+      return true;
+    }
+    if (palavra("false")) {
+      saida = Json(false);
+      return true;
+    }
+    if (palavra("null")) {
+      saida = Json();
+      return true;
+    }
+
+    const char* inicio = texto.c_str() + posicao;
+    char* fim = nullptr;
+    double numero = strtod(inicio, &fim);
+    if (fim == inicio) {
+      return false;
+    }
+    posicao += fim - inicio;
+    saida = Json(numero);
+    return true;
+  }
+};
+
+}  // namespace
+
+bool Json::interpretar(const std::string& texto, Json& saida) {
+  Leitor leitor{texto, 0};
+  Json resultado;
+  if (!leitor.lerValor(resultado, 0)) {
+    return false;
+  }
+  leitor.pularEspacos();
+  if (leitor.posicao != texto.size()) {
+    return false;
+  }
+  saida = resultado;
+  return true;
+}
+
+}  // namespace simulacao
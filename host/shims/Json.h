@@ -0,0 +1,76 @@
+/**
+ * @file Json.h
+ * @brief Árvore JSON mínima usada pelo RTDB simulado e pelo FirebaseJson
+ */
+#ifndef SIMULACAO_JSON_H
+#define SIMULACAO_JSON_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace simulacao {
+
+class Json {
+public:
+  enum class Tipo { Nulo, Booleano, Inteiro, Real, Texto, Objeto, Vetor };
+
+  Json() : tipo_(Tipo::Nulo) {}
+  Json(bool valor) : tipo_(Tipo::Booleano), booleano(valor) {}
+  Json(int valor) : Json((long long)valor) {}
+  Json(unsigned int valor) : Json((long long)valor) {}
+  Json(long valor) : Json((long long)valor) {}
+  Json(unsigned long valor) : Json((long long)valor) {}
+  Json(long long valor) : tipo_(Tipo::Inteiro), inteiro(valor) {}
+  Json(unsigned long long valor) : Json((long long)valor) {}
+  Json(float valor) : Json((double)valor) {}
+  Json(double valor);
+  Json(const char* valor) : tipo_(Tipo::Texto), texto(valor ? valor : "") {}
+  Json(const std::string& valor) : tipo_(Tipo::Texto), texto(valor) {}
+
+  static Json objeto();
+  static Json vetor();
+
+  Tipo tipo() const { return tipo_; }
+  bool nulo() const { return tipo_ == Tipo::Nulo; }
+  bool numero() const { return tipo_ == Tipo::Inteiro || tipo_ == Tipo::Real; }
+
+  bool comoBool() const { return tipo_ == Tipo::Booleano ? booleano : false; }
+  long long comoInteiro() const;
+  double comoReal() const;
+  const std::string& comoTexto() const { return texto; }
+
+  std::map<std::string, Json>& membros() { return objetoMembros; }
+  const std::map<std::string, Json>& membros() const { return objetoMembros; }
+  std::vector<Json>& itens() { return vetorItens; }
+  const std::vector<Json>& itens() const { return vetorItens; }
+
+  // Caminhos no formato "a/b/c" (barras extras são ignoradas)
+  const Json* buscar(const std::string& caminho) const;
+  Json& buscarOuCriar(const std::string& caminho);
+  bool remover(const std::string& caminho);
+
+  // Semântica do RTDB: nulos e objetos vazios deixam de existir
+  void podar();
+
+  std::string serializar() const;
+  static bool interpretar(const std::string& texto, Json& saida);
+
+  static std::vector<std::string> separarCaminho(const std::string& caminho);
+
+private:
+  Tipo tipo_;
+  bool booleano = false;
+  long long inteiro = 0;
+  double real = 0;
+  std::string texto;
+  std::map<std::string, Json> objetoMembros;
+  std::vector<Json> vetorItens;
+
+  void serializar(std::string& saida) const;
+};
+
+}  // namespace simulacao
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file LittleFS.h
+ * @brief LittleFS do Arduino-ESP32 para o build nativo (ver FS.h)
+ */
+#ifndef SHIM_LITTLEFS_H
+#define SHIM_LITTLEFS_H
+
+#include <FS.h>
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatarSeFalhar = false, const char* base = "/littlefs",
+             uint8_t maxArquivos = 10, const char* particao = "spiffs");
+  bool format();
+  void end() {}
+};
+
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,60 @@
+#include "MPU6500_WE.h"
+
+#include <cmath>
+
+namespace {
+
+// Conversão de 16 bits com saturação, como o registrador do sensor
+float quantizar(float valor, float faixa) {
+  float bruto = std::round(valor / faixa * 32768.0f);
+  if (bruto > 32767.0f) bruto = 32767.0f;
+  if (bruto < -32768.0f) bruto = -32768.0f;
+  return bruto * faixa / 32768.0f;
+}
+
+}  // namespace
+
+xyzFloat MPU6500_WE::getGValues() {
+  simulacao::AmostraIMU amostra = simulacao::lerIMU();
+  return xyzFloat(quantizar(amostra.ax, faixaAcel), quantizar(amostra.ay, faixaAcel),
+                  quantizar(amostra.az, faixaAcel));
+}
+
+xyzFloat MPU6500_WE::getGyrValues() {
+  simulacao::AmostraIMU amostra = simulacao::lerIMU();
+  return xyzFloat(quantizar(amostra.gx, faixaGiro), quantizar(amostra.gy, faixaGiro),
+                  quantizar(amostra.gz, faixaGiro));
+}
+
+float MPU6500_WE::getResultantG(xyzFloat gValue) {
+  return std::sqrt(gValue.x * gValue.x + gValue.y * gValue.y + gValue.z * gValue.z);
+}
+
+void MPU6500_WE::enableInterrupt(MPU6500_intType tipo) {
+  if (tipo == MPU6500_WOM_INT) {
+    interrupcaoWoM = true;
+    atualizarWoM();
+  }
+}
+
+void MPU6500_WE::disableInterrupt(MPU6500_intType tipo) {
+  if (tipo == MPU6500_WOM_INT) {
+    interrupcaoWoM = false;
+    atualizarWoM();
+  }
+}
+
+void MPU6500_WE::setWakeOnMotionThreshold(uint8_t limiar) {
+  limiarWoM = limiar;
+  atualizarWoM();
+}
+
+void MPU6500_WE::enableWakeOnMotion(MPU6500_womEn ativo, MPU6500_womCompEn comparacao) {
+  (void)comparacao;
+  womLigado = (ativo == MPU6500_WOM_ENABLE);
+  atualizarWoM();
+}
+
+void MPU6500_WE::atualizarWoM() {
+  simulacao::definirDespertarMovimento(interrupcaoWoM && womLigado, limiarWoM * 0.004f);
+}
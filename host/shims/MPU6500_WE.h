@@ -0,0 +1,107 @@
+/**
+ * @file MPU6500_WE.h
+ * @brief Subconjunto da MPU6500_WE para o build nativo
+ *
+ * As leituras vêm da IMU simulada (simulacao::lerIMU) e passam pela mesma
+ * quantização e saturação da faixa configurada que o sensor real aplica.
+ */
+#ifndef SHIM_MPU6500_WE_H
+#define SHIM_MPU6500_WE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+struct xyzFloat {
+  float x;
+  float y;
+  float z;
+
+  xyzFloat() : x(0), y(0), z(0) {}
+  xyzFloat(float x, float y, float z) : x(x), y(y), z(z) {}
+};
+
+typedef enum MPU9250_DLPF {
+  MPU6500_DLPF_0, MPU6500_DLPF_1, MPU6500_DLPF_2, MPU6500_DLPF_3,
+  MPU6500_DLPF_4, MPU6500_DLPF_5, MPU6500_DLPF_6, MPU6500_DLPF_7
+} MPU6500_dlpf;
+
+typedef enum MPU9250_GYRO_RANGE {
+  MPU6500_GYRO_RANGE_250, MPU6500_GYRO_RANGE_500, MPU6500_GYRO_RANGE_1000,
+  MPU6500_GYRO_RANGE_2000
+} MPU6500_gyroRange;
+
+typedef enum MPU9250_ACC_RANGE {
+  MPU6500_ACC_RANGE_2G, MPU6500_ACC_RANGE_4G, MPU6500_ACC_RANGE_8G, MPU6500_ACC_RANGE_16G
+} MPU6500_accRange;
+
+typedef enum MPU9250_INT_PIN_POL {
+  MPU6500_ACT_HIGH, MPU6500_ACT_LOW
+} MPU6500_intPinPol;
+
+typedef enum MPU9250_INT_TYPE {
+  MPU6500_DATA_READY = 0x01, MPU6500_FSYNC_INT = 0x08, MPU6500_FIFO_OVF = 0x10,
+  MPU6500_WOM_INT = 0x40
+} MPU6500_intType;
+
+typedef enum MPU9250_WOM_EN {
+  MPU6500_WOM_DISABLE, MPU6500_WOM_ENABLE
+} MPU6500_womEn;
+
+typedef enum MPU9250_WOM_COMP {
+  MPU6500_WOM_COMP_DISABLE, MPU6500_WOM_COMP_ENABLE
+} MPU6500_womCompEn;
+
+typedef enum MPU9250_LP_ACC_ODR {
+  MPU6500_LP_ACC_ODR_0_24, MPU6500_LP_ACC_ODR_0_49, MPU6500_LP_ACC_ODR_0_98,
+  MPU6500_LP_ACC_ODR_1_95, MPU6500_LP_ACC_ODR_3_91, MPU6500_LP_ACC_ODR_7_81,
+  MPU6500_LP_ACC_ODR_15_63, MPU6500_LP_ACC_ODR_31_25, MPU6500_LP_ACC_ODR_62_5,
+  MPU6500_LP_ACC_ODR_125, MPU6500_LP_ACC_ODR_250, MPU6500_LP_ACC_ODR_500
+} MPU6500_lpAccODR;
+
+class MPU6500_WE {
+public:
+  explicit MPU6500_WE(int endereco = 0x68) { (void)endereco; }
+  MPU6500_WE(TwoWire* wire, int endereco = 0x68) { (void)wire; (void)endereco; }
+
+  bool init() { return true; }
+  uint8_t whoAmI() { return 0x70; }
+  void autoOffsets() {}
+  void enableGyrDLPF() {}
+  void disableGyrDLPF() {}
+  void setGyrDLPF(MPU6500_dlpf dlpf) { (void)dlpf; }
+  void setSampleRateDivider(uint8_t divisor) { (void)divisor; }
+  void setGyrRange(MPU6500_gyroRange faixa) { faixaGiro = 250.0f * (1 << faixa); }
+  void setAccRange(MPU6500_accRange faixa) { faixaAcel = 2.0f * (1 << faixa); }
+  void enableAccDLPF(bool ativo) { (void)ativo; }
+  void setAccDLPF(MPU6500_dlpf dlpf) { (void)dlpf; }
+  void sleep(bool dormir) { (void)dormir; }
+
+  // Wake-on-motion: com a interrupção e o WoM ligados, o INT sobe quando um
+  // eixo varia mais que o limiar (4 mg por unidade); ver esp_sleep.h
+  void setIntPinPolarity(MPU6500_intPinPol polaridade) { (void)polaridade; }
+  void enableIntLatch(bool ativo) { (void)ativo; }
+  void enableClearIntByAnyRead(bool ativo) { (void)ativo; }
+  void enableInterrupt(MPU6500_intType tipo);
+  void disableInterrupt(MPU6500_intType tipo);
+  uint8_t readAndClearInterrupts() { return 0; }
+  void setWakeOnMotionThreshold(uint8_t limiar);
+  void enableWakeOnMotion(MPU6500_womEn ativo, MPU6500_womCompEn comparacao);
+  void setLowPowerAccDataRate(MPU6500_lpAccODR taxa) { (void)taxa; }
+  void enableCycle(bool ativo) { (void)ativo; }
+
+  xyzFloat getGValues();
+  xyzFloat getGyrValues();
+  float getResultantG(xyzFloat gValue);
+  float getTemperature() { return 25.0f; }
+
+private:
+  float faixaAcel = 2.0f;   // g
+  float faixaGiro = 250.0f; // graus/s
+  bool interrupcaoWoM = false;
+  bool womLigado = false;
+  uint8_t limiarWoM = 0;
+
+  void atualizarWoM();
+};
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file NTPClient.h
+ * @brief NTPClient para o build nativo
+ *
+ * A hora "da rede" é EPOCA_SIMULADA mais o relógio simulado, de modo que o
+ * relógio virtual também avança os timestamps enviados ao RTDB.
+ */
+#ifndef SHIM_NTPCLIENT_H
+#define SHIM_NTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+#define EPOCA_SIMULADA 1760000000UL  // 09/10/2025 08:53:20 UTC
+
+class NTPClient {
+public:
+  NTPClient(WiFiUDP& udp, const char* servidor, long deslocamento = 0)
+    : deslocamento(deslocamento) { (void)udp; (void)servidor; }
+
+  void begin() {}
+  void end() {}
+  void setTimeOffset(int segundos) { deslocamento = segundos; }
+  bool forceUpdate() {
+    sincronizado = simulacao::wifiConectado();
+    return sincronizado;
+  }
+  bool update() { return sincronizado || forceUpdate(); }
+  bool isTimeSet() const { return sincronizado; }
+
+  unsigned long getEpochTime() const {
+    unsigned long base = sincronizado ? EPOCA_SIMULADA : 0;
+    return base + deslocamento + (unsigned long)(simulacao::agoraUs() / 1000000ULL);
+  }
+  int getHours() const { return (getEpochTime() % 86400L) / 3600; }
+  int getMinutes() const { return (getEpochTime() % 3600) / 60; }
+  int getSeconds() const { return getEpochTime() % 60; }
+  String getFormattedTime() const {
+    char texto[9];
+    snprintf(texto, sizeof(texto), "%02d:%02d:%02d", getHours(), getMinutes(), getSeconds());
+    return String(texto);
+  }
+
+private:
+  long deslocamento;
+  bool sincronizado = false;
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "PainelSSD1306.h"
+
+#include <cstring>
+
+namespace simulacao {
+
+namespace {
+
+// Número de bytes de argumento de cada comando do SSD1306
+uint8_t argumentosDoComando(uint8_t comando) {
+  switch (comando) {
+    case 0x20:  // Modo de endereçamento
+    case 0x81:  // Contraste
+    case 0x8D:  // Charge pump
+    case 0xA8:  // Multiplex
+    case 0xD3:  // Deslocamento vertical
+    case 0xD5:  // Clock
+    case 0xD9:  // Pré-carga
+    case 0xDA:  // Pinos COM
+    case 0xDB:  // VCOMH
+      return 1;
+    case 0x21:  // COLUMNADDR
+    case 0x22:  // PAGEADDR
+      return 2;
+    case 0x26:  // Rolagem horizontal
+    case 0x27:
+      return 6;
+    case 0x29:
+    case 0x2A:
+      return 5;
+    case 0xA3:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+PainelSSD1306::PainelSSD1306() {
+  reiniciar();
+}
+
+void PainelSSD1306::reiniciar() {
+  memset(gddram, 0, sizeof(gddram));
+  colunaInicio = 0;
+  colunaFim = LARGURA - 1;
+  paginaInicio = 0;
+  paginaFim = PAGINAS - 1;
+  coluna = 0;
+  pagina = 0;
+  exibindo = false;
+  argumentosRecebidos = 0;
+  argumentosEsperados = 0;
+  zerarContadores();
+}
+
+void PainelSSD1306::zerarContadores() {
+  contadorDados = 0;
+  contadorComandos = 0;
+}
+
+bool PainelSSD1306::pixel(int x, int y) const {
+  if (x < 0 || x >= LARGURA || y < 0 || y >= PAGINAS * 8) {
+    return false;
+  }
+  return gddram[x + (y / 8) * LARGURA] & (1 << (y & 7));
+}
+
+void PainelSSD1306::receber(const uint8_t* dados, size_t quantidade) {
+  if (quantidade == 0) {
+    return;
+  }
+  // Sem o bit Co, o byte de controle vale para o resto da transação
+  bool saoDados = dados[0] & 0x40;
+  for (size_t i = 1; i < quantidade; i++) {
+    if (saoDados) {
+      escreverDado(dados[i]);
+    } else {
+      processarComando(dados[i]);
+    }
+  }
+}
+
+void PainelSSD1306::processarComando(uint8_t byte) {
+  contadorComandos++;
+  if (argumentosRecebidos < argumentosEsperados) {
+    argumentos[argumentosRecebidos++] = byte;
+    if (argumentosRecebidos == argumentosEsperados) {
+      executarComando();
+    }
+    return;
+  }
+  comandoAtual = byte;
+  argumentosRecebidos = 0;
+  argumentosEsperados = argumentosDoComando(byte);
+  if (argumentosEsperados == 0) {
+    executarComando();
+  }
+}
+
+void PainelSSD1306::executarComando() {
+  switch (comandoAtual) {
+    case 0xAE:
+      exibindo = false;
+      break;
+    case 0xAF:
+      exibindo = true;
+      break;
+    case 0x21:
+      colunaInicio = argumentos[0] & 0x7F;
+      colunaFim = argumentos[1] & 0x7F;
+      coluna = colunaInicio;
+      break;
+    case 0x22:
+      paginaInicio = argumentos[0] & 0x07;
+      paginaFim = argumentos[1] & 0x07;
+      pagina = paginaInicio;
+      break;
+    default:
+      break;
+  }
+  argumentosEsperados = 0;
+  argumentosRecebidos = 0;
+}
+
+void PainelSSD1306::escreverDado(uint8_t byte) {
+  contadorDados++;
+  gddram[coluna + pagina * LARGURA] = byte;
+  // Endereçamento horizontal: coluna, depois página, voltando ao início
+  if (coluna >= colunaFim) {
+    coluna = colunaInicio;
+    pagina = pagina >= paginaFim ? paginaInicio : pagina + 1;
+  } else {
+    coluna++;
+  }
+}
+
+PainelSSD1306& painelSSD1306() {
+  static PainelSSD1306 painel;
+  return painel;
+}
+
+}  // namespace simulacao
@@ -0,0 +1,58 @@
+/**
+ * @file PainelSSD1306.h
+ * @brief Controlador SSD1306 simulado no endereço I2C 0x3C
+ *
+ * Interpreta o fluxo I2C que chega ao painel (byte de controle 0x00 para
+ * comandos, 0x40 para dados) com endereçamento horizontal e as janelas de
+ * COLUMNADDR/PAGEADDR. A GDDRAM resultante mostra exatamente o que um
+ * painel real exibiria, o que permite verificar envios parciais.
+ */
+#ifndef SIMULACAO_PAINEL_SSD1306_H
+#define SIMULACAO_PAINEL_SSD1306_H
+
+#include <Wire.h>
+
+namespace simulacao {
+
+class PainelSSD1306 : public DispositivoI2C {
+public:
+  static const int LARGURA = 128;
+  static const int PAGINAS = 8;
+
+  PainelSSD1306();
+  void receber(const uint8_t* dados, size_t quantidade) override;
+
+  void reiniciar();
+  const uint8_t* memoria() const { return gddram; }
+  bool pixel(int x, int y) const;
+  bool ligado() const { return exibindo; }
+
+  uint32_t bytesDados() const { return contadorDados; }
+  uint32_t bytesComandos() const { return contadorComandos; }
+  void zerarContadores();
+
+private:
+  uint8_t gddram[LARGURA * PAGINAS];
+  uint8_t colunaInicio, colunaFim, paginaInicio, paginaFim;
+  uint8_t coluna, pagina;
+  bool exibindo;
+
+  // Comando com argumentos pendentes
+  uint8_t comandoAtual;
+  uint8_t argumentos[6];
+  uint8_t argumentosRecebidos;
+  uint8_t argumentosEsperados;
+
+  uint32_t contadorDados;
+  uint32_t contadorComandos;
+
+  void processarComando(uint8_t byte);
+  void executarComando();
+  void escreverDado(uint8_t byte);
+};
+
+PainelSSD1306& painelSSD1306();
+
+}  // namespace simulacao
+
+#endif
@@ -0,0 +1,54 @@
+#include "Print.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+size_t Print::write(const uint8_t* dados, size_t quantidade) {
+  size_t escritos = 0;
+  for (size_t i = 0; i < quantidade; i++) {
+    escritos += write(dados[i]);
+  }
+  return escritos;
+}
+
+size_t Print::write(const char* texto) {
+  return texto ? write((const uint8_t*)texto, strlen(texto)) : 0;
+}
+
+size_t Print::print(const String& texto) { return write(texto.c_str()); }
+size_t Print::print(const char* texto) { return write(texto); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(int numero, int base) { return print(String(numero, base)); }
+size_t Print::print(unsigned int numero, int base) { return print(String(numero, base)); }
+size_t Print::print(long numero, int base) { return print(String(numero, base)); }
+size_t Print::print(unsigned long numero, int base) { return print(String(numero, base)); }
+size_t Print::print(long long numero, int base) { return print(String(numero, base)); }
+size_t Print::print(unsigned long long numero, int base) { return print(String(numero, base)); }
+size_t Print::print(double numero, int casas) { return print(String(numero, casas)); }
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+size_t Print::printf(const char* formato, ...) {
+  char buffer[256];
+  va_list argumentos;
+  va_start(argumentos, formato);
+  int tamanho = vsnprintf(buffer, sizeof(buffer), formato, argumentos);
+  va_end(argumentos);
+
+  if (tamanho < 0) {
+    return 0;
+  }
+  if ((size_t)tamanho < sizeof(buffer)) {
+    return write((const uint8_t*)buffer, tamanho);
+  }
+
+  std::vector<char> grande(tamanho + 1);
+  va_start(argumentos, formato);
+  vsnprintf(grande.data(), grande.size(), formato, argumentos);
+  va_end(argumentos);
+  return write((const uint8_t*)grande.data(), tamanho);
+}
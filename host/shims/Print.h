@@ -0,0 +1,53 @@
+/**
+ * @file Print.h
+ * @brief Print/Stream do Arduino (build nativo)
+ */
+#ifndef SHIM_PRINT_H
+#define SHIM_PRINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* dados, size_t quantidade);
+  size_t write(const char* texto);
+  size_t write(const char* dados, size_t quantidade) { return write((const uint8_t*)dados, quantidade); }
+
+  size_t print(const String& texto);
+  size_t print(const char* texto);
+  size_t print(char c);
+  size_t print(int numero, int base = DEC);
+  size_t print(unsigned int numero, int base = DEC);
+  size_t print(long numero, int base = DEC);
+  size_t print(unsigned long numero, int base = DEC);
+  size_t print(long long numero, int base = DEC);
+  size_t print(unsigned long long numero, int base = DEC);
+  size_t print(double numero, int casas = 2);
+
+  size_t println();
+  template <typename T>
+  size_t println(const T& valor) { size_t n = print(valor); return n + println(); }
+  template <typename T>
+  size_t println(const T& valor, int formato) { size_t n = print(valor, formato); return n + println(); }
+
+  size_t printf(const char* formato, ...) __attribute__((format(printf, 2, 3)));
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#include "RTDB.h"
+#include "Simulacao.h"
+
+#include <chrono>
+
+namespace simulacao {
+
+namespace {
+RTDBMemoria memoria;
+std::atomic<RTDB*> ativo{nullptr};
+std::atomic<bool> pronto{true};
+}
+
+FluxoMemoria::FluxoMemoria(const std::string& caminho)
+    : caminhoPartes(Json::separarCaminho(caminho)) {}
+
+bool FluxoMemoria::proximo(EventoRTDB& evento, uint32_t esperaMs) {
+  std::unique_lock<std::mutex> trava(mutex);
+  if (fila.empty() && esperaMs > 0) {
+    novoEvento.wait_for(trava, std::chrono::milliseconds(esperaMs),
+                        [this] { return !fila.empty(); });
+  }
+  if (fila.empty()) {
+    return false;
+  }
+  evento = fila.front();
+  fila.pop_front();
+  return true;
+}
+
+void FluxoMemoria::publicar(const EventoRTDB& evento) {
+  {
+    std::lock_guard<std::mutex> trava(mutex);
+    fila.push_back(evento);
+  }
+  simulacao::sinalizarRede();  // Acorda o light sleep com WiFi (esp_sleep.h)
+  novoEvento.notify_all();
+}
+
+bool RTDBMemoria::ler(const std::string& caminho, Json& valor, std::string& erro) {
+  std::lock_guard<std::mutex> trava(mutex);
+  contadores.leituras++;
+  const Json* encontrado = raiz.buscar(caminho);
+  if (encontrado == nullptr || encontrado->nulo()) {
+    erro = "path not exist";
+    return false;
+  }
+  valor = *encontrado;
+  contadores.bytesRecebidos += valor.serializar().size();
+  return true;
+}
+
+bool RTDBMemoria::gravar(const std::string& caminho, const Json& valor, std::string& erro) {
+  (void)erro;
+  std::lock_guard<std::mutex> trava(mutex);
+  contadores.escritas++;
+  contadores.bytesEnviados += valor.serializar().size();
+  if (valor.nulo()) {
+    raiz.remover(caminho);
+  } else {
+    raiz.buscarOuCriar(caminho) = valor;
+  }
+  raiz.podar();
+  notificar(caminho, "put", valor);
+  return true;
+}
+
+bool RTDBMemoria::atualizar(const std::string& caminho, const Json& valor, std::string& erro) {
+  if (valor.tipo() != Json::Tipo::Objeto) {
+    erro = "invalid data; only object is allowed";
+    return false;
+  }
+  std::lock_guard<std::mutex> trava(mutex);
+  contadores.escritas++;
+  contadores.bytesEnviados += valor.serializar().size();
+
+  // PATCH: cada filho do objeto substitui o nó correspondente
+  Json& destino = raiz.buscarOuCriar(caminho);
+  if (destino.tipo() != Json::Tipo::Objeto) {
+    destino = Json::objeto();
+  }
+  for (const auto& item : valor.membros()) {
+    if (item.second.nulo()) {
+      destino.remover(item.first);
+    } else {
+      destino.buscarOuCriar(item.first) = item.second;
+    }
+  }
+  raiz.podar();
+  notificar(caminho, "patch", valor);
+  return true;
+}
+
+bool RTDBMemoria::remover(const std::string& caminho, std::string& erro) {
+  (void)erro;
+  std::lock_guard<std::mutex> trava(mutex);
+  contadores.remocoes++;
+  raiz.remover(caminho);
+  raiz.podar();
+  notificar(caminho, "put", Json());
+  return true;
+}
+
+std::shared_ptr<FluxoRTDB> RTDBMemoria::observar(const std::string& caminho, std::string& erro) {
+  (void)erro;
+  std::lock_guard<std::mutex> trava(mutex);
+  auto fluxo = std::make_shared<FluxoMemoria>(caminho);
+  const Json* atual = raiz.buscar(caminho);
+  fluxo->publicar({"put", "/", atual ? *atual : Json()});
+  contadores.eventos++;
+  fluxos.push_back(fluxo);
+  return fluxo;
+}
+
+void RTDBMemoria::notificar(const std::string& caminho, const std::string& tipo,
+                            const Json& dados) {
+  std::vector<std::string> escrito = Json::separarCaminho(caminho);
+  for (auto item = fluxos.begin(); item != fluxos.end();) {
+    std::shared_ptr<FluxoMemoria> fluxo = item->lock();
+    if (!fluxo) {
+      item = fluxos.erase(item);
+      continue;
+    }
+    item++;
+
+    const std::vector<std::string>& observado = fluxo->partes();
+    size_t comum = 0;
+    while (comum < escrito.size() && comum < observado.size() &&
+           escrito[comum] == observado[comum]) {
+      comum++;
+    }
+
+    if (comum == observado.size()) {
+      // Escrita dentro do nó observado: repassa com o caminho relativo
+      std::string relativo;
+      for (size_t i = comum; i < escrito.size(); i++) {
+        relativo += "/" + escrito[i];
+      }
+      fluxo->publicar({tipo, relativo.empty() ? "/" : relativo, dados});
+    } else if (comum == escrito.size()) {
+      // Escrita num ancestral: o nó observado é reenviado inteiro
+      // Num patch com vários caminhos ("saida/estado"), vale o primeiro trecho
+      if (tipo == "patch") {
+        bool toca = false;
+        for (const auto& membro : dados.membros()) {
+          std::vector<std::string> chave = Json::separarCaminho(membro.first);
+          toca = toca || (!chave.empty() && chave[0] == observado[comum]);
+        }
+        if (!toca) {
+          continue;
+        }
+      }
+      std::string completo;
+      for (const std::string& parte : observado) {
+        completo += "/" + parte;
+      }
+      const Json* atual = raiz.buscar(completo);
+      fluxo->publicar({"put", "/", atual ? *atual : Json()});
+    } else {
+      continue;
+    }
+    contadores.eventos++;
+  }
+}
+
+void RTDBMemoria::limpar() {
+  std::lock_guard<std::mutex> trava(mutex);
+  raiz = Json();
+  contadores = EstatisticasRTDB();
+  fluxos.clear();
+}
+
+Json RTDBMemoria::instantaneo() {
+  std::lock_guard<std::mutex> trava(mutex);
+  return raiz;
+}
+
+EstatisticasRTDB RTDBMemoria::estatisticas() {
+  std::lock_guard<std::mutex> trava(mutex);
+  return contadores;
+}
+
+RTDBMemoria& rtdbMemoria() {
+  return memoria;
+}
+
+void definirRTDB(RTDB* rtdb) {
+  ativo = rtdb;
+}
+
+RTDB& rtdb() {
+  RTDB* atual = ativo.load();
+  return atual ? *atual : memoria;
+}
+
+void definirFirebasePronto(bool valor) {
+  pronto = valor;
+}
+
+bool firebasePronto() {
+  return pronto;
+}
+
+}  // namespace simulacao
@@ -0,0 +1,116 @@
+/**
+ * @file RTDB.h
+ * @brief Realtime Database simulado para o build nativo
+ *
+ * O shim do Firebase_ESP_Client encaminha cada operação para o RTDB ativo.
+ * O padrão é uma árvore em memória compartilhada por todo o processo;
+ * simuladores podem trocar por outro backend (ex.: HTTP) com definirRTDB().
+ */
+#ifndef SIMULACAO_RTDB_H
+#define SIMULACAO_RTDB_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Json.h"
+
+namespace simulacao {
+
+struct EstatisticasRTDB {
+  uint64_t leituras;
+  uint64_t escritas;
+  uint64_t remocoes;
+  uint64_t bytesRecebidos;  // Respostas entregues ao dispositivo
+  uint64_t bytesEnviados;   // Corpos enviados pelo dispositivo
+  uint64_t eventos;         // Eventos entregues aos fluxos (streams)
+};
+
+// Evento de um fluxo, como no SSE do RTDB: "put" substitui o nó em
+// `caminho` (relativo ao nó observado, "/" = ele inteiro), "patch" atualiza
+// os filhos listados em `dados`
+struct EventoRTDB {
+  std::string tipo;
+  std::string caminho;
+  Json dados;
+};
+
+class FluxoRTDB {
+public:
+  virtual ~FluxoRTDB() {}
+
+  // Próximo evento, esperando até esperaMs (0: não bloqueia)
+  virtual bool proximo(EventoRTDB& evento, uint32_t esperaMs) = 0;
+  // false quando a conexão do fluxo caiu
+  virtual bool ativo() = 0;
+};
+
+class RTDB {
+public:
+  virtual ~RTDB() {}
+
+  // Erros seguem os textos do Firebase_ESP_Client ("path not exist", ...)
+  virtual bool ler(const std::string& caminho, Json& valor, std::string& erro) = 0;
+  virtual bool gravar(const std::string& caminho, const Json& valor, std::string& erro) = 0;
+  virtual bool atualizar(const std::string& caminho, const Json& valor, std::string& erro) = 0;
+  virtual bool remover(const std::string& caminho, std::string& erro) = 0;
+
+  // Abre um fluxo do nó; o primeiro evento é um "put" com o valor atual
+  virtual std::shared_ptr<FluxoRTDB> observar(const std::string& caminho, std::string& erro) = 0;
+};
+
+// Fila de eventos alimentada pelo RTDBMemoria
+class FluxoMemoria : public FluxoRTDB {
+public:
+  explicit FluxoMemoria(const std::string& caminho);
+
+  bool proximo(EventoRTDB& evento, uint32_t esperaMs) override;
+  bool ativo() override { return true; }
+
+  void publicar(const EventoRTDB& evento);
+  const std::vector<std::string>& partes() const { return caminhoPartes; }
+
+private:
+  std::vector<std::string> caminhoPartes;
+  std::mutex mutex;
+  std::condition_variable novoEvento;
+  std::deque<EventoRTDB> fila;
+};
+
+class RTDBMemoria : public RTDB {
+public:
+  bool ler(const std::string& caminho, Json& valor, std::string& erro) override;
+  bool gravar(const std::string& caminho, const Json& valor, std::string& erro) override;
+  bool atualizar(const std::string& caminho, const Json& valor, std::string& erro) override;
+  bool remover(const std::string& caminho, std::string& erro) override;
+  std::shared_ptr<FluxoRTDB> observar(const std::string& caminho, std::string& erro) override;
+
+  void limpar();
+  Json instantaneo();  // Cópia da árvore inteira
+  EstatisticasRTDB estatisticas();
+
+private:
+  std::mutex mutex;
+  Json raiz;
+  EstatisticasRTDB contadores = {};
+  std::vector<std::weak_ptr<FluxoMemoria>> fluxos;
+
+  // Avisa os fluxos afetados por uma escrita em `caminho` (com o mutex)
+  void notificar(const std::string& caminho, const std::string& tipo, const Json& dados);
+};
+
+RTDBMemoria& rtdbMemoria();
+void definirRTDB(RTDB* rtdb);  // nullptr volta ao RTDB em memória
+RTDB& rtdb();
+
+void definirFirebasePronto(bool pronto);
+bool firebasePronto();
+
+}  // namespace simulacao
+
+#endif
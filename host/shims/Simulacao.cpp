@@ -0,0 +1,265 @@
+#include "Simulacao.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "RTDB.h"
+#include "esp_sleep.h"
+
+namespace simulacao {
+
+// Definidas em FreeRTOS.cpp
+void dormirInterrompivel(uint64_t usReais);
+void reiniciarTarefas();
+// Definida em esp_ota.cpp
+void reiniciarParticoesOta();
+
+namespace {
+
+std::mutex mutexEstado;
+
+// Relógio
+std::atomic<int> modo{(int)ModoRelogio::Virtual};
+std::atomic<uint64_t> tempoVirtualUs{0};
+double escalaRelogio_ = 1.0;
+std::chrono::steady_clock::time_point inicioReal = std::chrono::steady_clock::now();
+uint64_t deslocamentoRealUs = 0;
+
+// Sensores
+const int NUM_PINOS = 64;
+std::atomic<uint16_t> toques[NUM_PINOS];
+FonteToque fonteToque;
+std::atomic<uint32_t> contadorToque{0};
+
+FonteIMU fonteIMU;
+std::atomic<uint32_t> contadorIMU{0};
+
+// Sono
+std::atomic<bool> movimentoAtivo{false};
+std::atomic<float> limiarMovimentoG{0};
+std::atomic<uint32_t> contadorRede{0};
+
+// Serial
+SaidaSerial saidaSerial;
+std::atomic<bool> serialSilencioso{false};
+std::deque<uint8_t> entradaSerial;
+
+// Rede
+std::atomic<bool> wifi{true};
+thread_local String macThread;
+
+}  // namespace
+
+void definirRelogio(ModoRelogio novoModo, double escala) {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  // Continua a contagem do ponto atual para o tempo nunca voltar
+  uint64_t agora = (ModoRelogio)modo.load() == ModoRelogio::Virtual
+                       ? tempoVirtualUs.load()
+                       : deslocamentoRealUs + (uint64_t)(std::chrono::duration<double, std::micro>(
+                                                   std::chrono::steady_clock::now() - inicioReal)
+                                                   .count() * escalaRelogio_);
+  escalaRelogio_ = escala > 0 ? escala : 1.0;
+  tempoVirtualUs = agora;
+  deslocamentoRealUs = agora;
+  inicioReal = std::chrono::steady_clock::now();
+  modo = (int)novoModo;
+}
+
+ModoRelogio modoRelogio() {
+  return (ModoRelogio)modo.load();
+}
+
+double escalaRelogio() {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  return escalaRelogio_;
+}
+
+uint64_t agoraUs() {
+  if ((ModoRelogio)modo.load() == ModoRelogio::Virtual) {
+    return tempoVirtualUs.load();
+  }
+  // Travado: um teste pode trocar a escala com as tarefas rodando
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  double decorrido = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - inicioReal).count();
+  return deslocamentoRealUs + (uint64_t)(decorrido * escalaRelogio_);
+}
+
+void avancarUs(uint64_t us) {
+  tempoVirtualUs += us;
+}
+
+void esperarUs(uint64_t us) {
+  if ((ModoRelogio)modo.load() == ModoRelogio::Virtual) {
+    tempoVirtualUs += us;
+    verificarEncerramento();
+    return;
+  }
+  dormirInterrompivel((uint64_t)(us / escalaRelogio()));
+}
+
+void definirToque(uint8_t pino, uint16_t valor) {
+  if (pino < NUM_PINOS) {
+    toques[pino] = valor;
+  }
+}
+
+void definirFonteToque(FonteToque fonte) {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  fonteToque = fonte;
+}
+
+uint16_t lerToque(uint8_t pino) {
+  contadorToque++;
+  FonteToque fonte;
+  {
+    std::lock_guard<std::mutex> trava(mutexEstado);
+    fonte = fonteToque;
+  }
+  if (fonte) {
+    return fonte(pino, agoraUs());
+  }
+  return pino < NUM_PINOS ? toques[pino].load() : 0;
+}
+
+uint32_t leiturasToque() {
+  return contadorToque;
+}
+
+void definirFonteIMU(FonteIMU fonte) {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  fonteIMU = fonte;
+}
+
+AmostraIMU lerIMU() {
+  contadorIMU++;
+  FonteIMU fonte;
+  {
+    std::lock_guard<std::mutex> trava(mutexEstado);
+    fonte = fonteIMU;
+  }
+  if (fonte) {
+    return fonte(agoraUs());
+  }
+  AmostraIMU repouso = {0, 0, 1, 0, 0, 0};
+  return repouso;
+}
+
+uint32_t leiturasIMU() {
+  return contadorIMU;
+}
+
+void definirDespertarMovimento(bool ativo, float limiarG) {
+  limiarMovimentoG = limiarG;
+  movimentoAtivo = ativo;
+}
+
+bool despertarMovimentoAtivo() {
+  return movimentoAtivo;
+}
+
+float limiarDespertarMovimento() {
+  return limiarMovimentoG;
+}
+
+void sinalizarRede() {
+  contadorRede++;
+}
+
+uint32_t sinaisRede() {
+  return contadorRede;
+}
+
+void definirSaidaSerial(SaidaSerial saida) {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  saidaSerial = saida;
+}
+
+void silenciarSerial(bool silencioso) {
+  serialSilencioso = silencioso;
+}
+
+void escreverSerial(const uint8_t* dados, size_t quantidade) {
+  SaidaSerial saida;
+  {
+    std::lock_guard<std::mutex> trava(mutexEstado);
+    saida = saidaSerial;
+  }
+  if (saida) {
+    saida(dados, quantidade);
+  } else if (!serialSilencioso) {
+    fwrite(dados, 1, quantidade, stdout);
+  }
+}
+
+void definirEntradaSerial(const String& texto) {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  entradaSerial.insert(entradaSerial.end(), texto.c_str(), texto.c_str() + texto.length());
+}
+
+int lerSerial() {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  if (entradaSerial.empty()) {
+    return -1;
+  }
+  int c = entradaSerial.front();
+  entradaSerial.pop_front();
+  return c;
+}
+
+int disponivelSerial() {
+  std::lock_guard<std::mutex> trava(mutexEstado);
+  return entradaSerial.size();
+}
+
+void definirWiFiConectado(bool conectado) {
+  wifi = conectado;
+}
+
+bool wifiConectado() {
+  return wifi;
+}
+
+void definirMacThread(const String& mac) {
+  macThread = mac;
+}
+
+String macAtual() {
+  return macThread.isEmpty() ? String("24:6F:28:AA:BB:CC") : macThread;
+}
+
+void reiniciar() {
+  reiniciarTarefas();
+  definirGanchosTarefa(nullptr, nullptr);
+  {
+    std::lock_guard<std::mutex> trava(mutexEstado);
+    modo = (int)ModoRelogio::Virtual;
+    tempoVirtualUs = 0;
+    escalaRelogio_ = 1.0;
+    deslocamentoRealUs = 0;
+    inicioReal = std::chrono::steady_clock::now();
+    fonteToque = nullptr;
+    fonteIMU = nullptr;
+    saidaSerial = nullptr;
+    entradaSerial.clear();
+  }
+  for (int i = 0; i < NUM_PINOS; i++) {
+    toques[i] = 0;
+  }
+  contadorToque = 0;
+  contadorIMU = 0;
+  movimentoAtivo = false;
+  contadorRede = 0;
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  wifi = true;
+  definirRTDB(nullptr);
+  definirFirebasePronto(true);
+  rtdbMemoria().limpar();
+  reiniciarParticoesOta();
+}
+
+}  // namespace simulacao
@@ -0,0 +1,117 @@
+/**
+ * @file Simulacao.h
+ * @brief Controle do hardware simulado do build nativo
+ *
+ * Os shims do Arduino, do MPU6500, do FreeRTOS e do Firebase leem o estado
+ * do "mundo" daqui. Testes, replays e simuladores usam estas funções para
+ * definir o que os sensores enxergam e como o tempo passa.
+ *
+ * @section relogio Relógio
+ * - Virtual: delay()/vTaskDelay() apenas avançam o relógio, sem dormir.
+ *   Determinístico e mais rápido que o tempo real; só para uso em uma thread.
+ * - Real: relógio monotônico do host multiplicado por uma escala (escala 10
+ *   faz 1 s de firmware durar 100 ms). Necessário quando há tarefas.
+ */
+#ifndef SIMULACAO_H
+#define SIMULACAO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "WString.h"
+
+namespace simulacao {
+
+// ---------------------------------------------------------------- Relógio
+enum class ModoRelogio { Virtual, Real };
+
+void definirRelogio(ModoRelogio modo, double escala = 1.0);
+ModoRelogio modoRelogio();
+double escalaRelogio();
+uint64_t agoraUs();
+void avancarUs(uint64_t us);   // Só no relógio virtual
+void esperarUs(uint64_t us);   // Base de delay(), vTaskDelay() e timeouts
+
+// ---------------------------------------------------------------- Toque
+typedef std::function<uint16_t(uint8_t pino, uint64_t tempoUs)> FonteToque;
+
+void definirToque(uint8_t pino, uint16_t valor);
+void definirFonteToque(FonteToque fonte);
+uint16_t lerToque(uint8_t pino);
+uint32_t leiturasToque();  // Número de chamadas a touchRead()
+
+// ---------------------------------------------------------------- IMU
+struct AmostraIMU {
+  float ax, ay, az;  // g
+  float gx, gy, gz;  // graus/s
+};
+typedef std::function<AmostraIMU(uint64_t tempoUs)> FonteIMU;
+
+void definirFonteIMU(FonteIMU fonte);
+AmostraIMU lerIMU();
+uint32_t leiturasIMU();
+
+// ---------------------------------------------------------------- Sono
+// Wake-on-motion do MPU6500 (ligado pelo shim) e pacotes que chegam pelo
+// WiFi: o esp_light_sleep_start() simulado acorda com eles (esp_sleep.h)
+void definirDespertarMovimento(bool ativo, float limiarG);
+bool despertarMovimentoAtivo();
+float limiarDespertarMovimento();
+void sinalizarRede();
+uint32_t sinaisRede();
+
+// ---------------------------------------------------------------- Serial
+typedef std::function<void(const uint8_t* dados, size_t quantidade)> SaidaSerial;
+
+void definirSaidaSerial(SaidaSerial saida);  // nullptr: stdout
+void silenciarSerial(bool silencioso);
+void escreverSerial(const uint8_t* dados, size_t quantidade);
+void definirEntradaSerial(const String& texto);
+int lerSerial();
+int disponivelSerial();
+
+// ---------------------------------------------------------------- Rede
+void definirWiFiConectado(bool conectado);
+bool wifiConectado();
+void definirMacThread(const String& mac);  // MAC vista pela thread atual
+String macAtual();
+
+// ---------------------------------------------------------------- Tarefas
+// Lançada dentro das tarefas quando o simulador pede o encerramento
+struct EncerramentoTarefa {};
+
+void encerrarTarefas();        // Sinaliza, acorda e aguarda todas as tarefas
+bool encerrando();
+void verificarEncerramento();  // Lança EncerramentoTarefa numa tarefa encerrando
+bool emTarefa();               // A thread atual é uma tarefa do FreeRTOS simulado
+
+// Como os traceTASK_SWITCHED_IN/OUT do FreeRTOS: "entrou" quando uma tarefa
+// começa ou volta de uma espera de verdade (relógio real), "saiu" quando vai
+// esperar. Chamados na thread da tarefa; nullptr desliga
+typedef void (*GanchoTarefa)();
+void definirGanchosTarefa(GanchoTarefa entrou, GanchoTarefa saiu);
+
+// ---------------------------------------------------------------- OTA
+// Partições ota_0 e ota_1 em memória (esp_ota_ops.h); a imagem de fábrica
+// (gravarFirmwareOta) fica na ota_0, sem estado na otadata, como gravada
+// pela serial. ESP.restart() numa tarefa só marca o pedido e
+// para a tarefa: o teste encerra as tarefas, chama reiniciarOta(), que faz
+// o que o bootloader faz (escolhe a partição e desfaz a imagem nova que não
+// foi confirmada), e roda o setup() de novo
+void gravarFirmwareOta(const uint8_t* imagem, size_t tamanho);
+size_t lerParticaoOta(int indice, uint8_t* dados, size_t tamanho);
+int particaoOtaAtual();
+int estadoParticaoOta(int indice);  // esp_ota_img_states_t
+void pedirReinicio();
+bool reinicioPedido();
+int reiniciarOta();                 // Devolve a partição que "subiu"
+
+// ---------------------------------------------------------------- Geral
+// Volta todo o estado simulado ao padrão (relógio virtual em zero, toques em
+// zero, IMU em repouso, WiFi conectado, RTDB em memória vazio, partições
+// OTA vazias)
+void reiniciar();
+
+}  // namespace simulacao
+
+#endif
@@ -0,0 +1,149 @@
+#include "WString.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+static std::string formatarInteiro(unsigned long long numero, bool negativo, unsigned char base) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+  std::string texto;
+  do {
+    int digito = numero % base;
+    texto += (char)(digito < 10 ? '0' + digito : 'a' + digito - 10);
+    numero /= base;
+  } while (numero > 0);
+  if (negativo) {
+    texto += '-';
+  }
+  std::reverse(texto.begin(), texto.end());
+  return texto;
+}
+
+static std::string formatarReal(double numero, unsigned int casas) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int)casas, numero);
+  return buffer;
+}
+
+String::String(int numero, unsigned char base) : String((long long)numero, base) {}
+String::String(unsigned int numero, unsigned char base) : String((unsigned long long)numero, base) {}
+String::String(long numero, unsigned char base) : String((long long)numero, base) {}
+String::String(unsigned long numero, unsigned char base) : String((unsigned long long)numero, base) {}
+
+String::String(long long numero, unsigned char base) {
+  // Como no Arduino, só a base 10 tem sinal
+  if (base == 10 && numero < 0) {
+    valor = formatarInteiro(0ULL - (unsigned long long)numero, true, base);
+  } else {
+    valor = formatarInteiro((unsigned long long)numero, false, base);
+  }
+}
+
+String::String(unsigned long long numero, unsigned char base)
+  : valor(formatarInteiro(numero, false, base)) {}
+
+String::String(float numero, unsigned int casas) : valor(formatarReal(numero, casas)) {}
+String::String(double numero, unsigned int casas) : valor(formatarReal(numero, casas)) {}
+
+String String::substring(unsigned int inicio) const {
+  return substring(inicio, valor.size());
+}
+
+String String::substring(unsigned int inicio, unsigned int fim) const {
+  if (inicio > fim) {
+    std::swap(inicio, fim);
+  }
+  if (inicio >= valor.size()) {
+    return String();
+  }
+  fim = std::min<unsigned int>(fim, valor.size());
+  return String(valor.substr(inicio, fim - inicio));
+}
+
+int String::indexOf(char c, unsigned int inicio) const {
+  size_t posicao = valor.find(c, inicio);
+  return posicao == std::string::npos ? -1 : (int)posicao;
+}
+
+int String::indexOf(const String& texto, unsigned int inicio) const {
+  size_t posicao = valor.find(texto.valor, inicio);
+  return posicao == std::string::npos ? -1 : (int)posicao;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t posicao = valor.rfind(c);
+  return posicao == std::string::npos ? -1 : (int)posicao;
+}
+
+bool String::startsWith(const String& prefixo) const {
+  return valor.compare(0, prefixo.valor.size(), prefixo.valor) == 0;
+}
+
+bool String::endsWith(const String& sufixo) const {
+  return valor.size() >= sufixo.valor.size() &&
+         valor.compare(valor.size() - sufixo.valor.size(), sufixo.valor.size(), sufixo.valor) == 0;
+}
+
+bool String::equalsIgnoreCase(const String& outra) const {
+  if (valor.size() != outra.valor.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < valor.size(); i++) {
+    if (tolower((unsigned char)valor[i]) != tolower((unsigned char)outra.valor[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void String::replace(const String& de, const String& para) {
+  if (de.valor.empty()) {
+    return;
+  }
+  size_t posicao = 0;
+  while ((posicao = valor.find(de.valor, posicao)) != std::string::npos) {
+    valor.replace(posicao, de.valor.size(), para.valor);
+    posicao += para.valor.size();
+  }
+}
+
+void String::remove(unsigned int indice) {
+  if (indice < valor.size()) {
+    valor.erase(indice);
+  }
+}
+
+void String::remove(unsigned int indice, unsigned int quantidade) {
+  if (indice < valor.size()) {
+    valor.erase(indice, quantidade);
+  }
+}
+
+void String::trim() {
+  size_t inicio = valor.find_first_not_of(" \t\r\n");
+  size_t fim = valor.find_last_not_of(" \t\r\n");
+  valor = (inicio == std::string::npos) ? std::string() : valor.substr(inicio, fim - inicio + 1);
+}
+
+void String::toLowerCase() {
+  for (char& c : valor) c = tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+  for (char& c : valor) c = toupper((unsigned char)c);
+}
+
+long String::toInt() const {
+  return strtol(valor.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+  return strtof(valor.c_str(), nullptr);
+}
+
+double String::toDouble() const {
+  return strtod(valor.c_str(), nullptr);
+}
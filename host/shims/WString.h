@@ -0,0 +1,98 @@
+/**
+ * @file WString.h
+ * @brief String do Arduino sobre std::string (build nativo)
+ *
+ * Implementa apenas a parte da API usada pelo firmware.
+ */
+#ifndef SHIM_WSTRING_H
+#define SHIM_WSTRING_H
+
+#include <cstdint>
+#include <string>
+
+class String {
+public:
+  String() {}
+  String(const char* texto) : valor(texto ? texto : "") {}
+  String(const std::string& texto) : valor(texto) {}
+  String(const String& outra) = default;
+  String(String&& outra) = default;
+  explicit String(char c) : valor(1, c) {}
+  explicit String(int numero, unsigned char base = 10);
+  explicit String(unsigned int numero, unsigned char base = 10);
+  explicit String(long numero, unsigned char base = 10);
+  explicit String(unsigned long numero, unsigned char base = 10);
+  explicit String(long long numero, unsigned char base = 10);
+  explicit String(unsigned long long numero, unsigned char base = 10);
+  explicit String(float numero, unsigned int casas = 2);
+  explicit String(double numero, unsigned int casas = 2);
+
+  String& operator=(const String& outra) = default;
+  String& operator=(String&& outra) = default;
+  String& operator=(const char* texto) { valor = texto ? texto : ""; return *this; }
+
+  const char* c_str() const { return valor.c_str(); }
+  unsigned int length() const { return valor.size(); }
+  bool isEmpty() const { return valor.empty(); }
+  void reserve(unsigned int tamanho) { valor.reserve(tamanho); }
+  const std::string& std() const { return valor; }
+
+  char charAt(unsigned int indice) const { return indice < valor.size() ? valor[indice] : 0; }
+  char operator[](unsigned int indice) const { return charAt(indice); }
+  char& operator[](unsigned int indice) { return valor[indice]; }
+
+  String substring(unsigned int inicio) const;
+  String substring(unsigned int inicio, unsigned int fim) const;
+  int indexOf(char c, unsigned int inicio = 0) const;
+  int indexOf(const String& texto, unsigned int inicio = 0) const;
+  int lastIndexOf(char c) const;
+  bool startsWith(const String& prefixo) const;
+  bool endsWith(const String& sufixo) const;
+  bool equals(const String& outra) const { return valor == outra.valor; }
+  bool equalsIgnoreCase(const String& outra) const;
+
+  void replace(const String& de, const String& para);
+  void remove(unsigned int indice);
+  void remove(unsigned int indice, unsigned int quantidade);
+  void trim();
+  void toLowerCase();
+  void toUpperCase();
+
+  long toInt() const;
+  float toFloat() const;
+  double toDouble() const;
+
+  String& operator+=(const String& outra) { valor += outra.valor; return *this; }
+  String& operator+=(const char* texto) { valor += texto ? texto : ""; return *this; }
+  String& operator+=(char c) { valor += c; return *this; }
+  String& operator+=(int numero) { return *this += String(numero); }
+  String& operator+=(unsigned int numero) { return *this += String(numero); }
+  String& operator+=(long numero) { return *this += String(numero); }
+  String& operator+=(unsigned long numero) { return *this += String(numero); }
+  String& operator+=(float numero) { return *this += String(numero); }
+  String& operator+=(double numero) { return *this += String(numero); }
+
+  bool concat(const String& outra) { *this += outra; return true; }
+
+  bool operator==(const String& outra) const { return valor == outra.valor; }
+  bool operator==(const char* texto) const { return valor == (texto ? texto : ""); }
+  bool operator!=(const String& outra) const { return valor != outra.valor; }
+  bool operator!=(const char* texto) const { return !(*this == texto); }
+  bool operator<(const String& outra) const { return valor < outra.valor; }
+
+private:
+  std::string valor;
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, char b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, long b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned long b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, float b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, double b) { String r(a); r += b; return r; }
+
+#endif
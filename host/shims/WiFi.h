@@ -0,0 +1,44 @@
+/**
+ * @file WiFi.h
+ * @brief WiFi do Arduino-ESP32 para o build nativo (estado em Simulacao.h)
+ */
+#ifndef SHIM_WIFI_H
+#define SHIM_WIFI_H
+
+#include <Arduino.h>
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+class WiFiClass {
+public:
+  wl_status_t status() { return simulacao::wifiConectado() ? WL_CONNECTED : WL_DISCONNECTED; }
+  bool isConnected() { return simulacao::wifiConectado(); }
+  String macAddress() { return simulacao::macAtual(); }
+  String SSID() { return "simulacao"; }
+  String localIP() { return "192.168.4.2"; }
+  int32_t RSSI() { return -50; }
+  int32_t channel() { return 1; }
+  bool mode(wifi_mode_t modo) { (void)modo; return true; }
+  bool disconnect(bool desligar = false) { (void)desligar; return true; }
+  bool reconnect() { return true; }
+  bool setSleep(bool ativo) { return setSleep(ativo ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE); }
+  bool setSleep(wifi_ps_type_t tipo) { economia = tipo; return true; }
+  wifi_ps_type_t getSleep() { return economia; }
+
+private:
+  wifi_ps_type_t economia = WIFI_PS_MIN_MODEM;
+};
+
+extern WiFiClass WiFi;
+
+#endif
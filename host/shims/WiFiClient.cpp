@@ -0,0 +1,98 @@
+#include "WiFiClient.h"
+
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+void WiFiClient::assumir(int socket, const std::string& jaLidos) {
+  if (socket != socketAtual) {
+    stop();
+  }
+  socketAtual = socket;
+  pendente = jaLidos;
+  fechado = false;
+}
+
+int WiFiClient::available() {
+  int prontos = 0;
+  if (socketAtual >= 0 && !fechado) {
+    ioctl(socketAtual, FIONREAD, &prontos);
+  }
+  return (int)pendente.size() + prontos;
+}
+
+int WiFiClient::read() {
+  uint8_t byte;
+  return read(&byte, 1) == 1 ? byte : -1;
+}
+
+int WiFiClient::read(uint8_t* dados, size_t tamanho) {
+  if (tamanho == 0) {
+    return 0;
+  }
+  if (!pendente.empty()) {
+    size_t n = std::min(tamanho, pendente.size());
+    memcpy(dados, pendente.data(), n);
+    pendente.erase(0, n);
+    return (int)n;
+  }
+  if (socketAtual < 0 || fechado) {
+    return -1;
+  }
+  ssize_t n;
+  do {
+    n = recv(socketAtual, dados, tamanho, 0);
+  } while (n < 0 && errno == EINTR);
+  if (n == 0) {
+    fechado = true;
+    return -1;
+  }
+  return n < 0 ? -1 : (int)n;
+}
+
+size_t WiFiClient::readBytes(uint8_t* dados, size_t tamanho) {
+  size_t lidos = 0;
+  while (lidos < tamanho) {
+    int n = read(dados + lidos, tamanho - lidos);
+    if (n <= 0) {
+      break;
+    }
+    lidos += n;
+  }
+  return lidos;
+}
+
+// Como no Arduino-ESP32: uma espiada sem esperar descobre se o outro lado fechou
+uint8_t WiFiClient::connected() {
+  if (socketAtual >= 0 && !fechado) {
+    char byte;
+    ssize_t n = recv(socketAtual, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      fechado = true;
+    }
+  }
+  return (socketAtual >= 0 && !fechado) || !pendente.empty();
+}
+
+void WiFiClient::stop() {
+  if (socketAtual >= 0) {
+    close(socketAtual);
+    socketAtual = -1;
+  }
+  pendente.clear();
+  fechado = true;
+}
+
+void WiFiClient::setTimeout(uint32_t ms) {
+  if (socketAtual < 0) {
+    return;
+  }
+  timeval espera;
+  espera.tv_sec = ms / 1000;
+  espera.tv_usec = (ms % 1000) * 1000;
+  setsockopt(socketAtual, SOL_SOCKET, SO_RCVTIMEO, &espera, sizeof(espera));
+}
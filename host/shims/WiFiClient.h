@@ -0,0 +1,40 @@
+/**
+ * @file WiFiClient.h
+ * @brief WiFiClient do Arduino-ESP32 sobre um socket TCP de verdade
+ *
+ * Só o lado de leitura, que o HTTPClient entrega em getStreamPtr(). Os
+ * bytes que o HTTPClient já leu junto com os cabeçalhos ficam em `pendente`.
+ */
+#ifndef SHIM_WIFICLIENT_H
+#define SHIM_WIFICLIENT_H
+
+#include <Arduino.h>
+
+#include <string>
+
+class WiFiClient {
+public:
+  WiFiClient() {}
+  ~WiFiClient() { stop(); }
+  WiFiClient(const WiFiClient&) = delete;
+  WiFiClient& operator=(const WiFiClient&) = delete;
+
+  int available();
+  int read();
+  int read(uint8_t* dados, size_t tamanho);        // Sem esperar além do timeout
+  size_t readBytes(uint8_t* dados, size_t tamanho);  // Espera até `tamanho` ou timeout
+  uint8_t connected();
+  void stop();
+  void setTimeout(uint32_t ms);
+
+  // Usados pelo HTTPClient
+  void assumir(int socket, const std::string& jaLidos);
+  int getSocket() const { return socketAtual; }
+
+private:
+  int socketAtual = -1;
+  std::string pendente;
+  bool fechado = false;  // O outro lado fechou a conexão
+};
+
+#endif
@@ -0,0 +1,21 @@
+/**
+ * @file WiFiManager.h
+ * @brief WiFiManager para o build nativo: conecta se o WiFi simulado estiver ativo
+ */
+#ifndef SHIM_WIFIMANAGER_H
+#define SHIM_WIFIMANAGER_H
+
+#include <WiFi.h>
+
+class WiFiManager {
+public:
+  void setConfigPortalTimeout(unsigned long segundos) { (void)segundos; }
+  void setConnectTimeout(unsigned long segundos) { (void)segundos; }
+  bool autoConnect(const char* nomeAP = nullptr) {
+    (void)nomeAP;
+    return simulacao::wifiConectado();
+  }
+  void resetSettings() {}
+};
+
+#endif
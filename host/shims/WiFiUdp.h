@@ -0,0 +1,16 @@
+/**
+ * @file WiFiUdp.h
+ * @brief WiFiUDP vazio: o NTPClient simulado não usa a rede
+ */
+#ifndef SHIM_WIFIUDP_H
+#define SHIM_WIFIUDP_H
+
+#include <Arduino.h>
+
+class WiFiUDP {
+public:
+  uint8_t begin(uint16_t porta) { (void)porta; return 1; }
+  void stop() {}
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "Wire.h"
+
+#include <map>
+#include <mutex>
+
+#include "PainelSSD1306.h"
+
+TwoWire Wire;
+
+namespace simulacao {
+
+namespace {
+
+// O MPU6500 simulado é lido direto de Simulacao.h; no barramento ele só
+// precisa confirmar presença
+class DispositivoMudo : public DispositivoI2C {
+public:
+  void receber(const uint8_t* dados, size_t quantidade) override {
+    (void)dados;
+    (void)quantidade;
+  }
+};
+
+std::mutex mutexBarramento;
+EstatisticasWire estatisticas = {0, 0, 100000};
+
+std::map<uint8_t, DispositivoI2C*>& dispositivos() {
+  static DispositivoMudo imu;
+  static std::map<uint8_t, DispositivoI2C*> mapa = {
+    {0x3C, &painelSSD1306()},
+    {0x68, &imu},
+  };
+  return mapa;
+}
+
+DispositivoI2C* dispositivo(uint8_t endereco) {
+  auto item = dispositivos().find(endereco);
+  return item == dispositivos().end() ? nullptr : item->second;
+}
+
+}  // namespace
+
+void registrarDispositivoI2C(uint8_t endereco, DispositivoI2C* novo) {
+  std::lock_guard<std::mutex> trava(mutexBarramento);
+  if (novo) {
+    dispositivos()[endereco] = novo;
+  } else {
+    dispositivos().erase(endereco);
+  }
+}
+
+EstatisticasWire estatisticasWire() {
+  std::lock_guard<std::mutex> trava(mutexBarramento);
+  return estatisticas;
+}
+
+void zerarEstatisticasWire() {
+  std::lock_guard<std::mutex> trava(mutexBarramento);
+  estatisticas.transacoes = 0;
+  estatisticas.bytes = 0;
+}
+
+}  // namespace simulacao
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequencia) {
+  (void)sda;
+  (void)scl;
+  if (frequencia) {
+    setClock(frequencia);
+  }
+  return true;
+}
+
+bool TwoWire::setClock(uint32_t frequencia) {
+  std::lock_guard<std::mutex> trava(simulacao::mutexBarramento);
+  simulacao::estatisticas.frequencia = frequencia;
+  return true;
+}
+
+uint32_t TwoWire::getClock() {
+  std::lock_guard<std::mutex> trava(simulacao::mutexBarramento);
+  return simulacao::estatisticas.frequencia;
+}
+
+void TwoWire::beginTransmission(uint8_t endereco) {
+  enderecoAtual = endereco;
+  transmissao.clear();
+}
+
+uint8_t TwoWire::endTransmission(bool parar) {
+  (void)parar;
+  std::lock_guard<std::mutex> trava(simulacao::mutexBarramento);
+  simulacao::estatisticas.transacoes++;
+  simulacao::estatisticas.bytes += transmissao.size() + 1;
+  simulacao::DispositivoI2C* destino = simulacao::dispositivo(enderecoAtual);
+  if (destino == nullptr) {
+    return 2;  // NACK no endereço
+  }
+  destino->receber(transmissao.data(), transmissao.size());
+  transmissao.clear();
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t endereco, uint8_t quantidade, bool parar) {
+  (void)parar;
+  std::lock_guard<std::mutex> trava(simulacao::mutexBarramento);
+  recepcao.assign(quantidade, 0);
+  posicaoRecepcao = 0;
+  simulacao::DispositivoI2C* origem = simulacao::dispositivo(endereco);
+  size_t recebidos = origem ? origem->responder(recepcao.data(), quantidade) : 0;
+  recepcao.resize(recebidos);
+  simulacao::estatisticas.transacoes++;
+  simulacao::estatisticas.bytes += recebidos + 1;
+  return recebidos;
+}
+
+size_t TwoWire::write(uint8_t c) {
+  if (transmissao.size() >= I2C_BUFFER_LENGTH) {
+    return 0;
+  }
+  transmissao.push_back(c);
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* dados, size_t quantidade) {
+  size_t escritos = 0;
+  while (escritos < quantidade && write(dados[escritos])) {
+    escritos++;
+  }
+  return escritos;
+}
+
+int TwoWire::available() {
+  return recepcao.size() - posicaoRecepcao;
+}
+
+int TwoWire::read() {
+  return posicaoRecepcao < recepcao.size() ? recepcao[posicaoRecepcao++] : -1;
+}
+
+int TwoWire::peek() {
+  return posicaoRecepcao < recepcao.size() ? recepcao[posicaoRecepcao] : -1;
+}
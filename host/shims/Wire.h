@@ -0,0 +1,71 @@
+/**
+ * @file Wire.h
+ * @brief TwoWire do Arduino-ESP32 para o build nativo
+ *
+ * As transações são entregues aos dispositivos I2C simulados registrados
+ * em cada endereço (ex.: o painel SSD1306 em PainelSSD1306.h). Endereços
+ * sem dispositivo respondem com NACK, como no barramento real.
+ */
+#ifndef SHIM_WIRE_H
+#define SHIM_WIRE_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define I2C_BUFFER_LENGTH 128
+
+namespace simulacao {
+
+class DispositivoI2C {
+public:
+  virtual ~DispositivoI2C() {}
+  virtual void receber(const uint8_t* dados, size_t quantidade) = 0;
+  virtual size_t responder(uint8_t* dados, size_t quantidade) {
+    (void)dados;
+    (void)quantidade;
+    return 0;
+  }
+};
+
+void registrarDispositivoI2C(uint8_t endereco, DispositivoI2C* dispositivo);
+
+struct EstatisticasWire {
+  uint32_t transacoes;
+  uint32_t bytes;          // Inclui o byte de endereço de cada transação
+  uint32_t frequencia;     // Último setClock()
+};
+
+EstatisticasWire estatisticasWire();
+void zerarEstatisticasWire();
+
+}  // namespace simulacao
+
+class TwoWire : public Stream {
+public:
+  bool begin() { return true; }
+  bool begin(int sda, int scl, uint32_t frequencia = 0);
+  bool end() { return true; }
+  bool setClock(uint32_t frequencia);
+  uint32_t getClock();
+
+  void beginTransmission(uint8_t endereco);
+  uint8_t endTransmission(bool parar = true);
+  uint8_t requestFrom(uint8_t endereco, uint8_t quantidade, bool parar = true);
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* dados, size_t quantidade) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+
+private:
+  uint8_t enderecoAtual = 0;
+  std::vector<uint8_t> transmissao;
+  std::vector<uint8_t> recepcao;
+  size_t posicaoRecepcao = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file arduinoFFT.h
+ * @brief ArduinoFFT (v2) para o build nativo
+ *
+ * Reprodução fiel dos trechos usados pelo firmware (janelas, FFT radix-2 com
+ * a mesma recorrência de twiddles, magnitude e pico), para que o host
+ * produza os mesmos números que o ESP32.
+ */
+#ifndef SHIM_ARDUINOFFT_H
+#define SHIM_ARDUINOFFT_H
+
+#include <cmath>
+#include <cstdint>
+
+enum class FFTDirection { Forward, Reverse };
+
+enum class FFTWindow {
+  Rectangle,
+  Hamming,
+  Hann,
+  Triangle,
+  Nuttall,
+  Blackman,
+  Blackman_Nuttall,
+  Blackman_Harris,
+  Flat_top,
+  Welch
+};
+
+template <typename T>
+class ArduinoFFT {
+public:
+  ArduinoFFT(T* vReal, T* vImag, uint_fast16_t samples, T samplingFrequency,
+             bool windowingFactors = false)
+    : _vReal(vReal), _vImag(vImag), _samples(samples), _samplingFrequency(samplingFrequency) {
+    (void)windowingFactors;
+    _power = 0;
+    while (((uint_fast16_t)1 << _power) < samples) {
+      _power++;
+    }
+  }
+
+  void dcRemoval() {
+    T media = 0;
+    for (uint_fast16_t i = 0; i < _samples; i++) media += _vReal[i];
+    media /= _samples;
+    for (uint_fast16_t i = 0; i < _samples; i++) _vReal[i] -= media;
+  }
+
+  void windowing(FFTWindow tipo, FFTDirection dir, bool withCompensation = false) {
+    (void)withCompensation;
+    T amostrasMenosUm = T(_samples) - 1;
+    for (uint_fast16_t i = 0; i < (_samples >> 1); i++) {
+      T razao = T(i) / amostrasMenosUm;
+      T peso = 1.0;
+      switch (tipo) {
+        case FFTWindow::Hamming:
+          peso = 0.54 - (0.46 * cos(2.0 * M_PI * razao));
+          break;
+        case FFTWindow::Hann:
+          peso = 0.54 * (1.0 - cos(2.0 * M_PI * razao));
+          break;
+        case FFTWindow::Blackman:
+          peso = 0.42323 - (0.49755 * cos(2.0 * M_PI * razao)) +
+                 (0.07922 * cos(4.0 * M_PI * razao));
+          break;
+        default:
+          peso = 1.0;
+          break;
+      }
+      if (dir == FFTDirection::Forward) {
+        _vReal[i] *= peso;
+        _vReal[_samples - (i + 1)] *= peso;
+      } else {
+        _vReal[i] /= peso;
+        _vReal[_samples - (i + 1)] /= peso;
+      }
+    }
+  }
+
+  void compute(FFTDirection dir) {
+    // Reordenação por bits invertidos
+    uint_fast16_t j = 0;
+    for (uint_fast16_t i = 0; i < (_samples - 1); i++) {
+      if (i < j) {
+        trocar(_vReal[i], _vReal[j]);
+        trocar(_vImag[i], _vImag[j]);
+      }
+      uint_fast16_t k = (_samples >> 1);
+      while (k <= j) {
+        j -= k;
+        k >>= 1;
+      }
+      j += k;
+    }
+
+    T c1 = -1.0;
+    T c2 = 0.0;
+    uint_fast16_t l2 = 1;
+    for (uint_fast8_t l = 0; l < _power; l++) {
+      uint_fast16_t l1 = l2;
+      l2 <<= 1;
+      T u1 = 1.0;
+      T u2 = 0.0;
+      for (j = 0; j < l1; j++) {
+        for (uint_fast16_t i = j; i < _samples; i += l2) {
+          uint_fast16_t i1 = i + l1;
+          T t1 = u1 * _vReal[i1] - u2 * _vImag[i1];
+          T t2 = u1 * _vImag[i1] + u2 * _vReal[i1];
+          _vReal[i1] = _vReal[i] - t1;
+          _vImag[i1] = _vImag[i] - t2;
+          _vReal[i] += t1;
+          _vImag[i] += t2;
+        }
+        T z = ((u1 * c1) - (u2 * c2));
+        u2 = ((u1 * c2) + (u2 * c1));
+        u1 = z;
+      }
+      c2 = sqrt((1.0 - c1) / 2.0);
+      c1 = sqrt((1.0 + c1) / 2.0);
+      if (dir == FFTDirection::Forward) {
+        c2 = -c2;
+      }
+    }
+
+    if (dir == FFTDirection::Reverse) {
+      for (uint_fast16_t i = 0; i < _samples; i++) {
+        _vReal[i] /= _samples;
+        _vImag[i] /= _samples;
+      }
+    }
+  }
+
+  void complexToMagnitude() {
+    for (uint_fast16_t i = 0; i < _samples; i++) {
+      _vReal[i] = sqrt(_vReal[i] * _vReal[i] + _vImag[i] * _vImag[i]);
+    }
+  }
+
+  T majorPeak() {
+    T maximo = 0;
+    uint_fast16_t indice = 0;
+    for (uint_fast16_t i = 1; i < ((_samples >> 1) + 1); i++) {
+      if ((_vReal[i - 1] < _vReal[i]) && (_vReal[i] > _vReal[i + 1])) {
+        if (_vReal[i] > maximo) {
+          maximo = _vReal[i];
+          indice = i;
+        }
+      }
+    }
+    if (indice == 0) {
+      return 0;
+    }
+    T delta = 0.5 * ((_vReal[indice - 1] - _vReal[indice + 1]) /
+                     (_vReal[indice - 1] - (2.0 * _vReal[indice]) + _vReal[indice + 1]));
+    T interpolado = ((indice + delta) * _samplingFrequency) / (_samples - 1);
+    if (indice == (_samples >> 1)) {
+      interpolado = ((indice + delta) * _samplingFrequency) / (_samples);
+    }
+    return interpolado;
+  }
+
+private:
+  T* _vReal;
+  T* _vImag;
+  uint_fast16_t _samples;
+  T _samplingFrequency;
+  uint_fast8_t _power;
+
+  static void trocar(T& a, T& b) {
+    T t = a;
+    a = b;
+    b = t;
+  }
+};
+
+#endif
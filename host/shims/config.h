@@ -0,0 +1,6 @@
+/**
+ * @file config.h
+ * @brief Credenciais do build nativo: os valores de exemplo bastam, pois o
+ * RTDB é simulado
+ */
+#include "../../saco/config.example.h"
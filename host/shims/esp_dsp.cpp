@@ -0,0 +1,172 @@
+#include "esp_dsp.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+std::vector<float> tabelaFc32;
+std::vector<int16_t> tabelaSc16;
+
+bool potenciaDeDois(int N) {
+  return N > 1 && (N & (N - 1)) == 0;
+}
+
+// Troca os pares (real, imaginário) nas posições de bits invertidos
+template <typename T>
+void inverterBits(T* dados, int N) {
+  int j = 0;
+  for (int i = 1; i < N - 1; i++) {
+    int k = N >> 1;
+    while (j >= k) {
+      j -= k;
+      k >>= 1;
+    }
+    j += k;
+    if (i < j) {
+      T re = dados[2 * j];
+      T im = dados[2 * j + 1];
+      dados[2 * j] = dados[2 * i];
+      dados[2 * j + 1] = dados[2 * i + 1];
+      dados[2 * i] = re;
+      dados[2 * i + 1] = im;
+    }
+  }
+}
+
+// Twiddles e^(-2πik/N), k < N/2, em ordem de bits invertidos
+std::vector<float> gerarTwiddles(int N) {
+  std::vector<float> w(N);
+  float e = M_PI * 2.0 / N;
+  for (int i = 0; i < (N >> 1); i++) {
+    w[2 * i] = cosf(i * e);
+    w[2 * i + 1] = sinf(i * e);
+  }
+  inverterBits(w.data(), N >> 1);
+  return w;
+}
+
+// (a·2^15 ∓ produto) >> 16: metade do resultado da borboleta
+inline int16_t borboleta(int16_t a, int32_t produto, bool soma) {
+  int32_t resultado = (int32_t)a << 15;
+  resultado = soma ? resultado + produto : resultado - produto;
+  return (int16_t)(resultado >> 16);
+}
+
+}  // namespace
+
+esp_err_t dsps_fft2r_init_fc32(float* tabela, int tamanho) {
+  (void)tabela;
+  if (!potenciaDeDois(tamanho) || tamanho > CONFIG_DSP_MAX_FFT_SIZE) {
+    return ESP_ERR_DSP_INVALID_LENGTH;
+  }
+  if (!tabelaFc32.empty()) {
+    return ESP_ERR_DSP_REINITIALIZED;
+  }
+  tabelaFc32 = gerarTwiddles(tamanho);
+  return ESP_OK;
+}
+
+void dsps_fft2r_deinit_fc32() {
+  tabelaFc32.clear();
+}
+
+esp_err_t dsps_fft2r_init_sc16(int16_t* tabela, int tamanho) {
+  (void)tabela;
+  if (!potenciaDeDois(tamanho) || tamanho > CONFIG_DSP_MAX_FFT_SIZE) {
+    return ESP_ERR_DSP_INVALID_LENGTH;
+  }
+  if (!tabelaSc16.empty()) {
+    return ESP_ERR_DSP_REINITIALIZED;
+  }
+  std::vector<float> w = gerarTwiddles(tamanho);
+  tabelaSc16.resize(w.size());
+  for (size_t i = 0; i < w.size(); i++) {
+    tabelaSc16[i] = (int16_t)lroundf(w[i] * INT16_MAX);
+  }
+  return ESP_OK;
+}
+
+void dsps_fft2r_deinit_sc16() {
+  tabelaSc16.clear();
+}
+
+esp_err_t dsps_fft2r_fc32(float* dados, int N) {
+  if (!potenciaDeDois(N)) {
+    return ESP_ERR_DSP_INVALID_LENGTH;
+  }
+  if ((int)tabelaFc32.size() < N) {
+    return ESP_ERR_DSP_UNINITIALIZED;
+  }
+  const float* w = tabelaFc32.data();
+  int ie = 1;
+  for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+    int ia = 0;
+    for (int j = 0; j < ie; j++) {
+      float c = w[2 * j];
+      float s = w[2 * j + 1];
+      for (int i = 0; i < N2; i++) {
+        int m = ia + N2;
+        float re = c * dados[2 * m] + s * dados[2 * m + 1];
+        float im = c * dados[2 * m + 1] - s * dados[2 * m];
+        dados[2 * m] = dados[2 * ia] - re;
+        dados[2 * m + 1] = dados[2 * ia + 1] - im;
+        dados[2 * ia] = dados[2 * ia] + re;
+        dados[2 * ia + 1] = dados[2 * ia + 1] + im;
+        ia++;
+      }
+      ia += N2;
+    }
+    ie <<= 1;
+  }
+  return ESP_OK;
+}
+
+esp_err_t dsps_bit_rev_fc32(float* dados, int N) {
+  if (!potenciaDeDois(N)) {
+    return ESP_ERR_DSP_INVALID_LENGTH;
+  }
+  inverterBits(dados, N);
+  return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_sc16(int16_t* dados, int N) {
+  if (!potenciaDeDois(N)) {
+    return ESP_ERR_DSP_INVALID_LENGTH;
+  }
+  if ((int)tabelaSc16.size() < N) {
+    return ESP_ERR_DSP_UNINITIALIZED;
+  }
+  const int16_t* w = tabelaSc16.data();
+  int ie = 1;
+  for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+    int ia = 0;
+    for (int j = 0; j < ie; j++) {
+      int32_t c = w[2 * j];
+      int32_t s = w[2 * j + 1];
+      for (int i = 0; i < N2; i++) {
+        int m = ia + N2;
+        int32_t re = c * dados[2 * m] + s * dados[2 * m + 1];
+        int32_t im = c * dados[2 * m + 1] - s * dados[2 * m];
+        int16_t aRe = dados[2 * ia];
+        int16_t aIm = dados[2 * ia + 1];
+        dados[2 * m] = borboleta(aRe, re, false);
+        dados[2 * m + 1] = borboleta(aIm, im, false);
+        dados[2 * ia] = borboleta(aRe, re, true);
+        dados[2 * ia + 1] = borboleta(aIm, im, true);
+        ia++;
+      }
+      ia += N2;
+    }
+    ie <<= 1;
+  }
+  return ESP_OK;
+}
+
+esp_err_t dsps_bit_rev_sc16_ansi(int16_t* dados, int N) {
+  if (!potenciaDeDois(N)) {
+    return ESP_ERR_DSP_INVALID_LENGTH;
+  }
+  inverterBits(dados, N);
+  return ESP_OK;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file esp_dsp.h
+ * @brief esp-dsp para o build nativo
+ *
+ * Reproduz as versões ANSI das FFTs radix-2 usadas pelo firmware: a de
+ * float complexo (fc32) e a de inteiros Q15 complexos (sc16), que divide o
+ * resultado por 2 a cada estágio (saída escalada por 1/N). Mesma ordem de
+ * twiddles da biblioteca: a saída sai em ordem de bits invertidos e
+ * dsps_bit_rev_*() a coloca na ordem natural.
+ */
+#ifndef SHIM_ESP_DSP_H
+#define SHIM_ESP_DSP_H
+
+#include <cstdint>
+
+#ifndef ESP_OK
+typedef int esp_err_t;
+#define ESP_OK 0
+#endif
+
+#define ESP_ERR_DSP_BASE 0x70000
+#define ESP_ERR_DSP_INVALID_LENGTH (ESP_ERR_DSP_BASE + 1)
+#define ESP_ERR_DSP_INVALID_PARAM (ESP_ERR_DSP_BASE + 2)
+#define ESP_ERR_DSP_PARAM_OUTOFRANGE (ESP_ERR_DSP_BASE + 3)
+#define ESP_ERR_DSP_UNINITIALIZED (ESP_ERR_DSP_BASE + 4)
+#define ESP_ERR_DSP_REINITIALIZED (ESP_ERR_DSP_BASE + 5)
+
+#define CONFIG_DSP_MAX_FFT_SIZE 4096
+
+// Tabelas de twiddles; com buffer nullptr a biblioteca aloca a própria
+esp_err_t dsps_fft2r_init_fc32(float* tabela, int tamanho);
+void dsps_fft2r_deinit_fc32();
+esp_err_t dsps_fft2r_init_sc16(int16_t* tabela, int tamanho);
+void dsps_fft2r_deinit_sc16();
+
+// dados: N pares (real, imaginário) intercalados
+esp_err_t dsps_fft2r_fc32(float* dados, int N);
+esp_err_t dsps_bit_rev_fc32(float* dados, int N);
+esp_err_t dsps_fft2r_sc16(int16_t* dados, int N);
+esp_err_t dsps_bit_rev_sc16_ansi(int16_t* dados, int N);
+
+#endif
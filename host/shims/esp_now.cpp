@@ -0,0 +1,158 @@
+/**
+ * @file esp_now.cpp
+ * @brief Meio ESP-NOW em memória entre os dispositivos simulados
+ */
+#include "esp_now.h"
+
+#include <array>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include "Simulacao.h"
+
+namespace {
+
+typedef std::array<uint8_t, ESP_NOW_ETH_ALEN> Mac;
+
+struct No {
+  esp_now_recv_cb_t recepcao = nullptr;
+  esp_now_send_cb_t envio = nullptr;
+  std::set<Mac> pares;
+};
+
+std::recursive_mutex mutexMeio;
+std::map<Mac, No> nos;
+
+Mac macDaThread() {
+  Mac mac = {};
+  unsigned int bytes[ESP_NOW_ETH_ALEN] = {};
+  String texto = simulacao::macAtual();
+  if (sscanf(texto.c_str(), "%x:%x:%x:%x:%x:%x", &bytes[0], &bytes[1], &bytes[2], &bytes[3],
+             &bytes[4], &bytes[5]) == ESP_NOW_ETH_ALEN) {
+    for (int i = 0; i < ESP_NOW_ETH_ALEN; i++) {
+      mac[i] = (uint8_t)bytes[i];
+    }
+  }
+  return mac;
+}
+
+Mac copiar(const uint8_t* mac) {
+  Mac copia;
+  for (int i = 0; i < ESP_NOW_ETH_ALEN; i++) {
+    copia[i] = mac[i];
+  }
+  return copia;
+}
+
+bool broadcast(const Mac& mac) {
+  for (uint8_t byte : mac) {
+    if (byte != 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+No* noAtual() {
+  auto item = nos.find(macDaThread());
+  return item == nos.end() ? nullptr : &item->second;
+}
+
+}  // namespace
+
+esp_err_t esp_now_init() {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  nos[macDaThread()];
+  return ESP_OK;
+}
+
+esp_err_t esp_now_deinit() {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  nos.erase(macDaThread());
+  return ESP_OK;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback) {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  No* no = noAtual();
+  if (no == nullptr) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+  no->recepcao = callback;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback) {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  No* no = noAtual();
+  if (no == nullptr) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+  no->envio = callback;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* par) {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  No* no = noAtual();
+  if (no == nullptr) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+  if (par == nullptr) {
+    return ESP_ERR_ESPNOW_ARG;
+  }
+  if (no->pares.size() >= ESP_NOW_MAX_TOTAL_PEER_NUM) {
+    return ESP_ERR_ESPNOW_FULL;
+  }
+  return no->pares.insert(copiar(par->peer_addr)).second ? ESP_OK : ESP_ERR_ESPNOW_EXIST;
+}
+
+esp_err_t esp_now_del_peer(const uint8_t* mac) {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  No* no = noAtual();
+  if (no == nullptr) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+  return no->pares.erase(copiar(mac)) ? ESP_OK : ESP_ERR_ESPNOW_NOT_FOUND;
+}
+
+bool esp_now_is_peer_exist(const uint8_t* mac) {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  No* no = noAtual();
+  return no != nullptr && no->pares.count(copiar(mac)) > 0;
+}
+
+esp_err_t esp_now_send(const uint8_t* mac, const uint8_t* dados, size_t tamanho) {
+  std::lock_guard<std::recursive_mutex> trava(mutexMeio);
+  Mac origem = macDaThread();
+  auto item = nos.find(origem);
+  if (item == nos.end()) {
+    return ESP_ERR_ESPNOW_NOT_INIT;
+  }
+  if (mac == nullptr || dados == nullptr || tamanho == 0 || tamanho > ESP_NOW_MAX_DATA_LEN) {
+    return ESP_ERR_ESPNOW_ARG;
+  }
+  Mac destino = copiar(mac);
+  if (!item->second.pares.count(destino)) {
+    return ESP_ERR_ESPNOW_NOT_FOUND;
+  }
+
+  bool entregue = false;
+  for (auto& outro : nos) {
+    if (outro.first == origem || (!broadcast(destino) && outro.first != destino)) {
+      continue;
+    }
+    if (outro.second.recepcao) {
+      simulacao::sinalizarRede();
+      outro.second.recepcao(origem.data(), dados, (int)tamanho);
+      entregue = true;
+    }
+  }
+  if (item->second.envio) {
+    // Broadcast não tem confirmação: no ESP32 também sai como sucesso
+    item->second.envio(mac, entregue || broadcast(destino) ? ESP_NOW_SEND_SUCCESS : ESP_NOW_SEND_FAIL);
+  }
+  return ESP_OK;
+}
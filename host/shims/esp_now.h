@@ -0,0 +1,61 @@
+/**
+ * @file esp_now.h
+ * @brief ESP-NOW do Arduino-ESP32 (2.x) para o build nativo
+ *
+ * Um meio em memória: cada dispositivo é a MAC da thread que chamou
+ * esp_now_init() (simulacao::macAtual()), e esp_now_send() entrega na hora
+ * aos outros, chamando o callback de recepção de cada um na thread de quem
+ * enviou, como a tarefa do WiFi faz no ESP32. Como no ESP32, o envio para
+ * uma MAC exige esp_now_add_peer() antes. Cada entrega acorda o light sleep
+ * simulado (simulacao::sinalizarRede()).
+ *
+ * Atraso e variação dos enlaces ficam para os testes do circuito, com um
+ * transporte próprio (host/testes/teste_circuito.cpp).
+ */
+#ifndef SHIM_ESP_NOW_H
+#define SHIM_ESP_NOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_sleep.h"
+
+#ifndef ESP_FAIL
+#define ESP_FAIL -1
+#endif
+#define ESP_ERR_ESPNOW_NOT_INIT 0x3065
+#define ESP_ERR_ESPNOW_ARG 0x3066
+#define ESP_ERR_ESPNOW_FULL 0x3068
+#define ESP_ERR_ESPNOW_NOT_FOUND 0x306A
+#define ESP_ERR_ESPNOW_EXIST 0x306C
+
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_KEY_LEN 16
+#define ESP_NOW_MAX_DATA_LEN 250
+#define ESP_NOW_MAX_TOTAL_PEER_NUM 20
+
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP = 1 } wifi_interface_t;
+
+typedef enum { ESP_NOW_SEND_SUCCESS = 0, ESP_NOW_SEND_FAIL } esp_now_send_status_t;
+
+typedef struct {
+  uint8_t peer_addr[ESP_NOW_ETH_ALEN];
+  uint8_t lmk[ESP_NOW_KEY_LEN];
+  uint8_t channel;
+  wifi_interface_t ifidx;
+  bool encrypt;
+  void* priv;
+} esp_now_peer_info_t;
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t* mac, const uint8_t* dados, int tamanho);
+typedef void (*esp_now_send_cb_t)(const uint8_t* mac, esp_now_send_status_t estado);
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_deinit();
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback);
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback);
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* par);
+esp_err_t esp_now_del_peer(const uint8_t* mac);
+bool esp_now_is_peer_exist(const uint8_t* mac);
+esp_err_t esp_now_send(const uint8_t* mac, const uint8_t* dados, size_t tamanho);
+
+#endif
@@ -0,0 +1,292 @@
+/**
+ * @file esp_ota.cpp
+ * @brief Partições OTA em memória e o bootloader simulado
+ */
+#include "esp_ota_ops.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "Arduino.h"
+#include "Simulacao.h"
+
+namespace {
+
+const int NUM_PARTICOES = 2;
+const uint32_t TAMANHO_PARTICAO = 0x180000;  // 1,5 MB, como na tabela min_spiffs
+
+const esp_partition_t particoes[NUM_PARTICOES] = {
+  {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, 0x10000, TAMANHO_PARTICAO, "app0", false},
+  {ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, 0x190000, TAMANHO_PARTICAO, "app1", false},
+};
+
+std::mutex mutexOta;
+std::vector<uint8_t> conteudo[NUM_PARTICOES];  // Além do tamanho, 0xFF (apagado)
+esp_ota_img_states_t estados[NUM_PARTICOES];
+int atual = 0;
+int inicializacao = 0;   // Partição que o bootloader vai subir
+esp_ota_handle_t proximoHandle = 1;
+esp_ota_handle_t handleAberto = 0;
+int particaoAberta = -1;
+std::atomic<bool> reinicio{false};
+esp_app_desc_t descricaoAtual;
+
+int indice(const esp_partition_t* particao) {
+  for (int i = 0; i < NUM_PARTICOES; i++) {
+    if (particao == &particoes[i] || (particao && particao->address == particoes[i].address)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool descricao(int i, esp_app_desc_t* saida) {
+  const std::vector<uint8_t>& imagem = conteudo[i];
+  if (imagem.size() < ESP_APP_DESC_OFFSET + sizeof(esp_app_desc_t) ||
+      imagem[0] != ESP_IMAGE_HEADER_MAGIC) {
+    return false;
+  }
+  memcpy(saida, &imagem[ESP_APP_DESC_OFFSET], sizeof(esp_app_desc_t));
+  return saida->magic_word == ESP_APP_DESC_MAGIC_WORD;
+}
+
+// O bootloader só sobe uma imagem com cabeçalho e que não foi descartada
+bool inicializavel(int i) {
+  return !conteudo[i].empty() && conteudo[i][0] == ESP_IMAGE_HEADER_MAGIC &&
+         estados[i] != ESP_OTA_IMG_INVALID && estados[i] != ESP_OTA_IMG_ABORTED;
+}
+
+}  // namespace
+
+namespace simulacao {
+
+void reiniciarParticoesOta() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  for (int i = 0; i < NUM_PARTICOES; i++) {
+    conteudo[i].clear();
+    estados[i] = ESP_OTA_IMG_UNDEFINED;
+  }
+  atual = 0;
+  inicializacao = 0;
+  handleAberto = 0;
+  particaoAberta = -1;
+  reinicio = false;
+}
+
+void gravarFirmwareOta(const uint8_t* imagem, size_t tamanho) {
+  // Como pela serial: sem registro na otadata, a imagem fica "indefinida"
+  std::lock_guard<std::mutex> trava(mutexOta);
+  conteudo[0].assign(imagem, imagem + tamanho);
+  conteudo[1].clear();
+  estados[0] = estados[1] = ESP_OTA_IMG_UNDEFINED;
+  atual = inicializacao = 0;
+}
+
+size_t lerParticaoOta(int i, uint8_t* dados, size_t tamanho) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  size_t n = std::min(tamanho, conteudo[i].size());
+  memcpy(dados, conteudo[i].data(), n);
+  return n;
+}
+
+int particaoOtaAtual() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  return atual;
+}
+
+int estadoParticaoOta(int i) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  return (int)estados[i];
+}
+
+void pedirReinicio() {
+  reinicio = true;
+}
+
+bool reinicioPedido() {
+  return reinicio;
+}
+
+int reiniciarOta() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  reinicio = false;
+  handleAberto = 0;
+  particaoAberta = -1;
+  int escolhida = inicializacao;
+  if (estados[escolhida] == ESP_OTA_IMG_PENDING_VERIFY) {
+    // Subiu uma vez e não foi confirmada: rollback
+    estados[escolhida] = ESP_OTA_IMG_ABORTED;
+  } else if (estados[escolhida] == ESP_OTA_IMG_NEW) {
+    estados[escolhida] = ESP_OTA_IMG_PENDING_VERIFY;
+  }
+  if (!inicializavel(escolhida)) {
+    escolhida = 1 - escolhida;
+  }
+  atual = inicializacao = escolhida;
+  return escolhida;
+}
+
+}  // namespace simulacao
+
+esp_err_t esp_partition_read(const esp_partition_t* particao, size_t deslocamento, void* dados,
+                             size_t tamanho) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  int i = indice(particao);
+  if (i < 0 || dados == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (deslocamento + tamanho > particoes[i].size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  uint8_t* saida = (uint8_t*)dados;
+  for (size_t k = 0; k < tamanho; k++) {
+    size_t posicao = deslocamento + k;
+    saida[k] = posicao < conteudo[i].size() ? conteudo[i][posicao] : 0xFF;
+  }
+  return ESP_OK;
+}
+
+const esp_partition_t* esp_ota_get_running_partition() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  return &particoes[atual];
+}
+
+const esp_partition_t* esp_ota_get_boot_partition() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  return &particoes[inicializacao];
+}
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* inicio) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  int i = inicio ? indice(inicio) : atual;
+  return i < 0 ? nullptr : &particoes[1 - i];
+}
+
+esp_err_t esp_ota_begin(const esp_partition_t* particao, size_t tamanho, esp_ota_handle_t* handle) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  int i = indice(particao);
+  if (i < 0 || handle == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (i == atual) {
+    return ESP_ERR_OTA_PARTITION_CONFLICT;
+  }
+  if (tamanho != OTA_SIZE_UNKNOWN && tamanho != OTA_WITH_SEQUENTIAL_WRITES &&
+      tamanho > particoes[i].size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  // Apaga a partição; a imagem antiga deixa de valer
+  conteudo[i].clear();
+  estados[i] = ESP_OTA_IMG_UNDEFINED;
+  handleAberto = proximoHandle++;
+  particaoAberta = i;
+  *handle = handleAberto;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* dados, size_t tamanho) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  if (handle == 0 || handle != handleAberto || dados == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  std::vector<uint8_t>& imagem = conteudo[particaoAberta];
+  if (imagem.size() + tamanho > particoes[particaoAberta].size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  const uint8_t* bytes = (const uint8_t*)dados;
+  if (imagem.empty() && tamanho > 0 && bytes[0] != ESP_IMAGE_HEADER_MAGIC) {
+    return ESP_ERR_OTA_VALIDATE_FAILED;
+  }
+  imagem.insert(imagem.end(), bytes, bytes + tamanho);
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_end(esp_ota_handle_t handle) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  if (handle == 0 || handle != handleAberto) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  handleAberto = 0;
+  const std::vector<uint8_t>& imagem = conteudo[particaoAberta];
+  if (imagem.empty() || imagem[0] != ESP_IMAGE_HEADER_MAGIC) {
+    return ESP_ERR_OTA_VALIDATE_FAILED;
+  }
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_abort(esp_ota_handle_t handle) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  if (handle == 0 || handle != handleAberto) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  handleAberto = 0;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* particao) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  int i = indice(particao);
+  if (i < 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (conteudo[i].empty() || conteudo[i][0] != ESP_IMAGE_HEADER_MAGIC) {
+    return ESP_ERR_OTA_VALIDATE_FAILED;
+  }
+  if (i != atual) {
+    estados[i] = ESP_OTA_IMG_NEW;
+  }
+  inicializacao = i;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* particao, esp_ota_img_states_t* estado) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  int i = indice(particao);
+  if (i < 0 || estado == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (estados[i] == ESP_OTA_IMG_UNDEFINED) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  *estado = estados[i];
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_valid_cancel_rollback() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  estados[atual] = ESP_OTA_IMG_VALID;
+  return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() {
+  {
+    std::lock_guard<std::mutex> trava(mutexOta);
+    int anterior = 1 - atual;
+    if (!inicializavel(anterior)) {
+      return ESP_ERR_OTA_ROLLBACK_FAILED;
+    }
+    estados[atual] = ESP_OTA_IMG_INVALID;
+    inicializacao = anterior;
+  }
+  ESP.restart();
+  return ESP_FAIL;
+}
+
+const esp_app_desc_t* esp_ota_get_app_description() {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  if (!descricao(atual, &descricaoAtual)) {
+    memset(&descricaoAtual, 0, sizeof(descricaoAtual));
+  }
+  return &descricaoAtual;
+}
+
+esp_err_t esp_ota_get_partition_description(const esp_partition_t* particao, esp_app_desc_t* saida) {
+  std::lock_guard<std::mutex> trava(mutexOta);
+  int i = indice(particao);
+  if (i < 0 || saida == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return descricao(i, saida) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file esp_ota_ops.h
+ * @brief Partições OTA do ESP-IDF (4.4, o do Arduino-ESP32 2.x) para o build nativo
+ *
+ * Duas partições de app em memória, ota_0 e ota_1, com o estado de cada
+ * imagem como o bootloader com CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE guarda
+ * na otadata. O esp_ota_end() confere o byte mágico da imagem do ESP32
+ * (0xE9), e a descrição do app (versão) sai do esp_app_desc_t no mesmo
+ * lugar da imagem real, logo depois dos cabeçalhos. O que o bootloader faz
+ * num reinício fica em simulacao::reiniciarOta() (Simulacao.h).
+ */
+#ifndef SHIM_ESP_OTA_OPS_H
+#define SHIM_ESP_OTA_OPS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_partition.h"
+
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_OTA_BASE 0x1500
+#define ESP_ERR_OTA_PARTITION_CONFLICT (ESP_ERR_OTA_BASE + 0x01)
+#define ESP_ERR_OTA_SELECT_INFO_INVALID (ESP_ERR_OTA_BASE + 0x02)
+#define ESP_ERR_OTA_VALIDATE_FAILED (ESP_ERR_OTA_BASE + 0x03)
+#define ESP_ERR_OTA_ROLLBACK_FAILED (ESP_ERR_OTA_BASE + 0x05)
+
+#define OTA_SIZE_UNKNOWN 0xffffffff
+#define OTA_WITH_SEQUENTIAL_WRITES 0xfffffffe
+
+#define ESP_IMAGE_HEADER_MAGIC 0xE9
+#define ESP_APP_DESC_MAGIC_WORD 0xABCD5432
+// esp_image_header_t (24 bytes) + esp_image_segment_header_t (8 bytes)
+#define ESP_APP_DESC_OFFSET 32
+
+typedef uint32_t esp_ota_handle_t;
+
+typedef enum {
+  ESP_OTA_IMG_NEW = 0x0U,
+  ESP_OTA_IMG_PENDING_VERIFY = 0x1U,
+  ESP_OTA_IMG_VALID = 0x2U,
+  ESP_OTA_IMG_INVALID = 0x3U,
+  ESP_OTA_IMG_ABORTED = 0x4U,
+  ESP_OTA_IMG_UNDEFINED = 0xFFFFFFFFU
+} esp_ota_img_states_t;
+
+typedef struct {
+  uint32_t magic_word;
+  uint32_t secure_version;
+  uint32_t reserv1[2];
+  char version[32];
+  char project_name[32];
+  char time[16];
+  char date[16];
+  char idf_ver[32];
+  uint8_t app_elf_sha256[32];
+  uint32_t reserv2[20];
+} esp_app_desc_t;
+
+const esp_partition_t* esp_ota_get_running_partition();
+const esp_partition_t* esp_ota_get_boot_partition();
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* inicio);
+
+esp_err_t esp_ota_begin(const esp_partition_t* particao, size_t tamanho, esp_ota_handle_t* handle);
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* dados, size_t tamanho);
+esp_err_t esp_ota_end(esp_ota_handle_t handle);
+esp_err_t esp_ota_abort(esp_ota_handle_t handle);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* particao);
+
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* particao, esp_ota_img_states_t* estado);
+esp_err_t esp_ota_mark_app_valid_cancel_rollback();
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot();
+
+const esp_app_desc_t* esp_ota_get_app_description();
+esp_err_t esp_ota_get_partition_description(const esp_partition_t* particao, esp_app_desc_t* descricao);
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file esp_partition.h
+ * @brief Partições do ESP-IDF para o build nativo (só as de app, ver esp_ota_ops.h)
+ */
+#ifndef SHIM_ESP_PARTITION_H
+#define SHIM_ESP_PARTITION_H
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_sleep.h"
+
+#ifndef ESP_FAIL
+#define ESP_FAIL -1
+#endif
+
+typedef enum { ESP_PARTITION_TYPE_APP = 0x00, ESP_PARTITION_TYPE_DATA = 0x01 } esp_partition_type_t;
+
+typedef enum {
+  ESP_PARTITION_SUBTYPE_APP_FACTORY = 0x00,
+  ESP_PARTITION_SUBTYPE_APP_OTA_0 = 0x10,
+  ESP_PARTITION_SUBTYPE_APP_OTA_1 = 0x11
+} esp_partition_subtype_t;
+
+typedef struct {
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+  bool encrypted;
+} esp_partition_t;
+
+esp_err_t esp_partition_read(const esp_partition_t* particao, size_t deslocamento, void* dados,
+                             size_t tamanho);
+
+#endif
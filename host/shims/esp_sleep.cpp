@@ -0,0 +1,116 @@
+#include "esp_sleep.h"
+
+#include <atomic>
+#include <cmath>
+
+#include "Arduino.h"
+
+namespace {
+
+const uint8_t SEM_PAD = 0xFF;
+
+std::atomic<uint64_t> temporizadorUs{0};
+std::atomic<bool> temporizadorAtivo{false};
+std::atomic<uint8_t> padDespertar{SEM_PAD};
+std::atomic<uint32_t> limiarPad{0};
+std::atomic<uint32_t> pinosGPIO{0};  // Bit n: GPIO n habilitado para acordar
+std::atomic<bool> gpioAtivo{false};
+std::atomic<bool> wifiAtivo{false};
+std::atomic<int> ultimaCausa{ESP_SLEEP_WAKEUP_UNDEFINED};
+
+// Wake-on-motion: compara cada eixo com a amostra do início do sono
+bool houveMovimento(const simulacao::AmostraIMU& referencia) {
+  if (!simulacao::despertarMovimentoAtivo()) {
+    return false;
+  }
+  simulacao::AmostraIMU agora = simulacao::lerIMU();
+  float limiar = simulacao::limiarDespertarMovimento();
+  return std::fabs(agora.ax - referencia.ax) > limiar ||
+         std::fabs(agora.ay - referencia.ay) > limiar ||
+         std::fabs(agora.az - referencia.az) > limiar;
+}
+
+}  // namespace
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t tempoUs) {
+  temporizadorUs = tempoUs;
+  temporizadorAtivo = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup() {
+  gpioAtivo = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_wifi_wakeup() {
+  wifiAtivo = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t fonte) {
+  bool todas = (fonte == ESP_SLEEP_WAKEUP_ALL);
+  if (todas || fonte == ESP_SLEEP_WAKEUP_TIMER) temporizadorAtivo = false;
+  if (todas || fonte == ESP_SLEEP_WAKEUP_TOUCHPAD) padDespertar = SEM_PAD;
+  if (todas || fonte == ESP_SLEEP_WAKEUP_GPIO) gpioAtivo = false;
+  if (todas || fonte == ESP_SLEEP_WAKEUP_WIFI) wifiAtivo = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_light_sleep_start() {
+  if (!temporizadorAtivo && padDespertar == SEM_PAD && !(gpioAtivo && pinosGPIO) && !wifiAtivo) {
+    return ESP_ERR_INVALID_ARG;  // Nenhuma fonte: o ESP32 não dormiria
+  }
+  uint64_t inicio = simulacao::agoraUs();
+  simulacao::AmostraIMU referencia = simulacao::lerIMU();
+  uint32_t sinaisInicio = simulacao::sinaisRede();
+
+  while (true) {
+    esp_sleep_wakeup_cause_t causa = ESP_SLEEP_WAKEUP_UNDEFINED;
+    uint8_t pad = padDespertar;
+    if (pad != SEM_PAD && simulacao::lerToque(pad) > limiarPad) {
+      causa = ESP_SLEEP_WAKEUP_TOUCHPAD;
+    } else if (gpioAtivo && pinosGPIO && houveMovimento(referencia)) {
+      causa = ESP_SLEEP_WAKEUP_GPIO;
+    } else if (wifiAtivo && simulacao::sinaisRede() != sinaisInicio) {
+      causa = ESP_SLEEP_WAKEUP_WIFI;
+    } else if (temporizadorAtivo && simulacao::agoraUs() - inicio >= temporizadorUs) {
+      causa = ESP_SLEEP_WAKEUP_TIMER;
+    }
+    if (causa != ESP_SLEEP_WAKEUP_UNDEFINED) {
+      ultimaCausa = causa;
+      return ESP_OK;
+    }
+    simulacao::esperarUs(1000);
+  }
+}
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+  return (esp_sleep_wakeup_cause_t)ultimaCausa.load();
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t pino, gpio_int_type_t tipo) {
+  if (pino < 0 || pino >= 32 ||
+      (tipo != GPIO_INTR_LOW_LEVEL && tipo != GPIO_INTR_HIGH_LEVEL)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pinosGPIO |= (1u << pino);
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t pino) {
+  if (pino < 0 || pino >= 32) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pinosGPIO &= ~(1u << pino);
+  return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+  return (int64_t)simulacao::agoraUs();
+}
+
+void touchSleepWakeUpEnable(uint8_t pino, uint32_t limiar) {
+  limiarPad = limiar;
+  padDespertar = pino;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file esp_sleep.h
+ * @brief Light sleep do ESP-IDF para o build nativo
+ *
+ * esp_light_sleep_start() avança o relógio em passos de 1 ms até uma fonte
+ * habilitada disparar:
+ *
+ * - Temporizador: passou o tempo de esp_sleep_enable_timer_wakeup()
+ * - Toque: o pad de touchSleepWakeUpEnable() passou do limiar
+ * - GPIO: um pino de gpio_wakeup_enable() é tratado como o INT do MPU6500,
+ *   que sobe quando o wake-on-motion do shim (simulacao) detecta movimento
+ * - WiFi: chegou um pacote para o dispositivo (simulacao::sinalizarRede())
+ *
+ * Com o relógio real as outras threads continuam rodando durante o sono
+ * (no ESP32 elas param); a lógica de despertar é a mesma.
+ */
+#ifndef SHIM_ESP_SLEEP_H
+#define SHIM_ESP_SLEEP_H
+
+#include <cstdint>
+
+#ifndef ESP_OK
+typedef int esp_err_t;
+#define ESP_OK 0
+#endif
+#define ESP_ERR_INVALID_ARG 0x102
+
+typedef enum {
+  ESP_SLEEP_WAKEUP_UNDEFINED,
+  ESP_SLEEP_WAKEUP_ALL,
+  ESP_SLEEP_WAKEUP_EXT0,
+  ESP_SLEEP_WAKEUP_EXT1,
+  ESP_SLEEP_WAKEUP_TIMER,
+  ESP_SLEEP_WAKEUP_TOUCHPAD,
+  ESP_SLEEP_WAKEUP_ULP,
+  ESP_SLEEP_WAKEUP_GPIO,
+  ESP_SLEEP_WAKEUP_UART,
+  ESP_SLEEP_WAKEUP_WIFI
+} esp_sleep_source_t;
+
+typedef esp_sleep_source_t esp_sleep_wakeup_cause_t;
+
+typedef int gpio_num_t;
+
+typedef enum {
+  GPIO_INTR_DISABLE,
+  GPIO_INTR_POSEDGE,
+  GPIO_INTR_NEGEDGE,
+  GPIO_INTR_ANYEDGE,
+  GPIO_INTR_LOW_LEVEL,
+  GPIO_INTR_HIGH_LEVEL
+} gpio_int_type_t;
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t tempoUs);
+esp_err_t esp_sleep_enable_gpio_wakeup();
+esp_err_t esp_sleep_enable_wifi_wakeup();
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t fonte);
+esp_err_t esp_light_sleep_start();
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+
+// No ESP32 vêm do driver/gpio.h e do esp_timer.h (incluídos pelo Arduino.h)
+esp_err_t gpio_wakeup_enable(gpio_num_t pino, gpio_int_type_t tipo);
+esp_err_t gpio_wakeup_disable(gpio_num_t pino);
+int64_t esp_timer_get_time();
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SHIM_FREERTOS_EVENT_GROUPS_H
+#define SHIM_FREERTOS_EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+struct GrupoEventosSimulado;
+typedef GrupoEventosSimulado* EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate();
+EventBits_t xEventGroupSetBits(EventGroupHandle_t grupo, EventBits_t bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t grupo, EventBits_t bits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t grupo);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t grupo, EventBits_t bits, BaseType_t limpar,
+                                BaseType_t todos, TickType_t espera);
+void vEventGroupDelete(EventGroupHandle_t grupo);
+
+#endif
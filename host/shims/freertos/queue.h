@@ -0,0 +1,22 @@
+#ifndef SHIM_FREERTOS_QUEUE_H
+#define SHIM_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+struct FilaSimulada;
+typedef FilaSimulada* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t tamanho, UBaseType_t tamanhoItem);
+BaseType_t xQueueSend(QueueHandle_t fila, const void* item, TickType_t espera);
+BaseType_t xQueueSendToBack(QueueHandle_t fila, const void* item, TickType_t espera);
+BaseType_t xQueueSendToFront(QueueHandle_t fila, const void* item, TickType_t espera);
+BaseType_t xQueueSendFromISR(QueueHandle_t fila, const void* item, BaseType_t* acordouTarefa);
+BaseType_t xQueueOverwrite(QueueHandle_t fila, const void* item);
+BaseType_t xQueueReceive(QueueHandle_t fila, void* item, TickType_t espera);
+BaseType_t xQueuePeek(QueueHandle_t fila, void* item, TickType_t espera);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t fila);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t fila);
+BaseType_t xQueueReset(QueueHandle_t fila);
+void vQueueDelete(QueueHandle_t fila);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SHIM_FREERTOS_SEMPHR_H
+#define SHIM_FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+struct SemaforoSimulado;
+typedef SemaforoSimulado* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maximo, UBaseType_t inicial);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaforo, TickType_t espera);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaforo);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaforo, BaseType_t* acordouTarefa);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaforo);
+void vSemaphoreDelete(SemaphoreHandle_t semaforo);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SHIM_FREERTOS_TASK_H
+#define SHIM_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+struct TarefaSimulada;
+typedef TarefaSimulada* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreate(TaskFunction_t funcao, const char* nome, uint32_t pilha,
+                       void* parametro, UBaseType_t prioridade, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t funcao, const char* nome, uint32_t pilha,
+                                   void* parametro, UBaseType_t prioridade,
+                                   TaskHandle_t* handle, BaseType_t nucleo);
+void vTaskDelete(TaskHandle_t handle);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* ultimoDespertar, TickType_t periodo);
+BaseType_t xTaskDelayUntil(TickType_t* ultimoDespertar, TickType_t periodo);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+const char* pcTaskGetName(TaskHandle_t handle);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t handle);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t handle);
+void taskYIELD();
+
+#endif
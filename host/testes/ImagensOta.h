@@ -0,0 +1,104 @@
+/**
+ * @file ImagensOta.h
+ * @brief Imagens de firmware sintéticas para os testes de OTA
+ *
+ * Parecidas o bastante com um .bin do ESP32 para o delta e os shims: byte
+ * mágico 0xE9, esp_app_desc_t com a versão no deslocamento de sempre e um
+ * "código" feito de blocos de um repertório fixo, que comprime como código
+ * de verdade. A versão seguinte insere funções novas e muda
+ * endereços espalhados, deslocando todo o resto.
+ */
+#ifndef IMAGENS_OTA_H
+#define IMAGENS_OTA_H
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "esp_ota_ops.h"
+
+namespace imagens_ota {
+
+// Trecho de "código": blocos básicos (3 a 6 instruções de 2 a 4 bytes)
+// de um repertório fixo, como as sequências que o compilador repete, com
+// instruções soltas e imediatos aleatórios entre eles
+inline std::vector<uint8_t> codigo(std::mt19937& sorteio, size_t tamanho) {
+  std::mt19937 fixo(99);
+  std::vector<std::vector<uint8_t>> instrucoes(64);
+  for (auto& instrucao : instrucoes) {
+    instrucao.resize(2 + fixo() % 3);
+    for (uint8_t& byte : instrucao) byte = (uint8_t)fixo();
+  }
+  std::vector<std::vector<uint8_t>> blocos(128);
+  for (auto& bloco : blocos) {
+    for (int i = 3 + fixo() % 4; i > 0; i--) {
+      const auto& instrucao = instrucoes[fixo() % instrucoes.size()];
+      bloco.insert(bloco.end(), instrucao.begin(), instrucao.end());
+    }
+  }
+  std::vector<uint8_t> saida;
+  while (saida.size() < tamanho) {
+    uint32_t escolha = sorteio() % 10;
+    if (escolha == 0) {
+      saida.push_back((uint8_t)sorteio());
+    } else if (escolha == 1) {
+      const auto& instrucao = instrucoes[sorteio() % instrucoes.size()];
+      saida.insert(saida.end(), instrucao.begin(), instrucao.end());
+    } else {
+      const auto& bloco = blocos[sorteio() % blocos.size()];
+      saida.insert(saida.end(), bloco.begin(), bloco.end());
+    }
+  }
+  saida.resize(tamanho);
+  return saida;
+}
+
+inline void definirVersao(std::vector<uint8_t>& imagem, const std::string& versao) {
+  esp_app_desc_t descricao;
+  memcpy(&descricao, &imagem[ESP_APP_DESC_OFFSET], sizeof(descricao));
+  memset(descricao.version, 0, sizeof(descricao.version));
+  strncpy(descricao.version, versao.c_str(), sizeof(descricao.version) - 1);
+  memcpy(&imagem[ESP_APP_DESC_OFFSET], &descricao, sizeof(descricao));
+}
+
+inline std::vector<uint8_t> imagemFirmware(const std::string& versao, uint32_t semente = 1,
+                                           size_t tamanho = 128 * 1024) {
+  std::mt19937 sorteio(semente);
+  std::vector<uint8_t> imagem(ESP_APP_DESC_OFFSET + sizeof(esp_app_desc_t), 0);
+  imagem[0] = ESP_IMAGE_HEADER_MAGIC;
+  esp_app_desc_t descricao;
+  memset(&descricao, 0, sizeof(descricao));
+  descricao.magic_word = ESP_APP_DESC_MAGIC_WORD;
+  strcpy(descricao.project_name, "saco");
+  memcpy(&imagem[ESP_APP_DESC_OFFSET], &descricao, sizeof(descricao));
+  definirVersao(imagem, versao);
+  std::vector<uint8_t> resto = codigo(sorteio, tamanho - imagem.size());
+  imagem.insert(imagem.end(), resto.begin(), resto.end());
+  return imagem;
+}
+
+// Três funções novas (a 20%, 50% e 80% da imagem) e `enderecos` palavras de
+// 4 bytes trocadas (chamadas e constantes que mudaram de lugar)
+inline std::vector<uint8_t> versaoSeguinte(const std::vector<uint8_t>& base,
+                                           const std::string& versao, uint32_t semente = 2,
+                                           int enderecos = 64) {
+  std::mt19937 sorteio(semente);
+  std::vector<uint8_t> nova = base;
+  definirVersao(nova, versao);
+  for (double fracao : {0.8, 0.5, 0.2}) {
+    std::vector<uint8_t> funcao = codigo(sorteio, 512);
+    nova.insert(nova.begin() + (size_t)(nova.size() * fracao), funcao.begin(), funcao.end());
+  }
+  size_t inicio = ESP_APP_DESC_OFFSET + sizeof(esp_app_desc_t);
+  for (int i = 0; i < enderecos; i++) {
+    size_t posicao = inicio + sorteio() % (nova.size() - inicio - 4);
+    uint32_t endereco = 0x42000000u + (sorteio() & 0xFFFFF);
+    memcpy(&nova[posicao], &endereco, 4);
+  }
+  return nova;
+}
+
+}  // namespace imagens_ota
+
+#endif
@@ -0,0 +1,229 @@
+/**
+ * @file ModosTeste.h
+ * @brief Fixture dos testes com as tarefas do saco.ino rodando de verdade
+ *
+ * setup() sobe as tarefas em threads, contra os sensores, o RTDB e o WiFi
+ * simulados. Cenario (teste_cenarios.cpp) encadeia ações do app e condições
+ * esperadas. As threads do host não têm as prioridades nem a preempção do
+ * FreeRTOS: os testes verificam ordem e corridas (com o TSan), e os limites
+ * de tempo só impedem um teste de travar.
+ */
+#ifndef MODOS_TESTE_H
+#define MODOS_TESTE_H
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Conexao.h"
+#include "Modos.h"
+#include "RTDB.h"
+#include "Rastreio.h"
+#include "ServicoDisplay.h"
+#include "Simulacao.h"
+
+void setup();
+
+// Tarefas reais (threads) com o relógio 20x mais rápido que o tempo real
+const double ESCALA = 20.0;
+
+class ModosTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    simulacao::definirRelogio(simulacao::ModoRelogio::Real, ESCALA);
+    simulacao::definirGanchosTarefa(rastreioTarefaEntrou, rastreioTarefaSaiu);
+    rastreio.limpar();
+    antesDoSetup();
+    setup();
+    // O registro no Firebase vem depois, na tarefa de comunicação
+    if (simulacao::wifiConectado()) {
+      ASSERT_TRUE(boot.aguardar(BOOT_FIREBASE, 5000));
+    }
+  }
+
+  virtual void antesDoSetup() {}
+
+  void TearDown() override {
+    // Com as tarefas ainda vivas: o anel aponta para os nomes delas
+    const char* arquivo = getenv("SACO_RASTREIO");
+    if (arquivo) {
+      ArquivoTexto saida(arquivo);
+      rastreio.exportarChrome(saida);
+    }
+    simulacao::encerrarTarefas();
+  }
+
+  // Exportação do rastreio num texto
+  class Texto : public Print {
+  public:
+    std::string conteudo;
+    size_t write(uint8_t c) override {
+      conteudo.push_back((char)c);
+      return 1;
+    }
+  };
+
+  class ArquivoTexto : public Print {
+  public:
+    explicit ArquivoTexto(const char* caminho) : arquivo(fopen(caminho, "w")) {}
+    ~ArquivoTexto() {
+      if (arquivo) {
+        fclose(arquivo);
+      }
+    }
+    size_t write(uint8_t c) override {
+      return arquivo && fputc(c, arquivo) != EOF ? 1 : 0;
+    }
+
+  private:
+    FILE* arquivo;
+  };
+
+  std::string caminho(const std::string& sufixo) {
+    return std::string("/devices/") + conexao.deviceId.c_str() + sufixo;
+  }
+
+  void gravar(const std::string& sufixo, const std::string& json) {
+    simulacao::Json valor;
+    ASSERT_TRUE(simulacao::Json::interpretar(json, valor));
+    std::string erro;
+    ASSERT_TRUE(simulacao::rtdbMemoria().gravar(caminho(sufixo), valor, erro));
+  }
+
+  void remover(const std::string& sufixo) {
+    std::string erro;
+    ASSERT_TRUE(simulacao::rtdbMemoria().remover(caminho(sufixo), erro)) << erro;
+  }
+
+  // O nó agora (nulo se não existir)
+  simulacao::Json ler(const std::string& sufixo) {
+    simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+    const simulacao::Json* valor = raiz.buscar(caminho(sufixo));
+    return valor ? *valor : simulacao::Json();
+  }
+
+  // Aguarda (em tempo de firmware) até o nó ter o texto esperado
+  bool aguardarTexto(const std::string& sufixo, const std::string& esperado,
+                     uint32_t limiteMs) {
+    unsigned long inicio = millis();
+    while (millis() - inicio < limiteMs) {
+      simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+      const simulacao::Json* valor = raiz.buscar(caminho(sufixo));
+      if (valor && valor->comoTexto() == esperado) {
+        return true;
+      }
+      delay(50);
+    }
+    return false;
+  }
+
+  Estado estado() {
+    xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+    Estado atual = estadoAtual;
+    xSemaphoreGive(xEstadoMutex);
+    return atual;
+  }
+
+  // O ESP.restart(): tarefas paradas, o bootloader escolhe a partição e o
+  // setup() roda de novo, com o RTDB de antes
+  int religar(bool wifi) {
+    simulacao::encerrarTarefas();
+    estadoAtual = Estado::Inicial;
+    simulacao::definirWiFiConectado(wifi);
+    int particao = simulacao::reiniciarOta();
+    setup();
+    return particao;
+  }
+
+  // Aguarda mais um estímulo (ServicoDisplay.h) chegar ao painel: o "Ataque"
+  // ou a seta que o usuário vê, depois de `anteriores`
+  bool aguardarEstimulo(uint32_t anteriores, uint32_t limiteMs) {
+    unsigned long inicio = millis();
+    while (servicoDisplay.getEstimulos() <= anteriores && millis() - inicio < limiteMs) {
+      delay(1);
+    }
+    return servicoDisplay.getEstimulos() > anteriores;
+  }
+
+  bool aguardarEstado(Estado esperado, uint32_t limiteMs) {
+    unsigned long inicio = millis();
+    while (estado() != esperado && millis() - inicio < limiteMs) {
+      delay(10);
+    }
+    return estado() == esperado;
+  }
+};
+
+// Roteiro de um cenário: ações do app e condições esperadas, em ordem
+class Cenario {
+public:
+  typedef std::function<void()> Acao;
+  typedef std::function<bool()> Condicao;
+
+  Cenario& fazer(const std::string& nome, Acao acao) {
+    passos.push_back({nome, Tipo::Fazer, acao, nullptr, 0});
+    return *this;
+  }
+
+  // Até limiteMs esperando a condição valer; o limite só evita travar
+  Cenario& esperar(const std::string& nome, Condicao condicao, uint32_t limiteMs) {
+    passos.push_back({nome, Tipo::Esperar, nullptr, condicao, limiteMs});
+    return *this;
+  }
+
+  // A condição vale o tempo todo por duracaoMs
+  Cenario& manter(const std::string& nome, Condicao condicao, uint32_t duracaoMs) {
+    passos.push_back({nome, Tipo::Manter, nullptr, condicao, duracaoMs});
+    return *this;
+  }
+
+  // Para no primeiro passo que falhar
+  ::testing::AssertionResult executar() {
+    for (Passo& passo : passos) {
+      unsigned long inicio = millis();
+      switch (passo.tipo) {
+        case Tipo::Fazer:
+          passo.acao();
+          break;
+        case Tipo::Esperar:
+          while (!passo.condicao()) {
+            if (millis() - inicio >= passo.limiteMs) {
+              return ::testing::AssertionFailure()
+                     << "\"" << passo.nome << "\" não aconteceu em " << passo.limiteMs << " ms";
+            }
+            delay(10);
+          }
+          break;
+        case Tipo::Manter:
+          while (millis() - inicio < passo.limiteMs) {
+            if (!passo.condicao()) {
+              return ::testing::AssertionFailure() << "\"" << passo.nome << "\" deixou de valer em "
+                                                   << (millis() - inicio) << " ms";
+            }
+            delay(10);
+          }
+          break;
+      }
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+private:
+  enum class Tipo { Fazer, Esperar, Manter };
+  struct Passo {
+    std::string nome;
+    Tipo tipo;
+    Acao acao;
+    Condicao condicao;
+    uint32_t limiteMs;
+  };
+  std::vector<Passo> passos;
+};
+
+#endif
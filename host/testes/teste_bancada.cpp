@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <sstream>
+
+#include "Bancada.h"
+#include "display.h"
+
+namespace {
+
+class BancadaTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+  }
+};
+
+// Destino em memória para o relatório
+class Texto : public Print {
+public:
+  size_t write(uint8_t c) override {
+    conteudo += (char)c;
+    return 1;
+  }
+  using Print::write;
+  std::string conteudo;
+};
+
+typedef std::map<std::string, std::string> Campos;
+
+Campos interpretar(const std::string& linha) {
+  Campos campos;
+  std::istringstream entrada(linha);
+  std::string item;
+  entrada >> item;  // "BANCADA"
+  while (entrada >> item) {
+    size_t igual = item.find('=');
+    campos[item.substr(0, igual)] = igual == std::string::npos ? "" : item.substr(igual + 1);
+  }
+  return campos;
+}
+
+}  // namespace
+
+TEST_F(BancadaTeste, RelatorioTemUmaLinhaPorRotina) {
+  setaDisplay.begin();
+  sensores.iniciar();
+
+  Texto saida;
+  bancada.executar(saida);
+
+  std::istringstream linhas(saida.conteudo);
+  std::string linha;
+  std::vector<Campos> rotinas;
+  bool cabecalho = false, fim = false;
+  while (std::getline(linhas, linha)) {
+    ASSERT_EQ(linha.rfind("BANCADA ", 0), 0u) << linha;
+    Campos campos = interpretar(linha);
+    if (campos.count("versao")) {
+      cabecalho = true;
+      EXPECT_EQ(campos["cpu_mhz"], "240");
+    } else if (campos.count("fim")) {
+      fim = true;
+    } else {
+      rotinas.push_back(campos);
+    }
+  }
+  EXPECT_TRUE(cabecalho);
+  EXPECT_TRUE(fim);
+
+  std::vector<std::string> nomes = {"integraFFT", "detectarPico", "detectarToque",
+                                    "calibrarSensorIndividual", "seta", "fft_arduinoFFT",
+                                    "fft_portavel", "fft_espdsp_f32", "fft_espdsp_s16",
+                                    "classificarGolpe", "registrarLog",
+                                    "decodificarMedicao_firebaseJson", "decodificarMedicao",
+                                    "decodificarMedicao_entrada"};
+  ASSERT_EQ(rotinas.size(), nomes.size());
+  for (size_t i = 0; i < nomes.size(); i++) {
+    EXPECT_EQ(rotinas[i]["nome"], nomes[i]);
+    EXPECT_LE(std::stoul(rotinas[i]["ciclos_min"]), std::stoul(rotinas[i]["ciclos_medio"]));
+    EXPECT_LE(std::stoul(rotinas[i]["ciclos_medio"]), std::stoul(rotinas[i]["ciclos_max"]));
+  }
+
+  // No host os ciclos vêm do relógio simulado: a calibração espera
+  // 20 amostras de 100 ms a 240 MHz
+  EXPECT_EQ(rotinas[3]["iteracoes"], "3");
+  EXPECT_EQ(rotinas[3]["ciclos_medio"], "480000000");
+}
+
+TEST_F(BancadaTeste, MedirContaCiclosDoRelogio) {
+  ResultadoBancada r = Bancada::medir("espera", 4, [](uint32_t i) { delayMicroseconds(10 * (i + 1)); });
+  EXPECT_EQ(r.iteracoes, 4u);
+  EXPECT_EQ(r.ciclosMin, 10u * 240);
+  EXPECT_EQ(r.ciclosMax, 40u * 240);
+  EXPECT_EQ(r.ciclosMedio, 25u * 240);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "Boot.h"
+#include "Simulacao.h"
+
+namespace {
+
+class BootTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    delay(300);  // ROM, bootloader e core antes do setup()
+    sequencia.iniciar();
+  }
+
+  SequenciaBoot sequencia;
+};
+
+// Print que guarda o texto
+class Texto : public Print {
+public:
+  std::string conteudo;
+  size_t write(uint8_t c) override {
+    conteudo.push_back((char)c);
+    return 1;
+  }
+};
+
+}  // namespace
+
+TEST_F(BootTeste, FasesMedemInicioEDuracaoDesdeOSetup) {
+  EXPECT_EQ(sequencia.getAntesDoSetupMs(), 300u);
+  delay(5);
+  sequencia.inicioFase(FaseBoot::Display);
+  delay(40);
+  sequencia.fimFase(FaseBoot::Display);
+
+  RegistroFase display = sequencia.fase(FaseBoot::Display);
+  EXPECT_EQ(display.estado, EstadoFase::Concluida);
+  EXPECT_EQ(display.inicioUs, 5000u);
+  EXPECT_EQ(display.duracaoUs, 40000u);
+  EXPECT_EQ(display.tentativas, 1);
+  EXPECT_EQ(sequencia.fase(FaseBoot::WiFi).estado, EstadoFase::Pendente);
+}
+
+TEST_F(BootTeste, BitsSoComAFaseConcluida) {
+  EXPECT_FALSE(sequencia.pronto(BOOT_LOCAL));
+  sequencia.inicioFase(FaseBoot::Tarefas);
+  delay(10);
+  sequencia.fimFase(FaseBoot::Tarefas);
+  EXPECT_TRUE(sequencia.pronto(BOOT_LOCAL));
+  EXPECT_EQ(sequencia.getLocalProntoMs(), 10u);
+
+  sequencia.inicioFase(FaseBoot::Hora);
+  sequencia.fimFase(FaseBoot::Hora, false);
+  EXPECT_FALSE(sequencia.pronto(BOOT_HORA));
+  EXPECT_FALSE(sequencia.pronto(BOOT_LOCAL | BOOT_HORA));
+  EXPECT_EQ(sequencia.fase(FaseBoot::Hora).estado, EstadoFase::Falhou);
+}
+
+TEST_F(BootTeste, RetentativaSomaAoTempoDaFase) {
+  // WiFi falha duas vezes (5 s entre tentativas) e conecta na terceira
+  for (int i = 0; i < 2; i++) {
+    sequencia.inicioFase(FaseBoot::WiFi);
+    delay(100);
+    sequencia.fimFase(FaseBoot::WiFi, false);
+    delay(5000);
+  }
+  sequencia.inicioFase(FaseBoot::WiFi);
+  delay(100);
+  sequencia.fimFase(FaseBoot::WiFi);
+
+  RegistroFase wifi = sequencia.fase(FaseBoot::WiFi);
+  EXPECT_EQ(wifi.inicioUs, 0u);
+  EXPECT_EQ(wifi.duracaoUs, 10300000u);
+  EXPECT_EQ(wifi.tentativas, 3);
+  EXPECT_TRUE(sequencia.pronto(BOOT_WIFI));
+
+  // Uma reconexão depois não muda o relatório, mas os bits sim
+  sequencia.limpar(BOOT_WIFI);
+  EXPECT_FALSE(sequencia.pronto(BOOT_WIFI));
+  sequencia.inicioFase(FaseBoot::WiFi);
+  sequencia.fimFase(FaseBoot::WiFi);
+  EXPECT_TRUE(sequencia.pronto(BOOT_WIFI));
+  EXPECT_EQ(sequencia.fase(FaseBoot::WiFi).duracaoUs, 10300000u);
+}
+
+TEST_F(BootTeste, AguardarEsgotaOPrazoSemOBit) {
+  uint64_t inicio = simulacao::agoraUs();
+  EXPECT_FALSE(sequencia.aguardar(BOOT_FIREBASE, 2000));
+  EXPECT_EQ(simulacao::agoraUs() - inicio, 2000000u);
+
+  sequencia.fimFase(FaseBoot::Firebase);
+  EXPECT_TRUE(sequencia.aguardar(BOOT_FIREBASE, 2000));
+}
+
+TEST_F(BootTeste, RelatorioListaAsFases) {
+  sequencia.inicioFase(FaseBoot::Tarefas);
+  delay(1200);
+  sequencia.fimFase(FaseBoot::Tarefas);
+  Texto saida;
+  sequencia.relatorio(saida);
+  for (int i = 0; i < NUM_FASES_BOOT; i++) {
+    EXPECT_NE(saida.conteudo.find(nomeFaseBoot((FaseBoot)i)), std::string::npos);
+  }
+  EXPECT_NE(saida.conteudo.find("Local pronto em 1200 ms (acima da meta)"), std::string::npos);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Captura.h"
+#include "Sensores.h"
+#include "Simulacao.h"
+
+namespace {
+
+class CapturaTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    sensores.iniciar();
+    // A estimativa de repouso sobrevive ao configurar(): começa do zero
+    captura = CapturaGolpe();
+  }
+
+  // Repouso em 1 g no eixo Z e um golpe em meio-seno no X em golpeMs
+  static void definirGolpe(uint32_t golpeMs, float intensidade) {
+    simulacao::definirFonteIMU([golpeMs, intensidade](uint64_t agora) {
+      simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+      int64_t fase = (int64_t)(agora / 1000) - golpeMs;
+      if (fase >= 0 && fase < 20) {
+        amostra.ax = intensidade * sinf(M_PI * fase / 20.0f);
+        amostra.gz = 300;
+      }
+      return amostra;
+    });
+  }
+
+  static xyzFloat vetor(float x, float y, float z) {
+    xyzFloat v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+  }
+};
+
+}  // namespace
+
+TEST_F(CapturaTeste, JanelaTemPreEPosGatilho) {
+  captura.configurar(10, 20, 1.5f);
+  xyzFloat zero = vetor(0, 0, 0);
+  for (uint32_t i = 0; i < 50; i++) {
+    EXPECT_FALSE(captura.adicionar(i, vetor(0, 0, 1), zero));
+  }
+  EXPECT_EQ(captura.getFase(), FaseCaptura::Monitorando);
+  EXPECT_EQ(captura.getAmostrasMonitoradas(), 50u);
+
+  EXPECT_FALSE(captura.adicionar(50, vetor(5, 0, 1), zero));
+  EXPECT_EQ(captura.getFase(), FaseCaptura::Capturando);
+  for (uint32_t i = 51; i < 69; i++) {
+    EXPECT_FALSE(captura.adicionar(i, vetor(0, 0, 1), zero));
+  }
+  EXPECT_TRUE(captura.adicionar(69, vetor(0, 0, 1), zero));
+  EXPECT_EQ(captura.getFase(), FaseCaptura::Completa);
+
+  // 10 amostras antes do gatilho, ele e mais 19
+  ASSERT_EQ(captura.getTamanho(), 30u);
+  EXPECT_EQ(captura.getIndiceGatilho(), 10u);
+  EXPECT_EQ(captura.amostra(0).tempoUs, 40u);
+  EXPECT_EQ(captura.amostra(10).tempoUs, 50u);
+  EXPECT_FLOAT_EQ(captura.amostra(10).ax, 5.0f);
+  EXPECT_EQ(captura.amostra(29).tempoUs, 69u);
+
+  // Completa: novas amostras são ignoradas até reiniciar()
+  EXPECT_FALSE(captura.adicionar(70, vetor(9, 0, 1), zero));
+  EXPECT_EQ(captura.amostra(29).tempoUs, 69u);
+  captura.reiniciar();
+  EXPECT_EQ(captura.getFase(), FaseCaptura::Monitorando);
+}
+
+TEST_F(CapturaTeste, GatilhoLogoNoInicioTemJanelaMenor) {
+  captura.configurar(10, 5, 1.5f);
+  xyzFloat zero = vetor(0, 0, 1);
+  captura.adicionar(0, vetor(0, 0, 1), zero);
+  captura.adicionar(1, vetor(0, 0, 1), zero);
+  captura.adicionar(2, vetor(4, 0, 1), zero);
+  for (uint32_t i = 3; i < 7; i++) {
+    captura.adicionar(i, vetor(0, 0, 1), zero);
+  }
+  ASSERT_EQ(captura.getFase(), FaseCaptura::Completa);
+  EXPECT_EQ(captura.getTamanho(), 7u);
+  EXPECT_EQ(captura.getIndiceGatilho(), 2u);
+  EXPECT_EQ(captura.amostra(0).tempoUs, 0u);
+}
+
+TEST_F(CapturaTeste, ComecarNoMeioDoGolpeEsperaORepouso) {
+  captura.configurar(10, 5, 1.5f);
+  xyzFloat zero = vetor(0, 0, 1);
+  // O fim deste golpe não é gatilho
+  for (uint32_t i = 0; i < 5; i++) {
+    captura.adicionar(i, vetor(6, 0, 1), zero);
+  }
+  for (uint32_t i = 5; i < 20; i++) {
+    captura.adicionar(i, vetor(0, 0, 1), zero);
+  }
+  EXPECT_EQ(captura.getFase(), FaseCaptura::Monitorando);
+
+  // O próximo é, com o pré-gatilho só de repouso
+  captura.adicionar(20, vetor(6, 0, 1), zero);
+  EXPECT_EQ(captura.getIndiceGatilho(), 10u);
+  EXPECT_EQ(captura.amostra(0).ax, 0.0f);
+}
+
+TEST_F(CapturaTeste, RepousoAcompanhaMudancaLentaSemDisparar) {
+  captura.configurar(10, 10, 1.0f);
+  xyzFloat zero = vetor(0, 0, 0);
+  // Rampa de 1 g até 2,5 g em 5 s, lenta demais para ser golpe
+  for (uint32_t i = 0; i < 5000; i++) {
+    captura.adicionar(i, vetor(0, 0, 1.0f + 1.5f * i / 5000), zero);
+  }
+  EXPECT_EQ(captura.getFase(), FaseCaptura::Monitorando);
+  EXPECT_NEAR(captura.getRepousoG(), 2.5f, 0.1f);
+}
+
+TEST_F(CapturaTeste, GolpeAtrasadoEhCapturadoNoImpacto) {
+  definirGolpe(3000, 8.0f);
+  uint64_t inicio = simulacao::agoraUs();
+  ASSERT_TRUE(captura.aguardarGolpe(sensores, CAPTURA_ESPERA_MS));
+
+  // O gatilho está no golpe, com o pré-gatilho antes dele
+  const AmostraGolpe& gatilho = captura.amostra(captura.getIndiceGatilho());
+  EXPECT_NEAR((gatilho.tempoUs - inicio) / 1000.0, 3000, 5);
+  EXPECT_EQ(captura.getIndiceGatilho(), CAPTURA_PRE_MS * CAPTURA_TAXA_HZ / 1000);
+  EXPECT_EQ(captura.getTamanho(), (CAPTURA_PRE_MS + CAPTURA_POS_MS) * CAPTURA_TAXA_HZ / 1000);
+  EXPECT_GT(gatilho.gz, 0.0f);
+
+  // A espera termina logo depois da janela pós-gatilho
+  EXPECT_LT((simulacao::agoraUs() - inicio) / 1000.0, 3000 + CAPTURA_POS_MS + 10);
+  EXPECT_GT(captura.analisarForca(), 0.0f);
+}
+
+TEST_F(CapturaTeste, SemGolpeEsgotaOLimite) {
+  definirGolpe(60000, 8.0f);
+  uint64_t inicio = simulacao::agoraUs();
+  EXPECT_FALSE(captura.aguardarGolpe(sensores, 2000));
+  EXPECT_NEAR((simulacao::agoraUs() - inicio) / 1000.0, 2000, 5);
+  EXPECT_EQ(captura.analisarForca(), 0.0f);
+}
+
+TEST_F(CapturaTeste, ForcaDaJanelaCresceComOGolpe) {
+  definirGolpe(500, 4.0f);
+  ASSERT_TRUE(captura.aguardarGolpe(sensores, CAPTURA_ESPERA_MS));
+  float fraco = captura.analisarForca();
+
+  definirGolpe(simulacao::agoraUs() / 1000 + 500, 12.0f);
+  ASSERT_TRUE(captura.aguardarGolpe(sensores, CAPTURA_ESPERA_MS));
+  float forte = captura.analisarForca();
+  EXPECT_GT(forte, 2 * fraco);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "Captura.h"
+#include "Log.h"
+#include "ModosTeste.h"
+#include "Sensores.h"
+
+TEST_F(ModosTeste, CenarioPrecisaoSobreviveAQuedaDaRede) {
+  uint8_t pino = sensores.getPino(4);  // LED 5
+  uint32_t descartados = 0;
+  Cenario cenario;
+  cenario
+      .fazer("pede precisão", [&] {
+        gravar("/estado", R"("ocupado")");
+        gravar("/entrada", R"({"estado":"solicitada","tipo":"precisao","usuario":"u1"})");
+      })
+      .esperar("comando → precisão", [&] { return estado() == Estado::Precisao; }, 5000)
+      .fazer("acende o LED 5 e toca o pad", [&] {
+        gravar("/entrada/ledIndex", "5");
+        simulacao::definirFonteToque([pino](uint8_t p, uint64_t tempoUs) -> uint16_t {
+          return p == pino && tempoUs % 400000 < 100000 ? 30000 : 0;
+        });
+      })
+      .esperar("LED → resultado",
+               [&] { return ler("/saida/estado").comoTexto() == "concluida"; }, 5000)
+      .fazer("derruba a rede", [&] {
+        descartados = servicoLog.getDescartados();
+        simulacao::definirWiFiConectado(false);
+      })
+      // Sem LED a tarefa espera: antes, girava sem parar e lotava o log de erros
+      .manter("precisão segue sem rede", [&] { return estado() == Estado::Precisao; }, 3000)
+      .fazer("volta a rede", [&] { simulacao::definirWiFiConectado(true); })
+      .esperar("rede → registro", [&] { return boot.pronto(BOOT_FIREBASE); }, 10000)
+      // O registro refaz o nó como "disponivel": sem app, o modo para
+      .esperar("registro → inicial", [&] { return estado() == Estado::Inicial; }, 5000);
+  ASSERT_TRUE(cenario.executar());
+
+  EXPECT_EQ(servicoLog.getDescartados(), descartados);
+  EXPECT_EQ(ler("/estado").comoTexto(), "disponivel");
+}
+
+TEST_F(ModosTeste, CenarioResultadoDaPrecisaoVaiParaOPadTocado) {
+  uint8_t pino = sensores.getPino(4);
+  Cenario cenario;
+  cenario
+      .fazer("pede precisão", [&] {
+        gravar("/estado", R"("ocupado")");
+        gravar("/entrada", R"({"estado":"solicitada","tipo":"precisao","usuario":"u1"})");
+      })
+      .esperar("comando → precisão", [&] { return estado() == Estado::Precisao; }, 5000)
+      .fazer("acende o LED 5 e toca o pad 5", [&] {
+        gravar("/entrada/ledIndex", "5");
+        simulacao::definirFonteToque([pino](uint8_t p, uint64_t tempoUs) -> uint16_t {
+          return p == pino && tempoUs % 400000 < 100000 ? 30000 : 0;
+        });
+      })
+      .esperar("LED → resultado",
+               [&] { return ler("/saida/estado").comoTexto() == "concluida"; }, 5000);
+  ASSERT_TRUE(cenario.executar());
+
+  EXPECT_TRUE(ler("/saida/resultado/acerto").comoBool());
+  EXPECT_EQ(ler("/saida/resultado/sensorTocado").comoInteiro(), 4);
+  EXPECT_EQ(ler("/saida/resultado/ledSorteado").comoInteiro(), 5);
+  // Com o resultado enviado a precisão segue, esperando o próximo LED
+  EXPECT_EQ(estado(), Estado::Precisao);
+}
+
+TEST_F(ModosTeste, CenarioPrecisaoParaQuandoOAppApagaAMedicao) {
+  Cenario cenario;
+  cenario
+      .fazer("pede precisão", [&] {
+        gravar("/estado", R"("ocupado")");
+        gravar("/entrada", R"({"estado":"solicitada","tipo":"precisao","usuario":"u1"})");
+      })
+      .esperar("comando → precisão", [&] { return estado() == Estado::Precisao; }, 5000)
+      // Como o foco.html ao parar o treino
+      .fazer("app apaga a medição", [&] { remover("/entrada"); })
+      .esperar("parada → inicial", [&] { return estado() == Estado::Inicial; }, 5000)
+      .manter("não volta à precisão", [&] { return estado() == Estado::Inicial; }, 2000);
+  ASSERT_TRUE(cenario.executar());
+}
+
+TEST_F(ModosTeste, CenarioForcaParadaNaoAtropelaOProximoModo) {
+  Cenario cenario;
+  cenario
+      .fazer("pede força", [&] {
+        gravar("/estado", R"("ocupado")");
+        gravar("/entrada", R"({"estado":"solicitada","tipo":"forca","usuario":"u1"})");
+      })
+      .esperar("comando → força", [&] { return estado() == Estado::Forca; }, 5000)
+      .fazer("app manda parar", [&] { gravar("/entrada/comando", R"("parar")"); })
+      .esperar("parar → inicial", [&] { return estado() == Estado::Inicial; }, 5000)
+      .esperar("comando limpo", [&] { return ler("/entrada/comando").nulo(); }, 1000)
+      .fazer("pede agilidade", [&] {
+        gravar("/entrada", R"({"estado":"solicitada","tipo":"tempo_reacao","usuario":"u1"})");
+      })
+      .esperar("comando → agilidade", [&] { return estado() == Estado::Agilidade; }, 5000)
+      // A captura da força segue até CAPTURA_ESPERA_MS sem golpe; ao acabar não
+      // pode enviar resultado nem devolver o saco ao estado inicial
+      .manter("agilidade segue", [&] { return estado() == Estado::Agilidade; },
+              CAPTURA_ESPERA_MS)
+      .fazer("toca o centro", [&] {
+        simulacao::definirFonteToque([](uint8_t pino, uint64_t tempoUs) -> uint16_t {
+          return pino == T3 && tempoUs % 300000 < 100000 ? 30000 : 0;
+        });
+      })
+      .esperar("toque → resultado",
+               [&] { return ler("/saida/estado").comoTexto() == "concluida"; }, 20000);
+  ASSERT_TRUE(cenario.executar());
+
+  EXPECT_FALSE(ler("/saida/toque/inicioS").nulo());
+  EXPECT_TRUE(ler("/saida/metricas").nulo());
+}
@@ -0,0 +1,414 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Circuito.h"
+#include "Sensores.h"
+
+namespace {
+
+class TransporteSimulado;
+
+// Tempo verdadeiro e quadros em trânsito entre os sacos simulados. Cada
+// enlace soma um atraso fixo e uma variação uniforme sorteada por quadro,
+// nos dois sentidos, como o rádio compartilhado com o WiFi
+struct Mundo {
+  uint64_t agoraUs = 0;
+  uint32_t atrasoUs = 500;
+  uint32_t variacaoUs = 300;
+  std::mt19937 sorteio{7};
+
+  struct Transito {
+    uint64_t entregaUs;
+    TransporteSimulado* destino;
+    uint8_t origem[6];
+    MensagemCircuito mensagem;
+  };
+  std::vector<Transito> transito;
+  std::vector<TransporteSimulado*> nos;
+};
+
+// Relógio local = deslocamento + tempo verdadeiro com a deriva do cristal
+class TransporteSimulado : public TransporteCircuito {
+public:
+  TransporteSimulado(Mundo& mundo, uint8_t id, uint32_t deslocamentoUs, double derivaPpm)
+    : mundo(mundo), deslocamentoUs(deslocamentoUs), derivaPpm(derivaPpm) {
+    uint8_t base[6] = {0x24, 0x6F, 0x28, 0x00, 0x00, id};
+    memcpy(mac, base, sizeof(mac));
+    mundo.nos.push_back(this);
+  }
+
+  bool iniciar() override { return true; }
+
+  bool enviar(const uint8_t destino[6], const MensagemCircuito& mensagem) override {
+    if (isolado) {
+      return true;  // Sai, mas ninguém ouve
+    }
+    bool broadcast = memcmp(destino, CIRCUITO_BROADCAST, 6) == 0;
+    std::uniform_int_distribution<uint32_t> variacao(0, mundo.variacaoUs);
+    for (TransporteSimulado* no : mundo.nos) {
+      if (no == this || no->isolado || (!broadcast && memcmp(destino, no->mac, 6) != 0)) {
+        continue;
+      }
+      Mundo::Transito quadro;
+      quadro.entregaUs = mundo.agoraUs + mundo.atrasoUs + variacao(mundo.sorteio);
+      quadro.destino = no;
+      memcpy(quadro.origem, mac, 6);
+      quadro.mensagem = mensagem;
+      mundo.transito.push_back(quadro);
+    }
+    return true;
+  }
+
+  // Não bloqueia: o teste avança o tempo. recebidoUs é o instante da
+  // chegada, como o carimbo do callback no ESP32
+  bool receber(QuadroCircuito& quadro, uint32_t esperaMs) override {
+    (void)esperaMs;
+    auto proximo = mundo.transito.end();
+    for (auto item = mundo.transito.begin(); item != mundo.transito.end(); ++item) {
+      if (item->destino == this && item->entregaUs <= mundo.agoraUs &&
+          (proximo == mundo.transito.end() || item->entregaUs < proximo->entregaUs)) {
+        proximo = item;
+      }
+    }
+    if (proximo == mundo.transito.end()) {
+      return false;
+    }
+    memcpy(quadro.origem, proximo->origem, 6);
+    quadro.recebidoUs = localEm(proximo->entregaUs);
+    quadro.mensagem = proximo->mensagem;
+    mundo.transito.erase(proximo);
+    return true;
+  }
+
+  uint32_t agoraUs() override { return localEm(mundo.agoraUs); }
+  void getMac(uint8_t mac[6]) override { memcpy(mac, this->mac, 6); }
+
+  uint32_t localEm(uint64_t verdadeiroUs) const {
+    return deslocamentoUs + (uint32_t)(int64_t)((double)verdadeiroUs * (1.0 + derivaPpm * 1e-6));
+  }
+
+  bool isolado = false;
+
+private:
+  Mundo& mundo;
+  uint8_t mac[6];
+  uint32_t deslocamentoUs;
+  double derivaPpm;
+};
+
+// Um saco: transporte, participante e a reação que o "atleta" vai ter
+struct SacoSimulado {
+  SacoSimulado(Mundo& mundo, uint8_t id, uint32_t deslocamentoUs, double derivaPpm)
+    : transporte(mundo, id, deslocamentoUs, derivaPpm), participante(transporte) {
+    participante.definirDisponivel(true);
+  }
+
+  TransporteSimulado transporte;
+  ParticipanteCircuito participante;
+  int32_t reacaoUs = 250000;  // -1: não toca
+  std::vector<uint64_t> disparosUs;  // Tempo verdadeiro de cada disparo
+  uint64_t toqueUs = 0;
+  int padToque = 0;
+};
+
+class CircuitoTeste : public ::testing::Test {
+protected:
+  static constexpr uint32_t PASSO_US = 20;
+
+  void SetUp() override { randomSeed(11); }
+
+  SacoSimulado& adicionar(uint32_t deslocamentoUs, double derivaPpm) {
+    sacos.emplace_back(new SacoSimulado(mundo, (uint8_t)(sacos.size() + 1), deslocamentoUs,
+                                        derivaPpm));
+    return *sacos.back();
+  }
+
+  CoordenadorCircuito& coordenar() {
+    coordenador.reset(new CoordenadorCircuito(sacos[0]->transporte, sacos[0]->participante));
+    return *coordenador;
+  }
+
+  // Uma volta da tarefa do circuito em cada saco, e o tempo avança um passo
+  void passo() {
+    for (size_t i = 0; i < sacos.size(); i++) {
+      SacoSimulado& saco = *sacos[i];
+      QuadroCircuito quadro;
+      while (saco.transporte.receber(quadro, 0)) {
+        if (i == 0 && coordenador && coordenador->tratar(quadro)) {
+          continue;
+        }
+        saco.participante.tratar(quadro);
+      }
+      if (i == 0 && coordenador) {
+        coordenador->processar();
+      }
+      int pad = saco.participante.processar();
+      if (pad > 0) {
+        saco.disparosUs.push_back(mundo.agoraUs);
+        if (saco.reacaoUs >= 0) {
+          saco.toqueUs = mundo.agoraUs + saco.reacaoUs;
+          saco.padToque = pad;
+        }
+      }
+      if (saco.toqueUs != 0 && mundo.agoraUs >= saco.toqueUs) {
+        saco.toqueUs = 0;
+        saco.participante.informarToque(saco.padToque, saco.transporte.agoraUs());
+      }
+    }
+    if (coordenador) {
+      RodadaCircuito rodada;
+      if (coordenador->rodadaPronta(rodada)) {
+        rodadas.push_back(rodada);
+      }
+    }
+    mundo.agoraUs += PASSO_US;
+  }
+
+  void avancarMs(uint32_t ms) {
+    uint64_t fim = mundo.agoraUs + ms * 1000ULL;
+    while (mundo.agoraUs < fim) {
+      passo();
+    }
+  }
+
+  bool executarAte(std::function<bool()> condicao, uint32_t limiteMs) {
+    uint64_t fim = mundo.agoraUs + limiteMs * 1000ULL;
+    while (mundo.agoraUs < fim) {
+      if (condicao()) {
+        return true;
+      }
+      passo();
+    }
+    return condicao();
+  }
+
+  // Posição do saco i entre os vizinhos do coordenador (ordem de adesão)
+  int indiceVizinho(size_t i) {
+    uint8_t mac[6], outro[6];
+    sacos[i]->transporte.getMac(mac);
+    for (uint8_t j = 0; j < coordenador->getNumSacos(); j++) {
+      coordenador->getMacSaco(j, outro);
+      if (memcmp(mac, outro, 6) == 0) {
+        return j;
+      }
+    }
+    return -1;
+  }
+
+  // Erro do relógio estimado do saco i, agora
+  int32_t erroRelogioUs(size_t i) {
+    const RelogioPar& relogio = coordenador->getRelogio(indiceVizinho(i));
+    uint32_t estimado = relogio.paraLocal(sacos[0]->transporte.agoraUs());
+    return (int32_t)(estimado - sacos[i]->transporte.agoraUs());
+  }
+
+  Mundo mundo;
+  std::vector<std::unique_ptr<SacoSimulado>> sacos;
+  std::unique_ptr<CoordenadorCircuito> coordenador;
+  std::vector<RodadaCircuito> rodadas;
+};
+
+}  // namespace
+
+TEST(RelogioPar, DeslocamentoPelaMenorIdaEVolta) {
+  RelogioPar relogio;
+  // Vizinho 1.000.000 us à frente; ida 300 us e volta 100 us na primeira
+  // amostra, 120 us e 110 us na segunda, que vale por ser a mais curta
+  relogio.adicionar(1000, 1000 + 300 + 1000000, 1000 + 350 + 1000000, 1000 + 350 + 100);
+  relogio.adicionar(5000, 5000 + 120 + 1000000, 5000 + 150 + 1000000, 5000 + 150 + 110);
+  ASSERT_TRUE(relogio.fecharJanela());
+
+  EXPECT_EQ(relogio.getAmostras(), 2);
+  EXPECT_NEAR((int32_t)relogio.getDeslocamentoUs(), 1000000, 5);
+  EXPECT_EQ(relogio.getIncertezaUs(), 115u);
+  EXPECT_NEAR((int32_t)(relogio.paraLocal(20000) - 1020000), 0, 5);
+  EXPECT_EQ(relogio.paraMestre(relogio.paraLocal(20000)), 20000u);
+}
+
+TEST(RelogioPar, DerivaEntreJanelasEPassagemPorZero) {
+  RelogioPar relogio;
+  // Vizinho atrás do mestre (deslocamento "negativo", módulo 2^32) e 100 ppm
+  // mais rápido
+  uint32_t deslocamento = (uint32_t)-5000;
+  relogio.adicionar(0, deslocamento + 50, deslocamento + 60, 110);
+  ASSERT_TRUE(relogio.fecharJanela());
+  relogio.iniciarJanela();
+  uint32_t t1 = 2000000;
+  uint32_t t2 = t1 + deslocamento + 200 + 50;  // 200 us de deriva em 2 s
+  relogio.adicionar(t1, t2, t2 + 10, t1 + 110);
+  ASSERT_TRUE(relogio.fecharJanela());
+
+  EXPECT_NEAR(relogio.getDerivaPpb(), 100000, 1000);
+  // 1 s depois da última sincronia: mais 100 us
+  EXPECT_NEAR((int32_t)(relogio.paraLocal(3000055) - (3000055 + deslocamento + 300)), 0, 3);
+  EXPECT_FALSE(RelogioPar().fecharJanela());
+}
+
+TEST_F(CircuitoTeste, SincroniaAbaixoDeUmMsComEnlaceRuim) {
+  // 1 ms de atraso e até 2 ms de variação por quadro, deriva de até 50 ppm
+  mundo.atrasoUs = 1000;
+  mundo.variacaoUs = 2000;
+  adicionar(123456, 0);
+  adicionar(4000000000u, 35);
+  adicionar(777, -50);
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(1, NUM_SENSORES, 200, 200);
+
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Rodada; }, 2000));
+  ASSERT_EQ(coord.getNumSacos(), 2);
+  for (size_t i = 1; i < sacos.size(); i++) {
+    ASSERT_GE(indiceVizinho(i), 0);
+    const RelogioPar& relogio = coord.getRelogio(indiceVizinho(i));
+    EXPECT_TRUE(relogio.getSincronizado());
+    // Com até 6 ms de ida e volta, o último pong pode chegar depois do fim da janela
+    EXPECT_GE(relogio.getAmostras(), CIRCUITO_AMOSTRAS_SINC - 1);
+    int32_t erro = erroRelogioUs(i);
+    // A incerteza informada cobre o erro real, que fica abaixo de 1 ms
+    EXPECT_LT(std::abs(erro), 1000) << "saco " << i;
+    EXPECT_LE((uint32_t)std::abs(erro), relogio.getIncertezaUs() + 10) << "saco " << i;
+  }
+}
+
+TEST_F(CircuitoTeste, SincroniaDeDezenasDeUsNoEspNow) {
+  adicionar(0, 0);
+  adicionar(31337, 20);
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(1, NUM_SENSORES, 200, 200);
+
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Rodada; }, 2000));
+  EXPECT_LT(std::abs(erroRelogioUs(1)), 150);
+}
+
+TEST_F(CircuitoTeste, SacosDisparamJuntosEmTodasAsRodadas) {
+  // Enlace de ESP-NOW com o WiFi ligado; as pausas de 1,5 s deixam a deriva
+  // de 70 ppm entre os sacos pesar se a inclinação não for corrigida
+  adicionar(5000, 0);
+  adicionar(3000000000u, 40);
+  adicionar(17, -30);
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(4, NUM_SENSORES, 500, 1500);
+
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Concluido; }, 20000));
+  ASSERT_EQ(rodadas.size(), 4u);
+  for (size_t r = 0; r < rodadas.size(); r++) {
+    uint64_t primeiro = UINT64_MAX, ultimo = 0;
+    for (auto& saco : sacos) {
+      ASSERT_EQ(saco->disparosUs.size(), 4u);
+      primeiro = std::min(primeiro, saco->disparosUs[r]);
+      ultimo = std::max(ultimo, saco->disparosUs[r]);
+    }
+    EXPECT_LT(ultimo - primeiro, 500u) << "rodada " << r + 1;
+  }
+  // Fim das rodadas: os vizinhos saem da sessão
+  avancarMs(50);
+  for (auto& saco : sacos) {
+    EXPECT_FALSE(saco->participante.getAtivo());
+  }
+}
+
+TEST_F(CircuitoTeste, ResultadosJuntamReacoesSemToqueEAusentes) {
+  SacoSimulado& local = adicionar(0, 0);
+  SacoSimulado& rapido = adicionar(99999, 10);
+  SacoSimulado& parado = adicionar(4242, -10);
+  SacoSimulado& sumido = adicionar(8, 0);
+  local.reacaoUs = 300000;
+  rapido.reacaoUs = 180000;
+  parado.reacaoUs = -1;
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(2, NUM_SENSORES, 400, 300);
+
+  // Adere e sai do alcance antes da sincronia
+  ASSERT_TRUE(executarAte([&] { return coord.getNumSacos() == 3; }, 1000));
+  sumido.transporte.isolado = true;
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Concluido; }, 10000));
+  ASSERT_EQ(rodadas.size(), 2u);
+  ASSERT_TRUE(indiceVizinho(1) >= 0 && indiceVizinho(2) >= 0 && indiceVizinho(3) >= 0);
+
+  for (const RodadaCircuito& rodada : rodadas) {
+    ASSERT_EQ(rodada.numSacos, 4);
+    const ResultadoSacoCircuito& r0 = rodada.sacos[0];
+    // Depois do coordenador, os vizinhos na ordem de adesão
+    const ResultadoSacoCircuito& r1 = rodada.sacos[1 + indiceVizinho(1)];
+    const ResultadoSacoCircuito& r2 = rodada.sacos[1 + indiceVizinho(2)];
+    const ResultadoSacoCircuito& r3 = rodada.sacos[1 + indiceVizinho(3)];
+
+    uint8_t mac[6];
+    local.transporte.getMac(mac);
+    EXPECT_EQ(memcmp(r0.mac, mac, 6), 0);
+    EXPECT_TRUE(r0.respondeu);
+    EXPECT_EQ(r0.padTocado, r0.pad);
+    EXPECT_NEAR((double)r0.reacaoUs, 300000, 2 * PASSO_US);
+    EXPECT_EQ(r0.atrasoDisparoUs, 0);
+
+    rapido.transporte.getMac(mac);
+    EXPECT_EQ(memcmp(r1.mac, mac, 6), 0);
+    EXPECT_TRUE(r1.respondeu);
+    EXPECT_GE(r1.pad, 1);
+    EXPECT_LE(r1.pad, NUM_SENSORES);
+    EXPECT_EQ(r1.padTocado, r1.pad);
+    EXPECT_NEAR((double)r1.reacaoUs, 180000, 2 * PASSO_US + 10);
+    EXPECT_LT(std::abs(r1.atrasoDisparoUs), 1000);
+
+    EXPECT_TRUE(r2.respondeu);
+    EXPECT_EQ(r2.padTocado, -1);
+    EXPECT_EQ(r2.reacaoUs, CIRCUITO_SEM_TOQUE);
+
+    EXPECT_FALSE(r3.respondeu);
+    EXPECT_EQ(r3.reacaoUs, CIRCUITO_SEM_TOQUE);
+  }
+}
+
+TEST_F(CircuitoTeste, LargadaQueimadaNaoContaEOEstimuloSegue) {
+  SacoSimulado& local = adicionar(0, 0);
+  local.reacaoUs = 300000;
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(1, NUM_SENSORES, 400, 300);
+
+  // Logo depois do disparo chega um toque cuja borda começou 20 ms antes
+  ASSERT_TRUE(executarAte([&] { return !local.disparosUs.empty(); }, 5000));
+  ASSERT_TRUE(local.participante.getEmEstimulo());
+  EXPECT_FALSE(local.participante.informarToque(local.padToque,
+                                                local.participante.getDisparoUs() - 20000));
+  EXPECT_TRUE(local.participante.getEmEstimulo());
+
+  // O toque de verdade, 300 ms depois do disparo, é o resultado da rodada
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Concluido; }, 5000));
+  ASSERT_EQ(rodadas.size(), 1u);
+  EXPECT_EQ(rodadas[0].sacos[0].padTocado, rodadas[0].sacos[0].pad);
+  EXPECT_NEAR((double)rodadas[0].sacos[0].reacaoUs, 300000, 2 * PASSO_US);
+}
+
+TEST_F(CircuitoTeste, SacoOcupadoNaoAdere) {
+  adicionar(0, 0);
+  SacoSimulado& ocupado = adicionar(500, 0);
+  adicionar(900, 0);
+  ocupado.participante.definirDisponivel(false);
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(1, NUM_SENSORES, 200, 200);
+
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Concluido; }, 5000));
+  EXPECT_EQ(coord.getNumSacos(), 1);
+  EXPECT_FALSE(ocupado.participante.getAtivo());
+  EXPECT_TRUE(ocupado.disparosUs.empty());
+  ASSERT_EQ(rodadas.size(), 1u);
+  EXPECT_EQ(rodadas[0].numSacos, 2);
+}
+
+TEST_F(CircuitoTeste, VizinhoSaiQuandoOCoordenadorSome) {
+  adicionar(0, 0);
+  SacoSimulado& vizinho = adicionar(500, 0);
+  CoordenadorCircuito& coord = coordenar();
+  coord.iniciar(10, NUM_SENSORES, 200, 60000);
+
+  ASSERT_TRUE(executarAte([&] { return coord.getEtapa() == EtapaCircuito::Pausa; }, 5000));
+  EXPECT_TRUE(vizinho.participante.getAtivo());
+  sacos[0]->transporte.isolado = true;
+  avancarMs(CIRCUITO_SILENCIO_MS + 100);
+  EXPECT_FALSE(vizinho.participante.getAtivo());
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Captura.h"
+#include "Classificador.h"
+#include "TreinoClassificador.h"
+
+namespace {
+
+// Golpe em meio-seno de 20 ms no eixo X, com a gravidade em Z
+void adicionarGolpe(ExtratorGolpe& extrator, float intensidade) {
+  for (int i = 0; i < 100; i++) {
+    extrator.repouso(0, 0, 1);
+  }
+  for (uint32_t ms = 0; ms < 20; ms++) {
+    AmostraGolpe amostra = {ms * 1000, intensidade * sinf(M_PI * ms / 20.0f), 0, 1, 0, 0, 200};
+    extrator.adicionar(amostra);
+  }
+}
+
+float acuracia(const ModeloGolpes& modelo, const std::vector<traco::ExemploGolpe>& exemplos) {
+  return traco::avaliar(modelo, exemplos).acuracia;
+}
+
+}  // namespace
+
+TEST(ClassificadorTeste, ExtratorResumeGolpeReto) {
+  ExtratorGolpe extrator;
+  adicionarGolpe(extrator, 6.0f);
+  float x[NUM_CARACTERISTICAS];
+  extrator.finalizar(0, x);
+
+  EXPECT_NEAR(x[0], 6.0f, 0.1f);  // Pico do desvio em relação ao repouso
+  EXPECT_NEAR(x[1], 19.0f, 0.5f);  // Duração em ms
+  EXPECT_GT(x[2], 0.99f);          // Toda a energia no eixo X
+  EXPECT_NEAR(x[5], 1.0f, 0.01f);  // Direção no pico
+  EXPECT_NEAR(x[10], 2.0f, 0.01f); // Giro em Z / 100
+  float bandas = x[11] + x[12] + x[13];
+  EXPECT_NEAR(bandas, 1.0f, 1e-4f);
+  EXPECT_FLOAT_EQ(x[14], POSICAO_PADS[0][0]);
+  EXPECT_FLOAT_EQ(x[15], POSICAO_PADS[0][1]);
+  EXPECT_FLOAT_EQ(x[16], POSICAO_PADS[0][2]);
+
+  // Depois de finalizar, sem golpe: só o pad aparece
+  extrator.finalizar(-1, x);
+  for (int i = 0; i < NUM_CARACTERISTICAS; i++) {
+    EXPECT_EQ(x[i], 0.0f) << i;
+  }
+}
+
+TEST(ClassificadorTeste, ModeloEmbarcadoAcertaGolpesSinteticos) {
+  // Semente diferente da usada para gerar o ModeloGolpesSaco.h
+  std::vector<traco::ExemploGolpe> exemplos = traco::exemplosSinteticos(50, 7);
+  ASSERT_EQ(exemplos.size(), 200u);
+  EXPECT_GE(acuracia(modeloGolpesPadrao(), exemplos), 0.9f);
+}
+
+TEST(ClassificadorTeste, QuantizacaoConcordaComFloat) {
+  traco::ParametrosTreino parametros;
+  parametros.epocas = 60;
+  parametros.semente = 3;
+  traco::ModeloTreinado modelo = traco::treinar(traco::exemplosSinteticos(100, 3), parametros);
+  std::vector<traco::ExemploGolpe> teste = traco::exemplosSinteticos(50, 11);
+
+  traco::AvaliacaoClassificador avaliacao = traco::avaliar(modelo.tabelas(), teste, &modelo);
+  EXPECT_EQ(avaliacao.total, 200u);
+  EXPECT_GE(avaliacao.acuracia, 0.9f);
+  EXPECT_GE(avaliacao.concordancia, 0.95f);
+  uint32_t soma = 0;
+  for (int r = 0; r < NUM_TIPOS_GOLPE; r++) {
+    for (int k = 0; k < NUM_TIPOS_GOLPE; k++) {
+      soma += avaliacao.confusao[r][k];
+    }
+  }
+  EXPECT_EQ(soma, 200u);
+}
+
+TEST(ClassificadorTeste, CaracteristicasDaCaptura) {
+  static CapturaGolpe capturaTeste;
+  capturaTeste.configurar(CAPTURA_PRE_MS, CAPTURA_POS_MS, CAPTURA_LIMIAR_G);
+  xyzFloat repouso = {0, 0, 1};
+  xyzFloat semGiro = {0, 0, 0};
+  for (uint32_t ms = 0; ms < 200; ms++) {
+    capturaTeste.adicionar(ms * 1000, repouso, semGiro);
+  }
+  bool completa = false;
+  for (uint32_t ms = 200; ms < 800 && !completa; ms++) {
+    xyzFloat a = repouso;
+    xyzFloat g = semGiro;
+    if (ms < 220) {
+      a.x = 6.0f * sinf(M_PI * (ms - 200) / 20.0f);
+      g.z = 200;
+    }
+    completa = capturaTeste.adicionar(ms * 1000, a, g);
+  }
+  ASSERT_TRUE(completa);
+
+  float x[NUM_CARACTERISTICAS];
+  extrairCaracteristicas(capturaTeste, 8, x);
+  float esperado[NUM_CARACTERISTICAS];
+  ExtratorGolpe extrator;
+  adicionarGolpe(extrator, 6.0f);
+  extrator.finalizar(8, esperado);
+  EXPECT_NEAR(x[0], esperado[0], 0.1f);
+  EXPECT_NEAR(x[5], esperado[5], 0.01f);
+  EXPECT_NEAR(x[10], esperado[10], 0.01f);
+  EXPECT_FLOAT_EQ(x[14], POSICAO_PADS[8][0]);
+  EXPECT_NE(classificadorGolpes.classificar(x), TipoGolpe::Desconhecido);
+}
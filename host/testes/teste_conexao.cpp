@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Conexao.h"
+#include "RTDB.h"
+
+namespace {
+
+class ConexaoTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    conexao.begin();
+  }
+
+  std::string caminho(const std::string& sufixo) {
+    return std::string("/devices/") + conexao.deviceId.c_str() + sufixo;
+  }
+
+  simulacao::Json ler(const std::string& sufixo) {
+    simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+    const simulacao::Json* valor = raiz.buscar(caminho(sufixo));
+    return valor ? *valor : simulacao::Json();
+  }
+
+  void gravar(const std::string& sufixo, const std::string& json) {
+    simulacao::Json valor;
+    ASSERT_TRUE(simulacao::Json::interpretar(json, valor));
+    std::string erro;
+    ASSERT_TRUE(simulacao::rtdbMemoria().gravar(caminho(sufixo), valor, erro));
+  }
+};
+
+}  // namespace
+
+TEST_F(ConexaoTeste, BeginRegistraDispositivo) {
+  EXPECT_EQ(conexao.deviceId.length(), 16u);
+  EXPECT_EQ(ler("/deviceId").comoTexto(), conexao.deviceId.c_str());
+  EXPECT_EQ(ler("/estado").comoTexto(), "disponivel");
+  EXPECT_EQ(ler("/timestamp").comoInteiro(), (long long)conexao.getTimestamp());
+  EXPECT_EQ(conexao.getDeviceState(), "disponivel");
+}
+
+TEST_F(ConexaoTeste, CheckForCommandsLeMedicaoSolicitada) {
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"forca","usuario":"u1","timestampSolicitacao":123})");
+
+  ASSERT_TRUE(conexao.checkForCommands());
+  Medicao medicao = conexao.getCurrentMeasurement();
+  EXPECT_EQ(medicao.estado, EstadoMedicao::Solicitada);
+  EXPECT_EQ(medicao.tipo, TipoMedicao::Forca);
+  EXPECT_STREQ(medicao.usuario, "u1");
+  EXPECT_EQ(medicao.timestampSolicitacao, 123u);
+}
+
+TEST_F(ConexaoTeste, CheckForCommandsIgnoraMedicaoEmAndamento) {
+  gravar("/entrada", R"({"estado":"executando","tipo":"forca"})");
+  EXPECT_FALSE(conexao.checkForCommands());
+
+  simulacao::rtdbMemoria().limpar();
+  EXPECT_FALSE(conexao.checkForCommands());
+}
+
+TEST_F(ConexaoTeste, CheckForCommandsLeOComandoNoMeioDoQueSobrou) {
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"round","usuario":"u3","duracao":90,)"
+                      R"("resultado":{"acerto":true,"tipo":"forca"},"rounds":{"1":{"golpes":12}},)"
+                      R"("sensoresCalibrados":{"1":true,"2":true}})");
+  ASSERT_TRUE(conexao.checkForCommands());
+  Medicao medicao = conexao.getCurrentMeasurement();
+  EXPECT_EQ(medicao.tipo, TipoMedicao::Round);
+  EXPECT_STREQ(medicao.usuario, "u3");
+  EXPECT_EQ(medicao.duracao, 90);
+  EXPECT_EQ(medicao.rounds, 0);
+
+  // Um tipo que o saco não conhece não é reescrito nem copiado para a saída
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"sparring","usuario":"u3"})");
+  ASSERT_TRUE(conexao.checkForCommands());
+  EXPECT_EQ(conexao.getCurrentMeasurement().tipo, TipoMedicao::Desconhecido);
+  ASSERT_TRUE(conexao.updateDeviceEx());
+  EXPECT_EQ(ler("/entrada/tipo").comoTexto(), "sparring");
+  EXPECT_TRUE(ler("/saida/tipo").nulo());
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "executando");
+}
+
+TEST_F(ConexaoTeste, LeituraDoComandoNaoCresceComOsResultados) {
+  const std::string comando = R"({"versao":2,"estado":"solicitada","tipo":"precisao","usuario":"u1"})";
+  gravar("/entrada", comando);
+  uint64_t antes = simulacao::rtdbMemoria().estatisticas().bytesRecebidos;
+  ASSERT_TRUE(conexao.checkForCommands());
+  uint64_t primeira = simulacao::rtdbMemoria().estatisticas().bytesRecebidos - antes;
+
+  // Tudo o que os modos escrevem vai para saida/
+  ASSERT_TRUE(conexao.updateDeviceEx());
+  for (int i = 1; i <= 9; i++) {
+    ASSERT_TRUE(conexao.sendSensorCalibrated(i));
+  }
+  ASSERT_TRUE(conexao.sendCalibrationProgress(9, 9));
+  ASSERT_TRUE(conexao.setCurrentLed(5));
+  ASSERT_TRUE(conexao.updatePrecisionStatus("aguardando"));
+  ASSERT_TRUE(conexao.sendPrecisionResult(true, 850, 4, 5, 870));
+  ASSERT_TRUE(conexao.setReactionResult(0.41f, 0.43f, 3));
+  ASSERT_TRUE(conexao.sendForceUpdate(321.5f));
+
+  gravar("/entrada", comando);
+  antes = simulacao::rtdbMemoria().estatisticas().bytesRecebidos;
+  ASSERT_TRUE(conexao.checkForCommands());
+  EXPECT_EQ(simulacao::rtdbMemoria().estatisticas().bytesRecebidos - antes, primeira);
+  EXPECT_EQ(primeira, comando.size());
+  EXPECT_EQ(ler("/saida/resultado/ledSorteado").comoInteiro(), 5);
+}
+
+TEST_F(ConexaoTeste, SaidaEEntradaMudamNumaEscritaSo) {
+  gravar("/entrada", R"({"versao":2,"estado":"solicitada","tipo":"precisao","usuario":"u1"})");
+  ASSERT_TRUE(conexao.checkForCommands());
+  ASSERT_TRUE(conexao.updateDeviceEx());
+  ASSERT_TRUE(conexao.setCurrentLed(5));
+
+  uint64_t antes = simulacao::rtdbMemoria().estatisticas().escritas;
+  ASSERT_TRUE(conexao.sendPrecisionResult(true, 850, 5, 5, 0));
+  EXPECT_EQ(simulacao::rtdbMemoria().estatisticas().escritas - antes, 1u);
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "concluida");
+  EXPECT_EQ(ler("/entrada/estado").comoTexto(), "concluida");
+  EXPECT_TRUE(ler("/saida/resultado/acerto").comoBool());
+
+  // Os caminhos são de filhos: o resto de saida/ e de entrada/ fica
+  EXPECT_EQ(ler("/saida/usuario").comoTexto(), "u1");
+  EXPECT_EQ(ler("/saida/ledAtual").comoInteiro(), 5);
+  EXPECT_EQ(ler("/entrada/tipo").comoTexto(), "precisao");
+
+  antes = simulacao::rtdbMemoria().estatisticas().escritas;
+  ASSERT_TRUE(conexao.updateDevicemMdicoes("cancelada"));
+  EXPECT_EQ(simulacao::rtdbMemoria().estatisticas().escritas - antes, 1u);
+  EXPECT_EQ(ler("/entrada/estado").comoTexto(), "cancelada");
+  EXPECT_EQ(ler("/saida/resultado/sensorTocado").comoInteiro(), 5);
+}
+
+TEST_F(ConexaoTeste, RegistroTrocaOMedicoesDoEsquema1) {
+  EXPECT_EQ(ler("/esquema").comoInteiro(), ESQUEMA_DISPOSITIVO);
+
+  // Um nó gravado pelo firmware antigo, com o que sobrou das medições
+  gravar("/medicoes", R"({"estado":"concluida","tipo":"forca","valor":310.2,)"
+                      R"("sensoresCalibrados":{"1":true},"resultado":{"acerto":false}})");
+  gravar("/esquema", "1");
+  conexao.begin();
+  EXPECT_TRUE(ler("/medicoes").nulo());
+  EXPECT_EQ(ler("/esquema").comoInteiro(), ESQUEMA_DISPOSITIVO);
+  EXPECT_EQ(ler("/estado").comoTexto(), "disponivel");
+}
+
+TEST_F(ConexaoTeste, RegistroMantemOConfigDoApp) {
+  gravar("/config/fatorNewtons", "50");
+  gravar("/saida", R"({"estado":"concluida","tipo":"forca","valor":310.2})");
+  conexao.begin();
+  EXPECT_EQ(ler("/config/fatorNewtons").comoReal(), 50.0);
+  EXPECT_FLOAT_EQ(conexao.getForceScale(), 50.0f);
+  EXPECT_TRUE(ler("/saida").nulo());
+}
+
+TEST_F(ConexaoTeste, ComandoDeUmEsquemaMaisNovoEhRecusado) {
+  gravar("/entrada", R"({"versao":3,"estado":"solicitada","tipo":"forca","usuario":"u1"})");
+  EXPECT_FALSE(conexao.checkForCommands());
+  EXPECT_EQ(ler("/entrada/estado").comoTexto(), "recusada");
+  EXPECT_FALSE(conexao.checkForCommands());
+
+  // Sem versão (uma página que ainda não a grava) vale como o esquema atual
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"forca","usuario":"u1"})");
+  EXPECT_TRUE(conexao.checkForCommands());
+}
+
+TEST_F(ConexaoTeste, SemWiFiNaoHaComandos) {
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"forca"})");
+  simulacao::definirWiFiConectado(false);
+  EXPECT_FALSE(conexao.isConnected());
+  EXPECT_FALSE(conexao.checkForCommands());
+  EXPECT_EQ(conexao.getDeviceState(), "desconectado");
+}
+
+TEST_F(ConexaoTeste, UpdateDeviceExIniciaCalibracao) {
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"tCalibrar","usuario":"u2"})");
+  ASSERT_TRUE(conexao.checkForCommands());
+  ASSERT_TRUE(conexao.updateDeviceEx());
+
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "executando");
+  EXPECT_EQ(ler("/saida/usuario").comoTexto(), "u2");
+  EXPECT_EQ(ler("/saida/sensor").comoInteiro(), 1);
+  EXPECT_EQ(ler("/saida/progresso/total").comoInteiro(), NUM_SENSORES);
+  // O sensor pedido pelo app não é sobrescrito
+  gravar("/entrada/sensor", "4");
+  ASSERT_TRUE(conexao.updateDeviceEx());
+  EXPECT_EQ(conexao.getSensorCalibracao(), 4);
+}
+
+TEST_F(ConexaoTeste, ResultadoDeForcaConcluiMedicao) {
+  gravar("/entrada", R"({"versao":2,"estado":"solicitada","tipo":"forca","usuario":"u1"})");
+  ASSERT_TRUE(conexao.checkForCommands());
+  ASSERT_TRUE(conexao.updateDeviceEx());
+  EXPECT_EQ(ler("/entrada/estado").comoTexto(), "executando");
+  ASSERT_TRUE(conexao.setMeasurementResult(12.5f));
+  ASSERT_TRUE(conexao.updateDevicemMdicoes("concluida"));
+
+  EXPECT_DOUBLE_EQ(ler("/saida/valor").comoReal(), 12.5);
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "concluida");
+  EXPECT_EQ(ler("/saida/tipo").comoTexto(), "forca");
+  EXPECT_EQ(ler("/saida/versao").comoInteiro(), ESQUEMA_DISPOSITIVO);
+  // Na entrada só o estado muda
+  EXPECT_EQ(ler("/entrada/estado").comoTexto(), "concluida");
+  EXPECT_TRUE(ler("/entrada/valor").nulo());
+  EXPECT_FALSE(conexao.checkForCommands());
+}
+
+TEST_F(ConexaoTeste, ResultadoDePrecisaoTemObjetoResultado) {
+  ASSERT_TRUE(conexao.sendPrecisionResult(true, 850, 3, 4));
+
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "concluida");
+  EXPECT_TRUE(ler("/saida/resultado/acerto").comoBool());
+  EXPECT_EQ(ler("/saida/resultado/tempoResposta").comoInteiro(), 850);
+  EXPECT_EQ(ler("/saida/resultado/sensorTocado").comoInteiro(), 3);
+  EXPECT_EQ(ler("/saida/resultado/ledSorteado").comoInteiro(), 4);
+}
+
+TEST_F(ConexaoTeste, ResumoDoUsuarioAcumulaCadaResultado) {
+  const float forcas[] = {20, 35, 25};
+  for (float forca : forcas) {
+    ASSERT_TRUE(conexao.updateUserSummary("u1", "forca", forca, true));
+  }
+  ASSERT_TRUE(conexao.updateUserSummary("u1", "tempo_reacao", 0.4f, false));
+  EXPECT_FALSE(conexao.updateUserSummary("", "forca", 10, true));
+
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  const simulacao::Json* resumo = raiz.buscar("/users/u1/resumo/forca");
+  ASSERT_NE(resumo, nullptr);
+  EXPECT_EQ(resumo->buscar("contagem")->comoInteiro(), 3);
+  EXPECT_NEAR(resumo->buscar("media")->comoReal(), 80.0 / 3, 1e-4);
+  EXPECT_NEAR(resumo->buscar("desvio")->comoReal(), std::sqrt(175.0 / 3), 1e-3);
+  EXPECT_EQ(resumo->buscar("melhor")->comoReal(), 35);
+  EXPECT_EQ(resumo->buscar("proximo")->comoInteiro(), 3);
+  EXPECT_EQ(resumo->buscar("ultimos/2")->comoReal(), 25);
+  EXPECT_EQ(raiz.buscar("/users/u1/resumo/tempo_reacao/contagem")->comoInteiro(), 1);
+
+  // Sem conseguir ler o resumo não grava um novo por cima
+  simulacao::definirWiFiConectado(false);
+  EXPECT_FALSE(conexao.updateUserSummary("u1", "forca", 50, true));
+}
+
+TEST_F(ConexaoTeste, SensorDeCalibracaoAusenteCriaEstrutura) {
+  EXPECT_EQ(conexao.getSensorCalibracao(), -1);
+  EXPECT_EQ(ler("/entrada/tipo").comoTexto(), "tCalibrar");
+  EXPECT_EQ(ler("/entrada/estado").comoTexto(), "solicitada");
+
+  EXPECT_EQ(conexao.getSensorCalibracao(), 0);
+  ASSERT_TRUE(conexao.setSensorCalibracao(5));
+  EXPECT_EQ(conexao.getSensorCalibracao(), 5);
+}
+
+TEST_F(ConexaoTeste, ComandoPararEhConsumido) {
+  gravar("/entrada", R"({"estado":"executando","comando":"parar"})");
+  EXPECT_TRUE(conexao.checkForStopCommand());
+  EXPECT_TRUE(ler("/entrada/comando").nulo());
+  EXPECT_FALSE(conexao.checkForStopCommand());
+}
+
+TEST_F(ConexaoTeste, MedicaoApagadaTambemPara) {
+  // O app apaga o nó ao parar o treino
+  EXPECT_TRUE(conexao.checkForStopCommand());
+  gravar("/entrada", R"({"estado":"executando"})");
+  EXPECT_FALSE(conexao.checkForStopCommand());
+  simulacao::definirWiFiConectado(false);
+  EXPECT_FALSE(conexao.checkForStopCommand());
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Delta.h"
+#include "GeradorDelta.h"
+#include "ImagensOta.h"
+
+namespace {
+
+class ParticoesMemoria : public ParticoesDelta {
+public:
+  explicit ParticoesMemoria(const std::vector<uint8_t>& base) : base(base) {}
+  std::vector<uint8_t> saida;
+  size_t leituras = 0;
+
+  bool lerBase(uint32_t posicao, uint8_t* dados, size_t tamanho) override {
+    leituras++;
+    if (posicao + tamanho > base.size()) return false;
+    memcpy(dados, base.data() + posicao, tamanho);
+    return true;
+  }
+  bool escrever(const uint8_t* dados, size_t tamanho) override {
+    saida.insert(saida.end(), dados, dados + tamanho);
+    return true;
+  }
+
+private:
+  const std::vector<uint8_t>& base;
+};
+
+// Alimenta o delta em pedaços de `pedaco` bytes (0: tamanhos sorteados)
+bool aplicar(AplicadorDelta& aplicador, ParticoesDelta& particoes,
+             const std::vector<uint8_t>& delta, size_t pedaco) {
+  std::mt19937 sorteio(3);
+  aplicador.reiniciar();
+  for (size_t i = 0; i < delta.size();) {
+    size_t n = pedaco ? pedaco : 1 + sorteio() % 1500;
+    n = std::min(n, delta.size() - i);
+    if (!aplicador.alimentar(particoes, delta.data() + i, n)) {
+      return false;
+    }
+    i += n;
+  }
+  return aplicador.getConcluido();
+}
+
+// A janela de 4 KB não vai para a pilha
+AplicadorDelta aplicador;
+
+}  // namespace
+
+TEST(Delta, Crc32DoZlib) {
+  const char* texto = "123456789";
+  EXPECT_EQ(crc32Delta(0, (const uint8_t*)texto, strlen(texto)), 0xCBF43926u);
+  // Em partes, continuando do anterior
+  uint32_t crc = crc32Delta(0, (const uint8_t*)texto, 4);
+  EXPECT_EQ(crc32Delta(crc, (const uint8_t*)texto + 4, 5), 0xCBF43926u);
+}
+
+TEST(Delta, ReproduzAVersaoNovaEmPedacosDeQualquerTamanho) {
+  std::vector<uint8_t> base = imagens_ota::imagemFirmware("1.0.0");
+  std::vector<uint8_t> nova = imagens_ota::versaoSeguinte(base, "1.1.0");
+  ota::EstatisticasDelta estatisticas;
+  std::vector<uint8_t> delta = ota::gerarDelta(base, nova, &estatisticas);
+
+  // Três funções novas e 64 endereços: muito menos que a imagem
+  EXPECT_LT(delta.size(), nova.size() / 20);
+  EXPECT_GT(estatisticas.bytesBase, nova.size() * 9 / 10);
+
+  for (size_t pedaco : {(size_t)1, (size_t)7, (size_t)1024, (size_t)0}) {
+    ParticoesMemoria particoes(base);
+    ASSERT_TRUE(aplicar(aplicador, particoes, delta, pedaco)) << pedaco << ": "
+                                                              << nomeErroDelta(aplicador.getErro());
+    EXPECT_EQ(particoes.saida, nova) << pedaco;
+    EXPECT_EQ(aplicador.getGerados(), nova.size());
+  }
+}
+
+TEST(Delta, SemBaseEhAImagemCompletaComprimida) {
+  std::vector<uint8_t> vazia;
+  std::vector<uint8_t> nova = imagens_ota::imagemFirmware("1.1.0");
+  std::vector<uint8_t> completa = ota::gerarDelta(vazia, nova);
+  EXPECT_LT(completa.size(), nova.size() * 9 / 10);
+
+  ParticoesMemoria particoes(vazia);
+  ASSERT_TRUE(aplicar(aplicador, particoes, completa, 0)) << nomeErroDelta(aplicador.getErro());
+  EXPECT_EQ(particoes.saida, nova);
+  EXPECT_EQ(aplicador.getCabecalho().tamanhoBase, 0u);
+  EXPECT_EQ(particoes.leituras, 0u);
+}
+
+TEST(Delta, BaseErradaRecusadaAntesDeEscrever) {
+  std::vector<uint8_t> base = imagens_ota::imagemFirmware("1.0.0");
+  std::vector<uint8_t> nova = imagens_ota::versaoSeguinte(base, "1.1.0");
+  std::vector<uint8_t> delta = ota::gerarDelta(base, nova);
+
+  // Mesma versão, outro build
+  std::vector<uint8_t> outra = imagens_ota::imagemFirmware("1.0.0", 5);
+  ParticoesMemoria particoes(outra);
+  EXPECT_FALSE(aplicar(aplicador, particoes, delta, 0));
+  EXPECT_EQ(aplicador.getErro(), ErroDelta::Base);
+  EXPECT_TRUE(particoes.saida.empty());
+}
+
+TEST(Delta, DeltaCorrompidoOuCortadoNaoConclui) {
+  std::vector<uint8_t> base = imagens_ota::imagemFirmware("1.0.0");
+  std::vector<uint8_t> nova = imagens_ota::versaoSeguinte(base, "1.1.0");
+  std::vector<uint8_t> delta = ota::gerarDelta(base, nova);
+
+  // Um byte trocado fora do cabeçalho: o erro aparece no meio (formato,
+  // tamanho) ou no CRC do fim, ou o delta fica esperando bytes que não vêm;
+  // nunca conclui
+  std::mt19937 sorteio(11);
+  for (int i = 0; i < 50; i++) {
+    std::vector<uint8_t> corrompido = delta;
+    size_t posicao = sizeof(CabecalhoDelta) + sorteio() % (delta.size() - sizeof(CabecalhoDelta));
+    corrompido[posicao] ^= (uint8_t)(1 + sorteio() % 255);
+    ParticoesMemoria particoes(base);
+    EXPECT_FALSE(aplicar(aplicador, particoes, corrompido, 0)) << posicao;
+  }
+
+  std::vector<uint8_t> cortado(delta.begin(), delta.end() - 10);
+  ParticoesMemoria particoes(base);
+  EXPECT_FALSE(aplicar(aplicador, particoes, cortado, 0));
+  EXPECT_FALSE(aplicador.getConcluido());
+
+  std::vector<uint8_t> semMagico = delta;
+  semMagico[0] ^= 0xFF;
+  ParticoesMemoria outra(base);
+  EXPECT_FALSE(aplicar(aplicador, outra, semMagico, 0));
+  EXPECT_EQ(aplicador.getErro(), ErroDelta::Formato);
+}
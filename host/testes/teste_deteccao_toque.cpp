@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "DeteccaoToque.h"
+
+namespace {
+
+const uint32_t PERIODO_US = TOQUE_PERIODO_MS * 1000;
+const int LIMITE = 15000;
+
+// Ruído uniforme de ±amplitude (determinístico)
+struct Ruido {
+  uint32_t estado = 12345;
+  int operator()(int amplitude) {
+    estado = estado * 1103515245u + 12345u;
+    return (int)((estado >> 16) % (2 * amplitude + 1)) - amplitude;
+  }
+};
+
+// Repouso em 1000 e rampa linear até 30000 a partir de inicioUs
+uint16_t rampa(uint32_t tempoUs, uint32_t inicioUs, uint32_t subidaUs) {
+  if (tempoUs <= inicioUs) {
+    return 1000;
+  }
+  if (tempoUs >= inicioUs + subidaUs) {
+    return 30000;
+  }
+  return 1000 + (uint16_t)(29000.0 * (tempoUs - inicioUs) / subidaUs);
+}
+
+// Alimenta o detector até confirmar; devolve o instante da confirmação (0: nenhuma)
+uint32_t alimentarAteToque(DetectorToque& detector, uint32_t inicioUs, uint32_t subidaUs,
+                           Ruido& ruido) {
+  for (uint32_t t = PERIODO_US; t < 2000000; t += PERIODO_US) {
+    if (detector.adicionar(t, rampa(t, inicioUs, subidaUs) + ruido(20), LIMITE)) {
+      return t;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+TEST(DeteccaoToqueTeste, InicioNaoDependeDaInclinacaoDaBorda) {
+  // Luvas e pads diferentes: a mesma aproximação com subidas de 20 a 160 ms
+  const uint32_t subidasMs[] = {20, 40, 80, 160};
+  for (uint32_t subidaMs : subidasMs) {
+    SCOPED_TRACE(subidaMs);
+    DetectorToque detector;
+    Ruido ruido;
+    const uint32_t inicioUs = 1003700;  // Fora da grade de amostragem
+    ASSERT_NE(alimentarAteToque(detector, inicioUs, subidaMs * 1000, ruido), 0u);
+
+    EXPECT_NEAR((double)detector.getInicioUs(), (double)inicioUs, 3000.0);
+    // O cruzamento fica mais tarde quanto mais lenta a subida
+    double cruzamentoEsperado = inicioUs + subidaMs * 1000.0 * (LIMITE - 1000) / 29000.0;
+    EXPECT_NEAR((double)detector.getCruzamentoUs(), cruzamentoEsperado, 1500.0);
+  }
+}
+
+TEST(DeteccaoToqueTeste, HistereseNaoRedisparaComOToqueSegurado) {
+  DetectorToque detector;
+  Ruido ruido;
+  ASSERT_NE(alimentarAteToque(detector, 500000, 40000, ruido), 0u);
+  EXPECT_TRUE(detector.tocando());
+
+  // Oscila entre 20000 e 30000 (a luva escorrega no pad): continua o mesmo toque
+  uint32_t t = 700000;
+  for (int i = 0; i < 50; i++, t += PERIODO_US) {
+    EXPECT_FALSE(detector.adicionar(t, (i % 4 < 2) ? 20000 : 30000, LIMITE));
+  }
+  // Cai um pouco abaixo do limite sem soltar: ainda não libera
+  EXPECT_FALSE(detector.adicionar(t, 12000, LIMITE));
+  t += PERIODO_US;
+  EXPECT_FALSE(detector.adicionar(t, 30000, LIMITE));
+  t += PERIODO_US;
+
+  // Solta e toca de novo
+  for (int i = 0; i < 30; i++, t += PERIODO_US) {
+    EXPECT_FALSE(detector.adicionar(t, 1000 + ruido(20), LIMITE));
+  }
+  EXPECT_FALSE(detector.tocando());
+  bool confirmou = false;
+  uint32_t inicio = t + 2000;
+  for (int i = 0; i < 20 && !confirmou; i++, t += PERIODO_US) {
+    confirmou = detector.adicionar(t, rampa(t, inicio, 40000) + ruido(20), LIMITE);
+  }
+  EXPECT_TRUE(confirmou);
+  EXPECT_NEAR((double)detector.getInicioUs(), (double)inicio, 3000.0);
+}
+
+TEST(DeteccaoToqueTeste, RuidoEDeslizeDaBaseNaoDisparam) {
+  DetectorToque detector;
+  Ruido ruido;
+  // 5 s de ruído de ±200 com a base subindo de 1000 para 3000 (temperatura, umidade)
+  for (uint32_t t = PERIODO_US; t < 5000000; t += PERIODO_US) {
+    uint16_t base = 1000 + (uint16_t)(2000.0 * t / 5000000);
+    ASSERT_FALSE(detector.adicionar(t, base + ruido(200), LIMITE));
+  }
+  // A base acompanha com o atraso da média (constante de 0,5 s a 400/s)
+  EXPECT_NEAR(detector.getBase(), 2800.0, 100.0);
+  EXPECT_GT(detector.getRuido(), 50.0f);
+  EXPECT_LT(detector.getRuido(), 200.0f);
+}
+
+TEST(DeteccaoToqueTeste, DoisPadsNaMesmaLeituraValeABordaMaisAntiga) {
+  // Pad 0 com subida rápida e pad 5 com subida lenta que começou antes:
+  // os dois passam do limite entre as mesmas duas leituras
+  DetectorToques detector;
+  int limites[NUM_SENSORES];
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    limites[i] = LIMITE;
+  }
+  EventoToque evento;
+  int pad = -1;
+  for (uint32_t t = PERIODO_US; t < 1000000 && pad < 0; t += PERIODO_US) {
+    uint16_t valores[NUM_SENSORES];
+    for (int i = 0; i < NUM_SENSORES; i++) {
+      valores[i] = 1000;
+    }
+    valores[0] = rampa(t, 510000, 20000);
+    valores[5] = rampa(t, 480000, 80000);
+    pad = detector.adicionar(t, valores, limites, evento);
+  }
+  ASSERT_EQ(pad, 5);
+  EXPECT_EQ(evento.pad, 5);
+  EXPECT_TRUE(detector.pad(0).tocando());
+  EXPECT_NEAR((double)evento.inicioUs, 480000.0, 3000.0);
+  EXPECT_LT(evento.inicioUs, evento.cruzamentoUs);
+}
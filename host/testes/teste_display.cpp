@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "PainelSSD1306.h"
+#include "ServicoDisplay.h"
+#include "display.h"
+#include "setas.h"
+
+namespace {
+
+class DisplayTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    simulacao::painelSSD1306().reiniciar();
+    tela.begin();
+    simulacao::painelSSD1306().zerarContadores();
+  }
+
+  const uint8_t* gddram() { return simulacao::painelSSD1306().memoria(); }
+
+  SetaDisplay tela;
+};
+
+const size_t INICIO_AZUL = (YELLOW_AREA_HEIGHT / 8) * SCREEN_WIDTH;
+
+// Com a tarefa do display rodando
+class ServicoDisplayTeste : public DisplayTeste {
+protected:
+  void SetUp() override {
+    DisplayTeste::SetUp();
+    simulacao::definirRelogio(simulacao::ModoRelogio::Real);
+    ASSERT_TRUE(servico.iniciar());
+  }
+
+  void TearDown() override {
+    simulacao::encerrarTarefas();
+  }
+
+  ServicoDisplay servico{tela};
+};
+
+}  // namespace
+
+TEST_F(DisplayTeste, BeginLigaEApagaOPainel) {
+  EXPECT_TRUE(simulacao::painelSSD1306().ligado());
+  for (int i = 0; i < SCREEN_WIDTH * NUM_PAGINAS; i++) {
+    ASSERT_EQ(gddram()[i], 0) << i;
+  }
+}
+
+TEST_F(DisplayTeste, SetaChegaAoPainelComoOGlifo) {
+  for (int indice = 0; indice < NUM_GLIFOS_SETA - 1; indice++) {
+    tela.seta(indice * 45);
+    ASSERT_EQ(memcmp(gddram() + INICIO_AZUL, GLIFOS_SETA[indice], TAMANHO_GLIFO_SETA), 0)
+        << "angulo " << indice * 45;
+  }
+  tela.seta("f");
+  EXPECT_EQ(memcmp(gddram() + INICIO_AZUL, GLIFOS_SETA[GLIFO_SETA_CENTRO], TAMANHO_GLIFO_SETA),
+            0);
+}
+
+TEST_F(DisplayTeste, AnguloInvalidoApagaAreaAzul) {
+  tela.seta(90);
+  tela.seta(30);
+  for (size_t i = INICIO_AZUL; i < (size_t)SCREEN_WIDTH * NUM_PAGINAS; i++) {
+    ASSERT_EQ(gddram()[i], 0) << i;
+  }
+}
+
+TEST_F(DisplayTeste, HoraEnviaApenasAreaAmarela) {
+  tela.seta(0);
+  simulacao::painelSSD1306().zerarContadores();
+
+  tela.showtimeCompact("12:34:56 01/02");
+  uint32_t enviados = simulacao::painelSSD1306().bytesDados();
+  EXPECT_GT(enviados, 0u);
+  EXPECT_LE(enviados, (uint32_t)INICIO_AZUL);
+
+  // A seta da área azul continua intacta
+  EXPECT_EQ(memcmp(gddram() + INICIO_AZUL, GLIFOS_SETA[0], TAMANHO_GLIFO_SETA), 0);
+}
+
+TEST_F(DisplayTeste, StatusEnviaSoOCantoDoSimbolo) {
+  tela.setStatus(2);
+  // 16 colunas das duas páginas amarelas, mais a linha extra da 3ª página
+  EXPECT_LE(simulacao::painelSSD1306().bytesDados(), 16u * 3);
+}
+
+TEST_F(DisplayTeste, SemEnvioAutomaticoSoUpdateEnvia) {
+  tela.setEnvioAutomatico(false);
+  tela.seta(180);
+  tela.print("TESTE");
+  EXPECT_EQ(simulacao::painelSSD1306().bytesDados(), 0u);
+
+  tela.update();
+  EXPECT_EQ(memcmp(gddram() + INICIO_AZUL, GLIFOS_SETA[4], TAMANHO_GLIFO_SETA), 0);
+
+  // Nada mudou: nada a enviar
+  simulacao::painelSSD1306().zerarContadores();
+  tela.update();
+  EXPECT_EQ(simulacao::painelSSD1306().bytesDados(), 0u);
+}
+
+TEST_F(ServicoDisplayTeste, EstimuloSoVoltaComASetaNoPainel) {
+  uint32_t postagem = micros();
+  uint32_t instante = servico.estimuloSeta(90);
+  EXPECT_EQ(memcmp(gddram() + INICIO_AZUL, GLIFOS_SETA[2], TAMANHO_GLIFO_SETA), 0);
+  EXPECT_GE((int32_t)(instante - postagem), 0);
+  EXPECT_LE((int32_t)(instante - micros()), 0);
+}
+
+TEST_F(ServicoDisplayTeste, FilaCheiaNaoDescartaOEstimulo) {
+  for (int i = 0; i < 8 * TAMANHO_FILA_DISPLAY; i++) {
+    servico.log(String(i));
+  }
+  servico.estimuloSeta(180);
+  EXPECT_EQ(memcmp(gddram() + INICIO_AZUL, GLIFOS_SETA[4], TAMANHO_GLIFO_SETA), 0);
+
+  // A mesma seta de novo: já está na tela, volta sem redesenhar
+  uint32_t renderizacoes = servico.getRenderizacoes();
+  servico.estimuloSeta(180);
+  EXPECT_EQ(servico.getRenderizacoes(), renderizacoes);
+}
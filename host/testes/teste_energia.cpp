@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <WiFi.h>
+
+#include "Energia.h"
+#include "RTDB.h"
+#include "Sensores.h"
+#include "Simulacao.h"
+
+namespace {
+
+class EnergiaTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    sensores.iniciar();
+    energia.iniciar(60000);
+  }
+
+  // Toque no pad `indice` a partir de inicioMs (em tempo absoluto)
+  static void tocarEm(int indice, uint64_t inicioMs) {
+    uint8_t pino = sensores.getPino(indice);
+    simulacao::definirFonteToque([pino, inicioMs](uint8_t lido, uint64_t agora) -> uint16_t {
+      return (lido == pino && agora / 1000 >= inicioMs) ? 30000 : 1000;
+    });
+  }
+};
+
+}  // namespace
+
+TEST_F(EnergiaTeste, OciosoSoDepoisDoTempoSemAtividade) {
+  EXPECT_FALSE(energia.ocioso());
+  delay(59000);
+  EXPECT_FALSE(energia.ocioso());
+  energia.registrarAtividade();
+  delay(59000);
+  EXPECT_FALSE(energia.ocioso());
+  delay(1000);
+  EXPECT_TRUE(energia.ocioso());
+}
+
+TEST_F(EnergiaTeste, TemporizadorAcordaSemOutraFonte) {
+  delay(60000);
+  uint64_t inicio = simulacao::agoraUs();
+  EXPECT_EQ(energia.dormir(2000), CausaDespertar::Temporizador);
+  EXPECT_NEAR((double)(simulacao::agoraUs() - inicio), 2000000.0, 2000.0);
+  EXPECT_EQ(energia.getCiclos(), 1u);
+  EXPECT_NEAR((double)energia.getTempoDormindoUs(), 2000000.0, 2000.0);
+  // Acordar pelo temporizador não é uso do saco
+  EXPECT_TRUE(energia.ocioso());
+  // O wake-on-motion só fica ligado durante o sono
+  EXPECT_FALSE(simulacao::despertarMovimentoAtivo());
+}
+
+TEST_F(EnergiaTeste, ToqueNoPadDoCentroAcordaEMedeOPronto) {
+  delay(60000);
+  tocarEm(ENERGIA_PAD_DESPERTAR, millis() + 700);
+  uint64_t inicio = simulacao::agoraUs();
+  EXPECT_EQ(energia.dormir(), CausaDespertar::Toque);
+  EXPECT_NEAR((double)(simulacao::agoraUs() - inicio), 700000.0, 2000.0);
+  EXPECT_FALSE(energia.ocioso());
+
+  delay(3);
+  energia.marcarPronto();
+  EXPECT_EQ(energia.getLatenciaDespertarUs(), 3000u);
+  EXPECT_EQ(energia.getDespertares(CausaDespertar::Toque), 1u);
+}
+
+TEST_F(EnergiaTeste, GolpeAcordaPeloWakeOnMotion) {
+  // Toque só em outro pad: não acorda (um único canal de toque no sono)
+  tocarEm(0, 0);
+  uint64_t golpeMs = millis() + 400;
+  simulacao::definirFonteIMU([golpeMs](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if (agora / 1000 >= golpeMs && agora / 1000 < golpeMs + 20) {
+      amostra.ax = 4.0f;
+    }
+    return amostra;
+  });
+  EXPECT_EQ(energia.dormir(), CausaDespertar::Movimento);
+  EXPECT_NEAR((double)millis(), (double)golpeMs, 2.0);
+  energia.marcarPronto();
+  EXPECT_LT(energia.getLatenciaDespertarUs(), (uint32_t)ENERGIA_META_DESPERTAR_US);
+}
+
+TEST_F(EnergiaTeste, BalancoAbaixoDoLimiarNaoAcorda) {
+  simulacao::definirFonteIMU([](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    amostra.ax = ((agora / 100000) % 2) ? 0.2f : -0.05f;  // 0,25 g < 300 mg
+    return amostra;
+  });
+  EXPECT_EQ(energia.dormir(1000), CausaDespertar::Temporizador);
+}
+
+TEST_F(EnergiaTeste, EventoDoStreamAcordaPelaRede) {
+  std::string erro;
+  std::shared_ptr<simulacao::FluxoRTDB> fluxo =
+      simulacao::rtdbMemoria().observar("/devices/saco", erro);
+  ASSERT_TRUE(fluxo);
+
+  // O app grava no nó 300 ms depois de o saco dormir
+  uint64_t gravacaoMs = millis() + 300;
+  simulacao::definirFonteIMU([gravacaoMs](uint64_t agora) {
+    if (agora / 1000 == gravacaoMs) {
+      simulacao::Json valor;
+      std::string erroGravacao;
+      simulacao::Json::interpretar(R"("ocupado")", valor);
+      simulacao::rtdbMemoria().gravar("/devices/saco/estado", valor, erroGravacao);
+    }
+    return simulacao::AmostraIMU{0, 0, 1, 0, 0, 0};
+  });
+  EXPECT_EQ(energia.dormir(), CausaDespertar::Rede);
+  EXPECT_NEAR((double)millis(), (double)gravacaoMs, 2.0);
+  // Pela rede não há ninguém na frente do saco: sem medição de pronto
+  energia.marcarPronto();
+  EXPECT_EQ(energia.getLatenciaDespertarUs(), 0u);
+}
+
+TEST_F(EnergiaTeste, ModemSleepSoEnquantoOcioso) {
+  energia.economizarRede(true);
+  EXPECT_EQ(WiFi.getSleep(), WIFI_PS_MAX_MODEM);
+  energia.economizarRede(false);
+  EXPECT_EQ(WiFi.getSleep(), WIFI_PS_MIN_MODEM);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "ComparacaoFFT.h"
+#include "Sensores.h"
+
+namespace {
+
+// Golpe em meio-seno sobre 1 g e um ruído determinístico
+float amostra(uint32_t i, float intensidade) {
+  uint32_t fase = i % 200;
+  float golpe = fase < 20 ? intensidade * sinf(M_PI * fase / 20.0f) : 0.0f;
+  return 1.0f + golpe + ((i * 37) % 11) * 0.005f;
+}
+
+template <class FFT>
+std::vector<float> saidas(float intensidade, uint32_t quantidade) {
+  PipelineForca<FFT> pipeline;
+  std::vector<float> resultado;
+  for (uint32_t i = 0; i < quantidade; i++) {
+    resultado.push_back(pipeline.processar(amostra(i, intensidade)));
+  }
+  return resultado;
+}
+
+template <class FFT>
+void compararComReferencia(float intensidade, float tolerancia) {
+  std::vector<float> referencia = saidas<FFTArduino<SAMPLES>>(intensidade, 600);
+  std::vector<float> obtido = saidas<FFT>(intensidade, 600);
+  for (size_t i = SAMPLES - 1; i < referencia.size(); i++) {
+    ASSERT_NEAR(obtido[i], referencia[i], tolerancia * referencia[i] + 1e-3f)
+        << FFT::nome() << " amostra " << i;
+  }
+}
+
+}  // namespace
+
+TEST(EspectroTeste, PipelineSoCalculaComAJanelaCheia) {
+  PipelineForca<FFTPortavel<SAMPLES>> pipeline;
+  for (int i = 0; i < SAMPLES - 1; i++) {
+    EXPECT_EQ(pipeline.processar(amostra(i, 8)), 0.0f);
+  }
+  EXPECT_GT(pipeline.processar(amostra(SAMPLES - 1, 8)), 0.0f);
+
+  pipeline.reiniciar();
+  EXPECT_EQ(pipeline.processar(amostra(0, 8)), 0.0f);
+}
+
+TEST(EspectroTeste, SinalConstanteNaoTemEnergia) {
+  PipelineForca<FFTEspDspF32<SAMPLES>> pipeline;
+  float ultima = 0;
+  for (int i = 0; i < 2 * SAMPLES; i++) {
+    ultima = pipeline.processar(1.0f);
+  }
+  EXPECT_NEAR(ultima, 0.0f, 1e-4f);
+}
+
+TEST(EspectroTeste, BackendsFloatEquivalemAoArduinoFFT) {
+  compararComReferencia<FFTPortavel<SAMPLES>>(8, 1e-4f);
+  compararComReferencia<FFTEspDspF32<SAMPLES>>(8, 1e-4f);
+  compararComReferencia<FFTPortavel<SAMPLES>>(0.5f, 1e-4f);
+  compararComReferencia<FFTEspDspF32<SAMPLES>>(0.5f, 1e-4f);
+}
+
+TEST(EspectroTeste, BackendQ15PerdePoucaPrecisaoEmGolpes) {
+  compararComReferencia<FFTEspDspS16<SAMPLES>>(8, 0.03f);
+  compararComReferencia<FFTEspDspS16<SAMPLES>>(20, 0.03f);
+}
+
+TEST(EspectroTeste, ComparacaoNoTracoSintetico) {
+  traco::ParametrosSinteticos parametros;
+  parametros.duracaoMs = 6000;
+  parametros.golpes = {{500, 3.0f, 20, 0}, {2500, 8.0f, 20, 1}, {4500, 14.0f, 20, 2}};
+  std::vector<traco::ResultadoFFT> r = traco::compararFFT(traco::gerarSintetico(parametros));
+
+  ASSERT_EQ(r.size(), 4u);
+  EXPECT_EQ(r[0].nome, "arduinoFFT");
+  ASSERT_EQ(r[0].forcas.size(), 6u);
+  EXPECT_GT(r[0].forcas[2], r[0].forcas[0]);  // Golpe de 8 g maior que o de 3 g
+  EXPECT_EQ(r[0].erroMaximo, 0.0f);
+  for (size_t i = 1; i < r.size(); i++) {
+    EXPECT_EQ(r[i].forcas.size(), r[0].forcas.size());
+    EXPECT_LT(r[i].erroMaximo, r[i].nome == "espdsp_s16" ? 0.05f : 1e-3f) << r[i].nome;
+  }
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "Estatisticas.h"
+
+TEST(Estatisticas, WelfordBateComAsDuasPassagens) {
+  const std::vector<float> valores = {12.5f, 30.0f, 18.25f, 22.0f, 9.75f, 41.0f, 27.5f};
+  ResumoEstatistico resumo;
+  for (float valor : valores) {
+    resumo.adicionar(valor);
+  }
+
+  double soma = 0;
+  for (float valor : valores) {
+    soma += valor;
+  }
+  double media = soma / valores.size();
+  double quadrados = 0;
+  for (float valor : valores) {
+    quadrados += (valor - media) * (valor - media);
+  }
+  EXPECT_EQ(resumo.getContagem(), valores.size());
+  EXPECT_NEAR(resumo.getMedia(), media, 1e-4);
+  EXPECT_NEAR(resumo.getVariancia(), quadrados / (valores.size() - 1), 1e-3);
+  EXPECT_NEAR(resumo.getDesvio(), std::sqrt(quadrados / (valores.size() - 1)), 1e-4);
+  EXPECT_EQ(resumo.getMelhor(), 41.0f);
+}
+
+TEST(Estatisticas, MelhorPodeSerOMenor) {
+  ResumoEstatistico tempos(false);
+  EXPECT_EQ(tempos.getVariancia(), 0.0f);
+  tempos.adicionar(0.42f);
+  EXPECT_EQ(tempos.getMelhor(), 0.42f);
+  EXPECT_EQ(tempos.getVariancia(), 0.0f);
+  tempos.adicionar(0.31f);
+  tempos.adicionar(0.55f);
+  EXPECT_EQ(tempos.getMelhor(), 0.31f);
+}
+
+TEST(Estatisticas, AnelGuardaOsUltimosEmOrdem) {
+  ResumoEstatistico resumo;
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(resumo.adicionar(i), i);
+  }
+  ASSERT_EQ(resumo.getNumUltimos(), 3);
+  EXPECT_EQ(resumo.getUltimo(0), 0.0f);
+  EXPECT_EQ(resumo.getUltimo(2), 2.0f);
+
+  // Depois de cheio, cada resultado toma o lugar do mais antigo
+  for (int i = 3; i < ESTATISTICAS_ULTIMOS + 4; i++) {
+    resumo.adicionar(i);
+  }
+  ASSERT_EQ(resumo.getNumUltimos(), ESTATISTICAS_ULTIMOS);
+  EXPECT_EQ(resumo.getProximo(), 4);
+  for (int i = 0; i < ESTATISTICAS_ULTIMOS; i++) {
+    EXPECT_EQ(resumo.getUltimo(i), (float)(i + 4)) << i;
+  }
+}
+
+TEST(Estatisticas, RestaurarContinuaDeOndeParou) {
+  // Metade dos valores, salva e restaurada como no Firebase, depois o resto
+  const float valores[] = {5, 7, 3, 9, 4, 8};
+  ResumoEstatistico inteiro;
+  ResumoEstatistico primeiro;
+  for (int i = 0; i < 6; i++) {
+    inteiro.adicionar(valores[i]);
+    if (i < 3) {
+      primeiro.adicionar(valores[i]);
+    }
+  }
+
+  ResumoEstatistico retomado;
+  retomado.restaurar(primeiro.getContagem(), primeiro.getMedia(), primeiro.getM2(),
+                     primeiro.getMelhor(), primeiro.getProximo());
+  for (uint8_t i = 0; i < primeiro.getNumUltimos(); i++) {
+    retomado.definirUltimo(i, primeiro.getUltimo(i));
+  }
+  for (int i = 3; i < 6; i++) {
+    retomado.adicionar(valores[i]);
+  }
+
+  EXPECT_EQ(retomado.getContagem(), inteiro.getContagem());
+  EXPECT_FLOAT_EQ(retomado.getMedia(), inteiro.getMedia());
+  EXPECT_FLOAT_EQ(retomado.getVariancia(), inteiro.getVariancia());
+  EXPECT_EQ(retomado.getMelhor(), 9.0f);
+  for (uint8_t i = 0; i < 6; i++) {
+    EXPECT_EQ(retomado.getUltimo(i), inteiro.getUltimo(i));
+  }
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "Conexao.h"
+#include "Firebase_ESP_Client.h"
+#include "Frota.h"
+#include "RTDB.h"
+#include "Simulacao.h"
+
+using simulacao::EventoRTDB;
+using simulacao::Json;
+
+namespace {
+
+Json json(const std::string& texto) {
+  Json valor;
+  EXPECT_TRUE(Json::interpretar(texto, valor)) << texto;
+  return valor;
+}
+
+class FrotaTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    simulacao::definirRelogio(simulacao::ModoRelogio::Real, 1.0);
+  }
+
+  void TearDown() override {
+    simulacao::definirRTDB(nullptr);
+    simulacao::reiniciar();
+  }
+};
+
+}  // namespace
+
+TEST_F(FrotaTeste, ObservarMemoriaEncaminhaEscritasRelativas) {
+  simulacao::RTDBMemoria banco;
+  std::string erro;
+  ASSERT_TRUE(banco.gravar("/devices/a", json(R"({"estado":"ocupado"})"), erro));
+
+  auto fluxo = banco.observar("/devices/a", erro);
+  ASSERT_TRUE(fluxo);
+  EventoRTDB evento;
+  ASSERT_TRUE(fluxo->proximo(evento, 0));
+  EXPECT_EQ(evento.tipo, "put");
+  EXPECT_EQ(evento.caminho, "/");
+  EXPECT_EQ(evento.dados.buscar("estado")->comoTexto(), "ocupado");
+
+  // Dentro do nó: caminho relativo
+  ASSERT_TRUE(banco.gravar("/devices/a/medicoes/estado", Json("solicitada"), erro));
+  ASSERT_TRUE(fluxo->proximo(evento, 0));
+  EXPECT_EQ(evento.tipo, "put");
+  EXPECT_EQ(evento.caminho, "/medicoes/estado");
+  EXPECT_EQ(evento.dados.comoTexto(), "solicitada");
+
+  ASSERT_TRUE(banco.atualizar("/devices/a", json(R"({"timestamp":5})"), erro));
+  ASSERT_TRUE(fluxo->proximo(evento, 0));
+  EXPECT_EQ(evento.tipo, "patch");
+  EXPECT_EQ(evento.caminho, "/");
+
+  // Outro nó: nada
+  ASSERT_TRUE(banco.gravar("/devices/b/estado", Json("livre"), erro));
+  EXPECT_FALSE(fluxo->proximo(evento, 0));
+
+  // Ancestral: o nó inteiro de novo; remoção chega como put null
+  ASSERT_TRUE(banco.gravar("/devices", json(R"({"a":{"estado":"x"}})"), erro));
+  ASSERT_TRUE(fluxo->proximo(evento, 0));
+  EXPECT_EQ(evento.caminho, "/");
+  EXPECT_EQ(evento.dados.buscar("estado")->comoTexto(), "x");
+
+  ASSERT_TRUE(banco.remover("/devices/a", erro));
+  ASSERT_TRUE(fluxo->proximo(evento, 0));
+  EXPECT_EQ(evento.tipo, "put");
+  EXPECT_TRUE(evento.dados.nulo());
+}
+
+TEST_F(FrotaTeste, ServidorAtendeOShimDoFirebasePorHTTP) {
+  frota::ServidorRTDB servidor;
+  ASSERT_TRUE(servidor.iniciar());
+  frota::ClienteRTDBHTTP cliente("127.0.0.1", servidor.porta());
+  simulacao::definirRTDB(&cliente);
+
+  FirebaseData fbdo;
+  FirebaseJson dados;
+  dados.set("estado", "solicitada");
+  dados.set("tentativas", 2);
+  ASSERT_TRUE(Firebase.RTDB.setJSON(&fbdo, "/devices/x/medicoes", &dados));
+  ASSERT_TRUE(Firebase.RTDB.setString(&fbdo, "/devices/x/nome com espaço", "s"));
+
+  ASSERT_TRUE(Firebase.RTDB.getString(&fbdo, "/devices/x/medicoes/estado"));
+  EXPECT_EQ(fbdo.stringData(), "solicitada");
+  ASSERT_TRUE(Firebase.RTDB.getInt(&fbdo, "/devices/x/medicoes/tentativas"));
+  EXPECT_EQ(fbdo.intData(), 2);
+  ASSERT_TRUE(Firebase.RTDB.getString(&fbdo, "/devices/x/nome com espaço"));
+  EXPECT_EQ(fbdo.stringData(), "s");
+
+  EXPECT_FALSE(Firebase.RTDB.getString(&fbdo, "/devices/y/estado"));
+  EXPECT_EQ(fbdo.errorReason(), "path not exist");
+
+  ASSERT_TRUE(Firebase.RTDB.deleteNode(&fbdo, "/devices/x"));
+  EXPECT_FALSE(Firebase.RTDB.getString(&fbdo, "/devices/x/medicoes/estado"));
+
+  frota::EstatisticasCliente e = cliente.estatisticas();
+  EXPECT_EQ(e.requisicoes[(int)frota::OperacaoRTDB::Gravacao], 2u);
+  EXPECT_EQ(e.requisicoes[(int)frota::OperacaoRTDB::Remocao], 1u);
+  EXPECT_EQ(e.latenciasUs.size(), e.totalRequisicoes());
+  EXPECT_GT(e.bytesRecebidos, 0u);
+  EXPECT_EQ(servidor.estatisticas().gravacoes, 2u);
+}
+
+TEST_F(FrotaTeste, StreamSSERecebeEventosDasEscritas) {
+  frota::ServidorRTDB servidor;
+  ASSERT_TRUE(servidor.iniciar());
+  frota::ClienteRTDBHTTP cliente("127.0.0.1", servidor.porta());
+
+  std::string erro;
+  auto fluxo = cliente.observar("/devices/z", erro);
+  ASSERT_TRUE(fluxo) << erro;
+  EventoRTDB evento;
+  ASSERT_TRUE(fluxo->proximo(evento, 2000));
+  EXPECT_EQ(evento.tipo, "put");
+  EXPECT_TRUE(evento.dados.nulo());
+
+  ASSERT_TRUE(cliente.gravar("/devices/z/medicoes", json(R"({"estado":"solicitada"})"), erro));
+  ASSERT_TRUE(fluxo->proximo(evento, 2000));
+  EXPECT_EQ(evento.caminho, "/medicoes");
+  EXPECT_EQ(evento.dados.buscar("estado")->comoTexto(), "solicitada");
+  EXPECT_EQ(cliente.estatisticas().eventos, 2u);
+}
+
+TEST_F(FrotaTeste, HasRemoteChangesSoComEventosDoStream) {
+  ConexaoManager conexao;
+  conexao.begin();
+  EXPECT_TRUE(conexao.hasRemoteChanges());  // Sem stream: sempre lê
+
+  ASSERT_TRUE(conexao.beginCommandStream());
+  EXPECT_TRUE(conexao.hasRemoteChanges());  // Valor inicial
+  EXPECT_FALSE(conexao.hasRemoteChanges());
+
+  std::string erro;
+  std::string caminho = std::string("/devices/") + conexao.deviceId.c_str() + "/entrada";
+  ASSERT_TRUE(simulacao::rtdbMemoria().gravar(caminho, json(R"({"estado":"solicitada"})"), erro));
+  EXPECT_TRUE(conexao.hasRemoteChanges());
+  EXPECT_FALSE(conexao.hasRemoteChanges());
+}
+
+TEST_F(FrotaTeste, FrotaPequenaAtendeComandosNosDoisModos) {
+  for (bool stream : {false, true}) {
+    frota::ServidorRTDB servidor;
+    ASSERT_TRUE(servidor.iniciar());
+    frota::ClienteRTDBHTTP sacos("127.0.0.1", servidor.porta());
+    frota::ClienteRTDBHTTP app("127.0.0.1", servidor.porta());
+
+    frota::ConfiguracaoFrota configuracao;
+    configuracao.dispositivos = 2;
+    configuracao.duracaoS = 2.5;
+    configuracao.hz = 10;
+    configuracao.stream = stream;
+    configuracao.comandosPorMinuto = 60;
+    configuracao.duracaoMedicaoMs = 100;
+    frota::ResultadoFrota r = frota::executarFrota(configuracao, sacos, app, &servidor);
+
+    EXPECT_GE(r.comandosEnviados, 2u) << "stream=" << stream;
+    EXPECT_GE(r.comandosAtendidos, 2u) << "stream=" << stream;
+    EXPECT_EQ(r.latenciaComandoMs.size(), r.comandosAtendidos);
+    EXPECT_GT(r.sacos.totalRequisicoes(), 0u);
+    EXPECT_EQ(r.sacos.erros, 0u);
+    EXPECT_TRUE(r.servidorLocal);
+    EXPECT_GE(r.servidor.conexoesMaximas, 2u);
+    if (stream) {
+      EXPECT_GT(r.sacos.eventos, 0u);
+    }
+  }
+}
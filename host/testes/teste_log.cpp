@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Log.h"
+#include "Simulacao.h"
+
+namespace {
+
+class LogTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+  }
+
+  ServicoLog log;
+};
+
+// Print que guarda o texto
+class Texto : public Print {
+public:
+  std::string conteudo;
+  size_t write(uint8_t c) override {
+    conteudo.push_back((char)c);
+    return 1;
+  }
+};
+
+std::vector<std::string> linhas(const std::string& texto) {
+  std::vector<std::string> resultado;
+  std::istringstream entrada(texto);
+  std::string linha;
+  while (std::getline(entrada, linha)) {
+    resultado.push_back(linha);
+  }
+  return resultado;
+}
+
+}  // namespace
+
+TEST_F(LogTeste, FormataNoDescarregarComoOPrintf) {
+  String erro = "connection refused";
+  delay(1234);
+  ASSERT_TRUE(log.registrar(NivelLog::Erro, ModuloLog::Conexao, false,
+                            "Erro ao acessar LED: %s (%d)", erro, -1));
+  ASSERT_TRUE(log.registrar(NivelLog::Info, ModuloLog::Modos, false,
+                            "Golpe: %s, %.1f g, subida %5.1f ms, eixo %s, %lu%%", "jab", 6.25f, 3.0,
+                            "+X", (unsigned long)42));
+  ASSERT_TRUE(log.registrar(NivelLog::Aviso, ModuloLog::Sensores, false, "Pad %02x: %u", 10, 7u));
+
+  Texto saida;
+  EXPECT_EQ(log.descarregar(saida), 3u);
+  std::vector<std::string> l = linhas(saida.conteudo);
+  ASSERT_EQ(l.size(), 3u);
+  EXPECT_EQ(l[0], "[1.234] ERRO conexao: Erro ao acessar LED: connection refused (-1)");
+  EXPECT_EQ(l[1], "[1.234] modos: Golpe: jab, 6.2 g, subida   3.0 ms, eixo +X, 42%");
+  EXPECT_EQ(l[2], "[1.234] AVISO sensores: Pad 0a: 7");
+  EXPECT_EQ(log.getEscritos(), 3u);
+  EXPECT_EQ(log.descarregar(saida), 0u);
+}
+
+TEST_F(LogTeste, StringsLongasSaoCortadas) {
+  std::string longa(100, 'a');
+  ASSERT_TRUE(log.registrar(NivelLog::Info, ModuloLog::Conexao, false, "[%s] [%s] %d",
+                            longa.c_str(), "b", 5));
+  RegistroLog registro = {};
+  Texto saida;
+  log.descarregar(saida);
+  std::string esperado = "[" + std::string(LOG_TAMANHO_TEXTO - 1, 'a') + "] [] 5";
+  EXPECT_NE(saida.conteudo.find(esperado), std::string::npos) << saida.conteudo;
+
+  // A formatação para no tamanho do destino
+  registro.formato = "%d-%d-%d";
+  registro.numArgumentos = 3;
+  registro.argumentos[0] = 123456;
+  registro.argumentos[1] = 7;
+  registro.argumentos[2] = 8;
+  char curto[6];
+  EXPECT_EQ(ServicoLog::formatar(registro, curto, sizeof(curto)), 5u);
+  EXPECT_STREQ(curto, "12345");
+}
+
+TEST_F(LogTeste, NivelPorModulo) {
+  EXPECT_EQ(log.getNivel(ModuloLog::Sensores), NivelLog::Info);
+  EXPECT_FALSE(log.registrar(NivelLog::Depuracao, ModuloLog::Sensores, false, "LED %d", 1));
+
+  log.definirNivel(ModuloLog::Sensores, NivelLog::Depuracao);
+  log.definirNivel(ModuloLog::Conexao, NivelLog::Desligado);
+  EXPECT_TRUE(log.registrar(NivelLog::Depuracao, ModuloLog::Sensores, false, "LED %d", 2));
+  EXPECT_FALSE(log.registrar(NivelLog::Erro, ModuloLog::Conexao, false, "Erro"));
+  EXPECT_TRUE(log.registrar(NivelLog::Erro, ModuloLog::Modos, false, "Erro"));
+
+  Texto saida;
+  EXPECT_EQ(log.descarregar(saida), 2u);
+  EXPECT_NE(saida.conteudo.find("DEP sensores: LED 2"), std::string::npos);
+  EXPECT_EQ(log.getDescartados(), 0u);
+}
+
+TEST_F(LogTeste, AnelCheioDescartaONovo) {
+  for (int i = 0; i < LOG_CAPACIDADE; i++) {
+    ASSERT_TRUE(log.registrar(NivelLog::Info, ModuloLog::Modos, false, "%d", i));
+  }
+  EXPECT_FALSE(log.registrar(NivelLog::Info, ModuloLog::Modos, false, "%d", -1));
+  EXPECT_EQ(log.getDescartados(), 1u);
+
+  Texto saida;
+  EXPECT_EQ(log.descarregar(saida), (size_t)LOG_CAPACIDADE);
+  std::vector<std::string> l = linhas(saida.conteudo);
+  EXPECT_EQ(l.front(), "[0.000] modos: 0");
+  EXPECT_EQ(l.back(), "[0.000] modos: " + std::to_string(LOG_CAPACIDADE - 1));
+
+  // Depois de lido o anel volta a aceitar, dando a volta nos índices
+  for (int volta = 0; volta < 3; volta++) {
+    for (int i = 0; i < LOG_CAPACIDADE; i++) {
+      ASSERT_TRUE(log.registrar(NivelLog::Info, ModuloLog::Modos, false, "%d", i));
+    }
+    EXPECT_EQ(log.descarregar(saida), (size_t)LOG_CAPACIDADE);
+  }
+}
+
+TEST_F(LogTeste, VariosProdutoresSemPerdaNemDuplicata) {
+  const int PRODUTORES = 4;
+  const int POR_PRODUTOR = 2000;
+  std::atomic<bool> fim(false);
+  Texto saida;
+  std::thread consumidor([&] {
+    while (!fim) {
+      log.descarregar(saida);
+    }
+    log.descarregar(saida);
+  });
+
+  std::vector<std::thread> produtores;
+  std::atomic<uint32_t> aceitos(0);
+  for (int p = 0; p < PRODUTORES; p++) {
+    produtores.emplace_back([&, p] {
+      for (int i = 0; i < POR_PRODUTOR; i++) {
+        while (!log.registrar(NivelLog::Info, ModuloLog::Sensores, false, "%d %d", p, i)) {
+          std::this_thread::yield();  // Anel cheio: espera o consumidor
+        }
+        aceitos++;
+      }
+    });
+  }
+  for (auto& t : produtores) {
+    t.join();
+  }
+  fim = true;
+  consumidor.join();
+
+  EXPECT_EQ(aceitos.load(), (uint32_t)(PRODUTORES * POR_PRODUTOR));
+  EXPECT_EQ(log.getEscritos(), (uint32_t)(PRODUTORES * POR_PRODUTOR));
+
+  // Cada produtor aparece em ordem, sem buracos
+  int proximo[PRODUTORES] = {0};
+  for (const std::string& linha : linhas(saida.conteudo)) {
+    int p, i;
+    ASSERT_EQ(sscanf(linha.c_str(), "[%*u.%*u] sensores: %d %d", &p, &i), 2) << linha;
+    ASSERT_GE(p, 0);
+    ASSERT_LT(p, PRODUTORES);
+    EXPECT_EQ(i, proximo[p]) << "produtor " << p;
+    proximo[p] = i + 1;
+  }
+  for (int p = 0; p < PRODUTORES; p++) {
+    EXPECT_EQ(proximo[p], POR_PRODUTOR);
+  }
+}
@@ -0,0 +1,333 @@
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bancada.h"
+#include "Json.h"
+#include "Medicao.h"
+
+using simulacao::Json;
+
+namespace {
+
+// Cópia do tamanho exato, sem '\0' no fim: uma leitura além do fim aparece
+// no ASan (-DSACO_ASAN=ON)
+bool decodificar(const std::string& texto, Medicao& medicao) {
+  std::vector<char> buffer(texto.begin(), texto.end());
+  return decodificarMedicao(buffer.data(), buffer.size(), medicao);
+}
+
+::testing::AssertionResult iguais(const Medicao& a, const Medicao& b) {
+  if (a.estado == b.estado && a.tipo == b.tipo && a.parar == b.parar &&
+      strcmp(a.usuario, b.usuario) == 0 && a.timestampSolicitacao == b.timestampSolicitacao &&
+      a.destino == b.destino && a.duracao == b.duracao && a.descanso == b.descanso &&
+      a.rounds == b.rounds && a.versao == b.versao) {
+    return ::testing::AssertionSuccess();
+  }
+  auto descrever = [](const Medicao& m) {
+    return "estado=" + std::to_string((int)m.estado) + " tipo=" + std::to_string((int)m.tipo) +
+           " parar=" + std::to_string(m.parar) + " usuario='" + m.usuario +
+           "' ts=" + std::to_string(m.timestampSolicitacao) +
+           " destino=" + std::to_string((int)m.destino) + " duracao=" + std::to_string(m.duracao) +
+           " descanso=" + std::to_string(m.descanso) + " rounds=" + std::to_string(m.rounds) +
+           " versao=" + std::to_string(m.versao);
+  };
+  return ::testing::AssertionFailure() << descrever(a) << " != " << descrever(b);
+}
+
+// Documentos aleatórios com a cara do nó de medições: os campos do comando
+// com valores (e tipos) sorteados no meio do que sobra das medições
+class GeradorMedicoes {
+public:
+  explicit GeradorMedicoes(uint32_t semente) : sorteio(semente) {}
+
+  Json documento() {
+    Json raiz = Json::objeto();
+    static const char* campos[] = {"estado", "tipo", "usuario", "comando", "destino",
+                                   "timestampSolicitacao", "duracao", "descanso", "rounds",
+                                   "versao"};
+    for (const char* campo : campos) {
+      if (sorteio() % 4 != 0) raiz.membros()[campo] = valorCampo(campo);
+    }
+    static const char* outros[] = {"resultado", "metricas", "progresso", "sensoresCalibrados",
+                                   "circuito", "valor", "toque", "ledIndex", "Estado", "tipo2"};
+    for (const char* outro : outros) {
+      if (sorteio() % 2) raiz.membros()[outro] = valor(4);
+    }
+    return raiz;
+  }
+
+  // Espaços em branco em volta da pontuação, fora dos textos
+  std::string espacar(const std::string& compacto) {
+    static const char brancos[] = {' ', '\t', '\n', '\r'};
+    std::string saida;
+    bool emTexto = false, escape = false;
+    for (char c : compacto) {
+      bool pontuacao = !emTexto && strchr("{}[]:,", c) != nullptr;
+      if (pontuacao && sorteio() % 2 == 0) saida += brancos[sorteio() % 4];
+      saida += c;
+      if (pontuacao && sorteio() % 2 == 0) saida += brancos[sorteio() % 4];
+      if (escape) {
+        escape = false;
+      } else if (c == '\\') {
+        escape = true;
+      } else if (c == '"') {
+        emTexto = !emTexto;
+      }
+    }
+    return saida;
+  }
+
+  std::mt19937& aleatorio() { return sorteio; }
+
+private:
+  std::mt19937 sorteio;
+
+  std::string texto() {
+    static const char* nomes[] = {"solicitada", "executando", "concluida", "forca", "precisao",
+                                  "tempo_reacao", "tCalibrar", "gravacao", "round", "circuito",
+                                  "parar", "flash", "serial", "", "Forca", "forca ",
+                                  "a\"b\\c/d\ne\tf", "acentuação ✓", "\x01\x1f"};
+    uint32_t escolha = sorteio() % 4;
+    if (escolha < 2) return nomes[sorteio() % (sizeof(nomes) / sizeof(nomes[0]))];
+    // Uids: 28 caracteres, às vezes maiores que o vetor da Medicao
+    size_t tamanho = escolha == 2 ? 28 : sorteio() % 100;
+    std::string uid;
+    for (size_t i = 0; i < tamanho; i++) uid += (char)('0' + sorteio() % 75);
+    return uid;
+  }
+
+  Json valorCampo(const std::string& campo) {
+    bool numerico = campo == "timestampSolicitacao" || campo == "duracao" || campo == "descanso" ||
+                    campo == "rounds" || campo == "versao";
+    // Na maior parte das vezes o tipo certo
+    if (sorteio() % 5 != 0) {
+      if (!numerico) return Json(texto());
+      long long minimo = campo == "timestampSolicitacao" ? 0 : INT_MIN;
+      std::uniform_int_distribution<long long> faixa(minimo, INT_MAX);
+      return Json(sorteio() % 2 ? faixa(sorteio) : (long long)(sorteio() % 200));
+    }
+    Json outro = valor(3);
+    // Um timestamp negativo virava um unsigned enorme; agora fica em 0
+    if (campo == "timestampSolicitacao" && outro.tipo() == Json::Tipo::Inteiro &&
+        outro.comoInteiro() < 0) {
+      return Json(-outro.comoInteiro());
+    }
+    return outro;
+  }
+
+  Json valor(int profundidade) {
+    switch (sorteio() % (profundidade > 0 ? 8 : 5)) {
+      case 0: return Json();
+      case 1: return Json(sorteio() % 2 == 0);
+      case 2: return Json((long long)(int32_t)sorteio());
+      case 3: return Json((double)(int32_t)sorteio() / 1000.0);
+      case 4: return Json(texto());
+      case 5: {
+        Json vetor = Json::vetor();
+        for (uint32_t i = sorteio() % 4; i > 0; i--) vetor.itens().push_back(valor(profundidade - 1));
+        return vetor;
+      }
+      default: {
+        Json objeto = Json::objeto();
+        for (uint32_t i = sorteio() % 4; i > 0; i--) {
+          objeto.membros()[texto()] = valor(profundidade - 1);
+        }
+        return objeto;
+      }
+    }
+  }
+};
+
+}  // namespace
+
+TEST(Medicao, DecodificaOComandoNoMeioDoQueSobrou) {
+  Medicao medicao;
+  ASSERT_TRUE(decodificar(Bancada::respostaMedicoes(), medicao));
+  EXPECT_EQ(medicao.estado, EstadoMedicao::Solicitada);
+  EXPECT_EQ(medicao.tipo, TipoMedicao::Round);
+  EXPECT_STREQ(medicao.usuario, "Xo3kq9TzVbQeW1mRf7LpA2sYd4Hn");
+  EXPECT_EQ(medicao.timestampSolicitacao, 1718822400u);
+  EXPECT_EQ(medicao.duracao, 120);
+  EXPECT_EQ(medicao.descanso, 30);
+  EXPECT_EQ(medicao.rounds, 0);
+  EXPECT_FALSE(medicao.parar);
+
+  // O mesmo que a leitura pelo FirebaseJson
+  Medicao antes;
+  ASSERT_TRUE(Bancada::decodificarFirebaseJson(Bancada::respostaMedicoes(), antes));
+  EXPECT_TRUE(iguais(medicao, antes));
+
+  // Sozinho na caixa de entrada do esquema 2, o mesmo comando
+  Medicao entrada;
+  ASSERT_TRUE(decodificar(Bancada::respostaEntrada(), entrada));
+  EXPECT_EQ(entrada.versao, 2);
+  entrada.versao = 0;
+  EXPECT_TRUE(iguais(medicao, entrada));
+}
+
+TEST(Medicao, CamposConhecidosViramEnums) {
+  Medicao medicao;
+  ASSERT_TRUE(decodificar(
+      R"({ "tipo" : "gravacao", "estado":"executando", "destino":"flash", "comando":"parar",)"
+      R"( "usuario":"u\u00e9\ud83e\udd4a\/1", "rounds":3, "versao":2 })",
+      medicao));
+  EXPECT_EQ(medicao.tipo, TipoMedicao::Gravacao);
+  EXPECT_EQ(medicao.estado, EstadoMedicao::Executando);
+  EXPECT_EQ(medicao.destino, DestinoTraco::Flash);
+  EXPECT_TRUE(medicao.parar);
+  EXPECT_STREQ(medicao.usuario, "u\xc3\xa9\xf0\x9f\xa5\x8a/1");
+  EXPECT_EQ(medicao.rounds, 3);
+  EXPECT_EQ(medicao.versao, 2);
+  EXPECT_STREQ(nomeTipoMedicao(medicao.tipo), "gravacao");
+
+  ASSERT_TRUE(decodificar(R"({"tipo":"boxe","estado":"pausada","comando":"seguir"})", medicao));
+  EXPECT_EQ(medicao.tipo, TipoMedicao::Desconhecido);
+  EXPECT_EQ(medicao.estado, EstadoMedicao::Desconhecido);
+  EXPECT_FALSE(medicao.parar);
+  EXPECT_STREQ(nomeTipoMedicao(medicao.tipo), "?");
+
+  ASSERT_TRUE(decodificar("{}", medicao));
+  EXPECT_TRUE(iguais(medicao, Medicao()));
+}
+
+TEST(Medicao, TipoErradoOuForaDaFaixaFicaNoPadrao) {
+  Medicao medicao;
+  ASSERT_TRUE(decodificar(R"({"estado":1,"tipo":{"nome":"forca"},"usuario":["u1"],)"
+                          R"("duracao":"30","descanso":2.5,"rounds":1e1,)"
+                          R"("timestampSolicitacao":-5})",
+                          medicao));
+  EXPECT_TRUE(iguais(medicao, Medicao()));
+
+  ASSERT_TRUE(decodificar(R"({"duracao":2147483648,"descanso":-2147483648,)"
+                          R"("rounds":99999999999999999999999,"timestampSolicitacao":0})",
+                          medicao));
+  EXPECT_EQ(medicao.duracao, 0);
+  EXPECT_EQ(medicao.descanso, INT_MIN);
+  EXPECT_EQ(medicao.rounds, 0);
+}
+
+TEST(Medicao, UsuarioQueNaoCabeOuComNuloFicaVazio) {
+  Medicao medicao;
+  std::string cabe(MEDICAO_TAMANHO_USUARIO - 1, 'a');
+  ASSERT_TRUE(decodificar("{\"usuario\":\"" + cabe + "\"}", medicao));
+  EXPECT_EQ(medicao.usuario, cabe);
+
+  ASSERT_TRUE(decodificar("{\"usuario\":\"" + cabe + "b\"}", medicao));
+  EXPECT_STREQ(medicao.usuario, "");
+
+  ASSERT_TRUE(decodificar(R"({"usuario":"u1\u0000u2"})", medicao));
+  EXPECT_STREQ(medicao.usuario, "");
+
+  // Só o primeiro nível conta
+  ASSERT_TRUE(decodificar(R"({"resultado":{"usuario":"u2","estado":"solicitada"}})", medicao));
+  EXPECT_STREQ(medicao.usuario, "");
+  EXPECT_EQ(medicao.estado, EstadoMedicao::Nenhum);
+}
+
+TEST(Medicao, RecusaOQueNaoEhUmObjetoJson) {
+  const char* invalidos[] = {
+      "", "null", "\"solicitada\"", "[]", "{", "}", "{\"estado\"}", "{\"estado\":}",
+      "{\"estado\":\"solicitada\",}", "{,}", "{\"a\":1 \"b\":2}", "{\"a\":01}", "{\"a\":1.}",
+      "{\"a\":-}", "{\"a\":1e}", "{\"a\":tru}", "{\"a\":nul}", "{\"a\":[1,]}", "{\"a\":[1}",
+      "{\"a\":{\"b\"}}", "{\"a\":{\"b\":1,}}", "{\"a\":\"\\x\"}", "{\"a\":\"\\u12g4\"}",
+      "{\"a\":\"\\ud83e\"}", "{\"a\":\"\\udd4a\"}", "{\"a\":\"\n\"}", "{'a':1}", "{a:1}",
+      "{\"a\":1} {}", "{\"a\":1}x", "{\"estado\":\"solicitada\"",
+  };
+  for (const char* texto : invalidos) {
+    Medicao medicao;
+    EXPECT_FALSE(decodificar(texto, medicao)) << texto;
+    EXPECT_TRUE(iguais(medicao, Medicao())) << texto;
+  }
+
+  // Todo prefixo de um documento válido é inválido
+  std::string completo = Bancada::respostaMedicoes();
+  for (size_t n = 0; n < completo.size(); n++) {
+    Medicao medicao;
+    ASSERT_FALSE(decodificar(completo.substr(0, n), medicao)) << n;
+  }
+}
+
+TEST(Medicao, AninhamentoTemLimiteENaoUsaAPilha) {
+  auto aninhado = [](int niveis) {
+    std::string texto = "{\"resultado\":";
+    for (int i = 0; i < niveis; i++) texto += i % 2 ? "[" : "{\"a\":";
+    texto += "1";
+    for (int i = niveis - 1; i >= 0; i--) texto += i % 2 ? "]" : "}";
+    return texto + ",\"estado\":\"solicitada\"}";
+  };
+  Medicao medicao;
+  ASSERT_TRUE(decodificar(aninhado(MEDICAO_PROFUNDIDADE_MAXIMA), medicao));
+  EXPECT_EQ(medicao.estado, EstadoMedicao::Solicitada);
+  EXPECT_FALSE(decodificar(aninhado(MEDICAO_PROFUNDIDADE_MAXIMA + 1), medicao));
+
+  // Um milhão de '[' não estoura nada
+  EXPECT_FALSE(decodificar("{\"a\":" + std::string(1000000, '['), medicao));
+}
+
+// Fuzz diferencial: documentos válidos sorteados, com espaços sorteados,
+// dão o mesmo que a leitura pelo FirebaseJson
+TEST(Medicao, FuzzIgualAoFirebaseJson) {
+  GeradorMedicoes gerador(2024);
+  for (int i = 0; i < 3000; i++) {
+    std::string texto = gerador.espacar(gerador.documento().serializar());
+    Medicao nova, antes;
+    ASSERT_TRUE(Bancada::decodificarFirebaseJson(texto.c_str(), antes)) << texto;
+    ASSERT_TRUE(decodificar(texto, nova)) << texto;
+    ASSERT_TRUE(iguais(nova, antes)) << texto;
+  }
+}
+
+// Fuzz por mutação: bytes trocados, inseridos, apagados e cortes sobre
+// documentos válidos. Nunca lê fora do buffer (ver o ASan acima) e, quando
+// aceita, o documento também é JSON para o leitor do shim
+TEST(Medicao, FuzzMutacoesNuncaSaemDoBuffer) {
+  static const char alfabeto[] = "{}[]\":,\\ -+.0123456789eEtrufalsn\x01\xff";
+  GeradorMedicoes gerador(77);
+  std::mt19937& sorteio = gerador.aleatorio();
+  int aceitos = 0;
+  for (int i = 0; i < 20000; i++) {
+    std::string texto = gerador.espacar(gerador.documento().serializar());
+    for (uint32_t m = 1 + sorteio() % 3; m > 0 && !texto.empty(); m--) {
+      size_t posicao = sorteio() % texto.size();
+      switch (sorteio() % 4) {
+        case 0: texto[posicao] = alfabeto[sorteio() % (sizeof(alfabeto) - 1)]; break;
+        case 1: texto.insert(texto.begin() + posicao, alfabeto[sorteio() % (sizeof(alfabeto) - 1)]); break;
+        case 2: texto.erase(posicao, 1 + sorteio() % 8); break;
+        default: texto.resize(posicao); break;
+      }
+    }
+    Medicao nova;
+    if (!decodificar(texto, nova)) {
+      ASSERT_TRUE(iguais(nova, Medicao())) << texto;
+      continue;
+    }
+    aceitos++;
+    Json referencia;
+    ASSERT_TRUE(Json::interpretar(texto, referencia)) << texto;
+    // Os números mutados (1e0, 99999999999, -0) o shim tipa diferente do
+    // FirebaseJson do saco; os textos têm que dar o mesmo
+    Medicao antes;
+    ASSERT_TRUE(Bancada::decodificarFirebaseJson(texto.c_str(), antes)) << texto;
+    ASSERT_EQ(nova.estado, antes.estado) << texto;
+    ASSERT_EQ(nova.tipo, antes.tipo) << texto;
+    ASSERT_STREQ(nova.usuario, antes.usuario) << texto;
+    ASSERT_EQ(nova.parar, antes.parar) << texto;
+    ASSERT_EQ(nova.destino, antes.destino) << texto;
+  }
+  // Algumas mutações caem em textos e continuam válidas
+  EXPECT_GT(aceitos, 100);
+
+  // E bytes quaisquer
+  for (int i = 0; i < 20000; i++) {
+    std::string texto(sorteio() % 48, '\0');
+    for (char& c : texto) c = alfabeto[sorteio() % (sizeof(alfabeto) - 1)];
+    if (i % 2) texto.insert(0, "{\"a\":");
+    Medicao medicao;
+    decodificar(texto, medicao);
+  }
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Captura.h"
+#include "Metricas.h"
+
+namespace {
+
+xyzFloat vetor(float x, float y, float z) {
+  xyzFloat v;
+  v.x = x;
+  v.y = y;
+  v.z = z;
+  return v;
+}
+
+// 100 ms de repouso (gravidade em `g`) e um meio-seno de `intensidade` g
+// e 20 ms na direção `direcao`, amostrado a 1 kHz
+void capturar(CapturaGolpe& captura, xyzFloat g, xyzFloat direcao, float intensidade) {
+  captura.configurar(100, 100, 1.0f);
+  xyzFloat giro = vetor(0, 0, 0);
+  for (uint32_t ms = 0; ms < 1000 && captura.getFase() != FaseCaptura::Completa; ms++) {
+    float golpe = 0;
+    if (ms >= 200 && ms < 220) {
+      golpe = intensidade * sinf(M_PI * (ms - 200) / 20.0f);
+      giro = vetor(0, 0, 400);
+    } else {
+      giro = vetor(0, 0, 0);
+    }
+    captura.adicionar(ms * 1000, vetor(g.x + direcao.x * golpe, g.y + direcao.y * golpe,
+                                       g.z + direcao.z * golpe), giro);
+  }
+  ASSERT_EQ(captura.getFase(), FaseCaptura::Completa);
+}
+
+}  // namespace
+
+TEST(MetricasTeste, GolpeFrontalEmMeioSeno) {
+  CapturaGolpe captura;
+  capturar(captura, vetor(0, 0, 1), vetor(1, 0, 0), 8.0f);
+  MetricasGolpe m = calcularMetricas(captura);
+
+  ASSERT_TRUE(m.valido);
+  EXPECT_NEAR(m.picoG, 8.0f, 0.05f);
+  // ∫ 8·sen(πt/20ms) dt = 2·8·0,02/π g·s, menos o ruído descontado
+  EXPECT_NEAR(m.impulsoGs, 2 * 8 * 0.02 / M_PI, 0.006);
+  EXPECT_NEAR(m.subidaMs, 9.0f, 1.01f);
+  EXPECT_NEAR(m.jerkGs, 8 * M_PI / 0.02, 0.05 * 8 * M_PI / 0.02);
+  EXPECT_STREQ(m.eixo, "+X");
+  EXPECT_NEAR(m.direcaoX, 1.0f, 1e-3f);
+  EXPECT_NEAR(m.azimuteGraus, 0.0f, 0.1f);
+  EXPECT_NEAR(m.giroDps, 400.0f, 1e-3f);
+  EXPECT_EQ(m.fatorNewtons, 0.0f);
+  EXPECT_EQ(m.forcaN, 0.0f);
+}
+
+TEST(MetricasTeste, RepousoInclinadoNaoViraDirecao) {
+  // Saco inclinado 30 graus: a gravidade aparece em Y e Z
+  CapturaGolpe captura;
+  capturar(captura, vetor(0, 0.5f, 0.866f), vetor(0, -1, 0), 5.0f);
+  MetricasGolpe m = calcularMetricas(captura);
+
+  EXPECT_NEAR(m.picoG, 5.0f, 0.05f);
+  EXPECT_STREQ(m.eixo, "-Y");
+  EXPECT_NEAR(m.azimuteGraus, -90.0f, 0.5f);
+  EXPECT_NEAR(m.direcaoZ, 0.0f, 0.01f);
+}
+
+TEST(MetricasTeste, FatorDoSacoConverteParaNewtons) {
+  CapturaGolpe captura;
+  capturar(captura, vetor(0, 0, 1), vetor(0.6f, 0.8f, 0), 10.0f);
+  MetricasGolpe m = calcularMetricas(captura, 45.0f);
+
+  EXPECT_NEAR(m.azimuteGraus, atan2f(0.8f, 0.6f) * 180 / M_PI, 0.5f);
+  EXPECT_STREQ(m.eixo, "+Y");
+  EXPECT_FLOAT_EQ(m.fatorNewtons, 45.0f);
+  EXPECT_FLOAT_EQ(m.forcaN, m.picoG * 45.0f);
+  EXPECT_FLOAT_EQ(m.impulsoNs, m.impulsoGs * 45.0f);
+}
+
+TEST(MetricasTeste, InicioAntesDoGatilhoContaNaSubidaENoImpulso) {
+  // Rampa de 0,1 g/ms em X a partir de 200 ms até 4 g em 240 ms. Passa do
+  // ruído em 203 ms e só dispara o gatilho (1,5 g) em 216 ms
+  CapturaGolpe captura;
+  captura.configurar(100, 100, 1.0f);
+  xyzFloat giro = vetor(0, 0, 0);
+  for (uint32_t ms = 0; ms < 1000 && captura.getFase() != FaseCaptura::Completa; ms++) {
+    float golpe = (ms >= 200 && ms <= 240) ? 0.1f * (ms - 200) : 0;
+    captura.adicionar(ms * 1000, vetor(golpe, 0, 1), giro);
+  }
+  ASSERT_EQ(captura.getFase(), FaseCaptura::Completa);
+  ASSERT_GT(captura.amostra(captura.getIndiceGatilho()).tempoUs, 210000u);
+
+  MetricasGolpe m = calcularMetricas(captura);
+  ASSERT_TRUE(m.valido);
+  // O repouso não leva a rampa: o pico é 4 g e só em X
+  EXPECT_NEAR(m.picoG, 4.0f, 0.01f);
+  EXPECT_NEAR(m.direcaoZ, 0.0f, 1e-3f);
+  EXPECT_NEAR(m.subidaMs, 37.0f, 0.01f);
+  // Σ (0,1·k - 0,2)·1 ms de k = 3 a 40
+  EXPECT_NEAR(m.impulsoGs, (0.1 * 817 - 0.2 * 38) / 1000, 5e-4);
+}
+
+TEST(MetricasTeste, RuidoNoPreGatilhoNaoEhOInicio) {
+  AnalisadorGolpe analisador;
+  AmostraGolpe amostra = {0, 0, 0, 1, 0, 0, 0};
+  for (uint32_t i = 0; i < 60; i++) {
+    amostra.tempoUs = i * 1000;
+    // Um pico isolado no pré-gatilho e o golpe de 3 g depois do gatilho
+    amostra.ax = (i == 30) ? 0.5f : (i >= 52 && i < 55) ? 3.0f : 0;
+    analisador.adicionar(amostra, i >= 50);
+  }
+  MetricasGolpe m = analisador.resultado();
+  ASSERT_TRUE(m.valido);
+  EXPECT_NEAR(m.picoG, 3.0f, 1e-3f);
+  EXPECT_NEAR(m.subidaMs, 0.0f, 1e-3f);
+  EXPECT_NEAR(m.impulsoGs, 3 * 2.8 / 1000, 1e-4);
+}
+
+TEST(MetricasTeste, JanelaSemGolpeNaoEhValida) {
+  AnalisadorGolpe analisador;
+  AmostraGolpe repouso = {0, 0, 0, 1, 0, 0, 0};
+  for (uint32_t i = 0; i < 50; i++) {
+    repouso.tempoUs = i * 1000;
+    analisador.adicionar(repouso, i >= 25);
+  }
+  MetricasGolpe m = analisador.resultado();
+  EXPECT_FALSE(m.valido);
+  EXPECT_EQ(m.picoG, 0.0f);
+  EXPECT_STREQ(m.eixo, "--");
+}
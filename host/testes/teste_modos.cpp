@@ -0,0 +1,602 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+
+#include "DeteccaoToque.h"
+#include "Energia.h"
+#include "GeradorDelta.h"
+#include "ImagensOta.h"
+#include "LittleFS.h"
+#include "ModosTeste.h"
+#include "Ota.h"
+#include "PainelSSD1306.h"
+#include "ReproducaoTraco.h"
+#include "Sensores.h"
+#include "ServidorOta.h"
+
+namespace {
+
+// Liga sem WiFi
+class BootSemRedeTeste : public ModosTeste {
+protected:
+  void antesDoSetup() override {
+    simulacao::definirWiFiConectado(false);
+  }
+};
+
+// A 1.0.0 gravada pela serial e o servidor local com a 1.1.0
+class AtualizacaoOtaTeste : public ModosTeste {
+protected:
+  std::vector<uint8_t> v1 = imagens_ota::imagemFirmware("1.0.0");
+  std::vector<uint8_t> v2 = imagens_ota::versaoSeguinte(v1, "1.1.0");
+  std::vector<uint8_t> delta = ota::gerarDelta(v1, v2);
+  ota::ServidorOta servidor;
+
+  void antesDoSetup() override {
+    simulacao::gravarFirmwareOta(v1.data(), v1.size());
+    servidor.publicar("/manifesto.txt", "versao 1.1.0\ncompleta saco-1.1.0.sdl\n"
+                                        "delta 1.0.0 saco-1.0.0-1.1.0.sdl\n");
+    servidor.publicar("/saco-1.0.0-1.1.0.sdl", delta);
+    servidor.publicar("/saco-1.1.0.sdl", ota::gerarDelta({}, v2));
+    ASSERT_TRUE(servidor.iniciar());
+  }
+
+  void publicarUrl() {
+    simulacao::Json url;
+    ASSERT_TRUE(simulacao::Json::interpretar("\"" + servidor.url() + "\"", url));
+    std::string erro;
+    ASSERT_TRUE(simulacao::rtdbMemoria().gravar("/ota/url", url, erro));
+  }
+
+  // Em tempo de firmware
+  bool aguardarReinicio(uint32_t limiteMs) {
+    unsigned long inicio = millis();
+    while (!simulacao::reinicioPedido() && millis() - inicio < limiteMs) {
+      delay(50);
+    }
+    return simulacao::reinicioPedido();
+  }
+};
+
+}  // namespace
+
+TEST_F(ModosTeste, ComandoDeForcaExecutaEConclui) {
+  // Golpes de 6 g a cada 250 ms
+  simulacao::definirFonteIMU([](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if ((agora / 1000) % 250 < 20) {
+      amostra.ax = 6.0f;
+    }
+    return amostra;
+  });
+
+  gravar("/estado", R"("ocupado")");
+  gravar("/config/fatorNewtons", "50");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"forca","usuario":"u1","timestampSolicitacao":1})");
+
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  const simulacao::Json* valor = raiz.buscar(caminho("/saida/valor"));
+  ASSERT_NE(valor, nullptr);
+  EXPECT_GT(valor->comoReal(), 0.0);
+
+  // Métricas do golpe ao lado do valor
+  const simulacao::Json* pico = raiz.buscar(caminho("/saida/metricas/picoG"));
+  ASSERT_NE(pico, nullptr);
+  EXPECT_NEAR(pico->comoReal(), 6.0, 0.5);
+  const simulacao::Json* eixo = raiz.buscar(caminho("/saida/metricas/eixo"));
+  ASSERT_NE(eixo, nullptr);
+  EXPECT_EQ(eixo->comoTexto(), "+X");
+  EXPECT_EQ(raiz.buscar(caminho("/saida/metricas/tipo")), nullptr);
+  const simulacao::Json* newtons = raiz.buscar(caminho("/saida/metricas/forcaN"));
+  ASSERT_NE(newtons, nullptr);
+  EXPECT_NEAR(newtons->comoReal(), 50 * pico->comoReal(), 0.01);
+
+  // Depois do resultado o saco volta ao estado inicial
+  unsigned long inicio = millis();
+  while (estado() != Estado::Inicial && millis() - inicio < 5000) {
+    delay(50);
+  }
+  EXPECT_EQ(estado(), Estado::Inicial);
+}
+
+TEST_F(ModosTeste, RoundTrocadoPorOutroComandoNaoConcluiNemVoltaAoInicial) {
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"round","duracao":20,"descanso":1,"rounds":2})");
+  ASSERT_TRUE(aguardarEstado(Estado::Round, 5000));
+
+  // Um pedido de força no meio do round; sem golpe ela espera CAPTURA_ESPERA_MS
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"forca","usuario":"u1","timestampSolicitacao":2})");
+  ASSERT_TRUE(aguardarEstado(Estado::Forca, 5000));
+  delay(2000);
+  EXPECT_EQ(estado(), Estado::Forca);
+  EXPECT_EQ(ler("/saida/tipo").comoTexto(), "forca");
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "executando");
+  EXPECT_TRUE(ler("/saida/rounds").nulo());
+  EXPECT_TRUE(ler("/saida/valor").nulo());
+}
+
+TEST_F(ModosTeste, FatorDeForcaSobreviveAoReinicio) {
+  // O app grava o fator antes; o registro do boot seguinte não o apaga
+  gravar("/config/fatorNewtons", "50");
+  religar(true);
+  ASSERT_TRUE(boot.aguardar(BOOT_FIREBASE, 5000));
+  EXPECT_EQ(ler("/config/fatorNewtons").comoReal(), 50.0);
+
+  simulacao::definirFonteIMU([](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if ((agora / 1000) % 250 < 20) {
+      amostra.ax = 6.0f;
+    }
+    return amostra;
+  });
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"forca","usuario":"u1","timestampSolicitacao":1})");
+
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  const simulacao::Json* pico = raiz.buscar(caminho("/saida/metricas/picoG"));
+  const simulacao::Json* newtons = raiz.buscar(caminho("/saida/metricas/forcaN"));
+  ASSERT_NE(pico, nullptr);
+  ASSERT_NE(newtons, nullptr);
+  EXPECT_NEAR(newtons->comoReal(), 50 * pico->comoReal(), 0.01);
+}
+
+TEST_F(ModosTeste, RoundContaTodosOsGolpesEEnviaUmRegistroPorRound) {
+  // Golpes de 5 g a cada 200 ms, sem parar nem no descanso. Mais longos
+  // que os reais (50 ms) para o escalonamento do host não pular nenhum;
+  // a contagem exata a 1 kHz está em teste_round.cpp
+  // O laço do round dá uma volta por ms: a 20x são 50 us reais, e uma pausa
+  // do escalonador do host engole golpes inteiros (ver o prazo "round")
+  simulacao::definirRelogio(simulacao::ModoRelogio::Real, ESCALA / 4);
+  simulacao::definirFonteIMU([](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if ((agora / 1000) % 200 < 50) {
+      amostra.ax = 5.0f;
+    }
+    return amostra;
+  });
+
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"round","duracao":2,"descanso":1,"rounds":2})");
+
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 30000));
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  double total = 0;
+  for (const char* numero : {"1", "2"}) {
+    std::string round = std::string("/saida/rounds/") + numero;
+    const simulacao::Json* golpes = raiz.buscar(caminho(round + "/golpes"));
+    ASSERT_NE(golpes, nullptr) << round;
+    // 2 s a 5 golpes por segundo; o primeiro ou o último podem ficar na borda
+    EXPECT_NEAR(golpes->comoReal(), 10, 1) << round;
+    total += golpes->comoReal();
+
+    const simulacao::Json* segundos = raiz.buscar(caminho(round + "/segundos/golpes"));
+    ASSERT_NE(segundos, nullptr);
+    EXPECT_EQ(segundos->itens().size(), 2u);
+    const simulacao::Json* pico = raiz.buscar(caminho(round + "/picoG"));
+    ASSERT_NE(pico, nullptr);
+    EXPECT_NEAR(pico->comoReal(), std::sqrt(26.0) - 1, 0.2);
+
+    // O modelo embarcado é sintético: a contagem por tipo não é publicada
+    EXPECT_EQ(raiz.buscar(caminho(round + "/tipos")), nullptr) << round;
+  }
+  EXPECT_EQ(raiz.buscar(caminho("/saida/rounds/3")), nullptr);
+
+  const simulacao::Json* valor = raiz.buscar(caminho("/saida/valor"));
+  ASSERT_NE(valor, nullptr);
+  EXPECT_EQ(valor->comoReal(), total);
+}
+
+TEST_F(ModosTeste, AgilidadeMedeTempoDeReacao) {
+  gravar("/estado", R"("ocupado")");
+  uint32_t estimulos = servicoDisplay.getEstimulos();
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"tempo_reacao","usuario":"u1"})");
+
+  // Pads em repouso até o "Ataque" chegar ao painel (espera aleatória de 2
+  // a 7 s); a tapa no Centro (T3) vem 200 ms depois, subindo em 40 ms até
+  // 30000. O instante exato da borda e do cruzamento depende de quando o
+  // host agenda as amostras, e é verificado com tempos exatos em
+  // teste_deteccao_toque.cpp
+  ASSERT_TRUE(aguardarEstimulo(estimulos, 10000));
+  uint64_t tapaUs = simulacao::agoraUs() + 200000;
+  simulacao::definirFonteToque([tapaUs](uint8_t pino, uint64_t tempoUs) -> uint16_t {
+    if (pino != T3 || tempoUs < tapaUs) {
+      return 0;
+    }
+    uint64_t fase = tempoUs - tapaUs;
+    return fase < 40000 ? (uint16_t)(30000 * fase / 40000) : 30000;
+  });
+
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  const simulacao::Json* valor = raiz.buscar(caminho("/saida/valor"));
+  ASSERT_NE(valor, nullptr);
+  EXPECT_GT(valor->comoReal(), 0.1);
+  EXPECT_LT(valor->comoReal(), 1.0);
+
+  // A reação vai até a borda, que vem antes do cruzamento do limite
+  const simulacao::Json* inicio = raiz.buscar(caminho("/saida/toque/inicioS"));
+  const simulacao::Json* cruzamento = raiz.buscar(caminho("/saida/toque/cruzamentoS"));
+  ASSERT_NE(inicio, nullptr);
+  ASSERT_NE(cruzamento, nullptr);
+  EXPECT_GT(cruzamento->comoReal(), inicio->comoReal());
+  EXPECT_EQ(valor->comoReal(), inicio->comoReal());
+  EXPECT_EQ(raiz.buscar(caminho("/saida/toque/pad"))->comoInteiro(), 8);  // T3: Centro
+  double reacao = valor->comoReal();
+
+  // O resumo do usuário recebe o mesmo tempo; é gravado depois do "concluida"
+  unsigned long inicioResumo = millis();
+  while (simulacao::rtdbMemoria().instantaneo().buscar("/users/u1/resumo/tempo_reacao") ==
+             nullptr &&
+         millis() - inicioResumo < 5000) {
+    delay(10);
+  }
+  raiz = simulacao::rtdbMemoria().instantaneo();
+  const simulacao::Json* resumo = raiz.buscar("/users/u1/resumo/tempo_reacao");
+  ASSERT_NE(resumo, nullptr);
+  EXPECT_EQ(resumo->buscar("contagem")->comoInteiro(), 1);
+  EXPECT_FLOAT_EQ(resumo->buscar("melhor")->comoReal(), reacao);
+}
+
+TEST_F(ModosTeste, AgilidadeRearmaNaLargadaQueimada) {
+  gravar("/estado", R"("ocupado")");
+  uint32_t estimulos = servicoDisplay.getEstimulos();
+
+  // A espera antes do "Ataque" é random(2000, 7000): com a semente fixa, o
+  // teste sabe de antemão quanto ela dura
+  randomSeed(3);
+  uint64_t esperaUs = random(2000, 7000) * 1000ULL;
+  randomSeed(3);
+
+  // Só a tarefa da agilidade lê os pads, e a primeira leitura abre a espera.
+  // A luva sai 30 ms antes do "Ataque" e cruza o limite 110 ms depois dele:
+  // a borda começa antes do estímulo, o toque só é confirmado depois
+  auto aberturaUs = std::make_shared<std::atomic<uint64_t>>(0);
+  simulacao::definirFonteToque([aberturaUs, esperaUs](uint8_t pino, uint64_t tempoUs) -> uint16_t {
+    uint64_t abertura = 0;
+    aberturaUs->compare_exchange_strong(abertura, tempoUs);
+    uint64_t saidaUs = aberturaUs->load() + esperaUs - 30000;
+    if (pino != T3 || tempoUs < saidaUs || tempoUs - saidaUs > 400000) {
+      return 0;
+    }
+    uint64_t fase = tempoUs - saidaUs;
+    return fase < 210000 ? (uint16_t)(30000 * fase / 210000) : 30000;
+  });
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"tempo_reacao","usuario":"u1"})");
+
+  // Nada publicado: o saco rearma e mostra um novo "Ataque"
+  ASSERT_TRUE(aguardarEstimulo(estimulos, 10000));
+  ASSERT_TRUE(aguardarEstimulo(estimulos + 1, 15000));
+  EXPECT_EQ(estado(), Estado::Agilidade);
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "executando");
+  EXPECT_TRUE(ler("/saida/valor").nulo());
+  EXPECT_EQ(simulacao::rtdbMemoria().instantaneo().buscar("/users/u1/resumo/tempo_reacao"),
+            nullptr);
+
+  // Agora sim, 200 ms depois do segundo "Ataque"
+  uint64_t tapaUs = simulacao::agoraUs() + 200000;
+  simulacao::definirFonteToque([tapaUs](uint8_t pino, uint64_t tempoUs) -> uint16_t {
+    if (pino != T3 || tempoUs < tapaUs) {
+      return 0;
+    }
+    uint64_t fase = tempoUs - tapaUs;
+    return fase < 40000 ? (uint16_t)(30000 * fase / 40000) : 30000;
+  });
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+  const simulacao::Json valor = ler("/saida/valor");
+  EXPECT_GT(valor.comoReal(), 0.1);
+  EXPECT_LT(valor.comoReal(), 1.0);
+}
+
+TEST_F(ModosTeste, PrecisaoRearmaNaLargadaQueimada) {
+  gravar("/estado", R"("ocupado")");
+  uint32_t estimulos = servicoDisplay.getEstimulos();
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"precisao","usuario":"u1","ledIndex":5})");
+  ASSERT_TRUE(aguardarEstimulo(estimulos, 10000));
+
+  // O detector já acompanha o pad 3 em repouso. A luva sai antes de o app
+  // trocar o LED para o 3 e cruza o limite depois de ele acender
+  uint8_t pino = sensores.getPino(2);
+  uint64_t saidaUs = simulacao::agoraUs();
+  simulacao::definirFonteToque([pino, saidaUs](uint8_t p, uint64_t tempoUs) -> uint16_t {
+    if (p != pino || tempoUs < saidaUs || tempoUs - saidaUs > 400000) {
+      return 0;
+    }
+    uint64_t fase = tempoUs - saidaUs;
+    return fase < 210000 ? (uint16_t)(30000 * fase / 210000) : 30000;
+  });
+  gravar("/entrada/ledIndex", "3");
+
+  // Nada publicado: o mesmo LED volta a acender depois do aviso
+  ASSERT_TRUE(aguardarEstimulo(estimulos + 1, 5000));
+  ASSERT_TRUE(aguardarEstimulo(estimulos + 2, 5000));
+  EXPECT_EQ(estado(), Estado::Precisao);
+  EXPECT_TRUE(ler("/saida/resultado").nulo());
+  EXPECT_EQ(simulacao::rtdbMemoria().instantaneo().buscar("/users/u1/resumo/precisao"), nullptr);
+
+  // Agora sim, 200 ms depois do LED
+  uint64_t tapaUs = simulacao::agoraUs() + 200000;
+  simulacao::definirFonteToque([pino, tapaUs](uint8_t p, uint64_t tempoUs) -> uint16_t {
+    if (p != pino || tempoUs < tapaUs) {
+      return 0;
+    }
+    uint64_t fase = tempoUs - tapaUs;
+    return fase < 40000 ? (uint16_t)(30000 * fase / 40000) : 30000;
+  });
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 5000));
+  EXPECT_TRUE(ler("/saida/resultado/acerto").comoBool());
+  long long resposta = ler("/saida/resultado/tempoResposta").comoInteiro();
+  EXPECT_LE(resposta, ler("/saida/resultado/tempoCruzamento").comoInteiro());
+  EXPECT_LT(ler("/saida/resultado/tempoCruzamento").comoInteiro(), 1000);
+}
+
+TEST_F(ModosTeste, CircuitoSozinhoEnviaUmRegistroPorRodada) {
+  // Sem vizinhos no ESP-NOW simulado o saco coordena só a si mesmo
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"circuito","rounds":2,"descanso":1})");
+  // Tapas no pad 5 a cada 300 ms: em cada rodada uma chega dentro da janela
+  uint8_t pino = sensores.getPino(4);
+  simulacao::definirFonteToque([pino](uint8_t p, uint64_t tempoUs) -> uint16_t {
+    return p == pino && tempoUs % 300000 < 100000 ? 30000 : 0;
+  });
+
+  ASSERT_TRUE(aguardarEstado(Estado::Circuito, 5000));
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 30000));
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  for (const char* numero : {"1", "2"}) {
+    std::string rodada = std::string("/saida/circuito/") + numero;
+    const simulacao::Json* sacos = raiz.buscar(caminho(rodada + "/sacos"));
+    ASSERT_NE(sacos, nullptr) << rodada;
+    EXPECT_EQ(sacos->comoInteiro(), 1);
+    const simulacao::Json* resultados = raiz.buscar(caminho(rodada + "/resultados"));
+    ASSERT_NE(resultados, nullptr);
+    ASSERT_EQ(resultados->membros().size(), 1u);
+    const simulacao::Json& saco = resultados->membros().begin()->second;
+    EXPECT_TRUE(saco.membros().at("respondeu").comoBool());
+    EXPECT_EQ(saco.membros().at("padTocado").comoInteiro(), 5);
+    EXPECT_LT(saco.membros().at("reacaoMs").comoReal(), 300.0);
+  }
+  const simulacao::Json* valor = raiz.buscar(caminho("/saida/valor"));
+  ASSERT_NE(valor, nullptr);
+  EXPECT_LT(valor->comoReal(), 0.3);
+  EXPECT_TRUE(aguardarEstado(Estado::Inicial, 2000));
+}
+
+TEST_F(ModosTeste, RastreioMostraATarefaDeModoEOsPrazos) {
+  uint32_t voltasPrecisao = 0;
+  for (int i = 0; i < rastreio.getNumPrazos(); i++) {
+    const PrazoRastreio* prazo = rastreio.getPrazo(i);
+    if (prazo != nullptr && strcmp(prazo->getNome(), "precisao.toque") == 0) {
+      voltasPrecisao = prazo->getVoltas();
+    }
+  }
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"tempo_reacao","usuario":"u1"})");
+  simulacao::definirFonteToque([](uint8_t pino, uint64_t tempoUs) -> uint16_t {
+    return pino == T3 && tempoUs % 300000 < 100000 ? 30000 : 0;
+  });
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+
+  Texto saida;
+  EXPECT_GT(rastreio.exportarChrome(saida), 0u);
+  simulacao::Json raiz;
+  ASSERT_TRUE(simulacao::Json::interpretar(saida.conteudo, raiz));
+
+  // Linhas da tarefa e da CPU dela, e o envio do resultado como trecho
+  std::map<std::string, long long> linhas;
+  bool envio = false;
+  bool cpu = false;
+  for (const simulacao::Json& evento : raiz.buscar("traceEvents")->itens()) {
+    const std::string& nome = evento.buscar("name")->comoTexto();
+    if (nome == "thread_name") {
+      linhas[evento.buscar("args/name")->comoTexto()] = evento.buscar("tid")->comoInteiro();
+    }
+  }
+  ASSERT_TRUE(linhas.count("tarefaAgilidade"));
+  ASSERT_TRUE(linhas.count("tarefaAgilidade (CPU)"));
+  for (const simulacao::Json& evento : raiz.buscar("traceEvents")->itens()) {
+    long long tid = evento.buscar("tid")->comoInteiro();
+    const std::string& nome = evento.buscar("name")->comoTexto();
+    if (tid == linhas["tarefaAgilidade"] && nome == "conexao.setReactionResult") {
+      envio = true;
+    }
+    if (tid == linhas["tarefaAgilidade (CPU)"] && nome == "CPU") {
+      cpu = true;
+    }
+  }
+  EXPECT_TRUE(envio);
+  EXPECT_TRUE(cpu);
+
+  // O detector da agilidade declarou o período dele; o da precisão, se um
+  // teste anterior o usou, não recebeu as voltas da agilidade
+  bool toque = false;
+  for (int i = 0; i < rastreio.getNumPrazos(); i++) {
+    const PrazoRastreio* prazo = rastreio.getPrazo(i);
+    if (prazo != nullptr && strcmp(prazo->getNome(), "agilidade.toque") == 0) {
+      toque = true;
+      EXPECT_GT(prazo->getVoltas(), 0u);
+      EXPECT_EQ(prazo->getPeriodoUs(), (uint32_t)TOQUE_PERIODO_MS * 1000);
+    }
+    if (prazo != nullptr && strcmp(prazo->getNome(), "precisao.toque") == 0) {
+      EXPECT_EQ(prazo->getVoltas(), voltasPrecisao);
+    }
+  }
+  EXPECT_TRUE(toque);
+}
+
+TEST_F(ModosTeste, GravacaoNoFlashProduzTracoLegivel) {
+  char modelo[] = "/tmp/saco_flashXXXXXX";
+  ASSERT_NE(mkdtemp(modelo), nullptr);
+  simulacao::definirDiretorioFlash(modelo);
+
+  simulacao::definirToque(T7, 30000);
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"gravacao","destino":"flash","duracao":1})");
+
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+
+  traco::Traco lido;
+  std::string erro;
+  ASSERT_TRUE(lido.carregar(std::string(modelo) + TRACO_ARQUIVO, erro)) << erro;
+  EXPECT_EQ(lido.cabecalho.numSensores, NUM_SENSORES);
+  EXPECT_GT(lido.imu.size(), 900u);
+  ASSERT_FALSE(lido.toques.empty());
+  EXPECT_EQ(lido.toques.back().valores[lido.indiceDoPino(T7)], 30000);
+  EXPECT_NEAR(lido.imu.back().valor.az, 1.0f, 0.01f);
+}
+
+TEST_F(ModosTeste, GravacaoTrocadaPorOutroComandoNaoConcluiNemVoltaAoInicial) {
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada", R"({"estado":"solicitada","tipo":"gravacao","duracao":20})");
+  ASSERT_TRUE(aguardarEstado(Estado::Gravacao, 5000));
+
+  // A força espera o golpe por CAPTURA_ESPERA_MS: a gravação sai antes
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"forca","usuario":"u1","timestampSolicitacao":2})");
+  ASSERT_TRUE(aguardarEstado(Estado::Forca, 5000));
+  delay(2000);
+  EXPECT_EQ(estado(), Estado::Forca);
+  EXPECT_EQ(ler("/saida/tipo").comoTexto(), "forca");
+  EXPECT_EQ(ler("/saida/estado").comoTexto(), "executando");
+  EXPECT_TRUE(ler("/saida/valor").nulo());
+}
+
+TEST_F(ModosTeste, OciosoDormeEAcordaPorToqueOuComando) {
+  // Sem app conectado o saco dorme depois de ENERGIA_OCIOSO_MS (3 s no
+  // build nativo) com o painel apagado
+  ASSERT_TRUE(aguardarEstado(Estado::Ocioso, 10000));
+  delay(300);
+  EXPECT_FALSE(simulacao::painelSSD1306().ligado());
+
+  // Toque no pad do centro: pronto bem antes da meta
+  uint8_t centro = sensores.getPino(ENERGIA_PAD_DESPERTAR);
+  simulacao::definirToque(centro, 30000);
+  ASSERT_TRUE(aguardarEstado(Estado::Inicial, 2000));
+  simulacao::definirToque(centro, 0);
+  unsigned long inicio = millis();
+  while (energia.getLatenciaDespertarUs() == 0 && millis() - inicio < 1000) {
+    delay(10);
+  }
+  EXPECT_GT(energia.getDespertares(CausaDespertar::Toque), 0u);
+  EXPECT_GT(energia.getLatenciaDespertarUs(), 0u);
+  EXPECT_LT(energia.getLatenciaDespertarUs(), (uint32_t)ENERGIA_META_DESPERTAR_US);
+  delay(300);
+  EXPECT_TRUE(simulacao::painelSSD1306().ligado());
+
+  // Dormindo de novo, um comando tira o saco do Estado::Ocioso direto para
+  // o modo. No host as outras tarefas não param durante o sono, então aqui
+  // não se verifica a janela de rede (ver teste_energia.cpp)
+  ASSERT_TRUE(aguardarEstado(Estado::Ocioso, 10000));
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"forca","usuario":"u1","timestampSolicitacao":1})");
+  ASSERT_TRUE(aguardarEstado(Estado::Forca, ENERGIA_VERIFICA_REDE_MS + 5000));
+
+  simulacao::definirFonteIMU([](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if ((agora / 1000) % 250 < 20) {
+      amostra.ax = 6.0f;
+    }
+    return amostra;
+  });
+  EXPECT_TRUE(aguardarTexto("/saida/estado", "concluida", 20000));
+}
+
+TEST_F(BootSemRedeTeste, ModosLocaisNaoEsperamARede) {
+  // O setup() volta sem a rede, dentro da meta
+  EXPECT_TRUE(boot.pronto(BOOT_LOCAL));
+  EXPECT_FALSE(boot.pronto(BOOT_WIFI));
+  EXPECT_GT(boot.getLocalProntoMs(), 0u);
+  EXPECT_LT(boot.getLocalProntoMs(), (uint32_t)BOOT_META_LOCAL_MS);
+  EXPECT_EQ(estado(), Estado::Inicial);
+
+  // Sem rede o saco segue local (e pode até dormir), sem registro no RTDB
+  EXPECT_FALSE(boot.aguardar(BOOT_FIREBASE, 2000));
+  simulacao::Json raiz = simulacao::rtdbMemoria().instantaneo();
+  EXPECT_EQ(raiz.buscar(caminho("")), nullptr);
+
+  // A rede volta: a tarefa de comunicação registra o saco e o relatório do boot
+  simulacao::definirWiFiConectado(true);
+  ASSERT_TRUE(boot.aguardar(BOOT_FIREBASE, 10000));
+  EXPECT_TRUE(boot.pronto(BOOT_WIFI | BOOT_HORA));
+  ASSERT_TRUE(aguardarTexto("/estado", "disponivel", 2000));
+  unsigned long inicio = millis();
+  const simulacao::Json* local = nullptr;
+  while (!local && millis() - inicio < 2000) {
+    raiz = simulacao::rtdbMemoria().instantaneo();
+    local = raiz.buscar(caminho("/boot/localMs"));
+    delay(50);
+  }
+  ASSERT_NE(local, nullptr);
+  EXPECT_EQ((uint32_t)local->comoReal(), boot.getLocalProntoMs());
+  const simulacao::Json* tentativas = raiz.buscar(caminho("/boot/fases/wifi/tentativas"));
+  ASSERT_NE(tentativas, nullptr);
+  EXPECT_GE(tentativas->comoReal(), 2.0);
+  EXPECT_GT(boot.getRedeProntaMs(), 2000u);
+}
+
+TEST_F(AtualizacaoOtaTeste, BaixaDuranteUmRoundEReiniciaQuandoOSacoFicaLivre) {
+  gravar("/estado", R"("ocupado")");
+  gravar("/entrada",
+         R"({"estado":"solicitada","tipo":"round","duracao":20,"descanso":1,"rounds":1})");
+  ASSERT_TRUE(aguardarEstado(Estado::Round, 5000));
+
+  // O download acontece com o round em andamento, e o reinício espera
+  publicarUrl();
+  ASSERT_TRUE(aguardarTexto("/ota/estado", "pronta", 10000));
+  EXPECT_EQ(estado(), Estado::Round);
+  EXPECT_FALSE(simulacao::reinicioPedido());
+  EXPECT_EQ(servidor.bytesEnviados("/saco-1.0.0-1.1.0.sdl"), delta.size());
+  EXPECT_EQ(servidor.requisicoes("/saco-1.1.0.sdl"), 0u);
+
+  ASSERT_TRUE(aguardarTexto("/saida/estado", "concluida", 30000));
+  ASSERT_TRUE(aguardarReinicio(5000));
+  EXPECT_EQ(ler("/ota/estado").comoTexto(), "reiniciando");
+
+  // Sobe à prova e se confirma com os sensores e o Firebase no ar
+  ASSERT_EQ(religar(true), 1);
+  ASSERT_TRUE(boot.aguardar(BOOT_FIREBASE, 5000));
+  ASSERT_TRUE(aguardarTexto("/ota/estado", "confirmada", 5000));
+  EXPECT_EQ(simulacao::estadoParticaoOta(1), ESP_OTA_IMG_VALID);
+  EXPECT_STREQ(esp_ota_get_app_description()->version, "1.1.0");
+  EXPECT_TRUE(aguardarTexto("/boot/versao", "1.1.0", 2000));
+
+  // Já na versão do manifesto: nada mais a baixar em três leituras dele
+  // (OTA_VERIFICA_MS é 2 s no saco_sketch)
+  delay(6000);
+  EXPECT_EQ(servidor.requisicoes("/saco-1.0.0-1.1.0.sdl"), 1u);
+  EXPECT_FALSE(simulacao::reinicioPedido());
+}
+
+TEST_F(AtualizacaoOtaTeste, SemRedeDepoisDaAtualizacaoVoltaParaAAnterior) {
+  publicarUrl();
+  ASSERT_TRUE(aguardarReinicio(10000));
+
+  // A 1.1.0 sobe sem WiFi: não passa na verificação e reverte sozinha
+  ASSERT_EQ(religar(false), 1);
+  ASSERT_TRUE(aguardarReinicio(OTA_PRAZO_SAUDE_MS + 5000));
+  EXPECT_EQ(simulacao::estadoParticaoOta(1), ESP_OTA_IMG_INVALID);
+
+  ASSERT_EQ(religar(true), 0);
+  ASSERT_TRUE(boot.aguardar(BOOT_FIREBASE, 5000));
+  EXPECT_STREQ(esp_ota_get_app_description()->version, "1.0.0");
+  ASSERT_TRUE(aguardarTexto("/ota/estado", "revertida", 5000));
+  EXPECT_EQ(ler("/ota/versao").comoTexto(), "1.1.0");
+
+  // A versão revertida não é baixada de novo
+  delay(6000);
+  EXPECT_EQ(servidor.requisicoes("/saco-1.0.0-1.1.0.sdl"), 1u);
+  EXPECT_FALSE(simulacao::reinicioPedido());
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GeradorDelta.h"
+#include "ImagensOta.h"
+#include "Ota.h"
+#include "ServidorOta.h"
+#include "Simulacao.h"
+
+namespace {
+
+// Versão 1.0.0 gravada pela serial e o servidor com a 1.1.0 (delta e completa)
+class OtaTeste : public ::testing::Test {
+protected:
+  std::vector<uint8_t> v1 = imagens_ota::imagemFirmware("1.0.0");
+  std::vector<uint8_t> v2 = imagens_ota::versaoSeguinte(v1, "1.1.0");
+  std::vector<uint8_t> delta = ota::gerarDelta(v1, v2);
+  std::vector<uint8_t> completa = ota::gerarDelta({}, v2);
+  ota::ServidorOta servidor;
+
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    // O download espera bytes de verdade
+    simulacao::definirRelogio(simulacao::ModoRelogio::Real);
+    simulacao::gravarFirmwareOta(v1.data(), v1.size());
+    servidor.publicar("/manifesto.txt",
+                      "versao 1.1.0\n"
+                      "completa saco-1.1.0.sdl\n"
+                      "delta 0.9.0 saco-0.9.0-1.1.0.sdl\n"
+                      "delta 1.0.0 saco-1.0.0-1.1.0.sdl\n");
+    servidor.publicar("/saco-1.0.0-1.1.0.sdl", delta);
+    servidor.publicar("/saco-1.1.0.sdl", completa);
+    ASSERT_TRUE(servidor.iniciar());
+    atualizadorOta.iniciar();
+  }
+
+  std::vector<uint8_t> particao(int indice, size_t tamanho) {
+    std::vector<uint8_t> dados(tamanho);
+    dados.resize(simulacao::lerParticaoOta(indice, dados.data(), dados.size()));
+    return dados;
+  }
+};
+
+}  // namespace
+
+TEST(Ota, ManifestoEscolheODeltaDaVersaoQueRoda) {
+  const char* texto =
+      "# saco\r\n"
+      "versao 1.2.0\r\n"
+      "delta 1.0.0 a.sdl\r\n"
+      "delta 1.1.0   b.sdl\r\n"
+      "completa saco-1.2.0.sdl\r\n";
+  ManifestoOta manifesto;
+  ASSERT_TRUE(AtualizadorOta::interpretarManifesto(texto, "1.1.0", manifesto));
+  EXPECT_STREQ(manifesto.versao, "1.2.0");
+  EXPECT_STREQ(manifesto.completa, "saco-1.2.0.sdl");
+  EXPECT_STREQ(manifesto.delta, "b.sdl");
+
+  // Sem delta da versão que roda: só a completa
+  ASSERT_TRUE(AtualizadorOta::interpretarManifesto(texto, "1.0.1", manifesto));
+  EXPECT_STREQ(manifesto.delta, "");
+
+  EXPECT_FALSE(AtualizadorOta::interpretarManifesto("versao 1.2.0\n", "1.1.0", manifesto));
+  EXPECT_FALSE(AtualizadorOta::interpretarManifesto("", "1.1.0", manifesto));
+}
+
+TEST_F(OtaTeste, BaixaODeltaNaOutraParticao) {
+  EXPECT_STREQ(atualizadorOta.getVersao(), "1.0.0");
+  ASSERT_TRUE(atualizadorOta.verificar(servidor.url().c_str()));
+  EXPECT_EQ(atualizadorOta.getEstado(), EstadoOta::Pronta);
+  EXPECT_STREQ(atualizadorOta.getVersaoNova(), "1.1.0");
+  EXPECT_TRUE(atualizadorOta.getUsouDelta());
+  EXPECT_EQ(atualizadorOta.getProgresso(), 100);
+
+  // Só o delta trafegou
+  EXPECT_EQ(atualizadorOta.getBytesBaixados(), delta.size());
+  EXPECT_EQ(servidor.bytesEnviados("/saco-1.0.0-1.1.0.sdl"), delta.size());
+  EXPECT_EQ(servidor.requisicoes("/saco-1.1.0.sdl"), 0u);
+  EXPECT_EQ(particao(1, v2.size() + 16), v2);
+  EXPECT_EQ(particao(0, v1.size() + 16), v1);
+  EXPECT_EQ(simulacao::particaoOtaAtual(), 0);
+}
+
+TEST_F(OtaTeste, BaseDiferenteCaiNaImagemCompleta) {
+  // Mesma versão, outro build: o CRC da base não bate
+  std::vector<uint8_t> outra = imagens_ota::imagemFirmware("1.0.0", 7);
+  simulacao::gravarFirmwareOta(outra.data(), outra.size());
+  atualizadorOta.iniciar();
+
+  ASSERT_TRUE(atualizadorOta.verificar(servidor.url().c_str()));
+  EXPECT_FALSE(atualizadorOta.getUsouDelta());
+  EXPECT_EQ(servidor.requisicoes("/saco-1.1.0.sdl"), 1u);
+  EXPECT_EQ(particao(1, v2.size() + 16), v2);
+}
+
+TEST_F(OtaTeste, MesmaVersaoOuSemRedeNaoBaixa) {
+  simulacao::definirWiFiConectado(false);
+  EXPECT_FALSE(atualizadorOta.verificar(servidor.url().c_str()));
+  EXPECT_EQ(servidor.requisicoes("/manifesto.txt"), 0u);
+
+  simulacao::definirWiFiConectado(true);
+  servidor.publicar("/manifesto.txt", "versao 1.0.0\ncompleta saco-1.0.0.sdl\n");
+  EXPECT_FALSE(atualizadorOta.verificar(servidor.url().c_str()));
+  EXPECT_EQ(servidor.requisicoes("/manifesto.txt"), 1u);
+  EXPECT_EQ(atualizadorOta.getEstado(), EstadoOta::Atualizada);
+}
+
+TEST_F(OtaTeste, ImagemNaoConfirmadaVoltaNoProximoBootENaoEhBaixadaDeNovo) {
+  ASSERT_TRUE(atualizadorOta.verificar(servidor.url().c_str()));
+  // O que AtualizadorOta::reiniciar() faz antes do ESP.restart()
+  ASSERT_EQ(esp_ota_set_boot_partition(esp_ota_get_next_update_partition(nullptr)), ESP_OK);
+
+  // Sobe à prova
+  ASSERT_EQ(simulacao::reiniciarOta(), 1);
+  EXPECT_EQ(simulacao::estadoParticaoOta(1), ESP_OTA_IMG_PENDING_VERIFY);
+  atualizadorOta.iniciar();
+  EXPECT_TRUE(atualizadorOta.pendenteVerificacao());
+  EXPECT_STREQ(atualizadorOta.getVersao(), "1.1.0");
+
+  // Reiniciou sem confirmar (travou, watchdog): o bootloader volta
+  ASSERT_EQ(simulacao::reiniciarOta(), 0);
+  EXPECT_EQ(simulacao::estadoParticaoOta(1), ESP_OTA_IMG_ABORTED);
+  atualizadorOta.iniciar();
+  EXPECT_EQ(atualizadorOta.getEstado(), EstadoOta::Revertida);
+  EXPECT_STREQ(atualizadorOta.getVersao(), "1.0.0");
+  EXPECT_STREQ(atualizadorOta.getVersaoNova(), "1.1.0");
+
+  EXPECT_FALSE(atualizadorOta.verificar(servidor.url().c_str()));
+  EXPECT_EQ(servidor.requisicoes("/saco-1.0.0-1.1.0.sdl"), 1u);
+
+  // Uma versão corrigida é baixada
+  std::vector<uint8_t> v3 = imagens_ota::versaoSeguinte(v2, "1.1.1", 3, 4);
+  servidor.publicar("/manifesto.txt", "versao 1.1.1\ncompleta saco-1.1.1.sdl\n");
+  servidor.publicar("/saco-1.1.1.sdl", ota::gerarDelta({}, v3));
+  ASSERT_TRUE(atualizadorOta.verificar(servidor.url().c_str()));
+  EXPECT_EQ(particao(1, v3.size() + 16), v3);
+}
+
+TEST_F(OtaTeste, ConfirmadaFicaValida) {
+  ASSERT_TRUE(atualizadorOta.verificar(servidor.url().c_str()));
+  ASSERT_EQ(esp_ota_set_boot_partition(esp_ota_get_next_update_partition(nullptr)), ESP_OK);
+  ASSERT_EQ(simulacao::reiniciarOta(), 1);
+  atualizadorOta.iniciar();
+  atualizadorOta.confirmar(true);
+  EXPECT_EQ(atualizadorOta.getEstado(), EstadoOta::Confirmada);
+  EXPECT_EQ(simulacao::estadoParticaoOta(1), ESP_OTA_IMG_VALID);
+
+  // Os próximos boots seguem na nova
+  EXPECT_EQ(simulacao::reiniciarOta(), 1);
+  EXPECT_EQ(simulacao::reiniciarOta(), 1);
+}
+
+TEST_F(OtaTeste, ServidorCaiNoMeioENadaMudaNoBoot) {
+  std::vector<uint8_t> grande = imagens_ota::imagemFirmware("2.0.0", 9, 512 * 1024);
+  servidor.publicar("/manifesto.txt", "versao 2.0.0\ncompleta saco-2.0.0.sdl\n");
+  servidor.publicar("/saco-2.0.0.sdl", ota::gerarDelta({}, grande));
+  servidor.limitarTaxa(64 * 1024);
+  // Cai com o download em andamento
+  std::thread derrubar([this] {
+    while (servidor.bytesEnviados("/saco-2.0.0.sdl") < 16 * 1024) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    servidor.parar();
+  });
+  EXPECT_FALSE(atualizadorOta.verificar(servidor.url().c_str()));
+  derrubar.join();
+  EXPECT_EQ(atualizadorOta.getEstado(), EstadoOta::Falhou);
+  EXPECT_STREQ(atualizadorOta.getErro(), "conexao");
+  EXPECT_EQ(simulacao::reiniciarOta(), 0);
+  EXPECT_STREQ(esp_ota_get_app_description()->version, "1.0.0");
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "Classificador.h"
+#include "Conexao.h"
+#include "Energia.h"
+#include "ModeloGolpes.h"
+#include "RTDB.h"
+#include "Sensores.h"
+
+// Compilado uma vez por placa (PLACA em host/CMakeLists.txt)
+
+namespace {
+
+class PlacaTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+  }
+};
+
+}  // namespace
+
+TEST_F(PlacaTeste, SensoresSegueODescritor) {
+  static_assert(Sensores::NUM_PADS == PlacaAtual::NUM_PADS, "Sensores de outra placa");
+  Sensores s;
+  std::set<uint8_t> pinos;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    EXPECT_EQ(s.getPino(i), PlacaAtual::pinos[i]);
+    EXPECT_STREQ(s.getNomeSensor(i).c_str(), PlacaAtual::nomes[i]);
+    EXPECT_EQ(s.getThreshold(i), PlacaAtual::limites[i]);
+    pinos.insert(s.getPino(i));
+  }
+  EXPECT_EQ(pinos.size(), (size_t)NUM_SENSORES);
+  EXPECT_STREQ(s.getNomeSensor(NUM_SENSORES).c_str(), "INVALIDO");
+  EXPECT_EQ(s.getPino(NUM_SENSORES), 0);
+}
+
+TEST_F(PlacaTeste, CalibracaoContaOsPadsDaPlaca) {
+  conexao.begin();
+  std::string raiz = std::string("/devices/") + conexao.deviceId.c_str();
+  simulacao::Json comando;
+  ASSERT_TRUE(simulacao::Json::interpretar(R"({"estado":"solicitada","tipo":"tCalibrar"})", comando));
+  std::string erro;
+  ASSERT_TRUE(simulacao::rtdbMemoria().gravar(raiz + "/entrada", comando, erro));
+  ASSERT_TRUE(conexao.checkForCommands());
+  ASSERT_TRUE(conexao.updateDeviceEx());
+
+  simulacao::Json atual = simulacao::rtdbMemoria().instantaneo();
+  const simulacao::Json* total = atual.buscar(raiz + "/saida/progresso/total");
+  ASSERT_NE(total, nullptr);
+  EXPECT_EQ(total->comoInteiro(), NUM_SENSORES);
+}
+
+TEST_F(PlacaTeste, CadaPadDisparaSozinho) {
+  Sensores s;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    SCOPED_TRACE(PlacaAtual::nomes[i]);
+    simulacao::definirToque(PlacaAtual::pinos[i], PlacaAtual::limites[i] + 1);
+    EXPECT_EQ(s.detectarToque(), i);
+
+    uint16_t valores[NUM_SENSORES];
+    s.lerToques(valores);
+    for (int j = 0; j < NUM_SENSORES; j++) {
+      EXPECT_EQ(valores[j], j == i ? PlacaAtual::limites[i] + 1 : 0);
+    }
+    simulacao::definirToque(PlacaAtual::pinos[i], 0);
+  }
+  EXPECT_EQ(s.detectarToque(), -1);
+}
+
+TEST_F(PlacaTeste, ForcaSoComIMU) {
+  Sensores s;
+  s.iniciar();
+  simulacao::definirFonteIMU([](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if (agora >= 200000 && agora < 220000) {
+      amostra.ax = 6.0f;
+    }
+    return amostra;
+  });
+  float forca = s.calcularForca();
+  xyzFloat aceleracao, giro;
+  s.lerIMU(aceleracao, giro);
+  if (PlacaAtual::TEM_IMU) {
+    EXPECT_GT(forca, 0.0f);
+  } else {
+    EXPECT_EQ(forca, 0.0f);
+    EXPECT_EQ(aceleracao.z, 1.0f);
+  }
+}
+
+TEST_F(PlacaTeste, SoClassificaComOModeloDaPlaca) {
+  float x[NUM_CARACTERISTICAS] = {6, 19, 1, 0, 0, 1, 0, 0, 0, 0, 2, 0.5f, 0.3f, 0.2f,
+                                  POSICAO_PADS[0][0], POSICAO_PADS[0][1], POSICAO_PADS[0][2]};
+  int32_t saidas[NUM_TIPOS_GOLPE];
+  TipoGolpe tipo = classificadorGolpes.classificar(x, saidas);
+#ifdef MODELO_GOLPES_OCULTOS
+  EXPECT_EQ(modeloGolpesPadrao().ocultos, MODELO_GOLPES_OCULTOS);
+  EXPECT_NE(tipo, TipoGolpe::Desconhecido);
+#else
+  // O modelo do saco não vale para os pads de outra placa
+  EXPECT_EQ(modeloGolpesPadrao().ocultos, 0);
+  EXPECT_EQ(tipo, TipoGolpe::Desconhecido);
+  for (int k = 0; k < NUM_TIPOS_GOLPE; k++) {
+    EXPECT_EQ(saidas[k], 0);
+  }
+#endif
+}
+
+TEST_F(PlacaTeste, PadDoCentroAcordaDoSono) {
+  Sensores s;
+  EXPECT_EQ(s.getPino(ENERGIA_PAD_DESPERTAR), PlacaAtual::pinos[PlacaAtual::PAD_CENTRO]);
+  EXPECT_GT(s.getThreshold(ENERGIA_PAD_DESPERTAR), 0);
+}
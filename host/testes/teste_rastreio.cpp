@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Json.h"
+#include "Rastreio.h"
+#include "Simulacao.h"
+
+namespace {
+
+class RastreioTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+    rastreio.limpar();
+    rastreio.ativar(true);
+  }
+
+  void TearDown() override {
+    rastreio.ativar(false);
+  }
+
+  // Exporta e interpreta o JSON do Chrome
+  simulacao::Json exportar(size_t* escritos = nullptr) {
+    Texto saida;
+    size_t n = rastreio.exportarChrome(saida);
+    if (escritos) {
+      *escritos = n;
+    }
+    simulacao::Json raiz;
+    EXPECT_TRUE(simulacao::Json::interpretar(saida.conteudo, raiz)) << saida.conteudo;
+    return raiz;
+  }
+
+  // Eventos que não são metadados (ph "M")
+  static std::vector<simulacao::Json> eventos(const simulacao::Json& raiz) {
+    std::vector<simulacao::Json> resultado;
+    const simulacao::Json* lista = raiz.buscar("traceEvents");
+    if (lista) {
+      for (const simulacao::Json& evento : lista->itens()) {
+        if (evento.buscar("ph")->comoTexto() != "M") {
+          resultado.push_back(evento);
+        }
+      }
+    }
+    return resultado;
+  }
+
+  // Nome da linha tid nos metadados, ou "" se não houver
+  static std::string nomeDaLinha(const simulacao::Json& raiz, long long tid) {
+    for (const simulacao::Json& evento : raiz.buscar("traceEvents")->itens()) {
+      if (evento.buscar("name")->comoTexto() == "thread_name" &&
+          evento.buscar("tid")->comoInteiro() == tid) {
+        return evento.buscar("args/name")->comoTexto();
+      }
+    }
+    return "";
+  }
+
+  class Texto : public Print {
+  public:
+    std::string conteudo;
+    size_t write(uint8_t c) override {
+      conteudo.push_back((char)c);
+      return 1;
+    }
+  };
+};
+
+}  // namespace
+
+TEST_F(RastreioTeste, TrechosViramInicioEFimNaLinhaDaTarefa) {
+  delay(100);
+  {
+    RASTREIO_TRECHO("externo");
+    delay(2);
+    {
+      RASTREIO_TRECHO("interno");
+      delay(3);
+    }
+    RASTREIO_INSTANTE("marco");
+  }
+
+  size_t escritos = 0;
+  simulacao::Json raiz = exportar(&escritos);
+  std::vector<simulacao::Json> l = eventos(raiz);
+  ASSERT_EQ(escritos, 5u);
+  ASSERT_EQ(l.size(), 5u);
+
+  const char* nomes[] = {"externo", "interno", "interno", "marco", "externo"};
+  const char* fases[] = {"B", "B", "E", "i", "E"};
+  // O tempo conta do primeiro evento
+  const long long tempos[] = {0, 2000, 5000, 5000, 5000};
+  for (size_t i = 0; i < l.size(); i++) {
+    EXPECT_EQ(l[i].buscar("name")->comoTexto(), nomes[i]) << i;
+    EXPECT_EQ(l[i].buscar("ph")->comoTexto(), fases[i]) << i;
+    EXPECT_EQ(l[i].buscar("ts")->comoInteiro(), tempos[i]) << i;
+    EXPECT_EQ(l[i].buscar("tid")->comoInteiro(), 1) << i;
+  }
+  EXPECT_EQ(nomeDaLinha(raiz, 1), "principal");
+  EXPECT_EQ(raiz.buscar("otherData/sobrescritos")->comoTexto(), "0");
+}
+
+TEST_F(RastreioTeste, TrocasDeTarefaVaoParaALinhaDaCPU) {
+  rastreioTarefaEntrou();
+  delay(1);
+  RASTREIO_INSTANTE("trabalho");
+  rastreioTarefaSaiu();
+
+  simulacao::Json raiz = exportar();
+  std::vector<simulacao::Json> l = eventos(raiz);
+  ASSERT_EQ(l.size(), 3u);
+  EXPECT_EQ(l[0].buscar("ph")->comoTexto(), "B");
+  EXPECT_EQ(l[0].buscar("name")->comoTexto(), "CPU");
+  EXPECT_EQ(l[2].buscar("ph")->comoTexto(), "E");
+  long long cpu = l[0].buscar("tid")->comoInteiro();
+  long long tarefa = l[1].buscar("tid")->comoInteiro();
+  EXPECT_EQ(cpu, tarefa + RASTREIO_MAX_TAREFAS);
+  EXPECT_EQ(l[2].buscar("tid")->comoInteiro(), cpu);
+  EXPECT_EQ(nomeDaLinha(raiz, cpu), "principal (CPU)");
+}
+
+TEST_F(RastreioTeste, PrazoContaSoOsAtrasosAlemDaTolerancia) {
+  // 10 ms com 5 ms de folga
+  static PrazoRastreio prazo("teste", 10000, 5000);
+  prazo.zerar();
+  prazo.iniciar();
+  const uint32_t intervalos[] = {10, 10, 14, 10, 25, 10, 16};
+  delay(50);  // Antes da primeira volta: não conta
+  prazo.marcar();
+  for (uint32_t intervalo : intervalos) {
+    delay(intervalo);
+    prazo.marcar();
+  }
+
+  EXPECT_EQ(prazo.getVoltas(), 7u);
+  EXPECT_EQ(prazo.getPerdas(), 2u);
+  EXPECT_EQ(prazo.getPiorAtrasoUs(), 15000u);
+
+  // Um novo iniciar() também não conta o intervalo até a volta seguinte
+  delay(1000);
+  prazo.iniciar();
+  prazo.marcar();
+  EXPECT_EQ(prazo.getVoltas(), 7u);
+
+  simulacao::Json raiz = exportar();
+  std::vector<simulacao::Json> perdidos;
+  for (const simulacao::Json& evento : eventos(raiz)) {
+    if (evento.buscar("name")->comoTexto() == "prazo perdido: teste") {
+      perdidos.push_back(evento);
+    }
+  }
+  ASSERT_EQ(perdidos.size(), 2u);
+  EXPECT_EQ(perdidos[0].buscar("ph")->comoTexto(), "i");
+  EXPECT_EQ(perdidos[0].buscar("args/atrasoUs")->comoInteiro(), 15000);
+  EXPECT_EQ(perdidos[1].buscar("args/atrasoUs")->comoInteiro(), 6000);
+  EXPECT_EQ(raiz.buscar("otherData/prazo.teste")->comoTexto(),
+            "periodoUs=10000 voltas=7 perdas=2 piorAtrasoUs=15000");
+
+  Texto relatorio;
+  rastreio.relatorioPrazos(relatorio);
+  EXPECT_NE(relatorio.conteudo.find("Prazo teste             10000 us: 7 voltas, 2 perdidos, pior atraso 15000 us"),
+            std::string::npos)
+      << relatorio.conteudo;
+}
+
+TEST_F(RastreioTeste, AnelGuardaOsMaisRecentes) {
+  const uint32_t EXTRAS = 10;
+  for (uint32_t i = 0; i < RASTREIO_CAPACIDADE + EXTRAS; i++) {
+    RASTREIO_INSTANTE(i < EXTRAS ? "antigo" : "recente");
+    delay(1);
+  }
+  EXPECT_EQ(rastreio.getGravados(), RASTREIO_CAPACIDADE + EXTRAS);
+  EXPECT_EQ(rastreio.getSobrescritos(), EXTRAS);
+
+  size_t escritos = 0;
+  simulacao::Json raiz = exportar(&escritos);
+  std::vector<simulacao::Json> l = eventos(raiz);
+  EXPECT_EQ(escritos, (size_t)RASTREIO_CAPACIDADE);
+  ASSERT_EQ(l.size(), (size_t)RASTREIO_CAPACIDADE);
+  for (const simulacao::Json& evento : l) {
+    ASSERT_EQ(evento.buscar("name")->comoTexto(), "recente");
+  }
+  EXPECT_EQ(l.front().buscar("ts")->comoInteiro(), 0);
+  EXPECT_EQ(l.back().buscar("ts")->comoInteiro(), (RASTREIO_CAPACIDADE - 1) * 1000LL);
+  EXPECT_EQ(raiz.buscar("otherData/sobrescritos")->comoTexto(), std::to_string(EXTRAS));
+}
+
+TEST_F(RastreioTeste, DesligadoNaoGrava) {
+  rastreio.ativar(false);
+  RASTREIO_INSTANTE("ignorado");
+  {
+    RASTREIO_TRECHO("ignorado");
+  }
+  EXPECT_EQ(rastreio.getGravados(), 0u);
+
+  // A exportação de um anel vazio ainda é um JSON válido
+  simulacao::Json raiz = exportar();
+  EXPECT_TRUE(eventos(raiz).empty());
+  EXPECT_FALSE(rastreio.getAtivo());
+}
+
+TEST_F(RastreioTeste, PrazoDestruidoSaiDaListaELiberaAPosicao) {
+  int antes = rastreio.getNumPrazos();
+  {
+    PrazoRastreio local("local", 1000, 500);
+    local.iniciar();
+    bool achou = false;
+    for (int i = 0; i < rastreio.getNumPrazos(); i++) {
+      achou = achou || rastreio.getPrazo(i) == &local;
+    }
+    EXPECT_TRUE(achou);
+  }
+  for (int i = 0; i < rastreio.getNumPrazos(); i++) {
+    const PrazoRastreio* prazo = rastreio.getPrazo(i);
+    EXPECT_TRUE(prazo == nullptr || strcmp(prazo->getNome(), "local") != 0);
+  }
+  Texto relatorio;
+  rastreio.relatorioPrazos(relatorio);
+  EXPECT_EQ(relatorio.conteudo.find("local"), std::string::npos);
+
+  // Um prazo novo ocupa a posição vaga em vez de uma nova
+  int depois = rastreio.getNumPrazos();
+  for (int volta = 0; volta < 2 * RASTREIO_MAX_PRAZOS; volta++) {
+    PrazoRastreio outro("outro", 1000, 500);
+    outro.iniciar();
+  }
+  EXPECT_EQ(rastreio.getNumPrazos(), depois);
+  EXPECT_LE(depois, antes + 1);
+}
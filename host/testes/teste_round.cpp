@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Round.h"
+
+namespace {
+
+xyzFloat vetor(float x, float y, float z) {
+  xyzFloat v;
+  v.x = x;
+  v.y = y;
+  v.z = z;
+  return v;
+}
+
+// Golpe em meio-seno de 20 ms no eixo X, com a gravidade em Z
+xyzFloat aceleracaoGolpe(uint32_t ms, uint32_t inicioMs, float intensidade) {
+  float golpe = 0;
+  if (ms >= inicioMs && ms < inicioMs + 20) {
+    golpe = intensidade * sinf(M_PI * (ms - inicioMs) / 20.0f);
+  }
+  return vetor(golpe, 0, 1);
+}
+
+// Desvio da resultante em relação a 1 g para um golpe de `intensidade` em X
+float desvioEsperado(float intensidade) {
+  return sqrtf(intensidade * intensidade + 1) - 1;
+}
+
+void toques(SegmentadorGolpes& segmentador, uint32_t ms, int padTocado) {
+  uint16_t valores[NUM_SENSORES] = {};
+  int limites[NUM_SENSORES];
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    limites[i] = 1000;
+  }
+  if (padTocado >= 0) {
+    valores[padTocado] = 5000;
+  }
+  segmentador.adicionarToques(ms, valores, limites);
+}
+
+}  // namespace
+
+TEST(RoundTeste, SegmentaMaisDeCincoGolpesPorSegundo) {
+  // 10 s de round, um golpe a cada 160 ms (6,25 por segundo). Um terço
+  // toca o pad antes do MPU, um terço durante e um terço não toca pad
+  const uint32_t PERIODO_MS = 160;
+  const uint32_t DURACAO_MS = 10000;
+  SegmentadorGolpes segmentador;
+  static RegistroRound registro;
+  registro.iniciar(1, DURACAO_MS / 1000, 0, 1700000000);
+
+  uint32_t esperadoPorSegundo[10] = {};
+  float picoPorSegundo[10] = {};
+  uint32_t esperadoPorPad[NUM_SENSORES] = {};
+  uint32_t total = 0;
+  for (uint32_t inicio = 100; inicio < DURACAO_MS - 100; inicio += PERIODO_MS) {
+    uint32_t k = (inicio - 100) / PERIODO_MS;
+    float intensidade = 3.0f + (k % 5);
+    esperadoPorSegundo[inicio / 1000]++;
+    picoPorSegundo[inicio / 1000] = fmaxf(picoPorSegundo[inicio / 1000], desvioEsperado(intensidade));
+    if (k % 3 != 2) {
+      esperadoPorPad[k % NUM_SENSORES]++;
+    }
+    total++;
+  }
+
+  GolpeSegmentado golpe;
+  uint32_t segmentados = 0;
+  for (uint32_t ms = 0; ms < DURACAO_MS; ms++) {
+    uint32_t k = ms < 100 ? 0 : (ms - 100) / PERIODO_MS;
+    uint32_t inicio = 100 + k * PERIODO_MS;
+    float intensidade = 3.0f + (k % 5);
+
+    if (ms % ROUND_PERIODO_TOQUE_MS == 0) {
+      int pad = -1;
+      uint32_t proximo = inicio + PERIODO_MS;
+      if ((k + 1) % 3 == 0 && ms + 10 == proximo) {
+        pad = (k + 1) % NUM_SENSORES;  // 10 ms antes do próximo golpe
+      } else if (ms >= 100 && k % 3 == 1 && ms >= inicio + 10 && ms < inicio + 40) {
+        pad = k % NUM_SENSORES;        // No meio do golpe
+      } else if (ms >= 100 && k % 3 == 0 && ms < inicio + 30) {
+        pad = k % NUM_SENSORES;        // Continua pressionado
+      }
+      toques(segmentador, ms, pad);
+    }
+    if (segmentador.adicionarIMU(ms, aceleracaoGolpe(ms, inicio, intensidade), golpe)) {
+      EXPECT_NEAR(golpe.inicioMs, inicio, 8u);
+      EXPECT_NEAR(golpe.picoG, desvioEsperado(intensidade), 0.05f);
+      EXPECT_LT(golpe.duracaoMs, 25);
+      EXPECT_EQ(golpe.pad, k % 3 == 2 ? -1 : (int)(k % NUM_SENSORES)) << "golpe " << k;
+      registro.registrar(golpe);
+      segmentados++;
+    }
+  }
+
+  EXPECT_EQ(segmentados, total);
+  EXPECT_EQ(registro.getGolpes(), total);
+  for (int s = 0; s < 10; s++) {
+    EXPECT_EQ(registro.balde(s).golpes, esperadoPorSegundo[s]) << "segundo " << s;
+    EXPECT_NEAR(registro.balde(s).picoG, picoPorSegundo[s], 0.05f);
+    EXPECT_GE(registro.balde(s).golpes, 6);
+  }
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    EXPECT_EQ(registro.getGolpesPad(i), esperadoPorPad[i]) << "pad " << i;
+  }
+  EXPECT_NEAR(registro.getPicoG(), desvioEsperado(7.0f), 0.05f);
+}
+
+TEST(RoundTeste, ToqueAntigoNaoEhAtribuidoAoGolpe) {
+  SegmentadorGolpes segmentador;
+  GolpeSegmentado golpe;
+  bool terminou = false;
+  for (uint32_t ms = 0; ms < 500 && !terminou; ms++) {
+    if (ms % ROUND_PERIODO_TOQUE_MS == 0) {
+      toques(segmentador, ms, ms >= 100 && ms < 150 ? 4 : -1);
+    }
+    terminou = segmentador.adicionarIMU(ms, aceleracaoGolpe(ms, 300, 5.0f), golpe);
+  }
+  ASSERT_TRUE(terminou);
+  EXPECT_EQ(golpe.pad, -1);
+}
+
+TEST(RoundTeste, InclinacaoLentaNaoViraGolpe) {
+  // O saco balança e a gravidade muda 0,6 g em 5 s: o repouso acompanha
+  SegmentadorGolpes segmentador;
+  GolpeSegmentado golpe;
+  for (uint32_t ms = 0; ms < 5000; ms++) {
+    float inclinacao = 0.6f * ms / 5000.0f;
+    ASSERT_FALSE(segmentador.adicionarIMU(ms, vetor(inclinacao, 0, 1), golpe)) << ms;
+  }
+  EXPECT_FALSE(segmentador.emGolpe());
+  EXPECT_GT(segmentador.getRepousoG(), 1.1f);
+}
+
+TEST(RoundTeste, RegistroDescartaGolpeForaDoRound) {
+  static RegistroRound registro;
+  registro.iniciar(2, 3, 1000, 0);
+  GolpeSegmentado golpe = {1500, 20, 4.0f, 2};
+  registro.registrar(golpe);
+  golpe.inicioMs = 1700;
+  golpe.picoG = 2.0f;
+  golpe.pad = -1;
+  registro.registrar(golpe);
+  golpe.inicioMs = 4000;  // Depois dos 3 s
+  registro.registrar(golpe);
+
+  EXPECT_EQ(registro.getNumero(), 2);
+  EXPECT_EQ(registro.getGolpes(), 2u);
+  EXPECT_FLOAT_EQ(registro.getMediaG(), 3.0f);
+  EXPECT_EQ(registro.balde(0).golpes, 2);
+  EXPECT_FLOAT_EQ(registro.balde(0).picoG, 4.0f);
+  EXPECT_EQ(registro.balde(0).porPad[2], 1);
+  EXPECT_EQ(registro.getGolpesPad(2), 1u);
+  EXPECT_EQ(registro.balde(2).golpes, 0);
+}
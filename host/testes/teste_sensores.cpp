@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+
+#include "BarramentoI2C.h"
+#include "LittleFS.h"
+#include "Sensores.h"
+
+namespace {
+
+class SensoresTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+  }
+};
+
+// Golpe: pico de aceleração de `intensidade` g durante 20 ms
+simulacao::FonteIMU golpe(uint64_t inicioUs, float intensidade) {
+  return [inicioUs, intensidade](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if (agora >= inicioUs && agora < inicioUs + 20000) {
+      amostra.ax = intensidade;
+    }
+    return amostra;
+  };
+}
+
+}  // namespace
+
+TEST_F(SensoresTeste, DetectarToqueRetornaPrimeiroSensorAcimaDoLimite) {
+  Sensores s;
+  EXPECT_EQ(s.detectarToque(), -1);
+
+  // T6 é o sensor 1 (FrenteBaixa), limite inicial 15000
+  simulacao::definirToque(T6, 14999);
+  EXPECT_EQ(s.detectarToque(), -1);
+  simulacao::definirToque(T6, 15001);
+  EXPECT_EQ(s.detectarToque(), 1);
+
+  // T8 (sensor 0) é verificado antes
+  simulacao::definirToque(T8, 20001);
+  EXPECT_EQ(s.detectarToque(), 0);
+}
+
+TEST_F(SensoresTeste, CalibracaoIndividualUsaMediaDosMaioresToques) {
+  Sensores s;
+  for (int pino = T1; pino <= T10; pino++) {
+    simulacao::definirToque(pino, 10000);
+  }
+  s.iniciarCalibracaoInterativa();  // Baseline de 10000
+  ASSERT_EQ(s.getBaseline(0), 10000);
+
+  simulacao::definirToque(T8, 16000);
+  EXPECT_TRUE(s.calibrarSensorIndividual(0));
+  EXPECT_EQ(s.getThreshold(0), (10000 + 16000) / 2);
+}
+
+TEST_F(SensoresTeste, CalibracaoGravadaVoltaNoProximoBoot) {
+  char modelo[] = "/tmp/saco_flashXXXXXX";
+  ASSERT_NE(mkdtemp(modelo), nullptr);
+  simulacao::definirDiretorioFlash(modelo);
+  ASSERT_TRUE(LittleFS.begin(true));
+
+  Sensores antes;
+  EXPECT_FALSE(antes.carregarCalibracao());  // Primeiro boot: limites da placa
+  antes.definirCalibracao(0, 9000, 17000);
+  antes.definirCalibracao(NUM_SENSORES - 1, 8000, 12000);
+  ASSERT_TRUE(antes.salvarCalibracao());
+
+  Sensores depois;
+  ASSERT_TRUE(depois.carregarCalibracao());
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    EXPECT_EQ(depois.getBaseline(i), antes.getBaseline(i)) << i;
+    EXPECT_EQ(depois.getThreshold(i), antes.getThreshold(i)) << i;
+  }
+  EXPECT_EQ(depois.getThreshold(0), 17000);
+
+  // Arquivo de uma placa com outro número de pads: fica com os limites
+  std::ofstream(std::string(modelo) + CALIBRACAO_ARQUIVO, std::ios::binary)
+      .write("CAL\x01\x63\0\0\0", 8);
+  Sensores outraPlaca;
+  EXPECT_FALSE(outraPlaca.carregarCalibracao());
+  EXPECT_EQ(outraPlaca.getThreshold(0), PlacaAtual::limites[0]);
+}
+
+TEST_F(SensoresTeste, CalibracaoIndividualFalhaSemToques) {
+  Sensores s;
+  for (int pino = T1; pino <= T10; pino++) {
+    simulacao::definirToque(pino, 10000);
+  }
+  s.iniciarCalibracaoInterativa();
+
+  uint64_t inicio = simulacao::agoraUs();
+  EXPECT_FALSE(s.calibrarSensorIndividual(0));
+  EXPECT_EQ(s.getThreshold(0), 20000);  // Limite inicial mantido
+  // 20 amostras a cada 100 ms
+  EXPECT_EQ(simulacao::agoraUs() - inicio, 2000000u);
+}
+
+TEST_F(SensoresTeste, ForcaEmRepousoEhZero) {
+  sensores.iniciar();
+  EXPECT_FLOAT_EQ(sensores.calcularForca(), 0.0f);
+}
+
+TEST_F(SensoresTeste, ForcaCresceComIntensidadeDoGolpe) {
+  sensores.iniciar();
+
+  simulacao::definirFonteIMU(golpe(simulacao::agoraUs() + 300000, 4.0f));
+  float fraco = sensores.calcularForca();
+
+  simulacao::definirFonteIMU(golpe(simulacao::agoraUs() + 300000, 12.0f));
+  float forte = sensores.calcularForca();
+
+  EXPECT_GT(fraco, 0.0f);
+  EXPECT_GT(forte, 2.0f * fraco);
+}
+
+TEST_F(SensoresTeste, ForcaSaturaNaFaixaDe16g) {
+  sensores.iniciar();
+
+  simulacao::definirFonteIMU(golpe(simulacao::agoraUs() + 300000, 16.0f));
+  float limite = sensores.calcularForca();
+  simulacao::definirFonteIMU(golpe(simulacao::agoraUs() + 300000, 40.0f));
+  float saturado = sensores.calcularForca();
+
+  EXPECT_NEAR(saturado, limite, limite * 0.01f);
+}
+
+TEST_F(SensoresTeste, TransacaoSemOBarramentoNaoLiberaOMutexDeOutro) {
+  ASSERT_TRUE(barramentoI2C.iniciar());
+  ASSERT_TRUE(barramentoI2C.adquirir(PrioridadeI2C::Display));
+  {
+    TransacaoI2C transacao(PrioridadeI2C::Sensor, 6, 0);
+    EXPECT_FALSE(transacao.adquirida());
+  }
+  // O display continua dono
+  EXPECT_FALSE(barramentoI2C.adquirir(PrioridadeI2C::Display, 0));
+  barramentoI2C.liberar(PrioridadeI2C::Display);
+
+  TransacaoI2C transacao(PrioridadeI2C::Sensor, 6, 0);
+  EXPECT_TRUE(transacao.adquirida());
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+
+#include "ReproducaoTraco.h"
+#include "Sensores.h"
+
+namespace {
+
+class TracoTeste : public ::testing::Test {
+protected:
+  void SetUp() override {
+    simulacao::reiniciar();
+    simulacao::silenciarSerial(true);
+  }
+};
+
+traco::ParametrosSinteticos parametrosComGolpes() {
+  traco::ParametrosSinteticos p;
+  p.duracaoMs = 3000;
+  p.ruidoG = 0;
+  p.golpes = {{500, 8.0f, 20, 0}, {1700, 8.0f, 20, 3}};
+  return p;
+}
+
+// Golpe em meio-seno igual ao do gerador sintético, sem quantização
+simulacao::FonteIMU meioSeno(uint64_t inicioUs, float intensidade) {
+  return [inicioUs, intensidade](uint64_t agora) {
+    simulacao::AmostraIMU amostra = {0, 0, 1, 0, 0, 0};
+    if (agora >= inicioUs && agora < inicioUs + 20000) {
+      amostra.ax = intensidade * sinf((float)M_PI * (agora - inicioUs) / 20000.0f);
+    }
+    return amostra;
+  };
+}
+
+}  // namespace
+
+TEST_F(TracoTeste, SerializarEInterpretarPreservamOTraco) {
+  traco::Traco original = traco::gerarSintetico(parametrosComGolpes());
+  ASSERT_EQ(original.cabecalho.numSensores, NUM_SENSORES);
+  EXPECT_EQ(original.imu.size(), 3001u);
+  EXPECT_EQ(original.toques.size(), 301u);
+  EXPECT_EQ(original.marcadores.size(), 2u);
+
+  traco::Traco copia;
+  std::string erro;
+  ASSERT_TRUE(copia.interpretar(original.serializar(), erro)) << erro;
+  EXPECT_EQ(memcmp(&copia.cabecalho, &original.cabecalho, sizeof(CabecalhoTraco)), 0);
+  ASSERT_EQ(copia.imu.size(), original.imu.size());
+  for (size_t i = 0; i < copia.imu.size(); i++) {
+    EXPECT_EQ(copia.imu[i].tempoUs, original.imu[i].tempoUs);
+    EXPECT_FLOAT_EQ(copia.imu[i].valor.ax, original.imu[i].valor.ax);
+  }
+  EXPECT_EQ(copia.marcadores[1].tempoUs, 1700000u);
+  EXPECT_EQ(copia.marcadores[1].texto, "golpe");
+}
+
+TEST_F(TracoTeste, IntervaloLongoGeraRegistroDeTempo) {
+  CabecalhoTraco cabecalho = {};
+  cabecalho.magico = TRACO_MAGICO;
+  cabecalho.versao = TRACO_VERSAO;
+  cabecalho.tamanhoCabecalho = sizeof(CabecalhoTraco);
+  cabecalho.numSensores = 1;
+  cabecalho.faixaAcelG = FAIXA_ACEL_G;
+  cabecalho.faixaGiroDps = FAIXA_GIRO_DPS;
+
+  traco::BufferTraco buffer;
+  GravadorTraco gravador;
+  ASSERT_TRUE(gravador.iniciar(buffer, cabecalho, false));
+  uint16_t valor = 1234;
+  gravador.registrarToque(100, &valor);
+  gravador.registrarToque(100 + 70000, &valor);
+  gravador.registrarToque(100 + 70000 + 5, &valor);
+  gravador.finalizar();
+
+  // 3 toques de 3 + 2 bytes e um registro de tempo de 3 + 4 bytes
+  EXPECT_EQ(buffer.bytes.size(), sizeof(CabecalhoTraco) + 3 * 5 + 7);
+
+  traco::Traco lido;
+  std::string erro;
+  ASSERT_TRUE(lido.interpretar(buffer.bytes, erro)) << erro;
+  ASSERT_EQ(lido.toques.size(), 3u);
+  EXPECT_EQ(lido.toques[0].tempoUs, 100u);
+  EXPECT_EQ(lido.toques[1].tempoUs, 70100u);
+  EXPECT_EQ(lido.toques[2].tempoUs, 70105u);
+  EXPECT_EQ(lido.toques[2].valores[0], 1234);
+}
+
+TEST_F(TracoTeste, CapturaSerialIgnoraLogsEQuadrosCorrompidos) {
+  traco::Traco original = traco::gerarSintetico(parametrosComGolpes());
+  std::vector<uint8_t> bytes = original.serializar();
+
+  // Grava enquadrado, intercalando texto de log entre os quadros
+  traco::BufferTraco captura;
+  GravadorTraco gravador;
+  original.cabecalho.numSensores = NUM_SENSORES;
+  gravador.iniciar(captura, original.cabecalho, true);
+  captura.print("Sensores inicializados\n");
+  for (const traco::AmostraToque& toque : original.toques) {
+    gravador.registrarToque(toque.tempoUs, toque.valores);
+    if (toque.tempoUs == 1000000) {
+      captura.print("log no meio do traço\n");
+    }
+  }
+  gravador.finalizar();
+  captura.print("Traço finalizado\n");
+
+  size_t invalidos = 0;
+  traco::Traco lido;
+  std::string erro;
+  ASSERT_TRUE(lido.interpretar(captura.bytes, erro)) << erro;
+  EXPECT_EQ(lido.toques.size(), original.toques.size());
+  traco::Traco::desenquadrar(captura.bytes, &invalidos);
+  EXPECT_EQ(invalidos, 0u);
+
+  // Um byte trocado derruba só o quadro afetado
+  size_t posicao = captura.bytes.size() / 2;
+  captura.bytes[posicao] ^= 0xFF;
+  traco::Traco::desenquadrar(captura.bytes, &invalidos);
+  EXPECT_EQ(invalidos, 1u);
+}
+
+TEST_F(TracoTeste, ArquivoSemCabecalhoEhRejeitado) {
+  traco::Traco lido;
+  std::string erro;
+  EXPECT_FALSE(lido.interpretar({'o', 'l', 'a', '\n'}, erro));
+  EXPECT_FALSE(erro.empty());
+}
+
+TEST_F(TracoTeste, ReproducaoDetectaToquesNosInstantesGravados) {
+  traco::Traco dados = traco::gerarSintetico(parametrosComGolpes());
+  traco::Reproducao reproducao(dados);
+  reproducao.aplicarCalibracao(sensores);
+  reproducao.instalar();
+
+  std::vector<std::pair<int, uint64_t>> detectados;
+  int anterior = -1;
+  while (!reproducao.terminou()) {
+    int sensor = sensores.detectarToque();
+    if (sensor != -1 && sensor != anterior) {
+      detectados.push_back({sensor, simulacao::agoraUs() - reproducao.inicio()});
+    }
+    anterior = sensor;
+    delay(1);
+  }
+
+  ASSERT_EQ(detectados.size(), 2u);
+  EXPECT_EQ(detectados[0].first, 0);
+  EXPECT_NEAR(detectados[0].second, 500000.0, 10000.0);
+  EXPECT_EQ(detectados[1].first, 3);
+  EXPECT_NEAR(detectados[1].second, 1700000.0, 10000.0);
+}
+
+TEST_F(TracoTeste, ForcaReproduzidaEquivaleAFonteDireta) {
+  sensores.iniciar();
+  simulacao::definirFonteIMU(meioSeno(simulacao::agoraUs() + 300000, 8.0f));
+  float direta = sensores.calcularForca();
+
+  traco::ParametrosSinteticos p;
+  p.duracaoMs = 1000;
+  p.ruidoG = 0;
+  p.golpes = {{300, 8.0f, 20, -1}};
+  traco::Traco dados = traco::gerarSintetico(p);
+  traco::Reproducao reproducao(dados);
+  reproducao.instalar();
+  float reproduzida = sensores.calcularForca();
+
+  EXPECT_GT(reproduzida, 0.0f);
+  EXPECT_NEAR(reproduzida, direta, direta * 0.02f);
+}
+
+TEST_F(TracoTeste, CalibracaoSobreTracoReproduzido) {
+  traco::ParametrosSinteticos p;
+  p.duracaoMs = 2500;
+  p.valorTocado = 16000;
+  for (uint32_t t = 100; t < 2000; t += 200) {
+    p.golpes.push_back({t, 2.0f, 100, 2});
+  }
+  traco::Traco dados = traco::gerarSintetico(p);
+  traco::Reproducao reproducao(dados);
+  reproducao.aplicarCalibracao(sensores);
+  reproducao.instalar();
+
+  EXPECT_TRUE(sensores.calibrarSensorIndividual(2));
+  EXPECT_EQ(sensores.getThreshold(2), (10000 + 16000) / 2);
+}
+
+TEST_F(TracoTeste, ReproducaoEhMaisRapidaQueOTempoReal) {
+  traco::ParametrosSinteticos p;
+  p.duracaoMs = 5000;
+  traco::Traco dados = traco::gerarSintetico(p);
+  traco::Reproducao reproducao(dados);
+  reproducao.instalar();
+
+  auto inicio = std::chrono::steady_clock::now();
+  while (!reproducao.terminou()) {
+    sensores.detectarToque();
+    delay(1);
+  }
+  double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+  EXPECT_LT(real, 5.0 / 10);
+}
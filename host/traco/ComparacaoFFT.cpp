@@ -0,0 +1,73 @@
+#include "ComparacaoFFT.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Sensores.h"
+
+namespace traco {
+
+namespace {
+
+template <class FFT>
+ResultadoFFT executar(const std::vector<float>& sinal, uint32_t amostrasPorJanela) {
+  ResultadoFFT resultado;
+  resultado.nome = FFT::nome();
+  PipelineForca<FFT> pipeline;
+
+  auto inicio = std::chrono::steady_clock::now();
+  float maior = 0;
+  for (size_t i = 0; i < sinal.size(); i++) {
+    maior = std::max(maior, pipeline.processar(sinal[i]));
+    if ((i + 1) % amostrasPorJanela == 0) {
+      resultado.forcas.push_back(maior);
+      maior = 0;
+    }
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio)
+                  .count();
+  resultado.nsPorAmostra = sinal.empty() ? 0 : ns / sinal.size();
+  return resultado;
+}
+
+}  // namespace
+
+std::vector<float> aceleracaoResultante(const Traco& traco, uint32_t periodoUs) {
+  std::vector<float> sinal;
+  size_t proxima = 0;
+  float atual = 0;
+  for (uint32_t t = 0; t < traco.duracaoUs(); t += periodoUs) {
+    while (proxima < traco.imu.size() && traco.imu[proxima].tempoUs <= t) {
+      const simulacao::AmostraIMU& a = traco.imu[proxima].valor;
+      atual = std::sqrt(a.ax * a.ax + a.ay * a.ay + a.az * a.az);
+      proxima++;
+    }
+    sinal.push_back(atual);
+  }
+  return sinal;
+}
+
+std::vector<ResultadoFFT> compararFFT(const Traco& traco, uint32_t amostrasPorJanela) {
+  std::vector<float> sinal = aceleracaoResultante(traco);
+  std::vector<ResultadoFFT> resultados = {
+      executar<FFTArduino<SAMPLES>>(sinal, amostrasPorJanela),
+      executar<FFTPortavel<SAMPLES>>(sinal, amostrasPorJanela),
+      executar<FFTEspDspF32<SAMPLES>>(sinal, amostrasPorJanela),
+      executar<FFTEspDspS16<SAMPLES>>(sinal, amostrasPorJanela),
+  };
+
+  const std::vector<float>& referencia = resultados[0].forcas;
+  for (ResultadoFFT& r : resultados) {
+    double soma = 0;
+    for (size_t i = 0; i < referencia.size(); i++) {
+      float erro = referencia[i] > 0 ? std::fabs(r.forcas[i] - referencia[i]) / referencia[i] : 0;
+      r.erroMaximo = std::max(r.erroMaximo, erro);
+      soma += erro;
+    }
+    r.erroMedio = referencia.empty() ? 0 : soma / referencia.size();
+  }
+  return resultados;
+}
+
+}  // namespace traco
@@ -0,0 +1,35 @@
+/**
+ * @file ComparacaoFFT.h
+ * @brief Precisão e velocidade dos backends de FFT (saco/Espectro.h) num traço
+ *
+ * Alimenta todos os backends com a mesma aceleração resultante do traço,
+ * amostrada a cada 1 ms como no calcularForca(), e mede a força de cada
+ * janela de `amostrasPorJanela` amostras (o maior valor do espectro, como o
+ * detectarPico). O primeiro resultado é sempre a referência (arduinoFFT).
+ */
+#ifndef COMPARACAO_FFT_H
+#define COMPARACAO_FFT_H
+
+#include <string>
+#include <vector>
+
+#include "ReproducaoTraco.h"
+
+namespace traco {
+
+struct ResultadoFFT {
+  std::string nome;
+  std::vector<float> forcas;  // Uma por janela
+  double nsPorAmostra = 0;    // Tempo de host por processar()
+  float erroMaximo = 0;       // Erro relativo à referência, na pior janela
+  float erroMedio = 0;
+};
+
+// Aceleração resultante (g) a cada `periodoUs`, retendo a última amostra
+std::vector<float> aceleracaoResultante(const Traco& traco, uint32_t periodoUs = 1000);
+
+std::vector<ResultadoFFT> compararFFT(const Traco& traco, uint32_t amostrasPorJanela = 1000);
+
+}  // namespace traco
+
+#endif
@@ -0,0 +1,339 @@
+#include "ReproducaoTraco.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include "Sensores.h"
+
+namespace traco {
+
+namespace {
+
+uint32_t lerU32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint16_t lerU16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+float converter(int16_t bruto, float faixa) {
+  return bruto * faixa / 32768.0f;
+}
+
+template <typename T>
+const T* amostraEm(const std::vector<T>& amostras, uint32_t tempoUs) {
+  if (amostras.empty()) {
+    return nullptr;
+  }
+  // Último registro até o instante (antes do primeiro, o primeiro)
+  auto item = std::upper_bound(amostras.begin(), amostras.end(), tempoUs,
+                               [](uint32_t t, const T& a) { return t < a.tempoUs; });
+  return item == amostras.begin() ? &amostras.front() : &*(item - 1);
+}
+
+}  // namespace
+
+std::vector<uint8_t> Traco::desenquadrar(const std::vector<uint8_t>& captura,
+                                         size_t* quadrosInvalidos) {
+  std::vector<uint8_t> saida;
+  size_t invalidos = 0;
+  size_t i = 0;
+  while (i + 4 < captura.size()) {
+    if (captura[i] != TRACO_QUADRO_SYNC1 || captura[i + 1] != TRACO_QUADRO_SYNC2) {
+      i++;
+      continue;
+    }
+    uint16_t tamanho = lerU16(&captura[i + 2]);
+    if (tamanho == 0 || tamanho > TRACO_TAMANHO_BUFFER || i + 4 + tamanho >= captura.size()) {
+      i++;
+      continue;
+    }
+    uint8_t soma = 0;
+    for (size_t k = 0; k < tamanho; k++) {
+      soma += captura[i + 4 + k];
+    }
+    if (soma != captura[i + 4 + tamanho]) {
+      invalidos++;
+      i++;
+      continue;
+    }
+    saida.insert(saida.end(), captura.begin() + i + 4, captura.begin() + i + 4 + tamanho);
+    i += 4 + tamanho + 1;
+  }
+  if (quadrosInvalidos) {
+    *quadrosInvalidos = invalidos;
+  }
+  return saida;
+}
+
+bool Traco::interpretar(const std::vector<uint8_t>& entrada, std::string& erro) {
+  std::vector<uint8_t> desenquadrado;
+  const std::vector<uint8_t>* bytes = &entrada;
+  if (entrada.size() < 4 || lerU32(entrada.data()) != TRACO_MAGICO) {
+    desenquadrado = desenquadrar(entrada);
+    bytes = &desenquadrado;
+  }
+  const std::vector<uint8_t>& dados = *bytes;
+
+  if (dados.size() < 8 || lerU32(dados.data()) != TRACO_MAGICO) {
+    erro = "cabeçalho de traço não encontrado";
+    return false;
+  }
+  uint16_t versao = lerU16(&dados[4]);
+  uint16_t tamanhoCabecalho = lerU16(&dados[6]);
+  if (versao > TRACO_VERSAO) {
+    erro = "versão de traço não suportada: " + std::to_string(versao);
+    return false;
+  }
+  if (tamanhoCabecalho < sizeof(CabecalhoTraco) || dados.size() < tamanhoCabecalho) {
+    erro = "cabeçalho truncado";
+    return false;
+  }
+  memcpy(&cabecalho, dados.data(), sizeof(CabecalhoTraco));
+  if (cabecalho.numSensores > TRACO_MAX_SENSORES) {
+    erro = "número de sensores inválido";
+    return false;
+  }
+
+  toques.clear();
+  imu.clear();
+  marcadores.clear();
+
+  const size_t tamanhoToque = cabecalho.numSensores * sizeof(uint16_t);
+  uint32_t tempo = 0;
+  size_t i = tamanhoCabecalho;
+  while (i + 3 <= dados.size()) {
+    uint8_t tipo = dados[i];
+    tempo += lerU16(&dados[i + 1]);
+    i += 3;
+
+    switch (tipo) {
+      case REGISTRO_TEMPO:
+        if (i + 4 > dados.size()) return true;  // Captura interrompida
+        tempo = lerU32(&dados[i]);
+        i += 4;
+        break;
+      case REGISTRO_TOQUE: {
+        if (i + tamanhoToque > dados.size()) return true;
+        AmostraToque amostra = {};
+        amostra.tempoUs = tempo;
+        for (int s = 0; s < cabecalho.numSensores; s++) {
+          amostra.valores[s] = lerU16(&dados[i + 2 * s]);
+        }
+        toques.push_back(amostra);
+        i += tamanhoToque;
+        break;
+      }
+      case REGISTRO_IMU: {
+        if (i + 12 > dados.size()) return true;
+        int16_t bruto[6];
+        for (int k = 0; k < 6; k++) {
+          bruto[k] = (int16_t)lerU16(&dados[i + 2 * k]);
+        }
+        AmostraIMU amostra;
+        amostra.tempoUs = tempo;
+        amostra.valor.ax = converter(bruto[0], cabecalho.faixaAcelG);
+        amostra.valor.ay = converter(bruto[1], cabecalho.faixaAcelG);
+        amostra.valor.az = converter(bruto[2], cabecalho.faixaAcelG);
+        amostra.valor.gx = converter(bruto[3], cabecalho.faixaGiroDps);
+        amostra.valor.gy = converter(bruto[4], cabecalho.faixaGiroDps);
+        amostra.valor.gz = converter(bruto[5], cabecalho.faixaGiroDps);
+        imu.push_back(amostra);
+        i += 12;
+        break;
+      }
+      case REGISTRO_MARCADOR: {
+        if (i + 1 > dados.size() || i + 1 + dados[i] > dados.size()) return true;
+        uint8_t tamanho = dados[i];
+        marcadores.push_back({tempo, std::string(dados.begin() + i + 1,
+                                                 dados.begin() + i + 1 + tamanho)});
+        i += 1 + tamanho;
+        break;
+      }
+      default:
+        erro = "registro desconhecido na posição " + std::to_string(i - 3);
+        return false;
+    }
+  }
+  return true;
+}
+
+bool Traco::carregar(const std::string& caminho, std::string& erro) {
+  std::ifstream arquivo(caminho, std::ios::binary);
+  if (!arquivo) {
+    erro = "não foi possível abrir " + caminho;
+    return false;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(arquivo)),
+                             std::istreambuf_iterator<char>());
+  return interpretar(bytes, erro);
+}
+
+std::vector<uint8_t> Traco::serializar() const {
+  BufferTraco buffer;
+  GravadorTraco gravador;
+  gravador.iniciar(buffer, cabecalho, false);
+
+  // Intercala os três tipos em ordem de tempo
+  size_t t = 0, m = 0, k = 0;
+  while (t < toques.size() || m < imu.size() || k < marcadores.size()) {
+    uint32_t proximoToque = t < toques.size() ? toques[t].tempoUs : UINT32_MAX;
+    uint32_t proximoIMU = m < imu.size() ? imu[m].tempoUs : UINT32_MAX;
+    uint32_t proximoMarcador = k < marcadores.size() ? marcadores[k].tempoUs : UINT32_MAX;
+    if (proximoMarcador <= proximoToque && proximoMarcador <= proximoIMU) {
+      gravador.registrarMarcador(proximoMarcador, marcadores[k++].texto.c_str());
+    } else if (proximoIMU <= proximoToque) {
+      const simulacao::AmostraIMU& v = imu[m++].valor;
+      gravador.registrarIMU(proximoIMU, v.ax, v.ay, v.az, v.gx, v.gy, v.gz);
+    } else {
+      gravador.registrarToque(proximoToque, toques[t++].valores);
+    }
+  }
+  gravador.finalizar();
+  return buffer.bytes;
+}
+
+bool Traco::salvar(const std::string& caminho) const {
+  std::vector<uint8_t> bytes = serializar();
+  std::ofstream arquivo(caminho, std::ios::binary);
+  arquivo.write((const char*)bytes.data(), bytes.size());
+  return (bool)arquivo;
+}
+
+uint32_t Traco::duracaoUs() const {
+  uint32_t fim = 0;
+  if (!toques.empty()) fim = std::max(fim, toques.back().tempoUs);
+  if (!imu.empty()) fim = std::max(fim, imu.back().tempoUs);
+  if (!marcadores.empty()) fim = std::max(fim, marcadores.back().tempoUs);
+  return fim;
+}
+
+int Traco::indiceDoPino(uint8_t pino) const {
+  for (int i = 0; i < cabecalho.numSensores; i++) {
+    if (cabecalho.pinos[i] == pino) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+Traco gerarSintetico(const ParametrosSinteticos& p) {
+  Sensores mapa;  // Só para o mapa de pinos do firmware
+
+  CabecalhoTraco cabecalho = {};
+  cabecalho.magico = TRACO_MAGICO;
+  cabecalho.versao = TRACO_VERSAO;
+  cabecalho.tamanhoCabecalho = sizeof(CabecalhoTraco);
+  cabecalho.numSensores = NUM_SENSORES;
+  cabecalho.faixaAcelG = FAIXA_ACEL_G;
+  cabecalho.faixaGiroDps = FAIXA_GIRO_DPS;
+  cabecalho.taxaToqueHz = p.taxaToqueHz;
+  cabecalho.taxaIMUHz = p.taxaIMUHz;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    cabecalho.pinos[i] = mapa.getPino(i);
+    cabecalho.baseline[i] = p.baselineToque;
+    cabecalho.threshold[i] = (p.baselineToque + p.valorTocado) / 2;
+  }
+
+  std::mt19937 gerador(p.semente);
+  std::normal_distribution<float> ruido(0.0f, p.ruidoG);
+
+  BufferTraco buffer;
+  GravadorTraco gravador;
+  gravador.iniciar(buffer, cabecalho, false);
+
+  uint32_t passoIMU = 1000000 / p.taxaIMUHz;
+  uint32_t passoToque = 1000000 / p.taxaToqueHz;
+  uint32_t proximoToque = 0;
+  for (uint32_t t = 0; t <= p.duracaoMs * 1000; t += passoIMU) {
+    float ax = 0;
+    uint16_t toques[NUM_SENSORES];
+    std::fill(toques, toques + NUM_SENSORES, p.baselineToque);
+
+    for (const GolpeSintetico& golpe : p.golpes) {
+      uint32_t inicio = golpe.tempoMs * 1000;
+      uint32_t duracao = golpe.duracaoMs * 1000;
+      if (t >= inicio && t < inicio + duracao) {
+        ax += golpe.intensidadeG * sinf((float)M_PI * (t - inicio) / duracao);
+        if (golpe.pad >= 0 && golpe.pad < NUM_SENSORES) {
+          toques[golpe.pad] = p.valorTocado;
+        }
+      }
+    }
+
+    gravador.registrarIMU(t, ax + ruido(gerador), ruido(gerador), 1.0f + ruido(gerador),
+                          0, 0, 0);
+    if (t >= proximoToque) {
+      gravador.registrarToque(t, toques);
+      proximoToque += passoToque;
+    }
+  }
+  for (const GolpeSintetico& golpe : p.golpes) {
+    gravador.registrarMarcador(golpe.tempoMs * 1000, "golpe");
+  }
+  gravador.finalizar();
+
+  Traco traco;
+  std::string erro;
+  traco.interpretar(buffer.bytes, erro);
+  return traco;
+}
+
+Reproducao::Reproducao(const Traco& traco) : traco(traco) {}
+
+Reproducao::~Reproducao() {
+  remover();
+}
+
+void Reproducao::instalar(uint64_t inicio) {
+  inicioUs = inicio;
+  instalada = true;
+  const Traco* dados = &traco;
+
+  simulacao::definirFonteToque([dados, inicio](uint8_t pino, uint64_t agora) -> uint16_t {
+    int indice = dados->indiceDoPino(pino);
+    const AmostraToque* amostra =
+        amostraEm(dados->toques, (uint32_t)(agora > inicio ? agora - inicio : 0));
+    return (indice < 0 || amostra == nullptr) ? 0 : amostra->valores[indice];
+  });
+  simulacao::definirFonteIMU([dados, inicio](uint64_t agora) {
+    const AmostraIMU* amostra =
+        amostraEm(dados->imu, (uint32_t)(agora > inicio ? agora - inicio : 0));
+    simulacao::AmostraIMU repouso = {0, 0, 1, 0, 0, 0};
+    return amostra ? amostra->valor : repouso;
+  });
+}
+
+void Reproducao::remover() {
+  if (instalada) {
+    simulacao::definirFonteToque(nullptr);
+    simulacao::definirFonteIMU(nullptr);
+    instalada = false;
+  }
+}
+
+bool Reproducao::terminou() const {
+  return simulacao::agoraUs() - inicioUs > traco.duracaoUs();
+}
+
+void Reproducao::aplicarCalibracao(Sensores& sensores) const {
+  for (int i = 0; i < traco.cabecalho.numSensores && i < NUM_SENSORES; i++) {
+    int indice = -1;
+    for (int s = 0; s < NUM_SENSORES; s++) {
+      if (sensores.getPino(s) == traco.cabecalho.pinos[i]) {
+        indice = s;
+      }
+    }
+    if (indice >= 0) {
+      sensores.definirCalibracao(indice, traco.cabecalho.baseline[i],
+                                 traco.cabecalho.threshold[i]);
+    }
+  }
+}
+
+}  // namespace traco
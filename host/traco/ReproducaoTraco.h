@@ -0,0 +1,119 @@
+/**
+ * @file ReproducaoTraco.h
+ * @brief Leitura, síntese e reprodução de traços dos sensores no build nativo
+ *
+ * O formato é o de saco/Traco.h. A reprodução instala o traço como fonte
+ * dos toques e da IMU simulados (amostra e retém entre registros); com o
+ * relógio virtual o Sensores consome o traço muito mais rápido que o tempo
+ * real, sempre com o mesmo resultado.
+ */
+#ifndef REPRODUCAO_TRACO_H
+#define REPRODUCAO_TRACO_H
+
+#include <string>
+#include <vector>
+
+#include "Sensores.h"
+#include "Traco.h"
+#include "Simulacao.h"
+
+namespace traco {
+
+struct AmostraToque {
+  uint32_t tempoUs;
+  uint16_t valores[TRACO_MAX_SENSORES];
+};
+
+struct AmostraIMU {
+  uint32_t tempoUs;
+  simulacao::AmostraIMU valor;
+};
+
+struct Marcador {
+  uint32_t tempoUs;
+  std::string texto;
+};
+
+// Destino em memória para o GravadorTraco
+class BufferTraco : public Print {
+public:
+  size_t write(uint8_t c) override {
+    bytes.push_back(c);
+    return 1;
+  }
+  size_t write(const uint8_t* dados, size_t quantidade) override {
+    bytes.insert(bytes.end(), dados, dados + quantidade);
+    return quantidade;
+  }
+  using Print::write;
+
+  std::vector<uint8_t> bytes;
+};
+
+class Traco {
+public:
+  CabecalhoTraco cabecalho = {};
+  std::vector<AmostraToque> toques;
+  std::vector<AmostraIMU> imu;
+  std::vector<Marcador> marcadores;
+
+  // Aceita o traço cru (flash) ou uma captura da serial com quadros e logs
+  bool interpretar(const std::vector<uint8_t>& bytes, std::string& erro);
+  bool carregar(const std::string& caminho, std::string& erro);
+  bool salvar(const std::string& caminho) const;
+  std::vector<uint8_t> serializar() const;
+
+  uint32_t duracaoUs() const;
+  int indiceDoPino(uint8_t pino) const;
+
+  // Extrai o conteúdo dos quadros de uma captura serial
+  static std::vector<uint8_t> desenquadrar(const std::vector<uint8_t>& captura,
+                                           size_t* quadrosInvalidos = nullptr);
+};
+
+struct GolpeSintetico {
+  uint32_t tempoMs;
+  float intensidadeG;  // Pico do meio-seno na aceleração
+  uint16_t duracaoMs;
+  int pad;             // Pad tocado (-1: nenhum)
+};
+
+struct ParametrosSinteticos {
+  uint32_t duracaoMs = 5000;
+  uint16_t taxaIMUHz = 1000;
+  uint16_t taxaToqueHz = 100;
+  uint16_t baselineToque = 10000;
+  uint16_t valorTocado = 30000;
+  float ruidoG = 0.02f;
+  uint32_t semente = 1;
+  std::vector<GolpeSintetico> golpes;
+};
+
+// Traço com golpes em meio-seno no eixo X e toques nos pads indicados,
+// gerado com o próprio GravadorTraco
+Traco gerarSintetico(const ParametrosSinteticos& parametros);
+
+class Reproducao {
+public:
+  explicit Reproducao(const Traco& traco);
+  ~Reproducao();
+
+  // O traço começa em inicioUs do relógio simulado
+  void instalar(uint64_t inicioUs);
+  void instalar() { instalar(simulacao::agoraUs()); }
+  void remover();
+  bool terminou() const;
+  uint64_t inicio() const { return inicioUs; }
+
+  // Baseline e limites gravados no cabeçalho
+  void aplicarCalibracao(Sensores& sensores) const;
+
+private:
+  const Traco& traco;
+  uint64_t inicioUs = 0;
+  bool instalada = false;
+};
+
+}  // namespace traco
+
+#endif
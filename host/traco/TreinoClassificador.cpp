@@ -0,0 +1,542 @@
+#include "TreinoClassificador.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "Captura.h"
+#include "Round.h"
+#include "Sensores.h"
+
+namespace traco {
+
+namespace {
+
+const uint32_t INTERVALO_GOLPES_MS = 400;
+const uint32_t INICIO_GOLPES_MS = 300;
+const uint16_t BASELINE_TOQUE = 10000;
+const uint16_t VALOR_TOCADO = 30000;
+const float ESCALA_ENTRADA = 32.0f;  // q = z · 32: ±4 desvios cabem no int8
+
+// Índices de Sensores::nomesSensores
+enum Pad { FrenteAlta, FrenteBaixa, DireitaBaixa, DireitaAlta, EsquerdaBaixa, EsquerdaAlta,
+           TrasAlta, TrasBaixa, Centro };
+
+struct FormaGolpe {
+  float direcao[3];
+  float intensidadeG;
+  float duracaoMs;
+  float anel;          // Vibração de 150 Hz do impacto seco, fração da intensidade
+  float giroDps[3];
+  int pad;
+};
+
+int sortearPad(std::mt19937& gerador, std::initializer_list<std::pair<int, float>> opcoes) {
+  float sorteio = std::uniform_real_distribution<float>(0, 1)(gerador);
+  for (const auto& opcao : opcoes) {
+    if (sorteio < opcao.second) {
+      return opcao.first;
+    }
+    sorteio -= opcao.second;
+  }
+  return -1;
+}
+
+// Faixas de uma base destra vista de frente para o saco: X para dentro do
+// saco, Y para a direita, Z para cima (os eixos do POSICAO_PADS)
+FormaGolpe sortearForma(TipoGolpe tipo, std::mt19937& gerador) {
+  auto uniforme = [&gerador](float a, float b) {
+    return std::uniform_real_distribution<float>(a, b)(gerador);
+  };
+  auto normal = [&gerador](float desvio) {
+    return std::normal_distribution<float>(0, desvio)(gerador);
+  };
+  FormaGolpe f;
+  float lado = uniforme(0, 1) < 0.7f ? 1.0f : -1.0f;  // Mão da frente ou de trás
+  switch (tipo) {
+    case TipoGolpe::Jab:
+      f = {{1, -0.15f + normal(0.1f), 0.05f + normal(0.1f)}, uniforme(2.5f, 5.5f),
+           uniforme(10, 18), uniforme(0.2f, 0.4f), {normal(20), normal(20), uniforme(-60, 60)}, 0};
+      f.pad = sortearPad(gerador, {{FrenteAlta, 0.65f}, {Centro, 0.2f}, {FrenteBaixa, 0.05f}});
+      break;
+    case TipoGolpe::Direto:
+      f = {{1, 0.15f + normal(0.1f), normal(0.1f)}, uniforme(5, 10), uniforme(16, 28),
+           uniforme(0.1f, 0.3f), {normal(30), normal(30), -uniforme(40, 160)}, 0};
+      f.pad = sortearPad(gerador, {{FrenteAlta, 0.55f}, {Centro, 0.3f}});
+      break;
+    case TipoGolpe::Gancho:
+      // Pela lateral: a mão da frente acerta a face esquerda e empurra para +Y
+      f = {{0.35f + normal(0.15f), lado, normal(0.15f)}, uniforme(4, 9), uniforme(20, 35),
+           uniforme(0, 0.15f), {normal(40), normal(40), lado * uniforme(150, 400)}, 0};
+      f.pad = lado > 0 ? sortearPad(gerador, {{EsquerdaAlta, 0.7f}, {EsquerdaBaixa, 0.1f}})
+                       : sortearPad(gerador, {{DireitaAlta, 0.7f}, {DireitaBaixa, 0.1f}});
+      break;
+    default:
+      f = {{0.4f + normal(0.15f), normal(0.2f), 1}, uniforme(3, 8), uniforme(20, 35),
+           uniforme(0, 0.15f), {normal(40), lado * uniforme(120, 320), normal(60)}, 0};
+      f.pad = sortearPad(gerador, {{FrenteBaixa, 0.6f}, {Centro, 0.15f}, {DireitaBaixa, 0.05f},
+                                   {EsquerdaBaixa, 0.05f}});
+      break;
+  }
+  float norma = sqrtf(f.direcao[0] * f.direcao[0] + f.direcao[1] * f.direcao[1] +
+                      f.direcao[2] * f.direcao[2]);
+  for (int i = 0; i < 3; i++) {
+    f.direcao[i] /= norma;
+  }
+  return f;
+}
+
+// Aceleração dinâmica (g, ao longo da direção) t ms depois do início
+float perfil(const FormaGolpe& f, float t) {
+  float valor = 0;
+  if (t < f.duracaoMs) {
+    valor += f.intensidadeG * sinf((float)M_PI * t / f.duracaoMs);
+    valor += f.anel * f.intensidadeG * expf(-t / 5.0f) * sinf(2 * (float)M_PI * 0.15f * t);
+  } else if (t < 3 * f.duracaoMs) {
+    // Rebote do saco
+    valor -= 0.25f * f.intensidadeG * sinf((float)M_PI * (t - f.duracaoMs) / (2 * f.duracaoMs));
+  }
+  return valor;
+}
+
+float limitar(float valor, float limite) {
+  return valor > limite ? limite : (valor < -limite ? -limite : valor);
+}
+
+void quantizarEntrada(const ModeloTreinado& m, const float x[NUM_CARACTERISTICAS],
+                      float z[NUM_CARACTERISTICAS]) {
+  for (int i = 0; i < NUM_CARACTERISTICAS; i++) {
+    z[i] = limitar(roundf((x[i] - m.media[i]) * m.escala[i]), 127) / ESCALA_ENTRADA;
+  }
+}
+
+// Camada oculta e saídas do modelo float
+void propagar(const ModeloTreinado& m, const float z[NUM_CARACTERISTICAS], float* oculta,
+              float saidas[NUM_TIPOS_GOLPE]) {
+  for (int j = 0; j < m.ocultos; j++) {
+    float soma = m.vies1Float[j];
+    for (int i = 0; i < NUM_CARACTERISTICAS; i++) {
+      soma += m.pesos1Float[j * NUM_CARACTERISTICAS + i] * z[i];
+    }
+    oculta[j] = soma > 0 ? soma : 0;
+  }
+  for (int k = 0; k < NUM_TIPOS_GOLPE; k++) {
+    float soma = m.vies2Float[k];
+    for (int j = 0; j < m.ocultos; j++) {
+      soma += m.pesos2Float[k * m.ocultos + j] * oculta[j];
+    }
+    saidas[k] = soma;
+  }
+}
+
+struct Adam {
+  std::vector<float> m, v;
+
+  explicit Adam(size_t tamanho) : m(tamanho, 0), v(tamanho, 0) {}
+
+  void aplicar(std::vector<float>& parametros, const std::vector<float>& gradiente, float taxa,
+               uint32_t t) {
+    const float b1 = 0.9f, b2 = 0.999f;
+    for (size_t i = 0; i < parametros.size(); i++) {
+      m[i] = b1 * m[i] + (1 - b1) * gradiente[i];
+      v[i] = b2 * v[i] + (1 - b2) * gradiente[i] * gradiente[i];
+      float mc = m[i] / (1 - powf(b1, (float)t));
+      float vc = v[i] / (1 - powf(b2, (float)t));
+      parametros[i] -= taxa * mc / (sqrtf(vc) + 1e-8f);
+    }
+  }
+};
+
+float maiorAbsoluto(const std::vector<float>& valores) {
+  float maior = 0;
+  for (float v : valores) {
+    maior = std::max(maior, fabsf(v));
+  }
+  return maior > 0 ? maior : 1.0f;
+}
+
+}  // namespace
+
+Traco gerarGolpesTipo(TipoGolpe tipo, uint32_t quantidade, uint32_t semente) {
+  Sensores mapa;  // Só para o mapa de pinos do firmware
+
+  CabecalhoTraco cabecalho = {};
+  cabecalho.magico = TRACO_MAGICO;
+  cabecalho.versao = TRACO_VERSAO;
+  cabecalho.tamanhoCabecalho = sizeof(CabecalhoTraco);
+  cabecalho.numSensores = NUM_SENSORES;
+  cabecalho.faixaAcelG = FAIXA_ACEL_G;
+  cabecalho.faixaGiroDps = FAIXA_GIRO_DPS;
+  cabecalho.taxaToqueHz = 100;
+  cabecalho.taxaIMUHz = 1000;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    cabecalho.pinos[i] = mapa.getPino(i);
+    cabecalho.baseline[i] = BASELINE_TOQUE;
+    cabecalho.threshold[i] = (BASELINE_TOQUE + VALOR_TOCADO) / 2;
+  }
+
+  std::mt19937 gerador(semente * 4 + (uint32_t)tipo);
+  std::normal_distribution<float> ruidoG(0.0f, 0.03f);
+  std::normal_distribution<float> ruidoDps(0.0f, 3.0f);
+
+  // Saco levemente inclinado: a gravidade não fica só em Z
+  float inclinacao = std::uniform_real_distribution<float>(0, 0.15f)(gerador);
+  float gravidade[3] = {sinf(inclinacao), 0, cosf(inclinacao)};
+
+  std::vector<FormaGolpe> formas;
+  for (uint32_t i = 0; i < quantidade; i++) {
+    formas.push_back(sortearForma(tipo, gerador));
+  }
+
+  BufferTraco buffer;
+  GravadorTraco gravador;
+  gravador.iniciar(buffer, cabecalho, false);
+
+  uint32_t duracaoMs = INICIO_GOLPES_MS + quantidade * INTERVALO_GOLPES_MS;
+  for (uint32_t ms = 0; ms < duracaoMs; ms++) {
+    float a[3] = {gravidade[0], gravidade[1], gravidade[2]};
+    float g[3] = {0, 0, 0};
+    uint16_t toques[NUM_SENSORES];
+    std::fill(toques, toques + NUM_SENSORES, BASELINE_TOQUE);
+
+    if (ms >= INICIO_GOLPES_MS) {
+      uint32_t indice = (ms - INICIO_GOLPES_MS) / INTERVALO_GOLPES_MS;
+      float t = (float)((ms - INICIO_GOLPES_MS) % INTERVALO_GOLPES_MS);
+      const FormaGolpe& f = formas[indice];
+      float valor = perfil(f, t);
+      for (int i = 0; i < 3; i++) {
+        a[i] += f.direcao[i] * valor;
+        if (t < 2 * f.duracaoMs) {
+          g[i] = f.giroDps[i] * sinf((float)M_PI * t / (2 * f.duracaoMs));
+        }
+      }
+      if (f.pad >= 0 && t < 30) {
+        toques[f.pad] = VALOR_TOCADO;
+      }
+    }
+
+    uint32_t tempoUs = ms * 1000;
+    gravador.registrarIMU(tempoUs, a[0] + ruidoG(gerador), a[1] + ruidoG(gerador),
+                          a[2] + ruidoG(gerador), g[0] + ruidoDps(gerador),
+                          g[1] + ruidoDps(gerador), g[2] + ruidoDps(gerador));
+    if (ms % 10 == 0) {
+      gravador.registrarToque(tempoUs, toques);
+    }
+  }
+  gravador.finalizar();
+
+  Traco traco;
+  std::string erro;
+  traco.interpretar(buffer.bytes, erro);
+  return traco;
+}
+
+std::vector<ExemploGolpe> extrairExemplos(const Traco& traco, TipoGolpe rotulo) {
+  Sensores mapa;
+  int indices[NUM_SENSORES];
+  int limites[NUM_SENSORES];
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    indices[i] = traco.indiceDoPino(mapa.getPino(i));
+    limites[i] = indices[i] >= 0 ? traco.cabecalho.threshold[indices[i]] : INT_MAX;
+  }
+
+  // Mesma sequência da tarefaRound: toques, segmentador e extrator
+  std::vector<ExemploGolpe> exemplos;
+  SegmentadorGolpes segmentador;
+  ExtratorGolpe extrator;
+  size_t proximoToque = 0;
+  for (const AmostraIMU& amostra : traco.imu) {
+    uint32_t ms = amostra.tempoUs / 1000;
+    while (proximoToque < traco.toques.size() &&
+           traco.toques[proximoToque].tempoUs <= amostra.tempoUs) {
+      uint16_t valores[NUM_SENSORES];
+      for (int i = 0; i < NUM_SENSORES; i++) {
+        valores[i] = indices[i] >= 0 ? traco.toques[proximoToque].valores[indices[i]] : 0;
+      }
+      segmentador.adicionarToques(traco.toques[proximoToque].tempoUs / 1000, valores, limites);
+      proximoToque++;
+    }
+
+    const simulacao::AmostraIMU& v = amostra.valor;
+    xyzFloat a;
+    a.x = v.ax;
+    a.y = v.ay;
+    a.z = v.az;
+    GolpeSegmentado golpe;
+    bool terminou = segmentador.adicionarIMU(ms, a, golpe);
+    if (segmentador.emGolpe()) {
+      AmostraGolpe s = {amostra.tempoUs, v.ax, v.ay, v.az, v.gx, v.gy, v.gz};
+      extrator.adicionar(s);
+    } else if (terminou) {
+      ExemploGolpe exemplo;
+      extrator.finalizar(golpe.pad, exemplo.x);
+      exemplo.tipo = rotulo;
+      exemplos.push_back(exemplo);
+    } else {
+      extrator.repouso(v.ax, v.ay, v.az);
+    }
+  }
+  return exemplos;
+}
+
+std::vector<ExemploGolpe> exemplosSinteticos(uint32_t porTipo, uint32_t semente) {
+  std::vector<ExemploGolpe> exemplos;
+  for (int t = 0; t < NUM_TIPOS_GOLPE; t++) {
+    TipoGolpe tipo = (TipoGolpe)t;
+    std::vector<ExemploGolpe> doTipo = extrairExemplos(gerarGolpesTipo(tipo, porTipo, semente), tipo);
+    exemplos.insert(exemplos.end(), doTipo.begin(), doTipo.end());
+  }
+  return exemplos;
+}
+
+ModeloGolpes ModeloTreinado::tabelas() const {
+  ModeloGolpes t = {media.data(), escala.data(), ocultos, pesos1.data(), vies1.data(),
+                    multiplicador1, deslocamento1, pesos2.data(), vies2.data()};
+  return t;
+}
+
+TipoGolpe ModeloTreinado::classificarFloat(const float x[NUM_CARACTERISTICAS]) const {
+  float z[NUM_CARACTERISTICAS];
+  std::vector<float> oculta(ocultos);
+  float saidas[NUM_TIPOS_GOLPE];
+  quantizarEntrada(*this, x, z);
+  propagar(*this, z, oculta.data(), saidas);
+  return (TipoGolpe)(std::max_element(saidas, saidas + NUM_TIPOS_GOLPE) - saidas);
+}
+
+ModeloTreinado treinar(const std::vector<ExemploGolpe>& exemplos, const ParametrosTreino& p) {
+  ModeloTreinado m;
+  m.ocultos = std::min<uint8_t>(p.ocultos, CLASSIFICADOR_MAX_OCULTOS);
+  const int H = m.ocultos;
+  const int N = NUM_CARACTERISTICAS;
+  const int K = NUM_TIPOS_GOLPE;
+
+  // Padronização: média e desvio de cada característica
+  m.media.assign(N, 0);
+  m.escala.assign(N, 0);
+  for (const ExemploGolpe& e : exemplos) {
+    for (int i = 0; i < N; i++) m.media[i] += e.x[i];
+  }
+  for (int i = 0; i < N; i++) m.media[i] /= std::max<size_t>(exemplos.size(), 1);
+  for (int i = 0; i < N; i++) {
+    double variancia = 0;
+    for (const ExemploGolpe& e : exemplos) variancia += (e.x[i] - m.media[i]) * (e.x[i] - m.media[i]);
+    float desvio = sqrtf(variancia / std::max<size_t>(exemplos.size(), 1));
+    m.escala[i] = desvio > 1e-6f ? ESCALA_ENTRADA / desvio : 0;
+  }
+
+  // O treino já vê a entrada quantizada, como a inferência no saco
+  std::vector<std::vector<float>> entradas(exemplos.size(), std::vector<float>(N));
+  for (size_t e = 0; e < exemplos.size(); e++) {
+    quantizarEntrada(m, exemplos[e].x, entradas[e].data());
+  }
+
+  std::mt19937 gerador(p.semente);
+  std::normal_distribution<float> inicial1(0, sqrtf(2.0f / N));
+  std::normal_distribution<float> inicial2(0, sqrtf(2.0f / H));
+  m.pesos1Float.resize(H * N);
+  m.vies1Float.assign(H, 0);
+  m.pesos2Float.resize(K * H);
+  m.vies2Float.assign(K, 0);
+  for (float& w : m.pesos1Float) w = inicial1(gerador);
+  for (float& w : m.pesos2Float) w = inicial2(gerador);
+
+  Adam adamW1(H * N), adamB1(H), adamW2(K * H), adamB2(K);
+  std::vector<float> gW1(H * N), gB1(H), gW2(K * H), gB2(K);
+  std::vector<float> oculta(H), erroOculta(H);
+  std::vector<size_t> ordem(exemplos.size());
+  for (size_t i = 0; i < ordem.size(); i++) ordem[i] = i;
+
+  uint32_t passo = 0;
+  for (uint32_t epoca = 0; epoca < p.epocas; epoca++) {
+    std::shuffle(ordem.begin(), ordem.end(), gerador);
+    for (size_t inicio = 0; inicio < ordem.size(); inicio += p.lote) {
+      size_t fim = std::min(ordem.size(), inicio + p.lote);
+      std::fill(gW1.begin(), gW1.end(), 0);
+      std::fill(gB1.begin(), gB1.end(), 0);
+      std::fill(gW2.begin(), gW2.end(), 0);
+      std::fill(gB2.begin(), gB2.end(), 0);
+      for (size_t b = inicio; b < fim; b++) {
+        const std::vector<float>& z = entradas[ordem[b]];
+        float saidas[NUM_TIPOS_GOLPE];
+        propagar(m, z.data(), oculta.data(), saidas);
+
+        // Softmax e gradiente da entropia cruzada
+        float maior = *std::max_element(saidas, saidas + K);
+        float soma = 0;
+        for (int k = 0; k < K; k++) {
+          saidas[k] = expf(saidas[k] - maior);
+          soma += saidas[k];
+        }
+        std::fill(erroOculta.begin(), erroOculta.end(), 0);
+        for (int k = 0; k < K; k++) {
+          float erro = saidas[k] / soma - (k == (int)exemplos[ordem[b]].tipo ? 1 : 0);
+          gB2[k] += erro;
+          for (int j = 0; j < H; j++) {
+            gW2[k * H + j] += erro * oculta[j];
+            erroOculta[j] += erro * m.pesos2Float[k * H + j];
+          }
+        }
+        for (int j = 0; j < H; j++) {
+          if (oculta[j] <= 0) continue;
+          gB1[j] += erroOculta[j];
+          for (int i = 0; i < N; i++) {
+            gW1[j * N + i] += erroOculta[j] * z[i];
+          }
+        }
+      }
+      float n = (float)(fim - inicio);
+      for (float& g : gW1) g /= n;
+      for (float& g : gB1) g /= n;
+      for (float& g : gW2) g /= n;
+      for (float& g : gB2) g /= n;
+      passo++;
+      adamW1.aplicar(m.pesos1Float, gW1, p.taxa, passo);
+      adamB1.aplicar(m.vies1Float, gB1, p.taxa, passo);
+      adamW2.aplicar(m.pesos2Float, gW2, p.taxa, passo);
+      adamB2.aplicar(m.vies2Float, gB2, p.taxa, passo);
+    }
+  }
+
+  // Quantização por camada. Entrada: z = q / 32
+  const float escalaEntrada = 1.0f / ESCALA_ENTRADA;
+  float escalaPesos1 = maiorAbsoluto(m.pesos1Float) / 127;
+  m.pesos1.resize(H * N);
+  m.vies1.resize(H);
+  for (int i = 0; i < H * N; i++) {
+    m.pesos1[i] = (int8_t)limitar(roundf(m.pesos1Float[i] / escalaPesos1), 127);
+  }
+  for (int j = 0; j < H; j++) {
+    m.vies1[j] = (int32_t)lroundf(m.vies1Float[j] / (escalaPesos1 * escalaEntrada));
+  }
+
+  // A maior ativação da camada oculta nos exemplos vira 127
+  float maiorOculta = 0;
+  for (const std::vector<float>& z : entradas) {
+    float saidas[NUM_TIPOS_GOLPE];
+    propagar(m, z.data(), oculta.data(), saidas);
+    for (float h : oculta) maiorOculta = std::max(maiorOculta, h);
+  }
+  float escalaOculta = maiorOculta > 0 ? maiorOculta / 127 : 1.0f;
+
+  // h = acc · M com M = multiplicador / 2^deslocamento, multiplicador em [2^30, 2^31)
+  double fator = (double)escalaPesos1 * escalaEntrada / escalaOculta;
+  int deslocamento = 0;
+  while (deslocamento < 62 && fator * std::ldexp(1.0, deslocamento + 1) < 2147483647.0) {
+    deslocamento++;
+  }
+  m.deslocamento1 = (uint8_t)deslocamento;
+  m.multiplicador1 = (int32_t)llround(fator * std::ldexp(1.0, deslocamento));
+
+  float escalaPesos2 = maiorAbsoluto(m.pesos2Float) / 127;
+  m.pesos2.resize(K * H);
+  m.vies2.resize(K);
+  for (int i = 0; i < K * H; i++) {
+    m.pesos2[i] = (int8_t)limitar(roundf(m.pesos2Float[i] / escalaPesos2), 127);
+  }
+  for (int k = 0; k < K; k++) {
+    m.vies2[k] = (int32_t)lroundf(m.vies2Float[k] / (escalaPesos2 * escalaOculta));
+  }
+  return m;
+}
+
+AvaliacaoClassificador avaliar(const ModeloGolpes& modelo, const std::vector<ExemploGolpe>& exemplos,
+                               const ModeloTreinado* flutuante) {
+  AvaliacaoClassificador a;
+  ClassificadorGolpes classificador(modelo);
+  uint32_t acertos = 0, acertosFloat = 0, iguais = 0;
+  for (const ExemploGolpe& e : exemplos) {
+    TipoGolpe previsto = classificador.classificar(e.x);
+    a.confusao[(int)e.tipo][(int)previsto]++;
+    acertos += previsto == e.tipo;
+    if (flutuante) {
+      TipoGolpe previstoFloat = flutuante->classificarFloat(e.x);
+      acertosFloat += previstoFloat == e.tipo;
+      iguais += previstoFloat == previsto;
+    }
+  }
+  a.total = exemplos.size();
+  if (a.total) {
+    a.acuracia = (float)acertos / a.total;
+    a.acuraciaFloat = flutuante ? (float)acertosFloat / a.total : 0;
+    a.concordancia = flutuante ? (float)iguais / a.total : 0;
+
+    // Tempo de inferência: repete até somar alguns milissegundos
+    uint32_t repeticoes = 0;
+    volatile int soma = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds decorrido(0);
+    while (decorrido < std::chrono::milliseconds(20)) {
+      for (const ExemploGolpe& e : exemplos) {
+        soma = soma + (int)classificador.classificar(e.x);
+      }
+      repeticoes += a.total;
+      decorrido = std::chrono::steady_clock::now() - inicio;
+    }
+    a.nsPorGolpe = (double)decorrido.count() / repeticoes;
+  }
+  return a;
+}
+
+bool escreverModelo(const ModeloTreinado& m, const std::string& caminho, const std::string& origem,
+                    bool gravado) {
+  FILE* saida = fopen(caminho.c_str(), "w");
+  if (!saida) {
+    return false;
+  }
+  // "saco" → ModeloGolpesSaco.h, MODELO_GOLPES_SACO_H
+  std::string placa = PlacaAtual::NOME;
+  std::string arquivo = placa, guarda = placa;
+  arquivo[0] = toupper(arquivo[0]);
+  std::transform(guarda.begin(), guarda.end(), guarda.begin(), ::toupper);
+  const int N = NUM_CARACTERISTICAS;
+  fprintf(saida,
+          "/**\n"
+          " * @file ModeloGolpes%s.h\n"
+          " * @brief Tabelas int8 do classificador de golpes da placa %s (ver Classificador.h)\n"
+          " *\n"
+          " * Gerado por host/ferramentas/treinar_classificador; não editar.\n"
+          " * Origem: %s\n"
+          " */\n"
+          "#ifndef MODELO_GOLPES_%s_H\n"
+          "#define MODELO_GOLPES_%s_H\n\n"
+          "#include <stdint.h>\n\n"
+          "#define MODELO_GOLPES_OCULTOS %d\n"
+          "#define MODELO_GOLPES_GRAVADO %d   // 1: treinado com traços gravados no saco\n\n",
+          arquivo.c_str(), placa.c_str(), origem.c_str(), guarda.c_str(), guarda.c_str(),
+          m.ocultos, gravado ? 1 : 0);
+
+  fprintf(saida, "constexpr float MODELO_GOLPES_MEDIA[%d] = {", N);
+  for (int i = 0; i < N; i++) fprintf(saida, "%s%.6ef", i ? ", " : "", m.media[i]);
+  fprintf(saida, "};\nconstexpr float MODELO_GOLPES_ESCALA[%d] = {", N);
+  for (int i = 0; i < N; i++) fprintf(saida, "%s%.6ef", i ? ", " : "", m.escala[i]);
+  fprintf(saida, "};\n\n");
+
+  fprintf(saida, "constexpr int8_t MODELO_GOLPES_PESOS1[%d][%d] = {\n", m.ocultos, N);
+  for (int j = 0; j < m.ocultos; j++) {
+    fprintf(saida, "  {");
+    for (int i = 0; i < N; i++) fprintf(saida, "%s%d", i ? ", " : "", m.pesos1[j * N + i]);
+    fprintf(saida, "},\n");
+  }
+  fprintf(saida, "};\nconstexpr int32_t MODELO_GOLPES_VIES1[%d] = {", m.ocultos);
+  for (int j = 0; j < m.ocultos; j++) fprintf(saida, "%s%d", j ? ", " : "", m.vies1[j]);
+  fprintf(saida, "};\nconstexpr int32_t MODELO_GOLPES_MULTIPLICADOR1 = %d;\n", m.multiplicador1);
+  fprintf(saida, "constexpr uint8_t MODELO_GOLPES_DESLOCAMENTO1 = %d;\n\n", m.deslocamento1);
+
+  fprintf(saida, "constexpr int8_t MODELO_GOLPES_PESOS2[%d][%d] = {\n", NUM_TIPOS_GOLPE, m.ocultos);
+  for (int k = 0; k < NUM_TIPOS_GOLPE; k++) {
+    fprintf(saida, "  {");
+    for (int j = 0; j < m.ocultos; j++) fprintf(saida, "%s%d", j ? ", " : "", m.pesos2[k * m.ocultos + j]);
+    fprintf(saida, "},\n");
+  }
+  fprintf(saida, "};\nconstexpr int32_t MODELO_GOLPES_VIES2[%d] = {", NUM_TIPOS_GOLPE);
+  for (int k = 0; k < NUM_TIPOS_GOLPE; k++) fprintf(saida, "%s%d", k ? ", " : "", m.vies2[k]);
+  fprintf(saida, "};\n\n#endif\n");
+  return fclose(saida) == 0;
+}
+
+}  // namespace traco
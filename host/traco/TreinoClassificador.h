@@ -0,0 +1,88 @@
+/**
+ * @file TreinoClassificador.h
+ * @brief Treino e avaliação do classificador de golpes (saco/Classificador.h)
+ *
+ * Os exemplos saem de traços (gravados no saco ou sintéticos) pelo mesmo
+ * caminho do firmware: SegmentadorGolpes do modo round para achar cada
+ * golpe e o pad, ExtratorGolpe para as características. O rótulo é o do
+ * traço inteiro: grava-se uma sessão por tipo de golpe.
+ *
+ * O treino é de uma MLP em float (Adam, entropia cruzada) sobre as
+ * características padronizadas; depois os pesos são quantizados para
+ * int8 por camada e a escala da camada oculta é calibrada nos próprios
+ * exemplos. escreverModelo() gera o ModeloGolpes<Placa>.h da placa do
+ * build (PlacaAtual), que o saco/ModeloGolpes.h escolhe.
+ */
+#ifndef TREINO_CLASSIFICADOR_H
+#define TREINO_CLASSIFICADOR_H
+
+#include <string>
+#include <vector>
+
+#include "Classificador.h"
+#include "ReproducaoTraco.h"
+
+namespace traco {
+
+struct ExemploGolpe {
+  float x[NUM_CARACTERISTICAS];
+  TipoGolpe tipo;
+};
+
+// Traço com `quantidade` golpes sintéticos do tipo, um a cada 400 ms, com
+// direção, intensidade, giro e pad sorteados em faixas de cada tipo
+Traco gerarGolpesTipo(TipoGolpe tipo, uint32_t quantidade, uint32_t semente);
+
+// Exemplos de vários tipos, `porTipo` de cada, para treino e testes
+std::vector<ExemploGolpe> exemplosSinteticos(uint32_t porTipo, uint32_t semente);
+
+std::vector<ExemploGolpe> extrairExemplos(const Traco& traco, TipoGolpe rotulo);
+
+struct ParametrosTreino {
+  uint8_t ocultos = 16;
+  uint32_t epocas = 200;
+  uint32_t lote = 32;
+  float taxa = 0.01f;
+  uint32_t semente = 1;
+};
+
+// Modelo quantizado, dono das tabelas, e a versão float que o originou
+struct ModeloTreinado {
+  std::vector<float> media, escala;
+  uint8_t ocultos = 0;
+  std::vector<int8_t> pesos1, pesos2;
+  std::vector<int32_t> vies1, vies2;
+  int32_t multiplicador1 = 0;
+  uint8_t deslocamento1 = 0;
+
+  std::vector<float> pesos1Float, vies1Float, pesos2Float, vies2Float;
+
+  ModeloGolpes tabelas() const;
+  TipoGolpe classificarFloat(const float x[NUM_CARACTERISTICAS]) const;
+};
+
+ModeloTreinado treinar(const std::vector<ExemploGolpe>& exemplos,
+                       const ParametrosTreino& parametros = ParametrosTreino());
+
+struct AvaliacaoClassificador {
+  uint32_t total = 0;
+  uint32_t confusao[NUM_TIPOS_GOLPE][NUM_TIPOS_GOLPE] = {};  // [real][previsto]
+  float acuracia = 0;       // int8, como no saco
+  float acuraciaFloat = 0;  // Só com o modelo float
+  float concordancia = 0;   // int8 == float
+  double nsPorGolpe = 0;    // Inferência int8 no host
+};
+
+// `flutuante` (opcional) compara com o modelo float antes da quantização
+AvaliacaoClassificador avaliar(const ModeloGolpes& modelo,
+                               const std::vector<ExemploGolpe>& exemplos,
+                               const ModeloTreinado* flutuante = nullptr);
+
+// Gera o cabeçalho com as tabelas constexpr (saco/ModeloGolpes<Placa>.h);
+// `gravado`: algum exemplo veio de traço gravado, não só sintético
+bool escreverModelo(const ModeloTreinado& modelo, const std::string& caminho,
+                    const std::string& origem, bool gravado);
+
+}  // namespace traco
+
+#endif
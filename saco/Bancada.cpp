@@ -0,0 +1,219 @@
+/**
+ * @file Bancada.cpp
+ * @brief Implementação da bancada de desempenho no dispositivo
+ */
+#include "Bancada.h"
+#include "display.h"
+#include "Captura.h"
+#include "Classificador.h"
+#include "Conexao.h"
+#include <math.h>
+#include <string.h>
+
+Bancada bancada;
+
+// Descarta o que o log da bancada formata
+class SaidaNula : public Print {
+public:
+  size_t write(uint8_t) override { return 1; }
+};
+
+// Um backend de FFT (Espectro.h) com a janela já cheia, sobre o sinal dado
+template <class FFT>
+static void medirFFT(Print& saida, const char* nome, const float* sinal) {
+  static PipelineForca<FFT> pipeline;
+  pipeline.reiniciar();
+  for (int i = 0; i < SAMPLES; i++) {
+    pipeline.processar(sinal[i]);
+  }
+  Bancada::imprimir(saida, Bancada::medir(nome, BANCADA_ITERACOES,
+                                          [sinal](uint32_t i) { pipeline.processar(sinal[i]); }));
+}
+
+void Bancada::reiniciar(Sensores& s) {
+  s.integraFFT(true);
+  s.detectarPico(0, true);
+}
+
+float Bancada::sinalPico(uint32_t indice) {
+  // Golpe de 8 g com 10 amostras a cada 50, mais um ruído determinístico
+  uint32_t fase = indice % 50;
+  float golpe = fase < 10 ? 8.0f * sinf(M_PI * fase / 10.0f) : 0.0f;
+  return golpe + ((indice * 37) % 11) * 0.01f;
+}
+
+void Bancada::caracteristicasBancada(float caracteristicas[NUM_CARACTERISTICAS]) {
+  // O primeiro golpe do sinalPico, no eixo X, com o pad da frente
+  ExtratorGolpe extrator;
+  extrator.repouso(0, 0, 1);
+  for (uint32_t i = 0; i < 10; i++) {
+    AmostraGolpe amostra = {i * 1000, sinalPico(i), 0, 1, 0, 0, 50};
+    extrator.adicionar(amostra);
+  }
+  extrator.finalizar(0, caracteristicas);
+}
+
+bool Bancada::registrarLog(ServicoLog& log, uint32_t indice) {
+  return log.registrar(NivelLog::Info, ModuloLog::Sensores, false, "Captura %d para sensor %d",
+                       (int)(indice % 10), (int)(indice % NUM_SENSORES));
+}
+
+const char* Bancada::respostaMedicoes() {
+  return "{\"estado\":\"solicitada\",\"tipo\":\"round\",\"usuario\":\"Xo3kq9TzVbQeW1mRf7LpA2sYd4Hn\","
+         "\"timestampSolicitacao\":1718822400,\"duracao\":120,\"descanso\":30,"
+         "\"timestampInicio\":1718820000,\"timestampConclusao\":1718820125,\"valor\":412.5,"
+         "\"ledIndex\":0,\"sensor\":9,\"progressoCalibracao\":{\"atual\":9,\"total\":9},"
+         "\"progresso\":{\"completos\":9,\"total\":9,\"percentual\":100},"
+         "\"sensoresCalibrados\":{\"1\":true,\"2\":true,\"3\":true,\"4\":true,\"5\":true,"
+         "\"6\":true,\"7\":true,\"8\":true,\"9\":true},"
+         "\"resultado\":{\"acerto\":true,\"tempoResposta\":850,\"sensorTocado\":3,\"ledSorteado\":3},"
+         "\"metricas\":{\"picoG\":11.8,\"impulsoGs\":0.42,\"subidaMs\":6.5,\"duracaoMs\":21,"
+         "\"tipo\":\"direto\",\"confianca\":0.87},"
+         "\"toque\":{\"inicioS\":0.412,\"cruzamentoS\":0.431,\"pad\":3},"
+         "\"circuito\":{\"1\":{\"sacos\":2,\"resultados\":{\"A0B1C2D3E4F5\":{\"ordem\":0,\"pad\":4,"
+         "\"respondeu\":true,\"padTocado\":4,\"reacaoMs\":388.2,\"atrasoDisparoUs\":0,"
+         "\"incertezaUs\":0},\"A0B1C2D3E4F6\":{\"ordem\":1,\"pad\":2,\"respondeu\":true,"
+         "\"padTocado\":2,\"reacaoMs\":402.7,\"atrasoDisparoUs\":812,\"incertezaUs\":95}}}},"
+         "\"precisao\":{\"acertos\":7,\"erros\":3,\"tentativas\":[850,920,610,1200,700]}}";
+}
+
+const char* Bancada::respostaEntrada() {
+  return "{\"versao\":2,\"estado\":\"solicitada\",\"tipo\":\"round\","
+         "\"usuario\":\"Xo3kq9TzVbQeW1mRf7LpA2sYd4Hn\",\"timestampSolicitacao\":1718822400,"
+         "\"duracao\":120,\"descanso\":30}";
+}
+
+// O FirebaseJson só dá JSON_INT para o que cabe em um int; o resto é double
+static bool inteiroFirebaseJson(const FirebaseJsonData& dado) {
+  return dado.typeNum == FirebaseJson::JSON_INT && dado.doubleValue == (double)dado.intValue;
+}
+
+bool Bancada::decodificarFirebaseJson(const char* resposta, Medicao& medicao) {
+  medicao = Medicao();
+  FirebaseJson json;
+  if (!json.setJsonData(resposta)) {
+    return false;
+  }
+  FirebaseJsonData dado;
+  if (json.get(dado, "estado") && dado.typeNum == FirebaseJson::JSON_STRING) {
+    if (dado.stringValue == "solicitada") medicao.estado = EstadoMedicao::Solicitada;
+    else if (dado.stringValue == "executando") medicao.estado = EstadoMedicao::Executando;
+    else if (dado.stringValue == "concluida") medicao.estado = EstadoMedicao::Concluida;
+    else medicao.estado = EstadoMedicao::Desconhecido;
+  }
+  if (json.get(dado, "tipo") && dado.typeNum == FirebaseJson::JSON_STRING) {
+    if (dado.stringValue == "forca") medicao.tipo = TipoMedicao::Forca;
+    else if (dado.stringValue == "precisao") medicao.tipo = TipoMedicao::Precisao;
+    else if (dado.stringValue == "tempo_reacao") medicao.tipo = TipoMedicao::TempoReacao;
+    else if (dado.stringValue == "tCalibrar") medicao.tipo = TipoMedicao::Calibrar;
+    else if (dado.stringValue == "gravacao") medicao.tipo = TipoMedicao::Gravacao;
+    else if (dado.stringValue == "round") medicao.tipo = TipoMedicao::Round;
+    else if (dado.stringValue == "circuito") medicao.tipo = TipoMedicao::Circuito;
+    else medicao.tipo = TipoMedicao::Desconhecido;
+  }
+  if (json.get(dado, "usuario") && dado.typeNum == FirebaseJson::JSON_STRING &&
+      dado.stringValue.length() < sizeof(medicao.usuario)) {
+    strcpy(medicao.usuario, dado.stringValue.c_str());
+  }
+  if (json.get(dado, "comando") && dado.typeNum == FirebaseJson::JSON_STRING) {
+    medicao.parar = dado.stringValue == "parar";
+  }
+  if (json.get(dado, "destino") && dado.typeNum == FirebaseJson::JSON_STRING &&
+      dado.stringValue == "flash") {
+    medicao.destino = DestinoTraco::Flash;
+  }
+  if (json.get(dado, "timestampSolicitacao") && inteiroFirebaseJson(dado)) {
+    medicao.timestampSolicitacao = dado.intValue;
+  }
+  if (json.get(dado, "duracao") && inteiroFirebaseJson(dado)) {
+    medicao.duracao = dado.intValue;
+  }
+  if (json.get(dado, "descanso") && inteiroFirebaseJson(dado)) {
+    medicao.descanso = dado.intValue;
+  }
+  if (json.get(dado, "rounds") && inteiroFirebaseJson(dado)) {
+    medicao.rounds = dado.intValue;
+  }
+  if (json.get(dado, "versao") && inteiroFirebaseJson(dado)) {
+    medicao.versao = dado.intValue;
+  }
+  return true;
+}
+
+void Bancada::imprimir(Print& saida, const ResultadoBancada& r) {
+  uint32_t mhz = ESP.getCpuFreqMHz();
+  saida.printf("BANCADA nome=%s iteracoes=%u ciclos_min=%u ciclos_medio=%u ciclos_max=%u us_medio=%.2f\n",
+               r.nome, (unsigned)r.iteracoes, (unsigned)r.ciclosMin, (unsigned)r.ciclosMedio,
+               (unsigned)r.ciclosMax, mhz ? (float)r.ciclosMedio / mhz : 0.0f);
+}
+
+void Bancada::executar(Print& saida) {
+  static float sinal[BANCADA_ITERACOES];
+  for (uint32_t i = 0; i < BANCADA_ITERACOES; i++) {
+    sinal[i] = sinalPico(i);
+  }
+  static const int angulos[8] = {0, 45, 90, 135, 180, 225, 270, 315};
+
+  saida.printf("BANCADA versao=%d cpu_mhz=%u\n", BANCADA_VERSAO, (unsigned)ESP.getCpuFreqMHz());
+
+  // Com o buffer da FFT já cheio, como durante o calcularForca()
+  reiniciar(sensores);
+  for (int i = 0; i < SAMPLES; i++) {
+    integraFFT(sensores);
+  }
+  imprimir(saida, medir("integraFFT", BANCADA_ITERACOES,
+                        [](uint32_t) { integraFFT(sensores); }));
+
+  reiniciar(sensores);
+  imprimir(saida, medir("detectarPico", BANCADA_ITERACOES,
+                        [](uint32_t i) { detectarPico(sensores, sinal[i]); }));
+  reiniciar(sensores);
+
+  imprimir(saida, medir("detectarToque", BANCADA_ITERACOES,
+                        [](uint32_t) { sensores.detectarToque(); }));
+
+  // Sem toques a calibração falha e mantém os limites atuais
+  imprimir(saida, medir("calibrarSensorIndividual", BANCADA_ITERACOES_CALIBRACAO,
+                        [](uint32_t) { sensores.calibrarSensorIndividual(0); }));
+
+  imprimir(saida, medir("seta", BANCADA_ITERACOES,
+                        [](uint32_t i) { setaDisplay.seta(angulos[i % 8]); }));
+  setaDisplay.clear();
+  setaDisplay.update();
+
+  // Só o espectro, sem a leitura do MPU: compara os backends de FFT_FORCA
+  medirFFT<FFTArduino<SAMPLES>>(saida, "fft_arduinoFFT", sinal);
+  medirFFT<FFTPortavel<SAMPLES>>(saida, "fft_portavel", sinal);
+#if ESPDSP_DISPONIVEL
+  medirFFT<FFTEspDspF32<SAMPLES>>(saida, "fft_espdsp_f32", sinal);
+  medirFFT<FFTEspDspS16<SAMPLES>>(saida, "fft_espdsp_s16", sinal);
+#endif
+
+  // Inferência int8 de um golpe (as características já extraídas)
+  static float caracteristicas[NUM_CARACTERISTICAS];
+  caracteristicasBancada(caracteristicas);
+  imprimir(saida, medir("classificarGolpe", BANCADA_ITERACOES,
+                        [](uint32_t) { classificadorGolpes.classificar(caracteristicas); }));
+
+  // Só o lado de quem loga, com o anel vazio: a formatação é da tarefa do log
+  static ServicoLog log;
+  SaidaNula nula;
+  log.descarregar(nula);
+  imprimir(saida, medir("registrarLog", LOG_CAPACIDADE,
+                        [](uint32_t i) { registrarLog(log, i); }));
+  log.descarregar(nula);
+
+  // Um comando novo no nó de medições, como o checkForCommands a cada segundo
+  static Medicao medicao;
+  imprimir(saida, medir("decodificarMedicao_firebaseJson", BANCADA_ITERACOES, [](uint32_t) {
+    decodificarFirebaseJson(respostaMedicoes(), medicao);
+  }));
+  imprimir(saida, medir("decodificarMedicao", BANCADA_ITERACOES, [](uint32_t) {
+    decodificarMedicao(respostaMedicoes(), strlen(respostaMedicoes()), medicao);
+  }));
+  imprimir(saida, medir("decodificarMedicao_entrada", BANCADA_ITERACOES, [](uint32_t) {
+    decodificarMedicao(respostaEntrada(), strlen(respostaEntrada()), medicao);
+  }));
+
+  saida.println("BANCADA fim");
+}
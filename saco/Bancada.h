@@ -0,0 +1,98 @@
+/**
+ * @file Bancada.h
+ * @brief Bancada de desempenho das rotinas de sensoriamento e do display
+ *
+ * Com MODO_BANCADA definido o firmware não inicia as tarefas: o setup()
+ * mede integraFFT, detectarPico, detectarToque, calibrarSensorIndividual e
+ * o redesenho completo de SetaDisplay::seta com o contador de ciclos do
+ * Xtensa (ESP.getCycleCount()) e imprime o relatório na serial. Em seguida
+ * mede cada backend de FFT do Espectro.h (fft_<nome>) sobre o mesmo sinal,
+ * a inferência do classificador de golpes (classificarGolpe), o custo de
+ * uma chamada de log para quem loga (registrarLog) e a leitura de um
+ * comando do nó medicoes/ do esquema 1, pelo FirebaseJson como era feita
+ * (decodificarMedicao_firebaseJson) e em uma passada (decodificarMedicao),
+ * e do mesmo comando sozinho em entrada/ (decodificarMedicao_entrada).
+ *
+ * @section relatorio Relatório
+ * Uma linha por rotina, no formato chave=valor e prefixada por "BANCADA"
+ * para ser extraída do meio dos logs:
+ *
+ *   BANCADA versao=1 cpu_mhz=240
+ *   BANCADA nome=integraFFT iteracoes=200 ciclos_min=... ciclos_medio=... ciclos_max=... us_medio=...
+ *   BANCADA fim
+ *
+ * ferramentas/comparar_bancada.py monta a tabela antes/depois a partir de
+ * dois relatórios (ou de duas saídas JSON da bancada do host).
+ */
+#ifndef BANCADA_H
+#define BANCADA_H
+
+#include <Arduino.h>
+#include "Sensores.h"
+#include "Classificador.h"
+#include "Log.h"
+#include "Medicao.h"
+
+#define BANCADA_VERSAO 1
+#define BANCADA_ITERACOES 200
+#define BANCADA_ITERACOES_CALIBRACAO 3  // Cada calibração espera 2 s de amostras
+
+struct ResultadoBancada {
+  const char* nome;
+  uint32_t iteracoes;
+  uint32_t ciclosMin;
+  uint32_t ciclosMedio;
+  uint32_t ciclosMax;
+};
+
+class Bancada {
+public:
+  // Roda todas as medições e imprime o relatório em `saida`
+  void executar(Print& saida);
+
+  // Acesso às rotinas internas do Sensores (também usado por host/bancada)
+  static float integraFFT(Sensores& s) { return s.integraFFT(); }
+  static float detectarPico(Sensores& s, float entrada) { return s.detectarPico(entrada); }
+  static void reiniciar(Sensores& s);
+
+  // Sinal de entrada do detectarPico: golpes em meio-seno sobre ruído
+  static float sinalPico(uint32_t indice);
+
+  // Características de um golpe do sinalPico, entrada do classificarGolpe
+  static void caracteristicasBancada(float caracteristicas[NUM_CARACTERISTICAS]);
+
+  // Um registro como os da calibração interativa (dois inteiros) no anel dado
+  static bool registrarLog(ServicoLog& log, uint32_t indice);
+
+  // Resposta de /devices/<id>/medicoes com um comando novo sobre o que
+  // sobrou das medições anteriores (resultado, metricas, circuito, ...)
+  static const char* respostaMedicoes();
+
+  // O mesmo comando em /devices/<id>/entrada (esquema 2), sem o resto
+  static const char* respostaEntrada();
+
+  // A leitura de antes do Medicao.h: FirebaseJson e um get() por campo
+  static bool decodificarFirebaseJson(const char* resposta, Medicao& medicao);
+
+  template <typename Funcao>
+  static ResultadoBancada medir(const char* nome, uint32_t iteracoes, Funcao funcao) {
+    ResultadoBancada resultado = {nome, iteracoes, UINT32_MAX, 0, 0};
+    uint64_t soma = 0;
+    for (uint32_t i = 0; i < iteracoes; i++) {
+      uint32_t inicio = ESP.getCycleCount();
+      funcao(i);
+      uint32_t ciclos = ESP.getCycleCount() - inicio;
+      soma += ciclos;
+      if (ciclos < resultado.ciclosMin) resultado.ciclosMin = ciclos;
+      if (ciclos > resultado.ciclosMax) resultado.ciclosMax = ciclos;
+    }
+    resultado.ciclosMedio = iteracoes ? (uint32_t)(soma / iteracoes) : 0;
+    return resultado;
+  }
+
+  static void imprimir(Print& saida, const ResultadoBancada& resultado);
+};
+
+extern Bancada bancada;
+
+#endif
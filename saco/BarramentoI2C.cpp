@@ -0,0 +1,146 @@
+/**
+ * @file BarramentoI2C.cpp
+ * @brief Implementação do gerenciador do barramento I2C compartilhado
+ */
+#include "BarramentoI2C.h"
+
+BarramentoI2C barramentoI2C(Wire);
+
+BarramentoI2C::BarramentoI2C(TwoWire& wire)
+  : wire(wire), mutex(NULL), iniciado(false), sensoresAguardando(0), inicioPosseUs(0) {
+  memset(&estatisticas, 0, sizeof(estatisticas));
+}
+
+bool BarramentoI2C::iniciar(uint32_t frequencia) {
+  if (iniciado) {
+    return true;
+  }
+
+  mutex = xSemaphoreCreateMutex();
+  if (mutex == NULL) {
+    Serial.println("Falha ao criar mutex do I2C");
+    return false;
+  }
+
+  wire.begin();
+  wire.setClock(frequencia);
+  zerarEstatisticas();
+  iniciado = true;
+  return true;
+}
+
+TwoWire& BarramentoI2C::getWire() {
+  return wire;
+}
+
+bool BarramentoI2C::adquirir(PrioridadeI2C prioridade, TickType_t espera) {
+  if (mutex == NULL) {
+    return false;
+  }
+  uint32_t inicioEspera = micros();
+  bool sensor = (prioridade == PrioridadeI2C::Sensor);
+
+  if (sensor) {
+    __atomic_add_fetch(&sensoresAguardando, 1, __ATOMIC_SEQ_CST);
+  } else {
+    // O display cede a vez enquanto houver leitura de sensor pendente
+    bool cedeu = false;
+    while (__atomic_load_n(&sensoresAguardando, __ATOMIC_SEQ_CST) > 0) {
+      cedeu = true;
+      vTaskDelay(1);
+    }
+    if (cedeu) {
+      __atomic_add_fetch(&estatisticas.cessoes, 1, __ATOMIC_SEQ_CST);
+    }
+  }
+
+  bool obtido = (xSemaphoreTake(mutex, espera) == pdTRUE);
+
+  if (sensor) {
+    __atomic_sub_fetch(&sensoresAguardando, 1, __ATOMIC_SEQ_CST);
+  }
+  if (!obtido) {
+    return false;
+  }
+
+  inicioPosseUs = micros();
+  uint8_t p = (uint8_t)prioridade;
+  uint32_t esperaUs = inicioPosseUs - inicioEspera;
+  if (esperaUs > estatisticas.esperaMaximaUs[p]) {
+    estatisticas.esperaMaximaUs[p] = esperaUs;
+  }
+  return true;
+}
+
+void BarramentoI2C::liberar(PrioridadeI2C prioridade, uint32_t bytes) {
+  uint8_t p = (uint8_t)prioridade;
+  estatisticas.transacoes[p]++;
+  estatisticas.bytes[p] += bytes;
+  estatisticas.tempoOcupadoUs[p] += micros() - inicioPosseUs;
+  xSemaphoreGive(mutex);
+}
+
+bool BarramentoI2C::escreverBlocos(uint8_t endereco, uint8_t controle, const uint8_t* dados,
+                                   uint16_t quantidade, PrioridadeI2C prioridade) {
+  bool sucesso = true;
+
+  do {
+    uint16_t bloco = min((uint16_t)I2C_BLOCO_ESCRITA, quantidade);
+
+    if (!adquirir(prioridade)) {
+      return false;
+    }
+    wire.beginTransmission(endereco);
+    wire.write(controle);
+    wire.write(dados, bloco);
+    sucesso = (wire.endTransmission() == 0) && sucesso;
+    liberar(prioridade, bloco + 1);
+
+    dados += bloco;
+    quantidade -= bloco;
+  } while (quantidade > 0);
+
+  return sucesso;
+}
+
+EstatisticasI2C BarramentoI2C::getEstatisticas() {
+  return estatisticas;
+}
+
+float BarramentoI2C::getUtilizacao() {
+  uint32_t janela = micros() - estatisticas.inicioJanelaUs;
+  if (janela == 0) {
+    return 0;
+  }
+  uint32_t ocupado = 0;
+  for (int p = 0; p < NUM_PRIORIDADES_I2C; p++) {
+    ocupado += estatisticas.tempoOcupadoUs[p];
+  }
+  return (float)ocupado / janela;
+}
+
+void BarramentoI2C::zerarEstatisticas() {
+  memset(&estatisticas, 0, sizeof(estatisticas));
+  estatisticas.inicioJanelaUs = micros();
+}
+
+void BarramentoI2C::imprimirEstatisticas() {
+  const char* nomes[NUM_PRIORIDADES_I2C] = {"sensor", "display"};
+  Serial.printf("I2C: utilizacao %.1f%%, cessoes do display %u\n",
+                getUtilizacao() * 100, estatisticas.cessoes);
+  for (int p = 0; p < NUM_PRIORIDADES_I2C; p++) {
+    Serial.printf("  %-8s transacoes=%u bytes=%u ocupado=%uus esperaMax=%uus\n", nomes[p],
+                  estatisticas.transacoes[p], estatisticas.bytes[p],
+                  estatisticas.tempoOcupadoUs[p], estatisticas.esperaMaximaUs[p]);
+  }
+}
+
+TransacaoI2C::TransacaoI2C(PrioridadeI2C prioridade, uint32_t bytes, TickType_t espera)
+  : prioridade(prioridade), bytes(bytes), posse(barramentoI2C.adquirir(prioridade, espera)) {
+}
+
+TransacaoI2C::~TransacaoI2C() {
+  if (posse) {
+    barramentoI2C.liberar(prioridade, bytes);
+  }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file BarramentoI2C.h
+ * @brief Gerenciador do barramento I2C compartilhado (MPU6500 + OLED SSD1306)
+ *
+ * O BarramentoI2C é o único dono do Wire: inicializa o periférico, fixa o
+ * clock e arbitra o acesso entre os dispositivos.
+ *
+ * @section prioridade Prioridades
+ * - Sensor: leituras do MPU6500. Sinalizam que estão aguardando antes de
+ *   pedir o barramento, e o display cede a vez entre um bloco e outro.
+ * - Display: escritas grandes são quebradas em blocos de I2C_BLOCO_ESCRITA
+ *   bytes, liberando o barramento entre blocos. No pior caso uma leitura do
+ *   acelerômetro espera um único bloco (~0,8 ms a 400 kHz).
+ *
+ * @section estatisticas Estatísticas
+ * Transações, bytes, tempo ocupado e espera máxima por prioridade, além do
+ * número de vezes que o display cedeu o barramento.
+ */
+#ifndef BARRAMENTO_I2C_H
+#define BARRAMENTO_I2C_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#define I2C_FREQUENCIA 400000UL  // Fast-mode: limite do MPU6500 e do SSD1306
+#define I2C_BLOCO_ESCRITA 32     // Bytes de dados por transação de escrita longa
+#define NUM_PRIORIDADES_I2C 2
+
+enum class PrioridadeI2C : uint8_t {
+  Sensor = 0,
+  Display = 1
+};
+
+struct EstatisticasI2C {
+  uint32_t transacoes[NUM_PRIORIDADES_I2C];
+  uint32_t bytes[NUM_PRIORIDADES_I2C];
+  uint32_t tempoOcupadoUs[NUM_PRIORIDADES_I2C];
+  uint32_t esperaMaximaUs[NUM_PRIORIDADES_I2C];
+  uint32_t cessoes;          // Vezes que o display esperou por um sensor
+  uint32_t inicioJanelaUs;   // Início da janela de medição
+};
+
+class BarramentoI2C {
+public:
+  BarramentoI2C(TwoWire& wire);
+  bool iniciar(uint32_t frequencia = I2C_FREQUENCIA);
+  TwoWire& getWire();
+
+  // Posse exclusiva do barramento; bytes entram nas estatísticas
+  bool adquirir(PrioridadeI2C prioridade, TickType_t espera = portMAX_DELAY);
+  void liberar(PrioridadeI2C prioridade, uint32_t bytes = 0);
+
+  // Escreve "dados" precedidos do byte de controle, em blocos, cedendo o
+  // barramento a leituras de sensor entre um bloco e outro
+  bool escreverBlocos(uint8_t endereco, uint8_t controle, const uint8_t* dados,
+                      uint16_t quantidade, PrioridadeI2C prioridade);
+
+  EstatisticasI2C getEstatisticas();
+  float getUtilizacao();  // Fração do tempo da janela com o barramento ocupado
+  void zerarEstatisticas();
+  void imprimirEstatisticas();
+
+private:
+  TwoWire& wire;
+  SemaphoreHandle_t mutex;
+  bool iniciado;
+  volatile uint32_t sensoresAguardando;
+  uint32_t inicioPosseUs;
+  EstatisticasI2C estatisticas;  // Alterado com o mutex em posse (cessoes: atômico)
+};
+
+/**
+ * @brief Guarda RAII para uma transação com prioridade
+ *
+ * Sem a posse (tempo esgotado, barramento não iniciado) quem usa não faz
+ * I/O, e o destrutor não devolve um mutex que não é seu.
+ */
+class TransacaoI2C {
+public:
+  TransacaoI2C(PrioridadeI2C prioridade, uint32_t bytes = 0,
+               TickType_t espera = portMAX_DELAY);
+  ~TransacaoI2C();
+  bool adquirida() const { return posse; }
+private:
+  PrioridadeI2C prioridade;
+  uint32_t bytes;
+  bool posse;
+};
+
+extern BarramentoI2C barramentoI2C;
+
+#endif
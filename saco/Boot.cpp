@@ -0,0 +1,125 @@
+/**
+ * @file Boot.cpp
+ * @brief Fases do boot, bits de prontidão e relatório de tempos
+ */
+#include "Boot.h"
+#include <string.h>
+
+SequenciaBoot boot;
+
+const char* nomeFaseBoot(FaseBoot fase) {
+  switch (fase) {
+    case FaseBoot::Display:    return "display";
+    case FaseBoot::Sensores:   return "sensores";
+    case FaseBoot::Calibracao: return "calibracao";
+    case FaseBoot::Tarefas:    return "tarefas";
+    case FaseBoot::WiFi:       return "wifi";
+    case FaseBoot::Hora:       return "hora";
+    case FaseBoot::Firebase:   return "firebase";
+    default:                   return "?";
+  }
+}
+
+SequenciaBoot::SequenciaBoot() : inicioUs(0), antesDoSetupUs(0) {
+  // O heap do FreeRTOS já existe nos construtores globais do ESP-IDF: o
+  // Conexao pode marcar fases mesmo sem o setup() (testes nativos)
+  eventos = xEventGroupCreate();
+  mutex = xSemaphoreCreateMutex();
+  memset(fases, 0, sizeof(fases));
+}
+
+void SequenciaBoot::iniciar() {
+  antesDoSetupUs = micros();
+  inicioUs = antesDoSetupUs;
+  xEventGroupClearBits(eventos, BOOT_LOCAL | BOOT_WIFI | BOOT_HORA | BOOT_FIREBASE);
+  memset(fases, 0, sizeof(fases));
+}
+
+EventBits_t SequenciaBoot::bitDaFase(FaseBoot fase) {
+  switch (fase) {
+    case FaseBoot::Tarefas:  return BOOT_LOCAL;
+    case FaseBoot::WiFi:     return BOOT_WIFI;
+    case FaseBoot::Hora:     return BOOT_HORA;
+    case FaseBoot::Firebase: return BOOT_FIREBASE;
+    default:                 return 0;
+  }
+}
+
+void SequenciaBoot::inicioFase(FaseBoot fase) {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  RegistroFase& registro = fases[(int)fase];
+  if (registro.estado == EstadoFase::Pendente) {
+    registro.inicioUs = micros() - inicioUs;
+  }
+  if (registro.estado != EstadoFase::Concluida) {
+    registro.estado = EstadoFase::Andamento;
+    registro.tentativas++;
+  }
+  xSemaphoreGive(mutex);
+}
+
+void SequenciaBoot::fimFase(FaseBoot fase, bool ok) {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  RegistroFase& registro = fases[(int)fase];
+  if (registro.estado != EstadoFase::Concluida) {
+    registro.duracaoUs = micros() - inicioUs - registro.inicioUs;
+    registro.estado = ok ? EstadoFase::Concluida : EstadoFase::Falhou;
+  }
+  xSemaphoreGive(mutex);
+
+  EventBits_t bit = bitDaFase(fase);
+  if (ok && bit) {
+    xEventGroupSetBits(eventos, bit);
+  }
+}
+
+void SequenciaBoot::limpar(EventBits_t bits) {
+  xEventGroupClearBits(eventos, bits);
+}
+
+bool SequenciaBoot::pronto(EventBits_t bits) const {
+  return (xEventGroupGetBits(eventos) & bits) == bits;
+}
+
+bool SequenciaBoot::aguardar(EventBits_t bits, uint32_t limiteMs) {
+  TickType_t espera = limiteMs == UINT32_MAX ? portMAX_DELAY : limiteMs / portTICK_PERIOD_MS;
+  EventBits_t atuais = xEventGroupWaitBits(eventos, bits, pdFALSE, pdTRUE, espera);
+  return (atuais & bits) == bits;
+}
+
+RegistroFase SequenciaBoot::fase(FaseBoot fase) const {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  RegistroFase registro = fases[(int)fase];
+  xSemaphoreGive(mutex);
+  return registro;
+}
+
+uint32_t SequenciaBoot::getLocalProntoMs() const {
+  RegistroFase tarefas = fase(FaseBoot::Tarefas);
+  if (tarefas.estado != EstadoFase::Concluida) return 0;
+  return (tarefas.inicioUs + tarefas.duracaoUs) / 1000;
+}
+
+uint32_t SequenciaBoot::getRedeProntaMs() const {
+  RegistroFase firebase = fase(FaseBoot::Firebase);
+  if (firebase.estado != EstadoFase::Concluida) return 0;
+  return (firebase.inicioUs + firebase.duracaoUs) / 1000;
+}
+
+void SequenciaBoot::relatorio(Print& saida) const {
+  static const char* estados[] = {"pendente", "andamento", "ok", "falhou"};
+  saida.printf("Boot: %u ms antes do setup()\n", (unsigned)getAntesDoSetupMs());
+  for (int i = 0; i < NUM_FASES_BOOT; i++) {
+    RegistroFase registro = fase((FaseBoot)i);
+    saida.printf("  %-10s %6u ms  +%6u ms  %s (%u)\n", nomeFaseBoot((FaseBoot)i),
+                 (unsigned)(registro.inicioUs / 1000), (unsigned)(registro.duracaoUs / 1000),
+                 estados[(int)registro.estado], (unsigned)registro.tentativas);
+  }
+  uint32_t localMs = getLocalProntoMs();
+  saida.printf("Local pronto em %u ms%s\n", (unsigned)localMs,
+               localMs > BOOT_META_LOCAL_MS ? " (acima da meta)" : "");
+  uint32_t redeMs = getRedeProntaMs();
+  if (redeMs > 0) {
+    saida.printf("Rede pronta em %u ms\n", (unsigned)redeMs);
+  }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file Boot.h
+ * @brief Boot em duas frentes: o saco local primeiro, a rede em segundo plano
+ *
+ * O setup() só sobe o que não depende da rede (display, sensores, calibração
+ * gravada no LittleFS e as tarefas) e sinaliza BOOT_LOCAL; a meta é
+ * BOOT_META_LOCAL_MS desde o início do setup(). WiFi, NTP e o registro no
+ * Firebase sobem na tarefa de comunicação, cada um com seu bit no grupo de
+ * eventos, e quem depende da rede espera pelo bit em vez de a tarefa inteira
+ * ficar parada.
+ *
+ * Cada fase tem início e duração medidos; o relatório vai para a Serial e,
+ * quando o Firebase fica pronto, para /devices/<id>/boot.
+ */
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+
+#define BOOT_LOCAL (1 << 0)      // Display, sensores, calibração e tarefas
+#define BOOT_WIFI (1 << 1)
+#define BOOT_HORA (1 << 2)       // NTP sincronizado
+#define BOOT_FIREBASE (1 << 3)   // Dispositivo registrado no RTDB
+#define BOOT_META_LOCAL_MS 1000
+
+enum class FaseBoot : uint8_t {
+  Display,
+  Sensores,
+  Calibracao,
+  Tarefas,    // Última fase local: conclui com BOOT_LOCAL
+  WiFi,
+  Hora,
+  Firebase
+};
+#define NUM_FASES_BOOT 7
+
+enum class EstadoFase : uint8_t {
+  Pendente,
+  Andamento,
+  Concluida,
+  Falhou      // A última tentativa falhou; a fase pode ser tentada de novo
+};
+
+struct RegistroFase {
+  uint32_t inicioUs;    // Desde o início do setup(), na primeira tentativa
+  uint32_t duracaoUs;   // Até a conclusão (ou a última falha), somando as tentativas
+  EstadoFase estado;
+  uint8_t tentativas;
+};
+
+const char* nomeFaseBoot(FaseBoot fase);
+
+class SequenciaBoot {
+public:
+  SequenciaBoot();
+
+  // No começo do setup(): zera as fases e marca o instante zero
+  void iniciar();
+
+  void inicioFase(FaseBoot fase);
+  // A primeira conclusão fica no relatório e sinaliza o bit da fase
+  void fimFase(FaseBoot fase, bool ok = true);
+
+  // A rede caiu: os bits voltam a zero até a próxima conclusão
+  void limpar(EventBits_t bits);
+  bool pronto(EventBits_t bits) const;
+  bool aguardar(EventBits_t bits, uint32_t limiteMs);
+
+  RegistroFase fase(FaseBoot fase) const;
+  uint32_t getAntesDoSetupMs() const { return antesDoSetupUs / 1000; }  // ROM, bootloader e core
+  uint32_t getLocalProntoMs() const;   // 0 enquanto BOOT_LOCAL não vier
+  uint32_t getRedeProntaMs() const;    // Até o Firebase; 0 enquanto não vier
+
+  void relatorio(Print& saida) const;
+
+private:
+  EventGroupHandle_t eventos;
+  SemaphoreHandle_t mutex;
+  uint32_t inicioUs;
+  uint32_t antesDoSetupUs;
+  RegistroFase fases[NUM_FASES_BOOT];
+
+  static EventBits_t bitDaFase(FaseBoot fase);
+};
+
+extern SequenciaBoot boot;
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file Captura.cpp
+ * @brief Implementação da captura de golpes disparada pelo impacto
+ */
+#include "Captura.h"
+#include "Rastreio.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <math.h>
+
+CapturaGolpe captura;
+
+CapturaGolpe::CapturaGolpe()
+  : repousoG(1.0f), repousoIniciado(false), amostrasMonitoradas(0), pad(-1) {
+  configurar(CAPTURA_PRE_MS, CAPTURA_POS_MS, CAPTURA_LIMIAR_G);
+}
+
+void CapturaGolpe::configurar(uint16_t preMs, uint16_t posMs, float limiar) {
+  if (preMs > CAPTURA_MAX_MS - 1) preMs = CAPTURA_MAX_MS - 1;
+  if (posMs < 1) posMs = 1;
+  if (preMs + posMs > CAPTURA_MAX_MS) posMs = CAPTURA_MAX_MS - preMs;
+  preAmostras = (uint32_t)preMs * CAPTURA_TAXA_HZ / 1000;
+  posAmostras = (uint32_t)posMs * CAPTURA_TAXA_HZ / 1000;
+  limiarG = limiar;
+  reiniciar();
+}
+
+void CapturaGolpe::reiniciar() {
+  fase = FaseCaptura::Monitorando;
+  cabeca = 0;
+  inicio = 0;
+  tamanho = 0;
+  indiceGatilho = 0;
+  posRestantes = 0;
+  pad = -1;
+}
+
+bool CapturaGolpe::adicionar(uint32_t tempoUs, const xyzFloat& a, const xyzFloat& g) {
+  if (fase == FaseCaptura::Completa) {
+    return false;
+  }
+
+  AmostraGolpe& destino = buffer[cabeca];
+  destino.tempoUs = tempoUs;
+  destino.ax = a.x;
+  destino.ay = a.y;
+  destino.az = a.z;
+  destino.gx = g.x;
+  destino.gy = g.y;
+  destino.gz = g.z;
+  cabeca = (cabeca + 1) % CAPTURA_MAX_AMOSTRAS;
+
+  if (fase == FaseCaptura::Capturando) {
+    tamanho++;
+    if (--posRestantes == 0) {
+      fase = FaseCaptura::Completa;
+      return true;
+    }
+    return false;
+  }
+
+  // Monitorando: só a resultante e o limiar
+  amostrasMonitoradas++;
+  float resultante = sqrtf(a.x * a.x + a.y * a.y + a.z * a.z);
+  if (!repousoIniciado) {
+    // Começou no meio de um golpe: espera o saco voltar para perto de 1 g,
+    // senão o fim do golpe vira gatilho com o golpe no pré-gatilho
+    if (fabsf(resultante - 1.0f) > limiarG) {
+      return false;
+    }
+    repousoG = resultante;
+    repousoIniciado = true;
+  }
+  if (fabsf(resultante - repousoG) <= limiarG) {
+    repousoG += CAPTURA_ALFA_REPOUSO * (resultante - repousoG);
+    if (tamanho < preAmostras) {
+      tamanho++;
+    }
+    return false;
+  }
+
+  // Gatilho: a janela começa preAmostras antes desta amostra
+  indiceGatilho = tamanho;
+  tamanho++;
+  inicio = (cabeca + CAPTURA_MAX_AMOSTRAS - tamanho) % CAPTURA_MAX_AMOSTRAS;
+  posRestantes = posAmostras;
+  fase = FaseCaptura::Capturando;
+  if (--posRestantes == 0) {
+    fase = FaseCaptura::Completa;
+    return true;
+  }
+  return false;
+}
+
+bool CapturaGolpe::aguardarGolpe(Sensores& sensores, uint32_t limiteMs) {
+  reiniciar();
+  uint32_t inicioMs = millis();
+  TickType_t ultimoDespertar = xTaskGetTickCount();
+  uint16_t padsAtivos = 0;
+  int8_t padAntes = -1;
+  uint32_t padAntesMs = 0;
+  bool gatilhoVisto = false;
+  static PrazoRastreio prazo("captura", 1000000 / CAPTURA_TAXA_HZ, 1000000 / CAPTURA_TAXA_HZ);
+  prazo.iniciar();
+  for (uint32_t ciclo = 0; ; ciclo++) {
+    prazo.marcar();
+    xyzFloat aceleracao, giro;
+    sensores.lerIMU(aceleracao, giro);
+    bool completa = adicionar(micros(), aceleracao, giro);
+
+    // O pad é o último tocado pouco antes do gatilho ou o primeiro depois dele
+    if (ciclo % CAPTURA_PERIODO_TOQUE_MS == 0 && pad < 0) {
+      uint16_t valores[NUM_SENSORES];
+      sensores.lerToques(valores);
+      for (int i = 0; i < NUM_SENSORES; i++) {
+        bool tocado = valores[i] > sensores.getThreshold(i);
+        if (tocado && !(padsAtivos & (1 << i))) {
+          if (fase == FaseCaptura::Monitorando) {
+            padAntes = i;
+            padAntesMs = millis();
+          } else if (pad < 0) {
+            pad = i;
+          }
+        }
+        padsAtivos = tocado ? (padsAtivos | (1 << i)) : (padsAtivos & ~(1 << i));
+      }
+    }
+    if (!gatilhoVisto && fase != FaseCaptura::Monitorando) {
+      gatilhoVisto = true;
+      if (padAntes >= 0 && millis() - padAntesMs <= CAPTURA_JANELA_PAD_MS) {
+        pad = padAntes;
+      }
+    }
+    if (completa) {
+      return true;
+    }
+    // Um golpe começado continua sendo capturado mesmo depois do limite
+    if (fase == FaseCaptura::Monitorando && millis() - inicioMs >= limiteMs) {
+      return false;
+    }
+    vTaskDelayUntil(&ultimoDespertar, pdMS_TO_TICKS(1000 / CAPTURA_TAXA_HZ));
+  }
+}
+
+float CapturaGolpe::analisarForca() {
+  static PipelineForca<FFTForca<SAMPLES>> pipeline;
+  if (fase != FaseCaptura::Completa) {
+    return 0;
+  }
+  pipeline.reiniciar();
+  float maior = 0;
+  for (uint16_t i = 0; i < tamanho; i++) {
+    const AmostraGolpe& s = amostra(i);
+    float forca = pipeline.processar(sqrtf(s.ax * s.ax + s.ay * s.ay + s.az * s.az));
+    if (forca > maior) {
+      maior = forca;
+    }
+  }
+  return maior;
+}
+
+const AmostraGolpe& CapturaGolpe::amostra(uint16_t indice) const {
+  return buffer[(inicio + indice) % CAPTURA_MAX_AMOSTRAS];
+}
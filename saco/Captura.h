@@ -0,0 +1,96 @@
+/**
+ * @file Captura.h
+ * @brief Captura de golpes disparada pelo impacto, com buffer pré-gatilho
+ *
+ * Em vez de amostrar uma janela fixa depois do "BATA", o saco monitora o
+ * MPU6500 continuamente e só analisa a janela em torno do golpe:
+ *
+ * - Monitorando: cada amostra (aceleração + giro) entra num buffer circular
+ *   que guarda os últimos preMs. O custo por amostra é uma resultante e uma
+ *   comparação; a estimativa de repouso (média móvel exponencial da
+ *   resultante) acompanha a gravidade e mudanças lentas.
+ * - Capturando: quando a resultante se afasta do repouso mais que o
+ *   limiar, a amostra vira o gatilho e a captura guarda mais posMs.
+ * - Completa: a janela [gatilho - preMs, gatilho + posMs) fica disponível
+ *   até reiniciar(); analisarForca() roda o espectro só sobre ela.
+ *
+ * aguardarGolpe() também lê os pads a cada CAPTURA_PERIODO_TOQUE_MS e
+ * guarda o pad atingido (para o Classificador.h).
+ */
+#ifndef CAPTURA_H
+#define CAPTURA_H
+
+#include <Arduino.h>
+#include "Sensores.h"
+
+#define CAPTURA_TAXA_HZ 1000      // Uma amostra por tick
+#define CAPTURA_PRE_MS 100
+#define CAPTURA_POS_MS 300
+#define CAPTURA_MAX_MS 500        // Limite de preMs + posMs (tamanho do buffer)
+#define CAPTURA_MAX_AMOSTRAS (CAPTURA_MAX_MS * CAPTURA_TAXA_HZ / 1000)
+#define CAPTURA_LIMIAR_G 1.5f     // Desvio da resultante em relação ao repouso
+#define CAPTURA_ALFA_REPOUSO 0.01f
+#define CAPTURA_ESPERA_MS 10000   // Tempo máximo esperando o golpe no modo força
+#define CAPTURA_PERIODO_TOQUE_MS 10
+#define CAPTURA_JANELA_PAD_MS 50  // Toque até 50 ms antes do gatilho ainda é do golpe
+
+struct AmostraGolpe {
+  uint32_t tempoUs;
+  float ax, ay, az;  // g
+  float gx, gy, gz;  // graus/s
+};
+
+enum class FaseCaptura {
+  Monitorando,
+  Capturando,
+  Completa
+};
+
+class CapturaGolpe {
+public:
+  CapturaGolpe();
+
+  // Valores fora da faixa são limitados a CAPTURA_MAX_MS; reinicia a captura
+  void configurar(uint16_t preMs, uint16_t posMs, float limiarG);
+
+  // Volta a monitorar; mantém a estimativa de repouso
+  void reiniciar();
+
+  // Uma amostra do MPU; true quando a janela acabou de ficar completa
+  bool adicionar(uint32_t tempoUs, const xyzFloat& aceleracao, const xyzFloat& giro);
+
+  // Lê o MPU a CAPTURA_TAXA_HZ até capturar um golpe (true) ou passar limiteMs
+  bool aguardarGolpe(Sensores& sensores, uint32_t limiteMs);
+
+  // Espectro (mesmo backend e escala do calcularForca) só sobre a janela
+  float analisarForca();
+
+  FaseCaptura getFase() const { return fase; }
+  uint16_t getTamanho() const { return tamanho; }          // Amostras na janela
+  uint16_t getIndiceGatilho() const { return indiceGatilho; }
+  const AmostraGolpe& amostra(uint16_t indice) const;      // 0: a mais antiga
+  float getRepousoG() const { return repousoG; }
+  int getPad() const { return pad; }                       // -1: nenhum pad tocado
+  uint32_t getAmostrasMonitoradas() const { return amostrasMonitoradas; }
+
+private:
+  AmostraGolpe buffer[CAPTURA_MAX_AMOSTRAS];
+  uint16_t preAmostras;
+  uint16_t posAmostras;
+  float limiarG;
+
+  FaseCaptura fase;
+  uint16_t cabeca;         // Próxima posição de escrita
+  uint16_t inicio;         // Amostra mais antiga da janela
+  uint16_t tamanho;
+  uint16_t indiceGatilho;
+  uint16_t posRestantes;
+  float repousoG;
+  bool repousoIniciado;
+  uint32_t amostrasMonitoradas;
+  int8_t pad;
+};
+
+extern CapturaGolpe captura;
+
+#endif
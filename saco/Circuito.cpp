@@ -0,0 +1,459 @@
+/**
+ * @file Circuito.cpp
+ * @brief Sincronia de relógios, agendamento dos estímulos e junção dos resultados
+ */
+#include "Circuito.h"
+#include <string.h>
+
+// ---------------------------------------------------------------- RelogioPar
+
+void RelogioPar::zerar() {
+  sincronizado = false;
+  deslocamentoUs = 0;
+  referenciaUs = 0;
+  incertezaUs = 0;
+  derivaPpb = 0;
+  ancorado = false;
+  ancoraDeslocamentoUs = 0;
+  ancoraReferenciaUs = 0;
+  iniciarJanela();
+}
+
+void RelogioPar::iniciarJanela() {
+  amostras = 0;
+  melhorIdaVoltaUs = 0;
+  melhorDeslocamentoUs = 0;
+  melhorReferenciaUs = 0;
+}
+
+void RelogioPar::adicionar(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4) {
+  // Ida e volta sem o tempo que o vizinho levou para responder
+  int32_t idaVolta = (int32_t)((t4 - t1) - (t3 - t2));
+  if (idaVolta < 0) {
+    return;  // Carimbos trocados: a amostra não serve
+  }
+  if (amostras == 0 || (uint32_t)idaVolta < melhorIdaVoltaUs) {
+    melhorIdaVoltaUs = idaVolta;
+    // ((t2 - t1) + (t3 - t4)) / 2 sem estourar: tudo módulo 2^32
+    melhorDeslocamentoUs = t2 - t1 - (uint32_t)idaVolta / 2;
+    melhorReferenciaUs = t1 + (t4 - t1) / 2;
+  }
+  amostras++;
+}
+
+bool RelogioPar::fecharJanela() {
+  if (amostras == 0) {
+    return false;
+  }
+  if (!ancorado) {
+    ancorado = true;
+    ancoraDeslocamentoUs = melhorDeslocamentoUs;
+    ancoraReferenciaUs = melhorReferenciaUs;
+  } else {
+    int32_t base = (int32_t)(melhorReferenciaUs - ancoraReferenciaUs);
+    if (base >= 1000000) {
+      int64_t ppb = (int64_t)(int32_t)(melhorDeslocamentoUs - ancoraDeslocamentoUs) * 1000000000LL / base;
+      if (ppb > -CIRCUITO_DERIVA_MAX_PPB && ppb < CIRCUITO_DERIVA_MAX_PPB) {
+        derivaPpb = (int32_t)ppb;
+      }
+    }
+  }
+  deslocamentoUs = melhorDeslocamentoUs;
+  referenciaUs = melhorReferenciaUs;
+  incertezaUs = melhorIdaVoltaUs / 2;
+  sincronizado = true;
+  return true;
+}
+
+int32_t RelogioPar::correcaoUs(uint32_t mestreUs) const {
+  return (int32_t)((int64_t)(int32_t)(mestreUs - referenciaUs) * derivaPpb / 1000000000LL);
+}
+
+uint32_t RelogioPar::paraLocal(uint32_t mestreUs) const {
+  return mestreUs + deslocamentoUs + correcaoUs(mestreUs);
+}
+
+uint32_t RelogioPar::paraMestre(uint32_t localUs) const {
+  // A correção muda menos de 1 us entre o instante local e o do mestre
+  uint32_t mestreUs = localUs - deslocamentoUs;
+  return mestreUs - correcaoUs(mestreUs);
+}
+
+// ---------------------------------------------------------------- Participante
+
+ParticipanteCircuito::ParticipanteCircuito(TransporteCircuito& transporte)
+  : transporte(transporte), coordenadorLocal(nullptr), disponivel(false), ativo(false), sessao(0),
+    ultimoContatoUs(0), pendente(false), emEstimulo(false), rodada(0), pad(0), disparoUs(0),
+    janelaUs(0) {
+  memset(coordenador, 0, sizeof(coordenador));
+}
+
+bool ParticipanteCircuito::tratar(const QuadroCircuito& quadro) {
+  const MensagemCircuito& mensagem = quadro.mensagem;
+  if (mensagem.versao != CIRCUITO_VERSAO) {
+    return false;
+  }
+  MensagemCircuito resposta;
+  memset(&resposta, 0, sizeof(resposta));
+
+  if (mensagem.tipo == TipoMensagemCircuito::Anuncio) {
+    if (ativo || !disponivel) {
+      return false;
+    }
+    ativo = true;
+    sessao = mensagem.sessao;
+    memcpy(coordenador, quadro.origem, sizeof(coordenador));
+    coordenadorLocal = nullptr;
+    ultimoContatoUs = quadro.recebidoUs;
+    responder(TipoMensagemCircuito::Adesao, resposta);
+    return true;
+  }
+
+  // O resto só vale da sessão em que o saco entrou
+  if (!ativo || coordenadorLocal != nullptr || mensagem.sessao != sessao ||
+      memcmp(quadro.origem, coordenador, sizeof(coordenador)) != 0) {
+    return false;
+  }
+  ultimoContatoUs = quadro.recebidoUs;
+  switch (mensagem.tipo) {
+    case TipoMensagemCircuito::Ping:
+      resposta.t1 = mensagem.t1;
+      resposta.t2 = quadro.recebidoUs;
+      responder(TipoMensagemCircuito::Pong, resposta);
+      return true;
+    case TipoMensagemCircuito::Estimulo:
+      agendar(mensagem.rodada, mensagem.tempoUs, mensagem.pad, mensagem.duracaoUs);
+      return true;
+    case TipoMensagemCircuito::Fim:
+      sair();
+      return true;
+    default:
+      return false;
+  }
+}
+
+int ParticipanteCircuito::processar() {
+  if (!ativo) {
+    return -1;
+  }
+  uint32_t agora = transporte.agoraUs();
+  if (pendente && (int32_t)(agora - disparoUs) >= 0) {
+    pendente = false;
+    emEstimulo = true;
+    disparoUs = agora;  // A reação conta do disparo real
+    return pad;
+  }
+  if (emEstimulo && agora - disparoUs > janelaUs) {
+    informarToque(-1, 0);
+  }
+  if (!pendente && !emEstimulo && coordenadorLocal == nullptr &&
+      agora - ultimoContatoUs > CIRCUITO_SILENCIO_MS * 1000UL) {
+    sair();  // Coordenador desligou ou saiu do alcance
+  }
+  return -1;
+}
+
+bool ParticipanteCircuito::informarToque(int padTocado, uint32_t inicioUs) {
+  if (!emEstimulo) {
+    return false;
+  }
+  int32_t reacao = (int32_t)(inicioUs - disparoUs);
+  if (padTocado >= 0 && reacao < 0) {
+    return false;  // Largada queimada
+  }
+  emEstimulo = false;
+  MensagemCircuito resultado;
+  memset(&resultado, 0, sizeof(resultado));
+  resultado.rodada = rodada;
+  resultado.pad = pad;
+  resultado.padTocado = padTocado;
+  resultado.tempoUs = disparoUs;
+  resultado.duracaoUs = padTocado < 0 ? CIRCUITO_SEM_TOQUE : reacao;
+  responder(TipoMensagemCircuito::Resultado, resultado);
+  return true;
+}
+
+void ParticipanteCircuito::ligarCoordenador(CoordenadorCircuito* coordenador, uint16_t sessao) {
+  coordenadorLocal = coordenador;
+  this->sessao = sessao;
+  transporte.getMac(this->coordenador);
+  ativo = true;
+  pendente = false;
+  emEstimulo = false;
+}
+
+void ParticipanteCircuito::agendar(uint16_t rodada, uint32_t disparoUs, uint8_t pad, uint32_t janelaUs) {
+  this->rodada = rodada;
+  this->disparoUs = disparoUs;
+  this->pad = pad;
+  this->janelaUs = janelaUs;
+  pendente = true;
+  emEstimulo = false;
+}
+
+void ParticipanteCircuito::sair() {
+  ativo = false;
+  pendente = false;
+  emEstimulo = false;
+  coordenadorLocal = nullptr;
+}
+
+void ParticipanteCircuito::responder(TipoMensagemCircuito tipo, MensagemCircuito& mensagem) {
+  mensagem.versao = CIRCUITO_VERSAO;
+  mensagem.tipo = tipo;
+  mensagem.sessao = sessao;
+  if (coordenadorLocal != nullptr) {
+    QuadroCircuito quadro;
+    transporte.getMac(quadro.origem);
+    quadro.recebidoUs = transporte.agoraUs();
+    quadro.mensagem = mensagem;
+    coordenadorLocal->tratar(quadro);
+    return;
+  }
+  mensagem.t3 = transporte.agoraUs();  // O mais perto possível do envio
+  transporte.enviar(coordenador, mensagem);
+}
+
+// ---------------------------------------------------------------- Coordenador
+
+CoordenadorCircuito::CoordenadorCircuito(TransporteCircuito& transporte, ParticipanteCircuito& local)
+  : transporte(transporte), local(local), etapa(EtapaCircuito::Parado), sessao(0), rodadas(0),
+    numPads(1), janelaUs(0), pausaUs(0), numSacos(0), etapaInicioUs(0), ultimoPingUs(0),
+    amostrasAlvo(0), atualPronta(false), respostas(0) {
+  memset(&atual, 0, sizeof(atual));
+}
+
+void CoordenadorCircuito::iniciar(uint16_t rodadas, uint8_t numPads, uint32_t janelaMs, uint32_t pausaMs) {
+  this->rodadas = rodadas;
+  this->numPads = numPads > 0 ? numPads : 1;
+  janelaUs = janelaMs * 1000UL;
+  pausaUs = pausaMs * 1000UL;
+  sessao = (uint16_t)random(1, 65536);
+  numSacos = 0;
+  memset(&atual, 0, sizeof(atual));
+  atualPronta = false;
+
+  local.ligarCoordenador(this, sessao);
+  MensagemCircuito anuncio;
+  memset(&anuncio, 0, sizeof(anuncio));
+  enviar(CIRCUITO_BROADCAST, TipoMensagemCircuito::Anuncio, anuncio);
+  mudarEtapa(EtapaCircuito::Descoberta);
+}
+
+bool CoordenadorCircuito::tratar(const QuadroCircuito& quadro) {
+  const MensagemCircuito& mensagem = quadro.mensagem;
+  if (!getAtivo() || mensagem.versao != CIRCUITO_VERSAO || mensagem.sessao != sessao) {
+    return false;
+  }
+
+  switch (mensagem.tipo) {
+    case TipoMensagemCircuito::Adesao:
+      if (etapa != EtapaCircuito::Descoberta || indiceSaco(quadro.origem) >= 0 ||
+          numSacos >= CIRCUITO_MAX_SACOS) {
+        return false;
+      }
+      memcpy(sacos[numSacos].mac, quadro.origem, sizeof(sacos[numSacos].mac));
+      sacos[numSacos].relogio.zerar();
+      sacos[numSacos].pingsEnviados = 0;
+      numSacos++;
+      return true;
+
+    case TipoMensagemCircuito::Pong: {
+      int indice = indiceSaco(quadro.origem);
+      if (indice < 0) {
+        return false;
+      }
+      sacos[indice].relogio.adicionar(mensagem.t1, mensagem.t2, mensagem.t3, quadro.recebidoUs);
+      return true;
+    }
+
+    case TipoMensagemCircuito::Resultado: {
+      if (etapa != EtapaCircuito::Rodada || mensagem.rodada != atual.numero) {
+        return false;  // Atrasado, de uma rodada já fechada
+      }
+      uint8_t mac[6];
+      transporte.getMac(mac);
+      int posicao = 0;
+      uint32_t disparoMestre = mensagem.tempoUs;
+      if (memcmp(quadro.origem, mac, sizeof(mac)) != 0) {
+        int indice = indiceSaco(quadro.origem);
+        if (indice < 0) {
+          return false;
+        }
+        posicao = indice + 1;
+        disparoMestre = sacos[indice].relogio.paraMestre(mensagem.tempoUs);
+      }
+      ResultadoSacoCircuito& resultado = atual.sacos[posicao];
+      if (resultado.respondeu) {
+        return false;
+      }
+      resultado.respondeu = true;
+      resultado.padTocado = mensagem.padTocado;
+      resultado.reacaoUs = mensagem.duracaoUs;
+      resultado.atrasoDisparoUs = (int32_t)(disparoMestre - atual.disparoUs);
+      respostas++;
+      if (respostas == atual.numSacos) {
+        encerrarRodada();
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+void CoordenadorCircuito::processar() {
+  uint32_t agora = transporte.agoraUs();
+  uint32_t decorrido = agora - etapaInicioUs;
+
+  switch (etapa) {
+    case EtapaCircuito::Descoberta:
+      if (decorrido >= CIRCUITO_DESCOBERTA_MS * 1000UL) {
+        iniciarSincronia(CIRCUITO_AMOSTRAS_SINC);
+      }
+      break;
+
+    case EtapaCircuito::Sincronia: {
+      if (agora - ultimoPingUs < CIRCUITO_INTERVALO_PING_MS * 1000UL) {
+        break;
+      }
+      bool faltam = false;
+      for (uint8_t i = 0; i < numSacos; i++) {
+        if (sacos[i].pingsEnviados < amostrasAlvo) {
+          MensagemCircuito ping;
+          memset(&ping, 0, sizeof(ping));
+          ping.t1 = transporte.agoraUs();
+          enviar(sacos[i].mac, TipoMensagemCircuito::Ping, ping);
+          sacos[i].pingsEnviados++;
+          faltam = true;
+        }
+      }
+      ultimoPingUs = agora;
+      // Depois do último ping, um intervalo para os pongs voltarem
+      if (!faltam) {
+        for (uint8_t i = 0; i < numSacos; i++) {
+          sacos[i].relogio.fecharJanela();
+        }
+        iniciarRodada();
+      }
+      break;
+    }
+
+    case EtapaCircuito::Rodada:
+      if ((int32_t)(agora - atual.disparoUs) > (int32_t)(janelaUs + CIRCUITO_MARGEM_MS * 1000UL)) {
+        encerrarRodada();  // Quem não respondeu fica como ausente
+      }
+      break;
+
+    case EtapaCircuito::Pausa:
+      if (decorrido >= pausaUs) {
+        iniciarSincronia(CIRCUITO_AMOSTRAS_RESINC);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+bool CoordenadorCircuito::rodadaPronta(RodadaCircuito& rodada) {
+  if (!atualPronta) {
+    return false;
+  }
+  rodada = atual;
+  atualPronta = false;
+  return true;
+}
+
+void CoordenadorCircuito::parar() {
+  if (!getAtivo()) {
+    return;
+  }
+  MensagemCircuito fim;
+  memset(&fim, 0, sizeof(fim));
+  enviar(CIRCUITO_BROADCAST, TipoMensagemCircuito::Fim, fim);
+  local.sair();
+  mudarEtapa(EtapaCircuito::Concluido);
+}
+
+void CoordenadorCircuito::getMacSaco(uint8_t indice, uint8_t mac[6]) const {
+  memcpy(mac, sacos[indice].mac, 6);
+}
+
+void CoordenadorCircuito::mudarEtapa(EtapaCircuito nova) {
+  etapa = nova;
+  etapaInicioUs = transporte.agoraUs();
+}
+
+void CoordenadorCircuito::enviar(const uint8_t destino[6], TipoMensagemCircuito tipo,
+                                 MensagemCircuito& mensagem) {
+  mensagem.versao = CIRCUITO_VERSAO;
+  mensagem.tipo = tipo;
+  mensagem.sessao = sessao;
+  transporte.enviar(destino, mensagem);
+}
+
+void CoordenadorCircuito::iniciarSincronia(uint16_t amostras) {
+  for (uint8_t i = 0; i < numSacos; i++) {
+    sacos[i].relogio.iniciarJanela();
+    sacos[i].pingsEnviados = 0;
+  }
+  amostrasAlvo = amostras;
+  ultimoPingUs = transporte.agoraUs() - CIRCUITO_INTERVALO_PING_MS * 1000UL;
+  mudarEtapa(EtapaCircuito::Sincronia);
+}
+
+void CoordenadorCircuito::iniciarRodada() {
+  uint16_t numero = atual.numero + 1;
+  memset(&atual, 0, sizeof(atual));
+  atual.numero = numero;
+  atual.disparoUs = transporte.agoraUs() + CIRCUITO_ANTECEDENCIA_MS * 1000UL;
+  atual.numSacos = numSacos + 1;
+  respostas = 0;
+  atualPronta = false;
+
+  for (uint8_t i = 0; i < atual.numSacos; i++) {
+    ResultadoSacoCircuito& resultado = atual.sacos[i];
+    resultado.pad = (uint8_t)random(1, numPads + 1);
+    resultado.padTocado = -1;
+    resultado.reacaoUs = CIRCUITO_SEM_TOQUE;
+    if (i == 0) {
+      transporte.getMac(resultado.mac);
+      local.agendar(numero, atual.disparoUs, resultado.pad, janelaUs);
+      continue;
+    }
+    const Saco& saco = sacos[i - 1];
+    memcpy(resultado.mac, saco.mac, sizeof(resultado.mac));
+    if (!saco.relogio.getSincronizado()) {
+      continue;  // Nenhum pong ainda: sem como marcar o disparo no relógio dele
+    }
+    resultado.incertezaUs = saco.relogio.getIncertezaUs();
+    MensagemCircuito estimulo;
+    memset(&estimulo, 0, sizeof(estimulo));
+    estimulo.rodada = numero;
+    estimulo.pad = resultado.pad;
+    estimulo.tempoUs = saco.relogio.paraLocal(atual.disparoUs);
+    estimulo.duracaoUs = janelaUs;
+    enviar(saco.mac, TipoMensagemCircuito::Estimulo, estimulo);
+  }
+  mudarEtapa(EtapaCircuito::Rodada);
+}
+
+void CoordenadorCircuito::encerrarRodada() {
+  atualPronta = true;
+  if (atual.numero >= rodadas) {
+    parar();
+  } else {
+    mudarEtapa(EtapaCircuito::Pausa);
+  }
+}
+
+int CoordenadorCircuito::indiceSaco(const uint8_t mac[6]) const {
+  for (uint8_t i = 0; i < numSacos; i++) {
+    if (memcmp(sacos[i].mac, mac, 6) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file Circuito.h
+ * @brief Modo circuito: vários sacos de uma estação com o mesmo "já"
+ *
+ * Pelo app cada saco recebe comandos sozinho, pela nuvem, e a latência do
+ * Firebase (centenas de ms, variando) não deixa disparar dois sacos juntos.
+ * No circuito o saco que recebeu o comando coordena os vizinhos por um
+ * transporte local (ESP-NOW no saco, TransporteEspNow.h):
+ *
+ * 1. Descoberta: o coordenador anuncia uma sessão em broadcast e os sacos
+ *    livres (estado inicial ou ocioso) aderem.
+ * 2. Sincronia: para cada saco, CIRCUITO_AMOSTRAS_SINC trocas de ping no
+ *    estilo do NTP (t1 envio, t2 chegada e t3 resposta no saco, t4 volta).
+ *    A amostra de menor ida e volta dá a diferença entre os relógios: com
+ *    atraso simétrico o erro fica abaixo de metade da ida e volta, bem
+ *    abaixo de 1 ms no ESP-NOW. Entre rodadas a sincronia é refeita com
+ *    menos amostras e a deriva dos cristais entra como inclinação.
+ * 3. Rodadas: o coordenador marca um instante CIRCUITO_ANTECEDENCIA_MS à
+ *    frente e manda a cada saco esse instante já no relógio dele, com um
+ *    pad sorteado. Todos disparam juntos; cada um mede a reação no próprio
+ *    relógio e devolve o resultado.
+ * 4. Resultados: o coordenador junta as respostas de cada rodada em uma
+ *    RodadaCircuito (quem não respondeu fica como ausente) e a tarefa do
+ *    circuito envia ao Firebase.
+ *
+ * O protocolo não bloqueia nem lê sensores: a tarefa entrega os quadros
+ * recebidos (tratar), chama processar() a cada volta e informa o toque do
+ * estímulo. Assim os testes rodam vários sacos numa thread, com enlaces
+ * simulados que somam atraso e variação (host/testes/teste_circuito.cpp).
+ */
+#ifndef CIRCUITO_H
+#define CIRCUITO_H
+
+#include <Arduino.h>
+
+#define CIRCUITO_VERSAO 1
+#define CIRCUITO_MAX_SACOS 8            // Vizinhos de um coordenador
+#define CIRCUITO_DESCOBERTA_MS 300
+#define CIRCUITO_AMOSTRAS_SINC 16
+#define CIRCUITO_AMOSTRAS_RESINC 4
+#define CIRCUITO_INTERVALO_PING_MS 5
+#define CIRCUITO_ANTECEDENCIA_MS 100    // Do agendamento ao disparo
+#define CIRCUITO_JANELA_PADRAO_MS 3000  // Para o toque depois do disparo
+#define CIRCUITO_MARGEM_MS 500          // Espera pelos resultados depois da janela
+#define CIRCUITO_PAUSA_PADRAO_MS 2000
+#define CIRCUITO_RODADAS_PADRAO 5
+#define CIRCUITO_SILENCIO_MS 10000      // Sem notícia do coordenador, o saco sai
+#define CIRCUITO_DERIVA_MAX_PPB 500000  // Inclinação maior que 500 ppm é erro de medida
+#define CIRCUITO_SEM_TOQUE 0xFFFFFFFFu
+
+static const uint8_t CIRCUITO_BROADCAST[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+enum class TipoMensagemCircuito : uint8_t {
+  Anuncio,    // Coordenador → todos: sessão aberta
+  Adesao,     // Saco → coordenador
+  Ping,       // t1
+  Pong,       // t1 de volta, t2 e t3 do saco
+  Estimulo,   // tempoUs no relógio do saco, pad, duracaoUs = janela
+  Resultado,  // tempoUs = disparo, duracaoUs = reação (CIRCUITO_SEM_TOQUE: nenhuma)
+  Fim
+};
+
+// No ar: 28 bytes, cabe em um quadro ESP-NOW (até 250)
+struct __attribute__((packed)) MensagemCircuito {
+  uint8_t versao;
+  TipoMensagemCircuito tipo;
+  uint16_t sessao;
+  uint16_t rodada;
+  uint8_t pad;        // 1 a NUM_SENSORES, como o LED da precisão
+  int8_t padTocado;   // -1: nenhum
+  uint32_t t1, t2, t3;
+  uint32_t tempoUs;
+  uint32_t duracaoUs;
+};
+
+struct QuadroCircuito {
+  uint8_t origem[6];
+  uint32_t recebidoUs;  // Relógio local na chegada (t2 ou t4)
+  MensagemCircuito mensagem;
+};
+
+// Enlace entre sacos. agoraUs() é o relógio que o protocolo sincroniza:
+// no saco, micros(); nos testes, um relógio por saco com deslocamento e deriva
+class TransporteCircuito {
+public:
+  virtual ~TransporteCircuito() {}
+
+  virtual bool iniciar() = 0;
+  virtual bool enviar(const uint8_t destino[6], const MensagemCircuito& mensagem) = 0;
+  // Até esperaMs pelo próximo quadro; false se não chegou nenhum
+  virtual bool receber(QuadroCircuito& quadro, uint32_t esperaMs) = 0;
+  virtual uint32_t agoraUs() = 0;
+  virtual void getMac(uint8_t mac[6]) = 0;
+};
+
+// Relógio de um vizinho visto do coordenador: local = mestre + deslocamento,
+// corrigido pela deriva desde a última sincronia
+class RelogioPar {
+public:
+  RelogioPar() { zerar(); }
+
+  void zerar();
+  void iniciarJanela();
+  // t1 e t4 no relógio do coordenador, t2 e t3 no do vizinho
+  void adicionar(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4);
+  // Adota a melhor amostra da janela; false se não houve nenhuma
+  bool fecharJanela();
+
+  uint32_t paraLocal(uint32_t mestreUs) const;
+  uint32_t paraMestre(uint32_t localUs) const;
+
+  bool getSincronizado() const { return sincronizado; }
+  uint32_t getDeslocamentoUs() const { return deslocamentoUs; }
+  uint32_t getIncertezaUs() const { return incertezaUs; }  // Metade da menor ida e volta
+  int32_t getDerivaPpb() const { return derivaPpb; }
+  uint16_t getAmostras() const { return amostras; }
+
+private:
+  bool sincronizado;
+  uint32_t deslocamentoUs;  // Módulo 2^32: os sacos ligam em horas diferentes
+  uint32_t referenciaUs;    // Instante do mestre em que o deslocamento foi medido
+  uint32_t incertezaUs;
+  int32_t derivaPpb;
+
+  // Primeira sincronia: a deriva é medida contra ela, com a base crescendo
+  // a cada rodada (o erro de cada medida pesa menos numa base longa)
+  bool ancorado;
+  uint32_t ancoraDeslocamentoUs;
+  uint32_t ancoraReferenciaUs;
+
+  uint16_t amostras;
+  uint32_t melhorIdaVoltaUs;
+  uint32_t melhorDeslocamentoUs;
+  uint32_t melhorReferenciaUs;
+
+  int32_t correcaoUs(uint32_t mestreUs) const;
+};
+
+struct ResultadoSacoCircuito {
+  uint8_t mac[6];
+  bool respondeu;
+  uint8_t pad;
+  int8_t padTocado;        // -1: nenhum toque na janela
+  uint32_t reacaoUs;       // CIRCUITO_SEM_TOQUE sem toque
+  int32_t atrasoDisparoUs; // Disparo real menos o marcado, no relógio do coordenador
+  uint32_t incertezaUs;    // Da sincronia desse saco
+};
+
+struct RodadaCircuito {
+  uint16_t numero;
+  uint32_t disparoUs;      // Relógio do coordenador
+  uint8_t numSacos;        // Incluindo o coordenador, que é o primeiro
+  ResultadoSacoCircuito sacos[CIRCUITO_MAX_SACOS + 1];
+};
+
+class CoordenadorCircuito;
+
+// Lado de cada saco (o coordenador também tem o seu, ligado direto)
+class ParticipanteCircuito {
+public:
+  explicit ParticipanteCircuito(TransporteCircuito& transporte);
+
+  // Só adere a uma sessão quando livre
+  void definirDisponivel(bool disponivel) { this->disponivel = disponivel; }
+  bool tratar(const QuadroCircuito& quadro);
+  // O pad do estímulo quando chega a hora de disparar; -1 nas outras voltas
+  int processar();
+  // Toque do estímulo em andamento (padTocado -1: a janela acabou). Uma
+  // borda que começou antes do disparo é largada queimada: false, nada é
+  // enviado e o estímulo segue esperando um toque dentro da janela
+  bool informarToque(int padTocado, uint32_t inicioUs);
+
+  // Estímulo marcado pelo coordenador do próprio saco, sem passar pelo ar
+  void ligarCoordenador(CoordenadorCircuito* coordenador, uint16_t sessao);
+  void agendar(uint16_t rodada, uint32_t disparoUs, uint8_t pad, uint32_t janelaUs);
+  void sair();
+
+  bool getAtivo() const { return ativo; }
+  bool getEmEstimulo() const { return emEstimulo; }
+  uint32_t getDisparoUs() const { return disparoUs; }
+  uint16_t getSessao() const { return sessao; }
+
+private:
+  TransporteCircuito& transporte;
+  CoordenadorCircuito* coordenadorLocal;
+  bool disponivel;
+  bool ativo;
+  uint16_t sessao;
+  uint8_t coordenador[6];
+  uint32_t ultimoContatoUs;
+
+  bool pendente;
+  bool emEstimulo;
+  uint16_t rodada;
+  uint8_t pad;
+  uint32_t disparoUs;
+  uint32_t janelaUs;
+
+  void responder(TipoMensagemCircuito tipo, MensagemCircuito& mensagem);
+};
+
+enum class EtapaCircuito : uint8_t {
+  Parado,
+  Descoberta,
+  Sincronia,
+  Rodada,
+  Pausa,
+  Concluido
+};
+
+class CoordenadorCircuito {
+public:
+  CoordenadorCircuito(TransporteCircuito& transporte, ParticipanteCircuito& local);
+
+  void iniciar(uint16_t rodadas, uint8_t numPads, uint32_t janelaMs = CIRCUITO_JANELA_PADRAO_MS,
+               uint32_t pausaMs = CIRCUITO_PAUSA_PADRAO_MS);
+  bool tratar(const QuadroCircuito& quadro);
+  void processar();
+  // Uma vez por rodada encerrada
+  bool rodadaPronta(RodadaCircuito& rodada);
+  // Avisa os vizinhos e encerra (também no fim das rodadas)
+  void parar();
+
+  EtapaCircuito getEtapa() const { return etapa; }
+  bool getAtivo() const { return etapa != EtapaCircuito::Parado && etapa != EtapaCircuito::Concluido; }
+  uint16_t getSessao() const { return sessao; }
+  uint8_t getNumSacos() const { return numSacos; }
+  const RelogioPar& getRelogio(uint8_t indice) const { return sacos[indice].relogio; }
+  void getMacSaco(uint8_t indice, uint8_t mac[6]) const;
+
+private:
+  struct Saco {
+    uint8_t mac[6];
+    RelogioPar relogio;
+    uint16_t pingsEnviados;
+  };
+
+  TransporteCircuito& transporte;
+  ParticipanteCircuito& local;
+  EtapaCircuito etapa;
+  uint16_t sessao;
+  uint16_t rodadas;
+  uint8_t numPads;
+  uint32_t janelaUs;
+  uint32_t pausaUs;
+
+  Saco sacos[CIRCUITO_MAX_SACOS];
+  uint8_t numSacos;
+  uint32_t etapaInicioUs;
+  uint32_t ultimoPingUs;
+  uint16_t amostrasAlvo;
+
+  RodadaCircuito atual;
+  bool atualPronta;
+  uint8_t respostas;
+
+  void mudarEtapa(EtapaCircuito nova);
+  void enviar(const uint8_t destino[6], TipoMensagemCircuito tipo, MensagemCircuito& mensagem);
+  void iniciarSincronia(uint16_t amostras);
+  void iniciarRodada();
+  void encerrarRodada();
+  int indiceSaco(const uint8_t mac[6]) const;
+};
+
+#endif
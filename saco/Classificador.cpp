@@ -0,0 +1,200 @@
+/**
+ * @file Classificador.cpp
+ * @brief Extração de características e inferência int8 do tipo de golpe
+ */
+#include "Classificador.h"
+#include "Captura.h"
+#include "ModeloGolpes.h"
+#include "Round.h"
+#include <math.h>
+#include <string.h>
+
+#if PUBLICAR_TIPO_GOLPE && !MODELO_GOLPES_GRAVADO
+#error "PUBLICAR_TIPO_GOLPE pede um modelo da placa treinado com traços gravados"
+#endif
+
+ClassificadorGolpes classificadorGolpes;
+
+const char* nomeTipoGolpe(TipoGolpe tipo) {
+  switch (tipo) {
+    case TipoGolpe::Jab: return "jab";
+    case TipoGolpe::Direto: return "direto";
+    case TipoGolpe::Gancho: return "gancho";
+    case TipoGolpe::Uppercut: return "uppercut";
+    default: return "desconhecido";
+  }
+}
+
+void ExtratorGolpe::reiniciar() {
+  repousoVetor[0] = repousoVetor[1] = 0;
+  repousoVetor[2] = 1.0f;
+  repousoIniciado = false;
+  emGolpe = false;
+}
+
+void ExtratorGolpe::repouso(float ax, float ay, float az) {
+  emGolpe = false;
+  if (!repousoIniciado) {
+    repousoVetor[0] = ax;
+    repousoVetor[1] = ay;
+    repousoVetor[2] = az;
+    repousoIniciado = true;
+    return;
+  }
+  repousoVetor[0] += CLASSIFICADOR_ALFA_REPOUSO * (ax - repousoVetor[0]);
+  repousoVetor[1] += CLASSIFICADOR_ALFA_REPOUSO * (ay - repousoVetor[1]);
+  repousoVetor[2] += CLASSIFICADOR_ALFA_REPOUSO * (az - repousoVetor[2]);
+}
+
+void ExtratorGolpe::adicionar(const AmostraGolpe& amostra) {
+  if (!emGolpe) {
+    emGolpe = true;
+    inicioUs = amostra.tempoUs;
+    pico = 0;
+    for (int i = 0; i < 3; i++) {
+      energia[i] = picoVetor[i] = giroPico[i] = 0;
+      passaBaixa30[i] = passaBaixa120[i] = energiaBanda[i] = 0;
+    }
+  }
+  ultimoUs = amostra.tempoUs;
+
+  float d[3] = {amostra.ax - repousoVetor[0], amostra.ay - repousoVetor[1],
+                amostra.az - repousoVetor[2]};
+  float giro[3] = {fabsf(amostra.gx), fabsf(amostra.gy), fabsf(amostra.gz)};
+  float modulo2 = 0;
+  for (int i = 0; i < 3; i++) {
+    energia[i] += d[i] * d[i];
+    modulo2 += d[i] * d[i];
+    if (giro[i] > giroPico[i]) giroPico[i] = giro[i];
+
+    // Bandas: < 30 Hz, 30-120 Hz e > 120 Hz
+    passaBaixa30[i] += CLASSIFICADOR_ALFA_30HZ * (d[i] - passaBaixa30[i]);
+    passaBaixa120[i] += CLASSIFICADOR_ALFA_120HZ * (d[i] - passaBaixa120[i]);
+    float media = passaBaixa120[i] - passaBaixa30[i];
+    float alta = d[i] - passaBaixa120[i];
+    energiaBanda[0] += passaBaixa30[i] * passaBaixa30[i];
+    energiaBanda[1] += media * media;
+    energiaBanda[2] += alta * alta;
+  }
+  float modulo = sqrtf(modulo2);
+  if (modulo > pico) {
+    pico = modulo;
+    memcpy(picoVetor, d, sizeof(picoVetor));
+  }
+}
+
+void ExtratorGolpe::finalizar(int pad, float x[NUM_CARACTERISTICAS]) {
+  memset(x, 0, NUM_CARACTERISTICAS * sizeof(float));
+  if (emGolpe) {
+    float total = energia[0] + energia[1] + energia[2];
+    float totalBandas = energiaBanda[0] + energiaBanda[1] + energiaBanda[2];
+    x[0] = pico;
+    x[1] = (ultimoUs - inicioUs) / 1000.0f;
+    for (int i = 0; i < 3; i++) {
+      x[2 + i] = total > 0 ? energia[i] / total : 0;
+      x[5 + i] = pico > 0 ? picoVetor[i] / pico : 0;
+      x[8 + i] = giroPico[i] / 100.0f;
+      x[11 + i] = totalBandas > 0 ? energiaBanda[i] / totalBandas : 0;
+    }
+  }
+  if (pad >= 0 && pad < NUM_SENSORES) {
+    x[14] = POSICAO_PADS[pad][0];
+    x[15] = POSICAO_PADS[pad][1];
+    x[16] = POSICAO_PADS[pad][2];
+  }
+  emGolpe = false;
+}
+
+const ModeloGolpes& modeloGolpesPadrao() {
+#ifdef MODELO_GOLPES_OCULTOS
+  static const ModeloGolpes modelo = {
+    MODELO_GOLPES_MEDIA, MODELO_GOLPES_ESCALA, MODELO_GOLPES_OCULTOS,
+    &MODELO_GOLPES_PESOS1[0][0], MODELO_GOLPES_VIES1,
+    MODELO_GOLPES_MULTIPLICADOR1, MODELO_GOLPES_DESLOCAMENTO1,
+    &MODELO_GOLPES_PESOS2[0][0], MODELO_GOLPES_VIES2
+  };
+#else
+  static const ModeloGolpes modelo = {nullptr, nullptr, 0, nullptr, nullptr, 0, 0, nullptr, nullptr};
+#endif
+  return modelo;
+}
+
+void ClassificadorGolpes::quantizar(const float x[NUM_CARACTERISTICAS],
+                                    int8_t q[NUM_CARACTERISTICAS]) const {
+  for (int i = 0; i < NUM_CARACTERISTICAS; i++) {
+    float valor = roundf((x[i] - modelo.media[i]) * modelo.escala[i]);
+    q[i] = valor > 127 ? 127 : (valor < -127 ? -127 : (int8_t)valor);
+  }
+}
+
+TipoGolpe ClassificadorGolpes::classificar(const float x[NUM_CARACTERISTICAS],
+                                           int32_t saidas[NUM_TIPOS_GOLPE]) const {
+  if (modelo.ocultos == 0) {
+    // Placa sem modelo
+    if (saidas) {
+      memset(saidas, 0, NUM_TIPOS_GOLPE * sizeof(int32_t));
+    }
+    return TipoGolpe::Desconhecido;
+  }
+  int8_t entrada[NUM_CARACTERISTICAS];
+  quantizar(x, entrada);
+
+  int8_t oculta[CLASSIFICADOR_MAX_OCULTOS];
+  uint8_t ocultos = modelo.ocultos > CLASSIFICADOR_MAX_OCULTOS ? CLASSIFICADOR_MAX_OCULTOS : modelo.ocultos;
+  for (uint8_t j = 0; j < ocultos; j++) {
+    const int8_t* pesos = modelo.pesos1 + j * NUM_CARACTERISTICAS;
+    int32_t acumulado = modelo.vies1[j];
+    for (int i = 0; i < NUM_CARACTERISTICAS; i++) {
+      acumulado += pesos[i] * entrada[i];
+    }
+    // ReLU e volta para int8, com arredondamento
+    if (acumulado <= 0) {
+      oculta[j] = 0;
+      continue;
+    }
+    int64_t escalado = ((int64_t)acumulado * modelo.multiplicador1 +
+                        ((int64_t)1 << (modelo.deslocamento1 - 1))) >> modelo.deslocamento1;
+    oculta[j] = escalado > 127 ? 127 : (int8_t)escalado;
+  }
+
+  int32_t locais[NUM_TIPOS_GOLPE];
+  int32_t* saida = saidas ? saidas : locais;
+  int melhor = 0;
+  for (int k = 0; k < NUM_TIPOS_GOLPE; k++) {
+    const int8_t* pesos = modelo.pesos2 + k * ocultos;
+    int32_t acumulado = modelo.vies2[k];
+    for (uint8_t j = 0; j < ocultos; j++) {
+      acumulado += pesos[j] * oculta[j];
+    }
+    saida[k] = acumulado;
+    if (acumulado > saida[melhor]) {
+      melhor = k;
+    }
+  }
+  return (TipoGolpe)melhor;
+}
+
+void extrairCaracteristicas(const CapturaGolpe& captura, int pad,
+                            float caracteristicas[NUM_CARACTERISTICAS]) {
+  // O mesmo segmentador do modo round decide onde o golpe acaba, para as
+  // características saírem iguais nos dois modos
+  SegmentadorGolpes segmentador;
+  ExtratorGolpe extrator;
+  GolpeSegmentado golpe;
+  for (uint16_t i = 0; i < captura.getTamanho(); i++) {
+    const AmostraGolpe& s = captura.amostra(i);
+    xyzFloat a;
+    a.x = s.ax;
+    a.y = s.ay;
+    a.z = s.az;
+    bool terminou = segmentador.adicionarIMU(s.tempoUs / 1000, a, golpe);
+    if (segmentador.emGolpe()) {
+      extrator.adicionar(s);
+    } else if (terminou) {
+      break;
+    } else {
+      extrator.repouso(s.ax, s.ay, s.az);
+    }
+  }
+  extrator.finalizar(pad, caracteristicas);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file Classificador.h
+ * @brief Tipo do golpe (jab, direto, gancho, uppercut) por um modelo int8
+ *
+ * Duas etapas, ambas com memória constante e passagem única:
+ *
+ * - ExtratorGolpe: recebe as amostras do MPU fora do golpe (acompanha o
+ *   vetor de repouso) e durante o golpe (d = a - repouso), e resume a
+ *   janela em NUM_CARACTERISTICAS valores: pico e duração, fração da
+ *   energia por eixo, direção no pico, pico do giro por eixo, energia em
+ *   três bandas (filtros de um polo em 30 e 120 Hz) e a posição do pad.
+ * - ClassificadorGolpes: MLP NUM_CARACTERISTICAS → MODELO_GOLPES_OCULTOS →
+ *   NUM_TIPOS_GOLPE com pesos int8 e acumulação em int32. As tabelas
+ *   (ModeloGolpes.h) são geradas no host por treinar_classificador, uma
+ *   por placa; a inferência custa ~350 multiplicações.
+ *
+ * O modelo embarcado ainda é treinado com golpes sintéticos: o tipo serve
+ * aos testes, à bancada e ao log, mas só vai para o app (metricas/tipo no
+ * modo força, tipos/ de cada round) com PUBLICAR_TIPO_GOLPE, que pede um
+ * modelo da placa treinado com traços gravados.
+ */
+#ifndef CLASSIFICADOR_H
+#define CLASSIFICADOR_H
+
+#include <Arduino.h>
+#include "Sensores.h"
+
+#define NUM_CARACTERISTICAS 17
+#define NUM_TIPOS_GOLPE 4
+#define CLASSIFICADOR_MAX_OCULTOS 64
+#define CLASSIFICADOR_ALFA_REPOUSO 0.01f
+#define CLASSIFICADOR_ALFA_30HZ 0.17f    // 1 - exp(-2π·30/1000)
+#define CLASSIFICADOR_ALFA_120HZ 0.53f   // 1 - exp(-2π·120/1000)
+
+#ifndef PUBLICAR_TIPO_GOLPE
+#define PUBLICAR_TIPO_GOLPE 0   // 1 só com MODELO_GOLPES_GRAVADO (ModeloGolpes.h)
+#endif
+
+struct AmostraGolpe;
+class CapturaGolpe;
+
+enum class TipoGolpe : uint8_t {
+  Jab,
+  Direto,
+  Gancho,
+  Uppercut,
+  Desconhecido
+};
+
+const char* nomeTipoGolpe(TipoGolpe tipo);
+
+// Posição de cada pad na superfície do saco, nos eixos do MPU: X vai da
+// face da frente para a de trás, Y da esquerda para a direita, Z para cima.
+// Vem do descritor da placa (Placas.h)
+static constexpr const float (&POSICAO_PADS)[NUM_SENSORES][3] = PlacaAtual::posicoes;
+
+class ExtratorGolpe {
+public:
+  ExtratorGolpe() { reiniciar(); }
+
+  // Esquece o repouso e o golpe em andamento
+  void reiniciar();
+
+  // Amostra fora do golpe: acompanha o vetor de repouso e descarta um
+  // golpe que não chegou a ser finalizado
+  void repouso(float ax, float ay, float az);
+
+  // Amostra do golpe; a primeira depois de finalizar() abre um novo golpe
+  void adicionar(const AmostraGolpe& amostra);
+
+  // Características do golpe acumulado (pad -1: nenhum) e volta ao repouso
+  void finalizar(int pad, float caracteristicas[NUM_CARACTERISTICAS]);
+
+private:
+  float repousoVetor[3];
+  bool repousoIniciado;
+
+  bool emGolpe;
+  uint32_t inicioUs;
+  uint32_t ultimoUs;
+  float energia[3];
+  float pico;
+  float picoVetor[3];
+  float giroPico[3];
+  float passaBaixa30[3];
+  float passaBaixa120[3];
+  float energiaBanda[3];
+};
+
+// Tabelas de um modelo quantizado (ModeloGolpes.h ou treinado no host)
+struct ModeloGolpes {
+  const float* media;          // [NUM_CARACTERISTICAS]
+  const float* escala;         // q = (x - media) * escala, limitado a ±127
+  uint8_t ocultos;
+  const int8_t* pesos1;        // [ocultos][NUM_CARACTERISTICAS]
+  const int32_t* vies1;        // [ocultos]
+  int32_t multiplicador1;      // Requantização da camada oculta:
+  uint8_t deslocamento1;       //   h = (acc · multiplicador1) >> deslocamento1
+  const int8_t* pesos2;        // [NUM_TIPOS_GOLPE][ocultos]
+  const int32_t* vies2;        // [NUM_TIPOS_GOLPE]
+};
+
+// O modelo embarcado da placa (ModeloGolpes.h); sem ele, ocultos = 0
+const ModeloGolpes& modeloGolpesPadrao();
+
+class ClassificadorGolpes {
+public:
+  explicit ClassificadorGolpes(const ModeloGolpes& modelo = modeloGolpesPadrao())
+    : modelo(modelo) {}
+
+  void quantizar(const float caracteristicas[NUM_CARACTERISTICAS],
+                 int8_t entrada[NUM_CARACTERISTICAS]) const;
+
+  // Saídas da última camada (opcional) e a classe de maior saída
+  TipoGolpe classificar(const float caracteristicas[NUM_CARACTERISTICAS],
+                        int32_t saidas[NUM_TIPOS_GOLPE] = nullptr) const;
+
+private:
+  const ModeloGolpes& modelo;
+};
+
+extern ClassificadorGolpes classificadorGolpes;
+
+// Características da janela de uma CapturaGolpe (pré-gatilho = repouso)
+void extrairCaracteristicas(const CapturaGolpe& captura, int pad,
+                            float caracteristicas[NUM_CARACTERISTICAS]);
+
+#endif
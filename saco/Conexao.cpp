@@ -1,39 +1,71 @@
 #include "Conexao.h"
+#include "Circuito.h"
+#include "Estatisticas.h"
+#include "Log.h"
+#include "Rastreio.h"
+#include "Round.h"
+#include <esp_ota_ops.h>
+#include <string.h>
 #include <time.h>
 
 ConexaoManager conexao;
 
+// fbdo guarda a resposta da última chamada, e as tarefas de modo o usam junto
+// com a de comunicação: a chamada e a leitura da resposta ficam sob o mutex
+class TravaFirebase {
+public:
+  explicit TravaFirebase(SemaphoreHandle_t mutex) : mutex(mutex) { xSemaphoreTake(mutex, portMAX_DELAY); }
+  ~TravaFirebase() { xSemaphoreGive(mutex); }
+
+private:
+  SemaphoreHandle_t mutex;
+};
+
 ConexaoManager::ConexaoManager() 
-  : timeClient(ntpUDP, "pool.ntp.org", 0) {  // Alterado para UTC+0 br.pool.ntp.org
+  : timeClient(ntpUDP, "pool.ntp.org", 0), streamAtivo(false) {  // Alterado para UTC+0 br.pool.ntp.org
   deviceId = generateDeviceId();
+  // Já no construtor: as tarefas de modo chamam o conexao antes do begin()
+  mutexFirebase = xSemaphoreCreateMutex();
 }
 
 void ConexaoManager::begin() {
+  // Roda na tarefa de comunicação: cada fase marca seu bit em Boot.h
   Serial.println("Iniciando WiFi...");
-  setupWiFi();
+  boot.inicioFase(FaseBoot::WiFi);
+  bool wifi = setupWiFi();
+  boot.fimFase(FaseBoot::WiFi, wifi);
+  if (!wifi) {
+    return;
+  }
   Serial.println("Iniciando NTP...");
-  setupTime();
+  boot.inicioFase(FaseBoot::Hora);
+  boot.fimFase(FaseBoot::Hora, setupTime());
   Serial.println("Iniciando Firebase...");
-  setupFirebase();
+  boot.inicioFase(FaseBoot::Firebase);
+  boot.fimFase(FaseBoot::Firebase, setupFirebase());
+#if USAR_STREAM_COMANDOS
+  beginCommandStream();
+#endif
 }
 
-void ConexaoManager::setupWiFi() {
+bool ConexaoManager::setupWiFi() {
   wifiManager.setConfigPortalTimeout(180);
   String apName = "SacoBoxe_" + deviceId.substring(0, 6);
   
   if (!wifiManager.autoConnect(apName.c_str())) {
-    Serial.println("Falha na conexão WiFi. Reiniciando...");
-    delay(3000);
-    ESP.restart();
+    // Sem reiniciar: os modos locais seguem e a tarefa de comunicação tenta de novo
+    Serial.println("Falha na conexão WiFi");
+    return false;
   }
   
   Serial.print("Conectado ao WiFi: ");
   Serial.println(WiFi.SSID());
   Serial.print("IP: ");
   Serial.println(WiFi.localIP());
+  return true;
 }
 
-void ConexaoManager::setupTime() {
+bool ConexaoManager::setupTime() {
   timeClient.begin();
   timeClient.setTimeOffset(0);  // Mantido em UTC+0
   
@@ -51,17 +83,19 @@ void ConexaoManager::setupTime() {
     // Configurar o fuso horário do sistema para UTC-3 (Brasília)
     setenv("TZ", "GMT+3", 1);
     tzset();
-  } else {
-    Serial.println("Não foi possível sincronizar com NTP. Usando tempo local.");
+    return true;
   }
+  Serial.println("Não foi possível sincronizar com NTP. Usando tempo local.");
+  return false;
 }
 
-void ConexaoManager::setupFirebase() {
+bool ConexaoManager::setupFirebase() {
   config.api_key = API_KEY;
   config.database_url = DATABASE_URL;
   auth.user.email = USER_EMAIL;
   auth.user.password = USER_PASSWORD;
   
+  TravaFirebase trava(mutexFirebase);
   // Configurar buffers para melhor performance
   fbdo.setBSSLBufferSize(4096, 1024);
   fbdo.setResponseSize(2048);
@@ -69,20 +103,28 @@ void ConexaoManager::setupFirebase() {
   Firebase.begin(&config, &auth);
   Firebase.reconnectNetwork(true);
   
-  // Registrar dispositivo
+  // Registrar dispositivo. É um updateNode, não um setJSON: o config/
+  // (fatorNewtons) é do app e tem de sobreviver ao boot. O que é da sessão
+  // anterior sai por null explícito, inclusive o medicoes/ de um saco do
+  // esquema 1; o "esquema" diz às páginas onde pedir e onde ler os resultados
   FirebaseJson deviceInfo;
   deviceInfo.set("deviceId", deviceId);
   deviceInfo.set("estado", "disponivel");
+  deviceInfo.set("esquema", ESQUEMA_DISPOSITIVO);
   deviceInfo.set("timestamp", getTimestamp());
   deviceInfo.set("ultimaConexao", getTimestamp());
+  deviceInfo.set("medicoes");
+  deviceInfo.set("entrada");
+  deviceInfo.set("saida");
   
   String path = "/devices/" + deviceId;
-  if (Firebase.RTDB.setJSON(&fbdo, path.c_str(), &deviceInfo)) {
+  if (Firebase.RTDB.updateNode(&fbdo, path.c_str(), &deviceInfo)) {
     Serial.println("Dispositivo registrado no Firebase");
-  } else {
-    Serial.println("Falha ao registrar dispositivo no Firebase");
-    Serial.println(fbdo.errorReason());
+    return true;
   }
+  Serial.println("Falha ao registrar dispositivo no Firebase");
+  Serial.println(fbdo.errorReason());
+  return false;
 }
 
 bool ConexaoManager::isConnected() {
@@ -111,55 +153,78 @@ String ConexaoManager::getTimeString() {
 }
 
 bool ConexaoManager::checkForCommands() {
+  RASTREIO_TRECHO("conexao.checkForCommands");
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes";
-  if (Firebase.RTDB.getJSON(&fbdo, path.c_str())) {
-    FirebaseJson* json = fbdo.jsonObjectPtr();
-    
-    if (json != nullptr) {
-      FirebaseJsonData jsonData;
-      
-      // Verificar se há um comando solicitado
-      if (json->get(jsonData, "estado") && 
-          jsonData.typeNum == FirebaseJson::JSON_STRING && 
-          jsonData.stringValue == "solicitada") {
-        
-        currentMeasurement.estado = jsonData.stringValue;
-        
-        // Obter tipo se disponível
-        if (json->get(jsonData, "tipo") && jsonData.typeNum == FirebaseJson::JSON_STRING) {
-          currentMeasurement.tipo = jsonData.stringValue;
-        }
-        
-        // Obter usuário se disponível
-        if (json->get(jsonData, "usuario") && jsonData.typeNum == FirebaseJson::JSON_STRING) {
-          currentMeasurement.usuario = jsonData.stringValue;
-        }
-        
-        // Obter timestamp se disponível
-        if (json->get(jsonData, "timestampSolicitacao") && jsonData.typeNum == FirebaseJson::JSON_INT) {
-          currentMeasurement.timestampSolicitacao = jsonData.intValue;
-        }
-        
-        return true;
-      }
-    }
+  // Só a caixa de entrada: os resultados ficam em saida/ e não voltam
+  String path = "/devices/" + deviceId + "/entrada";
+  TravaFirebase trava(mutexFirebase);
+  if (!Firebase.RTDB.getJSON(&fbdo, path.c_str())) {
+    return false;
   }
   
-  return false;
+  // A resposta crua, no buffer do fbdo: sem montar o FirebaseJson nem
+  // copiá-la para uma String (Medicao.h)
+  const char* resposta = fbdo.to<const char*>();
+  Medicao lida;
+  if (!decodificarMedicao(resposta, strlen(resposta), lida) ||
+      lida.estado != EstadoMedicao::Solicitada) {
+    return false;
+  }
+  if (lida.versao > ESQUEMA_DISPOSITIVO) {
+    // Uma página mais nova que o firmware: recusado uma vez, não a cada ciclo
+    LOG_AVISO(Conexao, "Comando do esquema %d recusado (o saco é do %d)", lida.versao,
+              ESQUEMA_DISPOSITIVO);
+    marcarEntrada("recusada");
+    return false;
+  }
+  currentMeasurement = lida;
+  return true;
+}
+
+bool ConexaoManager::beginCommandStream() {
+  String path = "/devices/" + deviceId;
+  streamAtivo = Firebase.RTDB.beginStream(&streamData, path.c_str());
+  if (!streamAtivo) {
+    LOG_ERRO(Conexao, "Falha ao iniciar stream: %s", streamData.errorReason());
+  }
+  return streamAtivo;
+}
+
+bool ConexaoManager::hasRemoteChanges() {
+  RASTREIO_TRECHO("conexao.hasRemoteChanges");
+  if (!streamAtivo) return true;
+  
+  // Em caso de erro no stream, volta a ler como no polling
+  if (!Firebase.RTDB.readStream(&streamData)) {
+    LOG_ERRO(Conexao, "Erro no stream: %s", streamData.errorReason());
+    return true;
+  }
+  
+  // Consome todos os eventos pendentes: uma leitura cobre todos eles
+  bool mudou = false;
+  while (streamData.streamAvailable()) {
+    mudou = true;
+    if (!Firebase.RTDB.readStream(&streamData)) break;
+  }
+  return mudou;
 }
 
 bool ConexaoManager::checkForStopCommand() {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes/comando";
-  if (Firebase.RTDB.getString(&fbdo, path.c_str())) {
-    if (fbdo.stringData() == "parar") {
-      // Limpar o comando após processá-lo
-      Firebase.RTDB.deleteNode(&fbdo, path.c_str());
-      return true;
-    }
+  // "parar" em entrada/comando, ou o nó apagado (o app faz isso ao parar o treino)
+  String path = "/devices/" + deviceId + "/entrada";
+  TravaFirebase trava(mutexFirebase);
+  if (!Firebase.RTDB.getJSON(&fbdo, path.c_str())) {
+    return fbdo.errorReason() == "path not exist";
+  }
+  const char* resposta = fbdo.to<const char*>();
+  Medicao lida;
+  if (decodificarMedicao(resposta, strlen(resposta), lida) && lida.parar) {
+    // Limpar o comando após processá-lo
+    Firebase.RTDB.deleteNode(&fbdo, (path + "/comando").c_str());
+    return true;
   }
   
   return false;
@@ -169,19 +234,21 @@ bool ConexaoManager::checkForStopCommand() {
 bool ConexaoManager::sendCalibrationProgress(int progresso, int total) {
     if (!isConnected()) return false;
     
-    String path = "/devices/" + deviceId + "/medicoes/progressoCalibracao";
+    String path = "/devices/" + deviceId + "/saida/progressoCalibracao";
     FirebaseJson progressoJson;
     progressoJson.set("completos", progresso);
     progressoJson.set("total", total);
     progressoJson.set("percentual", (progresso * 100) / total);
     
+    TravaFirebase trava(mutexFirebase);
     return Firebase.RTDB.setJSON(&fbdo, path.c_str(), &progressoJson);
 }
 
 bool ConexaoManager::sendSensorCalibrated(int sensorIndex) {
     if (!isConnected()) return false;
     
-    String path = "/devices/" + deviceId + "/medicoes/sensoresCalibrados/" + String(sensorIndex);
+    String path = "/devices/" + deviceId + "/saida/sensoresCalibrados/" + String(sensorIndex);
+    TravaFirebase trava(mutexFirebase);
     return Firebase.RTDB.setBool(&fbdo, path.c_str(), true);
 }
 
@@ -193,64 +260,251 @@ bool ConexaoManager::updateDeviceStatus(const String& status) {
   update.set("estado", status);
   update.set("ultimaAtualizacao", getTimestamp());
   
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
 }
 
 bool ConexaoManager::updateDevicemMdicoes(const String status) {
+  RASTREIO_TRECHO("conexao.updateDevicemMdicoes");
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes";
   FirebaseJson update;
-  update.set("estado", status);
+  update.add("saida/estado", status);
   
   if (status == "concluida") {
-    update.set("timestampConclusao", getTimestamp());
+    update.add("saida/timestampConclusao", getTimestamp());
   }
   
-  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+  TravaFirebase trava(mutexFirebase);
+  return atualizarSaida(update, status);
 }
 
 bool ConexaoManager::updateDeviceEx() {
     if (!isConnected()) return false;
     
-    String path = "/devices/" + deviceId + "/medicoes";
     FirebaseJson update;
-    update.set("estado", "executando");
-    update.set("timestampInicio", getTimestamp());
-    update.set("tipo", currentMeasurement.tipo);
-    update.set("usuario", currentMeasurement.usuario);
-    
-    // Inicializar campos de calibração se for o caso
-    if (currentMeasurement.tipo == "tCalibrar") {
-        update.set("sensor", 1); // Começar com o sensor 1
-        update.set("progresso/completos", 0);
-        update.set("progresso/total", 9);
-        update.set("progresso/percentual", 0);
+    update.add("saida/versao", ESQUEMA_DISPOSITIVO);
+    update.add("saida/estado", "executando");
+    update.add("saida/timestampInicio", getTimestamp());
+    // Um tipo que o saco não conhece fica só em entrada/, como o app gravou
+    if (currentMeasurement.tipo != TipoMedicao::Nenhum &&
+        currentMeasurement.tipo != TipoMedicao::Desconhecido) {
+        update.add("saida/tipo", nomeTipoMedicao(currentMeasurement.tipo));
     }
+    update.add("saida/usuario", currentMeasurement.usuario);
     
-    // Inicializar campo ledIndex para precisão
-    if (currentMeasurement.tipo == "precisao") {
-        update.set("ledIndex", 0); // Será definido pela interface web
+    // Inicializar campos de calibração se for o caso. O sensor pedido pelo
+    // app (entrada/sensor) não é tocado; o ledIndex da precisão também fica
+    // só em entrada/
+    if (currentMeasurement.tipo == TipoMedicao::Calibrar) {
+        FirebaseJson progresso;
+        progresso.set("completos", 0);
+        progresso.set("total", NUM_SENSORES);
+        progresso.set("percentual", 0);
+        update.add("saida/sensor", 1); // Começar com o sensor 1
+        update.add("saida/progresso", progresso);
     }
     
-    return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+    TravaFirebase trava(mutexFirebase);
+    return atualizarSaida(update, "executando");
 }
 
 bool ConexaoManager::setMeasurementResult(float value) {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes";
+  String path = "/devices/" + deviceId + "/saida";
   FirebaseJson update;
   update.set("valor", value);
   update.set("timestampConclusao", getTimestamp());
   
+  TravaFirebase trava(mutexFirebase);
+  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+}
+
+bool ConexaoManager::setMeasurementResult(float value, const MetricasGolpe& metricas, TipoGolpe tipo) {
+  RASTREIO_TRECHO("conexao.setMeasurementResult");
+  if (!isConnected()) return false;
+  
+  String path = "/devices/" + deviceId + "/saida";
+  FirebaseJson update;
+  update.set("valor", value);
+  update.set("timestampConclusao", getTimestamp());
+  if (metricas.valido) {
+    update.set("metricas/picoG", metricas.picoG);
+    update.set("metricas/impulsoGs", metricas.impulsoGs);
+    update.set("metricas/subidaMs", metricas.subidaMs);
+    update.set("metricas/jerkGs", metricas.jerkGs);
+    update.set("metricas/direcao/x", metricas.direcaoX);
+    update.set("metricas/direcao/y", metricas.direcaoY);
+    update.set("metricas/direcao/z", metricas.direcaoZ);
+    update.set("metricas/azimuteGraus", metricas.azimuteGraus);
+    update.set("metricas/eixo", String(metricas.eixo));
+    update.set("metricas/giroDps", metricas.giroDps);
+#if PUBLICAR_TIPO_GOLPE
+    if (tipo != TipoGolpe::Desconhecido) {
+      update.set("metricas/tipo", String(nomeTipoGolpe(tipo)));
+    }
+#else
+    (void)tipo;
+#endif
+    if (metricas.fatorNewtons > 0) {
+      update.set("metricas/forcaN", metricas.forcaN);
+      update.set("metricas/impulsoNs", metricas.impulsoNs);
+    }
+  }
+  
+  TravaFirebase trava(mutexFirebase);
+  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+}
+
+bool ConexaoManager::setReactionResult(float inicioS, float cruzamentoS, int pad) {
+  RASTREIO_TRECHO("conexao.setReactionResult");
+  if (!isConnected()) return false;
+  
+  // valor continua sendo o tempo de reação (agora até o início do toque)
+  String path = "/devices/" + deviceId + "/saida";
+  FirebaseJson update;
+  update.set("valor", inicioS);
+  update.set("timestampConclusao", getTimestamp());
+  update.set("toque/inicioS", inicioS);
+  update.set("toque/cruzamentoS", cruzamentoS);
+  update.set("toque/pad", pad);
+  
+  TravaFirebase trava(mutexFirebase);
+  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+}
+
+bool ConexaoManager::sendRoundResult(const RegistroRound& resultado) {
+  if (!isConnected()) return false;
+  
+  // Totais do round e os baldes de 1 s em vetores paralelos
+  FirebaseJsonArray pads, golpes, mediaG, picoG;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    pads.add((int)resultado.getGolpesPad(i));
+  }
+  for (uint16_t s = 0; s < resultado.getSegundos(); s++) {
+    const BaldeRound& balde = resultado.balde(s);
+    golpes.add((int)balde.golpes);
+    mediaG.add(balde.golpes ? balde.somaG / balde.golpes : 0.0f);
+    picoG.add(balde.picoG);
+  }
+  
+  FirebaseJson registro;
+  registro.set("inicio", resultado.getInicioEpoch());
+  registro.set("duracaoS", (int)resultado.getSegundos());
+  registro.set("golpes", (int)resultado.getGolpes());
+  registro.set("mediaG", resultado.getMediaG());
+  registro.set("picoG", resultado.getPicoG());
+  registro.set("pads", pads);
+#if PUBLICAR_TIPO_GOLPE
+  for (int t = 0; t < NUM_TIPOS_GOLPE; t++) {
+    registro.set(String("tipos/") + nomeTipoGolpe((TipoGolpe)t),
+                 (int)resultado.getGolpesTipo((TipoGolpe)t));
+  }
+#endif
+  registro.set("segundos/golpes", golpes);
+  registro.set("segundos/mediaG", mediaG);
+  registro.set("segundos/picoG", picoG);
+  
+  String path = "/devices/" + deviceId + "/saida/rounds";
+  FirebaseJson update;
+  update.set(String(resultado.getNumero()), registro);
+  
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
 }
 
+bool ConexaoManager::sendCircuitResult(const RodadaCircuito& rodada) {
+  if (!isConnected()) return false;
+  
+  // Um registro por saco, pela MAC; o primeiro é este (o coordenador)
+  FirebaseJson registro;
+  registro.set("sacos", (int)rodada.numSacos);
+  for (uint8_t i = 0; i < rodada.numSacos; i++) {
+    const ResultadoSacoCircuito& saco = rodada.sacos[i];
+    char mac[13];
+    snprintf(mac, sizeof(mac), "%02X%02X%02X%02X%02X%02X", saco.mac[0], saco.mac[1], saco.mac[2],
+             saco.mac[3], saco.mac[4], saco.mac[5]);
+    String chave = String("resultados/") + mac + "/";
+    registro.set(chave + "ordem", (int)i);
+    registro.set(chave + "pad", (int)saco.pad);
+    registro.set(chave + "respondeu", saco.respondeu);
+    if (!saco.respondeu) {
+      continue;
+    }
+    registro.set(chave + "padTocado", (int)saco.padTocado);
+    if (saco.reacaoUs != CIRCUITO_SEM_TOQUE) {
+      registro.set(chave + "reacaoMs", saco.reacaoUs / 1000.0f);
+    }
+    registro.set(chave + "atrasoDisparoUs", (int)saco.atrasoDisparoUs);
+    registro.set(chave + "incertezaUs", (int)saco.incertezaUs);
+  }
+  
+  String path = "/devices/" + deviceId + "/saida/circuito";
+  FirebaseJson update;
+  update.set(String(rodada.numero), registro);
+  
+  TravaFirebase trava(mutexFirebase);
+  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+}
+
+bool ConexaoManager::updateUserSummary(const String& usuario, const String& modo, float valor,
+                                       bool maiorMelhor) {
+  RASTREIO_TRECHO("conexao.updateUserSummary");
+  if (!isConnected() || usuario.length() == 0) return false;
+  
+  String path = "/users/" + usuario + "/resumo/" + modo;
+  ResumoEstatistico resumo(maiorMelhor);
+  TravaFirebase trava(mutexFirebase);
+  if (Firebase.RTDB.getJSON(&fbdo, path.c_str())) {
+    FirebaseJson* json = fbdo.jsonObjectPtr();
+    FirebaseJsonData contagem, media, m2, melhor, proximo;
+    if (json != nullptr && json->get(contagem, "contagem") && json->get(media, "media") &&
+        json->get(m2, "m2") && json->get(melhor, "melhor") && json->get(proximo, "proximo")) {
+      resumo.restaurar(contagem.intValue, media.floatValue, m2.floatValue, melhor.floatValue,
+                       proximo.intValue);
+    }
+  } else if (fbdo.errorReason() != "path not exist") {
+    // Sem ler o resumo, gravar um novo apagaria o histórico acumulado
+    LOG_ERRO(Conexao, "Erro ao ler o resumo de %s: %s", modo, fbdo.errorReason());
+    return false;
+  }
+  
+  uint8_t posicao = resumo.adicionar(valor);
+  FirebaseJson update;
+  update.set("contagem", (int)resumo.getContagem());
+  update.set("media", resumo.getMedia());
+  update.set("m2", resumo.getM2());
+  update.set("desvio", resumo.getDesvio());
+  update.set("melhor", resumo.getMelhor());
+  update.set("proximo", (int)resumo.getProximo());
+  update.set("atualizado", getTimestamp());
+  if (!Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update)) {
+    return false;
+  }
+  // Só a posição nova do anel: um "ultimos/<i>" no update trocaria o nó inteiro
+  return Firebase.RTDB.setFloat(&fbdo, (path + "/ultimos/" + String(posicao)).c_str(), valor);
+}
+
+float ConexaoManager::getForceScale() {
+  if (!isConnected()) return FATOR_NEWTONS_PADRAO;
+  
+  String path = "/devices/" + deviceId + "/config/fatorNewtons";
+  TravaFirebase trava(mutexFirebase);
+  if (Firebase.RTDB.getFloat(&fbdo, path.c_str())) {
+    float fator = fbdo.floatData();
+    if (fator > 0) {
+      return fator;
+    }
+  }
+  return FATOR_NEWTONS_PADRAO;
+}
+
 bool ConexaoManager::setCurrentLed(int ledIndex) {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes/ledAtual";
+  String path = "/devices/" + deviceId + "/saida/ledAtual";
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setInt(&fbdo, path.c_str(), ledIndex);
 }
 
@@ -258,20 +512,22 @@ bool ConexaoManager::setCurrentLed(int ledIndex) {
 /**
  * @brief Envia resultado completo do teste de precisão
  * @param acerto true se foi acerto, false se erro
- * @param tempoResposta Tempo de resposta em milissegundos
+ * @param tempoResposta Tempo de resposta em milissegundos, até o início do toque
  * @param sensorTocado Sensor que foi tocado (0-8)
- * @param ledSorteado LED que estava aceso (1-9)
+ * @param ledSorteado LED que estava aceso (1 a NUM_SENSORES)
+ * @param tempoCruzamento Tempo até o sinal passar do limite, em ms (0: não enviar)
  * @return true se enviado com sucesso, false caso contrário
  */
-bool ConexaoManager::sendPrecisionResult(bool acerto, unsigned long tempoResposta, int sensorTocado, int ledSorteado) {
+bool ConexaoManager::sendPrecisionResult(bool acerto, unsigned long tempoResposta, int sensorTocado, int ledSorteado,
+                                         unsigned long tempoCruzamento) {
+    RASTREIO_TRECHO("conexao.sendPrecisionResult");
     if (!isConnected()) return false;
     
-    String path = "/devices/" + deviceId + "/medicoes";
     FirebaseJson update;
     
     // Atualizar estado para concluído
-    update.set("estado", "concluida");
-    update.set("timestampConclusao", getTimestamp());
+    update.add("saida/estado", "concluida");
+    update.add("saida/timestampConclusao", getTimestamp());
     
     // Adicionar resultado completo
     FirebaseJson resultado;
@@ -279,26 +535,80 @@ bool ConexaoManager::sendPrecisionResult(bool acerto, unsigned long tempoRespost
     resultado.set("tempoResposta", tempoResposta);
     resultado.set("sensorTocado", sensorTocado);
     resultado.set("ledSorteado", ledSorteado);
+    if (tempoCruzamento > 0) {
+        resultado.set("tempoCruzamento", tempoCruzamento);
+    }
     
-    update.set("resultado", resultado);
+    update.add("saida/resultado", resultado);
     
-    return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+    TravaFirebase trava(mutexFirebase);
+    return atualizarSaida(update, "concluida");
+}
+
+bool ConexaoManager::sendBootReport() {
+  if (!isConnected()) return false;
+  
+  FirebaseJson relatorio;
+  relatorio.set("antesDoSetupMs", (int)boot.getAntesDoSetupMs());
+  relatorio.set("localMs", (int)boot.getLocalProntoMs());
+  relatorio.set("redeMs", (int)boot.getRedeProntaMs());
+  relatorio.set("versao", String(esp_ota_get_app_description()->version));
+  for (int i = 0; i < NUM_FASES_BOOT; i++) {
+    RegistroFase registro = boot.fase((FaseBoot)i);
+    String fase = String("fases/") + nomeFaseBoot((FaseBoot)i);
+    relatorio.set(fase + "/inicioMs", (int)(registro.inicioUs / 1000));
+    relatorio.set(fase + "/duracaoMs", (int)(registro.duracaoUs / 1000));
+    relatorio.set(fase + "/ok", registro.estado == EstadoFase::Concluida);
+    relatorio.set(fase + "/tentativas", (int)registro.tentativas);
+  }
+  
+  String path = "/devices/" + deviceId + "/boot";
+  TravaFirebase trava(mutexFirebase);
+  return Firebase.RTDB.setJSON(&fbdo, path.c_str(), &relatorio);
+}
+
+String ConexaoManager::getOtaUrl() {
+  if (!isConnected()) return "";
+  
+  TravaFirebase trava(mutexFirebase);
+  if (Firebase.RTDB.getString(&fbdo, "/ota/url")) {
+    return fbdo.stringData();
+  }
+  return "";
+}
+
+bool ConexaoManager::updateOtaStatus(const String& estado, const String& versao, int progresso,
+                                     const String& erro) {
+  if (!isConnected()) return false;
+  
+  FirebaseJson json;
+  json.set("estado", estado);
+  json.set("versao", versao);
+  json.set("progresso", progresso);
+  json.set("erro", erro);
+  json.set("timestamp", getTimestamp());
+  
+  String path = "/devices/" + deviceId + "/ota";
+  TravaFirebase trava(mutexFirebase);
+  return Firebase.RTDB.setJSON(&fbdo, path.c_str(), &json);
 }
 
 bool ConexaoManager::updatePrecisionStatus(const String& status) {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes/estadoPrecisao";
+  String path = "/devices/" + deviceId + "/saida/estadoPrecisao";
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setString(&fbdo, path.c_str(), status);
 }
 
 bool ConexaoManager::clearPrecisionData() {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes/ledAtual";
+  String path = "/devices/" + deviceId + "/saida/ledAtual";
+  TravaFirebase trava(mutexFirebase);
   Firebase.RTDB.deleteNode(&fbdo, path.c_str());
   
-  path = "/devices/" + deviceId + "/medicoes/ultimoResultado";
+  path = "/devices/" + deviceId + "/saida/ultimoResultado";
   Firebase.RTDB.deleteNode(&fbdo, path.c_str());
   
   return true;
@@ -334,30 +644,53 @@ String ConexaoManager::generateDeviceId() {
 
 // Métodos auxiliares privados
 bool ConexaoManager::sendToFirebase(const String& path, const String& value) {
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setString(&fbdo, path.c_str(), value);
 }
 
 bool ConexaoManager::sendToFirebase(const String& path, int value) {
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setInt(&fbdo, path.c_str(), value);
 }
 
 bool ConexaoManager::sendToFirebase(const String& path, float value) {
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setFloat(&fbdo, path.c_str(), value);
 }
 
 bool ConexaoManager::sendToFirebase(const String& path, bool value) {
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setBool(&fbdo, path.c_str(), value);
 }
 
 bool ConexaoManager::sendToFirebase(const String& path, FirebaseJson& json) {
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setJSON(&fbdo, path.c_str(), &json);
 }
+
+bool ConexaoManager::marcarEntrada(const String& estado) {
+  // O estado também vai para entrada/: é o que tira o comando de
+  // "solicitada" e o que o app consulta antes de pedir outro
+  String path = "/devices/" + deviceId + "/entrada/estado";
+  return Firebase.RTDB.setString(&fbdo, path.c_str(), estado);
+}
+
+bool ConexaoManager::atualizarSaida(FirebaseJson& update, const String& estado) {
+  // Um updateNode em /devices/<id> com as chaves "saida/..." e
+  // "entrada/estado": o app nunca vê saida/ concluída com a entrada/ ainda
+  // em "solicitada", e é uma requisição em vez de duas
+  update.add("entrada/estado", estado);
+  String path = "/devices/" + deviceId;
+  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+}
 String ConexaoManager::getDeviceState() {
+  RASTREIO_TRECHO("conexao.getDeviceState");
   if (!isConnected()) {
     return "desconectado";
   }
   
   String path = "/devices/" + deviceId + "/estado";
+  TravaFirebase trava(mutexFirebase);
   if (Firebase.RTDB.getString(&fbdo, path.c_str())) {
     return fbdo.stringData();
   }
@@ -367,36 +700,40 @@ String ConexaoManager::getDeviceState() {
 bool ConexaoManager::setMeasurementLed(int ledIndex) {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes";
+  // O LED que o saco acendeu; o pedido do app é o entrada/ledIndex
   FirebaseJson update;
-  update.set("ledIndex", ledIndex);
-  update.set("estado", "executando");
-  update.set("timestampInicio", getTimestamp());
+  update.add("saida/ledIndex", ledIndex);
+  update.add("saida/estado", "executando");
+  update.add("saida/timestampInicio", getTimestamp());
   
-  return Firebase.RTDB.updateNode(&fbdo, path.c_str(), &update);
+  TravaFirebase trava(mutexFirebase);
+  return atualizarSaida(update, "executando");
 }
 
 int ConexaoManager::getSensorCalibracao() {
-    String path = "/devices/" + deviceId + "/medicoes/sensor";
+    RASTREIO_TRECHO("conexao.getSensorCalibracao");
+    String path = "/devices/" + deviceId + "/entrada/sensor";
     int sensorAtual = -1;
 
+    TravaFirebase trava(mutexFirebase);
     if (Firebase.RTDB.getInt(&fbdo, path.c_str())) {
         sensorAtual = fbdo.intData();
-        Serial.printf("Sensor para calibrar: %d\n", sensorAtual);
+        LOG_DEPURACAO(Conexao, "Sensor para calibrar: %d", sensorAtual);
     } else {
-        Serial.printf("Erro ao acessar Firebase: %s\n", fbdo.errorReason().c_str());
+        LOG_ERRO(Conexao, "Erro ao acessar Firebase: %s", fbdo.errorReason());
         // Verificar se o nó existe
         if (fbdo.errorReason() == "path not exist") {
-            Serial.println("Criando estrutura de calibração...");
+            LOG_INFO(Conexao, "Criando estrutura de calibração...");
             // Criar a estrutura inicial se não existir
-            FirebaseJson medicoesJson;
-            medicoesJson.set("tipo", "tCalibrar");
-            medicoesJson.set("estado", "solicitada");
-            medicoesJson.set("usuario", "");
-            medicoesJson.set("sensor", 0);
-            medicoesJson.set("timestamp", getTimestamp());
+            FirebaseJson entradaJson;
+            entradaJson.set("versao", ESQUEMA_DISPOSITIVO);
+            entradaJson.set("tipo", "tCalibrar");
+            entradaJson.set("estado", "solicitada");
+            entradaJson.set("usuario", "");
+            entradaJson.set("sensor", 0);
+            entradaJson.set("timestamp", getTimestamp());
             
-            Firebase.RTDB.setJSON(&fbdo, ("/devices/" + deviceId + "/medicoes").c_str(), &medicoesJson);
+            Firebase.RTDB.setJSON(&fbdo, ("/devices/" + deviceId + "/entrada").c_str(), &entradaJson);
         }
     }
     return sensorAtual;
@@ -405,23 +742,27 @@ int ConexaoManager::getSensorCalibracao() {
 bool ConexaoManager::setSensorCalibracao(int sensor) {
     if (!isConnected()) return false;
     
-    String path = "/devices/" + deviceId + "/medicoes/sensor";
+    String path = "/devices/" + deviceId + "/entrada/sensor";
+    TravaFirebase trava(mutexFirebase);
     return Firebase.RTDB.setInt(&fbdo, path.c_str(), sensor);
 }
 
 /**
  * @brief Obtém o LED atual para teste de precisão
- * @return Número do LED (1-9) ou -1 se não houver comando
+ * @return Número do LED (1 a NUM_SENSORES) ou -1 se não houver comando
  */
 int ConexaoManager::getLedPrecisao() {
-    String path = "/devices/" + deviceId + "/medicoes/ledIndex";
+    RASTREIO_TRECHO("conexao.getLedPrecisao");
+    if (!isConnected()) return -1;
+    String path = "/devices/" + deviceId + "/entrada/ledIndex";
     int ledAtual = -1;
 
+    TravaFirebase trava(mutexFirebase);
     if (Firebase.RTDB.getInt(&fbdo, path.c_str())) {
         ledAtual = fbdo.intData();
-        Serial.printf("LED para precisão: %d\n", ledAtual);
+        LOG_DEPURACAO(Conexao, "LED para precisão: %d", ledAtual);
     } else {
-        Serial.printf("Erro ao acessar LED: %s\n", fbdo.errorReason().c_str());
+        LOG_ERRO(Conexao, "Erro ao acessar LED: %s", fbdo.errorReason());
     }
     return ledAtual;
 }
@@ -429,6 +770,7 @@ int ConexaoManager::getLedPrecisao() {
 bool ConexaoManager::sendForceUpdate(float forca) {
   if (!isConnected()) return false;
   
-  String path = "/devices/" + deviceId + "/medicoes/forca";
+  String path = "/devices/" + deviceId + "/saida/forca";
+  TravaFirebase trava(mutexFirebase);
   return Firebase.RTDB.setFloat(&fbdo, path.c_str(), forca);
 }
\ No newline at end of file
@@ -15,18 +15,28 @@
 #include <WiFiUdp.h>
 #include <NTPClient.h>
 #include <Firebase_ESP_Client.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include "config.h"
+#include "Boot.h"
+#include "Metricas.h"
+#include "Classificador.h"
+#include "Medicao.h"
 
-// Estrutura para medições
-struct Medicao {
-  String tipo;
-  String estado;
-  float valor;
-  String usuario;
-  unsigned long timestampSolicitacao;
-  unsigned long timestampConclusao;
-};
+// 1: recebe as mudanças de /devices/<id> por stream (SSE) em vez de ler o
+// estado e os comandos a cada ciclo da tarefa de comunicação
+#ifndef USAR_STREAM_COMANDOS
+#define USAR_STREAM_COMANDOS 0
+#endif
+
+// Layout de /devices/<id>, gravado em "esquema" no registro. 1: comando e
+// resultados juntos em medicoes/. 2: o app pede em entrada/ (só o comando,
+// que o saco lê) e o saco responde em saida/ (que ele só escreve)
+#define ESQUEMA_DISPOSITIVO 2
+
+class RegistroRound;
+struct RodadaCircuito;
 
 // Estrutura para resultados de precisão
 struct ResultadoPrecisao {
@@ -45,15 +55,30 @@ public:
   unsigned long getTimestamp();
   String getTimeString();  // Nova função para obter data e hora formatada
   bool checkForCommands();
+  bool beginCommandStream();
+  bool hasRemoteChanges();  // Sem stream é sempre true (o laço faz polling)
   bool checkForStopCommand();
   bool updateDeviceStatus(const String& status);
   bool updateDevicemMdicoes(const String status);
   bool updateDeviceEx();
   bool setMeasurementResult(float value);
+  bool setMeasurementResult(float value, const MetricasGolpe& metricas,
+                            TipoGolpe tipo = TipoGolpe::Desconhecido);  // valor + metricas/
+  bool setReactionResult(float inicioS, float cruzamentoS, int pad);  // valor + toque/
+  bool sendRoundResult(const RegistroRound& resultado);  // saida/rounds/<n>, um registro por round
+  bool sendCircuitResult(const RodadaCircuito& rodada);  // saida/circuito/<n>, um registro por rodada
+  bool updateUserSummary(const String& usuario, const String& modo, float valor,
+                         bool maiorMelhor);  // /users/<uid>/resumo/<modo> (Estatisticas.h)
+  float getForceScale();  // /devices/<id>/config/fatorNewtons (N por g); 0 se não houver
   bool setCurrentLed(int ledIndex);
-  bool sendPrecisionResult(bool acerto, unsigned long tempoResposta, int sensorTocado, int ledAlvo);
+  bool sendPrecisionResult(bool acerto, unsigned long tempoResposta, int sensorTocado, int ledAlvo,
+                           unsigned long tempoCruzamento = 0);
   bool sendPrecisionFinalResult(int totalAcertos, int totalErros);
   bool updatePrecisionStatus(const String& status);
+  bool sendBootReport();  // /devices/<id>/boot, com as fases de Boot.h e a versão
+  String getOtaUrl();     // /ota/url, da frota toda; vazio sem atualização publicada
+  bool updateOtaStatus(const String& estado, const String& versao, int progresso,
+                       const String& erro);  // /devices/<id>/ota (Ota.h)
   bool clearPrecisionData();
   bool sendCalibrationProgress(int progresso, int total);
   bool sendSensorCalibrated(int sensorIndex);
@@ -63,6 +88,7 @@ public:
   bool setSensorCalibracao(int sensor);
   int getLedPrecisao();
   FirebaseData fbdo;
+  FirebaseData streamData;  // Conexão própria do stream, como pede a biblioteca
   FirebaseAuth auth;
   FirebaseConfig config;
   Medicao currentMeasurement;
@@ -74,11 +100,16 @@ public:
   
 private:
   WiFiManager wifiManager;
+  SemaphoreHandle_t mutexFirebase;  // Posse do fbdo (o streamData é só da tarefa de comunicação)
+  bool streamAtivo;
   WiFiUDP ntpUDP;
   
-  void setupWiFi();
-  void setupTime();
-  void setupFirebase();
+  bool setupWiFi();
+  bool setupTime();
+  bool setupFirebase();
+  bool marcarEntrada(const String& estado);  // entrada/estado, com o mutexFirebase já tomado
+  // saida/ (chaves "saida/...") e entrada/estado numa escrita só
+  bool atualizarSaida(FirebaseJson& update, const String& estado);
   bool sendToFirebase(const String& path, const String& value);
   bool sendToFirebase(const String& path, int value);
   bool sendToFirebase(const String& path, float value);
@@ -0,0 +1,241 @@
+/**
+ * @file Delta.cpp
+ * @brief Aplicação do delta em fluxo e CRC-32
+ */
+#include "Delta.h"
+#include <string.h>
+
+const char* nomeErroDelta(ErroDelta erro) {
+  switch (erro) {
+    case ErroDelta::Nenhum: return "nenhum";
+    case ErroDelta::Formato: return "formato";
+    case ErroDelta::Base: return "base";
+    case ErroDelta::Leitura: return "leitura";
+    case ErroDelta::Escrita: return "escrita";
+    case ErroDelta::Tamanho: return "tamanho";
+    case ErroDelta::Crc: return "crc";
+  }
+  return "?";
+}
+
+// CRC-32 (IEEE, o mesmo do zlib), meio byte por vez: 64 bytes de tabela
+uint32_t crc32Delta(uint32_t crc, const uint8_t* dados, size_t tamanho) {
+  static const uint32_t tabela[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+    0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+  crc = ~crc;
+  for (size_t i = 0; i < tamanho; i++) {
+    crc ^= dados[i];
+    crc = (crc >> 4) ^ tabela[crc & 0x0F];
+    crc = (crc >> 4) ^ tabela[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+void AplicadorDelta::reiniciar() {
+  etapa = Etapa::Cabecalho;
+  erro = ErroDelta::Nenhum;
+  memset(&cabecalho, 0, sizeof(cabecalho));
+  lidosCabecalho = 0;
+  op = OpDelta::Fim;
+  argumento = 0;
+  numeros[0] = numeros[1] = 0;
+  deslocamentoBits = 0;
+  restanteLiteral = 0;
+  proximaBase = 0;
+  gerados = 0;
+  crc = 0;
+  usadosSaida = 0;
+}
+
+bool AplicadorDelta::alimentar(ParticoesDelta& particoes, const uint8_t* dados, size_t tamanho) {
+  size_t i = 0;
+  while (i < tamanho) {
+    switch (etapa) {
+      case Etapa::Cabecalho:
+        ((uint8_t*)&cabecalho)[lidosCabecalho++] = dados[i++];
+        if (lidosCabecalho == sizeof(cabecalho)) {
+          if (cabecalho.magico != DELTA_MAGICO) {
+            return falhar(ErroDelta::Formato);
+          }
+          if (!conferirBase(particoes)) {
+            return false;
+          }
+          etapa = Etapa::Operacao;
+        }
+        break;
+
+      case Etapa::Operacao: {
+        uint8_t codigo = dados[i++];
+        if (codigo > (uint8_t)OpDelta::Literal) {
+          return falhar(ErroDelta::Formato);
+        }
+        op = (OpDelta)codigo;
+        if (op == OpDelta::Fim) {
+          return concluir(particoes);
+        }
+        argumento = 0;
+        numeros[0] = numeros[1] = 0;
+        deslocamentoBits = 0;
+        etapa = Etapa::Argumento;
+        break;
+      }
+
+      case Etapa::Argumento: {
+        // Números em varint (7 bits por byte, o menos significativo primeiro)
+        uint8_t byte = dados[i++];
+        if (deslocamentoBits > 28) {
+          return falhar(ErroDelta::Formato);
+        }
+        numeros[argumento] |= (uint32_t)(byte & 0x7F) << deslocamentoBits;
+        deslocamentoBits += 7;
+        if (byte & 0x80) {
+          break;
+        }
+        deslocamentoBits = 0;
+        argumento++;
+        if (op == OpDelta::Literal) {
+          restanteLiteral = numeros[0];
+          etapa = restanteLiteral > 0 ? Etapa::Literal : Etapa::Operacao;
+        } else if (argumento == 2) {
+          if (!executar(particoes)) {
+            return false;
+          }
+          etapa = Etapa::Operacao;
+        }
+        break;
+      }
+
+      case Etapa::Literal: {
+        size_t n = tamanho - i;
+        if (n > restanteLiteral) {
+          n = restanteLiteral;
+        }
+        for (size_t k = 0; k < n; k++) {
+          if (!emitir(particoes, dados[i + k])) {
+            return false;
+          }
+        }
+        i += n;
+        restanteLiteral -= n;
+        if (restanteLiteral == 0) {
+          etapa = Etapa::Operacao;
+        }
+        break;
+      }
+
+      case Etapa::Concluido:
+        return true;
+
+      case Etapa::Erro:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool AplicadorDelta::falhar(ErroDelta motivo) {
+  erro = motivo;
+  etapa = Etapa::Erro;
+  return false;
+}
+
+bool AplicadorDelta::conferirBase(ParticoesDelta& particoes) {
+  uint8_t bloco[DELTA_BLOCO];
+  uint32_t crcBase = 0;
+  for (uint32_t posicao = 0; posicao < cabecalho.tamanhoBase; posicao += sizeof(bloco)) {
+    size_t n = cabecalho.tamanhoBase - posicao;
+    if (n > sizeof(bloco)) {
+      n = sizeof(bloco);
+    }
+    if (!particoes.lerBase(posicao, bloco, n)) {
+      return falhar(ErroDelta::Leitura);
+    }
+    crcBase = crc32Delta(crcBase, bloco, n);
+  }
+  return crcBase == cabecalho.crcBase ? true : falhar(ErroDelta::Base);
+}
+
+bool AplicadorDelta::executar(ParticoesDelta& particoes) {
+  uint32_t quantidade = numeros[1];
+  if (quantidade > cabecalho.tamanhoAlvo - gerados) {
+    return falhar(ErroDelta::Tamanho);
+  }
+
+  if (op == OpDelta::CopiaJanela) {
+    uint32_t distancia = numeros[0];
+    if (distancia == 0 || distancia > DELTA_JANELA || distancia > gerados) {
+      return falhar(ErroDelta::Formato);
+    }
+    // Byte a byte: com distância menor que o tamanho a cópia se sobrepõe
+    // e repete o trecho (as sequências de 0xFF do preenchimento)
+    for (uint32_t k = 0; k < quantidade; k++) {
+      if (!emitir(particoes, janela[(gerados - distancia) & (DELTA_JANELA - 1)])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // CopiaBase: zigzag devolve o sinal do deslocamento relativo
+  int32_t relativo = (int32_t)(numeros[0] >> 1) ^ -(int32_t)(numeros[0] & 1);
+  uint32_t posicao = proximaBase + relativo;
+  if (posicao > cabecalho.tamanhoBase || quantidade > cabecalho.tamanhoBase - posicao) {
+    return falhar(ErroDelta::Formato);
+  }
+  uint8_t bloco[DELTA_BLOCO];
+  for (uint32_t feitos = 0; feitos < quantidade;) {
+    size_t n = quantidade - feitos;
+    if (n > sizeof(bloco)) {
+      n = sizeof(bloco);
+    }
+    if (!particoes.lerBase(posicao + feitos, bloco, n)) {
+      return falhar(ErroDelta::Leitura);
+    }
+    for (size_t k = 0; k < n; k++) {
+      if (!emitir(particoes, bloco[k])) {
+        return false;
+      }
+    }
+    feitos += n;
+  }
+  proximaBase = posicao + quantidade;
+  return true;
+}
+
+bool AplicadorDelta::emitir(ParticoesDelta& particoes, uint8_t byte) {
+  if (gerados >= cabecalho.tamanhoAlvo) {
+    return falhar(ErroDelta::Tamanho);
+  }
+  janela[gerados & (DELTA_JANELA - 1)] = byte;
+  gerados++;
+  saida[usadosSaida++] = byte;
+  return usadosSaida < sizeof(saida) || descarregar(particoes);
+}
+
+bool AplicadorDelta::descarregar(ParticoesDelta& particoes) {
+  if (usadosSaida == 0) {
+    return true;
+  }
+  crc = crc32Delta(crc, saida, usadosSaida);
+  if (!particoes.escrever(saida, usadosSaida)) {
+    return falhar(ErroDelta::Escrita);
+  }
+  usadosSaida = 0;
+  return true;
+}
+
+bool AplicadorDelta::concluir(ParticoesDelta& particoes) {
+  if (!descarregar(particoes)) {
+    return false;
+  }
+  if (gerados != cabecalho.tamanhoAlvo) {
+    return falhar(ErroDelta::Tamanho);
+  }
+  if (crc != cabecalho.crcAlvo) {
+    return falhar(ErroDelta::Crc);
+  }
+  etapa = Etapa::Concluido;
+  return true;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file Delta.h
+ * @brief Imagem de firmware em delta comprimido contra a versão que roda
+ *
+ * Na academia o WiFi é fraco e uma imagem completa (~1 MB) demora a
+ * baixar. Entre duas versões próximas quase todo o código se repete,
+ * só deslocado; o delta descreve a nova imagem com:
+ *
+ * - CopiaBase: um trecho da imagem que está rodando. O deslocamento vem
+ *   relativo ao fim da cópia anterior, e na maior parte das cópias é zero
+ *   ou pequeno;
+ * - CopiaJanela: um trecho repetido dos últimos DELTA_JANELA bytes já
+ *   gerados (LZ77), que comprime o código novo e os preenchimentos;
+ * - Literal: bytes novos.
+ *
+ * Sem base (tamanhoBase 0) o mesmo formato é uma imagem completa
+ * comprimida. O cabeçalho leva tamanho e CRC-32 da base e da imagem gerada:
+ * a base é conferida antes de escrever qualquer byte, e a imagem, no fim.
+ *
+ * O AplicadorDelta recebe o delta em pedaços de qualquer tamanho (como
+ * chegam do HTTP), sem alocar: a janela e os buffers são membros. A base e
+ * o destino ficam atrás de ParticoesDelta (no saco, as partições OTA; nos
+ * testes, vetores). O gerador está no build nativo (host/ota).
+ */
+#ifndef DELTA_H
+#define DELTA_H
+
+#include <Arduino.h>
+
+#define DELTA_MAGICO 0x314C4453u  // "SDL1"
+#define DELTA_JANELA 4096         // Potência de 2
+#define DELTA_BLOCO 256           // Leitura da base e escrita do destino
+
+enum class OpDelta : uint8_t {
+  Fim,
+  CopiaBase,    // zigzag(deslocamento - fim da cópia anterior), tamanho
+  CopiaJanela,  // distância (1 a DELTA_JANELA), tamanho
+  Literal       // tamanho, bytes
+};
+
+struct __attribute__((packed)) CabecalhoDelta {
+  uint32_t magico;
+  uint32_t tamanhoBase;  // 0: imagem completa
+  uint32_t crcBase;
+  uint32_t tamanhoAlvo;
+  uint32_t crcAlvo;
+};
+
+enum class ErroDelta : uint8_t {
+  Nenhum,
+  Formato,   // Cabeçalho ou operação inválida
+  Base,      // A imagem que roda não é a base do delta
+  Leitura,
+  Escrita,
+  Tamanho,   // Mais ou menos bytes que o cabeçalho diz
+  Crc
+};
+
+const char* nomeErroDelta(ErroDelta erro);
+
+uint32_t crc32Delta(uint32_t crc, const uint8_t* dados, size_t tamanho);
+
+// Onde o aplicador lê a base e escreve a imagem nova
+class ParticoesDelta {
+public:
+  virtual ~ParticoesDelta() {}
+  virtual bool lerBase(uint32_t posicao, uint8_t* dados, size_t tamanho) = 0;
+  virtual bool escrever(const uint8_t* dados, size_t tamanho) = 0;
+};
+
+class AplicadorDelta {
+public:
+  AplicadorDelta() { reiniciar(); }
+
+  void reiniciar();
+  // false ao primeiro erro (getErro); os bytes depois do Fim são ignorados
+  bool alimentar(ParticoesDelta& particoes, const uint8_t* dados, size_t tamanho);
+
+  bool getConcluido() const { return etapa == Etapa::Concluido; }
+  ErroDelta getErro() const { return erro; }
+  const CabecalhoDelta& getCabecalho() const { return cabecalho; }
+  bool getCabecalhoLido() const { return etapa != Etapa::Cabecalho; }
+  uint32_t getGerados() const { return gerados; }
+
+private:
+  enum class Etapa : uint8_t { Cabecalho, Operacao, Argumento, Literal, Concluido, Erro };
+
+  Etapa etapa;
+  ErroDelta erro;
+  CabecalhoDelta cabecalho;
+  uint8_t lidosCabecalho;
+
+  OpDelta op;
+  uint8_t argumento;       // Qual dos dois números está sendo lido
+  uint32_t numeros[2];
+  uint8_t deslocamentoBits;
+  uint32_t restanteLiteral;
+
+  uint32_t proximaBase;    // Fim da última CopiaBase
+  uint32_t gerados;
+  uint32_t crc;
+  uint8_t janela[DELTA_JANELA];
+  uint8_t saida[DELTA_BLOCO];
+  uint16_t usadosSaida;
+
+  bool falhar(ErroDelta motivo);
+  bool conferirBase(ParticoesDelta& particoes);
+  bool executar(ParticoesDelta& particoes);
+  bool emitir(ParticoesDelta& particoes, uint8_t byte);
+  bool descarregar(ParticoesDelta& particoes);
+  bool concluir(ParticoesDelta& particoes);
+};
+
+#endif
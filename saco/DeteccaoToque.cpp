@@ -0,0 +1,193 @@
+/**
+ * @file DeteccaoToque.cpp
+ * @brief Implementação do detector de início de toque
+ */
+#include "DeteccaoToque.h"
+#include "Rastreio.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <math.h>
+
+void DetectorToque::reiniciar() {
+  cabeca = 0;
+  quantidade = 0;
+  iniciado = false;
+  base = 0;
+  desvio = TOQUE_RUIDO_MIN;
+  armada = false;
+  armadaUs = 0;
+  tocandoAgora = false;
+  inicioUs = 0;
+  cruzamentoUs = 0;
+}
+
+uint16_t DetectorToque::valor(uint8_t atras) const {
+  return valores[(cabeca + TOQUE_HISTORICO - 1 - atras) & (TOQUE_HISTORICO - 1)];
+}
+
+uint32_t DetectorToque::tempo(uint8_t atras) const {
+  return tempos[(cabeca + TOQUE_HISTORICO - 1 - atras) & (TOQUE_HISTORICO - 1)];
+}
+
+float DetectorToque::filtroCasado() const {
+  if (quantidade < 2 * TOQUE_JANELA_FILTRO) {
+    return 0;
+  }
+  float depois = 0;
+  float antes = 0;
+  for (uint8_t i = 0; i < TOQUE_JANELA_FILTRO; i++) {
+    depois += valor(i);
+    antes += valor(i + TOQUE_JANELA_FILTRO);
+  }
+  // Diferença de duas médias de K amostras: desvio padrão σ·√(2/K)
+  float diferenca = (depois - antes) / TOQUE_JANELA_FILTRO;
+  return diferenca / (desvio * sqrtf(2.0f / TOQUE_JANELA_FILTRO));
+}
+
+uint32_t DetectorToque::estimarInicio() const {
+  float repouso = base + TOQUE_NIVEL_REPOUSO * desvio;
+
+  // Última amostra ainda em repouso
+  uint8_t i = 0;
+  while (i + 1 < quantidade && valor(i) > repouso) {
+    i++;
+  }
+  if (i == 0 || valor(i) > repouso) {
+    return tempo(i);  // A borda começou antes do histórico
+  }
+
+  // Inclinação da subida entre as duas primeiras amostras da borda; com a
+  // borda de uma amostra só (ou sem subir), desde o repouso
+  uint8_t primeira = i - 1;
+  float inclinacao = 0;
+  if (primeira > 0) {
+    inclinacao = ((float)valor(primeira - 1) - valor(primeira)) /
+                 (float)(tempo(primeira - 1) - tempo(primeira));
+  }
+  if (inclinacao <= 0) {
+    inclinacao = ((float)valor(primeira) - valor(i)) / (float)(tempo(primeira) - tempo(i));
+  }
+  if (inclinacao <= 0) {
+    return tempo(primeira);
+  }
+
+  // Extrapola até a base, sem passar da última amostra em repouso
+  float atrasUs = (valor(primeira) - base) / inclinacao;
+  uint32_t intervaloUs = tempo(primeira) - tempo(i);
+  if (atrasUs >= intervaloUs) {
+    return tempo(i);
+  }
+  return tempo(primeira) - (uint32_t)atrasUs;
+}
+
+bool DetectorToque::adicionar(uint32_t tempoUs, uint16_t leitura, int limite) {
+  valores[cabeca] = leitura;
+  tempos[cabeca] = tempoUs;
+  cabeca = (cabeca + 1) & (TOQUE_HISTORICO - 1);
+  if (quantidade < TOQUE_HISTORICO) {
+    quantidade++;
+  }
+
+  if (!iniciado) {
+    base = leitura;
+    iniciado = true;
+    tocandoAgora = leitura > limite;
+    return false;
+  }
+  float anterior = valor(1);
+
+  if (tocandoAgora) {
+    if (leitura < base + TOQUE_FRACAO_LIBERA * (limite - base)) {
+      tocandoAgora = false;
+    }
+    return false;
+  }
+
+  if (leitura > limite) {
+    tocandoAgora = true;
+    armada = false;
+    cruzamentoUs = tempoUs;
+    if (anterior < limite) {
+      float fracao = (limite - anterior) / (leitura - anterior);
+      cruzamentoUs = tempo(1) + (uint32_t)(fracao * (tempoUs - tempo(1)));
+    }
+    inicioUs = estimarInicio();
+    if ((int32_t)(cruzamentoUs - inicioUs) < 0) {
+      inicioUs = cruzamentoUs;
+    }
+    return true;
+  }
+
+  if (!armada) {
+    if (filtroCasado() > TOQUE_LIMIAR_BORDA) {
+      armada = true;
+      armadaUs = tempoUs;
+    }
+  } else if (leitura <= base + TOQUE_NIVEL_REPOUSO * desvio ||
+             tempoUs - armadaUs > TOQUE_MAX_BORDA_MS * 1000UL) {
+    armada = false;  // A luva se afastou ou o nível só mudou devagar
+  }
+
+  // Base e ruído só acompanham o repouso
+  if (!armada) {
+    // |primeira diferença| média = 2σ/√π
+    desvio += TOQUE_ALFA_RUIDO * (fabsf(leitura - anterior) * 0.886f - desvio);
+    if (desvio < TOQUE_RUIDO_MIN) {
+      desvio = TOQUE_RUIDO_MIN;
+    }
+    base += TOQUE_ALFA_BASE * (leitura - base);
+  }
+  return false;
+}
+
+// Meio período de folga: um tick a mais ainda não é prazo perdido
+DetectorToques::DetectorToques(const char* nomePrazo)
+    : prazo(nomePrazo, TOQUE_PERIODO_MS * 1000, TOQUE_PERIODO_MS * 500) {}
+
+void DetectorToques::reiniciar() {
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    pads[i].reiniciar();
+  }
+}
+
+int DetectorToques::adicionar(uint32_t tempoUs, const uint16_t valores[NUM_SENSORES],
+                              const int limites[NUM_SENSORES], EventoToque& evento) {
+  int confirmado = -1;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    if (!pads[i].adicionar(tempoUs, valores[i], limites[i])) {
+      continue;
+    }
+    // Dois pads na mesma leitura: vale a borda que começou antes
+    if (confirmado < 0 ||
+        (int32_t)(pads[i].getInicioUs() - pads[confirmado].getInicioUs()) < 0) {
+      confirmado = i;
+    }
+  }
+  if (confirmado >= 0) {
+    evento.pad = confirmado;
+    evento.inicioUs = pads[confirmado].getInicioUs();
+    evento.cruzamentoUs = pads[confirmado].getCruzamentoUs();
+  }
+  return confirmado;
+}
+
+int DetectorToques::aguardar(Sensores& sensores, uint32_t limiteMs, EventoToque& evento) {
+  uint16_t valores[NUM_SENSORES];
+  int limites[NUM_SENSORES];
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    limites[i] = sensores.getThreshold(i);
+  }
+
+  prazo.iniciar();
+  uint32_t inicio = millis();
+  do {
+    prazo.marcar();
+    sensores.lerToques(valores);
+    int pad = adicionar(micros(), valores, limites, evento);
+    if (pad >= 0) {
+      return pad;
+    }
+    vTaskDelay(TOQUE_PERIODO_MS / portTICK_PERIOD_MS);
+  } while (millis() - inicio < limiteMs);
+  return -1;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file DeteccaoToque.h
+ * @brief Início do toque pela borda do sinal, não pelo cruzamento do limiar
+ *
+ * detectarToque() só dispara quando o touchRead passa do limite calibrado;
+ * com a luva se aproximando isso acontece no meio da subida, e o quanto no
+ * meio depende do material da luva e do pad. O DetectorToque acompanha
+ * cada pad amostra a amostra e marca dois instantes:
+ *
+ * - inicio: onde a borda começa. Um filtro casado de degrau (média das
+ *   últimas TOQUE_JANELA_FILTRO amostras menos a das anteriores, em
+ *   unidades de ruído) arma a borda e congela a linha de base; na
+ *   confirmação o detector volta pelo histórico até a última amostra em
+ *   repouso e extrapola a inclinação (primeira diferença) até a base.
+ * - cruzamento: onde o sinal passa do limite, interpolado entre amostras
+ *   (o mesmo critério do detectarToque), que confirma o toque.
+ *
+ * Histerese: depois de confirmado, o pad só volta a disparar quando o
+ * sinal cai abaixo de TOQUE_FRACAO_LIBERA entre a base e o limite.
+ */
+#ifndef DETECCAO_TOQUE_H
+#define DETECCAO_TOQUE_H
+
+#include <Arduino.h>
+#include "Rastreio.h"
+#include "Sensores.h"
+
+#define TOQUE_PERIODO_MS 10         // Amostragem dos pads nos modos
+#define TOQUE_HISTORICO 16          // Amostras guardadas por pad (potência de 2)
+#define TOQUE_JANELA_FILTRO 3       // Amostras de cada lado do degrau
+#define TOQUE_LIMIAR_BORDA 4.0f     // Saída do filtro casado que arma a borda
+#define TOQUE_NIVEL_REPOUSO 3.0f    // Desvios padrão acima da base: fora do repouso
+#define TOQUE_FRACAO_LIBERA 0.5f
+#define TOQUE_MAX_BORDA_MS 500      // Borda armada sem cruzar: desiste e volta a adaptar
+#define TOQUE_ALFA_BASE 0.02f
+#define TOQUE_ALFA_RUIDO 0.05f
+#define TOQUE_RUIDO_MIN 5.0f        // Piso do desvio padrão (contagens do touchRead)
+
+struct EventoToque {
+  int8_t pad;
+  uint32_t inicioUs;      // Começo da borda
+  uint32_t cruzamentoUs;  // Passagem pelo limite (onde detectarToque dispararia)
+};
+
+class DetectorToque {
+public:
+  DetectorToque() { reiniciar(); }
+
+  void reiniciar();
+
+  // Uma leitura do pad; true quando um toque acabou de ser confirmado
+  bool adicionar(uint32_t tempoUs, uint16_t valor, int limite);
+
+  bool tocando() const { return tocandoAgora; }
+  bool bordaArmada() const { return armada; }
+  uint32_t getInicioUs() const { return inicioUs; }
+  uint32_t getCruzamentoUs() const { return cruzamentoUs; }
+  float getBase() const { return base; }
+  float getRuido() const { return desvio; }
+
+private:
+  uint16_t valores[TOQUE_HISTORICO];
+  uint32_t tempos[TOQUE_HISTORICO];
+  uint8_t cabeca;       // Próxima posição de escrita
+  uint8_t quantidade;
+
+  bool iniciado;
+  float base;
+  float desvio;         // Desvio padrão do ruído em repouso
+  bool armada;
+  uint32_t armadaUs;
+  bool tocandoAgora;
+  uint32_t inicioUs;
+  uint32_t cruzamentoUs;
+
+  uint16_t valor(uint8_t atras) const;   // 0: a mais recente
+  uint32_t tempo(uint8_t atras) const;
+  float filtroCasado() const;
+  uint32_t estimarInicio() const;
+};
+
+// Os NUM_SENSORES pads juntos, com os limites do Sensores
+class DetectorToques {
+public:
+  // O prazo da amostragem do aguardar() é do detector: cada tarefa tem o seu
+  explicit DetectorToques(const char* nomePrazo = "toque");
+
+  void reiniciar();
+
+  // Leitura de todos os pads; devolve o pad confirmado (-1: nenhum)
+  int adicionar(uint32_t tempoUs, const uint16_t valores[NUM_SENSORES],
+                const int limites[NUM_SENSORES], EventoToque& evento);
+
+  // Lê os pads a cada TOQUE_PERIODO_MS por até limiteMs
+  int aguardar(Sensores& sensores, uint32_t limiteMs, EventoToque& evento);
+
+  const DetectorToque& pad(int indice) const { return pads[indice]; }
+
+private:
+  DetectorToque pads[NUM_SENSORES];
+  PrazoRastreio prazo;
+};
+
+#endif
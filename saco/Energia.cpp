@@ -0,0 +1,114 @@
+/**
+ * @file Energia.cpp
+ * @brief Implementação do modo ocioso em light sleep
+ */
+#include "Energia.h"
+#include "Log.h"
+#include "Sensores.h"
+#include <WiFi.h>
+#include <esp_sleep.h>
+
+GerenciadorEnergia energia;
+
+const char* nomeCausaDespertar(CausaDespertar causa) {
+  switch (causa) {
+    case CausaDespertar::Toque:        return "toque";
+    case CausaDespertar::Movimento:    return "movimento";
+    case CausaDespertar::Rede:         return "rede";
+    case CausaDespertar::Temporizador: return "temporizador";
+    default:                           return "nenhuma";
+  }
+}
+
+GerenciadorEnergia::GerenciadorEnergia()
+  : ociosoMs(ENERGIA_OCIOSO_MS), ultimaAtividadeMs(0), ciclos(0), tempoDormindoUs(0),
+    despertarUs(0), latenciaUs(0), latenciaMaximaUs(0), ultimaCausa(CausaDespertar::Nenhuma) {
+  memset(despertares, 0, sizeof(despertares));
+}
+
+void GerenciadorEnergia::iniciar(uint32_t ocioso) {
+  ociosoMs = ocioso;
+  ciclos = 0;
+  memset(despertares, 0, sizeof(despertares));
+  tempoDormindoUs = 0;
+  despertarUs = 0;
+  latenciaUs = 0;
+  latenciaMaximaUs = 0;
+  ultimaCausa = CausaDespertar::Nenhuma;
+  registrarAtividade();
+}
+
+void GerenciadorEnergia::registrarAtividade() {
+  // Chamado pela tarefa de comunicação e pela de energia
+  __atomic_store_n(&ultimaAtividadeMs, (uint32_t)millis(), __ATOMIC_RELAXED);
+}
+
+bool GerenciadorEnergia::ocioso() const {
+  return millis() - __atomic_load_n(&ultimaAtividadeMs, __ATOMIC_RELAXED) >= ociosoMs;
+}
+
+CausaDespertar GerenciadorEnergia::dormir(uint32_t limiteMs) {
+  sensores.ativarDespertarMovimento(ENERGIA_LIMIAR_MOVIMENTO_MG);
+  touchSleepWakeUpEnable(sensores.getPino(ENERGIA_PAD_DESPERTAR),
+                         sensores.getThreshold(ENERGIA_PAD_DESPERTAR));
+  gpio_wakeup_enable((gpio_num_t)ENERGIA_PINO_INT_MPU, GPIO_INTR_HIGH_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  esp_sleep_enable_wifi_wakeup();
+  esp_sleep_enable_timer_wakeup((uint64_t)limiteMs * 1000);
+
+  int64_t inicio = esp_timer_get_time();
+  esp_err_t erro = esp_light_sleep_start();
+  despertarUs = esp_timer_get_time();
+  tempoDormindoUs += despertarUs - inicio;
+
+  CausaDespertar causa = CausaDespertar::Nenhuma;
+  if (erro != ESP_OK) {
+    LOG_ERRO(Energia, "Falha no light sleep: %d", erro);
+  } else {
+    switch (esp_sleep_get_wakeup_cause()) {
+      case ESP_SLEEP_WAKEUP_TOUCHPAD: causa = CausaDespertar::Toque; break;
+      case ESP_SLEEP_WAKEUP_GPIO:     causa = CausaDespertar::Movimento; break;
+      case ESP_SLEEP_WAKEUP_WIFI:     causa = CausaDespertar::Rede; break;
+      case ESP_SLEEP_WAKEUP_TIMER:    causa = CausaDespertar::Temporizador; break;
+      default:                        break;
+    }
+  }
+
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  gpio_wakeup_disable((gpio_num_t)ENERGIA_PINO_INT_MPU);
+  sensores.desativarDespertarMovimento();
+
+  ciclos++;
+  despertares[(int)causa]++;
+  ultimaCausa = causa;
+  if (causa == CausaDespertar::Toque || causa == CausaDespertar::Movimento) {
+    registrarAtividade();
+  }
+  return causa;
+}
+
+void GerenciadorEnergia::economizarRede(bool economizar) {
+  WiFi.setSleep(economizar ? WIFI_PS_MAX_MODEM : WIFI_PS_MIN_MODEM);
+}
+
+void GerenciadorEnergia::marcarPronto() {
+  // Só toque e movimento têm alguém esperando na frente do saco; depois de
+  // rede ou temporizador o "pronto" inclui a janela de leitura do comando
+  bool presencial = (ultimaCausa == CausaDespertar::Toque || ultimaCausa == CausaDespertar::Movimento);
+  if (despertarUs == 0 || !presencial) {
+    despertarUs = 0;
+    return;
+  }
+  latenciaUs = esp_timer_get_time() - despertarUs;
+  if (latenciaUs > latenciaMaximaUs) {
+    latenciaMaximaUs = latenciaUs;
+  }
+  despertarUs = 0;
+  if (latenciaUs > ENERGIA_META_DESPERTAR_US) {
+    LOG_AVISO(Energia, "Despertar lento: %u us", latenciaUs);
+  }
+}
+
+uint32_t GerenciadorEnergia::getDespertares(CausaDespertar causa) const {
+  return despertares[(int)causa];
+}
@@ -0,0 +1,93 @@
+/**
+ * @file Energia.h
+ * @brief Modo ocioso: light sleep com despertar por toque, movimento ou rede
+ *
+ * Parado no Estado::Inicial, o saco não precisa de LED piscando, relógio no
+ * display nem consulta ao Firebase a cada segundo. Depois de
+ * ENERGIA_OCIOSO_MS sem atividade a tarefa de energia:
+ *
+ * - apaga o display e o LED (Estado::Ocioso) e põe o WiFi em modem sleep
+ *   máximo (o AP mantém a associação, o rádio só acorda nos beacons);
+ * - entra em light sleep com quatro fontes de despertar: o pad do centro
+ *   (o ESP32-S3 só acorda por um canal de toque), o INT do MPU6500 em
+ *   wake-on-motion (qualquer golpe em qualquer pad move o saco), um pacote
+ *   no WiFi (evento do stream de comandos) e um temporizador de
+ *   ENERGIA_VERIFICA_REDE_MS para o polling sem stream.
+ *
+ * Toque e movimento são atividade: o saco volta ao Estado::Inicial. Rede e
+ * temporizador abrem uma janela de ENERGIA_JANELA_REDE_MS para a tarefa de
+ * comunicação ler o nó; se nenhum comando chegar, volta a dormir.
+ *
+ * O tempo do despertar por toque ou movimento até o saco estar pronto
+ * (sensores reconfigurados, WiFi e display de volta, estado liberado) é
+ * medido a cada vez; a meta é ENERGIA_META_DESPERTAR_US.
+ */
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include <Arduino.h>
+#include "Placas.h"
+
+#ifndef ENERGIA_OCIOSO_MS
+#define ENERGIA_OCIOSO_MS (5 * 60 * 1000UL)
+#endif
+#define ENERGIA_PINO_INT_MPU 16          // INT do MPU6500
+#define ENERGIA_PAD_DESPERTAR (PlacaAtual::PAD_CENTRO)
+#define ENERGIA_LIMIAR_MOVIMENTO_MG 300
+#define ENERGIA_VERIFICA_REDE_MS 5000
+#define ENERGIA_JANELA_REDE_MS 1500      // Mais que o período da tarefaComunicacao
+#define ENERGIA_META_DESPERTAR_US 100000
+
+enum class CausaDespertar : uint8_t {
+  Nenhuma,
+  Toque,
+  Movimento,
+  Rede,
+  Temporizador
+};
+
+const char* nomeCausaDespertar(CausaDespertar causa);
+
+class GerenciadorEnergia {
+public:
+  GerenciadorEnergia();
+
+  void iniciar(uint32_t ociosoMs = ENERGIA_OCIOSO_MS);
+
+  // Qualquer uso do saco (toque, comando, modo, app conectado) adia o sono
+  void registrarAtividade();
+  bool ocioso() const;
+
+  // Um ciclo de light sleep de no máximo limiteMs; devolve por que acordou
+  CausaDespertar dormir(uint32_t limiteMs = ENERGIA_VERIFICA_REDE_MS);
+
+  // Modem sleep do WiFi enquanto ocioso
+  void economizarRede(bool economizar);
+
+  // O saco está pronto depois do último despertar por toque ou movimento
+  void marcarPronto();
+
+  uint32_t getOciosoMs() const { return ociosoMs; }
+  uint32_t getCiclos() const { return ciclos; }
+  uint32_t getDespertares(CausaDespertar causa) const;
+  uint64_t getTempoDormindoUs() const { return tempoDormindoUs; }
+  uint32_t getLatenciaDespertarUs() const { return latenciaUs; }        // Último ciclo
+  uint32_t getLatenciaMaximaUs() const { return latenciaMaximaUs; }
+  CausaDespertar getUltimaCausa() const { return ultimaCausa; }
+
+private:
+  uint32_t ociosoMs;
+  uint32_t ultimaAtividadeMs;  // Atômico: escrito por mais de uma tarefa
+
+  uint32_t ciclos;
+  uint32_t despertares[5];
+  uint64_t tempoDormindoUs;
+  int64_t despertarUs;       // Quando o último light sleep terminou (0: já pronto)
+  uint32_t latenciaUs;
+  uint32_t latenciaMaximaUs;
+  CausaDespertar ultimaCausa;
+};
+
+extern GerenciadorEnergia energia;
+
+#endif
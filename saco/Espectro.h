@@ -0,0 +1,317 @@
+/**
+ * @file Espectro.h
+ * @brief Pipeline espectral da força com o backend de FFT escolhido na compilação
+ *
+ * A força de um golpe é a soma das magnitudes do espectro (bins 1 a N/2-1,
+ * janela de Hamming) da aceleração resultante nas últimas N amostras, sem a
+ * média. PipelineForca<FFT> mantém a janela deslizante; a FFT é uma
+ * política com a mesma interface:
+ *
+ * - FFTArduino:   arduinoFFT em double, a referência. O ESP32-S3 não tem FPU
+ *   de precisão dupla: cada operação é emulada em software, e a janela é
+ *   recalculada com cos() a cada chamada.
+ * - FFTEspDspF32: esp-dsp em float (rotinas otimizadas para o Xtensa).
+ * - FFTEspDspS16: esp-dsp em Q15, com a janela normalizada pela maior
+ *   amostra (borboletas inteiras; cada estágio divide por 2 e arredonda).
+ * - FFTPortavel:  float puro, com tabelas pré-calculadas e a FFT real de N
+ *   pontos feita com uma complexa de N/2. Roda em qualquer alvo.
+ *
+ * FFT_FORCA escolhe o backend do Sensores (padrão: esp-dsp float quando a
+ * biblioteca está disponível, senão o portável). A comparação de precisão e
+ * velocidade fica em "reproduzir_traco <traço> fft" e na Bancada.
+ */
+#ifndef ESPECTRO_H
+#define ESPECTRO_H
+
+#include <Arduino.h>
+#include <arduinoFFT.h>
+#include <math.h>
+
+#if __has_include(<esp_dsp.h>)
+#include <esp_dsp.h>
+#define ESPDSP_DISPONIVEL 1
+#else
+#define ESPDSP_DISPONIVEL 0
+#endif
+
+#define FFT_ARDUINOFFT 0
+#define FFT_ESPDSP_F32 1
+#define FFT_ESPDSP_S16 2
+#define FFT_PORTAVEL 3
+
+#ifndef FFT_FORCA
+#if ESPDSP_DISPONIVEL
+#define FFT_FORCA FFT_ESPDSP_F32
+#else
+#define FFT_FORCA FFT_PORTAVEL
+#endif
+#endif
+
+// Janela de Hamming com os mesmos pesos do arduinoFFT
+template <uint16_t N>
+struct JanelaHamming {
+  float peso[N];
+
+  JanelaHamming() {
+    for (uint16_t i = 0; i < N / 2; i++) {
+      float p = 0.54 - 0.46 * cos(2.0 * M_PI * i / (N - 1.0));
+      peso[i] = p;
+      peso[N - 1 - i] = p;
+    }
+  }
+};
+
+template <uint16_t N>
+class FFTArduino {
+public:
+  static const uint16_t AMOSTRAS = N;
+  static const char* nome() { return "arduinoFFT"; }
+
+  // anel: últimas N amostras, a mais antiga em anel[inicio]
+  float somaMagnitudes(const float* anel, uint16_t inicio, float media) {
+    for (uint16_t k = 0; k < N; k++) {
+      vReal[k] = anel[(inicio + k) % N] - media;
+      vImag[k] = 0;
+    }
+    // A frequência de amostragem só entra no majorPeak(), não usado aqui
+    ArduinoFFT<double> FFT(vReal, vImag, N, 1.0);
+    FFT.windowing(FFTWindow::Hamming, FFTDirection::Forward);
+    FFT.compute(FFTDirection::Forward);
+    FFT.complexToMagnitude();
+
+    float soma = 0;
+    for (uint16_t i = 1; i < N / 2; i++) {
+      soma += vReal[i];
+    }
+    return soma;
+  }
+
+private:
+  double vReal[N];
+  double vImag[N];
+};
+
+template <uint16_t N>
+class FFTPortavel {
+public:
+  static const uint16_t AMOSTRAS = N;
+  static const char* nome() { return "portavel"; }
+
+  FFTPortavel() {
+    // Twiddles da FFT complexa de N/2 e da separação do espectro real
+    for (uint16_t k = 0; k < N / 2; k++) {
+      cosseno[k] = cos(2.0 * M_PI * k / N);
+      seno[k] = -sin(2.0 * M_PI * k / N);
+    }
+    uint16_t j = 0;
+    for (uint16_t i = 0; i < N / 2; i++) {
+      reverso[i] = j;
+      uint16_t bit = N / 4;
+      while (bit && (j & bit)) {
+        j ^= bit;
+        bit >>= 1;
+      }
+      j |= bit;
+    }
+  }
+
+  float somaMagnitudes(const float* anel, uint16_t inicio, float media) {
+    // Amostras pares na parte real e ímpares na imaginária, já na ordem
+    // de bits invertidos
+    for (uint16_t n = 0; n < N / 2; n++) {
+      uint16_t destino = reverso[n];
+      re[destino] = (anel[(inicio + 2 * n) % N] - media) * janela.peso[2 * n];
+      im[destino] = (anel[(inicio + 2 * n + 1) % N] - media) * janela.peso[2 * n + 1];
+    }
+
+    for (uint16_t tamanho = 2; tamanho <= N / 2; tamanho <<= 1) {
+      uint16_t metade = tamanho / 2;
+      uint16_t passo = N / tamanho;  // Índice no twiddle de N pontos
+      for (uint16_t bloco = 0; bloco < N / 2; bloco += tamanho) {
+        for (uint16_t k = 0; k < metade; k++) {
+          float c = cosseno[k * passo];
+          float s = seno[k * passo];
+          uint16_t a = bloco + k;
+          uint16_t b = a + metade;
+          float tRe = c * re[b] - s * im[b];
+          float tIm = c * im[b] + s * re[b];
+          re[b] = re[a] - tRe;
+          im[b] = im[a] - tIm;
+          re[a] += tRe;
+          im[a] += tIm;
+        }
+      }
+    }
+
+    // X[k] = (Z[k] + Z*[N/2-k]) / 2 - i·W^k (Z[k] - Z*[N/2-k]) / 2
+    float soma = 0;
+    for (uint16_t k = 1; k < N / 2; k++) {
+      uint16_t espelho = N / 2 - k;
+      float parRe = 0.5f * (re[k] + re[espelho]);
+      float parIm = 0.5f * (im[k] - im[espelho]);
+      float imparRe = 0.5f * (im[k] + im[espelho]);
+      float imparIm = -0.5f * (re[k] - re[espelho]);
+      float xRe = parRe + cosseno[k] * imparRe - seno[k] * imparIm;
+      float xIm = parIm + cosseno[k] * imparIm + seno[k] * imparRe;
+      soma += sqrtf(xRe * xRe + xIm * xIm);
+    }
+    return soma;
+  }
+
+private:
+  JanelaHamming<N> janela;
+  float cosseno[N / 2];
+  float seno[N / 2];
+  uint16_t reverso[N / 2];
+  float re[N / 2];
+  float im[N / 2];
+};
+
+#if ESPDSP_DISPONIVEL
+// As tabelas do esp-dsp são globais: inicializadas uma vez, no primeiro uso
+inline bool iniciarEspDsp(esp_err_t resultado) {
+  if (resultado != ESP_OK && resultado != ESP_ERR_DSP_REINITIALIZED) {
+    Serial.println("Falha ao iniciar a FFT do esp-dsp: " + String((int)resultado));
+    return false;
+  }
+  return true;
+}
+
+template <uint16_t N>
+class FFTEspDspF32 {
+public:
+  static const uint16_t AMOSTRAS = N;
+  static const char* nome() { return "espdsp_f32"; }
+
+  float somaMagnitudes(const float* anel, uint16_t inicio, float media) {
+    static bool iniciada = iniciarEspDsp(dsps_fft2r_init_fc32(NULL, N));
+    if (!iniciada) {
+      return 0;
+    }
+    for (uint16_t k = 0; k < N; k++) {
+      dados[2 * k] = (anel[(inicio + k) % N] - media) * janela.peso[k];
+      dados[2 * k + 1] = 0;
+    }
+    dsps_fft2r_fc32(dados, N);
+    dsps_bit_rev_fc32(dados, N);
+
+    float soma = 0;
+    for (uint16_t i = 1; i < N / 2; i++) {
+      soma += sqrtf(dados[2 * i] * dados[2 * i] + dados[2 * i + 1] * dados[2 * i + 1]);
+    }
+    return soma;
+  }
+
+private:
+  JanelaHamming<N> janela;
+  float dados[2 * N] __attribute__((aligned(16)));
+};
+
+template <uint16_t N>
+class FFTEspDspS16 {
+public:
+  static const uint16_t AMOSTRAS = N;
+  static const char* nome() { return "espdsp_s16"; }
+
+  float somaMagnitudes(const float* anel, uint16_t inicio, float media) {
+    static bool iniciada = iniciarEspDsp(dsps_fft2r_init_sc16(NULL, N));
+    if (!iniciada) {
+      return 0;
+    }
+    // Ponto flutuante em bloco: a maior amostra da janela ocupa a faixa
+    // Q15 inteira, o que preserva a resolução de golpes fracos
+    float maior = 0;
+    for (uint16_t k = 0; k < N; k++) {
+      janelado[k] = (anel[(inicio + k) % N] - media) * janela.peso[k];
+      maior = fmaxf(maior, fabsf(janelado[k]));
+    }
+    if (maior == 0) {
+      return 0;
+    }
+    float escala = 32767.0f / maior;
+    for (uint16_t k = 0; k < N; k++) {
+      dados[2 * k] = (int16_t)lroundf(janelado[k] * escala);
+      dados[2 * k + 1] = 0;
+    }
+    dsps_fft2r_sc16(dados, N);
+    dsps_bit_rev_sc16_ansi(dados, N);
+
+    float soma = 0;
+    for (uint16_t i = 1; i < N / 2; i++) {
+      int32_t re = dados[2 * i];
+      int32_t im = dados[2 * i + 1];
+      soma += sqrtf((float)(re * re + im * im));
+    }
+    // A FFT Q15 divide o resultado por N
+    return soma * (N / escala);
+  }
+
+private:
+  JanelaHamming<N> janela;
+  float janelado[N];
+  int16_t dados[2 * N] __attribute__((aligned(16)));
+};
+#endif
+
+#if FFT_FORCA == FFT_ARDUINOFFT
+template <uint16_t N> using FFTForca = FFTArduino<N>;
+#elif FFT_FORCA == FFT_ESPDSP_F32 && ESPDSP_DISPONIVEL
+template <uint16_t N> using FFTForca = FFTEspDspF32<N>;
+#elif FFT_FORCA == FFT_ESPDSP_S16 && ESPDSP_DISPONIVEL
+template <uint16_t N> using FFTForca = FFTEspDspS16<N>;
+#elif FFT_FORCA == FFT_PORTAVEL
+template <uint16_t N> using FFTForca = FFTPortavel<N>;
+#else
+#error "FFT_FORCA inválido ou esp-dsp indisponível"
+#endif
+
+// Janela deslizante da aceleração resultante e espectro a cada amostra
+template <class FFT>
+class PipelineForca {
+public:
+  static const uint16_t N = FFT::AMOSTRAS;
+
+  PipelineForca() { reiniciar(); }
+
+  void reiniciar() {
+    for (uint16_t i = 0; i < N; i++) {
+      anel[i] = 0;
+    }
+    media = 0;
+    somaSample = 0;
+    ind = 0;
+    numSamples = 0;
+  }
+
+  // Soma das magnitudes com a nova amostra; 0 até a janela encher
+  float processar(float newSample) {
+    if (numSamples < N) {
+      somaSample += newSample;
+      anel[numSamples] = newSample;
+      numSamples++;
+    } else {
+      somaSample += newSample - anel[ind];
+      anel[ind] = newSample;
+    }
+
+    ind = (ind + 1) % N;
+    media = somaSample / N;
+
+    if (numSamples >= N) {
+      return fft.somaMagnitudes(anel, ind, media);
+    }
+    return 0;
+  }
+
+  static const char* nome() { return FFT::nome(); }
+
+private:
+  FFT fft;
+  float anel[N];
+  float media;
+  float somaSample;
+  uint16_t ind;
+  uint16_t numSamples;
+};
+
+#endif
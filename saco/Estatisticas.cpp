@@ -0,0 +1,70 @@
+/**
+ * @file Estatisticas.cpp
+ * @brief Implementação do resumo incremental (Welford e anel dos últimos)
+ */
+#include "Estatisticas.h"
+#include <math.h>
+
+void ResumoEstatistico::zerar() {
+  contagem = 0;
+  media = 0;
+  m2 = 0;
+  melhor = 0;
+  proximo = 0;
+  for (int i = 0; i < ESTATISTICAS_ULTIMOS; i++) {
+    ultimos[i] = 0;
+  }
+}
+
+void ResumoEstatistico::restaurar(uint32_t contagem, float media, float m2, float melhor,
+                                  uint8_t proximo) {
+  this->contagem = contagem;
+  this->media = media;
+  this->m2 = m2 > 0 ? m2 : 0;
+  this->melhor = melhor;
+  this->proximo = proximo % ESTATISTICAS_ULTIMOS;
+}
+
+void ResumoEstatistico::definirUltimo(uint8_t indice, float valor) {
+  if (indice < ESTATISTICAS_ULTIMOS) {
+    ultimos[indice] = valor;
+  }
+}
+
+uint8_t ResumoEstatistico::adicionar(float valor) {
+  contagem++;
+  float delta = valor - media;
+  media += delta / contagem;
+  m2 += delta * (valor - media);
+
+  if (contagem == 1 || (maiorMelhor ? valor > melhor : valor < melhor)) {
+    melhor = valor;
+  }
+
+  uint8_t posicao = proximo;
+  ultimos[posicao] = valor;
+  proximo = (proximo + 1) % ESTATISTICAS_ULTIMOS;
+  return posicao;
+}
+
+float ResumoEstatistico::getVariancia() const {
+  return contagem > 1 ? m2 / (contagem - 1) : 0.0f;
+}
+
+float ResumoEstatistico::getDesvio() const {
+  return sqrtf(getVariancia());
+}
+
+uint8_t ResumoEstatistico::getNumUltimos() const {
+  return contagem < ESTATISTICAS_ULTIMOS ? (uint8_t)contagem : ESTATISTICAS_ULTIMOS;
+}
+
+float ResumoEstatistico::getUltimo(uint8_t i) const {
+  // Cheio, o mais antigo é o que o próximo resultado vai sobrescrever
+  uint8_t n = getNumUltimos();
+  if (i >= n) {
+    return 0;
+  }
+  uint8_t inicio = (proximo + ESTATISTICAS_ULTIMOS - n) % ESTATISTICAS_ULTIMOS;
+  return ultimos[(inicio + i) % ESTATISTICAS_ULTIMOS];
+}
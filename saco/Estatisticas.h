@@ -0,0 +1,61 @@
+/**
+ * @file Estatisticas.h
+ * @brief Resumo incremental dos resultados de um usuário em um modo
+ *
+ * As páginas (forca.html, tempodereacao.html, foco.html) liam o histórico
+ * inteiro do usuário para mostrar contagem, média e recorde, e o custo de
+ * abrir a página crescia com o tempo de treino. O saco mantém em
+ * /users/<uid>/resumo/<modo> um resumo atualizado a cada resultado:
+ *
+ * - contagem, media e m2 pelo algoritmo de Welford (variância em uma
+ *   passagem, sem guardar os valores nem perder precisão com somas grandes);
+ * - melhor: maior valor (força) ou menor (tempos);
+ * - ultimos: anel com os ESTATISTICAS_ULTIMOS resultados mais recentes, e
+ *   proximo, a posição que o próximo resultado ocupa.
+ *
+ * Com o resumo a página só busca uma página do histórico (limitToLast).
+ */
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <Arduino.h>
+
+#define ESTATISTICAS_ULTIMOS 10
+
+class ResumoEstatistico {
+public:
+  explicit ResumoEstatistico(bool maiorMelhor = true) : maiorMelhor(maiorMelhor) { zerar(); }
+
+  void zerar();
+
+  // Retoma um resumo lido do Firebase (ultimos[] volta por definirUltimo)
+  void restaurar(uint32_t contagem, float media, float m2, float melhor, uint8_t proximo);
+  void definirUltimo(uint8_t indice, float valor);
+
+  // Devolve a posição do anel onde o valor entrou
+  uint8_t adicionar(float valor);
+
+  uint32_t getContagem() const { return contagem; }
+  float getMedia() const { return media; }
+  float getM2() const { return m2; }
+  float getVariancia() const;  // Amostral (n - 1); 0 com menos de 2 resultados
+  float getDesvio() const;
+  float getMelhor() const { return melhor; }
+  bool getMaiorMelhor() const { return maiorMelhor; }
+
+  // Anel dos últimos resultados: i = 0 é o mais antigo guardado
+  uint8_t getNumUltimos() const;
+  float getUltimo(uint8_t i) const;
+  uint8_t getProximo() const { return proximo; }
+
+private:
+  bool maiorMelhor;
+  uint32_t contagem;
+  float media;
+  float m2;
+  float melhor;
+  float ultimos[ESTATISTICAS_ULTIMOS];
+  uint8_t proximo;
+};
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file Log.cpp
+ * @brief Anel do log e formatação adiada
+ *
+ * O anel é o de Vyukov com vários produtores e um consumidor: cada registro
+ * tem um número de sequência que diz de quem é a vez. Igual à posição, está
+ * livre para o produtor que reservar a posição; igual à posição + 1, está
+ * publicado para o consumidor, que devolve com a posição + LOG_CAPACIDADE.
+ */
+#include "Log.h"
+#include "Rastreio.h"
+#include "ServicoDisplay.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+ServicoLog servicoLog;
+
+const char* nomeModuloLog(ModuloLog modulo) {
+  switch (modulo) {
+    case ModuloLog::Sensores: return "sensores";
+    case ModuloLog::Conexao:  return "conexao";
+    case ModuloLog::Modos:    return "modos";
+    case ModuloLog::Energia:  return "energia";
+    default:                  return "?";
+  }
+}
+
+ServicoLog::ServicoLog() : cabeca(0), cauda(0), descartados(0), escritos(0), saida(&Serial) {
+  for (uint32_t i = 0; i < LOG_CAPACIDADE; i++) {
+    anel[i].sequencia = i;
+  }
+  definirNivel(NivelLog::Info);
+}
+
+bool ServicoLog::iniciar() {
+  if (xTaskCreate(tarefa, "tarefaLog", PILHA_TAREFA_LOG, this, PRIORIDADE_TAREFA_LOG, NULL) != pdPASS) {
+    Serial.println("Falha ao criar tarefa do log");
+    return false;
+  }
+  return true;
+}
+
+void ServicoLog::definirNivel(ModuloLog modulo, NivelLog nivel) {
+  __atomic_store_n(&niveis[(int)modulo], (uint8_t)nivel, __ATOMIC_RELAXED);
+}
+
+void ServicoLog::definirNivel(NivelLog nivel) {
+  for (int i = 0; i < NUM_MODULOS_LOG; i++) {
+    definirNivel((ModuloLog)i, nivel);
+  }
+}
+
+NivelLog ServicoLog::getNivel(ModuloLog modulo) const {
+  return (NivelLog)__atomic_load_n(&niveis[(int)modulo], __ATOMIC_RELAXED);
+}
+
+void ServicoLog::definirSaida(Print& destino) {
+  saida = &destino;
+}
+
+RegistroLog* ServicoLog::reservar(uint32_t& posicao) {
+  posicao = __atomic_load_n(&cabeca, __ATOMIC_RELAXED);
+  while (true) {
+    RegistroLog& registro = anel[posicao & (LOG_CAPACIDADE - 1)];
+    uint32_t sequencia = __atomic_load_n(&registro.sequencia, __ATOMIC_ACQUIRE);
+    int32_t diferenca = (int32_t)(sequencia - posicao);
+    if (diferenca == 0) {
+      // Em caso de falha o CAS já traz a posição atual
+      if (__atomic_compare_exchange_n(&cabeca, &posicao, posicao + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        return &registro;
+      }
+    } else if (diferenca < 0) {
+      // O consumidor ainda não leu este registro: anel cheio
+      __atomic_add_fetch(&descartados, 1, __ATOMIC_RELAXED);
+      return nullptr;
+    } else {
+      posicao = __atomic_load_n(&cabeca, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+void ServicoLog::publicar(RegistroLog& registro, uint32_t posicao) {
+  __atomic_store_n(&registro.sequencia, posicao + 1, __ATOMIC_RELEASE);
+}
+
+bool ServicoLog::retirar(RegistroLog& destino) {
+  RegistroLog& registro = anel[cauda & (LOG_CAPACIDADE - 1)];
+  uint32_t sequencia = __atomic_load_n(&registro.sequencia, __ATOMIC_ACQUIRE);
+  if (sequencia != cauda + 1) {
+    return false;
+  }
+  // Sem a parte não usada do texto: a maioria dos registros não tem %s
+  memcpy(&destino, &registro, offsetof(RegistroLog, texto) + registro.tamanhoTexto);
+  __atomic_store_n(&registro.sequencia, cauda + LOG_CAPACIDADE, __ATOMIC_RELEASE);
+  cauda++;
+  return true;
+}
+
+void ServicoLog::copiarTexto(RegistroLog& registro, size_t& texto, const char* origem) {
+  // Sem espaço a string fica vazia (ou cortada), mas o '\0' dela sempre entra
+  if (texto >= LOG_TAMANHO_TEXTO) {
+    return;
+  }
+  size_t livre = LOG_TAMANHO_TEXTO - texto - 1;
+  size_t tamanho = strnlen(origem, livre);
+  memcpy(registro.texto + texto, origem, tamanho);
+  registro.texto[texto + tamanho] = '\0';
+  texto += tamanho + 1;
+}
+
+size_t ServicoLog::formatar(const RegistroLog& registro, char* destino, size_t tamanho) {
+  if (tamanho == 0) {
+    return 0;
+  }
+  size_t escrito = 0;
+  uint8_t argumento = 0;
+  size_t texto = 0;
+  const char* p = registro.formato;
+
+  auto acrescentar = [&](int n) {
+    if (n > 0) {
+      escrito += (size_t)n;
+      if (escrito >= tamanho) {
+        escrito = tamanho - 1;
+      }
+    }
+  };
+
+  while (*p && escrito < tamanho - 1) {
+    if (*p != '%') {
+      destino[escrito++] = *p++;
+      continue;
+    }
+    if (p[1] == '%') {
+      destino[escrito++] = '%';
+      p += 2;
+      continue;
+    }
+
+    // Flags, largura e precisão ficam; o tamanho (l, h, z) sai, porque o
+    // argumento guardado já é de 32 bits (ou float, promovido a double)
+    char especificacao[16];
+    size_t n = 0;
+    especificacao[n++] = *p++;
+    while (*p && strchr("-+ #0123456789.lhzjt", *p) && n < sizeof(especificacao) - 2) {
+      if (!strchr("lhzjt", *p)) {
+        especificacao[n++] = *p;
+      }
+      p++;
+    }
+    char conversao = *p;
+    if (!conversao) {
+      break;
+    }
+    p++;
+    especificacao[n++] = conversao;
+    especificacao[n] = '\0';
+
+    uint32_t palavra = argumento < registro.numArgumentos ? registro.argumentos[argumento] : 0;
+    char* fim = destino + escrito;
+    size_t resta = tamanho - escrito;
+    switch (conversao) {
+      case 'd': case 'i': case 'c':
+        acrescentar(snprintf(fim, resta, especificacao, (int)(int32_t)palavra));
+        argumento++;
+        break;
+      case 'u': case 'x': case 'X': case 'o':
+        acrescentar(snprintf(fim, resta, especificacao, (unsigned)palavra));
+        argumento++;
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+        float real;
+        memcpy(&real, &palavra, sizeof(real));
+        acrescentar(snprintf(fim, resta, especificacao, (double)real));
+        argumento++;
+        break;
+      }
+      case 's': {
+        const char* valor = texto < registro.tamanhoTexto ? registro.texto + texto : "";
+        texto += strlen(valor) + 1;
+        acrescentar(snprintf(fim, resta, especificacao, valor));
+        break;
+      }
+      default:
+        // Conversão não suportada: sai como está no formato
+        acrescentar(snprintf(fim, resta, "%s", especificacao));
+        break;
+    }
+  }
+  destino[escrito] = '\0';
+  return escrito;
+}
+
+size_t ServicoLog::descarregar(Print& destino) {
+  RASTREIO_TRECHO("log.descarregar");
+  static const char* prefixos[] = {"", "ERRO ", "AVISO ", "", "DEP "};
+  RegistroLog registro;
+  char mensagem[128];
+  size_t quantidade = 0;
+  while (retirar(registro)) {
+    formatar(registro, mensagem, sizeof(mensagem));
+    destino.printf("[%lu.%03lu] %s%s: %s\n", (unsigned long)(registro.tempoUs / 1000000),
+                   (unsigned long)(registro.tempoUs / 1000 % 1000), prefixos[(int)registro.nivel],
+                   nomeModuloLog(registro.modulo), mensagem);
+    if (registro.tela) {
+      servicoDisplay.log(mensagem);
+    }
+    quantidade++;
+  }
+  __atomic_add_fetch(&escritos, quantidade, __ATOMIC_RELAXED);
+  return quantidade;
+}
+
+void ServicoLog::tarefa(void* arg) {
+  ServicoLog* log = static_cast<ServicoLog*>(arg);
+  while (1) {
+    log->descarregar();
+    vTaskDelay(LOG_PERIODO_MS / portTICK_PERIOD_MS);
+  }
+}
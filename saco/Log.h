@@ -0,0 +1,202 @@
+/**
+ * @file Log.h
+ * @brief Log assíncrono: registro binário no anel, formatação na tarefa do log
+ *
+ * Um Serial.printf a 115200 baud segura quem chama por milissegundos. Aqui
+ * quem loga só copia o ponteiro do formato (o literal fica na flash e serve
+ * de ID), os argumentos em palavras de 32 bits e as strings (%s) para um
+ * registro do anel, sem trava: a reserva é um compare-and-swap no índice de
+ * escrita e a publicação um store no número de sequência do registro. A
+ * tarefa do log, de prioridade baixa, formata e escreve na Serial (e no log
+ * do display, com LOG_TELA) a cada LOG_PERIODO_MS.
+ *
+ * Cada módulo tem seu nível; acima dele a chamada volta sem tocar no anel.
+ * Anel cheio descarta o registro novo (getDescartados()).
+ *
+ * @section formatos Formatos
+ * Os do printf, sem '\n' no fim (a tarefa põe): inteiros vão como 32 bits
+ * (%ld e %lu servem, %lld não), reais como float e cada %s é copiado, até
+ * LOG_TAMANHO_TEXTO bytes somando todas as strings do registro.
+ */
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+#define LOG_CAPACIDADE 64          // Registros no anel (potência de 2)
+#define LOG_MAX_ARGUMENTOS 4       // Fora as strings
+#define LOG_TAMANHO_TEXTO 32       // Strings do registro, separadas por '\0'
+#define LOG_PERIODO_MS 20
+#define PRIORIDADE_TAREFA_LOG 0    // Abaixo de todas as tarefas de modo
+#define PILHA_TAREFA_LOG 4096
+
+// Níveis acima deste somem na compilação
+#ifndef LOG_NIVEL_MAXIMO
+#define LOG_NIVEL_MAXIMO 4         // NivelLog::Depuracao
+#endif
+
+static_assert((LOG_CAPACIDADE & (LOG_CAPACIDADE - 1)) == 0, "LOG_CAPACIDADE deve ser potência de 2");
+static_assert(LOG_TAMANHO_TEXTO <= 255, "RegistroLog::tamanhoTexto é de 8 bits");
+
+enum class NivelLog : uint8_t {
+  Desligado,
+  Erro,
+  Aviso,
+  Info,
+  Depuracao
+};
+
+enum class ModuloLog : uint8_t {
+  Sensores,
+  Conexao,
+  Modos,
+  Energia
+};
+#define NUM_MODULOS_LOG 4
+
+struct RegistroLog {
+  uint32_t sequencia;     // Controle do anel
+  uint32_t tempoUs;
+  const char* formato;
+  NivelLog nivel;
+  ModuloLog modulo;
+  uint8_t numArgumentos;
+  bool tela;              // Também no log do display
+  uint8_t tamanhoTexto;   // Bytes usados de texto: o consumidor só copia esses
+  uint32_t argumentos[LOG_MAX_ARGUMENTOS];
+  char texto[LOG_TAMANHO_TEXTO];
+};
+
+const char* nomeModuloLog(ModuloLog modulo);
+
+// Quantos dos argumentos vão para RegistroLog::argumentos (números e enums)
+template <typename... Argumentos>
+struct NumericosLog {
+  static constexpr int quantidade = 0;
+};
+
+template <typename T, typename... Resto>
+struct NumericosLog<T, Resto...> {
+  typedef typename std::decay<T>::type Tipo;
+  static constexpr int quantidade =
+      (std::is_arithmetic<Tipo>::value || std::is_enum<Tipo>::value ? 1 : 0) +
+      NumericosLog<Resto...>::quantidade;
+};
+
+class ServicoLog {
+public:
+  ServicoLog();
+  bool iniciar();
+
+  void definirNivel(ModuloLog modulo, NivelLog nivel);
+  void definirNivel(NivelLog nivel);   // Todos os módulos
+  NivelLog getNivel(ModuloLog modulo) const;
+  bool habilitado(NivelLog nivel, ModuloLog modulo) const {
+    return (uint8_t)nivel <= LOG_NIVEL_MAXIMO &&
+           (uint8_t)nivel <= __atomic_load_n(&niveis[(int)modulo], __ATOMIC_RELAXED);
+  }
+
+  void definirSaida(Print& saida);
+
+  // Não bloqueia nem formata; false se o nível estiver desligado ou o anel cheio
+  template <typename... Argumentos>
+  bool registrar(NivelLog nivel, ModuloLog modulo, bool tela, const char* formato,
+                 const Argumentos&... argumentos) {
+    static_assert(NumericosLog<Argumentos...>::quantidade <= LOG_MAX_ARGUMENTOS,
+                  "Argumentos numéricos demais para o log");
+    if (!habilitado(nivel, modulo)) {
+      return false;
+    }
+    uint32_t posicao;
+    RegistroLog* registro = reservar(posicao);
+    if (registro == nullptr) {
+      return false;
+    }
+    registro->tempoUs = micros();
+    registro->formato = formato;
+    registro->nivel = nivel;
+    registro->modulo = modulo;
+    registro->numArgumentos = 0;
+    registro->tela = tela;
+    size_t texto = 0;
+    // Um codificar() por argumento, da esquerda para a direita (a ordem
+    // de uma lista entre chaves é garantida)
+    int expansao[] = {0, (codificar(*registro, texto, argumentos), 0)...};
+    (void)expansao;
+    registro->tamanhoTexto = (uint8_t)texto;
+    publicar(*registro, posicao);
+    return true;
+  }
+
+  // Formata e escreve os registros pendentes; só um consumidor por vez
+  // (a tarefa do log ou, sem ela, quem chamar)
+  size_t descarregar(Print& saida);
+  size_t descarregar() { return descarregar(*saida); }
+
+  // A mensagem sem o prefixo de tempo e módulo
+  static size_t formatar(const RegistroLog& registro, char* destino, size_t tamanho);
+
+  uint32_t getDescartados() const { return __atomic_load_n(&descartados, __ATOMIC_RELAXED); }
+  uint32_t getEscritos() const { return __atomic_load_n(&escritos, __ATOMIC_RELAXED); }
+
+private:
+  RegistroLog anel[LOG_CAPACIDADE];
+  uint32_t cabeca;   // Próxima reserva (produtores)
+  uint32_t cauda;    // Próxima leitura (consumidor)
+  uint8_t niveis[NUM_MODULOS_LOG];
+  uint32_t descartados;
+  uint32_t escritos;
+  Print* saida;
+
+  RegistroLog* reservar(uint32_t& posicao);
+  void publicar(RegistroLog& registro, uint32_t posicao);
+  bool retirar(RegistroLog& destino);
+  static void tarefa(void* arg);
+
+  static const char* textoDe(const char* texto) { return texto ? texto : "(null)"; }
+  static const char* textoDe(const String& texto) { return texto.c_str(); }
+
+  // Real, inteiro (ou enum) ou texto, escolhido pelo tipo na compilação
+  typedef std::integral_constant<int, 0> ArgumentoReal;
+  typedef std::integral_constant<int, 1> ArgumentoInteiro;
+  typedef std::integral_constant<int, 2> ArgumentoTexto;
+
+  template <typename T>
+  static void codificar(RegistroLog& registro, size_t& texto, const T& valor) {
+    typedef typename std::decay<T>::type Tipo;
+    codificar(registro, texto, valor,
+              std::integral_constant<int, std::is_floating_point<Tipo>::value ? 0
+                                          : NumericosLog<Tipo>::quantidade ? 1 : 2>());
+  }
+
+  template <typename T>
+  static void codificar(RegistroLog& registro, size_t&, const T& valor, ArgumentoReal) {
+    float real = (float)valor;
+    memcpy(&registro.argumentos[registro.numArgumentos++], &real, sizeof(real));
+  }
+
+  template <typename T>
+  static void codificar(RegistroLog& registro, size_t&, const T& valor, ArgumentoInteiro) {
+    registro.argumentos[registro.numArgumentos++] = (uint32_t)valor;
+  }
+
+  template <typename T>
+  static void codificar(RegistroLog& registro, size_t& texto, const T& valor, ArgumentoTexto) {
+    copiarTexto(registro, texto, textoDe(valor));
+  }
+  static void copiarTexto(RegistroLog& registro, size_t& texto, const char* origem);
+};
+
+extern ServicoLog servicoLog;
+
+#define LOG_ERRO(modulo, ...) servicoLog.registrar(NivelLog::Erro, ModuloLog::modulo, false, __VA_ARGS__)
+#define LOG_AVISO(modulo, ...) servicoLog.registrar(NivelLog::Aviso, ModuloLog::modulo, false, __VA_ARGS__)
+#define LOG_INFO(modulo, ...) servicoLog.registrar(NivelLog::Info, ModuloLog::modulo, false, __VA_ARGS__)
+#define LOG_DEPURACAO(modulo, ...) servicoLog.registrar(NivelLog::Depuracao, ModuloLog::modulo, false, __VA_ARGS__)
+// Info que também vai para o log do display (só a mensagem, cortada na largura da tela)
+#define LOG_TELA(modulo, ...) servicoLog.registrar(NivelLog::Info, ModuloLog::modulo, true, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,437 @@
+/**
+ * @file Medicao.cpp
+ * @brief Leitor de JSON em uma passada para o nó de medições
+ */
+#include "Medicao.h"
+#include <limits.h>
+#include <string.h>
+
+namespace {
+
+// Maior chave e maior valor de texto conhecidos ("timestampSolicitacao",
+// "tempo_reacao"), com folga
+const size_t TAMANHO_CHAVE = 24;
+const size_t TAMANHO_NOME = 16;
+
+struct NomeEstado {
+  const char* nome;
+  EstadoMedicao estado;
+};
+
+const NomeEstado ESTADOS[] = {
+  {"solicitada", EstadoMedicao::Solicitada},
+  {"executando", EstadoMedicao::Executando},
+  {"concluida", EstadoMedicao::Concluida},
+};
+
+struct NomeTipo {
+  const char* nome;
+  TipoMedicao tipo;
+};
+
+const NomeTipo TIPOS[] = {
+  {"forca", TipoMedicao::Forca},
+  {"precisao", TipoMedicao::Precisao},
+  {"tempo_reacao", TipoMedicao::TempoReacao},
+  {"tCalibrar", TipoMedicao::Calibrar},
+  {"gravacao", TipoMedicao::Gravacao},
+  {"round", TipoMedicao::Round},
+  {"circuito", TipoMedicao::Circuito},
+};
+
+enum class Campo : uint8_t {
+  Outro,
+  Estado,
+  Tipo,
+  Usuario,
+  Comando,
+  Destino,
+  Timestamp,
+  Duracao,
+  Descanso,
+  Rounds,
+  Versao
+};
+
+struct NomeCampo {
+  const char* nome;
+  Campo campo;
+};
+
+const NomeCampo CAMPOS[] = {
+  {"estado", Campo::Estado},
+  {"tipo", Campo::Tipo},
+  {"usuario", Campo::Usuario},
+  {"comando", Campo::Comando},
+  {"destino", Campo::Destino},
+  {"timestampSolicitacao", Campo::Timestamp},
+  {"duracao", Campo::Duracao},
+  {"descanso", Campo::Descanso},
+  {"rounds", Campo::Rounds},
+  {"versao", Campo::Versao},
+};
+
+// Texto decodificado (pode ter '\0' no meio, vindo de \u0000) contra um nome
+bool igual(const char* texto, size_t tamanho, const char* nome) {
+  return tamanho == strlen(nome) && memcmp(texto, nome, tamanho) == 0;
+}
+
+int valorHex(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool digito(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Cursor sobre o buffer da resposta; nada é copiado além dos textos pedidos
+class LeitorJson {
+public:
+  LeitorJson(const char* texto, size_t tamanho) : p(texto), fim(texto + tamanho) {}
+
+  bool terminou() const { return p == fim; }
+  bool proximo(char c) const { return p < fim && *p == c; }
+  bool numeroAFrente() const { return p < fim && (*p == '-' || digito(*p)); }
+
+  void espacos() {
+    while (p < fim && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+  }
+
+  bool consumir(char c) {
+    if (!proximo(c)) return false;
+    p++;
+    return true;
+  }
+
+  // Texto entre aspas, decodificado em `destino` (se houver) com no máximo
+  // capacidade - 1 bytes; `tamanho` conta todos e `coube` diz se couberam
+  bool texto(char* destino, size_t capacidade, size_t& tamanho, bool& coube) {
+    tamanho = 0;
+    coube = true;
+    if (!consumir('"')) return false;
+    while (p < fim) {
+      uint8_t c = (uint8_t)*p++;
+      if (c == '"') {
+        if (destino) destino[coube ? tamanho : capacidade - 1] = '\0';
+        return true;
+      }
+      if (c < 0x20) return false;
+      if (c != '\\') {
+        anexar(destino, capacidade, tamanho, coube, c);
+        continue;
+      }
+      if (p == fim) return false;
+      switch (*p++) {
+        case '"': c = '"'; break;
+        case '\\': c = '\\'; break;
+        case '/': c = '/'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u': {
+          uint32_t codigo;
+          if (!unicode(codigo)) return false;
+          utf8(destino, capacidade, tamanho, coube, codigo);
+          continue;
+        }
+        default: return false;
+      }
+      anexar(destino, capacidade, tamanho, coube, c);
+    }
+    return false;
+  }
+
+  // Número na gramática do JSON; `inteiro` sem fração nem expoente, e
+  // `valor` só vale se ele também não estourou
+  bool numero(bool& inteiro, bool& estourou, long long& valor) {
+    bool negativo = consumir('-');
+    if (p == fim || !digito(*p)) return false;
+    unsigned long long acumulado = 0;
+    estourou = false;
+    if (*p == '0') {
+      p++;
+    } else {
+      while (p < fim && digito(*p)) {
+        unsigned d = (unsigned)(*p++ - '0');
+        if (acumulado > ((unsigned long long)LLONG_MAX - d) / 10) {
+          estourou = true;
+        } else {
+          acumulado = acumulado * 10 + d;
+        }
+      }
+    }
+    inteiro = true;
+    if (consumir('.')) {
+      inteiro = false;
+      if (!digitos()) return false;
+    }
+    if (consumir('e') || consumir('E')) {
+      inteiro = false;
+      if (!consumir('+')) consumir('-');
+      if (!digitos()) return false;
+    }
+    valor = negativo ? -(long long)acumulado : (long long)acumulado;
+    return true;
+  }
+
+  // Qualquer valor, com o que houver dentro; sem recursão
+  bool pular() {
+    uint32_t pilha = 0;  // Um bit por nível aberto: 1 objeto, 0 vetor
+    int nivel = 0;
+    for (;;) {
+      espacos();
+      bool fechado = false;
+      if (proximo('{') || proximo('[')) {
+        if (nivel == MEDICAO_PROFUNDIDADE_MAXIMA) return false;
+        bool objeto = *p++ == '{';
+        pilha = (pilha << 1) | (objeto ? 1u : 0u);
+        nivel++;
+        espacos();
+        if (consumir(objeto ? '}' : ']')) {
+          pilha >>= 1;
+          nivel--;
+          fechado = true;
+        } else if (objeto && !chave()) {
+          return false;
+        }
+        if (!fechado) continue;
+      } else if (!escalar()) {
+        return false;
+      }
+
+      // Depois de um valor: fecha os níveis que terminaram ou vai ao próximo item
+      for (;;) {
+        if (nivel == 0) return true;
+        espacos();
+        bool objeto = pilha & 1u;
+        if (consumir(',')) {
+          if (objeto && !chave()) return false;
+          break;
+        }
+        if (!consumir(objeto ? '}' : ']')) return false;
+        pilha >>= 1;
+        nivel--;
+      }
+    }
+  }
+
+private:
+  const char* p;
+  const char* fim;
+
+  static void anexar(char* destino, size_t capacidade, size_t& tamanho, bool& coube, uint8_t c) {
+    if (destino && coube && tamanho < capacidade - 1) {
+      destino[tamanho] = (char)c;
+    } else {
+      coube = false;
+    }
+    tamanho++;
+  }
+
+  static void utf8(char* destino, size_t capacidade, size_t& tamanho, bool& coube, uint32_t codigo) {
+    if (codigo < 0x80) {
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)codigo);
+    } else if (codigo < 0x800) {
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0xC0 | (codigo >> 6)));
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0x80 | (codigo & 0x3F)));
+    } else if (codigo < 0x10000) {
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0xE0 | (codigo >> 12)));
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0x80 | ((codigo >> 6) & 0x3F)));
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0x80 | (codigo & 0x3F)));
+    } else {
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0xF0 | (codigo >> 18)));
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0x80 | ((codigo >> 12) & 0x3F)));
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0x80 | ((codigo >> 6) & 0x3F)));
+      anexar(destino, capacidade, tamanho, coube, (uint8_t)(0x80 | (codigo & 0x3F)));
+    }
+  }
+
+  bool hex4(uint32_t& codigo) {
+    if (fim - p < 4) return false;
+    codigo = 0;
+    for (int i = 0; i < 4; i++) {
+      int v = valorHex(*p++);
+      if (v < 0) return false;
+      codigo = (codigo << 4) | (uint32_t)v;
+    }
+    return true;
+  }
+
+  // Depois de "\u": um ponto de código, juntando os pares substitutos
+  bool unicode(uint32_t& codigo) {
+    if (!hex4(codigo)) return false;
+    if (codigo >= 0xDC00 && codigo <= 0xDFFF) return false;
+    if (codigo < 0xD800 || codigo > 0xDBFF) return true;
+    uint32_t baixo;
+    if (!consumir('\\') || !consumir('u') || !hex4(baixo) || baixo < 0xDC00 || baixo > 0xDFFF) {
+      return false;
+    }
+    codigo = 0x10000 + ((codigo - 0xD800) << 10) + (baixo - 0xDC00);
+    return true;
+  }
+
+  bool digitos() {
+    if (p == fim || !digito(*p)) return false;
+    while (p < fim && digito(*p)) p++;
+    return true;
+  }
+
+  bool literal(const char* palavra) {
+    size_t n = strlen(palavra);
+    if ((size_t)(fim - p) < n || memcmp(p, palavra, n) != 0) return false;
+    p += n;
+    return true;
+  }
+
+  bool escalar() {
+    if (proximo('"')) {
+      size_t tamanho;
+      bool coube;
+      return texto(nullptr, 0, tamanho, coube);
+    }
+    if (proximo('t')) return literal("true");
+    if (proximo('f')) return literal("false");
+    if (proximo('n')) return literal("null");
+    bool inteiro, estourou;
+    long long valor;
+    return numero(inteiro, estourou, valor);
+  }
+
+  // Chave de um objeto aninhado e o ':'
+  bool chave() {
+    size_t tamanho;
+    bool coube;
+    espacos();
+    if (!texto(nullptr, 0, tamanho, coube)) return false;
+    espacos();
+    return consumir(':');
+  }
+};
+
+Campo campoMedicao(const char* chave, size_t tamanho) {
+  for (const NomeCampo& item : CAMPOS) {
+    if (igual(chave, tamanho, item.nome)) return item.campo;
+  }
+  return Campo::Outro;
+}
+
+// Inteiro em [minimo, maximo]; outro tipo ou fora da faixa fica no padrão
+template <typename T>
+bool lerInteiro(LeitorJson& leitor, T& destino, long long minimo, unsigned long long maximo) {
+  if (!leitor.numeroAFrente()) {
+    return leitor.pular();
+  }
+  bool inteiro, estourou;
+  long long valor;
+  if (!leitor.numero(inteiro, estourou, valor)) return false;
+  if (inteiro && !estourou && valor >= minimo && (valor < 0 || (unsigned long long)valor <= maximo)) {
+    destino = (T)valor;
+  }
+  return true;
+}
+
+bool lerCampo(LeitorJson& leitor, Campo campo, Medicao& medicao) {
+  switch (campo) {
+    case Campo::Timestamp:
+      return lerInteiro(leitor, medicao.timestampSolicitacao, 0, ULONG_MAX);
+    case Campo::Duracao:
+      return lerInteiro(leitor, medicao.duracao, INT_MIN, INT_MAX);
+    case Campo::Descanso:
+      return lerInteiro(leitor, medicao.descanso, INT_MIN, INT_MAX);
+    case Campo::Rounds:
+      return lerInteiro(leitor, medicao.rounds, INT_MIN, INT_MAX);
+    case Campo::Versao:
+      return lerInteiro(leitor, medicao.versao, INT_MIN, INT_MAX);
+    case Campo::Outro:
+      return leitor.pular();
+    default:
+      break;
+  }
+  if (!leitor.proximo('"')) {
+    return leitor.pular();
+  }
+
+  size_t tamanho;
+  bool coube;
+  if (campo == Campo::Usuario) {
+    if (!leitor.texto(medicao.usuario, sizeof(medicao.usuario), tamanho, coube)) return false;
+    // Com um '\0' no meio o uid também não serve
+    if (!coube || strlen(medicao.usuario) != tamanho) medicao.usuario[0] = '\0';
+    return true;
+  }
+
+  char nome[TAMANHO_NOME];
+  if (!leitor.texto(nome, sizeof(nome), tamanho, coube)) return false;
+  if (!coube) tamanho = 0;  // Nenhum nome conhecido é tão grande
+  switch (campo) {
+    case Campo::Estado:
+      medicao.estado = EstadoMedicao::Desconhecido;
+      for (const NomeEstado& item : ESTADOS) {
+        if (igual(nome, tamanho, item.nome)) medicao.estado = item.estado;
+      }
+      break;
+    case Campo::Tipo:
+      medicao.tipo = TipoMedicao::Desconhecido;
+      for (const NomeTipo& item : TIPOS) {
+        if (igual(nome, tamanho, item.nome)) medicao.tipo = item.tipo;
+      }
+      break;
+    case Campo::Comando:
+      medicao.parar = igual(nome, tamanho, "parar");
+      break;
+    case Campo::Destino:
+      medicao.destino = igual(nome, tamanho, "flash") ? DestinoTraco::Flash : DestinoTraco::Serial;
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+bool decodificarObjeto(LeitorJson& leitor, Medicao& medicao) {
+  leitor.espacos();
+  if (!leitor.consumir('{')) return false;
+  leitor.espacos();
+  if (!leitor.consumir('}')) {
+    do {
+      leitor.espacos();
+      char chave[TAMANHO_CHAVE];
+      size_t tamanho;
+      bool coube;
+      if (!leitor.texto(chave, sizeof(chave), tamanho, coube)) return false;
+      leitor.espacos();
+      if (!leitor.consumir(':')) return false;
+      leitor.espacos();
+      Campo campo = coube ? campoMedicao(chave, tamanho) : Campo::Outro;
+      if (!lerCampo(leitor, campo, medicao)) return false;
+      leitor.espacos();
+    } while (leitor.consumir(','));
+    if (!leitor.consumir('}')) return false;
+  }
+  leitor.espacos();
+  return leitor.terminou();
+}
+
+}  // namespace
+
+const char* nomeTipoMedicao(TipoMedicao tipo) {
+  for (const NomeTipo& item : TIPOS) {
+    if (item.tipo == tipo) return item.nome;
+  }
+  return "?";
+}
+
+bool decodificarMedicao(const char* json, size_t tamanho, Medicao& medicao) {
+  medicao = Medicao();
+  LeitorJson leitor(json, tamanho);
+  if (!decodificarObjeto(leitor, medicao)) {
+    medicao = Medicao();
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file Medicao.h
+ * @brief Comando de /devices/<id>/entrada e sua decodificação
+ *
+ * O checkForCommands lia o nó inteiro como FirebaseJson (uma árvore no
+ * heap) e buscava cada campo com get() e comparações de String. No
+ * esquema 1 o comando e os resultados dividiam o nó medicoes/, que só
+ * crescia durante uma medição (resultado, progresso, sensoresCalibrados,
+ * rounds, ...); desde o esquema 2 (Conexao.h) o comando fica sozinho em
+ * entrada/ e a leitura tem tamanho fixo.
+ *
+ * decodificarMedicao() percorre a resposta crua uma vez, no próprio
+ * buffer do FirebaseData (fbdo.to<const char*>(), sem passar por uma
+ * String), e preenche a Medicao: os textos conhecidos viram enums, o
+ * usuário é copiado para um vetor fixo e os objetos e vetores aninhados
+ * são só validados e pulados. Nenhuma alocação, e a pilha não depende do
+ * documento (o aninhamento é uma pilha de bits, até
+ * MEDICAO_PROFUNDIDADE_MAXIMA níveis).
+ *
+ * Como no get() do FirebaseJson, só os campos do primeiro nível contam, e
+ * um campo de outro tipo (um número onde se espera texto) fica no padrão.
+ */
+#ifndef MEDICAO_H
+#define MEDICAO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Uids do Firebase Auth têm 28 caracteres; um maior que isso fica vazio
+// (truncado, seria o uid de outro usuário)
+#ifndef MEDICAO_TAMANHO_USUARIO
+#define MEDICAO_TAMANHO_USUARIO 64
+#endif
+
+// Objetos e vetores aninhados (resultado/metricas/... de um nó do esquema 1)
+#define MEDICAO_PROFUNDIDADE_MAXIMA 32
+
+// Campo "estado"
+enum class EstadoMedicao : uint8_t {
+  Nenhum,  // Ausente
+  Solicitada,
+  Executando,
+  Concluida,
+  Desconhecido
+};
+
+// Campo "tipo": o modo pedido pelo app
+enum class TipoMedicao : uint8_t {
+  Nenhum,
+  Forca,        // "forca"
+  Precisao,     // "precisao"
+  TempoReacao,  // "tempo_reacao"
+  Calibrar,     // "tCalibrar"
+  Gravacao,     // "gravacao"
+  Round,        // "round"
+  Circuito,     // "circuito"
+  Desconhecido
+};
+
+// Campo "destino" da gravação de traço
+enum class DestinoTraco : uint8_t { Serial, Flash };
+
+// Estrutura para medições
+struct Medicao {
+  EstadoMedicao estado = EstadoMedicao::Nenhum;
+  TipoMedicao tipo = TipoMedicao::Nenhum;
+  bool parar = false;  // "comando": "parar"
+  char usuario[MEDICAO_TAMANHO_USUARIO] = {};
+  unsigned long timestampSolicitacao = 0;
+  DestinoTraco destino = DestinoTraco::Serial;  // Gravação de traço
+  int duracao = 0;                              // Gravação de traço e round: segundos
+  int descanso = 0;                             // Round: segundos entre os rounds
+  int rounds = 0;                               // Round: quantidade de rounds
+  int versao = 0;                               // Esquema de quem pediu; 0: sem versão
+};
+
+// Nome do tipo como o app grava ("?" para Nenhum/Desconhecido)
+const char* nomeTipoMedicao(TipoMedicao tipo);
+
+// `json` não precisa terminar em '\0': só os `tamanho` bytes são lidos.
+// Falso se não for um objeto JSON válido, e a Medicao volta ao padrão.
+bool decodificarMedicao(const char* json, size_t tamanho, Medicao& medicao);
+
+#endif
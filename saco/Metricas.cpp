@@ -0,0 +1,182 @@
+/**
+ * @file Metricas.cpp
+ * @brief Implementação das métricas físicas do golpe
+ */
+#include "Metricas.h"
+#include "Captura.h"
+#include <math.h>
+#include <string.h>
+
+void AnalisadorGolpe::reiniciar(float fatorNewtons) {
+  fator = fatorNewtons;
+  somaRepouso[0] = somaRepouso[1] = somaRepouso[2] = 0;
+  amostrasRepouso = 0;
+  repouso[0] = repouso[1] = repouso[2] = 0;
+  repousoFixo = false;
+  anteriorValida = false;
+  tempoAnteriorUs = 0;
+  iniciado = false;
+  inicioUs = 0;
+  pico = 0;
+  picoVetor[0] = picoVetor[1] = picoVetor[2] = 0;
+  picoUs = 0;
+  impulso = 0;
+  jerk = 0;
+  giro = 0;
+}
+
+void AnalisadorGolpe::fixarRepouso(const AmostraGolpe& amostra) {
+  if (amostrasRepouso > 0) {
+    for (int i = 0; i < 3; i++) {
+      repouso[i] = somaRepouso[i] / amostrasRepouso;
+    }
+  } else {
+    // Sem pré-gatilho: só a gravidade, na direção da primeira amostra
+    float norma = sqrtf(amostra.ax * amostra.ax + amostra.ay * amostra.ay + amostra.az * amostra.az);
+    float escala = norma > 0 ? 1.0f / norma : 0;
+    repouso[0] = amostra.ax * escala;
+    repouso[1] = amostra.ay * escala;
+    repouso[2] = amostra.az * escala;
+  }
+  repousoFixo = true;
+}
+
+float AnalisadorGolpe::dinamica(const AmostraGolpe& amostra, const float base[3]) const {
+  float dx = amostra.ax - base[0], dy = amostra.ay - base[1], dz = amostra.az - base[2];
+  return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+void AnalisadorGolpe::iniciarNoPreGatilho(const float media[3], uint32_t tempoUs) {
+  memcpy(repouso, media, sizeof(repouso));
+  repousoFixo = true;
+  // A amostra anterior, ainda bruta, é a base do jerk e do impulso da primeira do golpe
+  for (int i = 0; i < 3; i++) {
+    anterior[i] -= repouso[i];
+  }
+  iniciado = true;
+  inicioUs = tempoUs;
+}
+
+void AnalisadorGolpe::descartarInicio() {
+  repousoFixo = false;
+  iniciado = false;
+  inicioUs = 0;
+  pico = 0;
+  picoVetor[0] = picoVetor[1] = picoVetor[2] = 0;
+  picoUs = 0;
+  impulso = 0;
+  jerk = 0;
+  giro = 0;
+}
+
+void AnalisadorGolpe::adicionar(const AmostraGolpe& amostra, bool posGatilho) {
+  if (!posGatilho) {
+    if (iniciado) {
+      if (dinamica(amostra, repouso) > METRICAS_RUIDO_G) {
+        medir(amostra);
+        return;
+      }
+      // Voltou ao repouso antes do gatilho: não era o golpe
+      descartarInicio();
+    } else if (amostrasRepouso >= METRICAS_REPOUSO_MINIMO) {
+      float media[3];
+      for (int i = 0; i < 3; i++) {
+        media[i] = somaRepouso[i] / amostrasRepouso;
+      }
+      if (dinamica(amostra, media) > METRICAS_RUIDO_G) {
+        iniciarNoPreGatilho(media, amostra.tempoUs);
+        medir(amostra);
+        return;
+      }
+    }
+    somaRepouso[0] += amostra.ax;
+    somaRepouso[1] += amostra.ay;
+    somaRepouso[2] += amostra.az;
+    amostrasRepouso++;
+    // Bruta por enquanto: vira d quando o repouso for fixado
+    anterior[0] = amostra.ax;
+    anterior[1] = amostra.ay;
+    anterior[2] = amostra.az;
+    tempoAnteriorUs = amostra.tempoUs;
+    anteriorValida = true;
+    return;
+  }
+  if (!repousoFixo) {
+    fixarRepouso(amostra);
+    // A última amostra do pré-gatilho é a base do jerk e do impulso da primeira do golpe
+    for (int i = 0; i < 3; i++) {
+      anterior[i] -= repouso[i];
+    }
+  }
+  medir(amostra);
+}
+
+void AnalisadorGolpe::medir(const AmostraGolpe& amostra) {
+  float d[3] = {amostra.ax - repouso[0], amostra.ay - repouso[1], amostra.az - repouso[2]};
+  float modulo = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+
+  if (anteriorValida) {
+    float dt = (amostra.tempoUs - tempoAnteriorUs) / 1e6f;
+    if (dt > 0) {
+      float dx = d[0] - anterior[0], dy = d[1] - anterior[1], dz = d[2] - anterior[2];
+      float variacao = sqrtf(dx * dx + dy * dy + dz * dz) / dt;
+      if (variacao > jerk) jerk = variacao;
+      if (modulo > METRICAS_RUIDO_G) {
+        impulso += (modulo - METRICAS_RUIDO_G) * dt;
+      }
+    }
+  }
+  memcpy(anterior, d, sizeof(anterior));
+  tempoAnteriorUs = amostra.tempoUs;
+  anteriorValida = true;
+
+  if (!iniciado && modulo > METRICAS_RUIDO_G) {
+    iniciado = true;
+    inicioUs = amostra.tempoUs;
+  }
+  if (modulo > pico) {
+    pico = modulo;
+    memcpy(picoVetor, d, sizeof(picoVetor));
+    picoUs = amostra.tempoUs;
+  }
+
+  float rotacao = sqrtf(amostra.gx * amostra.gx + amostra.gy * amostra.gy + amostra.gz * amostra.gz);
+  if (rotacao > giro) giro = rotacao;
+}
+
+MetricasGolpe AnalisadorGolpe::resultado() const {
+  MetricasGolpe m;
+  memset(&m, 0, sizeof(m));
+  m.valido = iniciado;
+  m.picoG = pico;
+  m.impulsoGs = impulso;
+  m.subidaMs = iniciado ? (picoUs - inicioUs) / 1000.0f : 0;
+  m.jerkGs = jerk;
+  m.giroDps = giro;
+  strcpy(m.eixo, "--");
+  if (pico > 0) {
+    m.direcaoX = picoVetor[0] / pico;
+    m.direcaoY = picoVetor[1] / pico;
+    m.direcaoZ = picoVetor[2] / pico;
+    m.azimuteGraus = atan2f(picoVetor[1], picoVetor[0]) * 180.0f / M_PI;
+    int eixo = 0;
+    for (int i = 1; i < 3; i++) {
+      if (fabsf(picoVetor[i]) > fabsf(picoVetor[eixo])) eixo = i;
+    }
+    m.eixo[0] = picoVetor[eixo] < 0 ? '-' : '+';
+    m.eixo[1] = "XYZ"[eixo];
+  }
+  m.fatorNewtons = fator;
+  m.forcaN = pico * fator;
+  m.impulsoNs = impulso * fator;
+  return m;
+}
+
+MetricasGolpe calcularMetricas(const CapturaGolpe& captura, float fatorNewtons) {
+  AnalisadorGolpe analisador;
+  analisador.reiniciar(fatorNewtons);
+  for (uint16_t i = 0; i < captura.getTamanho(); i++) {
+    analisador.adicionar(captura.amostra(i), i >= captura.getIndiceGatilho());
+  }
+  return analisador.resultado();
+}
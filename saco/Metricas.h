@@ -0,0 +1,93 @@
+/**
+ * @file Metricas.h
+ * @brief Métricas físicas de um golpe a partir da janela de aceleração e giro
+ *
+ * O AnalisadorGolpe recebe as amostras uma a uma (passagem única, memória
+ * constante). O golpe começa antes do gatilho (CAPTURA_LIMIAR_G fica bem
+ * acima do ruído), então o início é procurado já no pré-gatilho: a amostra
+ * que se afasta mais que METRICAS_RUIDO_G da média das anteriores. As
+ * amostras antes dele definem o vetor de repouso (gravidade e inclinação do
+ * saco); dele em diante são medidas como a aceleração dinâmica
+ * d = a - repouso. Se |d| volta ao ruído antes do gatilho, era ruído e o
+ * repouso segue somando. Sem início no pré-gatilho, o repouso é a média do
+ * pré-gatilho inteiro:
+ *
+ * - picoG:     maior |d|
+ * - impulsoGs: integral de |d| acima do ruído (METRICAS_RUIDO_G), em g·s
+ * - subidaMs:  do início do golpe (|d| acima do ruído) até o pico
+ * - jerkGs:    maior |d[k] - d[k-1]| / dt, em g/s
+ * - direcao:   d no pico, normalizado; azimute no plano X-Y e eixo dominante
+ * - giroDps:   maior velocidade angular do golpe
+ *
+ * Com um fator de escala do saco (N por g, ex.: massa efetiva × 9,81) as
+ * métricas também saem em newtons e N·s.
+ */
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <Arduino.h>
+
+#define METRICAS_RUIDO_G 0.2f       // |d| abaixo disso é ruído do MPU e do saco
+#define FATOR_NEWTONS_PADRAO 0.0f   // 0: sem conversão para newtons
+#define METRICAS_REPOUSO_MINIMO 10  // Amostras de repouso antes de procurar o início
+
+struct AmostraGolpe;
+class CapturaGolpe;
+
+struct MetricasGolpe {
+  bool valido;
+  float picoG;
+  float impulsoGs;
+  float subidaMs;
+  float jerkGs;
+  float direcaoX, direcaoY, direcaoZ;
+  float azimuteGraus;   // atan2(Y, X) de d no pico
+  char eixo[3];         // Eixo dominante de d no pico: "+X", "-Z", ...
+  float giroDps;
+  float fatorNewtons;   // 0 se o saco não tem escala
+  float forcaN;         // picoG × fator
+  float impulsoNs;      // impulsoGs × fator
+};
+
+class AnalisadorGolpe {
+public:
+  AnalisadorGolpe() { reiniciar(); }
+
+  void reiniciar(float fatorNewtons = FATOR_NEWTONS_PADRAO);
+
+  // posGatilho: false para as amostras do pré-gatilho
+  void adicionar(const AmostraGolpe& amostra, bool posGatilho);
+
+  MetricasGolpe resultado() const;
+
+private:
+  float fator;
+  float somaRepouso[3];
+  uint32_t amostrasRepouso;
+  float repouso[3];
+  bool repousoFixo;
+
+  bool anteriorValida;
+  float anterior[3];
+  uint32_t tempoAnteriorUs;
+
+  bool iniciado;
+  uint32_t inicioUs;
+  float pico;
+  float picoVetor[3];
+  uint32_t picoUs;
+  float impulso;
+  float jerk;
+  float giro;
+
+  void fixarRepouso(const AmostraGolpe& amostra);
+  void iniciarNoPreGatilho(const float media[3], uint32_t tempoUs);
+  void descartarInicio();
+  float dinamica(const AmostraGolpe& amostra, const float base[3]) const;
+  void medir(const AmostraGolpe& amostra);
+};
+
+// Métricas da janela completa de uma CapturaGolpe
+MetricasGolpe calcularMetricas(const CapturaGolpe& captura, float fatorNewtons = FATOR_NEWTONS_PADRAO);
+
+#endif
@@ -0,0 +1,23 @@
+/**
+ * @file ModeloGolpes.h
+ * @brief Escolhe as tabelas do classificador de golpes da placa (PLACA)
+ *
+ * Cada placa tem o seu modelo, gerado por treinar_classificador num build
+ * dessa placa (ModeloGolpes<Placa>.h): a posição dos pads é uma das
+ * características e a resposta ao golpe muda com a montagem. Uma placa
+ * sem modelo classifica tudo como Desconhecido.
+ */
+#ifndef MODELO_GOLPES_H
+#define MODELO_GOLPES_H
+
+#include "Placas.h"
+
+#if PLACA == PLACA_SACO
+#include "ModeloGolpesSaco.h"
+#endif
+
+#ifndef MODELO_GOLPES_GRAVADO
+#define MODELO_GOLPES_GRAVADO 0
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file ModeloGolpesSaco.h
+ * @brief Tabelas int8 do classificador de golpes da placa saco (ver Classificador.h)
+ *
+ * Gerado por host/ferramentas/treinar_classificador; não editar.
+ * Origem: 400 golpes sintéticos por tipo (semente 1)
+ */
+#ifndef MODELO_GOLPES_SACO_H
+#define MODELO_GOLPES_SACO_H
+
+#include <stdint.h>
+
+#define MODELO_GOLPES_OCULTOS 16
+#define MODELO_GOLPES_GRAVADO 0   // 1: treinado com traços gravados no saco
+
+constexpr float MODELO_GOLPES_MEDIA[17] = {5.882905e+00f, 5.591583e+01f, 5.447434e-01f, 2.342511e-01f, 2.210065e-01f, 6.585762e-01f, 8.501814e-02f, 2.470958e-01f, 3.045680e-01f, 7.896901e-01f, 1.168131e+00f, 8.069375e-01f, 1.694627e-01f, 2.359941e-02f, -6.275000e-01f, -7.500000e-02f, 2.650000e-01f};
+constexpr float MODELO_GOLPES_ESCALA[17] = {1.727851e+01f, 1.565473e+00f, 7.640347e+01f, 8.802598e+01f, 8.989214e+01f, 9.597954e+01f, 6.715648e+01f, 8.005451e+01f, 1.556850e+02f, 3.444512e+01f, 3.001595e+01f, 3.778106e+02f, 4.819849e+02f, 1.695195e+03f, 6.618811e+01f, 6.780812e+01f, 4.059287e+01f};
+
+constexpr int8_t MODELO_GOLPES_PESOS1[16][17] = {
+  {-7, 3, -15, 7, -37, -20, 12, -35, 26, -33, 39, 13, 3, -21, -20, -14, 10},
+  {32, -9, -51, -30, 47, -26, -3, 51, 12, 16, -44, -15, 11, -7, 7, -3, -12},
+  {-17, -7, -18, 27, 21, -8, 18, 3, 22, 2, -6, 29, -42, -20, -8, 12, -27},
+  {-13, 1, 5, 8, 14, 4, -40, -19, 16, -20, -84, -24, 25, -5, -18, -3, 3},
+  {5, 11, 35, -52, -24, 37, 18, -38, 45, -12, 47, 9, 13, -9, -37, 26, -17},
+  {4, 13, -46, 46, -19, -29, 47, 1, -27, -25, 35, 2, -11, 14, 25, 6, 14},
+  {-2, 28, 18, -22, -48, 38, 97, -61, 6, -22, 84, 37, -10, -91, 3, 52, -3},
+  {13, 17, 44, -19, -7, 22, 79, -1, -9, -18, 69, 21, -8, -16, -21, 26, 26},
+  {0, 16, 29, -32, -49, 13, 35, -9, -31, -18, 31, 10, -17, -27, -49, 25, -12},
+  {20, 22, -19, -19, 23, 14, 7, 8, -58, 20, -9, 3, 24, -8, 36, 4, -35},
+  {1, -19, -19, 12, 22, 15, -9, 31, 1, 47, -16, 15, -16, -24, -7, -10, -21},
+  {25, -4, 29, -46, -9, 25, -91, -25, 9, -40, -127, -37, 23, 83, 40, -11, 16},
+  {-10, 10, -15, 24, 14, -19, -69, 10, -48, -44, -76, -9, 9, 51, -27, 12, 11},
+  {-21, -12, -14, 12, -4, 20, -32, 5, -11, -15, -64, -45, 27, 16, 4, -11, 9},
+  {-20, 2, 15, 1, -2, -8, -29, 3, -1, -18, -23, -27, 37, 22, 15, -1, -11},
+  {26, 6, -49, 5, -19, -15, -40, -41, -1, -12, 26, 15, 8, -24, 10, -9, -3},
+};
+constexpr int32_t MODELO_GOLPES_VIES1[16] = {1065, 891, 698, -415, 980, 603, 1212, 907, 511, 70, 561, 399, -759, -543, -466, 340};
+constexpr int32_t MODELO_GOLPES_MULTIPLICADOR1 = 1415430207;
+constexpr uint8_t MODELO_GOLPES_DESLOCAMENTO1 = 38;
+
+constexpr int8_t MODELO_GOLPES_PESOS2[4][16] = {
+  {-88, 6, -38, 62, -38, -26, -127, -119, -62, -89, -47, 74, 104, 118, 103, -30},
+  {21, -4, -72, -49, 44, -66, 71, 120, 88, 29, -30, -12, -99, -65, -33, -57},
+  {99, -14, 20, -4, -88, 75, 52, 39, -71, -20, -82, -72, 5, -20, -44, 112},
+  {-33, 85, 67, -49, -27, -55, -20, -54, -44, 42, 37, -63, 0, 8, -6, -29},
+};
+constexpr int32_t MODELO_GOLPES_VIES2[4] = {-254, 47, 120, 164};
+
+#endif
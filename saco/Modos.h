@@ -0,0 +1,43 @@
+/**
+ * @file Modos.h
+ * @brief Estados de operação do saco e tarefas que os executam
+ *
+ * Declarações compartilhadas entre saco.ino e o build nativo (host/), que
+ * exercita as tarefas de modo sem o hardware.
+ */
+#ifndef MODOS_H
+#define MODOS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+enum class Estado {
+  Inicial,
+  Forca,
+  Agilidade,
+  Calibrar,
+  Precisao,
+  Gravacao,
+  Round,
+  Circuito,   // Vários sacos sincronizados (Circuito.h)
+  Ocioso      // Light sleep entre despertares (Energia.h)
+};
+
+extern Estado estadoAtual;
+extern SemaphoreHandle_t xEstadoMutex;
+
+void tarefaPiscarLED(void* arg);
+void tarefaDataHora(void* arg);
+void tarefaCalibra(void* arg);
+void tarefaComunicacao(void* arg);
+void tarefaAgilidade(void* arg);
+void tarefaPrecisao(void* arg);
+void tarefaForca(void* arg);
+void tarefaGravacao(void* arg);
+void tarefaRound(void* arg);
+void tarefaEnergia(void* arg);
+void tarefaCircuito(void* arg);
+void tarefaOta(void* arg);
+
+#endif
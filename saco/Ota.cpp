@@ -0,0 +1,288 @@
+/**
+ * @file Ota.cpp
+ * @brief Download, aplicação e confirmação das imagens OTA
+ */
+#include "Ota.h"
+#include "Log.h"
+#include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+
+AtualizadorOta atualizadorOta;
+
+namespace {
+
+// Base: a partição que roda; destino: a outra, aberta com esp_ota_begin()
+class ParticoesOta : public ParticoesDelta {
+public:
+  ParticoesOta(const esp_partition_t* base, esp_ota_handle_t handle) : base(base), handle(handle) {}
+
+  bool lerBase(uint32_t posicao, uint8_t* dados, size_t tamanho) override {
+    return esp_partition_read(base, posicao, dados, tamanho) == ESP_OK;
+  }
+
+  bool escrever(const uint8_t* dados, size_t tamanho) override {
+    return esp_ota_write(handle, dados, tamanho) == ESP_OK;
+  }
+
+private:
+  const esp_partition_t* base;
+  esp_ota_handle_t handle;
+};
+
+void copiarTexto(char* destino, size_t capacidade, const char* inicio, size_t tamanho) {
+  size_t n = tamanho < capacidade - 1 ? tamanho : capacidade - 1;
+  memcpy(destino, inicio, n);
+  destino[n] = '\0';
+}
+
+// Próxima palavra de `texto` até o fim da linha; avança `texto`
+size_t palavra(const char*& texto, const char*& inicio) {
+  while (*texto == ' ' || *texto == '\t' || *texto == '\r') texto++;
+  inicio = texto;
+  while (*texto && *texto != ' ' && *texto != '\t' && *texto != '\r' && *texto != '\n') texto++;
+  return texto - inicio;
+}
+
+}  // namespace
+
+const char* nomeEstadoOta(EstadoOta estado) {
+  switch (estado) {
+    case EstadoOta::Atualizada: return "atualizada";
+    case EstadoOta::Baixando: return "baixando";
+    case EstadoOta::Pronta: return "pronta";
+    case EstadoOta::Reiniciando: return "reiniciando";
+    case EstadoOta::Verificando: return "verificando";
+    case EstadoOta::Confirmada: return "confirmada";
+    case EstadoOta::Revertida: return "revertida";
+    case EstadoOta::Falhou: return "falhou";
+  }
+  return "?";
+}
+
+AtualizadorOta::AtualizadorOta()
+  : aviso(nullptr), estado(EstadoOta::Atualizada), erro(""), progresso(0), usouDelta(false),
+    bytesBaixados(0), destino(nullptr) {
+  versao[0] = '\0';
+  versaoNova[0] = '\0';
+}
+
+void AtualizadorOta::iniciar(AvisoOta funcao) {
+  aviso = funcao;
+  estado = EstadoOta::Atualizada;
+  erro = "";
+  progresso = 0;
+  usouDelta = false;
+  bytesBaixados = 0;
+  destino = nullptr;
+  copiarTexto(versao, sizeof(versao), esp_ota_get_app_description()->version,
+              sizeof(esp_ota_get_app_description()->version));
+  versaoNova[0] = '\0';
+
+  const esp_partition_t* atual = esp_ota_get_running_partition();
+  esp_ota_img_states_t situacao;
+  if (esp_ota_get_state_partition(atual, &situacao) == ESP_OK &&
+      situacao == ESP_OTA_IMG_PENDING_VERIFY) {
+    copiarTexto(versaoNova, sizeof(versaoNova), versao, sizeof(versao));
+    estado = EstadoOta::Verificando;
+    return;
+  }
+
+  // A outra partição descartada: este boot é a volta de um rollback
+  const esp_partition_t* outra = esp_ota_get_next_update_partition(nullptr);
+  esp_app_desc_t descricao;
+  if (esp_ota_get_state_partition(outra, &situacao) == ESP_OK &&
+      (situacao == ESP_OTA_IMG_INVALID || situacao == ESP_OTA_IMG_ABORTED) &&
+      esp_ota_get_partition_description(outra, &descricao) == ESP_OK) {
+    copiarTexto(versaoNova, sizeof(versaoNova), descricao.version, sizeof(descricao.version));
+    estado = EstadoOta::Revertida;
+  }
+}
+
+void AtualizadorOta::confirmar(bool saudavel) {
+  if (estado != EstadoOta::Verificando) {
+    return;
+  }
+  if (saudavel) {
+    esp_ota_mark_app_valid_cancel_rollback();
+    LOG_INFO(Conexao, "OTA: versao %s confirmada", versao);
+    mudar(EstadoOta::Confirmada);
+    return;
+  }
+  LOG_ERRO(Conexao, "OTA: versao %s sem saude, revertendo", versao);
+  // Só volta daqui sem uma imagem anterior para subir
+  esp_ota_mark_app_invalid_rollback_and_reboot();
+  mudar(EstadoOta::Falhou, "sem imagem anterior");
+}
+
+bool AtualizadorOta::interpretarManifesto(const char* texto, const char* versaoAtual,
+                                          ManifestoOta& manifesto) {
+  memset(&manifesto, 0, sizeof(manifesto));
+  while (*texto) {
+    const char* inicio;
+    size_t n = palavra(texto, inicio);
+    if (n == 6 && strncmp(inicio, "versao", 6) == 0) {
+      n = palavra(texto, inicio);
+      copiarTexto(manifesto.versao, sizeof(manifesto.versao), inicio, n);
+    } else if (n == 8 && strncmp(inicio, "completa", 8) == 0) {
+      n = palavra(texto, inicio);
+      copiarTexto(manifesto.completa, sizeof(manifesto.completa), inicio, n);
+    } else if (n == 5 && strncmp(inicio, "delta", 5) == 0) {
+      n = palavra(texto, inicio);
+      bool daVersaoAtual = n == strlen(versaoAtual) && strncmp(inicio, versaoAtual, n) == 0;
+      n = palavra(texto, inicio);
+      if (daVersaoAtual) {
+        copiarTexto(manifesto.delta, sizeof(manifesto.delta), inicio, n);
+      }
+    }
+    // Resto da linha (comentários, campos desconhecidos)
+    while (*texto && *texto != '\n') texto++;
+    if (*texto == '\n') texto++;
+  }
+  return manifesto.versao[0] != '\0' && manifesto.completa[0] != '\0';
+}
+
+// A versão já subiu aqui e foi descartada: continua na outra partição
+bool AtualizadorOta::versaoRevertida(const char* nova) {
+  const esp_partition_t* outra = esp_ota_get_next_update_partition(nullptr);
+  esp_ota_img_states_t situacao;
+  esp_app_desc_t descricao;
+  return esp_ota_get_state_partition(outra, &situacao) == ESP_OK &&
+         (situacao == ESP_OTA_IMG_INVALID || situacao == ESP_OTA_IMG_ABORTED) &&
+         esp_ota_get_partition_description(outra, &descricao) == ESP_OK &&
+         strncmp(descricao.version, nova, sizeof(descricao.version)) == 0;
+}
+
+bool AtualizadorOta::verificar(const String& url) {
+  if (estado == EstadoOta::Pronta || estado == EstadoOta::Reiniciando) {
+    return true;
+  }
+  String texto;
+  {
+    HTTPClient http;
+    if (!http.begin(url + "/manifesto.txt") || http.GET() != HTTP_CODE_OK) {
+      return false;  // Sem rede ou sem servidor: tenta na próxima
+    }
+    texto = http.getString();
+  }
+  ManifestoOta manifesto;
+  if (!interpretarManifesto(texto.c_str(), versao, manifesto)) {
+    LOG_AVISO(Conexao, "OTA: manifesto invalido");
+    return false;
+  }
+  if (strcmp(manifesto.versao, versao) == 0 || versaoRevertida(manifesto.versao)) {
+    return false;
+  }
+
+  copiarTexto(versaoNova, sizeof(versaoNova), manifesto.versao, sizeof(manifesto.versao));
+  LOG_INFO(Conexao, "OTA: %s -> %s", versao, versaoNova);
+  bytesBaixados = 0;
+  usouDelta = manifesto.delta[0] != '\0';
+  bool ok = false;
+  if (usouDelta) {
+    ok = baixar(url, manifesto.delta);
+    if (!ok && aplicador.getErro() == ErroDelta::Base) {
+      // A partição não tem a imagem que o manifesto diz: vai a completa
+      LOG_AVISO(Conexao, "OTA: base do delta nao confere");
+      usouDelta = false;
+    }
+  }
+  if (!usouDelta) {
+    ok = baixar(url, manifesto.completa);
+  }
+  if (!ok) {
+    return false;
+  }
+  mudar(EstadoOta::Pronta);
+  return true;
+}
+
+bool AtualizadorOta::baixar(const String& url, const char* arquivo) {
+  progresso = 0;
+  aplicador.reiniciar();
+  mudar(EstadoOta::Baixando);
+  HTTPClient http;
+  http.begin(url + "/" + arquivo);
+  int status = http.GET();
+  int total = http.getSize();
+  if (status != HTTP_CODE_OK || total <= 0) {
+    mudar(EstadoOta::Falhou, "http");
+    return false;
+  }
+
+  destino = esp_ota_get_next_update_partition(nullptr);
+  esp_ota_handle_t handle;
+  if (destino == nullptr || esp_ota_begin(destino, OTA_SIZE_UNKNOWN, &handle) != ESP_OK) {
+    mudar(EstadoOta::Falhou, "particao");
+    return false;
+  }
+  ParticoesOta particoes(esp_ota_get_running_partition(), handle);
+
+  WiFiClient* stream = http.getStreamPtr();
+  int recebidos = 0;
+  unsigned long ultimoByte = millis();
+  uint8_t avisado = 0;
+  while (recebidos < total && !aplicador.getConcluido()) {
+    int disponiveis = stream->available();
+    if (disponiveis <= 0) {
+      if (!stream->connected() || millis() - ultimoByte > OTA_TIMEOUT_LEITURA_MS) {
+        break;
+      }
+      vTaskDelay(10 / portTICK_PERIOD_MS);
+      continue;
+    }
+    int pedido = disponiveis < (int)sizeof(bloco) ? disponiveis : (int)sizeof(bloco);
+    if (pedido > total - recebidos) pedido = total - recebidos;
+    int n = stream->read(bloco, pedido);
+    if (n <= 0) {
+      break;
+    }
+    recebidos += n;
+    bytesBaixados += n;
+    ultimoByte = millis();
+    if (!aplicador.alimentar(particoes, bloco, n)) {
+      break;
+    }
+    progresso = (uint8_t)((uint64_t)recebidos * 100 / total);
+    if (progresso >= avisado + 10) {
+      avisado = progresso - progresso % 10;
+      if (aviso) aviso(*this);
+    }
+    // Os modos têm prioridade: a escrita na flash espera a vez
+    vTaskDelay(1);
+  }
+
+  if (!aplicador.getConcluido()) {
+    esp_ota_abort(handle);
+    ErroDelta motivo = aplicador.getErro();
+    mudar(EstadoOta::Falhou, motivo != ErroDelta::Nenhum ? nomeErroDelta(motivo) : "conexao");
+    return false;
+  }
+  if (esp_ota_end(handle) != ESP_OK) {
+    mudar(EstadoOta::Falhou, "imagem");
+    return false;
+  }
+  progresso = 100;
+  return true;
+}
+
+void AtualizadorOta::reiniciar() {
+  if (estado != EstadoOta::Pronta) {
+    return;
+  }
+  if (esp_ota_set_boot_partition(destino) != ESP_OK) {
+    mudar(EstadoOta::Falhou, "boot");
+    return;
+  }
+  mudar(EstadoOta::Reiniciando);
+  ESP.restart();
+}
+
+void AtualizadorOta::mudar(EstadoOta novo, const char* motivo) {
+  estado = novo;
+  erro = motivo ? motivo : "";
+  if (motivo) {
+    LOG_AVISO(Conexao, "OTA: %s (%s)", nomeEstadoOta(novo), motivo);
+  }
+  if (aviso) aviso(*this);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file Ota.h
+ * @brief Atualização OTA em segundo plano, A/B, com delta e rollback
+ *
+ * O saco tem duas partições de app (ota_0 e ota_1). A tarefaOta lê em
+ * /ota/url (no Firebase, para a frota toda) o endereço HTTP das imagens e,
+ * a cada OTA_VERIFICA_MS, o manifesto:
+ *
+ *   versao 1.1.0
+ *   completa saco-1.1.0.sdl
+ *   delta 1.0.0 saco-1.0.0-1.1.0.sdl
+ *
+ * Com uma versão diferente da que roda, baixa o delta contra a versão atual
+ * (Delta.h) ou, sem ele (ou se a base não bater), a imagem completa
+ * comprimida, e escreve a nova imagem na outra partição enquanto os modos
+ * seguem funcionando. O reinício só acontece com o saco livre (Inicial ou
+ * Ocioso) e leva o tempo de um boot.
+ *
+ * A imagem nova sobe à prova (PENDING_VERIFY): se em OTA_PRAZO_SAUDE_MS os
+ * sensores e o registro no Firebase não ficarem prontos, ela é marcada
+ * inválida e o saco volta para a anterior. Um reinício antes da
+ * confirmação faz o bootloader voltar sozinho. Uma versão revertida não é
+ * baixada de novo.
+ *
+ * O estado vai para /devices/<id>/ota.
+ */
+#ifndef OTA_H
+#define OTA_H
+
+#include <Arduino.h>
+#include <esp_ota_ops.h>
+#include "Delta.h"
+
+#ifndef OTA_VERIFICA_MS
+#define OTA_VERIFICA_MS (60 * 60 * 1000UL)
+#endif
+#ifndef OTA_PRAZO_SAUDE_MS
+#define OTA_PRAZO_SAUDE_MS 60000
+#endif
+#define OTA_TIMEOUT_LEITURA_MS 15000  // Sem nenhum byte do servidor
+#define OTA_BLOCO 1024                // Leitura do HTTP
+#define OTA_TAMANHO_NOME 64
+
+enum class EstadoOta : uint8_t {
+  Atualizada,   // Nada a fazer
+  Baixando,
+  Pronta,       // Imagem nova na outra partição, esperando o saco ficar livre
+  Reiniciando,
+  Verificando,  // A imagem que subiu está à prova
+  Confirmada,
+  Revertida,
+  Falhou
+};
+
+const char* nomeEstadoOta(EstadoOta estado);
+
+struct ManifestoOta {
+  char versao[32];
+  char completa[OTA_TAMANHO_NOME];
+  char delta[OTA_TAMANHO_NOME];  // Vazio: nenhum delta contra a versão que roda
+};
+
+class AtualizadorOta;
+// Chamado a cada mudança de estado e a cada 10% do download
+typedef void (*AvisoOta)(const AtualizadorOta& ota);
+
+class AtualizadorOta {
+public:
+  AtualizadorOta();
+
+  // No começo da tarefa: versão que roda e se ela está à prova ou voltou
+  // de um rollback
+  void iniciar(AvisoOta aviso = nullptr);
+
+  bool pendenteVerificacao() const { return estado == EstadoOta::Verificando; }
+  // Saudável: confirma a imagem. Senão, marca inválida e reinicia na
+  // anterior (só volta se não houver anterior)
+  void confirmar(bool saudavel);
+
+  // Lê o manifesto em url e, se houver versão nova, baixa e grava. true com
+  // a imagem pronta para o próximo boot
+  bool verificar(const String& url);
+
+  // Com o estado Pronta: aponta o boot e reinicia
+  void reiniciar();
+
+  static bool interpretarManifesto(const char* texto, const char* versaoAtual,
+                                   ManifestoOta& manifesto);
+
+  EstadoOta getEstado() const { return estado; }
+  const char* getVersao() const { return versao; }            // A que roda
+  const char* getVersaoNova() const { return versaoNova; }    // Baixada, confirmada ou revertida
+  uint8_t getProgresso() const { return progresso; }          // 0 a 100
+  const char* getErro() const { return erro; }
+  bool getUsouDelta() const { return usouDelta; }
+  uint32_t getBytesBaixados() const { return bytesBaixados; }
+
+private:
+  AvisoOta aviso;
+  EstadoOta estado;
+  char versao[32];
+  char versaoNova[32];
+  const char* erro;
+  uint8_t progresso;
+  bool usouDelta;
+  uint32_t bytesBaixados;
+  const esp_partition_t* destino;
+
+  AplicadorDelta aplicador;  // Janela de 4 KB: fora da pilha da tarefa
+  uint8_t bloco[OTA_BLOCO];
+
+  bool versaoRevertida(const char* nova);
+  bool baixar(const String& url, const char* arquivo);
+  void mudar(EstadoOta novo, const char* motivo = nullptr);
+};
+
+extern AtualizadorOta atualizadorOta;
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file Placas.cpp
+ * @brief Definições dos membros static constexpr dos descritores
+ *
+ * Até o C++14 um membro static constexpr usado por endereço ou referência
+ * (um vetor indexado em tempo de execução, um argumento const&) precisa de
+ * uma definição fora da classe, em uma única unidade de compilação. No
+ * C++17 eles já são inline e isto não é compilado (o build do host).
+ */
+#include "Placas.h"
+
+#if __cplusplus < 201703L
+#define DEFINIR_PLACA(Placa)                            \
+  constexpr const char* Placa::NOME;                    \
+  constexpr uint8_t Placa::NUM_PADS;                    \
+  constexpr bool Placa::TEM_IMU;                        \
+  constexpr uint8_t Placa::PAD_CENTRO;                  \
+  constexpr uint8_t Placa::pinos[Placa::NUM_PADS];      \
+  constexpr const char* Placa::nomes[Placa::NUM_PADS];  \
+  constexpr int Placa::limites[Placa::NUM_PADS];        \
+  constexpr float Placa::posicoes[Placa::NUM_PADS][3];  \
+  constexpr int16_t Placa::setas[Placa::NUM_PADS];
+
+DEFINIR_PLACA(PlacaSaco)
+DEFINIR_PLACA(PlacaVelocidade)
+DEFINIR_PLACA(PlacaBoneco)
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file Placas.h
+ * @brief Descritores das variantes do saco, escolhidos na compilação
+ *
+ * Cada placa é um struct só com constantes: número de pads, pinos de toque,
+ * nomes, limites iniciais, posição de cada pad (para o Classificador), a
+ * seta do display que aponta para ele e se há MPU6500. O Sensores é um
+ * template sobre o descritor (SensoresPlaca<Placa>), então os laços correm
+ * sobre vetores de tamanho fixo e as tabelas ficam em .rodata (flash).
+ *
+ * PLACA escolhe a variante do firmware (padrão: o saco de 9 pads). Cada
+ * variante é um build separado; no Arduino, -DPLACA=PLACA_VELOCIDADE no
+ * build_opt.h do sketch.
+ *
+ * O core compila em gnu++11: os membros static constexpr usados em tempo
+ * de execução (pinos[i], NOME num log) têm a definição em Placas.cpp.
+ */
+#ifndef PLACAS_H
+#define PLACAS_H
+
+#include <Arduino.h>
+
+#define PLACA_SACO 0         // Saco de pancada, 9 pads
+#define PLACA_VELOCIDADE 1   // Saco de velocidade (speed bag), 5 pads
+#define PLACA_BONECO 2       // Boneco de pé, 12 pads, sem MPU
+
+#ifndef PLACA
+#define PLACA PLACA_SACO
+#endif
+
+#define SETA_CENTRO -1       // Em setas[]: setaCentro() em vez de um ângulo
+
+struct PlacaSaco {
+  static constexpr const char* NOME = "saco";
+  static constexpr uint8_t NUM_PADS = 9;
+  static constexpr bool TEM_IMU = true;
+  static constexpr uint8_t PAD_CENTRO = 8;
+  static constexpr uint8_t pinos[NUM_PADS] = {T8, T6, T7, T10, T1, T5, T4, T2, T3};
+  static constexpr const char* nomes[NUM_PADS] = {
+    "FrenteAlta", "FrenteBaixa", "DireitaBaixa",
+    "DireitaAlta", "EsquerdaBaixa", "EsquerdaAlta",
+    "TrasAlta", "TrasBaixa", "Centro"
+  };
+  static constexpr int limites[NUM_PADS] = {20000, 15000, 20000, 15000, 20000, 7000, 20000, 20000, 20000};
+  static constexpr float posicoes[NUM_PADS][3] = {
+    {-1, 0, 1},  {-1, 0, -1}, {0, 1, -1},
+    {0, 1, 1},   {0, -1, -1}, {0, -1, 1},
+    {1, 0, 1},   {1, 0, -1},  {-1, 0, 0}   // Centro (da face da frente)
+  };
+  static constexpr int16_t setas[NUM_PADS] = {0, 45, 90, 135, 180, 225, 270, 315, SETA_CENTRO};
+};
+
+// Pads em volta da gota; T8/T9 ficam para o I2C
+struct PlacaVelocidade {
+  static constexpr const char* NOME = "velocidade";
+  static constexpr uint8_t NUM_PADS = 5;
+  static constexpr bool TEM_IMU = true;
+  static constexpr uint8_t PAD_CENTRO = 0;
+  static constexpr uint8_t pinos[NUM_PADS] = {T1, T2, T3, T4, T5};
+  static constexpr const char* nomes[NUM_PADS] = {
+    "Frente", "Direita", "Tras", "Esquerda", "Base"
+  };
+  static constexpr int limites[NUM_PADS] = {15000, 15000, 15000, 15000, 20000};
+  static constexpr float posicoes[NUM_PADS][3] = {
+    {-1, 0, 0}, {0, 1, 0}, {1, 0, 0}, {0, -1, 0}, {0, 0, -1}
+  };
+  static constexpr int16_t setas[NUM_PADS] = {0, 90, 180, 270, SETA_CENTRO};
+};
+
+// Sem MPU6500: o boneco é pesado demais para a força pela aceleração
+struct PlacaBoneco {
+  static constexpr const char* NOME = "boneco";
+  static constexpr uint8_t NUM_PADS = 12;
+  static constexpr bool TEM_IMU = false;
+  static constexpr uint8_t PAD_CENTRO = 9;
+  static constexpr uint8_t pinos[NUM_PADS] = {T1, T2, T3, T4, T5, T6, T7, T10, T11, T12, T13, T14};
+  static constexpr const char* nomes[NUM_PADS] = {
+    "Testa", "Queixo", "TemporaDireita", "TemporaEsquerda",
+    "PeitoDireito", "PeitoEsquerdo", "CostelaDireita", "CostelaEsquerda",
+    "Figado", "Estomago", "CoxaDireita", "CoxaEsquerda"
+  };
+  static constexpr int limites[NUM_PADS] = {
+    15000, 15000, 15000, 15000, 20000, 20000, 20000, 20000, 20000, 20000, 15000, 15000
+  };
+  static constexpr float posicoes[NUM_PADS][3] = {
+    {-1, 0, 1},      {-1, 0, 0.7f},    {-0.7f, 0.7f, 1}, {-0.7f, -0.7f, 1},
+    {-1, 0.5f, 0.3f}, {-1, -0.5f, 0.3f}, {0, 1, 0},       {0, -1, 0},
+    {-0.7f, 0.7f, -0.2f}, {-1, 0, -0.2f}, {-1, 0.5f, -1},  {-1, -0.5f, -1}
+  };
+  static constexpr int16_t setas[NUM_PADS] = {
+    SETA_CENTRO, SETA_CENTRO, 45, 315, 45, 315, 90, 270, 90, SETA_CENTRO, 135, 225
+  };
+};
+
+#if PLACA == PLACA_SACO
+using PlacaAtual = PlacaSaco;
+#elif PLACA == PLACA_VELOCIDADE
+using PlacaAtual = PlacaVelocidade;
+#elif PLACA == PLACA_BONECO
+using PlacaAtual = PlacaBoneco;
+#else
+#error "PLACA inválida"
+#endif
+
+namespace placas {
+
+// Um pino de toque por pad: nenhum repetido. Recursivo, como o constexpr
+// do C++11 pede (um único return)
+template <class Placa>
+constexpr bool pinoRepetido(uint8_t i, uint8_t j) {
+  return j < Placa::NUM_PADS &&
+         (Placa::pinos[i] == Placa::pinos[j] || pinoRepetido<Placa>(i, j + 1));
+}
+
+template <class Placa>
+constexpr bool pinosDistintos(uint8_t i = 0) {
+  return i >= Placa::NUM_PADS ||
+         (!pinoRepetido<Placa>(i, i + 1) && pinosDistintos<Placa>(i + 1));
+}
+
+}  // namespace placas
+
+static_assert(placas::pinosDistintos<PlacaSaco>(), "PlacaSaco: pino de toque repetido");
+static_assert(placas::pinosDistintos<PlacaVelocidade>(), "PlacaVelocidade: pino de toque repetido");
+static_assert(placas::pinosDistintos<PlacaBoneco>(), "PlacaBoneco: pino de toque repetido");
+static_assert(PlacaAtual::PAD_CENTRO < PlacaAtual::NUM_PADS, "PAD_CENTRO fora da placa");
+
+#endif
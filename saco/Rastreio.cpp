@@ -0,0 +1,237 @@
+/**
+ * @file Rastreio.cpp
+ * @brief Anel de eventos, prazos e exportação no formato de eventos do Chrome
+ */
+#include "Rastreio.h"
+#include <string.h>
+
+Rastreio rastreio;
+
+extern "C" void rastreioTarefaEntrou(void) {
+  rastreio.registrar(TipoEvento::Entrou, "CPU");
+}
+
+extern "C" void rastreioTarefaSaiu(void) {
+  rastreio.registrar(TipoEvento::Saiu, "CPU");
+}
+
+PrazoRastreio::PrazoRastreio(const char* nome, uint32_t periodoUs, uint32_t toleranciaUs)
+  : nome(nome), periodoUs(periodoUs), toleranciaUs(toleranciaUs), ultimoUs(0), armado(false),
+    registrado(false), voltas(0), perdas(0), piorAtrasoUs(0) {}
+
+PrazoRastreio::~PrazoRastreio() {
+  if (registrado) {
+    rastreio.removerPrazo(this);
+  }
+}
+
+void PrazoRastreio::iniciar() {
+  // Registrado no primeiro uso: os prazos costumam ser estáticos de outros
+  // arquivos, sem ordem garantida de construção
+  if (!registrado) {
+    registrado = true;
+    rastreio.adicionarPrazo(this);
+  }
+  armado = false;
+}
+
+void PrazoRastreio::marcar() {
+  uint32_t agora = micros();
+  if (armado) {
+    uint32_t intervalo = agora - ultimoUs;
+    voltas++;
+    if (intervalo > periodoUs + toleranciaUs) {
+      uint32_t atraso = intervalo - periodoUs;
+      perdas++;
+      if (atraso > piorAtrasoUs) {
+        piorAtrasoUs = atraso;
+      }
+      rastreio.registrar(TipoEvento::PrazoPerdido, nome, atraso);
+    }
+  }
+  ultimoUs = agora;
+  armado = true;
+}
+
+void PrazoRastreio::zerar() {
+  voltas = 0;
+  perdas = 0;
+  piorAtrasoUs = 0;
+}
+
+void Rastreio::adicionarPrazo(PrazoRastreio* prazo) {
+  // A primeira posição vaga, nova ou de um prazo já destruído
+  for (uint32_t indice = 0; indice < RASTREIO_MAX_PRAZOS; indice++) {
+    PrazoRastreio* vaga = nullptr;
+    if (__atomic_compare_exchange_n(&prazos[indice], &vaga, prazo, false, __ATOMIC_RELEASE,
+                                    __ATOMIC_RELAXED)) {
+      uint32_t numero = __atomic_load_n(&numPrazos, __ATOMIC_RELAXED);
+      while (numero < indice + 1 &&
+             !__atomic_compare_exchange_n(&numPrazos, &numero, indice + 1, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      }
+      return;
+    }
+  }
+  Serial.printf("Rastreio: prazo %s além de RASTREIO_MAX_PRAZOS\n", prazo->getNome());
+}
+
+void Rastreio::removerPrazo(PrazoRastreio* prazo) {
+  for (int indice = 0; indice < getNumPrazos(); indice++) {
+    PrazoRastreio* esperado = prazo;
+    if (__atomic_compare_exchange_n(&prazos[indice], &esperado, nullptr, false,
+                                    __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+      return;
+    }
+  }
+}
+
+int Rastreio::getNumPrazos() const {
+  uint32_t numero = __atomic_load_n(&numPrazos, __ATOMIC_RELAXED);
+  return numero < RASTREIO_MAX_PRAZOS ? (int)numero : RASTREIO_MAX_PRAZOS;
+}
+
+const PrazoRastreio* Rastreio::getPrazo(int indice) const {
+  if (indice < 0 || indice >= getNumPrazos()) {
+    return nullptr;
+  }
+  return __atomic_load_n(&prazos[indice], __ATOMIC_ACQUIRE);
+}
+
+void Rastreio::limpar() {
+  __atomic_store_n(&gravados, 0, __ATOMIC_RELAXED);
+}
+
+uint32_t Rastreio::getSobrescritos() const {
+  uint32_t total = getGravados();
+  return total > RASTREIO_CAPACIDADE ? total - RASTREIO_CAPACIDADE : 0;
+}
+
+// Nomes de tarefas e trechos são literais simples, mas o JSON tem que fechar
+static void escreverTexto(Print& saida, const char* texto) {
+  saida.print('"');
+  for (const char* p = texto ? texto : ""; *p; p++) {
+    if (*p == '"' || *p == '\\') {
+      saida.print('\\');
+    }
+    saida.print((unsigned char)*p < 0x20 ? ' ' : *p);
+  }
+  saida.print('"');
+}
+
+// As tarefas podem estar gravando por cima (ver Rastreio::registrar)
+static EventoRastreio lerEvento(const EventoRastreio& origem) {
+  EventoRastreio evento;
+  evento.tempoUs = __atomic_load_n(&origem.tempoUs, __ATOMIC_RELAXED);
+  evento.tipo = __atomic_load_n(&origem.tipo, __ATOMIC_RELAXED);
+  evento.valor = __atomic_load_n(&origem.valor, __ATOMIC_RELAXED);
+  evento.nome = __atomic_load_n(&origem.nome, __ATOMIC_RELAXED);
+  evento.tarefa = __atomic_load_n(&origem.tarefa, __ATOMIC_RELAXED);
+  return evento;
+}
+
+size_t Rastreio::exportarChrome(Print& saida) {
+  bool estavaAtivo = getAtivo();
+  ativar(false);
+
+  uint32_t total = getGravados();
+  uint32_t quantidade = total < RASTREIO_CAPACIDADE ? total : RASTREIO_CAPACIDADE;
+  uint32_t primeiro = total - quantidade;
+  uint32_t origemUs = quantidade ? lerEvento(eventos[primeiro & (RASTREIO_CAPACIDADE - 1)]).tempoUs : 0;
+
+  // Uma linha (tid) por tarefa e outra, tid + RASTREIO_MAX_TAREFAS, para a CPU
+  const char* tarefas[RASTREIO_MAX_TAREFAS];
+  int numTarefas = 0;
+  auto linhaDaTarefa = [&](const char* tarefa) -> int {
+    for (int i = 0; i < numTarefas; i++) {
+      if (tarefas[i] == tarefa || strcmp(tarefas[i], tarefa) == 0) {
+        return i + 1;
+      }
+    }
+    if (numTarefas == RASTREIO_MAX_TAREFAS) {
+      return RASTREIO_MAX_TAREFAS;  // As que sobram dividem a última linha
+    }
+    tarefas[numTarefas++] = tarefa;
+    return numTarefas;
+  };
+
+  saida.print("{\"traceEvents\":[\n");
+  saida.print("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"saco\"}}");
+  size_t escritos = 0;
+  for (uint32_t i = primeiro; i != total; i++) {
+    EventoRastreio evento = lerEvento(eventos[i & (RASTREIO_CAPACIDADE - 1)]);
+    int tid = linhaDaTarefa(evento.tarefa ? evento.tarefa : "?");
+    const char* fase;
+    switch (evento.tipo) {
+      case TipoEvento::Inicio:
+      case TipoEvento::Entrou:       fase = "B"; break;
+      case TipoEvento::Fim:
+      case TipoEvento::Saiu:         fase = "E"; break;
+      default:                       fase = "i"; break;
+    }
+    if (evento.tipo == TipoEvento::Entrou || evento.tipo == TipoEvento::Saiu) {
+      tid += RASTREIO_MAX_TAREFAS;
+    }
+
+    saida.print(",\n{\"name\":");
+    if (evento.tipo == TipoEvento::PrazoPerdido) {
+      saida.print("\"prazo perdido: ");
+      saida.print(evento.nome ? evento.nome : "?");
+      saida.print('"');
+    } else {
+      escreverTexto(saida, evento.nome);
+    }
+    saida.printf(",\"ph\":\"%s\",\"ts\":%lu,\"pid\":1,\"tid\":%d", fase,
+                 (unsigned long)(evento.tempoUs - origemUs), tid);
+    if (fase[0] == 'i') {
+      saida.print(",\"s\":\"t\"");
+    }
+    if (evento.tipo == TipoEvento::PrazoPerdido) {
+      saida.printf(",\"args\":{\"atrasoUs\":%lu}", (unsigned long)evento.valor);
+    }
+    saida.print('}');
+    escritos++;
+  }
+
+  for (int i = 0; i < numTarefas; i++) {
+    saida.printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", i + 1);
+    escreverTexto(saida, tarefas[i]);
+    saida.printf("}},\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                 i + 1 + RASTREIO_MAX_TAREFAS);
+    saida.print('"');
+    saida.print(tarefas[i]);
+    saida.print(" (CPU)\"}}");
+  }
+
+  // Os contadores dos prazos vão junto, em otherData
+  saida.printf("\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"sobrescritos\":\"%lu\"",
+               (unsigned long)getSobrescritos());
+  for (int i = 0; i < getNumPrazos(); i++) {
+    const PrazoRastreio* prazo = getPrazo(i);
+    if (prazo == nullptr) {
+      continue;
+    }
+    saida.print(",\"prazo.");
+    saida.print(prazo->getNome());
+    saida.printf("\":\"periodoUs=%lu voltas=%lu perdas=%lu piorAtrasoUs=%lu\"",
+                 (unsigned long)prazo->getPeriodoUs(), (unsigned long)prazo->getVoltas(),
+                 (unsigned long)prazo->getPerdas(), (unsigned long)prazo->getPiorAtrasoUs());
+  }
+  saida.print("}}\n");
+
+  ativar(estavaAtivo);
+  return escritos;
+}
+
+void Rastreio::relatorioPrazos(Print& saida) const {
+  for (int i = 0; i < getNumPrazos(); i++) {
+    const PrazoRastreio* prazo = getPrazo(i);
+    if (prazo == nullptr) {
+      continue;
+    }
+    saida.printf("Prazo %-16s %6lu us: %lu voltas, %lu perdidos, pior atraso %lu us\n",
+                 prazo->getNome(), (unsigned long)prazo->getPeriodoUs(),
+                 (unsigned long)prazo->getVoltas(), (unsigned long)prazo->getPerdas(),
+                 (unsigned long)prazo->getPiorAtrasoUs());
+  }
+}
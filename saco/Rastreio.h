@@ -0,0 +1,158 @@
+/**
+ * @file Rastreio.h
+ * @brief Pontos de rastreio, prazos dos laços de amostragem e exportação para o Perfetto
+ *
+ * Para saber por que um tempo de reação saiu estranho: as tarefas de modo,
+ * o ConexaoManager e o SetaDisplay marcam trechos (RASTREIO_TRECHO), os
+ * laços de amostragem declaram o período (PrazoRastreio) e a troca de
+ * tarefa do FreeRTOS entra pelos ganchos rastreioTarefaEntrou/Saiu. Tudo
+ * vai para um anel fixo na RAM, que guarda os RASTREIO_CAPACIDADE eventos
+ * mais recentes; gravar um evento é um incremento atômico e quatro stores.
+ *
+ * exportarChrome() escreve o anel no formato de eventos do Chrome (JSON),
+ * que abre no Perfetto (ui.perfetto.dev) ou no chrome://tracing: uma linha
+ * por tarefa com os trechos e os prazos perdidos, e outra com os intervalos
+ * em que a tarefa estava na CPU. No saco, "r" na Serial exporta e "p"
+ * lista os prazos; no host os testes de modo exportam para o arquivo em
+ * SACO_RASTREIO.
+ *
+ * @section trocas Troca de tarefa
+ * O FreeRTOS do Arduino vem compilado, então os ganchos só entram num build
+ * com o ESP-IDF (Arduino como componente), no FreeRTOSConfig:
+ *
+ *   #define traceTASK_SWITCHED_IN() rastreioTarefaEntrou()
+ *   #define traceTASK_SWITCHED_OUT() rastreioTarefaSaiu()
+ *
+ * No host o FreeRTOS simulado chama os mesmos ganchos quando uma tarefa vai
+ * esperar e quando volta (simulacao::definirGanchosTarefa).
+ */
+#ifndef RASTREIO_H
+#define RASTREIO_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define RASTREIO_CAPACIDADE 1024   // Eventos no anel (potência de 2)
+#define RASTREIO_MAX_PRAZOS 8
+#define RASTREIO_MAX_TAREFAS 24    // Linhas distintas na exportação
+
+static_assert((RASTREIO_CAPACIDADE & (RASTREIO_CAPACIDADE - 1)) == 0,
+              "RASTREIO_CAPACIDADE deve ser potência de 2");
+
+enum class TipoEvento : uint8_t {
+  Inicio,         // De um trecho
+  Fim,
+  Instante,
+  Entrou,         // A tarefa ganhou a CPU
+  Saiu,
+  PrazoPerdido    // valor = atraso além do período, em us
+};
+
+struct EventoRastreio {
+  uint32_t tempoUs;
+  TipoEvento tipo;
+  uint32_t valor;
+  const char* nome;      // Literal do trecho ou nome do prazo
+  const char* tarefa;    // pcTaskGetName() de quem gravou
+};
+
+// Período declarado de um laço de amostragem: cada volta chama marcar(), e
+// um intervalo maior que periodo + tolerância conta como prazo perdido. Um
+// prazo por laço (e por dono): dois laços no mesmo misturam as voltas.
+// Destruído, sai da lista do rastreio
+class PrazoRastreio {
+public:
+  PrazoRastreio(const char* nome, uint32_t periodoUs, uint32_t toleranciaUs);
+  ~PrazoRastreio();
+  PrazoRastreio(const PrazoRastreio&) = delete;
+  PrazoRastreio& operator=(const PrazoRastreio&) = delete;
+
+  // Antes do laço: o intervalo até a primeira volta não conta
+  void iniciar();
+  void marcar();
+
+  const char* getNome() const { return nome; }
+  uint32_t getPeriodoUs() const { return periodoUs; }
+  uint32_t getVoltas() const { return voltas; }
+  uint32_t getPerdas() const { return perdas; }
+  uint32_t getPiorAtrasoUs() const { return piorAtrasoUs; }
+  void zerar();
+
+private:
+  const char* nome;
+  uint32_t periodoUs;
+  uint32_t toleranciaUs;
+  uint32_t ultimoUs;
+  bool armado;
+  bool registrado;
+  uint32_t voltas;
+  uint32_t perdas;
+  uint32_t piorAtrasoUs;
+};
+
+class Rastreio {
+public:
+  // Desligado, registrar() volta sem gravar
+  void ativar(bool ligado) { __atomic_store_n(&ativo, ligado, __ATOMIC_RELAXED); }
+  bool getAtivo() const { return __atomic_load_n(&ativo, __ATOMIC_RELAXED); }
+
+  void registrar(TipoEvento tipo, const char* nome, uint32_t valor = 0) {
+    if (!getAtivo()) {
+      return;
+    }
+    uint32_t indice = __atomic_fetch_add(&gravados, 1, __ATOMIC_RELAXED);
+    EventoRastreio& evento = eventos[indice & (RASTREIO_CAPACIDADE - 1)];
+    // Campo a campo: numa volta do anel durante a exportação o evento pode
+    // sair misturado com o seguinte, mas nenhum campo sai pela metade
+    __atomic_store_n(&evento.tempoUs, (uint32_t)micros(), __ATOMIC_RELAXED);
+    __atomic_store_n(&evento.tipo, tipo, __ATOMIC_RELAXED);
+    __atomic_store_n(&evento.valor, valor, __ATOMIC_RELAXED);
+    __atomic_store_n(&evento.nome, nome, __ATOMIC_RELAXED);
+    __atomic_store_n(&evento.tarefa, pcTaskGetName(NULL), __ATOMIC_RELAXED);
+  }
+
+  void adicionarPrazo(PrazoRastreio* prazo);
+  void removerPrazo(PrazoRastreio* prazo);
+  int getNumPrazos() const;
+  // nullptr numa posição vaga (o prazo dali já foi destruído)
+  const PrazoRastreio* getPrazo(int indice) const;
+
+  void limpar();
+  uint32_t getGravados() const { return __atomic_load_n(&gravados, __ATOMIC_RELAXED); }
+  uint32_t getSobrescritos() const;
+
+  // Pausa a gravação enquanto lê o anel; devolve o número de eventos escritos
+  size_t exportarChrome(Print& saida);
+  void relatorioPrazos(Print& saida) const;
+
+private:
+  // Sem construtor: zerado (e desligado) antes de qualquer construtor global
+  EventoRastreio eventos[RASTREIO_CAPACIDADE];
+  uint32_t gravados;
+  bool ativo;
+  PrazoRastreio* prazos[RASTREIO_MAX_PRAZOS];
+  uint32_t numPrazos;   // Maior posição já ocupada + 1
+};
+
+extern Rastreio rastreio;
+
+// Trecho do início até o fim do escopo
+class TrechoRastreio {
+public:
+  explicit TrechoRastreio(const char* nome) : nome(nome) { rastreio.registrar(TipoEvento::Inicio, nome); }
+  ~TrechoRastreio() { rastreio.registrar(TipoEvento::Fim, nome); }
+
+private:
+  const char* nome;
+};
+
+#define RASTREIO_JUNTAR_(a, b) a##b
+#define RASTREIO_JUNTAR(a, b) RASTREIO_JUNTAR_(a, b)
+#define RASTREIO_TRECHO(nome) TrechoRastreio RASTREIO_JUNTAR(trechoRastreio, __LINE__)(nome)
+#define RASTREIO_INSTANTE(nome) rastreio.registrar(TipoEvento::Instante, nome)
+
+extern "C" void rastreioTarefaEntrou(void);
+extern "C" void rastreioTarefaSaiu(void);
+
+#endif
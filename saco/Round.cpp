@@ -0,0 +1,138 @@
+/**
+ * @file Round.cpp
+ * @brief Implementação da segmentação de golpes e dos baldes do round
+ */
+#include "Round.h"
+#include <math.h>
+#include <string.h>
+
+void SegmentadorGolpes::reiniciar() {
+  // Parado, o MPU mede 1 g em qualquer inclinação; começar da primeira
+  // amostra prenderia o repouso num golpe em andamento
+  repousoG = 1.0f;
+  ativo = false;
+  abaixo = false;
+  abaixoDesdeMs = 0;
+  padsAtivos = 0;
+  ultimoPad = -1;
+  ultimoPadMs = 0;
+  ultimoPadUsado = true;
+}
+
+bool SegmentadorGolpes::adicionarIMU(uint32_t tempoMs, const xyzFloat& a, GolpeSegmentado& golpe) {
+  float resultante = sqrtf(a.x * a.x + a.y * a.y + a.z * a.z);
+  float desvio = fabsf(resultante - repousoG);
+
+  if (!ativo) {
+    if (desvio <= SEGMENTO_LIMIAR_G) {
+      repousoG += SEGMENTO_ALFA_REPOUSO * (resultante - repousoG);
+      return false;
+    }
+    ativo = true;
+    abaixo = false;
+    atual.inicioMs = tempoMs;
+    atual.picoG = desvio;
+    atual.pad = -1;
+    atual.tipo = TipoGolpe::Desconhecido;
+    // Toque um pouco antes do impacto (o pad é mais rápido que o MPU)
+    if (!ultimoPadUsado && tempoMs - ultimoPadMs <= SEGMENTO_JANELA_PAD_MS) {
+      atual.pad = ultimoPad;
+      ultimoPadUsado = true;
+    }
+    return false;
+  }
+
+  if (desvio > atual.picoG) {
+    atual.picoG = desvio;
+  }
+  // Longo demais para um golpe: o repouso mudou (saco balançando, MPU
+  // saturado). Descarta e recomeça do valor atual
+  if (tempoMs - atual.inicioMs > SEGMENTO_MAX_MS) {
+    ativo = false;
+    repousoG = resultante;
+    return false;
+  }
+  if (desvio >= SEGMENTO_FIM_G) {
+    abaixo = false;
+    return false;
+  }
+  if (!abaixo) {
+    abaixo = true;
+    abaixoDesdeMs = tempoMs;
+  }
+  if (tempoMs - abaixoDesdeMs < SEGMENTO_SILENCIO_MS) {
+    return false;
+  }
+
+  ativo = false;
+  atual.duracaoMs = abaixoDesdeMs - atual.inicioMs;
+  golpe = atual;
+  return true;
+}
+
+void SegmentadorGolpes::adicionarToques(uint32_t tempoMs, const uint16_t valores[NUM_SENSORES],
+                                        const int limites[NUM_SENSORES]) {
+  uint16_t agora = 0;
+  for (int i = 0; i < NUM_SENSORES; i++) {
+    if (valores[i] > limites[i]) {
+      agora |= (1 << i);
+    }
+  }
+  uint16_t subidas = agora & ~padsAtivos;
+  padsAtivos = agora;
+  if (!subidas) {
+    return;
+  }
+
+  int pad = 0;
+  while (!(subidas & (1 << pad))) {
+    pad++;
+  }
+  if (ativo && atual.pad < 0) {
+    atual.pad = pad;
+  } else {
+    ultimoPad = pad;
+    ultimoPadMs = tempoMs;
+    ultimoPadUsado = false;
+  }
+}
+
+void RegistroRound::iniciar(uint16_t n, uint16_t duracaoS, uint32_t inicio, unsigned long epoch) {
+  numero = n;
+  segundos = duracaoS > ROUND_MAX_S ? ROUND_MAX_S : duracaoS;
+  inicioMs = inicio;
+  inicioEpoch = epoch;
+  golpes = 0;
+  somaG = 0;
+  picoG = 0;
+  memset(porTipo, 0, sizeof(porTipo));
+  memset(baldes, 0, sizeof(baldes));
+}
+
+void RegistroRound::registrar(const GolpeSegmentado& golpe) {
+  uint32_t segundo = (golpe.inicioMs - inicioMs) / 1000;
+  if (segundo >= segundos) {
+    return;
+  }
+  BaldeRound& b = baldes[segundo];
+  b.golpes++;
+  b.somaG += golpe.picoG;
+  if (golpe.picoG > b.picoG) b.picoG = golpe.picoG;
+  if (golpe.pad >= 0 && b.porPad[golpe.pad] < 255) {
+    b.porPad[golpe.pad]++;
+  }
+  if (golpe.tipo < TipoGolpe::Desconhecido) {
+    porTipo[(int)golpe.tipo]++;
+  }
+  golpes++;
+  somaG += golpe.picoG;
+  if (golpe.picoG > picoG) picoG = golpe.picoG;
+}
+
+uint32_t RegistroRound::getGolpesPad(int pad) const {
+  uint32_t total = 0;
+  for (uint16_t s = 0; s < segundos; s++) {
+    total += baldes[s].porPad[pad];
+  }
+  return total;
+}
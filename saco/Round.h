@@ -0,0 +1,111 @@
+/**
+ * @file Round.h
+ * @brief Segmentação contínua de golpes e agregação por segundo do modo round
+ *
+ * No modo round (ex.: 3 min de luta, 1 min de descanso) o saco conta todos
+ * os golpes em tempo real, sem voltar ao estado inicial entre eles:
+ *
+ * - SegmentadorGolpes: detector de início sobre a aceleração a 1 kHz. Um
+ *   golpe começa quando a resultante se afasta do repouso mais que
+ *   SEGMENTO_LIMIAR_G e termina depois de SEGMENTO_SILENCIO_MS abaixo de
+ *   SEGMENTO_FIM_G (histerese). As bordas de subida dos pads, lidas a cada
+ *   10 ms, atribuem o pad ao golpe. A 1 kHz o segmentador separa golpes a
+ *   menos de 50 ms um do outro: 5 golpes por segundo ficam bem folgados.
+ * - RegistroRound: baldes de 1 s no próprio saco (golpes, intensidade média
+ *   e de pico, distribuição por pad) e a contagem por tipo de golpe
+ *   (Classificador.h). Cada round gera um único registro no Firebase, em
+ *   vez de uma escrita por golpe.
+ */
+#ifndef ROUND_H
+#define ROUND_H
+
+#include <Arduino.h>
+#include "Sensores.h"
+#include "Classificador.h"
+
+#define ROUND_DURACAO_PADRAO_S 180
+#define ROUND_DESCANSO_PADRAO_S 60
+#define ROUND_NUM_PADRAO 3
+#define ROUND_MAX_S 600                // Baldes alocados por round
+#define ROUND_PERIODO_TOQUE_MS 10
+
+#define SEGMENTO_LIMIAR_G 1.5f         // Início do golpe (desvio do repouso)
+#define SEGMENTO_FIM_G 0.75f           // Abaixo disso o golpe pode acabar
+#define SEGMENTO_SILENCIO_MS 25        // Tempo abaixo de SEGMENTO_FIM_G para encerrar
+#define SEGMENTO_JANELA_PAD_MS 50      // Toque até 50 ms antes do início ainda conta
+#define SEGMENTO_MAX_MS 500            // Acima disso não é golpe: o repouso mudou
+#define SEGMENTO_ALFA_REPOUSO 0.01f
+
+struct GolpeSegmentado {
+  uint32_t inicioMs;
+  uint16_t duracaoMs;
+  float picoG;    // Maior desvio da resultante em relação ao repouso
+  int8_t pad;     // -1: nenhum pad tocado
+  TipoGolpe tipo; // Preenchido pelo classificador, fora do segmentador
+};
+
+class SegmentadorGolpes {
+public:
+  SegmentadorGolpes() { reiniciar(); }
+
+  void reiniciar();
+
+  // Uma amostra do MPU; true quando um golpe terminou (preenche `golpe`)
+  bool adicionarIMU(uint32_t tempoMs, const xyzFloat& aceleracao, GolpeSegmentado& golpe);
+
+  // Leitura dos pads; detecta as bordas de subida em relação aos limites
+  void adicionarToques(uint32_t tempoMs, const uint16_t valores[NUM_SENSORES],
+                       const int limites[NUM_SENSORES]);
+
+  bool emGolpe() const { return ativo; }
+  float getRepousoG() const { return repousoG; }
+
+private:
+  float repousoG;
+
+  bool ativo;
+  GolpeSegmentado atual;
+  uint32_t abaixoDesdeMs;
+  bool abaixo;
+
+  uint16_t padsAtivos;         // Bit por pad acima do limite na última leitura
+  int8_t ultimoPad;
+  uint32_t ultimoPadMs;
+  bool ultimoPadUsado;
+};
+
+struct BaldeRound {
+  uint16_t golpes;
+  float somaG;
+  float picoG;
+  uint8_t porPad[NUM_SENSORES];
+};
+
+class RegistroRound {
+public:
+  void iniciar(uint16_t numero, uint16_t segundos, uint32_t inicioMs, unsigned long inicioEpoch);
+  void registrar(const GolpeSegmentado& golpe);
+
+  uint16_t getNumero() const { return numero; }
+  uint16_t getSegundos() const { return segundos; }
+  unsigned long getInicioEpoch() const { return inicioEpoch; }
+  uint32_t getGolpes() const { return golpes; }
+  float getMediaG() const { return golpes ? somaG / golpes : 0; }
+  float getPicoG() const { return picoG; }
+  uint32_t getGolpesPad(int pad) const;
+  uint32_t getGolpesTipo(TipoGolpe tipo) const { return porTipo[(int)tipo]; }
+  const BaldeRound& balde(uint16_t segundo) const { return baldes[segundo]; }
+
+private:
+  BaldeRound baldes[ROUND_MAX_S];
+  uint16_t numero;
+  uint16_t segundos;
+  uint32_t inicioMs;
+  unsigned long inicioEpoch;
+  uint32_t golpes;
+  float somaG;
+  float picoG;
+  uint32_t porTipo[NUM_TIPOS_GOLPE];
+};
+
+#endif
@@ -1,20 +1,18 @@
 #include "Sensores.h"
-#include <Wire.h>
+#include "BarramentoI2C.h"
+#include "Log.h"
+#include <LittleFS.h>
 #include <algorithm>
 
-// Definir pinos de toque (mantidos da versão anterior)
-const byte Sensores::pinosToque[NUM_SENSORES] = {T8, T6, T7, T10, T1, T5, T4, T2, T3};
-
-Sensores::Sensores() : mpu(ENDERECO_MPU6500) {
+template <class Placa>
+SensoresPlaca<Placa>::SensoresPlaca() : mpu(ENDERECO_MPU6500) {
     // Inicializar arrays
-    float limitesIniciais[NUM_SENSORES] = {20000,15000,20000,15000,20000,7000,20000,20000,20000};
-    
-    for(int i = 0; i < NUM_SENSORES; i++) {
+    for(int i = 0; i < NUM_PADS; i++) {
         baselineToque[i] = 0;
-        thresholdsToque[i] = limitesIniciais[i];
+        thresholdsToque[i] = Placa::limites[i];
         sensorCalibrado[i] = false;
         mediasToque[i] = 0;
-        limitesToque[i] = limitesIniciais[i];
+        limitesToque[i] = Placa::limites[i];
         
         for(int j = 0; j < 10; j++) {
             maxValoresToque[i][j] = 0;
@@ -26,17 +24,28 @@ Sensores::Sensores() : mpu(ENDERECO_MPU6500) {
     tempoInicioCalibracao = 0;
     sensoresCalibrados = 0;
     
-    for(int i = 0; i < NUM_SENSORES; i++) {
+    for(int i = 0; i < NUM_PADS; i++) {
         contadorCapturas[i] = 0;
     }
 }
 
-void Sensores::iniciar() {
-    // Inicializar MPU6500
-    Wire.begin();
+template <class Placa>
+void SensoresPlaca<Placa>::iniciar() {
+    if (!Placa::TEM_IMU) {
+        LOG_INFO(Sensores, "Sensores inicializados (sem MPU6500)");
+        return;
+    }
+
+    // Inicializar MPU6500 (o Wire pertence ao BarramentoI2C)
+    barramentoI2C.iniciar();
+    TransacaoI2C transacao(PrioridadeI2C::Sensor);
+    if (!transacao.adquirida()) {
+        LOG_ERRO(Sensores, "Barramento I2C indisponível");
+        return;
+    }
     
     if (!mpu.init()) {
-        Serial.println("MPU6500 não responde");
+        LOG_ERRO(Sensores, "MPU6500 não responde");
         return;
     }
     
@@ -50,34 +59,36 @@ void Sensores::iniciar() {
     mpu.enableAccDLPF(true);
     mpu.setAccDLPF(MPU6500_DLPF_7);
     
-    Serial.println("Sensores inicializados");
+    LOG_INFO(Sensores, "Sensores inicializados");
 }
 
-void Sensores::coletarBaseline() {
-    Serial.println("Coletando valores de repouso...");
+template <class Placa>
+void SensoresPlaca<Placa>::coletarBaseline() {
+    LOG_INFO(Sensores, "Coletando valores de repouso...");
     
-    for(int i = 0; i < NUM_SENSORES; i++) {
+    for(int i = 0; i < NUM_PADS; i++) {
         long soma = 0;
         
         for(int j = 0; j < 50; j++) {
-            soma += touchRead(pinosToque[i]);
+            soma += touchRead(Placa::pinos[i]);
             delay(20);
         }
         
         baselineToque[i] = soma / 50;
-        Serial.printf("Sensor %s: Baseline = %d\n", nomesSensores[i].c_str(), baselineToque[i]);
+        LOG_INFO(Sensores, "Sensor %s: Baseline = %d", Placa::nomes[i], baselineToque[i]);
         sensorCalibrado[i] = false;
     }
 }
 
-void Sensores::iniciarCalibracaoInterativa() {
-    Serial.println("Iniciando calibração interativa...");
+template <class Placa>
+void SensoresPlaca<Placa>::iniciarCalibracaoInterativa() {
+    LOG_INFO(Sensores, "Iniciando calibração interativa...");
     calibracaoInterativaAtiva = true;
     sensoresCalibrados = 0;
     tempoInicioCalibracao = millis();
     
     // Inicializar arrays
-    for (int i = 0; i < NUM_SENSORES; i++) {
+    for (int i = 0; i < NUM_PADS; i++) {
         contadorCapturas[i] = 0;
         sensorCalibrado[i] = false;
     }
@@ -85,10 +96,11 @@ void Sensores::iniciarCalibracaoInterativa() {
     // Coletar baseline inicial
     coletarBaseline();
     
-    Serial.println("Toque em cada sensor para calibração...");
+    LOG_INFO(Sensores, "Toque em cada sensor para calibração...");
 }
 
-bool Sensores::calibrarSensorIndividual(int indiceSensor) {
+template <class Placa>
+bool SensoresPlaca<Placa>::calibrarSensorIndividual(int indiceSensor) {
   const int TOTAL_AMOSTRAS = 20;
   const int NUM_MAIORES = 10;
   const int TOUCH_THRESHOLD_PERCENT = 25;
@@ -102,7 +114,7 @@ bool Sensores::calibrarSensorIndividual(int indiceSensor) {
   const unsigned long TIMEOUT_MS = 30000; // 30 segundos de timeout
   
   while (amostrasColetadas < TOTAL_AMOSTRAS && (millis() - inicio) < TIMEOUT_MS) {
-    int current_value = touchRead(pinosToque[indiceSensor]);
+    int current_value = touchRead(Placa::pinos[indiceSensor]);
     amostras[amostrasColetadas] = current_value;
     amostrasColetadas++;
     
@@ -135,8 +147,8 @@ bool Sensores::calibrarSensorIndividual(int indiceSensor) {
   
   // Verificar se capturamos toques suficientes
   if (captureCount < NUM_MAIORES) {
-    Serial.printf("Erro: Apenas %d toques válidos capturados para o sensor %d\n", 
-                  captureCount, indiceSensor);
+    LOG_ERRO(Sensores, "Apenas %d toques válidos capturados para o sensor %d",
+             captureCount, indiceSensor);
     return false;
   }
   
@@ -153,33 +165,34 @@ bool Sensores::calibrarSensorIndividual(int indiceSensor) {
   // Definir o threshold
   thresholdsToque[indiceSensor] = (baselineToque[indiceSensor] + media) / 2;
   
-  Serial.printf("Sensor %d calibrado. Threshold: %d\n", 
-                indiceSensor, thresholdsToque[indiceSensor]);
+  LOG_INFO(Sensores, "Sensor %d calibrado. Threshold: %d",
+           indiceSensor, thresholdsToque[indiceSensor]);
   
   return true;
 }
 
 
 
-bool Sensores::processarCalibracaoInterativa() {
+template <class Placa>
+bool SensoresPlaca<Placa>::processarCalibracaoInterativa() {
     if (!calibracaoInterativaAtiva) {
         return false;
     }
     
     // Verificar timeout (60 segundos)
     if (millis() - tempoInicioCalibracao > 60000) {
-        Serial.println("Timeout na calibração interativa");
+        LOG_TELA(Sensores, "Timeout na calibracao");
         finalizarCalibracaoInterativa();
         return true;
     }
     
     // Processar cada sensor
-    for (int i = 0; i < NUM_SENSORES; i++) {
+    for (int i = 0; i < NUM_PADS; i++) {
         if (sensorCalibrado[i]) {
             continue; // Sensor já calibrado
         }
         
-        int valorAtual = touchRead(pinosToque[i]);
+        int valorAtual = touchRead(Placa::pinos[i]);
         int diferenca = abs(valorAtual - baselineToque[i]);
         int limiarTemporario = (baselineToque[i] * 25) / 100;
         
@@ -187,19 +200,19 @@ bool Sensores::processarCalibracaoInterativa() {
             if (contadorCapturas[i] < 10) {
                 maxValoresToque[i][contadorCapturas[i]] = valorAtual;
                 contadorCapturas[i]++;
-                Serial.printf("Captura %d para sensor %d\n", contadorCapturas[i], i);
+                LOG_DEPURACAO(Sensores, "Captura %d para sensor %d", contadorCapturas[i], i);
             } else {
                 // Ordenar valores e marcar como calibrado
                 std::sort(maxValoresToque[i], maxValoresToque[i] + 10);
                 sensorCalibrado[i] = true;
                 sensoresCalibrados++;
-                Serial.printf("Sensor %d calibrado. Total: %d/%d\n", i, sensoresCalibrados, NUM_SENSORES);
+                LOG_INFO(Sensores, "Sensor %d calibrado. Total: %d/%d", i, sensoresCalibrados, NUM_PADS);
             }
         }
     }
     
     // Verificar se todos os sensores foram calibrados
-    if (sensoresCalibrados == NUM_SENSORES) {
+    if (sensoresCalibrados == NUM_PADS) {
         calcularThresholds();
         finalizarCalibracaoInterativa();
         return true;
@@ -208,32 +221,36 @@ bool Sensores::processarCalibracaoInterativa() {
     return false; // Calibração ainda em andamento
 }
 
-int Sensores::getProgressoCalibracao() {
+template <class Placa>
+int SensoresPlaca<Placa>::getProgressoCalibracao() {
     return sensoresCalibrados;
 }
 
-int Sensores::getSensorCalibrado(int index) {
-    if (index < 0 || index >= NUM_SENSORES) {
+template <class Placa>
+int SensoresPlaca<Placa>::getSensorCalibrado(int index) {
+    if (index < 0 || index >= NUM_PADS) {
         return -1; // Índice inválido
     }
     return sensorCalibrado[index] ? 1 : 0;
 }
 
-void Sensores::finalizarCalibracaoInterativa() {
+template <class Placa>
+void SensoresPlaca<Placa>::finalizarCalibracaoInterativa() {
     calibracaoInterativaAtiva = false;
-    Serial.println("Calibração interativa finalizada");
+    LOG_INFO(Sensores, "Calibração interativa finalizada");
 }
 
-void Sensores::capturarToquesCalibracao() {
+template <class Placa>
+void SensoresPlaca<Placa>::capturarToquesCalibracao() {
     int sensoresCalibrados = 0;
     unsigned long tempoInicial = millis();
-    int contadorCapturas[NUM_SENSORES] = {0};
+    int contadorCapturas[NUM_PADS] = {0};
 
-    while(sensoresCalibrados < NUM_SENSORES && millis() - tempoInicial < 60000) {
-        for(int i = 0; i < NUM_SENSORES; i++) {
+    while(sensoresCalibrados < NUM_PADS && millis() - tempoInicial < 60000) {
+        for(int i = 0; i < NUM_PADS; i++) {
             if(sensorCalibrado[i]) continue;
 
-            int valorAtual = touchRead(pinosToque[i]);
+            int valorAtual = touchRead(Placa::pinos[i]);
             int diferenca = abs(valorAtual - baselineToque[i]);
             int limiarTemporario = (baselineToque[i] * 25) / 100;
 
@@ -246,7 +263,7 @@ void Sensores::capturarToquesCalibracao() {
                     std::sort(maxValoresToque[i], maxValoresToque[i] + 10);
                     sensorCalibrado[i] = true;
                     sensoresCalibrados++;
-                    Serial.printf("Sensor %s calibrado.\n", nomesSensores[i].c_str());
+                    LOG_INFO(Sensores, "Sensor %s calibrado.", Placa::nomes[i]);
                 }
             }
         }
@@ -254,8 +271,9 @@ void Sensores::capturarToquesCalibracao() {
     }
 }
 
-void Sensores::calcularThresholds() {
-    for(int i = 0; i < NUM_SENSORES; i++) {
+template <class Placa>
+void SensoresPlaca<Placa>::calcularThresholds() {
+    for(int i = 0; i < NUM_PADS; i++) {
         if(sensorCalibrado[i]) {
             long soma = 0;
             for(int j = 0; j < 10; j++) {
@@ -264,40 +282,48 @@ void Sensores::calcularThresholds() {
             int mediaMaximos = soma / 10;
             thresholdsToque[i] = (baselineToque[i] + mediaMaximos) / 2;
             limitesToque[i] = thresholdsToque[i];
-            Serial.printf("Sensor %s: Threshold = %d\n", nomesSensores[i].c_str(), thresholdsToque[i]);
+            LOG_INFO(Sensores, "Sensor %s: Threshold = %d", Placa::nomes[i], thresholdsToque[i]);
         } else {
             // Fallback para valores padrão se não calibrado
             thresholdsToque[i] = baselineToque[i] * 1.2;
             limitesToque[i] = thresholdsToque[i];
-            Serial.printf("Sensor %s: Threshold padrão = %d\n", nomesSensores[i].c_str(), thresholdsToque[i]);
+            LOG_AVISO(Sensores, "Sensor %s: Threshold padrão = %d", Placa::nomes[i], thresholdsToque[i]);
         }
     }
 }
 
-void Sensores::calibrarSensoresToqueAvancado() {
+template <class Placa>
+void SensoresPlaca<Placa>::calibrarSensoresToqueAvancado() {
     coletarBaseline();
     capturarToquesCalibracao();
     calcularThresholds();
-    Serial.println("Calibração avançada concluída!");
+    LOG_INFO(Sensores, "Calibração avançada concluída!");
 }
 
-int Sensores::detectarToque() {
-    for (int i = 0; i < NUM_SENSORES; i++) {
-        if(touchRead(pinosToque[i]) > thresholdsToque[i]) {
+template <class Placa>
+int SensoresPlaca<Placa>::detectarToque() {
+    for (int i = 0; i < NUM_PADS; i++) {
+        if(touchRead(Placa::pinos[i]) > thresholdsToque[i]) {
             return i;
         }
     }
     return -1;
 }
 
-float Sensores::lerSensorToque(int indice) {
-    if (indice < 0 || indice >= NUM_SENSORES) {
+template <class Placa>
+float SensoresPlaca<Placa>::lerSensorToque(int indice) {
+    if (indice < 0 || indice >= NUM_PADS) {
         return -1;
     }
-    return touchRead(pinosToque[indice]);
+    return touchRead(Placa::pinos[indice]);
 }
 
-float Sensores::calcularForca() {
+template <class Placa>
+float SensoresPlaca<Placa>::calcularForca() {
+    if (!Placa::TEM_IMU) {
+        return 0;
+    }
+
     static float maiorPico = 0;
     maiorPico = 0;
     
@@ -313,62 +339,27 @@ float Sensores::calcularForca() {
     return maiorPico;
 }
 
-float Sensores::integraFFT(bool reset) {
-    static double vReal[SAMPLES];
-    static double vImag[SAMPLES];
-    static double vRealR[SAMPLES];
-    static float media = 0;
-    static float somaSample = 0;
-    static int ind = 0;
-    static int numSamples = 0;
-    
+template <class Placa>
+float SensoresPlaca<Placa>::integraFFT(bool reset) {
     if (reset) {
-        for(int i = 0; i < SAMPLES; i++) {
-            vRealR[i] = 0;
-        }
-        media = 0;
-        somaSample = 0;
-        ind = 0;
-        numSamples = 0;
+        pipelineForca.reiniciar();
         return 0;
     }
 
-    xyzFloat gValue = mpu.getGValues();
-    float newSample = mpu.getResultantG(gValue);
-
-    if (numSamples < SAMPLES) {
-        somaSample += newSample;
-        vRealR[numSamples] = newSample;
-        numSamples++;
-    } else {
-        somaSample += newSample - vRealR[ind];
-        vRealR[ind] = newSample;
-    }
-    
-    ind = (ind + 1) % SAMPLES;
-    media = somaSample / SAMPLES;
-
-    if (numSamples >= SAMPLES) {
-        for (int k = 0; k < SAMPLES; k++) {
-            vReal[k] = vRealR[(ind + k) % SAMPLES] - media;
-            vImag[k] = 0;
-        }
-        
-        ArduinoFFT<double> FFT(vReal, vImag, SAMPLES, SAMPLING_FREQUENCY);
-        FFT.windowing(FFTWindow::Hamming, FFTDirection::Forward);
-        FFT.compute(FFTDirection::Forward);
-        FFT.complexToMagnitude();
-        
-        float soma = 0;
-        for (int i = 1; i < SAMPLES / 2; i++) {
-            soma += vReal[i];
+    xyzFloat gValue;
+    {
+        // 6 bytes de aceleração; tem prioridade sobre o display
+        TransacaoI2C transacao(PrioridadeI2C::Sensor, 6);
+        if (!transacao.adquirida()) {
+            return 0;
         }
-        return soma;
+        gValue = mpu.getGValues();
     }
-    return 0;
+    return pipelineForca.processar(mpu.getResultantG(gValue));
 }
 
-float Sensores::detectarPico(float entrada, bool reset) {
+template <class Placa>
+float SensoresPlaca<Placa>::detectarPico(float entrada, bool reset) {
     static float maior = 0;
     static bool subindo = true;
 
@@ -391,33 +382,168 @@ float Sensores::detectarPico(float entrada, bool reset) {
     return maior;
 }
 
-void Sensores::ajusteDinamicoReferencias() {
-    for (int i = 0; i < NUM_SENSORES; i++) {
-        uint16_t valorAtual = touchRead(pinosToque[i]);
+template <class Placa>
+void SensoresPlaca<Placa>::ajusteDinamicoReferencias() {
+    for (int i = 0; i < NUM_PADS; i++) {
+        uint16_t valorAtual = touchRead(Placa::pinos[i]);
         if (abs(valorAtual - mediasToque[i]) < 10) {
             mediasToque[i] = (mediasToque[i] * 0.9) + (valorAtual * 0.1);
         }
     }
 }
 
-int Sensores::getBaseline(int indice) const {
-    if (indice < 0 || indice >= NUM_SENSORES) return -1;
+template <class Placa>
+int SensoresPlaca<Placa>::getBaseline(int indice) const {
+    if (indice < 0 || indice >= NUM_PADS) return -1;
     return baselineToque[indice];
 }
 
-int Sensores::getThreshold(int indice) const {
-    if (indice < 0 || indice >= NUM_SENSORES) return -1;
+template <class Placa>
+int SensoresPlaca<Placa>::getThreshold(int indice) const {
+    if (indice < 0 || indice >= NUM_PADS) return -1;
     return thresholdsToque[indice];
 }
 
-String Sensores::getNomeSensor(int indice) const {
-    if (indice < 0 || indice >= NUM_SENSORES) return "INVALIDO";
-    return nomesSensores[indice];
+template <class Placa>
+String SensoresPlaca<Placa>::getNomeSensor(int indice) const {
+    if (indice < 0 || indice >= NUM_PADS) return "INVALIDO";
+    return Placa::nomes[indice];
 }
 
-bool Sensores::isSensorCalibrado(int indice) const {
-    if (indice < 0 || indice >= NUM_SENSORES) return false;
+template <class Placa>
+bool SensoresPlaca<Placa>::isSensorCalibrado(int indice) const {
+    if (indice < 0 || indice >= NUM_PADS) return false;
     return sensorCalibrado[indice];
 }
 
+template <class Placa>
+uint8_t SensoresPlaca<Placa>::getPino(int indice) const {
+    if (indice < 0 || indice >= NUM_PADS) return 0;
+    return Placa::pinos[indice];
+}
+
+template <class Placa>
+void SensoresPlaca<Placa>::lerToques(uint16_t valores[NUM_PADS]) {
+    // NUM_PADS é constante da placa: o laço sai desenrolado
+    #pragma GCC unroll 16
+    for (int i = 0; i < NUM_PADS; i++) {
+        valores[i] = touchRead(Placa::pinos[i]);
+    }
+}
+
+template <class Placa>
+void SensoresPlaca<Placa>::lerIMU(xyzFloat& aceleracao, xyzFloat& giro) {
+    if (!Placa::TEM_IMU) {
+        // Em repouso, para os traços e o round seguirem com o mesmo formato
+        aceleracao = {0, 0, 1};
+        giro = {0, 0, 0};
+        return;
+    }
+
+    TransacaoI2C transacao(PrioridadeI2C::Sensor, 12);
+    if (!transacao.adquirida()) {
+        aceleracao = {0, 0, 1};
+        giro = {0, 0, 0};
+        return;
+    }
+    aceleracao = mpu.getGValues();
+    giro = mpu.getGyrValues();
+}
+
+template <class Placa>
+void SensoresPlaca<Placa>::ativarDespertarMovimento(uint16_t limiarMg) {
+    if (!Placa::TEM_IMU) {
+        return;  // Só o pad do centro acorda
+    }
+
+    TransacaoI2C transacao(PrioridadeI2C::Sensor);
+    if (!transacao.adquirida()) {
+        return;
+    }
+    // INT em nível alto e travado até a leitura: o ESP32 acorda por nível
+    mpu.setIntPinPolarity(MPU6500_ACT_HIGH);
+    mpu.enableIntLatch(true);
+    mpu.enableClearIntByAnyRead(false);
+    mpu.setWakeOnMotionThreshold(limiarMg >= 1020 ? 255 : limiarMg / 4);  // 4 mg por unidade
+    mpu.enableWakeOnMotion(MPU6500_WOM_ENABLE, MPU6500_WOM_COMP_DISABLE);
+    mpu.enableInterrupt(MPU6500_WOM_INT);
+    mpu.readAndClearInterrupts();
+    // Só o acelerômetro, acordando a 125 Hz para comparar
+    mpu.setLowPowerAccDataRate(MPU6500_LP_ACC_ODR_125);
+    mpu.enableCycle(true);
+}
+
+template <class Placa>
+void SensoresPlaca<Placa>::desativarDespertarMovimento() {
+    if (!Placa::TEM_IMU) {
+        return;
+    }
+
+    TransacaoI2C transacao(PrioridadeI2C::Sensor);
+    if (!transacao.adquirida()) {
+        return;
+    }
+    mpu.enableCycle(false);
+    mpu.disableInterrupt(MPU6500_WOM_INT);
+    mpu.enableWakeOnMotion(MPU6500_WOM_DISABLE, MPU6500_WOM_COMP_DISABLE);
+    mpu.readAndClearInterrupts();
+}
+
+template <class Placa>
+void SensoresPlaca<Placa>::definirCalibracao(int indice, int baseline, int threshold) {
+    if (indice < 0 || indice >= NUM_PADS) return;
+    baselineToque[indice] = baseline;
+    thresholdsToque[indice] = threshold;
+    limitesToque[indice] = threshold;
+}
+
+// Cabeçalho do arquivo de calibração; depois dele baseline e threshold de cada pad
+struct CabecalhoCalibracao {
+    char assinatura[3];   // "CAL"
+    uint8_t versao;
+    uint8_t numPads;
+    uint8_t reservado[3];
+};
+
+template <class Placa>
+bool SensoresPlaca<Placa>::carregarCalibracao(const char* caminho) {
+    File arquivo = LittleFS.open(caminho, FILE_READ);
+    if (!arquivo) {
+        return false;
+    }
+    CabecalhoCalibracao cabecalho;
+    int32_t valores[2 * NUM_PADS];
+    if (arquivo.read((uint8_t*)&cabecalho, sizeof(cabecalho)) != sizeof(cabecalho) ||
+        memcmp(cabecalho.assinatura, "CAL", 3) != 0 || cabecalho.versao != CALIBRACAO_VERSAO ||
+        cabecalho.numPads != NUM_PADS ||
+        arquivo.read((uint8_t*)valores, sizeof(valores)) != sizeof(valores)) {
+        LOG_AVISO(Sensores, "Calibração em %s inválida ou de outra placa", caminho);
+        return false;
+    }
+    for (int i = 0; i < NUM_PADS; i++) {
+        definirCalibracao(i, valores[2 * i], valores[2 * i + 1]);
+        sensorCalibrado[i] = true;
+    }
+    return true;
+}
+
+template <class Placa>
+bool SensoresPlaca<Placa>::salvarCalibracao(const char* caminho) const {
+    File arquivo = LittleFS.open(caminho, FILE_WRITE);
+    if (!arquivo) {
+        LOG_ERRO(Sensores, "Falha ao abrir %s", caminho);
+        return false;
+    }
+    CabecalhoCalibracao cabecalho = {{'C', 'A', 'L'}, CALIBRACAO_VERSAO, NUM_PADS, {0, 0, 0}};
+    int32_t valores[2 * NUM_PADS];
+    for (int i = 0; i < NUM_PADS; i++) {
+        valores[2 * i] = baselineToque[i];
+        valores[2 * i + 1] = thresholdsToque[i];
+    }
+    return arquivo.write((const uint8_t*)&cabecalho, sizeof(cabecalho)) == sizeof(cabecalho) &&
+           arquivo.write((const uint8_t*)valores, sizeof(valores)) == sizeof(valores);
+}
+
+template class SensoresPlaca<PlacaAtual>;
+
 Sensores sensores;
\ No newline at end of file
@@ -3,17 +3,26 @@
 
 #include <Arduino.h>
 #include <MPU6500_WE.h>
-#include <arduinoFFT.h>
+#include "Espectro.h"
+#include "Placas.h"
 
-#define NUM_SENSORES 9
+#define NUM_SENSORES (PlacaAtual::NUM_PADS)
 #define SAMPLES 64
 #define SAMPLING_FREQUENCY 100
 #define ENDERECO_MPU6500 0x68
 #define DURACAO_CALIBRACAO_MS 1000
+#define FAIXA_ACEL_G 16        // MPU6500_ACC_RANGE_16G, configurada em iniciar()
+#define FAIXA_GIRO_DPS 2000    // MPU6500_GYRO_RANGE_2000
+#define CALIBRACAO_ARQUIVO "/calibracao.bin"
+#define CALIBRACAO_VERSAO 1
 
-class Sensores {
+// Pads, pinos e limites vêm do descritor da placa (Placas.h)
+template <class Placa>
+class SensoresPlaca {
 public:
-    Sensores();
+    static constexpr uint8_t NUM_PADS = Placa::NUM_PADS;
+
+    SensoresPlaca();
     void iniciar();
     void calibrarSensoresToqueAvancado();
     bool calibrarSensorIndividual(int indiceSensor); 
@@ -35,28 +44,41 @@ public:
     int getThreshold(int indice) const;
     String getNomeSensor(int indice) const;
     bool isSensorCalibrado(int indice) const;
+    uint8_t getPino(int indice) const;
+
+    // Leituras cruas para gravação de traços (Traco.h)
+    void lerToques(uint16_t valores[Placa::NUM_PADS]);
+    void lerIMU(xyzFloat& aceleracao, xyzFloat& giro);
+
+    // Wake-on-motion do MPU6500 para o light sleep (Energia.h): o INT sobe
+    // quando um eixo varia mais que limiarMg
+    void ativarDespertarMovimento(uint16_t limiarMg);
+    void desativarDespertarMovimento();
+
+    // Restaura a calibração gravada num traço
+    void definirCalibracao(int indice, int baseline, int threshold);
+
+    // Calibração no LittleFS (já montado): carregada no boot, sem esperar a
+    // rede; gravada depois de cada calibração. Arquivo de outra placa é ignorado
+    bool carregarCalibracao(const char* caminho = CALIBRACAO_ARQUIVO);
+    bool salvarCalibracao(const char* caminho = CALIBRACAO_ARQUIVO) const;
 
 private:
-    int baselineToque[NUM_SENSORES];
-    int maxValoresToque[NUM_SENSORES][10];
-    int thresholdsToque[NUM_SENSORES];
-    bool sensorCalibrado[NUM_SENSORES];
-    
-    static const byte pinosToque[NUM_SENSORES];
+    friend class Bancada;  // Mede integraFFT e detectarPico (Bancada.h)
+
+    int baselineToque[Placa::NUM_PADS];
+    int maxValoresToque[Placa::NUM_PADS][10];
+    int thresholdsToque[Placa::NUM_PADS];
+    bool sensorCalibrado[Placa::NUM_PADS];
     
-    float mediasToque[NUM_SENSORES];
-    float limitesToque[NUM_SENSORES];
-    const String nomesSensores[NUM_SENSORES] = {
-        "FrenteAlta", "FrenteBaixa", "DireitaBaixa", 
-        "DireitaAlta", "EsquerdaBaixa", "EsquerdaAlta",
-        "TrasAlta", "TrasBaixa", "Centro"
-    };
+    float mediasToque[Placa::NUM_PADS];
+    float limitesToque[Placa::NUM_PADS];
     
     // Variáveis para calibração interativa
     bool calibracaoInterativaAtiva;
     unsigned long tempoInicioCalibracao;
     int sensoresCalibrados;
-    int contadorCapturas[NUM_SENSORES];
+    int contadorCapturas[Placa::NUM_PADS];
     
     // Métodos de calibração avançada
     void coletarBaseline();
@@ -64,10 +86,20 @@ private:
     void calcularThresholds();
     
     MPU6500_WE mpu;
+    PipelineForca<FFTForca<SAMPLES>> pipelineForca;  // Backend em FFT_FORCA (Espectro.h)
     float integraFFT(bool reset = false);
     float detectarPico(float entrada, bool reset = false);
 };
 
+// Definição do membro static constexpr até o C++14 (ver Placas.cpp)
+#if __cplusplus < 201703L
+template <class Placa>
+constexpr uint8_t SensoresPlaca<Placa>::NUM_PADS;
+#endif
+
+// Instanciado só para a placa do build (Sensores.cpp)
+using Sensores = SensoresPlaca<PlacaAtual>;
+
 extern Sensores sensores;
 
 #endif
\ No newline at end of file
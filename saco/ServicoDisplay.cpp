@@ -0,0 +1,260 @@
+/**
+ * @file ServicoDisplay.cpp
+ * @brief Implementação do serviço de renderização do display OLED
+ *
+ * A tarefa do display bloqueia na fila até chegar um comando, esvazia o que
+ * mais estiver pendente, aplica a coalescência e só então desenha e envia.
+ * Nenhuma outra tarefa toca no SetaDisplay ou no I2C do display.
+ */
+#include "ServicoDisplay.h"
+
+ServicoDisplay servicoDisplay(setaDisplay);
+
+ServicoDisplay::ServicoDisplay(SetaDisplay& display)
+  : display(display), fila(NULL), mutexEstimulo(NULL), estimuloNoPainel(NULL), renderizadoUs(0),
+    descartados(0), renderizacoes(0), estimulos(0), statusAtual(0), painelAceso(true) {
+  // Log nunca é considerado redundante, então serve de "nada na tela"
+  azulAtual.comando = ComandoDisplay::Log;
+  azulAtual.valor = 0;
+  azulAtual.estimulo = false;
+  azulAtual.aguardando = false;
+  azulAtual.texto[0] = '\0';
+  amareloAtual = azulAtual;
+}
+
+bool ServicoDisplay::iniciar() {
+  mutexEstimulo = xSemaphoreCreateMutex();
+  estimuloNoPainel = xSemaphoreCreateBinary();
+  fila = xQueueCreate(TAMANHO_FILA_DISPLAY, sizeof(MensagemDisplay));
+  if (fila == NULL || mutexEstimulo == NULL || estimuloNoPainel == NULL) {
+    Serial.println("Falha ao criar fila do display");
+    fila = NULL;
+    return false;
+  }
+
+  // A partir daqui os métodos do SetaDisplay só desenham; o envio é feito
+  // uma vez por rodada pela tarefa
+  display.setEnvioAutomatico(false);
+
+  if (xTaskCreate(tarefa, "tarefaDisplay", PILHA_TAREFA_DISPLAY, this,
+                  PRIORIDADE_TAREFA_DISPLAY, NULL) != pdPASS) {
+    Serial.println("Falha ao criar tarefa do display");
+    display.setEnvioAutomatico(true);
+    fila = NULL;
+    return false;
+  }
+  return true;
+}
+
+bool ServicoDisplay::postar(ComandoDisplay comando, int valor, const char* texto) {
+  MensagemDisplay mensagem;
+  mensagem.comando = comando;
+  mensagem.valor = valor;
+  mensagem.estimulo = false;
+  mensagem.aguardando = false;
+  strncpy(mensagem.texto, texto, TAMANHO_TEXTO_DISPLAY - 1);
+  mensagem.texto[TAMANHO_TEXTO_DISPLAY - 1] = '\0';
+
+  // Tempo de espera zero: quem posta nunca espera pelo display
+  if (fila == NULL || xQueueSend(fila, &mensagem, 0) != pdTRUE) {
+    __atomic_add_fetch(&descartados, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+  return true;
+}
+
+uint32_t ServicoDisplay::postarEstimulo(ComandoDisplay comando, int valor, const char* texto,
+                                        bool aguardar) {
+  if (fila == NULL) {
+    return micros();
+  }
+  MensagemDisplay mensagem;
+  mensagem.comando = comando;
+  mensagem.valor = valor;
+  mensagem.estimulo = true;
+  mensagem.aguardando = aguardar;
+  strncpy(mensagem.texto, texto, TAMANHO_TEXTO_DISPLAY - 1);
+  mensagem.texto[TAMANHO_TEXTO_DISPLAY - 1] = '\0';
+
+  if (!aguardar) {
+    xQueueSend(fila, &mensagem, portMAX_DELAY);
+    return micros();
+  }
+
+  xSemaphoreTake(mutexEstimulo, portMAX_DELAY);
+  // Sobra de um estímulo anterior que passou do prazo
+  xSemaphoreTake(estimuloNoPainel, 0);
+  xQueueSend(fila, &mensagem, portMAX_DELAY);
+  uint32_t instante;
+  if (xSemaphoreTake(estimuloNoPainel, ESPERA_ESTIMULO_MS / portTICK_PERIOD_MS) == pdTRUE) {
+    instante = renderizadoUs;
+  } else {
+    instante = micros();
+  }
+  xSemaphoreGive(mutexEstimulo);
+  return instante;
+}
+
+bool ServicoDisplay::seta(int angulo) {
+  return postar(ComandoDisplay::Seta, angulo, "");
+}
+
+bool ServicoDisplay::setaCentro() {
+  return postar(ComandoDisplay::SetaCentro, 0, "");
+}
+
+bool ServicoDisplay::banner(const String& texto) {
+  return postar(ComandoDisplay::Banner, 0, texto.c_str());
+}
+
+bool ServicoDisplay::texto(const String& texto) {
+  return postar(ComandoDisplay::Texto, 0, texto.c_str());
+}
+
+bool ServicoDisplay::hora(const String& texto) {
+  return postar(ComandoDisplay::Hora, 0, texto.c_str());
+}
+
+bool ServicoDisplay::status(int status) {
+  return postar(ComandoDisplay::Status, status, "");
+}
+
+bool ServicoDisplay::log(const String& texto) {
+  return postar(ComandoDisplay::Log, 0, texto.c_str());
+}
+
+bool ServicoDisplay::painel(bool aceso) {
+  return postar(ComandoDisplay::Painel, aceso ? 1 : 0, "");
+}
+
+uint32_t ServicoDisplay::estimuloSeta(int angulo, bool aguardar) {
+  return postarEstimulo(ComandoDisplay::Seta, angulo, "", aguardar);
+}
+
+uint32_t ServicoDisplay::estimuloSetaCentro(bool aguardar) {
+  return postarEstimulo(ComandoDisplay::SetaCentro, 0, "", aguardar);
+}
+
+uint32_t ServicoDisplay::estimuloBanner(const String& texto, bool aguardar) {
+  return postarEstimulo(ComandoDisplay::Banner, 0, texto.c_str(), aguardar);
+}
+
+uint32_t ServicoDisplay::getDescartados() const {
+  return __atomic_load_n(&descartados, __ATOMIC_RELAXED);
+}
+
+uint32_t ServicoDisplay::getRenderizacoes() const {
+  return renderizacoes;
+}
+
+uint32_t ServicoDisplay::getEstimulos() const {
+  return estimulos;
+}
+
+static bool mesmoConteudo(const MensagemDisplay& a, const MensagemDisplay& b) {
+  return a.comando == b.comando && a.valor == b.valor && strcmp(a.texto, b.texto) == 0;
+}
+
+void ServicoDisplay::processar(const MensagemDisplay& primeira) {
+  MensagemDisplay mensagem = primeira;
+  MensagemDisplay azul;
+  MensagemDisplay amarelo;
+  bool temAzul = false;
+  bool temAmarelo = false;
+  int novoStatus = 0;
+  int novoPainel = -1;
+  bool estimulo = false;
+  bool aguardando = false;
+
+  // Esvazia a fila guardando apenas o último comando de cada área
+  do {
+    switch (mensagem.comando) {
+      case ComandoDisplay::Log:
+        display.registrarLog(String(mensagem.texto));
+        // fall through
+      case ComandoDisplay::Seta:
+      case ComandoDisplay::SetaCentro:
+      case ComandoDisplay::Banner:
+        azul = mensagem;
+        temAzul = true;
+        break;
+      case ComandoDisplay::Texto:
+      case ComandoDisplay::Hora:
+        amarelo = mensagem;
+        temAmarelo = true;
+        break;
+      case ComandoDisplay::Status:
+        novoStatus = mensagem.valor;
+        break;
+      case ComandoDisplay::Painel:
+        novoPainel = mensagem.valor;
+        break;
+    }
+    // O estímulo fecha a rodada: o que vier depois fica para a próxima
+    if (mensagem.estimulo) {
+      estimulo = true;
+      aguardando = mensagem.aguardando;
+      break;
+    }
+  } while (xQueueReceive(fila, &mensagem, 0) == pdTRUE);
+
+  bool desenhou = false;
+
+  if (temAzul && (azul.comando == ComandoDisplay::Log || !mesmoConteudo(azul, azulAtual))) {
+    switch (azul.comando) {
+      case ComandoDisplay::Seta:       display.seta(azul.valor); break;
+      case ComandoDisplay::SetaCentro: display.seta("f"); break;
+      case ComandoDisplay::Banner:     display.printazul(String(azul.texto)); break;
+      default:                         display.mostrarLog(); break;
+    }
+    azulAtual = azul;
+    desenhou = true;
+  }
+
+  if (temAmarelo && !mesmoConteudo(amarelo, amareloAtual)) {
+    if (amarelo.comando == ComandoDisplay::Hora) {
+      display.showtimeCompact(String(amarelo.texto));
+    } else {
+      display.print(String(amarelo.texto));
+    }
+    amareloAtual = amarelo;
+    desenhou = true;
+  }
+
+  if (novoStatus != 0 && novoStatus != statusAtual) {
+    display.setStatus(novoStatus);
+    statusAtual = novoStatus;
+    desenhou = true;
+  }
+
+  if (desenhou) {
+    display.update();
+    renderizacoes++;
+  }
+
+  // Igual ao que já estava na tela também conta: o usuário já o vê. O
+  // instante é anotado antes da contagem, que quem observa de fora usa
+  if (estimulo) {
+    renderizadoUs = micros();
+    estimulos++;
+  }
+  if (aguardando) {
+    xSemaphoreGive(estimuloNoPainel);
+  }
+
+  if (novoPainel >= 0 && (novoPainel == 1) != painelAceso) {
+    painelAceso = (novoPainel == 1);
+    display.ligarPainel(painelAceso);
+  }
+}
+
+void ServicoDisplay::tarefa(void* arg) {
+  ServicoDisplay* servico = static_cast<ServicoDisplay*>(arg);
+  MensagemDisplay mensagem;
+
+  while (1) {
+    if (xQueueReceive(servico->fila, &mensagem, portMAX_DELAY) == pdTRUE) {
+      servico->processar(mensagem);
+    }
+  }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file ServicoDisplay.h
+ * @brief Serviço de renderização do display OLED com fila de comandos
+ *
+ * Uma única tarefa é dona do SetaDisplay. As demais tarefas apenas postam
+ * comandos pequenos numa fila (sem bloquear); a tarefa do display esvazia a
+ * fila, descarta comandos redundantes, desenha o resultado final no
+ * framebuffer (buffer de fundo) e envia ao painel apenas o que mudou.
+ *
+ * @section coalescencia Coalescência
+ * - Área azul: vale o último comando (seta, banner ou log) de cada rodada
+ * - Área amarela: vale o último texto/hora
+ * - Status: vale o último símbolo
+ * - Comandos iguais ao que já está na tela são ignorados
+ * - Mensagens de log sempre entram no histórico, mesmo que não sejam exibidas
+ * - Painel: vale o último; o desenho continua no framebuffer com ele apagado
+ *
+ * @section estimulos Estímulos
+ * O "Ataque" da agilidade e a seta da precisão e do circuito são o que o
+ * usuário reage: esperam vaga na fila em vez de ser descartados, fecham a
+ * rodada (nada postado depois os cobre antes de chegarem ao painel) e,
+ * pedidos com `aguardar`, só retornam com o envio ao painel concluído,
+ * devolvendo o micros() desse instante para o início da contagem.
+ */
+#ifndef SERVICO_DISPLAY_H
+#define SERVICO_DISPLAY_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include "display.h"
+
+#define TAMANHO_FILA_DISPLAY 16
+#define TAMANHO_TEXTO_DISPLAY 24
+#define PRIORIDADE_TAREFA_DISPLAY 1
+#define PILHA_TAREFA_DISPLAY 4096
+#define ESPERA_ESTIMULO_MS 500  // Sem resposta da tarefa: conta da postagem
+
+enum class ComandoDisplay : uint8_t {
+  Seta,        // valor = ângulo
+  SetaCentro,
+  Banner,      // texto grande na área azul
+  Texto,       // texto na área amarela
+  Hora,        // hora compacta na área amarela
+  Status,      // valor = símbolo de status
+  Log,         // linha de log na área azul
+  Painel       // valor = 1 aceso, 0 apagado (modo ocioso)
+};
+
+struct MensagemDisplay {
+  ComandoDisplay comando;
+  int16_t valor;
+  bool estimulo;
+  bool aguardando;  // Estímulo com alguém esperando o renderizadoUs
+  char texto[TAMANHO_TEXTO_DISPLAY];
+};
+
+class ServicoDisplay {
+public:
+  ServicoDisplay(SetaDisplay& display);
+  bool iniciar();
+
+  // Todas as chamadas abaixo retornam imediatamente; false se a fila estiver cheia
+  bool seta(int angulo);
+  bool setaCentro();
+  bool banner(const String& texto);
+  bool texto(const String& texto);
+  bool hora(const String& texto);
+  bool status(int status);
+  bool log(const String& texto);
+  bool painel(bool aceso);
+
+  // Estímulos: bloqueiam se a fila estiver cheia e, com `aguardar`, até o
+  // painel mostrar; devolvem o micros() do fim do envio ao painel
+  uint32_t estimuloSeta(int angulo, bool aguardar = true);
+  uint32_t estimuloSetaCentro(bool aguardar = true);
+  uint32_t estimuloBanner(const String& texto, bool aguardar = true);
+
+  uint32_t getDescartados() const;
+  uint32_t getRenderizacoes() const;
+  uint32_t getEstimulos() const;  // Estímulos (de todo tipo) que chegaram ao painel
+
+private:
+  SetaDisplay& display;
+  QueueHandle_t fila;
+  SemaphoreHandle_t mutexEstimulo;     // Um estímulo aguardado por vez
+  SemaphoreHandle_t estimuloNoPainel;  // Dado pela tarefa após o envio
+  volatile uint32_t renderizadoUs;
+  volatile uint32_t descartados;       // Atômico: várias tarefas postam
+  volatile uint32_t renderizacoes;
+  volatile uint32_t estimulos;
+
+  // Estado atualmente na tela (para ignorar comandos redundantes)
+  MensagemDisplay azulAtual;
+  MensagemDisplay amareloAtual;
+  int statusAtual;
+  bool painelAceso;
+
+  bool postar(ComandoDisplay comando, int valor, const char* texto);
+  uint32_t postarEstimulo(ComandoDisplay comando, int valor, const char* texto, bool aguardar);
+  void processar(const MensagemDisplay& primeira);
+  static void tarefa(void* arg);
+};
+
+extern ServicoDisplay servicoDisplay;
+
+#endif
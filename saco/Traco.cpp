@@ -0,0 +1,125 @@
+/**
+ * @file Traco.cpp
+ * @brief Implementação do gravador de traços dos sensores
+ */
+#include "Traco.h"
+#include <math.h>
+
+GravadorTraco::GravadorTraco()
+  : destino(NULL), enquadrado(false), numSensores(0), faixaAcel(16), faixaGiro(2000),
+    ultimoTempoUs(0), ocupado(0), bytesGravados(0), registros(0) {
+}
+
+bool GravadorTraco::iniciar(Print& saida, const CabecalhoTraco& cabecalho, bool comQuadros) {
+  if (cabecalho.numSensores > TRACO_MAX_SENSORES) {
+    Serial.println("Traço: número de sensores inválido");
+    return false;
+  }
+  destino = &saida;
+  enquadrado = comQuadros;
+  numSensores = cabecalho.numSensores;
+  faixaAcel = cabecalho.faixaAcelG;
+  faixaGiro = cabecalho.faixaGiroDps;
+  ultimoTempoUs = 0;
+  ocupado = 0;
+  bytesGravados = 0;
+  registros = 0;
+
+  adicionar(&cabecalho, sizeof(cabecalho));
+  return true;
+}
+
+int16_t GravadorTraco::converterLeitura(float valor, float faixa) {
+  // Mesma escala do registrador de 16 bits do MPU6500
+  float bruto = roundf(valor / faixa * 32768.0f);
+  if (bruto > 32767.0f) bruto = 32767.0f;
+  if (bruto < -32768.0f) bruto = -32768.0f;
+  return (int16_t)bruto;
+}
+
+void GravadorTraco::iniciarRegistro(uint8_t tipo, uint32_t tempoUs) {
+  uint32_t dt = tempoUs - ultimoTempoUs;
+  if (dt > 0xFFFF) {
+    uint8_t tempo[3] = {REGISTRO_TEMPO, 0, 0};
+    adicionar(tempo, sizeof(tempo));
+    adicionar(&tempoUs, sizeof(tempoUs));
+    dt = 0;
+  }
+  ultimoTempoUs = tempoUs;
+
+  uint8_t cabecalho[3] = {tipo, (uint8_t)(dt & 0xFF), (uint8_t)(dt >> 8)};
+  adicionar(cabecalho, sizeof(cabecalho));
+  registros++;
+}
+
+void GravadorTraco::registrarToque(uint32_t tempoUs, const uint16_t* valores) {
+  if (!ativo()) return;
+  iniciarRegistro(REGISTRO_TOQUE, tempoUs);
+  adicionar(valores, numSensores * sizeof(uint16_t));
+}
+
+void GravadorTraco::registrarIMU(uint32_t tempoUs, float ax, float ay, float az,
+                                 float gx, float gy, float gz) {
+  if (!ativo()) return;
+  int16_t leituras[6] = {
+    converterLeitura(ax, faixaAcel), converterLeitura(ay, faixaAcel),
+    converterLeitura(az, faixaAcel), converterLeitura(gx, faixaGiro),
+    converterLeitura(gy, faixaGiro), converterLeitura(gz, faixaGiro)
+  };
+  iniciarRegistro(REGISTRO_IMU, tempoUs);
+  adicionar(leituras, sizeof(leituras));
+}
+
+void GravadorTraco::registrarMarcador(uint32_t tempoUs, const char* texto) {
+  if (!ativo()) return;
+  size_t tamanho = strlen(texto);
+  if (tamanho > 255) tamanho = 255;
+  uint8_t tamanhoByte = tamanho;
+  iniciarRegistro(REGISTRO_MARCADOR, tempoUs);
+  adicionar(&tamanhoByte, 1);
+  adicionar(texto, tamanho);
+}
+
+void GravadorTraco::adicionar(const void* dados, uint16_t quantidade) {
+  const uint8_t* bytes = (const uint8_t*)dados;
+  while (quantidade > 0) {
+    uint16_t livre = TRACO_TAMANHO_BUFFER - ocupado;
+    uint16_t bloco = quantidade < livre ? quantidade : livre;
+    memcpy(buffer + ocupado, bytes, bloco);
+    ocupado += bloco;
+    bytes += bloco;
+    quantidade -= bloco;
+    if (ocupado == TRACO_TAMANHO_BUFFER) {
+      descarregar();
+    }
+  }
+}
+
+void GravadorTraco::descarregar() {
+  if (ocupado == 0 || destino == NULL) {
+    return;
+  }
+  if (enquadrado) {
+    uint8_t soma = 0;
+    for (uint16_t i = 0; i < ocupado; i++) {
+      soma += buffer[i];
+    }
+    uint8_t inicio[4] = {TRACO_QUADRO_SYNC1, TRACO_QUADRO_SYNC2,
+                         (uint8_t)(ocupado & 0xFF), (uint8_t)(ocupado >> 8)};
+    destino->write(inicio, sizeof(inicio));
+    destino->write(buffer, ocupado);
+    destino->write(&soma, 1);
+  } else {
+    destino->write(buffer, ocupado);
+  }
+  bytesGravados += ocupado;
+  ocupado = 0;
+}
+
+void GravadorTraco::finalizar() {
+  descarregar();
+  if (destino != NULL) {
+    destino->flush();
+  }
+  destino = NULL;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file Traco.h
+ * @brief Formato binário de traço dos sensores e gravador do dispositivo
+ *
+ * Um traço guarda uma sessão real (toques dos pads e aceleração/giro do
+ * MPU6500) para ser reproduzida no build nativo (host/) contra o Sensores,
+ * tornando o ajuste dos algoritmos repetível.
+ *
+ * @section formato Formato (little-endian)
+ * - CabecalhoTraco: taxas, faixas do MPU, mapa de pinos e a calibração dos
+ *   pads no momento da gravação
+ * - Registros: [tipo:1][dt:2] + conteúdo, com dt em µs desde o registro
+ *   anterior. Intervalos maiores que 65535 µs são precedidos de um registro
+ *   Tempo com o instante absoluto (uint32 µs desde o início)
+ *   - Toque:    uint16 por pad (numSensores valores)
+ *   - IMU:      int16 ax, ay, az, gx, gy, gz (leitura crua na faixa do cabeçalho)
+ *   - Marcador: uint8 tamanho + texto (eventos, ex.: "golpe")
+ *
+ * @section serial Envio pela serial
+ * Na serial o traço divide o canal com os logs. Os bytes vão em quadros
+ * [0xA5 0x5A][tamanho:2][dados][soma:1]; o extrator do host ignora o texto
+ * entre quadros e quadros com soma inválida. No flash o traço é gravado
+ * sem quadros.
+ */
+#ifndef TRACO_H
+#define TRACO_H
+
+#include <Arduino.h>
+
+#define TRACO_MAGICO 0x54434153UL  // "SACT"
+#define TRACO_VERSAO 1
+#define TRACO_MAX_SENSORES 12
+#define TRACO_TAMANHO_BUFFER 512
+#define TRACO_QUADRO_SYNC1 0xA5
+#define TRACO_QUADRO_SYNC2 0x5A
+#define TRACO_ARQUIVO "/traco.bin"
+
+struct __attribute__((packed)) CabecalhoTraco {
+  uint32_t magico;
+  uint16_t versao;
+  uint16_t tamanhoCabecalho;
+  uint8_t numSensores;
+  uint8_t faixaAcelG;
+  uint16_t faixaGiroDps;
+  uint16_t taxaToqueHz;
+  uint16_t taxaIMUHz;
+  uint32_t inicioEpoch;  // UTC do início da gravação (0 se desconhecido)
+  uint8_t pinos[TRACO_MAX_SENSORES];
+  uint16_t baseline[TRACO_MAX_SENSORES];
+  uint16_t threshold[TRACO_MAX_SENSORES];
+};
+
+enum TipoRegistroTraco : uint8_t {
+  REGISTRO_TOQUE = 1,
+  REGISTRO_IMU = 2,
+  REGISTRO_TEMPO = 3,
+  REGISTRO_MARCADOR = 4
+};
+
+/**
+ * @brief Grava um traço em qualquer Print (Serial, arquivo do LittleFS, ...)
+ *
+ * Os registros são acumulados num buffer de TRACO_TAMANHO_BUFFER bytes e
+ * escritos no destino de uma vez.
+ */
+class GravadorTraco {
+public:
+  GravadorTraco();
+
+  // enquadrado = true para destinos compartilhados com texto (serial)
+  bool iniciar(Print& destino, const CabecalhoTraco& cabecalho, bool enquadrado);
+  void registrarToque(uint32_t tempoUs, const uint16_t* valores);
+  void registrarIMU(uint32_t tempoUs, float ax, float ay, float az,
+                    float gx, float gy, float gz);
+  void registrarMarcador(uint32_t tempoUs, const char* texto);
+  void finalizar();
+
+  bool ativo() const { return destino != NULL; }
+  uint32_t getBytesGravados() const { return bytesGravados; }
+  uint32_t getRegistros() const { return registros; }
+
+  static int16_t converterLeitura(float valor, float faixa);
+
+private:
+  Print* destino;
+  bool enquadrado;
+  uint8_t numSensores;
+  float faixaAcel;
+  float faixaGiro;
+  uint32_t ultimoTempoUs;
+  uint8_t buffer[TRACO_TAMANHO_BUFFER];
+  uint16_t ocupado;
+  uint32_t bytesGravados;
+  uint32_t registros;
+
+  void iniciarRegistro(uint8_t tipo, uint32_t tempoUs);
+  void adicionar(const void* dados, uint16_t quantidade);
+  void descarregar();
+};
+
+#endif
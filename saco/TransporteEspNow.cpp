@@ -0,0 +1,88 @@
+/**
+ * @file TransporteEspNow.cpp
+ * @brief Fila de recepção e pares do ESP-NOW
+ */
+#include "TransporteEspNow.h"
+#include "Log.h"
+#include <WiFi.h>
+#include <esp_now.h>
+#include <string.h>
+
+TransporteEspNow transporteEspNow;
+
+TransporteEspNow::TransporteEspNow() : fila(nullptr), iniciado(false), descartados(0) {
+  memset(mac, 0, sizeof(mac));
+}
+
+bool TransporteEspNow::iniciar() {
+  if (iniciado) {
+    return true;
+  }
+  // A MAC da estação identifica o saco no circuito
+  unsigned int bytes[6] = {0};
+  sscanf(WiFi.macAddress().c_str(), "%x:%x:%x:%x:%x:%x", &bytes[0], &bytes[1], &bytes[2],
+         &bytes[3], &bytes[4], &bytes[5]);
+  for (int i = 0; i < 6; i++) {
+    mac[i] = (uint8_t)bytes[i];
+  }
+
+  if (fila == nullptr) {
+    fila = xQueueCreate(CIRCUITO_FILA, sizeof(QuadroCircuito));
+  }
+  if (esp_now_init() != ESP_OK) {
+    LOG_ERRO(Conexao, "ESP-NOW não iniciou");
+    return false;
+  }
+  esp_now_register_recv_cb(aoReceber);
+  iniciado = garantirPar(CIRCUITO_BROADCAST);
+  return iniciado;
+}
+
+bool TransporteEspNow::garantirPar(const uint8_t destino[6]) {
+  if (esp_now_is_peer_exist(destino)) {
+    return true;
+  }
+  esp_now_peer_info_t par;
+  memset(&par, 0, sizeof(par));
+  memcpy(par.peer_addr, destino, 6);
+  par.channel = 0;  // O canal atual do WiFi
+  par.ifidx = WIFI_IF_STA;
+  par.encrypt = false;
+  return esp_now_add_peer(&par) == ESP_OK;
+}
+
+bool TransporteEspNow::enviar(const uint8_t destino[6], const MensagemCircuito& mensagem) {
+  if (!iniciado || !garantirPar(destino)) {
+    return false;
+  }
+  return esp_now_send(destino, (const uint8_t*)&mensagem, sizeof(mensagem)) == ESP_OK;
+}
+
+bool TransporteEspNow::receber(QuadroCircuito& quadro, uint32_t esperaMs) {
+  if (fila == nullptr) {
+    vTaskDelay(esperaMs / portTICK_PERIOD_MS);
+    return false;
+  }
+  return xQueueReceive(fila, &quadro, esperaMs / portTICK_PERIOD_MS) == pdTRUE;
+}
+
+void TransporteEspNow::getMac(uint8_t mac[6]) {
+  memcpy(mac, this->mac, 6);
+}
+
+// Na tarefa do WiFi: só carimba e enfileira
+void TransporteEspNow::aoReceber(const uint8_t* origem, const uint8_t* dados, int tamanho) {
+  uint32_t chegadaUs = micros();
+  TransporteEspNow& transporte = transporteEspNow;
+  if (tamanho != (int)sizeof(MensagemCircuito) || transporte.fila == nullptr) {
+    __atomic_fetch_add(&transporte.descartados, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  QuadroCircuito quadro;
+  memcpy(quadro.origem, origem, 6);
+  quadro.recebidoUs = chegadaUs;
+  memcpy(&quadro.mensagem, dados, sizeof(MensagemCircuito));
+  if (xQueueSend(transporte.fila, &quadro, 0) != pdTRUE) {
+    __atomic_fetch_add(&transporte.descartados, 1, __ATOMIC_RELAXED);
+  }
+}
@@ -0,0 +1,45 @@
+/**
+ * @file TransporteEspNow.h
+ * @brief Transporte do circuito (Circuito.h) sobre ESP-NOW
+ *
+ * ESP-NOW vai direto de rádio a rádio, sem o roteador: menos de 1 ms de
+ * ida e volta entre sacos próximos, bem mais estável que UDP pelo AP. Os
+ * sacos precisam estar no mesmo canal; ligados ao mesmo AP, já estão. O
+ * callback de recepção carimba o quadro com micros() logo na chegada (o t2
+ * e o t4 da sincronia) e o põe numa fila, lida pela tarefa do circuito.
+ */
+#ifndef TRANSPORTE_ESPNOW_H
+#define TRANSPORTE_ESPNOW_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "Circuito.h"
+
+#define CIRCUITO_FILA 16  // Quadros esperando a tarefa do circuito
+
+class TransporteEspNow : public TransporteCircuito {
+public:
+  TransporteEspNow();
+
+  bool iniciar() override;
+  bool enviar(const uint8_t destino[6], const MensagemCircuito& mensagem) override;
+  bool receber(QuadroCircuito& quadro, uint32_t esperaMs) override;
+  uint32_t agoraUs() override { return micros(); }
+  void getMac(uint8_t mac[6]) override;
+
+  uint32_t getDescartados() const { return __atomic_load_n(&descartados, __ATOMIC_RELAXED); }
+
+private:
+  QueueHandle_t fila;
+  bool iniciado;
+  uint8_t mac[6];
+  uint32_t descartados;  // Fila cheia ou quadro de outro tamanho
+
+  bool garantirPar(const uint8_t destino[6]);
+  static void aoReceber(const uint8_t* origem, const uint8_t* dados, int tamanho);
+};
+
+extern TransporteEspNow transporteEspNow;
+
+#endif
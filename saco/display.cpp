@@ -9,22 +9,45 @@
  * - Utiliza a biblioteca Adafruit_SSD1306 para controle de hardware
  * - Implementa um sistema de log com rotação de mensagens
  * - Fornece funções para desenho de setas e exibição de texto
+ * - As setas vêm de glifos pré-calculados (setas.h), copiados de uma vez
  * - Gerencia automaticamente a limpeza e atualização do display
+ * - Rastreia as regiões modificadas por página e envia somente elas,
+ *   usando o endereçamento de coluna/página do SSD1306
  */
 #include "display.h"
+#include "Rastreio.h"
+#include "setas.h"
 
-SetaDisplay::SetaDisplay() : display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1) {
-  centroX = SCREEN_WIDTH / 2;
-  centroY = YELLOW_AREA_HEIGHT + (BLUE_AREA_HEIGHT / 2);
+SetaDisplay setaDisplay;
+
+// Clock igual durante e após as transações da Adafruit: quem define o clock
+// do barramento é o BarramentoI2C
+SetaDisplay::SetaDisplay()
+  : display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1, I2C_FREQUENCIA, I2C_FREQUENCIA) {
+  envioAutomatico = true;
+  limparRegioesSujas();
 }
 
 void SetaDisplay::begin() {
-  if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+  barramentoI2C.iniciar();
+
+  // A inicialização da Adafruit usa o Wire diretamente; o periférico já foi
+  // iniciado pelo BarramentoI2C (periphBegin = false)
+  bool encontrado = false;
+  if (barramentoI2C.adquirir(PrioridadeI2C::Display)) {
+    encontrado = display.begin(SSD1306_SWITCHCAPVCC, ENDERECO_DISPLAY, true, false);
+    if (encontrado) {
+      display.clearDisplay();
+      display.display();
+    }
+    barramentoI2C.liberar(PrioridadeI2C::Display, encontrado ? SCREEN_WIDTH * NUM_PAGINAS : 0);
+  }
+
+  if (!encontrado) {
     Serial.println("Display não encontrado!");
     while (1);
   }
-  display.clearDisplay();
-  display.display();
+  limparRegioesSujas();
   
   display.setTextSize(1);
   display.setTextColor(WHITE);
@@ -32,52 +55,164 @@ void SetaDisplay::begin() {
 
 void SetaDisplay::clear() {
   display.clearDisplay();
+  marcarSujo(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 }
 
 void SetaDisplay::update() {
-  display.display();
+  enviarRegioesSujas();
+}
+
+void SetaDisplay::setEnvioAutomatico(bool ativo) {
+  envioAutomatico = ativo;
+}
+
+void SetaDisplay::finalizarDesenho() {
+  if (envioAutomatico) {
+    enviarRegioesSujas();
+  }
+}
+
+void SetaDisplay::marcarSujo(int x, int y, int w, int h) {
+  // Recorta o retângulo aos limites da tela
+  int x2 = min(x + w, SCREEN_WIDTH) - 1;
+  int y2 = min(y + h, SCREEN_HEIGHT) - 1;
+  x = max(x, 0);
+  y = max(y, 0);
+  if (x > x2 || y > y2) {
+    return;
+  }
+
+  for (int pagina = y / 8; pagina <= y2 / 8; pagina++) {
+    if (colunaSujaInicio[pagina] > colunaSujaFim[pagina]) {
+      colunaSujaInicio[pagina] = x;
+      colunaSujaFim[pagina] = x2;
+    } else {
+      colunaSujaInicio[pagina] = min((int)colunaSujaInicio[pagina], x);
+      colunaSujaFim[pagina] = max((int)colunaSujaFim[pagina], x2);
+    }
+  }
+}
+
+void SetaDisplay::limparRegioesSujas() {
+  for (int pagina = 0; pagina < NUM_PAGINAS; pagina++) {
+    colunaSujaInicio[pagina] = SCREEN_WIDTH - 1;  // inicio > fim: página limpa
+    colunaSujaFim[pagina] = 0;
+  }
+}
+
+void SetaDisplay::enviarComandos(const uint8_t* comandos, uint8_t quantidade) {
+  // Co = 0, D/C = 0: sequência de comandos
+  barramentoI2C.escreverBlocos(ENDERECO_DISPLAY, 0x00, comandos, quantidade, PrioridadeI2C::Display);
+}
+
+void SetaDisplay::ligarPainel(bool ligado) {
+  uint8_t comando = ligado ? SSD1306_DISPLAYON : SSD1306_DISPLAYOFF;
+  enviarComandos(&comando, 1);
+}
+
+void SetaDisplay::enviarDados(const uint8_t* dados, uint16_t quantidade) {
+  // Co = 0, D/C = 1: dados de GDDRAM. O barramento quebra em blocos e cede
+  // a vez às leituras do acelerômetro entre um bloco e outro
+  barramentoI2C.escreverBlocos(ENDERECO_DISPLAY, 0x40, dados, quantidade, PrioridadeI2C::Display);
+}
+
+void SetaDisplay::enviarRegioesSujas() {
+  RASTREIO_TRECHO("display.enviarRegioesSujas");
+  uint8_t* buffer = display.getBuffer();
+  bool enviou = false;
+
+  int pagina = 0;
+  while (pagina < NUM_PAGINAS) {
+    uint8_t inicio = colunaSujaInicio[pagina];
+    uint8_t fim = colunaSujaFim[pagina];
+    if (inicio > fim) {
+      pagina++;
+      continue;
+    }
+
+    // Agrupa páginas consecutivas com a mesma faixa de colunas numa única
+    // janela: no modo de endereçamento horizontal o SSD1306 avança de página
+    // automaticamente ao atingir a última coluna da janela
+    int ultimaPagina = pagina;
+    while (ultimaPagina + 1 < NUM_PAGINAS &&
+           colunaSujaInicio[ultimaPagina + 1] == inicio &&
+           colunaSujaFim[ultimaPagina + 1] == fim) {
+      ultimaPagina++;
+    }
+
+    const uint8_t janela[] = {
+      SSD1306_COLUMNADDR, inicio, fim,
+      SSD1306_PAGEADDR, (uint8_t)pagina, (uint8_t)ultimaPagina
+    };
+    enviarComandos(janela, sizeof(janela));
+
+    uint16_t largura = fim - inicio + 1;
+    if (largura == SCREEN_WIDTH) {
+      // Páginas inteiras são contíguas no framebuffer
+      enviarDados(buffer + pagina * SCREEN_WIDTH, largura * (ultimaPagina - pagina + 1));
+    } else {
+      for (int p = pagina; p <= ultimaPagina; p++) {
+        enviarDados(buffer + p * SCREEN_WIDTH + inicio, largura);
+      }
+    }
+
+    enviou = true;
+    pagina = ultimaPagina + 1;
+  }
+
+  if (enviou) {
+    limparRegioesSujas();
+  }
 }
 
 void SetaDisplay::atualizarAreaAmarela() {
   // Limpa apenas a área de texto, deixando espaço para o símbolo (16px à direita)
   display.fillRect(0, 0, SCREEN_WIDTH - 16, YELLOW_AREA_HEIGHT, BLACK);
+  marcarSujo(0, 0, SCREEN_WIDTH - 16, YELLOW_AREA_HEIGHT);
 }
 
 void SetaDisplay::atualizarAreaAzul() {
   // Limpa apenas a área azul
   display.fillRect(0, YELLOW_AREA_HEIGHT, SCREEN_WIDTH, BLUE_AREA_HEIGHT, BLACK);
+  marcarSujo(0, YELLOW_AREA_HEIGHT, SCREEN_WIDTH, BLUE_AREA_HEIGHT);
 }
 
 void SetaDisplay::seta(int angulo) {
-  // Limpa apenas a área azul
-  atualizarAreaAzul();
-
-  switch (angulo) {
-    case 0:   desenharSetaReta(1); break;
-    case 45:  desenharSetaAngular(45); break;
-    case 90:  desenharSetaReta(0); break;
-    case 135: desenharSetaAngular(135); break;
-    case 180: desenharSetaReta(3); break;
-    case 225: desenharSetaAngular(225); break;
-    case 270: desenharSetaReta(2); break;
-    case 315: desenharSetaAngular(315); break;
+  RASTREIO_TRECHO("display.seta");
+  if (angulo < 0 || angulo >= 360 || angulo % 45 != 0) {
+    // Ângulo sem seta: apenas limpa a área azul
+    atualizarAreaAzul();
+    finalizarDesenho();
+    return;
   }
-
-  display.display();
+  desenharGlifo(angulo / 45);
 }
 
 void SetaDisplay::seta(const char* tipo) {
-  // Limpa apenas a área azul
-  atualizarAreaAzul();
-
+  RASTREIO_TRECHO("display.seta");
   if (strcmp(tipo, "f") == 0) {
-    desenharSetaFrente();
+    desenharGlifo(GLIFO_SETA_CENTRO);
+  } else {
+    atualizarAreaAzul();
+    finalizarDesenho();
   }
+}
 
-  display.display();
+void SetaDisplay::desenharGlifo(int indice) {
+  // O glifo cobre a área azul inteira (inclusive o fundo), então uma única
+  // cópia substitui a limpeza e todo o desenho
+  uint8_t* areaAzul = display.getBuffer() + (YELLOW_AREA_HEIGHT / 8) * SCREEN_WIDTH;
+  memcpy_P(areaAzul, GLIFOS_SETA[indice], TAMANHO_GLIFO_SETA);
+  marcarSujo(0, YELLOW_AREA_HEIGHT, SCREEN_WIDTH, BLUE_AREA_HEIGHT);
+  finalizarDesenho();
 }
 
 void SetaDisplay::printlog(String mensagem) {
+  registrarLog(mensagem);
+  mostrarLog();
+}
+
+void SetaDisplay::registrarLog(String mensagem) {
   // Adiciona a nova mensagem no início do vetor (log mais recente primeiro)
   logMessages.insert(logMessages.begin(), mensagem);
   
@@ -85,7 +220,9 @@ void SetaDisplay::printlog(String mensagem) {
   if (logMessages.size() > MAX_LOG_LINES) {
     logMessages.pop_back(); // Remove a mensagem mais antiga
   }
-  
+}
+
+void SetaDisplay::mostrarLog() {
   // Limpa apenas a área azul
   atualizarAreaAzul();
   display.setTextSize(1);
@@ -96,7 +233,7 @@ void SetaDisplay::printlog(String mensagem) {
     display.println(logMessages[i]);
   }
   
-  display.display();
+  finalizarDesenho();
 }
 
 void SetaDisplay::print(String mensagem) {
@@ -129,7 +266,8 @@ void SetaDisplay::print(String mensagem) {
 
   display.setCursor(x, y);
   display.println(textoFinal);
-  display.display();
+  marcarSujo(x, y, w, h);
+  finalizarDesenho();
 }
 
 
@@ -149,7 +287,7 @@ void SetaDisplay::printazul(String mensagem) {
   
   display.setCursor(x, y);
   display.println(mensagem);
-  display.display();
+  finalizarDesenho();
 }
 
 void SetaDisplay::showtime(String timestamp) {
@@ -168,105 +306,18 @@ void SetaDisplay::showtime(String timestamp) {
   
   display.setCursor(x, y);
   display.println(timestamp);
-  display.display();
-}
-
-void SetaDisplay::desenharLinhaEspessa(int x1, int y1, int x2, int y2) {
-  display.drawLine(x1, y1, x2, y2, WHITE);
-  
-  if (x1 == x2) {
-    display.drawLine(x1+1, y1, x2+1, y2, WHITE);
-  } else if (y1 == y2) {
-    display.drawLine(x1, y1+1, x2, y2+1, WHITE);
-  } else {
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float length = sqrt(dx*dx + dy*dy);
-    float perpx = -dy/length;
-    float perpy = dx/length;
-    
-    display.drawLine(x1 + perpx, y1 + perpy, x2 + perpx, y2 + perpy, WHITE);
-  }
-}
-
-void SetaDisplay::desenharSetaReta(int modo) {
-  int metadeComprimento = SETA_COMPRIMENTO / 2;
-  int comprimentoPonta = 10;
-  int larguraBase = 8;
-
-  if (modo == 0) {
-    desenharLinhaEspessa(centroX - metadeComprimento, centroY, 
-                         centroX + metadeComprimento - comprimentoPonta, centroY);
-    display.fillTriangle(centroX + metadeComprimento, centroY,
-                         centroX + metadeComprimento - comprimentoPonta, centroY - larguraBase,
-                         centroX + metadeComprimento - comprimentoPonta, centroY + larguraBase,
-                         WHITE);
-  } else if (modo == 1) {
-    desenharLinhaEspessa(centroX, centroY + metadeComprimento, 
-                         centroX, centroY - metadeComprimento + comprimentoPonta);
-    display.fillTriangle(centroX, centroY - metadeComprimento,
-                         centroX - larguraBase, centroY - metadeComprimento + comprimentoPonta,
-                         centroX + larguraBase, centroY - metadeComprimento + comprimentoPonta,
-                         WHITE);
-  } else if (modo == 2) {
-    desenharLinhaEspessa(centroX + metadeComprimento, centroY, 
-                         centroX - metadeComprimento + comprimentoPonta, centroY);
-    display.fillTriangle(centroX - metadeComprimento, centroY,
-                         centroX - metadeComprimento + comprimentoPonta, centroY - larguraBase,
-                         centroX - metadeComprimento + comprimentoPonta, centroY + larguraBase,
-                         WHITE);
-  } else if (modo == 3) {
-    desenharLinhaEspessa(centroX, centroY - metadeComprimento, 
-                         centroX, centroY + metadeComprimento - comprimentoPonta);
-    display.fillTriangle(centroX, centroY + metadeComprimento,
-                         centroX - larguraBase, centroY + metadeComprimento - comprimentoPonta,
-                         centroX + larguraBase, centroY + metadeComprimento - comprimentoPonta,
-                         WHITE);
-  }
-}
-
-void SetaDisplay::desenharSetaAngular(int angulo) {
-  int metadeComprimento = SETA_COMPRIMENTO / 2;
-  int comprimentoPonta = 10;
-  int larguraBase = 8;
-
-  float radianos = angulo * M_PI / 180.0;
-  float cos_theta = cos(radianos);
-  float sin_theta = sin(radianos);
-
-  int inicioX = centroX - metadeComprimento * cos_theta;
-  int inicioY = centroY + metadeComprimento * sin_theta;
-  int baseX = centroX + (metadeComprimento - comprimentoPonta) * cos_theta;
-  int baseY = centroY - (metadeComprimento - comprimentoPonta) * sin_theta;
-
-  int verticeX = centroX + metadeComprimento * cos_theta;
-  int verticeY = centroY - metadeComprimento * sin_theta;
-
-  float perpX = -sin_theta;
-  float perpy = -cos_theta;
-
-  int base1X = baseX + larguraBase * perpX;
-  int base1Y = baseY + larguraBase * perpy;
-  int base2X = baseX - larguraBase * perpX;
-  int base2Y = baseY - larguraBase * perpy;
-
-  desenharLinhaEspessa(inicioX, inicioY, baseX, baseY);
-  display.fillTriangle(verticeX, verticeY, base1X, base1Y, base2X, base2Y, WHITE);
-}
-
-void SetaDisplay::desenharSetaFrente() {
-  display.drawCircle(centroX, centroY, 12, WHITE);
-  display.drawCircle(centroX, centroY, 11, WHITE);
-  display.fillCircle(centroX, centroY, 3, WHITE);
+  marcarSujo(x, y, w, h);
+  finalizarDesenho();
 }
 
 void SetaDisplay::setStatus(int status) {
   // Limpa apenas a área do símbolo (canto superior direito)
   display.fillRect(SCREEN_WIDTH - 16, 0, 16, YELLOW_AREA_HEIGHT, BLACK);
   
-  // Desenha o símbolo correspondente
+  // Desenha o símbolo correspondente (o ✓✓ encosta na primeira linha da área azul)
   desenharSimboloStatus(status);
-  display.display();
+  marcarSujo(SCREEN_WIDTH - 16, 0, 16, YELLOW_AREA_HEIGHT + 1);
+  finalizarDesenho();
 }
 
 void SetaDisplay::desenharSimboloStatus(int status) {
@@ -302,6 +353,7 @@ void SetaDisplay::desenharSimboloStatus(int status) {
 void SetaDisplay::showtimeCompact(String timestamp) {
   // Atualiza apenas a área de texto (deixando espaço para o símbolo)
   display.fillRect(0, 0, SCREEN_WIDTH - 18, YELLOW_AREA_HEIGHT, BLACK);
+  marcarSujo(0, 0, SCREEN_WIDTH - 18, YELLOW_AREA_HEIGHT);
   
   display.setTextSize(1);
   display.setTextColor(WHITE);
@@ -316,5 +368,6 @@ void SetaDisplay::showtimeCompact(String timestamp) {
   
   display.setCursor(x, y);
   display.println(timestamp);
-  display.display();
+  marcarSujo(x, y, w, h);
+  finalizarDesenho();
 }
\ No newline at end of file
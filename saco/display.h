@@ -10,9 +10,11 @@
  * - Sistema de log com rotação de mensagens
  * - Exibição de mensagens centralizadas em fonte grande
  * - Controle completo do display OLED
+ * - Envio parcial do framebuffer: apenas as páginas/colunas modificadas
+ *   desde o último envio são transmitidas pelo I2C
  * 
  * @section dependencies Dependências
- * - Wire.h
+ * - Wire.h (através do BarramentoI2C)
  * - Adafruit_GFX.h
  * - Adafruit_SSD1306.h
  * - vector (para armazenamento de logs)
@@ -30,6 +32,7 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "BarramentoI2C.h"
 #include <math.h>
 #include <vector>
 #include <string>
@@ -39,19 +42,28 @@
 #define YELLOW_AREA_HEIGHT 16
 #define BLUE_AREA_HEIGHT 48
 #define MAX_LOG_LINES 6
-#define SETA_COMPRIMENTO 47
+#define SETA_COMPRIMENTO 47  // Usado por ferramentas/gerar_setas.py (setas.h)
+#define ENDERECO_DISPLAY 0x3C
+#define NUM_PAGINAS (SCREEN_HEIGHT / 8)   // Páginas de 8 linhas do SSD1306
 
 class SetaDisplay {
   private:
     Adafruit_SSD1306 display;
-    int centroX;
-    int centroY;
     std::vector<String> logMessages;
+    bool envioAutomatico;  // false: os métodos só desenham no framebuffer
     
-    void desenharSetaReta(int modo);
-    void desenharSetaAngular(int angulo);
-    void desenharSetaFrente();
-    void desenharLinhaEspessa(int x1, int y1, int x2, int y2);
+    // Região suja por página: colunas [inicio, fim] ainda não enviadas ao display.
+    // inicio > fim indica página limpa.
+    uint8_t colunaSujaInicio[NUM_PAGINAS];
+    uint8_t colunaSujaFim[NUM_PAGINAS];
+    
+    void marcarSujo(int x, int y, int w, int h);
+    void limparRegioesSujas();
+    void enviarRegioesSujas();
+    void enviarComandos(const uint8_t* comandos, uint8_t quantidade);
+    void enviarDados(const uint8_t* dados, uint16_t quantidade);
+    void finalizarDesenho();
+    void desenharGlifo(int indice);
     void atualizarAreaAmarela();
     void atualizarAreaAzul();
     void desenharSimboloStatus(int status);
@@ -59,17 +71,26 @@ class SetaDisplay {
     SetaDisplay();
     void begin();
     void clear();
-    void update();
+    void update();  // Envia ao display apenas as regiões modificadas
     
     // Funções principais
     void seta(int angulo);
     void seta(const char* tipo);
     void printlog(String mensagem);
+    void registrarLog(String mensagem);  // Só adiciona ao histórico, sem desenhar
+    void mostrarLog();                   // Desenha o histórico na área azul
     void print(String mensagem);
     void printazul(String mensagem);
     void showtime(String timestamp);
     void setStatus(int status); // 1: desconectado, 2: conectado Firebase, 3: app conectado
+    void ligarPainel(bool ligado); // Apagado, a GDDRAM é mantida e o painel quase não consome
   void showtimeCompact(String timestamp); // Nova função para tempo compacto
+    
+    // Com envio automático desligado os métodos acima apenas desenham no
+    // framebuffer (buffer de fundo); update() envia o resultado acumulado
+    void setEnvioAutomatico(bool ativo);
 };
 
+extern SetaDisplay setaDisplay;
+
 #endif  
\ No newline at end of file
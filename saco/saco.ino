@@ -6,29 +6,54 @@
  #include "Conexao.h"
  #include "Sensores.h"
  #include "display.h"
+ #include "ServicoDisplay.h"
+ #include "Modos.h"
+ #include "Traco.h"
+ #include "Bancada.h"
+ #include "Captura.h"
+ #include "Metricas.h"
+ #include "Round.h"
+ #include "Classificador.h"
+ #include "Energia.h"
+ #include "DeteccaoToque.h"
+ #include "Boot.h"
+ #include "Log.h"
+ #include "Rastreio.h"
+ #include "Circuito.h"
+ #include "TransporteEspNow.h"
+ #include "Ota.h"
+ #include <LittleFS.h>
  #include <freertos/semphr.h>
  
  // Definições de pinos
  #define PINO_LED 15
  #define ENDERECO_MPU6500 0x68
  
- uint32_t tempoPisca = 1500;
+ // Precisão, agilidade e circuito: uma borda que começou antes do estímulo
+ // é largada queimada; o aviso fica no painel por este tempo antes de rearmar
+ #define LARGADA_QUEIMADA_MS 1500
+ 
+ // Gravação de traços: IMU a cada tick (1 ms), toques a cada 10
+ #define TAXA_TRACO_IMU_HZ 1000
+ #define TAXA_TRACO_TOQUE_HZ 100
+ #define DURACAO_TRACO_PADRAO_S 10
  
- enum class Estado {
-   Inicial,
-   Forca,
-   Agilidade,
-   Calibrar,
-   Precisao
- };
+ // Mede as rotinas críticas (Bancada.h) em vez de iniciar o saco.
+ // Descomente ou compile com -DMODO_BANCADA
+ //#define MODO_BANCADA
+ 
+ uint32_t tempoPisca = 1500;
  
  // Variáveis globais
  Estado estadoAtual = Estado::Inicial;
  SemaphoreHandle_t xEstadoMutex;
  
- // Instância do display OLED
- SetaDisplay setaDisplay;
- SemaphoreHandle_t xDisplayMutex;
+ // Circuito (Circuito.h): o saco coordena com o comando do app ou adere
+ // ao anúncio de um vizinho. Como vizinho fica "disponivel" no Firebase sem
+ // sair do modo (protegido por xEstadoMutex)
+ ParticipanteCircuito participanteCircuito(transporteEspNow);
+ CoordenadorCircuito coordenadorCircuito(transporteEspNow, participanteCircuito);
+ bool circuitoComoVizinho = false;
  
  /**
   * @brief Tarefa que serve para indicar em que estado o programa se encontra.
@@ -45,7 +70,10 @@
        vTaskDelay(tempoPisca / portTICK_PERIOD_MS);
        digitalWrite(PINO_LED, LOW);
      }
-     if (estadoLocal != Estado::Inicial) {
+     else if (estadoLocal == Estado::Ocioso) {
+       digitalWrite(PINO_LED, LOW);
+     }
+     else {
        digitalWrite(PINO_LED, HIGH);
      }
  
@@ -59,12 +87,40 @@
  void tarefaDataHora(void* arg) {
     while (1) {
       vTaskDelay(4000/ portTICK_PERIOD_MS);
+      // Com o painel apagado não há o que redesenhar
+      xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+      bool ocioso = (estadoAtual == Estado::Ocioso);
+      xSemaphoreGive(xEstadoMutex);
+      if (ocioso) continue;
       String dataHora = conexao.getTimeString();
-      xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-      setaDisplay.showtimeCompact(dataHora);
-      xSemaphoreGive(xDisplayMutex);
+      servicoDisplay.hora(dataHora);
     }
  }
+ /**
+  * @brief Aponta no display o pad de número `pad` (1 a NUM_SENSORES), com a
+  * seta do descritor da placa
+  */
+ void mostrarSetaPad(int pad) {
+   int16_t angulo = PlacaAtual::setas[pad - 1];
+   if (angulo == SETA_CENTRO) {
+     servicoDisplay.setaCentro();
+   } else {
+     servicoDisplay.seta(angulo);
+   }
+ }
+
+ /**
+  * @brief mostrarSetaPad() como estímulo (ServicoDisplay.h): nunca é
+  * descartada e devolve o micros() em que chegou ao painel
+  */
+ uint32_t estimuloPad(int pad, bool aguardar) {
+   int16_t angulo = PlacaAtual::setas[pad - 1];
+   if (angulo == SETA_CENTRO) {
+     return servicoDisplay.estimuloSetaCentro(aguardar);
+   }
+   return servicoDisplay.estimuloSeta(angulo, aguardar);
+ }
+
  /**
   * @brief Tarefa para calibração dos sensores
   */
@@ -80,23 +136,17 @@ void tarefaCalibra(void* arg) {
             // Obter o sensor específico a calibrar
             int sensorParaCalibrar = conexao.getSensorCalibracao();
             
-            if (sensorParaCalibrar >= 1 && sensorParaCalibrar <= 9) {
+            if (sensorParaCalibrar >= 1 && sensorParaCalibrar <= NUM_SENSORES) {
                 // Sensor mudou? Atualizar display
                 if (sensorParaCalibrar != ultimoSensor) {
-                    xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-                    if (sensorParaCalibrar == 9) {
-                        setaDisplay.seta("f");  // Centro
-                    } else {
-                        setaDisplay.seta((sensorParaCalibrar - 1) * 45);
-                    }
-                    xSemaphoreGive(xDisplayMutex);
+                    mostrarSetaPad(sensorParaCalibrar);
                     ultimoSensor = sensorParaCalibrar;
                 }
                 
                 // Informar início da calibração
                 conexao.updateDeviceEx();  
                 
-                // Calibrar sensor específico (convertendo 1-9 para 0-8)
+                // Calibrar sensor específico (convertendo de 1-N para 0-(N-1))
                 bool sucesso = sensores.calibrarSensorIndividual(sensorParaCalibrar - 1);
                 
                 // Informar resultado
@@ -104,6 +154,8 @@ void tarefaCalibra(void* arg) {
                     conexao.updateDevicemMdicoes("concluida");
                     // Marcar sensor como calibrado
                     conexao.sendSensorCalibrated(sensorParaCalibrar);
+                    // Gravar para o próximo boot não depender da rede
+                    sensores.salvarCalibracao();
                 } else {
                     conexao.updateDevicemMdicoes("erro");
                 }
@@ -117,27 +169,48 @@ void tarefaCalibra(void* arg) {
 }
 
 
+/**
+ * @brief Volta ao estado inicial; cada tarefa de modo vê a troca e sai
+ */
+static void pararModo(const char* motivo) {
+  LOG_INFO(Modos, "%s", motivo);
+  xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+  estadoAtual = Estado::Inicial;
+  xSemaphoreGive(xEstadoMutex);
+  servicoDisplay.texto("PRONTO");
+}
+
   /**
  * @brief Tarefa para gerenciar a comunicação com Firebase - Versão Refatorada
  */
 void tarefaComunicacao(void* arg) {
   unsigned long ultimaAtualizacaoHora = 0;
   int ultimoStatus = 1; // Inicia como desconectado
+  bool relatorioEnviado = false;  // Relatório do boot, uma vez
   
   while (1) {
-    // Verificar se está conectado ao Firebase
-    bool conectado = conexao.isConnected();
+    // Verificar se está conectado ao Firebase; sem o bit o dispositivo
+    // ainda não foi registrado, mesmo que o WiFi tenha voltado sozinho
+    bool conectado = boot.pronto(BOOT_FIREBASE) && conexao.isConnected();
     
     if (!conectado) {
-      // Tentar reconectar
+      // No boot a rede sobe aqui, com os modos locais já rodando; depois é
+      // a reconexão
+      boot.limpar(BOOT_WIFI | BOOT_FIREBASE);
       conexao.begin();
-      
+      conectado = conexao.isConnected();
+      if (conectado && !relatorioEnviado) {
+        boot.relatorio(Serial);
+        relatorioEnviado = conexao.sendBootReport();
+        servicoDisplay.log("Conexões OK");
+      }
+    }
+    
+    if (!conectado) {
       // Atualizar status para desconectado se necessário
       if (ultimoStatus != 1) {
-        xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-        setaDisplay.setStatus(1);
-        setaDisplay.printlog("Reconectando...");
-        xSemaphoreGive(xDisplayMutex);
+        servicoDisplay.status(1);
+        servicoDisplay.log("Reconectando...");
         ultimoStatus = 1;
       }
       
@@ -145,77 +218,105 @@ void tarefaComunicacao(void* arg) {
       continue;
     }
     
+    // Com o stream de comandos só lê o nó quando ele mudou
+    if (!conexao.hasRemoteChanges()) {
+      vTaskDelay(1000 / portTICK_PERIOD_MS);
+      continue;
+    }
+    
     // Se conectado, verificar o estado do dispositivo
     String estadoDispositivo = conexao.getDeviceState();
     
     // Atualizar o status de conexão no display
     if (estadoDispositivo == "ocupado" && ultimoStatus != 3) {
-      xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-      setaDisplay.setStatus(3); // App conectado
-      xSemaphoreGive(xDisplayMutex);
+      servicoDisplay.status(3); // App conectado
       ultimoStatus = 3;
     } 
     else if (estadoDispositivo == "disponivel" && ultimoStatus != 2) {
-      xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-      setaDisplay.setStatus(2); // Conectado ao Firebase
-      xSemaphoreGive(xDisplayMutex);
+      servicoDisplay.status(2); // Conectado ao Firebase
       ultimoStatus = 2;
     }
     else if (estadoDispositivo == "manutencao" && ultimoStatus != 4) {
-      xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-      setaDisplay.setStatus(4); // Modo manutenção
-      xSemaphoreGive(xDisplayMutex);
+      servicoDisplay.status(4); // Modo manutenção
       ultimoStatus = 4;
     }
     
+    xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+    bool emModo = (estadoAtual != Estado::Inicial && estadoAtual != Estado::Ocioso);
+    bool vizinhoCircuito = circuitoComoVizinho;
+    xSemaphoreGive(xEstadoMutex);
+    
     // Só verificar comandos se o dispositivo estiver ocupado
     if (estadoDispositivo == "ocupado") {
-      if (conexao.checkForCommands()) {
+      // App conectado: o saco está em uso e não entra no modo ocioso
+      energia.registrarAtividade();
+      
+      // Um modo em andamento para com "parar" ou com o nó de entrada apagado
+      if (emModo && conexao.checkForStopCommand()) {
+        pararModo("Modo interrompido pelo app");
+      } else if (conexao.checkForCommands()) {
         Medicao medicao = conexao.getCurrentMeasurement();  
         
         if (conexao.updateDeviceEx()) { 
-          Serial.print("Comando recebido: ");
-          Serial.println(medicao.tipo);
+          LOG_INFO(Conexao, "Comando recebido: %s", nomeTipoMedicao(medicao.tipo));
           
-          // Obter todos os mutexes necessários primeiro
-          xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
           
           // Processar o tipo de medição uma única vez
-          if (medicao.tipo == "forca") {
-            setaDisplay.printazul("FORCA");
-            estadoAtual = Estado::Forca;
-          } 
-          else if (medicao.tipo == "precisao") {
-            setaDisplay.printazul("PRECISAO");
-            estadoAtual = Estado::Precisao;
-          } 
-          else if (medicao.tipo == "tempo_reacao") {
-            setaDisplay.printazul("AGILIDADE");
-            estadoAtual = Estado::Agilidade;
-          } 
-          else if (medicao.tipo == "tCalibrar") {
-            setaDisplay.printazul("CALIBRAR");
-            estadoAtual = Estado::Calibrar;
+          switch (medicao.tipo) {
+            case TipoMedicao::Forca:
+              servicoDisplay.banner("FORCA");
+              estadoAtual = Estado::Forca;
+              break;
+            case TipoMedicao::Precisao:
+              servicoDisplay.banner("PRECISAO");
+              estadoAtual = Estado::Precisao;
+              break;
+            case TipoMedicao::TempoReacao:
+              servicoDisplay.banner("AGILIDADE");
+              estadoAtual = Estado::Agilidade;
+              break;
+            case TipoMedicao::Calibrar:
+              servicoDisplay.banner("CALIBRAR");
+              estadoAtual = Estado::Calibrar;
+              break;
+            case TipoMedicao::Gravacao:
+              servicoDisplay.banner("GRAVANDO");
+              estadoAtual = Estado::Gravacao;
+              break;
+            case TipoMedicao::Round:
+              servicoDisplay.banner("ROUND");
+              estadoAtual = Estado::Round;
+              break;
+            case TipoMedicao::Circuito:
+              servicoDisplay.banner("CIRCUITO");
+              estadoAtual = Estado::Circuito;
+              break;
+            default:
+              break;
           }
           
-          // Liberar mutexes
           xSemaphoreGive(xEstadoMutex);
-          xSemaphoreGive(xDisplayMutex);
         }
       }
+    } else if (emModo && !vizinhoCircuito && estadoDispositivo == "disponivel") {
+      // O app liberou o saco, ou o registro de uma reconexão refez o nó
+      pararModo("Modo sem app, parado");
     }
     
-    
-    
     vTaskDelay(1000 / portTICK_PERIOD_MS);
   }
 }
  
  /**
   * @brief Tarefa que estuda o tempo de reação do usuario
+  *
+  * A reação é medida até o início da borda do toque (DeteccaoToque.h), o
+  * que não depende da luva nem do pad; o instante em que o sinal cruza o
+  * limite vai junto, em saida/toque.
   */
  void tarefaAgilidade(void* arg) {
+   static DetectorToques detector("agilidade.toque");
    
    while (1) {
      xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
@@ -223,47 +324,77 @@ void tarefaComunicacao(void* arg) {
      xSemaphoreGive(xEstadoMutex);
      
      if (estadoLocal == Estado::Agilidade) {
-       xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-       setaDisplay.printazul("Prepare-se...");
-      
-       int intervalo = random(2000, 7000);
-       delay(intervalo);
-       setaDisplay.printazul("Ataque");  
-       xSemaphoreGive(xDisplayMutex);
-       unsigned long tempoInicio = millis();
+       Medicao medicao = conexao.getCurrentMeasurement();
+       EventoToque evento;
+       uint32_t tempoInicioUs = 0;
        int sensorTocado = -1;
-       while (sensorTocado < 0) {
-         sensorTocado = sensores.detectarToque();
-         vTaskDelay(10 / portTICK_PERIOD_MS);
-         // Verificar se ainda está no modo agilidade
-         xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
-         bool aindaNoModo = (estadoAtual == Estado::Agilidade);
-         xSemaphoreGive(xEstadoMutex);
-         if (!aindaNoModo) {
-           break; // Sai se o modo foi alterado
+       bool aindaNoModo = true;
+       
+       // Uma largada queimada não tem resultado: nova espera e novo "Ataque"
+       while (sensorTocado < 0 && aindaNoModo) {
+         servicoDisplay.banner("Prepare-se...");
+         
+         // Os pads seguem amostrados na espera: o detector chega ao "Ataque"
+         // com base e ruído em dia, e um toque antes dele é ignorado
+         int intervalo = random(2000, 7000);
+         unsigned long inicioEspera = millis();
+         {
+           RASTREIO_TRECHO("agilidade.espera");
+           while (millis() - inicioEspera < (unsigned long)intervalo) {
+             detector.aguardar(sensores, intervalo - (millis() - inicioEspera), evento);
+           }
+         }
+         // A contagem começa com o "Ataque" no painel, não na fila
+         tempoInicioUs = servicoDisplay.estimuloBanner("Ataque");
+         RASTREIO_INSTANTE("agilidade.ataque");
+         while (sensorTocado < 0) {
+           sensorTocado = detector.aguardar(sensores, 100, evento);
+           // Verificar se ainda está no modo agilidade
+           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+           aindaNoModo = (estadoAtual == Estado::Agilidade);
+           xSemaphoreGive(xEstadoMutex);
+           if (!aindaNoModo) {
+             break; // Sai se o modo foi alterado
+           }
+         }
+         
+         if (sensorTocado >= 0 && (int32_t)(evento.inicioUs - tempoInicioUs) < 0) {
+           // A borda começou antes do "Ataque": a luva já vinha vindo
+           LOG_INFO(Modos, "Largada queimada no pad %d, %ld ms antes do estimulo", sensorTocado,
+                    (long)((tempoInicioUs - evento.inicioUs) / 1000));
+           servicoDisplay.banner("QUEIMOU");
+           vTaskDelay(LARGADA_QUEIMADA_MS / portTICK_PERIOD_MS);
+           sensorTocado = -1;
+           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+           aindaNoModo = (estadoAtual == Estado::Agilidade);
+           xSemaphoreGive(xEstadoMutex);
          }
        }
        
        if (sensorTocado >= 0) {
-         float tempoReacao = (millis() - tempoInicio) / 1000.0;
+         float tempoReacao = (int32_t)(evento.inicioUs - tempoInicioUs) / 1000000.0;
+         float tempoCruzamento = (int32_t)(evento.cruzamentoUs - tempoInicioUs) / 1000000.0;
          
          // Enviar resultado
-         conexao.setMeasurementResult(tempoReacao);
-         conexao.updateDevicemMdicoes("concluida");
+         {
+           RASTREIO_TRECHO("agilidade.envio");
+           conexao.setReactionResult(tempoReacao, tempoCruzamento, sensorTocado);
+           conexao.updateDevicemMdicoes("concluida");
+           conexao.updateUserSummary(medicao.usuario, "tempo_reacao", tempoReacao, false);
+         }
          
          // Mostrar resultado no display
-         xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-         setaDisplay.printazul("Tempo: " + String(tempoReacao) + "s");
-         xSemaphoreGive(xDisplayMutex);
+         servicoDisplay.banner("Tempo: " + String(tempoReacao) + "s");
        }
        
+       // Parado no meio, outro comando pode já ter trocado o modo
        xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
-       estadoAtual = Estado::Inicial;
+       if (estadoAtual == Estado::Agilidade) {
+         estadoAtual = Estado::Inicial;
+       }
        xSemaphoreGive(xEstadoMutex);
        
-       xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-       setaDisplay.print("PRONTO");
-       xSemaphoreGive(xDisplayMutex);
+       servicoDisplay.texto("PRONTO");
      }
      vTaskDelay(100 / portTICK_PERIOD_MS);
    }
@@ -274,8 +405,10 @@ void tarefaComunicacao(void* arg) {
  * Agora a interface web controla a sequência de LEDs
  */
 void tarefaPrecisao(void* arg) {
+    static DetectorToques detector("precisao.toque");
     int ultimoLed = -1;
-    unsigned long tempoInicio = 0;
+    uint32_t tempoInicioUs = 0;
+    String usuario;
     
     while (1) {
         xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
@@ -286,42 +419,59 @@ void tarefaPrecisao(void* arg) {
             // Obter o LED específico a ser acionado
             int ledParaAcender = conexao.getLedPrecisao();
             
-            if (ledParaAcender >= 1 && ledParaAcender <= 9) {
+            if (ledParaAcender >= 1 && ledParaAcender <= NUM_SENSORES) {
                 // LED mudou? Atualizar display
                 if (ledParaAcender != ultimoLed) {
-                    xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-                    if (ledParaAcender == 9) {
-                        setaDisplay.seta("f");  // Centro
-                    } else {
-                        setaDisplay.seta((ledParaAcender - 1) * 45);
-                    }
-                    setaDisplay.printazul("PRECISÃO");
-                    xSemaphoreGive(xDisplayMutex);
+                    usuario = conexao.getCurrentMeasurement().usuario;
+                    // Na área amarela, para não apagar a seta da área azul
+                    servicoDisplay.texto("PRECISAO");
                     ultimoLed = ledParaAcender;
-                    tempoInicio = millis();
+                    tempoInicioUs = estimuloPad(ledParaAcender, true);
                 }
                 
-                // Aguardar toque no sensor
-                int sensorTocado = sensores.detectarToque();
+                // Aguardar toque no sensor (pads a cada 10 ms por 50 ms)
+                EventoToque evento;
+                int sensorTocado;
+                {
+                    RASTREIO_TRECHO("precisao.espera");
+                    sensorTocado = detector.aguardar(sensores, 50, evento);
+                }
                 
-                if (sensorTocado >= 0) {
-                    // Calcular tempo de resposta
-                    unsigned long tempoResposta = millis() - tempoInicio;
+                // Tempo de resposta até o início da borda do toque
+                int32_t respostaUs = (int32_t)(evento.inicioUs - tempoInicioUs);
+                if (sensorTocado >= 0 && respostaUs < 0) {
+                    // A borda começou antes do LED: sem resultado nem resumo,
+                    // e o mesmo LED volta a acender depois do aviso
+                    LOG_INFO(Modos, "Largada queimada no pad %d, %ld ms antes do estimulo",
+                             sensorTocado, (long)(-respostaUs / 1000));
+                    servicoDisplay.banner("QUEIMOU");
+                    vTaskDelay(LARGADA_QUEIMADA_MS / portTICK_PERIOD_MS);
+                    ultimoLed = -1;
+                } else if (sensorTocado >= 0) {
+                    unsigned long tempoResposta = respostaUs / 1000;
+                    int32_t cruzamentoUs = (int32_t)(evento.cruzamentoUs - tempoInicioUs);
+                    unsigned long tempoCruzamento = cruzamentoUs > 0 ? cruzamentoUs / 1000 : 0;
                     
-                    // Determinar se foi acerto (sensor indexado 0-8, LED 1-9)
+                    // Determinar se foi acerto (sensor indexado de 0, LED de 1)
                     bool acerto = (sensorTocado == (ledParaAcender - 1));
                     
                     // Enviar resultado para Firebase
-                    conexao.sendPrecisionResult(acerto, tempoResposta, sensorTocado, ledParaAcender);
+                    {
+                        RASTREIO_TRECHO("precisao.envio");
+                        conexao.sendPrecisionResult(acerto, tempoResposta, sensorTocado, ledParaAcender,
+                                                    tempoCruzamento);
+                        // O resumo da precisão é o tempo de resposta dos acertos
+                        if (acerto) {
+                            conexao.updateUserSummary(usuario, "precisao", tempoResposta, false);
+                        }
+                    }
                     
                     // Feedback visual no display
-                    xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
                     if (acerto) {
-                        setaDisplay.printazul("ACERTOU!");
+                        servicoDisplay.banner("ACERTOU!");
                     } else {
-                        setaDisplay.printazul("ERROU!");
+                        servicoDisplay.banner("ERROU!");
                     }
-                    xSemaphoreGive(xDisplayMutex);
                     
                     // Pequena pausa para feedback
                     vTaskDelay(1000 / portTICK_PERIOD_MS);
@@ -329,8 +479,10 @@ void tarefaPrecisao(void* arg) {
                     // Preparar para próximo LED
                     ultimoLed = -1;
                 }
+            } else {
+                // Sem LED (ou sem rede): espera em vez de girar e tomar a CPU
+                vTaskDelay(TOQUE_PERIODO_MS * 10 / portTICK_PERIOD_MS);
             }
-            vTaskDelay(50 / portTICK_PERIOD_MS);
         } else {
             ultimoLed = -1; // Reset quando sair do modo precisão
             vTaskDelay(1000 / portTICK_PERIOD_MS);
@@ -340,6 +492,13 @@ void tarefaPrecisao(void* arg) {
  
  /**
   * @brief Tarefa que estuda a força do soco
+  *
+  * A medição começa no golpe, não num temporizador: a captura (Captura.h)
+  * monitora o MPU6500 até o impacto e só a janela em torno dele é
+  * analisada. Sem golpe em CAPTURA_ESPERA_MS o resultado é 0.
+  * O "valor" continua sendo o do espectro; as métricas físicas do golpe
+  * (Metricas.h) e o tipo do golpe (Classificador.h) vão ao lado, em
+  * saida/metricas.
   */
 void tarefaForca(void* arg) {
    while (1) {
@@ -348,38 +507,612 @@ void tarefaForca(void* arg) {
      xSemaphoreGive(xEstadoMutex);
      
      if (estadoLocal == Estado::Forca) {
-       xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-       setaDisplay.printazul("BATA");
-       xSemaphoreGive(xDisplayMutex);
+       Medicao medicao = conexao.getCurrentMeasurement();
+       servicoDisplay.banner("BATA");
        
-       float forca = sensores.calcularForca();
+       float fatorNewtons = conexao.getForceScale();
+       float forca = 0;
+       MetricasGolpe metricas;
+       memset(&metricas, 0, sizeof(metricas));
+       TipoGolpe tipo = TipoGolpe::Desconhecido;
+       bool golpe;
+       {
+         RASTREIO_TRECHO("forca.espera");
+         golpe = captura.aguardarGolpe(sensores, CAPTURA_ESPERA_MS);
+       }
+       if (golpe) {
+         forca = captura.analisarForca();
+         metricas = calcularMetricas(captura, fatorNewtons);
+         float caracteristicas[NUM_CARACTERISTICAS];
+         extrairCaracteristicas(captura, captura.getPad(), caracteristicas);
+         tipo = classificadorGolpes.classificar(caracteristicas);
+         servicoDisplay.banner("F: " + String(forca));
+         LOG_INFO(Modos, "Golpe: %s, %.1f g, %.3f g.s, subida %.1f ms, eixo %s", nomeTipoGolpe(tipo),
+                  metricas.picoG, metricas.impulsoGs, metricas.subidaMs, metricas.eixo);
+       } else {
+         LOG_INFO(Modos, "Nenhum golpe detectado");
+         servicoDisplay.banner("SEM GOLPE");
+       }
        
-       // Enviar resultado
-       conexao.setMeasurementResult(forca);
-       conexao.updateDevicemMdicoes("concluida");
+       // Enviar resultado, a menos que o app tenha parado o modo na espera
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       bool aindaNoModo = (estadoAtual == Estado::Forca);
+       xSemaphoreGive(xEstadoMutex);
+       if (aindaNoModo) {
+         RASTREIO_TRECHO("forca.envio");
+         conexao.setMeasurementResult(forca, metricas, tipo);
+         conexao.updateDevicemMdicoes("concluida");
+         if (golpe) {
+           conexao.updateUserSummary(medicao.usuario, "forca", forca, true);
+         }
+       }
        
-       // Mostrar resultado no display
-       xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-       setaDisplay.printazul("F: " + String(forca));
-       xSemaphoreGive(xDisplayMutex);
+       // Só se nenhum outro comando trocou o modo nesse meio tempo
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       if (estadoAtual == Estado::Forca) {
+         estadoAtual = Estado::Inicial;
+       }
+       xSemaphoreGive(xEstadoMutex);
        
+     }
+     vTaskDelay(1000 / portTICK_PERIOD_MS);
+   }
+ }
+ 
+ /**
+  * @brief Tarefa que grava um traço dos sensores (toques + MPU6500)
+  *
+  * Destino "flash" grava TRACO_ARQUIVO no LittleFS; qualquer outro envia
+  * pela serial em quadros (ver Traco.h). A 1 kHz o traço ocupa ~19 KB/s:
+  * na serial isso exige a USB CDC do ESP32-S3 ou uma UART acima de 230400.
+  */
+void tarefaGravacao(void* arg) {
+   // O prazo do laço de 1 kHz é da tarefa, como o detector de cada modo
+   PrazoRastreio prazoGravacao("gravacao", 1000000 / TAXA_TRACO_IMU_HZ, 1000000 / TAXA_TRACO_IMU_HZ);
+   
+   while (1) {
+     xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+     Estado estadoLocal = estadoAtual;
+     xSemaphoreGive(xEstadoMutex);
+     
+     if (estadoLocal == Estado::Gravacao) {
+       Medicao medicao = conexao.getCurrentMeasurement();
+       bool paraFlash = (medicao.destino == DestinoTraco::Flash);
+       uint32_t duracaoUs = (uint32_t)(medicao.duracao > 0 ? medicao.duracao : DURACAO_TRACO_PADRAO_S) * 1000000UL;
+       
+       CabecalhoTraco cabecalho;
+       memset(&cabecalho, 0, sizeof(cabecalho));
+       cabecalho.magico = TRACO_MAGICO;
+       cabecalho.versao = TRACO_VERSAO;
+       cabecalho.tamanhoCabecalho = sizeof(cabecalho);
+       cabecalho.numSensores = NUM_SENSORES;
+       cabecalho.faixaAcelG = FAIXA_ACEL_G;
+       cabecalho.faixaGiroDps = FAIXA_GIRO_DPS;
+       cabecalho.taxaToqueHz = TAXA_TRACO_TOQUE_HZ;
+       cabecalho.taxaIMUHz = TAXA_TRACO_IMU_HZ;
+       cabecalho.inicioEpoch = conexao.getTimestamp();
+       for (int i = 0; i < NUM_SENSORES; i++) {
+         cabecalho.pinos[i] = sensores.getPino(i);
+         cabecalho.baseline[i] = sensores.getBaseline(i);
+         cabecalho.threshold[i] = sensores.getThreshold(i);
+       }
+       
+       File arquivo;
+       Print* destino = &Serial;
+       if (paraFlash) {
+         if (LittleFS.begin(true)) {
+           arquivo = LittleFS.open(TRACO_ARQUIVO, FILE_WRITE);
+         }
+         if (!arquivo) {
+           LOG_ERRO(Modos, "Falha ao abrir o traço no flash");
+           // O erro e a volta ao inicial só valem se nenhum comando trocou o modo
+           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+           bool aindaNoModo = (estadoAtual == Estado::Gravacao);
+           xSemaphoreGive(xEstadoMutex);
+           if (aindaNoModo) {
+             conexao.updateDevicemMdicoes("erro");
+           }
+           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+           if (estadoAtual == Estado::Gravacao) {
+             estadoAtual = Estado::Inicial;
+           }
+           xSemaphoreGive(xEstadoMutex);
+           continue;
+         }
+         destino = &arquivo;
+       }
+       
+       GravadorTraco gravador;
+       gravador.iniciar(*destino, cabecalho, !paraFlash);
+       
+       uint32_t inicio = micros();
+       TickType_t ultimoDespertar = xTaskGetTickCount();
+       uint32_t ciclo = 0;
+       bool aindaNoModo = true;
+       prazoGravacao.iniciar();
+       while (aindaNoModo && (micros() - inicio) < duracaoUs) {
+         prazoGravacao.marcar();
+         xyzFloat aceleracao, giro;
+         sensores.lerIMU(aceleracao, giro);
+         gravador.registrarIMU(micros() - inicio, aceleracao.x, aceleracao.y, aceleracao.z,
+                               giro.x, giro.y, giro.z);
+         
+         if (ciclo % (TAXA_TRACO_IMU_HZ / TAXA_TRACO_TOQUE_HZ) == 0) {
+           uint16_t toques[NUM_SENSORES];
+           sensores.lerToques(toques);
+           gravador.registrarToque(micros() - inicio, toques);
+           
+           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+           aindaNoModo = (estadoAtual == Estado::Gravacao);
+           xSemaphoreGive(xEstadoMutex);
+         }
+         ciclo++;
+         vTaskDelayUntil(&ultimoDespertar, pdMS_TO_TICKS(1000 / TAXA_TRACO_IMU_HZ));
+       }
+       
+       gravador.finalizar();
+       if (paraFlash) {
+         arquivo.close();
+       }
+       LOG_INFO(Modos, "Traço gravado: %u registros, %u bytes",
+                (unsigned)gravador.getRegistros(), (unsigned)gravador.getBytesGravados());
+       
+       // "concluida" só com a duração inteira: parado pelo app ou trocado por
+       // outro modo, a saida/ já pode ser de outro comando
        xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
-       estadoAtual = Estado::Inicial;
+       aindaNoModo = aindaNoModo && (estadoAtual == Estado::Gravacao);
        xSemaphoreGive(xEstadoMutex);
+       if (aindaNoModo) {
+         conexao.setMeasurementResult(gravador.getBytesGravados());
+         conexao.updateDevicemMdicoes("concluida");
+         servicoDisplay.banner("TRACO OK");
+       }
        
+       // Só se nenhum outro comando trocou o modo nesse meio tempo
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       if (estadoAtual == Estado::Gravacao) {
+         estadoAtual = Estado::Inicial;
+       }
+       xSemaphoreGive(xEstadoMutex);
      }
      vTaskDelay(1000 / portTICK_PERIOD_MS);
    }
  }
  
+ /**
+  * @brief Tarefa do modo round: todos os golpes, sem voltar ao estado inicial
+  *
+  * Lê o MPU6500 a 1 kHz e os pads a cada ROUND_PERIODO_TOQUE_MS; o
+  * SegmentadorGolpes (Round.h) separa cada golpe em tempo real, o
+  * ExtratorGolpe resume cada um para o classificador (Classificador.h) e
+  * o RegistroRound acumula os baldes de 1 s. Só ao fim de cada round há
+  * uma escrita no Firebase (saida/rounds/<n>); o "valor" final é o
+  * total de golpes de todos os rounds.
+  */
+void tarefaRound(void* arg) {
+   // ~14 KB de baldes: fora da pilha da tarefa
+   static RegistroRound registro;
+   PrazoRastreio prazoRound("round", 1000, 1000);
+   
+   while (1) {
+     xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+     Estado estadoLocal = estadoAtual;
+     xSemaphoreGive(xEstadoMutex);
+     
+     if (estadoLocal == Estado::Round) {
+       Medicao medicao = conexao.getCurrentMeasurement();
+       int duracaoS = medicao.duracao > 0 ? medicao.duracao : ROUND_DURACAO_PADRAO_S;
+       int descansoS = medicao.descanso > 0 ? medicao.descanso : ROUND_DESCANSO_PADRAO_S;
+       int rounds = medicao.rounds > 0 ? medicao.rounds : ROUND_NUM_PADRAO;
+       
+       int limites[NUM_SENSORES];
+       for (int i = 0; i < NUM_SENSORES; i++) {
+         limites[i] = sensores.getThreshold(i);
+       }
+       
+       SegmentadorGolpes segmentador;
+       ExtratorGolpe extrator;
+       uint32_t totalGolpes = 0;
+       bool aindaNoModo = true;
+       
+       for (int numero = 1; numero <= rounds && aindaNoModo; numero++) {
+         // Descanso entre os rounds, com contagem regressiva
+         if (numero > 1) {
+           for (int restante = descansoS; restante > 0 && aindaNoModo; restante--) {
+             servicoDisplay.texto("DESCANSO " + String(restante));
+             vTaskDelay(1000 / portTICK_PERIOD_MS);
+             xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+             aindaNoModo = (estadoAtual == Estado::Round);
+             xSemaphoreGive(xEstadoMutex);
+           }
+           if (!aindaNoModo) {
+             break;
+           }
+         }
+         
+         servicoDisplay.banner("ROUND " + String(numero));
+         segmentador.reiniciar();
+         extrator.reiniciar();
+         uint32_t inicio = millis();
+         registro.iniciar(numero, duracaoS, inicio, conexao.getTimestamp());
+         
+         TickType_t ultimoDespertar = xTaskGetTickCount();
+         uint32_t ciclo = 0;
+         prazoRound.iniciar();
+         while (aindaNoModo && (millis() - inicio) < (uint32_t)duracaoS * 1000UL) {
+           prazoRound.marcar();
+           xyzFloat aceleracao, giro;
+           sensores.lerIMU(aceleracao, giro);
+           uint32_t agora = millis();
+           
+           if (ciclo % ROUND_PERIODO_TOQUE_MS == 0) {
+             uint16_t toques[NUM_SENSORES];
+             sensores.lerToques(toques);
+             segmentador.adicionarToques(agora, toques, limites);
+             
+             xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+             aindaNoModo = (estadoAtual == Estado::Round);
+             xSemaphoreGive(xEstadoMutex);
+           }
+           
+           GolpeSegmentado golpe;
+           bool terminou = segmentador.adicionarIMU(agora, aceleracao, golpe);
+           if (segmentador.emGolpe()) {
+             AmostraGolpe amostra = {(uint32_t)micros(), aceleracao.x, aceleracao.y, aceleracao.z,
+                                     giro.x, giro.y, giro.z};
+             extrator.adicionar(amostra);
+           } else if (terminou) {
+             float caracteristicas[NUM_CARACTERISTICAS];
+             extrator.finalizar(golpe.pad, caracteristicas);
+             golpe.tipo = classificadorGolpes.classificar(caracteristicas);
+             registro.registrar(golpe);
+           } else {
+             extrator.repouso(aceleracao.x, aceleracao.y, aceleracao.z);
+           }
+           
+           if (ciclo % 1000 == 0) {
+             uint32_t restante = duracaoS - (agora - inicio) / 1000;
+             servicoDisplay.texto(String(restante) + "s  " + String(registro.getGolpes()));
+           }
+           ciclo++;
+           vTaskDelayUntil(&ultimoDespertar, pdMS_TO_TICKS(1));
+         }
+         
+         LOG_INFO(Modos, "Round %d: %u golpes, media %.1f g, pico %.1f g", numero,
+                  (unsigned)registro.getGolpes(), registro.getMediaG(), registro.getPicoG());
+         totalGolpes += registro.getGolpes();
+         // Um round cortado pelo app não é enviado: a saida/ já pode ser de outro comando
+         if (aindaNoModo && !conexao.sendRoundResult(registro)) {
+           LOG_ERRO(Modos, "Falha ao enviar o round");
+         }
+       }
+       
+       // Enviar resultado, a menos que o app tenha parado ou trocado o modo
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       aindaNoModo = (estadoAtual == Estado::Round);
+       xSemaphoreGive(xEstadoMutex);
+       if (aindaNoModo) {
+         conexao.setMeasurementResult(totalGolpes);
+         conexao.updateDevicemMdicoes("concluida");
+         servicoDisplay.banner("GOLPES: " + String(totalGolpes));
+       }
+       
+       // Só se nenhum outro comando trocou o modo nesse meio tempo
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       if (estadoAtual == Estado::Round) {
+         estadoAtual = Estado::Inicial;
+       }
+       xSemaphoreGive(xEstadoMutex);
+     }
+     vTaskDelay(1000 / portTICK_PERIOD_MS);
+   }
+ }
+ 
+ /**
+  * @brief Tarefa do modo circuito: vários sacos com o mesmo "já" (Circuito.h)
+  *
+  * Ouve o ESP-NOW o tempo todo. Livre, o saco adere ao anúncio de um vizinho
+  * e entra no Estado::Circuito sem comando do app; o resultado dele sai pelo
+  * coordenador. Com o comando "circuito" este saco coordena: sincroniza os
+  * vizinhos, marca as rodadas e envia cada uma em saida/circuito/<n>. Os
+  * pads são lidos entre os quadros, a cada TOQUE_PERIODO_MS, para os pongs
+  * não esperarem pela leitura.
+  */
+void tarefaCircuito(void* arg) {
+   static DetectorToques detector("circuito.toque");
+   bool coordenando = false;
+   bool vizinho = false;
+   uint32_t ultimaLeituraMs = 0;
+   float somaReacaoS = 0;
+   int reacoes = 0;
+   
+   // O ESP-NOW usa o canal do AP: só depois do WiFi
+   while (!boot.pronto(BOOT_WIFI) || !transporteEspNow.iniciar()) {
+     vTaskDelay(1000 / portTICK_PERIOD_MS);
+   }
+   
+   while (1) {
+     xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+     Estado estadoLocal = estadoAtual;
+     xSemaphoreGive(xEstadoMutex);
+     participanteCircuito.definirDisponivel(estadoLocal == Estado::Inicial ||
+                                            estadoLocal == Estado::Ocioso);
+     
+     // Parado pelo app (ou outro modo pedido): avisa os vizinhos
+     if (coordenando && estadoLocal != Estado::Circuito) {
+       coordenadorCircuito.parar();
+       coordenando = false;
+     }
+     if (vizinho && estadoLocal != Estado::Circuito) {
+       participanteCircuito.sair();
+     }
+     
+     // Comando do app: este saco coordena
+     if (estadoLocal == Estado::Circuito && !coordenando && !vizinho) {
+       Medicao medicao = conexao.getCurrentMeasurement();
+       int rodadas = medicao.rounds > 0 ? medicao.rounds : CIRCUITO_RODADAS_PADRAO;
+       uint32_t pausaMs = medicao.descanso > 0 ? medicao.descanso * 1000UL : CIRCUITO_PAUSA_PADRAO_MS;
+       coordenadorCircuito.iniciar(rodadas, NUM_SENSORES, CIRCUITO_JANELA_PADRAO_MS, pausaMs);
+       coordenando = true;
+       somaReacaoS = 0;
+       reacoes = 0;
+       LOG_INFO(Modos, "Circuito: sessao %u, %d rodadas", coordenadorCircuito.getSessao(), rodadas);
+     }
+     
+     // Em sessão, 1 ms de espera: a sincronia troca um ping a cada 5 ms
+     QuadroCircuito quadro;
+     uint32_t esperaMs = participanteCircuito.getAtivo() ? 1 : 10;
+     while (transporteEspNow.receber(quadro, esperaMs)) {
+       esperaMs = 0;
+       if (coordenando && coordenadorCircuito.tratar(quadro)) {
+         continue;
+       }
+       bool livre = !participanteCircuito.getAtivo();
+       if (!participanteCircuito.tratar(quadro) || !livre || !participanteCircuito.getAtivo()) {
+         continue;
+       }
+       // Aderiu ao anúncio de um vizinho, se nenhum comando chegou antes
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       vizinho = (estadoAtual == Estado::Inicial || estadoAtual == Estado::Ocioso);
+       if (vizinho) {
+         estadoAtual = Estado::Circuito;
+         circuitoComoVizinho = true;
+       }
+       xSemaphoreGive(xEstadoMutex);
+       if (!vizinho) {
+         participanteCircuito.sair();
+         continue;
+       }
+       energia.registrarAtividade();
+       servicoDisplay.banner("CIRCUITO");
+       LOG_INFO(Modos, "Circuito: sessao %u de um vizinho", participanteCircuito.getSessao());
+     }
+     
+     if (coordenando) {
+       coordenadorCircuito.processar();
+     }
+     
+     // Disparo a menos de 2 ms: espera o instante, não o próximo tick
+     int32_t faltaUs = (int32_t)(participanteCircuito.getDisparoUs() - micros());
+     if (participanteCircuito.getAtivo() && !participanteCircuito.getEmEstimulo() &&
+         faltaUs > 0 && faltaUs <= 2000) {
+       delayMicroseconds(faltaUs);
+     }
+     int pad = participanteCircuito.processar();
+     if (pad > 0) {
+       RASTREIO_INSTANTE("circuito.disparo");
+       // Sem esperar o painel: o laço mantém a sincronia de relógio
+       estimuloPad(pad, false);
+     }
+     
+     // Os pads seguem amostrados durante toda a sessão, como na espera da
+     // agilidade: no disparo o detector já tem base e ruído em dia
+     if (participanteCircuito.getAtivo() && millis() - ultimaLeituraMs >= TOQUE_PERIODO_MS) {
+       ultimaLeituraMs = millis();
+       uint16_t valores[NUM_SENSORES];
+       int limites[NUM_SENSORES];
+       for (int i = 0; i < NUM_SENSORES; i++) {
+         limites[i] = sensores.getThreshold(i);
+       }
+       sensores.lerToques(valores);
+       EventoToque evento;
+       int tocado = detector.adicionar(micros(), valores, limites, evento);
+       if (tocado >= 0 && participanteCircuito.getEmEstimulo()) {
+         int32_t reacaoUs = (int32_t)(evento.inicioUs - participanteCircuito.getDisparoUs());
+         if (participanteCircuito.informarToque(tocado + 1, evento.inicioUs)) {
+           servicoDisplay.texto("Tempo: " + String(reacaoUs / 1000000.0) + "s");
+         } else {
+           // Largada queimada: fica valendo o próximo toque dentro da janela
+           servicoDisplay.texto("QUEIMOU");
+         }
+       }
+     }
+     
+     RodadaCircuito rodada;
+     if (coordenando && coordenadorCircuito.rodadaPronta(rodada)) {
+       for (uint8_t i = 0; i < rodada.numSacos; i++) {
+         if (rodada.sacos[i].respondeu && rodada.sacos[i].reacaoUs != CIRCUITO_SEM_TOQUE) {
+           somaReacaoS += rodada.sacos[i].reacaoUs / 1000000.0f;
+           reacoes++;
+         }
+       }
+       LOG_INFO(Modos, "Circuito: rodada %u com %u sacos", rodada.numero, rodada.numSacos);
+       if (!conexao.sendCircuitResult(rodada)) {
+         LOG_ERRO(Modos, "Falha ao enviar a rodada do circuito");
+       }
+     }
+     
+     // Fim das rodadas: o "valor" é a reação média de todos os sacos
+     if (coordenando && !coordenadorCircuito.getAtivo()) {
+       coordenando = false;
+       conexao.setMeasurementResult(reacoes > 0 ? somaReacaoS / reacoes : 0);
+       conexao.updateDevicemMdicoes("concluida");
+       servicoDisplay.banner("CIRCUITO FIM");
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       if (estadoAtual == Estado::Circuito) {
+         estadoAtual = Estado::Inicial;
+       }
+       xSemaphoreGive(xEstadoMutex);
+     }
+     
+     // Vizinho: o coordenador encerrou ou sumiu
+     if (vizinho && !participanteCircuito.getAtivo()) {
+       vizinho = false;
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       circuitoComoVizinho = false;
+       if (estadoAtual == Estado::Circuito) {
+         estadoAtual = Estado::Inicial;
+       }
+       xSemaphoreGive(xEstadoMutex);
+       servicoDisplay.texto("PRONTO");
+     }
+   }
+ }
+ 
+ /**
+  * @brief Tarefa que põe o saco em light sleep quando fica ocioso
+  *
+  * Depois de ENERGIA_OCIOSO_MS no Estado::Inicial (sem app conectado), apaga
+  * o painel e o LED, põe o WiFi em modem sleep e dorme em ciclos (Energia.h).
+  * Toque ou movimento devolvem o saco ao Estado::Inicial; um comando que
+  * chegue numa janela de rede tira o saco do Estado::Ocioso direto para o
+  * modo pedido.
+  */
+ void tarefaEnergia(void* arg) {
+   while (1) {
+     vTaskDelay(1000 / portTICK_PERIOD_MS);
+     
+     xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+     bool inicial = (estadoAtual == Estado::Inicial);
+     bool dormir = inicial && energia.ocioso();
+     if (dormir) {
+       estadoAtual = Estado::Ocioso;
+     }
+     xSemaphoreGive(xEstadoMutex);
+     
+     if (!inicial) {
+       energia.registrarAtividade();  // Um modo em andamento é uso do saco
+       continue;
+     }
+     if (!dormir) {
+       continue;
+     }
+     
+     LOG_INFO(Energia, "Ocioso: entrando em light sleep");
+     servicoDisplay.painel(false);
+     digitalWrite(PINO_LED, LOW);
+     energia.economizarRede(true);
+     vTaskDelay(100 / portTICK_PERIOD_MS);  // A tarefa do display apaga o painel
+     
+     bool continuar = true;
+     while (continuar) {
+       CausaDespertar causa = energia.dormir();
+       if (causa != CausaDespertar::Toque && causa != CausaDespertar::Movimento) {
+         // Janela para a tarefaComunicacao ler o nó; um comando muda o estado
+         vTaskDelay(ENERGIA_JANELA_REDE_MS / portTICK_PERIOD_MS);
+       }
+       
+       xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+       bool aindaOcioso = (estadoAtual == Estado::Ocioso);
+       continuar = aindaOcioso && energia.ocioso();
+       if (aindaOcioso && !continuar) {
+         estadoAtual = Estado::Inicial;
+       }
+       xSemaphoreGive(xEstadoMutex);
+     }
+     
+     energia.economizarRede(false);
+     servicoDisplay.painel(true);
+     energia.marcarPronto();
+     // Pelo anel do log: um printf aqui seguraria o saco que acabou de acordar
+     LOG_INFO(Energia, "Acordou (%s) depois de %u ciclos, pronto em %u us",
+              nomeCausaDespertar(energia.getUltimaCausa()),
+              (unsigned)energia.getCiclos(), (unsigned)energia.getLatenciaDespertarUs());
+   }
+ }
+ 
+ /**
+  * @brief Sem isso o core do Arduino confirma a imagem antes do setup()
+  *
+  * Com o rollback ligado no bootloader, a imagem nova só é confirmada pela
+  * tarefaOta, depois da verificação de saúde.
+  */
+ bool verifyRollbackLater() {
+   return true;
+ }
+ 
+ /**
+  * @brief Estado da atualização em /devices/<id>/ota (chamada pelo AtualizadorOta)
+  */
+ void avisarOta(const AtualizadorOta& atualizador) {
+   conexao.updateOtaStatus(nomeEstadoOta(atualizador.getEstado()), atualizador.getVersaoNova(),
+                           atualizador.getProgresso(), atualizador.getErro());
+ }
+ 
+ /**
+  * @brief Tarefa de atualização OTA (Ota.h), abaixo dos modos
+  *
+  * Primeiro confirma ou reverte a imagem que acabou de subir; depois
+  * procura versões novas em /ota/url e, com uma imagem pronta, espera o
+  * saco ficar livre para reiniciar.
+  */
+ void tarefaOta(void* arg) {
+   atualizadorOta.iniciar(avisarOta);
+   
+   if (atualizadorOta.pendenteVerificacao()) {
+     // Saudável: sensores no ar e o saco registrado no Firebase
+     bool rede = boot.aguardar(BOOT_FIREBASE, OTA_PRAZO_SAUDE_MS);
+     bool sensoresOk = boot.fase(FaseBoot::Sensores).estado == EstadoFase::Concluida;
+     atualizadorOta.confirmar(rede && sensoresOk);
+   } else if (atualizadorOta.getEstado() == EstadoOta::Revertida) {
+     boot.aguardar(BOOT_FIREBASE, portMAX_DELAY);
+     avisarOta(atualizadorOta);
+   }
+   
+   while (1) {
+     if (boot.pronto(BOOT_FIREBASE)) {
+       String url = conexao.getOtaUrl();
+       if (url.length() > 0 && atualizadorOta.verificar(url)) {
+         // O download não interrompe nada, o reinício espera o saco livre
+         bool livre = false;
+         while (!livre) {
+           xSemaphoreTake(xEstadoMutex, portMAX_DELAY);
+           livre = (estadoAtual == Estado::Inicial || estadoAtual == Estado::Ocioso);
+           xSemaphoreGive(xEstadoMutex);
+           if (!livre) {
+             vTaskDelay(1000 / portTICK_PERIOD_MS);
+           }
+         }
+         LOG_TELA(Conexao, "Atualizando para %s", atualizadorOta.getVersaoNova());
+         atualizadorOta.reiniciar();
+       }
+     }
+     vTaskDelay(OTA_VERIFICA_MS / portTICK_PERIOD_MS);
+   }
+ }
+ 
  /**
   * @brief Função de configuração inicial do programa
   */
  void setup() {
+   // Sem esperar a Serial nem a rede: o relatório do boot sai quando ela vier
+   boot.iniciar();
    pinMode(PINO_LED, OUTPUT);
    Serial.begin(115200);
+   
+ #ifdef MODO_BANCADA
+   // Só o hardware das rotinas medidas: sem WiFi, Firebase ou tarefas
    delay(2000);
+   setaDisplay.begin();
+   sensores.iniciar();
+   bancada.executar(Serial);
+   return;
+ #endif
    Serial.println("Iniciando sistema...");
+   // A partir daqui os módulos logam pelo anel (Log.h)
+   servicoLog.iniciar();
+   // Trechos, prazos e trocas de tarefa (Rastreio.h); "r" na Serial exporta
+   rastreio.ativar(true);
    
    // Criar mutex para proteção do estado
    xEstadoMutex = xSemaphoreCreateMutex();
@@ -388,69 +1121,61 @@ void tarefaForca(void* arg) {
      while(1);
    }
    
-   // Criar mutex para proteção do display
-   xDisplayMutex = xSemaphoreCreateMutex();
-   if (xDisplayMutex == NULL) {
-     Serial.println("Falha ao criar mutex do display");
+   // Inicializar display; a partir daqui só a tarefa do display o acessa
+   boot.inicioFase(FaseBoot::Display);
+   setaDisplay.begin();
+   if (!servicoDisplay.iniciar()) {
      while(1);
    }
-   
-   // Inicializar display
-   setaDisplay.begin();
-   setaDisplay.clear();
-   setaDisplay.update();
-   setaDisplay.print("INICIANDO...");
-   setaDisplay.setStatus(1);
-   setaDisplay.printlog("Sistema iniciando");
-   
-   // Inicializar conexões
-   conexao.begin();
-   Serial.println("Conexões inicializadas");
-   setaDisplay.printlog("Conexões OK");
+   servicoDisplay.texto("INICIANDO...");
+   servicoDisplay.status(1);
+   servicoDisplay.log("Sistema iniciando");
+   boot.fimFase(FaseBoot::Display);
    
    // Inicializar sensores
+   boot.inicioFase(FaseBoot::Sensores);
    sensores.iniciar();
-   Serial.println("Sensores inicializados");
-   setaDisplay.printlog("Sensores OK");
+   energia.iniciar();
+   boot.fimFase(FaseBoot::Sensores);
+   servicoDisplay.log("Sensores OK");
    
-   // Calibrar sensores de toque
-   //sensores.calibrarSensoresToque();
-   //Serial.println("Sensores calibrados");
-   //setaDisplay.printlog("Sensores calibrados");
+   // Última calibração gravada; sem ela ficam os limites da placa
+   boot.inicioFase(FaseBoot::Calibracao);
+   bool calibrado = LittleFS.begin(true) && sensores.carregarCalibracao();
+   boot.fimFase(FaseBoot::Calibracao, calibrado);
+   servicoDisplay.log(calibrado ? "Calibracao carregada" : "Limites padrao");
    
-   // Mostrar hora atual
-   String dataHora = conexao.getTimeString();
-
-// Usar no display
-      xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-      setaDisplay.showtime(dataHora);
-      xSemaphoreGive(xDisplayMutex);
-
-      // Ou usar para logging
-      Serial.println("Data/hora atual: " + dataHora);
-      xSemaphoreTake(xDisplayMutex, portMAX_DELAY);
-      setaDisplay.printlog("Hora: " + dataHora);
-      xSemaphoreGive(xDisplayMutex);
-  
-    
-   // Iniciar tarefas
+   // Iniciar tarefas; WiFi, NTP e Firebase sobem na tarefaComunicacao
+   boot.inicioFase(FaseBoot::Tarefas);
    xTaskCreate(tarefaPiscarLED, "tarefaPiscarLED", 4096, NULL, 1, NULL);
    xTaskCreate(tarefaComunicacao, "tarefaComunicacao", 8192, NULL, 2, NULL);
    xTaskCreate(tarefaAgilidade, "tarefaAgilidade", 4096, NULL, 1, NULL);
    xTaskCreate(tarefaPrecisao, "tarefaPrecisao", 8192, NULL, 1, NULL);
    xTaskCreate(tarefaForca, "tarefaForca", 4096, NULL, 1, NULL);
    xTaskCreate(tarefaCalibra, "tarefaCalibra", 8192, NULL, 1, NULL);
+   xTaskCreate(tarefaGravacao, "tarefaGravacao", 8192, NULL, 2, NULL);
+   xTaskCreate(tarefaRound, "tarefaRound", 8192, NULL, 2, NULL);
    xTaskCreate(tarefaDataHora, "tarefaDataHora", 4096, NULL, 1, NULL);  
-   Serial.println("Todas as tarefas iniciadas");
-   setaDisplay.printlog("Sistema pronto");
-   conexao.updateDeviceStatus("disponivel");
-   setaDisplay.setStatus(2);
+   xTaskCreate(tarefaEnergia, "tarefaEnergia", 4096, NULL, 1, NULL);
+   xTaskCreate(tarefaCircuito, "tarefaCircuito", 4096, NULL, 2, NULL);
+   xTaskCreate(tarefaOta, "tarefaOta", 8192, NULL, 0, NULL);
+   boot.fimFase(FaseBoot::Tarefas);
+   Serial.printf("Modos locais prontos em %u ms\n", (unsigned)boot.getLocalProntoMs());
+   servicoDisplay.log("Local pronto");
  }
  
  /**
   * @brief Função de loop principal
   */
  void loop() {
-   
+   // Comandos do rastreio pela Serial: "r" exporta o anel, "p" lista os prazos
+   while (Serial.available()) {
+     int comando = Serial.read();
+     if (comando == 'r') {
+       rastreio.exportarChrome(Serial);
+     } else if (comando == 'p') {
+       rastreio.relatorioPrazos(Serial);
+     }
+   }
    vTaskDelay(1000 / portTICK_PERIOD_MS);
  }
\ No newline at end of file